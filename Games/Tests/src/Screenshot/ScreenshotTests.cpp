@@ -1,7 +1,5 @@
 #include "ScreenshotTests.h"
 
-#include <ImageLoader/PortableMaps/PPMImage.h>
-
 ScreenshotTests::ScreenshotTests()
 	: Layer("Screenshot")
 {
@@ -42,8 +40,15 @@ void ScreenshotTests::OnUpdate(const TRAP::Utils::TimeStep& deltaTime)
 	if(time >= 3.0f && !done)
 	{
 		TRAP::Scope<TRAP::Image> renderedImg = TRAP::Graphics::RendererAPI::GetRenderer()->CaptureScreenshot(*TRAP::Application::GetWindow());
+		//Encode and write the screenshot in the background so the frame doesn't stall
 		if(renderedImg)
-			TRAP::INTERNAL::PPMImage::Save(renderedImg.get(), "output.ppm");
+			m_screenshotSaved = TRAP::Image::SaveToFileAsync(std::move(renderedImg), "output.png");
 		done = true;
 	}
+
+	if(m_screenshotSaved.valid() && m_screenshotSaved.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+	{
+		if(m_screenshotSaved.get())
+			TP_INFO("[Screenshot] Saved screenshot to output.png");
+	}
 }
\ No newline at end of file
@@ -14,6 +14,7 @@ public:
 
 private:
 	TRAP::Graphics::OrthographicCameraController m_cameraController{TRAP::Application::GetWindow()->GetAspectRatio(), true};
+	std::future<bool> m_screenshotSaved;
 };
 
 #endif /*GAMESTRAP_SCREENSHOTTESTS_H*/
\ No newline at end of file
@@ -103,6 +103,17 @@ inline constexpr TRAP::SemanticVersion<0, 10, 93> TRAP_VERSION{};
 
 //-------------------------------------------------------------------------------------------------------------------//
 
+/// @brief Compile a function for the given instruction set extensions (i.e. "sse4.1,pclmul"),
+///        independent of the extensions enabled for the whole project.
+///        Only call such functions after checking TRAP::Utils::GetCPUInfo() for support.
+#if defined(__GNUC__) || defined(__clang__)
+	#define TRAP_TARGET_ISA(isa) __attribute__((target(isa)))
+#else
+	#define TRAP_TARGET_ISA(isa)
+#endif /*defined(__GNUC__) || defined(__clang__)*/
+
+//-------------------------------------------------------------------------------------------------------------------//
+
 #if defined(__GNUC__) && !defined(__clang__)
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wshadow"
@@ -0,0 +1,147 @@
+#include "TRAPPCH.h"
+#include "MappedFile.h"
+
+#include "FileSystem.h"
+
+namespace
+{
+	/// @brief Map the given file into memory.
+	/// @param path File path.
+	/// @param size Size of the file in bytes.
+	/// @return Pointer to the mapped file content on success, nullptr otherwise.
+	[[nodiscard]] const u8* MapFileInternal(const std::filesystem::path& path, const usize size)
+	{
+		ZoneNamedC(__tracy, tracy::Color::Blue, (GetTRAPProfileSystems() & ProfileSystems::FileSystem) != ProfileSystems::None);
+
+#ifdef TRAP_PLATFORM_LINUX
+		const i32 fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if(fd == -1)
+			return nullptr;
+
+		void* const data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+		close(fd); //The mapping keeps its own reference to the file
+
+		if(data == MAP_FAILED)
+			return nullptr;
+
+		//Decoders usually read the content front to back
+		madvise(data, size, MADV_SEQUENTIAL);
+
+		return static_cast<const u8*>(data);
+#elif defined(TRAP_PLATFORM_WINDOWS)
+		HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+		                          FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if(file == INVALID_HANDLE_VALUE)
+			return nullptr;
+
+		HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		CloseHandle(file); //The mapping keeps its own reference to the file
+		if(mapping == nullptr)
+			return nullptr;
+
+		const void* const data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, size);
+		CloseHandle(mapping); //The view keeps its own reference to the mapping
+
+		return static_cast<const u8*>(data);
+#else
+		return nullptr;
+#endif /*TRAP_PLATFORM_LINUX*/
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+TRAP::FileSystem::MappedFile::MappedFile(const u8* const mappedData, const usize size) noexcept
+	: m_data(mappedData, size), m_mapped(true)
+{
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+TRAP::FileSystem::MappedFile::MappedFile(std::vector<u8> data) noexcept
+	: m_data(data), m_fallbackData(std::move(data))
+{
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+TRAP::FileSystem::MappedFile::MappedFile(MappedFile&& other) noexcept
+	: m_data(std::exchange(other.m_data, {})), m_mapped(std::exchange(other.m_mapped, false)),
+	  m_fallbackData(std::move(other.m_fallbackData))
+{
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+TRAP::FileSystem::MappedFile& TRAP::FileSystem::MappedFile::operator=(MappedFile&& other) noexcept
+{
+	if(this == &other)
+		return *this;
+
+	Unmap();
+
+	m_data = std::exchange(other.m_data, {});
+	m_mapped = std::exchange(other.m_mapped, false);
+	m_fallbackData = std::move(other.m_fallbackData);
+
+	return *this;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+TRAP::FileSystem::MappedFile::~MappedFile()
+{
+	Unmap();
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::FileSystem::MappedFile::Unmap() noexcept
+{
+	ZoneNamedC(__tracy, tracy::Color::Blue, (GetTRAPProfileSystems() & ProfileSystems::FileSystem) != ProfileSystems::None &&
+	                                        (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	if(!m_mapped)
+		return;
+
+#ifdef TRAP_PLATFORM_LINUX
+	munmap(const_cast<u8*>(m_data.data()), m_data.size());
+#elif defined(TRAP_PLATFORM_WINDOWS)
+	UnmapViewOfFile(m_data.data());
+#endif /*TRAP_PLATFORM_LINUX*/
+
+	m_data = {};
+	m_mapped = false;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] TRAP::Optional<TRAP::FileSystem::MappedFile> TRAP::FileSystem::MapFile(const std::filesystem::path& path)
+{
+	ZoneNamedC(__tracy, tracy::Color::Blue, (GetTRAPProfileSystems() & ProfileSystems::FileSystem) != ProfileSystems::None);
+
+	TRAP_ASSERT(!path.empty(), "FileSystem::MapFile(): Path is empty!");
+
+	std::error_code ec{};
+	const bool isRegularFile = std::filesystem::is_regular_file(path, ec);
+	const usize fileSize = isRegularFile ? std::filesystem::file_size(path, ec) : 0;
+	if(ec)
+	{
+		TP_ERROR(Log::FileSystemPrefix, "Couldn't map file: ", path, " (", ec.message(), ")!");
+		return TRAP::NullOpt;
+	}
+
+	//Empty files can't be mapped
+	if(isRegularFile && fileSize != 0)
+	{
+		if(const u8* const data = MapFileInternal(path, fileSize); data != nullptr)
+			return MappedFile(data, fileSize);
+	}
+
+	//Fallback, read the whole file at once
+	auto data = ReadFile(path);
+	if(!data)
+		return TRAP::NullOpt;
+
+	return MappedFile(std::move(*data));
+}
@@ -0,0 +1,69 @@
+#ifndef TRAP_MAPPEDFILE_H
+#define TRAP_MAPPEDFILE_H
+
+#include <filesystem>
+#include <span>
+#include <vector>
+
+#include "Core/Types.h"
+#include "Utils/Optional.h"
+
+namespace TRAP::FileSystem
+{
+	/// @brief Read only view of a files content.
+	///        The file is mapped into memory, if the file can't be mapped
+	///        (i.e. because it is not a regular file) its content is read in a single bulk read instead.
+	class MappedFile
+	{
+	public:
+		/// @brief Constructor.
+		/// @param mappedData Start of the mapped file content.
+		/// @param size Size of the mapped file content in bytes.
+		/// @note Use MapFile() to create a MappedFile.
+		MappedFile(const u8* mappedData, usize size) noexcept;
+		/// @brief Constructor.
+		/// @param data File content read into memory.
+		/// @note Use MapFile() to create a MappedFile.
+		explicit MappedFile(std::vector<u8> data) noexcept;
+
+		/// @brief Copy constructor.
+		consteval MappedFile(const MappedFile&) = delete;
+		/// @brief Copy assignment operator.
+		consteval MappedFile& operator=(const MappedFile&) = delete;
+		/// @brief Move constructor.
+		MappedFile(MappedFile&& other) noexcept;
+		/// @brief Move assignment operator.
+		MappedFile& operator=(MappedFile&& other) noexcept;
+
+		/// @brief Destructor.
+		~MappedFile();
+
+		/// @brief Retrieve the content of the file.
+		/// @return File content.
+		/// @note The returned span is only valid as long as the MappedFile is alive.
+		[[nodiscard]] constexpr std::span<const u8> GetData() const noexcept;
+
+	private:
+		/// @brief Unmap the file.
+		void Unmap() noexcept;
+
+		std::span<const u8> m_data{};
+		bool m_mapped = false;
+		std::vector<u8> m_fallbackData{};
+	};
+
+	/// @brief Map the given file into memory for reading.
+	/// @param path File path.
+	/// @return Mapped file on success, empty optional otherwise.
+	/// @note Unlike ReadFile() the file content is loaded lazily by the OS, so this can be used for big files.
+	[[nodiscard]] TRAP::Optional<MappedFile> MapFile(const std::filesystem::path& path);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] constexpr std::span<const u8> TRAP::FileSystem::MappedFile::GetData() const noexcept
+{
+	return m_data;
+}
+
+#endif /*TRAP_MAPPEDFILE_H*/
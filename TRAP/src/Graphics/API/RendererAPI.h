@@ -1355,7 +1355,9 @@ namespace TRAP::Graphics
 			//Fragment mask //TODO Implement
 			FragMask = BIT(13u),
 			//Create a storage texture
-			Storage = BIT(14u)
+			Storage = BIT(14u),
+			//Decode HDR images (Radiance, PFM) to half floats, halves memory usage and upload size
+			HalfFloatHDR = BIT(15u)
 		};
 
 		/// @brief Enum describing the state of a resource.
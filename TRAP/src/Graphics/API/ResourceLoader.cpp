@@ -10,6 +10,7 @@
 #include "Vulkan/VulkanRenderer.h"
 #include "Utils/String/String.h"
 #include "FileSystem/FileSystem.h"
+#include "ImageLoader/PixelConversion.h"
 
 #include "Vulkan/VulkanCommon.h"
 #include "Vulkan/Objects/VulkanDevice.h"
@@ -787,7 +788,7 @@ void TRAP::Graphics::API::ResourceLoader::StreamerThreadFunc(const std::stop_tok
 				case UpdateRequestType::UpdateTexture:
 				{
 					result = loader.UpdateTexture(loader.m_nextSet,
-												std::get<TextureUpdateDescInternal>(updateState.Desc), nullptr);
+												std::get<TextureUpdateDescInternal>(updateState.Desc), nullptr, nullptr);
 					break;
 				}
 
@@ -1236,7 +1237,8 @@ void TRAP::Graphics::API::ResourceLoader::StreamerFlush(const usize activeSet)
 
 [[nodiscard]] TRAP::Graphics::API::ResourceLoader::UploadFunctionResult TRAP::Graphics::API::ResourceLoader::UpdateTexture(const usize activeSet,
 																											               const TextureUpdateDescInternal& textureUpdateDesc,
-																											               const std::array<const TRAP::Image*, 6>* const images)
+																											               const std::array<const TRAP::Image*, 6>* const images,
+																											               const TRAP::TextureContainer* const container)
 {
 	ZoneNamedC(__tracy, tracy::Color::Red, (GetTRAPProfileSystems() & ProfileSystems::Graphics) != ProfileSystems::None);
 
@@ -1288,8 +1290,7 @@ void TRAP::Graphics::API::ResourceLoader::StreamerFlush(const usize activeSet)
 	{
 		for(u32 i = secondStart; i < secondEnd; ++i)
 		{
-			const u32 mip = textureUpdateDesc.MipsAfterSlice ? j : i; //TODO For now only upload mip level 0 and use the Vulkan way to blit
-			                                                         //them to their mips till I know that Compute Shaders work
+			const u32 mip = textureUpdateDesc.MipsAfterSlice ? j : i;
 			const u32 layer = textureUpdateDesc.MipsAfterSlice ? i : j;
 
 			const u32 w = MIP_REDUCE(texture->GetWidth(), mip);
@@ -1309,24 +1310,54 @@ void TRAP::Graphics::API::ResourceLoader::StreamerFlush(const usize activeSet)
 			const u32 subRowSize = rowBytes;
 			const std::span<u8> data = upload.Data.subspan(offset);
 
-			if(!dataAlreadyFilled)
+			if(!dataAlreadyFilled && container != nullptr)
 			{
+				//Texture containers already hold tightly packed GPU data (including block compressed formats),
+				//so every row of blocks only needs to be placed at the aligned pitch
+				const std::span<const u8> subresourceData = container->GetSubresourceData(mip, layer);
+				if(subresourceData.size() < NumericCast<usize>(subRowSize) * subNumRows * subDepth)
+					return UploadFunctionResult::InvalidRequest;
+
+				for(u32 z = 0; z < subDepth; ++z)
+				{
+					const std::span<const u8> srcData = subresourceData.subspan(NumericCast<usize>(subRowSize) * subNumRows * z);
+					const std::span<u8> dstData = data.subspan(NumericCast<usize>(subSlicePitch) * z);
+					for(u64 r = 0; r < subNumRows; ++r)
+						std::copy_n(srcData.subspan(r * subRowSize).data(), subRowSize, dstData.subspan(r * subRowPitch).data());
+				}
+			}
+			else if(!dataAlreadyFilled)
+			{
+				const TRAP::Image& image = *(*images)[layer];
+				const std::span<const u8> pixelData = image.GetPixelData();
+
 				for(u32 z = 0; z < subDepth; ++z)
 				{
-					//Convert to RGBA if necessary
-					std::span<const u8> pixelData{};
-					TRAP::Scope<TRAP::Image> RGBAImage = nullptr;
-					if((*images)[layer]->GetColorFormat() == TRAP::Image::ColorFormat::RGB) //Convert RGB to RGBA
+					const std::span<u8> dstData = data.subspan(NumericCast<usize>(subSlicePitch) * z);
+
+					if(image.GetColorFormat() == TRAP::Image::ColorFormat::RGB)
 					{
-						RGBAImage = TRAP::Image::ConvertRGBToRGBA((*images)[layer]);
-						pixelData = RGBAImage->GetPixelData();
+						//Convert RGB to RGBA directly into the staging buffer, row by row
+						const u64 srcRowSize = subRowSize / 4u * 3u;
+						for(u64 r = 0; r < subNumRows; ++r)
+						{
+							TRAP::INTERNAL::ConvertRGBToRGBA(pixelData.subspan(r * srcRowSize, srcRowSize),
+							                                 dstData.subspan(r * subRowPitch, subRowSize),
+							                                 image.GetBytesPerChannel());
+
+							//Opaque alpha for half floats is 1.0 instead of the maximum value
+							if(image.IsHDR() && image.GetBytesPerChannel() == 2)
+							{
+								for(u64 a = 3u * sizeof(u16); a < subRowSize; a += 4u * sizeof(u16))
+									std::memcpy(dstData.subspan(r * subRowPitch + a).data(), &TRAP::INTERNAL::HalfFloatOne, sizeof(u16));
+							}
+						}
 					}
 					else
-						pixelData = (*images)[layer]->GetPixelData();
-
-					const std::span<u8> dstData = data.subspan(NumericCast<usize>(subSlicePitch) * z);
-					for(u64 r = 0; r < subNumRows; ++r)
-						std::copy_n(pixelData.subspan(r * subRowSize).data(), subRowSize, dstData.subspan(r * subRowPitch).data());
+					{
+						for(u64 r = 0; r < subNumRows; ++r)
+							std::copy_n(pixelData.subspan(r * subRowSize).data(), subRowSize, dstData.subspan(r * subRowPitch).data());
+					}
 				}
 			}
 
@@ -1345,7 +1376,8 @@ void TRAP::Graphics::API::ResourceLoader::StreamerFlush(const usize activeSet)
 		}
 	}
 
-	if(RendererAPI::GetRenderAPI() == RenderAPI::Vulkan && texture->GetMipLevels() > 1)
+	//Only generate mip maps that weren't uploaded
+	if(RendererAPI::GetRenderAPI() == RenderAPI::Vulkan && textureUpdateDesc.MipLevels < texture->GetMipLevels())
 		VulkanGenerateMipMaps(*texture, cmd); //Mipmapping via vkCmdBlitImage
 	//D3D12/DirectX 12 would need a compute shader to generate mip maps (as there is no vkCmdBlitImage equivalent)
 	//https://github.com/GPUOpen-Effects/FidelityFX-SPD/blob/master/sample/src/VK/CSDownsampler.glsl
@@ -1410,23 +1442,50 @@ void TRAP::Graphics::API::ResourceLoader::StreamerFlush(const usize activeSet)
 	{
 		if((textureLoadDesc.Filepaths.empty() ||
 			!TRAP::FileSystem::Exists(textureLoadDesc.Filepaths[0]) ||
-			!TRAP::Image::IsSupportedImageFile(textureLoadDesc.Filepaths[0])))
+			(!TRAP::Image::IsSupportedImageFile(textureLoadDesc.Filepaths[0]) &&
+			 !TRAP::TextureContainer::IsSupportedTextureContainerFile(textureLoadDesc.Filepaths[0]))))
 		{
 			supported = false;
 		}
 	}
 
+	//Texture containers (KTX2, DDS) hold GPU ready data which is uploaded as-is
+	TRAP::Scope<TRAP::TextureContainer> container = nullptr;
+	if(textureLoadDesc.Images.empty() && supported &&
+	   TRAP::TextureContainer::IsSupportedTextureContainerFile(textureLoadDesc.Filepaths[0]))
+	{
+		container = TRAP::TextureContainer::LoadFromFile(textureLoadDesc.Filepaths[0]);
+		if(container && container->IsCubemap() != textureLoadDesc.IsCubemap)
+		{
+			TP_ERROR(Log::TexturePrefix, "Texture container ", textureLoadDesc.Filepaths[0],
+			         (textureLoadDesc.IsCubemap ? " doesn't contain a cube map!" : " contains a cube map!"));
+			container = nullptr;
+		}
+		if(container && RendererAPI::GetRenderAPI() == RenderAPI::Vulkan &&
+		   !VulkanRenderer::s_GPUCapBits.CanShaderReadFrom[std::to_underlying(container->GetImageFormat())])
+		{
+			TP_ERROR(Log::TexturePrefix, "Texture container ", textureLoadDesc.Filepaths[0],
+			         " uses an image format which is not supported by the GPU!");
+			container = nullptr;
+		}
+
+		if(!container)
+			supported = false;
+	}
+
 	TextureUpdateDescInternal updateDesc = {};
-	updateDesc.MipsAfterSlice = false; //TODO Change when we support a texture format which holds mips after a slice like KTX
+	updateDesc.MipsAfterSlice = false;
 	TRAP::Graphics::RendererAPI::TextureDesc textureDesc = {};
-	textureDesc.Depth = 1; //TODO Change when we support a texture format that can hold 3D textures like KTX
-	textureDesc.ArraySize = 1; //TODO Change when we support a texture format than can contain multiple images in one file like KTX
+	textureDesc.Depth = 1;
+	textureDesc.ArraySize = 1;
 	textureDesc.Descriptors = RendererAPI::DescriptorType::Texture;
 	textureDesc.SampleCount = RendererAPI::SampleCount::One;
 	textureDesc.StartState = TRAP::Graphics::RendererAPI::ResourceState::Common;
 	textureDesc.Flags |= textureLoadDesc.CreationFlag;
 	if((textureDesc.Flags & RendererAPI::TextureCreationFlags::Storage) != RendererAPI::TextureCreationFlags::None)
 		textureDesc.Descriptors |= RendererAPI::DescriptorType::RWTexture;
+	const TRAP::Image::HDRPrecision hdrPrecision = (textureDesc.Flags & RendererAPI::TextureCreationFlags::HalfFloatHDR) != RendererAPI::TextureCreationFlags::None ?
+	                                               TRAP::Image::HDRPrecision::Float16 : TRAP::Image::HDRPrecision::Float32;
 
 	if(TRAP::Graphics::RendererAPI::GetRenderAPI() == TRAP::Graphics::RenderAPI::Vulkan &&
 	   textureLoadDesc.Desc != nullptr)
@@ -1454,17 +1513,45 @@ void TRAP::Graphics::API::ResourceLoader::StreamerFlush(const usize activeSet)
 				textureDesc.Name = *fileName;
 		}
 
+		if(container)
+		{
+			textureDesc.Format = container->GetImageFormat();
+			textureDesc.Width = container->GetWidth();
+			textureDesc.Height = container->GetHeight();
+			textureDesc.Depth = container->GetDepth();
+			textureDesc.ArraySize = container->GetArraySize();
+			if(container->IsCubemap())
+				textureDesc.Descriptors |= RendererAPI::DescriptorType::TextureCube;
+
+			//Use the pre-built mip chain if there is one, otherwise generate it if possible
+			//(block compressed formats and 3D textures can't be blitted)
+			if(container->GetMipLevels() > 1 || ImageFormatIsCompressed(textureDesc.Format) || textureDesc.Depth > 1)
+				textureDesc.MipLevels = container->GetMipLevels();
+			else
+				textureDesc.MipLevels = TRAP::Graphics::Texture::CalculateMipLevels(textureDesc.Width, textureDesc.Height);
+
+			textureLoadDesc.Texture->Init(textureDesc);
+
+			updateDesc.Texture = textureLoadDesc.Texture;
+			updateDesc.BaseMipLevel = 0;
+			updateDesc.MipLevels = container->GetMipLevels();
+			updateDesc.BaseArrayLayer = 0;
+			updateDesc.LayerCount = textureDesc.ArraySize;
+
+			return UpdateTexture(activeSet, updateDesc, nullptr, container.get());
+		}
+
 		//Handle the different types of textures
 		if(textureLoadDesc.IsCubemap && textureLoadDesc.Filepaths.size() == 6)
 		{
 			if(textureLoadDesc.Images.empty())
 			{
-				//Use file paths
+				//Use file paths, all faces are decoded in parallel
+				std::vector<TRAP::Scope<TRAP::Image>> faceImages = TRAP::Image::LoadFromFiles(textureLoadDesc.Filepaths, hdrPrecision);
 				for(usize i = 0; i < ownedImages.size(); ++i)
 				{
-					ownedImages[i] = TRAP::Image::LoadFromFile(textureLoadDesc.Filepaths[i]);
-					if(ownedImages[i])
-						ptrImages[i] = ownedImages[i].get();
+					ownedImages[i] = std::move(faceImages[i]);
+					ptrImages[i] = ownedImages[i].get();
 				}
 			}
 			else
@@ -1534,7 +1621,7 @@ void TRAP::Graphics::API::ResourceLoader::StreamerFlush(const usize activeSet)
 		{
 			TRAP::Scope<TRAP::Image> baseImg = nullptr;
 			if(textureLoadDesc.Images.empty())
-				baseImg = TRAP::Image::LoadFromFile(textureLoadDesc.Filepaths[0]);
+				baseImg = TRAP::Image::LoadFromFile(textureLoadDesc.Filepaths[0], hdrPrecision);
 			const TRAP::Image* const baseImgPtr = !textureLoadDesc.Images.empty() ? textureLoadDesc.Images[0] : baseImg.get();
 
 			bool valid = true;
@@ -1561,7 +1648,7 @@ void TRAP::Graphics::API::ResourceLoader::StreamerFlush(const usize activeSet)
 			{
 				if(baseImgPtr->IsHDR() && baseImgPtr->GetBytesPerChannel() == 4)
 				    ownedImages = TRAP::Graphics::Texture::SplitImageFromCross<f32>(*baseImgPtr);
-				else if (baseImgPtr->IsLDR() && baseImgPtr->GetBytesPerChannel() == 2)
+				else if (baseImgPtr->GetBytesPerChannel() == 2) //16 bpc or half float HDR
 					ownedImages = TRAP::Graphics::Texture::SplitImageFromCross<u16>(*baseImgPtr);
 				else /*if (baseImgPtr->IsLDR() && baseImgPtr->GetBytesPerChannel() == 1)*/
 					ownedImages = TRAP::Graphics::Texture::SplitImageFromCross<u8>(*baseImgPtr);
@@ -1588,7 +1675,7 @@ void TRAP::Graphics::API::ResourceLoader::StreamerFlush(const usize activeSet)
 		else //if(!textureLoadDesc.IsCubemap) //Normal Texture
 		{
 			if(textureLoadDesc.Images.empty())
-				std::get<0>(ownedImages) = TRAP::Image::LoadFromFile(textureLoadDesc.Filepaths[0]);
+				std::get<0>(ownedImages) = TRAP::Image::LoadFromFile(textureLoadDesc.Filepaths[0], hdrPrecision);
 			std::get<0>(ptrImages) = !textureLoadDesc.Images.empty() ? textureLoadDesc.Images[0] : std::get<0>(ownedImages).get();
 
 			textureDesc.Width = std::get<0>(ptrImages)->GetWidth();
@@ -1599,7 +1686,13 @@ void TRAP::Graphics::API::ResourceLoader::StreamerFlush(const usize activeSet)
 
 		textureDesc.Format = TRAP::Graphics::API::ImageFormat::R8G8B8A8_UNORM;
 
-		if (std::get<0>(ptrImages)->IsHDR() && std::get<0>(ptrImages)->GetColorFormat() == TRAP::Image::ColorFormat::RGB) //RGB HDR (32 bpc) | Will be converted to RGBA before upload
+		if (std::get<0>(ptrImages)->IsHDR() && std::get<0>(ptrImages)->GetBitsPerChannel() == 16 && std::get<0>(ptrImages)->IsImageColored()) //RGB(A) half float HDR (16 bpc) | RGB will be converted to RGBA before upload
+			textureDesc.Format = TRAP::Graphics::API::ImageFormat::R16G16B16A16_SFLOAT;
+		else if (std::get<0>(ptrImages)->IsHDR() && std::get<0>(ptrImages)->GetBitsPerChannel() == 16 && std::get<0>(ptrImages)->GetColorFormat() == TRAP::Image::ColorFormat::GrayScaleAlpha) //GrayScale Alpha half float HDR (16 bpc)
+			textureDesc.Format = TRAP::Graphics::API::ImageFormat::R16G16_SFLOAT;
+		else if (std::get<0>(ptrImages)->IsHDR() && std::get<0>(ptrImages)->GetBitsPerChannel() == 16 && std::get<0>(ptrImages)->GetColorFormat() == TRAP::Image::ColorFormat::GrayScale) //GrayScale half float HDR (16 bpc)
+			textureDesc.Format = TRAP::Graphics::API::ImageFormat::R16_SFLOAT;
+		else if (std::get<0>(ptrImages)->IsHDR() && std::get<0>(ptrImages)->GetColorFormat() == TRAP::Image::ColorFormat::RGB) //RGB HDR (32 bpc) | Will be converted to RGBA before upload
 			textureDesc.Format = TRAP::Graphics::API::ImageFormat::R32G32B32A32_SFLOAT;
 		else if (std::get<0>(ptrImages)->GetBitsPerChannel() == 16 && (std::get<0>(ptrImages)->GetColorFormat() == TRAP::Image::ColorFormat::RGBA || //RGB(A) 16 bpc | Will be converted to RGBA before upload
 				 std::get<0>(ptrImages)->GetColorFormat() == TRAP::Image::ColorFormat::RGB))
@@ -1623,12 +1716,11 @@ void TRAP::Graphics::API::ResourceLoader::StreamerFlush(const usize activeSet)
 
 		updateDesc.Texture = textureLoadDesc.Texture;
 		updateDesc.BaseMipLevel = 0;
-		//updateDesc.MipLevels = textureDesc.MipLevels; //TODO For now every supported format does not support mip levels in file
-		updateDesc.MipLevels = 1;
+		updateDesc.MipLevels = 1; //Images only contain the base level, the remaining levels get generated
 		updateDesc.BaseArrayLayer = 0;
 		updateDesc.LayerCount = textureDesc.ArraySize;
 
-		return UpdateTexture(activeSet, updateDesc, &ptrImages);
+		return UpdateTexture(activeSet, updateDesc, &ptrImages, nullptr);
 	}
 
 	//Fallback to default textures
@@ -1668,12 +1760,11 @@ void TRAP::Graphics::API::ResourceLoader::StreamerFlush(const usize activeSet)
 
 	updateDesc.Texture = textureLoadDesc.Texture;
 	updateDesc.BaseMipLevel = 0;
-	//updateDesc.MipLevels = textureDesc.MipLevels; //TODO For now every supported format does not support mip levels in file
-	updateDesc.MipLevels = 1;
+	updateDesc.MipLevels = 1; //Images only contain the base level, the remaining levels get generated
 	updateDesc.BaseArrayLayer = 0;
 	updateDesc.LayerCount = textureDesc.ArraySize;
 
-	return UpdateTexture(activeSet, updateDesc, &ptrImages);
+	return UpdateTexture(activeSet, updateDesc, &ptrImages, nullptr);
 }
 
 //-------------------------------------------------------------------------------------------------------------------//
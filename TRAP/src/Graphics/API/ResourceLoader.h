@@ -8,6 +8,7 @@
 
 #include "RendererAPI.h"
 #include "ImageLoader/Image.h"
+#include "ImageLoader/TextureContainer.h"
 #include "Maths/Math.h"
 
 namespace TRAP::Graphics
@@ -228,9 +229,11 @@ namespace TRAP::Graphics::API
 		/// @param activeSet Resource set to use.
 		/// @param textureUpdateDesc Description of texture update.
 		/// @param images Images to update.
+		/// @param container Texture container to update from, used instead of images if not nullptr.
 		/// @return Result of upload.
 		[[nodiscard]] UploadFunctionResult UpdateTexture(usize activeSet, const TextureUpdateDescInternal& textureUpdateDesc,
-		                                                 const std::array<const TRAP::Image*, 6>* images);
+		                                                 const std::array<const TRAP::Image*, 6>* images,
+														 const TRAP::TextureContainer* container);
 		/// @brief Load a texture with the specified resource set.
 		/// @param activeSet Resource set to use.
 		/// @param textureUpdate Texture update request.
@@ -518,26 +518,38 @@ requires std::same_as<T, u8> || std::same_as<T, u16> || std::same_as<T, f32>
 		}
 	}
 
+	//Half float HDR faces must stay HDR
+	const auto loadFace = [&image, faceWidth, faceHeight](const std::vector<T>& faceData)
+	{
+		if constexpr(std::same_as<T, u16>)
+		{
+			if(image.IsHDR())
+				return TRAP::Image::LoadHalfFloatFromMemory(faceWidth, faceHeight, image.GetColorFormat(), faceData);
+		}
+
+		return TRAP::Image::LoadFromMemory(faceWidth, faceHeight, image.GetColorFormat(), faceData);
+	};
+
 	std::array<TRAP::Scope<TRAP::Image>, 6> images{};
 
 	//Load Images in correct order
 	if(cxLimit == 4 && cyLimit == 3)
 	{
-		std::get<0>(images) = TRAP::Image::LoadFromMemory(faceWidth, faceHeight, image.GetColorFormat(), std::get<3>(cubeTextureData)); //+X
-		std::get<1>(images) = TRAP::Image::LoadFromMemory(faceWidth, faceHeight, image.GetColorFormat(), std::get<1>(cubeTextureData)); //-X
-		std::get<2>(images) = TRAP::Image::LoadFromMemory(faceWidth, faceHeight, image.GetColorFormat(), std::get<0>(cubeTextureData)); //+Y
-		std::get<3>(images) = TRAP::Image::LoadFromMemory(faceWidth, faceHeight, image.GetColorFormat(), std::get<5>(cubeTextureData)); //-Y
-		std::get<4>(images) = TRAP::Image::LoadFromMemory(faceWidth, faceHeight, image.GetColorFormat(), std::get<2>(cubeTextureData)); //+Z
-		std::get<5>(images) = TRAP::Image::LoadFromMemory(faceWidth, faceHeight, image.GetColorFormat(), std::get<4>(cubeTextureData)); //-Z
+		std::get<0>(images) = loadFace(std::get<3>(cubeTextureData)); //+X
+		std::get<1>(images) = loadFace(std::get<1>(cubeTextureData)); //-X
+		std::get<2>(images) = loadFace(std::get<0>(cubeTextureData)); //+Y
+		std::get<3>(images) = loadFace(std::get<5>(cubeTextureData)); //-Y
+		std::get<4>(images) = loadFace(std::get<2>(cubeTextureData)); //+Z
+		std::get<5>(images) = loadFace(std::get<4>(cubeTextureData)); //-Z
 	}
 	else
 	{
-		std::get<0>(images) = TRAP::Image::LoadFromMemory(faceWidth, faceHeight, image.GetColorFormat(), std::get<2>(cubeTextureData)); //+X
-		std::get<1>(images) = TRAP::Image::LoadFromMemory(faceWidth, faceHeight, image.GetColorFormat(), std::get<5>(cubeTextureData)); //-X
-		std::get<2>(images) = TRAP::Image::Rotate90CounterClockwise(TRAP::Image::LoadFromMemory(faceWidth, faceHeight, image.GetColorFormat(), std::get<0>(cubeTextureData)).get()); //+Y
-		std::get<3>(images) = TRAP::Image::Rotate90Clockwise(TRAP::Image::LoadFromMemory(faceWidth, faceHeight, image.GetColorFormat(), std::get<4>(cubeTextureData)).get()); //-Y
-		std::get<4>(images) = TRAP::Image::LoadFromMemory(faceWidth, faceHeight, image.GetColorFormat(), std::get<1>(cubeTextureData)); //+Z
-		std::get<5>(images) = TRAP::Image::LoadFromMemory(faceWidth, faceHeight, image.GetColorFormat(), std::get<3>(cubeTextureData)); //-Z
+		std::get<0>(images) = loadFace(std::get<2>(cubeTextureData)); //+X
+		std::get<1>(images) = loadFace(std::get<5>(cubeTextureData)); //-X
+		std::get<2>(images) = TRAP::Image::Rotate90CounterClockwise(loadFace(std::get<0>(cubeTextureData)).get()); //+Y
+		std::get<3>(images) = TRAP::Image::Rotate90Clockwise(loadFace(std::get<4>(cubeTextureData)).get()); //-Y
+		std::get<4>(images) = loadFace(std::get<1>(cubeTextureData)); //+Z
+		std::get<5>(images) = loadFace(std::get<3>(cubeTextureData)); //-Z
 	}
 
 	return images;
@@ -2,6 +2,8 @@
 #include "BMPImage.h"
 
 #include "FileSystem/FileSystem.h"
+#include "FileSystem/MappedFile.h"
+#include "Utils/ByteReader.h"
 #include "Maths/Math.h"
 #include "Utils/Memory.h"
 #include "Utils/Utils.h"
@@ -164,19 +166,42 @@ TRAP::INTERNAL::BMPImage::BMPImage(std::filesystem::path filepath)
 	if (!FileSystem::Exists(m_filepath))
 		return;
 
-	std::ifstream file(m_filepath, std::ios::binary);
-	if (!file.is_open())
+	const auto file = FileSystem::MapFile(m_filepath);
+	if (!file)
 	{
 		TP_ERROR(Log::ImageBMPPrefix, "Couldn't open file path: ", m_filepath, "!");
 		TP_WARN(Log::ImageBMPPrefix, "Using default image!");
 		return;
 	}
 
+	Decode(file->GetData());
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+TRAP::INTERNAL::BMPImage::BMPImage(const std::span<const u8> data)
+	: Image("")
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	TP_DEBUG(Log::ImageBMPPrefix, "Loading image from memory");
+
+	Decode(data);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::INTERNAL::BMPImage::Decode(const std::span<const u8> encodedData)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	Utils::ByteReader reader(encodedData);
+
 	Header header{};
-	file.read(reinterpret_cast<char*>(&header.MagicNumber), sizeof(u16));
-	file.read(reinterpret_cast<char*>(&header.Size), sizeof(u32));
-	file.ignore(4);
-	file.read(reinterpret_cast<char*>(&header.DataOffset), sizeof(u32));
+	reader.Read(header.MagicNumber);
+	reader.Read(header.Size);
+	reader.Skip(4);
+	reader.Read(header.DataOffset);
 
 	//File uses little-endian
 	//Convert to machines endian
@@ -189,24 +214,23 @@ TRAP::INTERNAL::BMPImage::BMPImage(std::filesystem::path filepath)
 
 	if (header.MagicNumber != 0x4D42)
 	{
-		file.close();
 		TP_ERROR(Log::ImageBMPPrefix, "Magic number ", header.MagicNumber, " is invalid!");
 		TP_WARN(Log::ImageBMPPrefix, "Using default image!");
 		return;
 	}
 
 	InfoHeader infoHeader{};
-	file.read(reinterpret_cast<char*>(&infoHeader.Size), sizeof(u32));
-	file.read(reinterpret_cast<char*>(&infoHeader.Width), sizeof(u32));
-	file.read(reinterpret_cast<char*>(&infoHeader.Height), sizeof(i32));
-	file.ignore(2);
-	file.read(reinterpret_cast<char*>(&infoHeader.BitsPerPixel), sizeof(u16));
-	file.read(reinterpret_cast<char*>(&infoHeader.Compression), sizeof(u32));
-	file.read(reinterpret_cast<char*>(&infoHeader.SizeImage), sizeof(u32));
-	file.ignore(4);
-	file.ignore(4);
-	file.read(reinterpret_cast<char*>(&infoHeader.CLRUsed), sizeof(u32));
-	file.ignore(4);
+	reader.Read(infoHeader.Size);
+	reader.Read(infoHeader.Width);
+	reader.Read(infoHeader.Height);
+	reader.Skip(2);
+	reader.Read(infoHeader.BitsPerPixel);
+	reader.Read(infoHeader.Compression);
+	reader.Read(infoHeader.SizeImage);
+	reader.Skip(4);
+	reader.Skip(4);
+	reader.Read(infoHeader.CLRUsed);
+	reader.Skip(4);
 
 	if constexpr (Utils::GetEndian() != Utils::Endian::Little)
 	{
@@ -221,7 +245,6 @@ TRAP::INTERNAL::BMPImage::BMPImage(std::filesystem::path filepath)
 
 	if(infoHeader.Size == 12)
 	{
-		file.close();
 		TP_ERROR(Log::ImageBMPPrefix, "OS/2 1.x BMPs are unsupported!");
 		TP_WARN(Log::ImageBMPPrefix, "Using default image!");
 		return;
@@ -232,16 +255,15 @@ TRAP::INTERNAL::BMPImage::BMPImage(std::filesystem::path filepath)
 	{
 		if (infoHeader.Size == 40)
 		{
-			file.close();
 			TP_ERROR(Log::ImageBMPPrefix, "Only BMPV5 images with bit fields are supported!");
 			TP_WARN(Log::ImageBMPPrefix, "Using default image!");
 			return;
 		}
 
-		file.read(reinterpret_cast<char*>(&std::get<0>(masks)), sizeof(u32));
-		file.read(reinterpret_cast<char*>(&std::get<1>(masks)), sizeof(u32));
-		file.read(reinterpret_cast<char*>(&std::get<2>(masks)), sizeof(u32));
-		file.read(reinterpret_cast<char*>(&std::get<3>(masks)), sizeof(u32));
+		reader.Read(std::get<0>(masks));
+		reader.Read(std::get<1>(masks));
+		reader.Read(std::get<2>(masks));
+		reader.Read(std::get<3>(masks));
 
 		if constexpr (Utils::GetEndian() != Utils::Endian::Little)
 		{
@@ -254,7 +276,6 @@ TRAP::INTERNAL::BMPImage::BMPImage(std::filesystem::path filepath)
 
 	if (infoHeader.Width < 1)
 	{
-		file.close();
 		TP_ERROR(Log::ImageBMPPrefix, "Width ", infoHeader.Width, " is invalid!");
 		TP_WARN(Log::ImageBMPPrefix, "Using default image!");
 		return;
@@ -265,7 +286,6 @@ TRAP::INTERNAL::BMPImage::BMPImage(std::filesystem::path filepath)
 		m_height = NumericCast<u32>(Math::Abs(infoHeader.Height));
 	else if (infoHeader.Height == 0)
 	{
-		file.close();
 		TP_ERROR(Log::ImageBMPPrefix, "Height ", infoHeader.Height, " is invalid!");
 		TP_WARN(Log::ImageBMPPrefix, "Using default image!");
 		return;
@@ -280,7 +300,6 @@ TRAP::INTERNAL::BMPImage::BMPImage(std::filesystem::path filepath)
 
 	if(m_bitsPerPixel <= 4)
 	{
-		file.close();
 		TP_ERROR(Log::ImageBMPPrefix, "Bits per pixel ", m_bitsPerPixel, " is unsupported!");
 		TP_WARN(Log::ImageBMPPrefix, "Using default image!");
 		return;
@@ -290,9 +309,8 @@ TRAP::INTERNAL::BMPImage::BMPImage(std::filesystem::path filepath)
 	if (m_bitsPerPixel <= 8 && (infoHeader.CLRUsed != 0u))
 	{
 		colorTable.resize(NumericCast<usize>(4u) * infoHeader.CLRUsed);
-		if(!file.read(reinterpret_cast<char*>(colorTable.data()), 4 * NumericCast<std::streamsize>(infoHeader.CLRUsed)))
+		if(!reader.Read(colorTable))
 		{
-			file.close();
 			TP_ERROR(Log::ImageBMPPrefix, "Couldn't load color map data!");
 			TP_WARN(Log::ImageBMPPrefix, "Using default image!");
 			return;
@@ -318,7 +336,7 @@ TRAP::INTERNAL::BMPImage::BMPImage(std::filesystem::path filepath)
 	}
 
 	//Load Pixel Data(BGRA) into vector
-	file.seekg(header.DataOffset, std::ios::beg);
+	reader.Seek(header.DataOffset);
 	std::vector<u8> imageData{};
 	if ((m_bitsPerPixel != 32 && infoHeader.Compression == 0) &&
 	    4 - (((m_bitsPerPixel / 8) * m_width) % 4) != 4) //Padding
@@ -328,17 +346,15 @@ TRAP::INTERNAL::BMPImage::BMPImage(std::filesystem::path filepath)
 		u32 offset = 0;
 		for (u32 j = 0; j < m_height; j++)
 		{
-			if(!file.read(reinterpret_cast<char*>(imageData.data()) + offset,
-			              NumericCast<std::streamsize>(m_width) * (m_bitsPerPixel / 8)))
+			if(!reader.Read(std::span(imageData).subspan(offset, NumericCast<usize>(m_width) * (m_bitsPerPixel / 8))))
 			{
-				file.close();
 				TP_ERROR(Log::ImageBMPPrefix, "Couldn't load pixel data!");
 				TP_WARN(Log::ImageBMPPrefix, "Using default image!");
 				return;
 			}
 
-			for (u32 pad = 0; pad < padding; pad++)
-				file.ignore();
+			//Padding of the last row may be missing
+			reader.Skip(Math::Min<usize>(padding, reader.GetRemainingSize()));
 
 			offset += m_width * (m_bitsPerPixel / 8);
 		}
@@ -348,10 +364,8 @@ TRAP::INTERNAL::BMPImage::BMPImage(std::filesystem::path filepath)
 		if (infoHeader.Compression != 1)
 		{
 			imageData.resize(NumericCast<usize>(m_width) * m_height * (m_bitsPerPixel / 8));
-			if(!file.read(reinterpret_cast<char*>(imageData.data()),
-						  NumericCast<std::streamsize>(m_width) * m_height * (m_bitsPerPixel / 8)))
+			if(!reader.Read(imageData))
 			{
-				file.close();
 				TP_ERROR(Log::ImageBMPPrefix, "Couldn't load pixel data!");
 				TP_WARN(Log::ImageBMPPrefix, "Using default image!");
 				return;
@@ -360,9 +374,8 @@ TRAP::INTERNAL::BMPImage::BMPImage(std::filesystem::path filepath)
 		else
 		{
 			imageData.resize(infoHeader.SizeImage);
-			if (!file.read(reinterpret_cast<char*>(imageData.data()), infoHeader.SizeImage))
+			if (!reader.Read(imageData))
 			{
-				file.close();
 				TP_ERROR(Log::ImageBMPPrefix, "Couldn't load pixel data!");
 				TP_WARN(Log::ImageBMPPrefix, "Using default image!");
 				return;
@@ -370,7 +383,6 @@ TRAP::INTERNAL::BMPImage::BMPImage(std::filesystem::path filepath)
 		}
 	}
 
-	file.close();
 
 	if (infoHeader.Compression == 0) //Uncompressed
 	{
@@ -404,7 +416,7 @@ TRAP::INTERNAL::BMPImage::BMPImage(std::filesystem::path filepath)
 		else if (m_bitsPerPixel == 24) //RGB
 		{
 			m_colorFormat = ColorFormat::RGB;
-			m_data = ConvertBGR24ToRGB24(imageData, m_width, m_height);
+			m_data = ConvertBGR24ToRGB24(std::move(imageData), m_width, m_height);
 		}
 		else if (m_bitsPerPixel == 32) //RGBA
 		{
@@ -428,7 +440,7 @@ TRAP::INTERNAL::BMPImage::BMPImage(std::filesystem::path filepath)
 					imageData[i] = 255;
 			}
 
-			m_data = ConvertBGRA32ToRGBA32(imageData, m_width, m_height);
+			m_data = ConvertBGRA32ToRGBA32(std::move(imageData), m_width, m_height);
 		}
 	}
 	else if (infoHeader.Compression == 1) //Microsoft RLE 8
@@ -541,5 +553,5 @@ TRAP::INTERNAL::BMPImage::BMPImage(std::filesystem::path filepath)
 	}
 
 	if (needYFlip)
-		m_data = FlipY<u8>(m_width, m_height, m_colorFormat, m_data);
+		INTERNAL::FlipPixelsY(m_data, m_data, m_width, m_height, std::to_underlying(m_colorFormat));
 }
@@ -11,6 +11,9 @@ namespace TRAP::INTERNAL
 		/// @brief Constructor.
 		/// @param filepath File path of the image to load.
 		explicit BMPImage(std::filesystem::path filepath);
+		/// @brief Constructor.
+		/// @param data Encoded image data to load.
+		explicit BMPImage(std::span<const u8> data);
 		/// @brief Copy constructor.
 		BMPImage(const BMPImage&) noexcept = default;
 		/// @brief Copy assignment operator.
@@ -27,6 +30,10 @@ namespace TRAP::INTERNAL
 		[[nodiscard]] constexpr std::span<const u8> GetPixelData() const noexcept override;
 
 	private:
+		/// @brief Decode the image.
+		/// @param encodedData Encoded image data.
+		void Decode(std::span<const u8> encodedData);
+
 		/// @brief Decode run length encoded 8-bit BMP data.
 		/// @param compressedImageData Compressed image data.
 		/// @param colorTable Color table.
@@ -14,10 +14,11 @@ namespace TRAP::INTERNAL
 		/// @param height Height for the image.
 		/// @param format Color format of the pixel data.
 		/// @param pixelData Raw pixel data.
+		/// @param isHalfFloat Whether u16 pixel data holds HDR half precision floats instead of normalized integers.
 		template<typename T>
 		requires std::same_as<T, u8> || std::same_as<T, u16> || std::same_as<T, f32>
 		CustomImage(std::filesystem::path filepath, u32 width, u32 height, ColorFormat format,
-		            std::vector<T> pixelData);
+		            std::vector<T> pixelData, bool isHalfFloat = false);
 		/// @brief Copy constructor.
 		CustomImage(const CustomImage&) noexcept = default;
 		/// @brief Copy assignment operator.
@@ -43,7 +44,7 @@ namespace TRAP::INTERNAL
 template<typename T>
 requires std::same_as<T, u8> || std::same_as<T, u16> || std::same_as<T, f32>
 TRAP::INTERNAL::CustomImage::CustomImage(std::filesystem::path filepath, const u32 width, const u32 height,
-                                         const ColorFormat format, std::vector<T> pixelData)
+                                         const ColorFormat format, std::vector<T> pixelData, const bool isHalfFloat)
 	: Image(std::move(filepath), width, height, format)
 {
 	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
@@ -58,6 +59,7 @@ TRAP::INTERNAL::CustomImage::CustomImage(std::filesystem::path filepath, const u
 		TRAP_ASSERT(false, "CustomImage(): Invalid pixel data provided!");
 		return;
 	}
+	TRAP_ASSERT(!isHalfFloat || std::same_as<T, u16>, "CustomImage(): Half floats require u16 pixel data!");
 
 	m_bitsPerPixel = sizeof(T) * 8u * std::to_underlying(m_colorFormat);
 
@@ -68,7 +70,7 @@ TRAP::INTERNAL::CustomImage::CustomImage(std::filesystem::path filepath, const u
 	}
 	else if constexpr (std::same_as<T, u16>)
 	{
-		m_isHDR = false;
+		m_isHDR = isHalfFloat;
 		m_data2Byte = std::move(pixelData);
 	}
 	else
@@ -0,0 +1,361 @@
+#include "TRAPPCH.h"
+#include "DDSContainer.h"
+
+#include "FileSystem/FileSystem.h"
+#include "FileSystem/MappedFile.h"
+#include "Utils/ByteReader.h"
+#include "Utils/Memory.h"
+#include "Utils/Utils.h"
+
+namespace
+{
+	[[nodiscard]] consteval u32 MakeFourCC(const char a, const char b, const char c, const char d) noexcept
+	{
+		return static_cast<u32>(a) | (static_cast<u32>(b) << 8u) | (static_cast<u32>(c) << 16u) | (static_cast<u32>(d) << 24u);
+	}
+
+	constexpr u32 DDSD_CAPS = 0x1;
+	constexpr u32 DDSD_HEIGHT = 0x2;
+	constexpr u32 DDSD_WIDTH = 0x4;
+	constexpr u32 DDSD_PIXELFORMAT = 0x1000;
+	constexpr u32 DDSD_MIPMAPCOUNT = 0x20000;
+	constexpr u32 DDSD_LINEARSIZE = 0x80000;
+	constexpr u32 DDSD_DEPTH = 0x800000;
+
+	constexpr u32 DDPF_ALPHAPIXELS = 0x1;
+	constexpr u32 DDPF_FOURCC = 0x4;
+	constexpr u32 DDPF_RGB = 0x40;
+	constexpr u32 DDPF_LUMINANCE = 0x20000;
+
+	constexpr u32 DDSCAPS_COMPLEX = 0x8;
+	constexpr u32 DDSCAPS_TEXTURE = 0x1000;
+	constexpr u32 DDSCAPS_MIPMAP = 0x400000;
+
+	constexpr u32 DDSCAPS2_CUBEMAP = 0x200;
+	constexpr u32 DDSCAPS2_CUBEMAP_ALLFACES = 0xFC00;
+	constexpr u32 DDSCAPS2_VOLUME = 0x200000;
+
+	constexpr u32 D3D10_RESOURCE_DIMENSION_TEXTURE2D = 3;
+	constexpr u32 D3D10_RESOURCE_DIMENSION_TEXTURE3D = 4;
+	constexpr u32 D3D10_RESOURCE_MISC_TEXTURECUBE = 0x4;
+	constexpr u32 DDS_ALPHA_MODE_MASK = 0x7;
+	constexpr u32 DDS_ALPHA_MODE_OPAQUE = 0x3;
+
+	/// @brief Convert a legacy (non DX10) pixel format to an image format.
+	/// @param fourCC FourCC code, 0 if not used.
+	/// @param flags Pixel format flags.
+	/// @param bitCount Bits per pixel for uncompressed data.
+	/// @param masks Red, green, blue and alpha bit masks for uncompressed data.
+	/// @return Image format, ImageFormat::Undefined if the format is not supported.
+	[[nodiscard]] constexpr TRAP::Graphics::API::ImageFormat LegacyPixelFormatToImageFormat(const u32 fourCC, const u32 flags,
+	                                                                                       const u32 bitCount,
+	                                                                                       const std::array<u32, 4>& masks) noexcept
+	{
+		using TRAP::Graphics::API::ImageFormat;
+
+		if((flags & DDPF_FOURCC) != 0u)
+		{
+			switch(fourCC)
+			{
+			case MakeFourCC('D', 'X', 'T', '1'): return ImageFormat::DXBC1_RGBA_UNORM;
+			case MakeFourCC('D', 'X', 'T', '2'): [[fallthrough]];
+			case MakeFourCC('D', 'X', 'T', '3'): return ImageFormat::DXBC2_UNORM;
+			case MakeFourCC('D', 'X', 'T', '4'): [[fallthrough]];
+			case MakeFourCC('D', 'X', 'T', '5'): return ImageFormat::DXBC3_UNORM;
+			case MakeFourCC('A', 'T', 'I', '1'): [[fallthrough]];
+			case MakeFourCC('B', 'C', '4', 'U'): return ImageFormat::DXBC4_UNORM;
+			case MakeFourCC('B', 'C', '4', 'S'): return ImageFormat::DXBC4_SNORM;
+			case MakeFourCC('A', 'T', 'I', '2'): [[fallthrough]];
+			case MakeFourCC('B', 'C', '5', 'U'): return ImageFormat::DXBC5_UNORM;
+			case MakeFourCC('B', 'C', '5', 'S'): return ImageFormat::DXBC5_SNORM;
+			case 113: return ImageFormat::R16G16B16A16_SFLOAT; //D3DFMT_A16B16G16R16F
+			case 116: return ImageFormat::R32G32B32A32_SFLOAT; //D3DFMT_A32B32G32R32F
+			default: return ImageFormat::Undefined;
+			}
+		}
+
+		if((flags & DDPF_RGB) != 0u && bitCount == 32)
+		{
+			if(masks == std::array<u32, 4>{0x000000FF, 0x0000FF00, 0x00FF0000, 0xFF000000})
+				return ImageFormat::R8G8B8A8_UNORM;
+			if(masks == std::array<u32, 4>{0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000})
+				return ImageFormat::B8G8R8A8_UNORM;
+		}
+		else if((flags & DDPF_LUMINANCE) != 0u && (flags & DDPF_ALPHAPIXELS) == 0u && bitCount == 8)
+			return ImageFormat::R8_UNORM;
+
+		return ImageFormat::Undefined;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+TRAP::INTERNAL::DDSContainer::DDSContainer(std::filesystem::path filepath)
+	: TextureContainer(std::move(filepath))
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	TP_DEBUG(Log::ImageDDSPrefix, "Loading texture container: ", m_filepath);
+
+	if(!FileSystem::Exists(m_filepath))
+		return;
+
+	m_file = FileSystem::MapFile(m_filepath);
+	if(!m_file)
+	{
+		TP_ERROR(Log::ImageDDSPrefix, "Couldn't open file path: ", m_filepath, "!");
+		return;
+	}
+
+	Decode(m_file->GetData());
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+TRAP::INTERNAL::DDSContainer::DDSContainer(const std::span<const u8> data)
+	: TextureContainer("")
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	TP_DEBUG(Log::ImageDDSPrefix, "Loading texture container from memory");
+
+	m_data.assign(data.begin(), data.end());
+	Decode(m_data);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::INTERNAL::DDSContainer::Decode(const std::span<const u8> data)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	if(data.size() < HeaderSize)
+	{
+		TP_ERROR(Log::ImageDDSPrefix, "File size is too small: ", m_filepath, "!");
+		return;
+	}
+
+	Utils::ByteReader reader(data);
+
+	Header header{};
+	reader.Read(header.MagicNumber);
+	reader.Read(header.Size);
+	reader.Read(header.Flags);
+	reader.Read(header.Height);
+	reader.Read(header.Width);
+	reader.Read(header.PitchOrLinearSize);
+	reader.Read(header.Depth);
+	reader.Read(header.MipMapCount);
+	reader.Skip(11 * sizeof(u32)); //Reserved
+	reader.Read(header.Format.Size);
+	reader.Read(header.Format.Flags);
+	reader.Read(header.Format.FourCC);
+	reader.Read(header.Format.RGBBitCount);
+	reader.Read(header.Format.RBitMask);
+	reader.Read(header.Format.GBitMask);
+	reader.Read(header.Format.BBitMask);
+	reader.Read(header.Format.ABitMask);
+	reader.Read(header.Caps);
+	reader.Read(header.Caps2);
+	reader.Seek(HeaderSize);
+
+	//Magic number must be "DDS "
+	const std::string_view magicNumber(reinterpret_cast<const char*>(header.MagicNumber.data()), header.MagicNumber.size());
+	if(magicNumber != "DDS ")
+	{
+		TP_ERROR(Log::ImageDDSPrefix, "Invalid magic number: ", magicNumber, "!");
+		return;
+	}
+
+	//Convert to machines endian
+	if constexpr (Utils::GetEndian() != Utils::Endian::Little)
+	{
+		for(u32* const value : {&header.Size, &header.Flags, &header.Height, &header.Width, &header.PitchOrLinearSize,
+		                        &header.Depth, &header.MipMapCount, &header.Format.Size, &header.Format.Flags,
+								&header.Format.FourCC, &header.Format.RGBBitCount, &header.Format.RBitMask,
+								&header.Format.GBitMask, &header.Format.BBitMask, &header.Format.ABitMask,
+								&header.Caps, &header.Caps2})
+		{
+			Utils::Memory::SwapBytes(*value);
+		}
+	}
+
+	if(header.Size != 124 || header.Format.Size != 32)
+	{
+		TP_ERROR(Log::ImageDDSPrefix, "Invalid header size!");
+		return;
+	}
+
+	m_width = header.Width;
+	m_height = header.Height;
+	m_depth = 1;
+	m_arraySize = 1;
+	m_mipLevels = (header.Flags & DDSD_MIPMAPCOUNT) != 0u ? std::max(header.MipMapCount, 1u) : 1u;
+
+	if((header.Format.Flags & DDPF_FOURCC) != 0u && header.Format.FourCC == MakeFourCC('D', 'X', '1', '0'))
+	{
+		HeaderDX10 headerDX10{};
+		reader.Read(headerDX10.DXGIFormat);
+		reader.Read(headerDX10.ResourceDimension);
+		reader.Read(headerDX10.MiscFlag);
+		reader.Read(headerDX10.ArraySize);
+		reader.Read(headerDX10.MiscFlags2);
+
+		if(reader.HasFailed())
+		{
+			TP_ERROR(Log::ImageDDSPrefix, "File size is too small: ", m_filepath, "!");
+			return;
+		}
+
+		if constexpr (Utils::GetEndian() != Utils::Endian::Little)
+		{
+			for(u32* const value : {&headerDX10.DXGIFormat, &headerDX10.ResourceDimension, &headerDX10.MiscFlag,
+			                        &headerDX10.ArraySize, &headerDX10.MiscFlags2})
+			{
+				Utils::Memory::SwapBytes(*value);
+			}
+		}
+
+		m_format = DXGIFormatToImageFormat(headerDX10.DXGIFormat);
+		if(m_format == Graphics::API::ImageFormat::Undefined)
+		{
+			TP_ERROR(Log::ImageDDSPrefix, "Unsupported DXGI format (", headerDX10.DXGIFormat, ")!");
+			return;
+		}
+
+		//DXGI has no BC1 format without alpha, opaque alpha mode marks it instead
+		if((headerDX10.MiscFlags2 & DDS_ALPHA_MODE_MASK) == DDS_ALPHA_MODE_OPAQUE)
+		{
+			if(m_format == Graphics::API::ImageFormat::DXBC1_RGBA_UNORM)
+				m_format = Graphics::API::ImageFormat::DXBC1_RGB_UNORM;
+			else if(m_format == Graphics::API::ImageFormat::DXBC1_RGBA_SRGB)
+				m_format = Graphics::API::ImageFormat::DXBC1_RGB_SRGB;
+		}
+
+		if(headerDX10.ResourceDimension == D3D10_RESOURCE_DIMENSION_TEXTURE3D)
+			m_depth = std::max(header.Depth, 1u);
+
+		m_isCubemap = (headerDX10.MiscFlag & D3D10_RESOURCE_MISC_TEXTURECUBE) != 0u;
+		m_arraySize = std::max(headerDX10.ArraySize, 1u) * (m_isCubemap ? 6u : 1u);
+	}
+	else
+	{
+		m_format = LegacyPixelFormatToImageFormat(header.Format.FourCC, header.Format.Flags, header.Format.RGBBitCount,
+		                                          {header.Format.RBitMask, header.Format.GBitMask,
+												   header.Format.BBitMask, header.Format.ABitMask});
+		if(m_format == Graphics::API::ImageFormat::Undefined)
+		{
+			TP_ERROR(Log::ImageDDSPrefix, "Unsupported pixel format!");
+			return;
+		}
+
+		if((header.Caps2 & DDSCAPS2_CUBEMAP) != 0u)
+		{
+			if((header.Caps2 & DDSCAPS2_CUBEMAP_ALLFACES) != DDSCAPS2_CUBEMAP_ALLFACES)
+			{
+				TP_ERROR(Log::ImageDDSPrefix, "Cube maps with missing faces are not supported!");
+				return;
+			}
+
+			m_isCubemap = true;
+			m_arraySize = 6;
+		}
+		else if((header.Caps2 & DDSCAPS2_VOLUME) != 0u && (header.Flags & DDSD_DEPTH) != 0u)
+			m_depth = std::max(header.Depth, 1u);
+	}
+
+	//Every subresource is at least a single byte, this also prevents huge allocations for corrupted headers
+	if(m_width < 1 || m_height < 1 || m_mipLevels > std::bit_width(std::max({m_width, m_height, m_depth})) ||
+	   NumericCast<u64>(m_mipLevels) * m_arraySize > data.size())
+	{
+		TP_ERROR(Log::ImageDDSPrefix, "Invalid dimensions (", m_width, "x", m_height, "x", m_depth, ", ", m_arraySize,
+		         " layers, ", m_mipLevels, " mip levels)!");
+		return;
+	}
+
+	//Unlike KTX2 every layer (or face) stores its whole mip chain before the next layer
+	m_subresources.resize(NumericCast<usize>(m_mipLevels) * m_arraySize);
+	u64 offset = reader.GetPosition();
+	for(u32 layer = 0; layer < m_arraySize; ++layer)
+	{
+		for(u32 mip = 0; mip < m_mipLevels; ++mip)
+		{
+			const u64 subresourceSize = CalculateSubresourceSize(m_format, std::max(m_width >> mip, 1u), std::max(m_height >> mip, 1u),
+			                                                     std::max(m_depth >> mip, 1u));
+			m_subresources[NumericCast<usize>(mip) * m_arraySize + layer] = Subresource{.Offset = offset, .Size = subresourceSize};
+			offset += subresourceSize;
+		}
+	}
+
+	if(!Validate(Log::ImageDDSPrefix))
+		m_subresources.clear();
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] std::vector<u8> TRAP::INTERNAL::DDSContainer::Encode(const Graphics::API::ImageFormat format, const u32 width,
+                                                                  const u32 height, const std::span<const std::vector<u8>> mipLevels)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	const u32 dxgiFormat = ImageFormatToDXGIFormat(format);
+	if(dxgiFormat == 0 || width == 0 || height == 0 || mipLevels.empty() ||
+	   mipLevels.size() > std::bit_width(std::max(width, height)))
+	{
+		TP_ERROR(Log::ImageDDSPrefix, "Unable to encode texture with format ", std::to_underlying(format), " (",
+		         width, "x", height, ", ", mipLevels.size(), " mip levels)!");
+		return {};
+	}
+
+	usize dataSize = 0;
+	for(usize mip = 0; mip < mipLevels.size(); ++mip)
+	{
+		const u64 expectedSize = CalculateSubresourceSize(format, std::max(width >> mip, 1u), std::max(height >> mip, 1u), 1);
+		if(mipLevels[mip].size() != expectedSize)
+		{
+			TP_ERROR(Log::ImageDDSPrefix, "Data of mip level ", mip, " has an invalid size!");
+			return {};
+		}
+		dataSize += mipLevels[mip].size();
+	}
+
+	std::vector<u8> result{};
+	result.reserve(HeaderSize + HeaderDX10Size + dataSize);
+
+	const auto WriteU32 = [&result](const u32 value)
+	{
+		for(u32 i = 0; i < 4; ++i)
+			result.push_back(static_cast<u8>((value >> (i * 8u)) & 0xFFu));
+	};
+
+	const u32 mipMapCount = NumericCast<u32>(mipLevels.size());
+
+	result.insert(result.end(), {'D', 'D', 'S', ' '});
+	WriteU32(124); //Size
+	WriteU32(DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT | DDSD_MIPMAPCOUNT | DDSD_LINEARSIZE);
+	WriteU32(height);
+	WriteU32(width);
+	WriteU32(NumericCast<u32>(mipLevels[0].size())); //PitchOrLinearSize
+	WriteU32(0); //Depth
+	WriteU32(mipMapCount);
+	result.resize(result.size() + 11 * sizeof(u32), 0); //Reserved
+	WriteU32(32); //PixelFormat.Size
+	WriteU32(DDPF_FOURCC);
+	WriteU32(MakeFourCC('D', 'X', '1', '0'));
+	result.resize(result.size() + 5 * sizeof(u32), 0); //RGBBitCount and bit masks
+	WriteU32(DDSCAPS_TEXTURE | (mipMapCount > 1 ? (DDSCAPS_COMPLEX | DDSCAPS_MIPMAP) : 0u));
+	result.resize(result.size() + 4 * sizeof(u32), 0); //Caps2, Caps3, Caps4, Reserved2
+
+	WriteU32(dxgiFormat);
+	WriteU32(D3D10_RESOURCE_DIMENSION_TEXTURE2D);
+	WriteU32(0); //MiscFlag
+	WriteU32(1); //ArraySize
+	const bool isBC1RGB = format == Graphics::API::ImageFormat::DXBC1_RGB_UNORM ||
+	                      format == Graphics::API::ImageFormat::DXBC1_RGB_SRGB;
+	WriteU32(isBC1RGB ? DDS_ALPHA_MODE_OPAQUE : 0u); //MiscFlags2
+
+	for(const std::vector<u8>& mipLevel : mipLevels)
+		result.insert(result.end(), mipLevel.begin(), mipLevel.end());
+
+	return result;
+}
@@ -0,0 +1,162 @@
+#ifndef TRAP_DDSCONTAINER_H
+#define TRAP_DDSCONTAINER_H
+
+#include "ImageLoader/TextureContainer.h"
+
+namespace TRAP::INTERNAL
+{
+	/// @brief DirectDraw Surface (DDS) container.
+	/// @note Legacy headers are supported for DXT1-5, ATI1/2 and 8 bit RGBA/BGRA/luminance data,
+	///       DX10 headers are required for everything else.
+	class DDSContainer final : public TextureContainer
+	{
+	public:
+		/// @brief Constructor.
+		/// @param filepath File path of the container to load.
+		explicit DDSContainer(std::filesystem::path filepath);
+		/// @brief Constructor.
+		/// @param data Encoded container data to load.
+		explicit DDSContainer(std::span<const u8> data);
+		/// @brief Copy constructor.
+		consteval DDSContainer(const DDSContainer&) = delete;
+		/// @brief Copy assignment operator.
+		consteval DDSContainer& operator=(const DDSContainer&) = delete;
+		/// @brief Move constructor.
+		DDSContainer(DDSContainer&&) noexcept = default;
+		/// @brief Move assignment operator.
+		DDSContainer& operator=(DDSContainer&&) noexcept = default;
+		/// @brief Destructor.
+		~DDSContainer() override = default;
+
+		/// @brief Convert a DXGI_FORMAT value to an image format.
+		/// @param dxgiFormat DXGI_FORMAT value.
+		/// @return Image format, ImageFormat::Undefined if the format is not supported.
+		[[nodiscard]] static constexpr Graphics::API::ImageFormat DXGIFormatToImageFormat(u32 dxgiFormat) noexcept;
+		/// @brief Convert an image format to a DXGI_FORMAT value.
+		/// @param format Image format.
+		/// @return DXGI_FORMAT value, 0 (DXGI_FORMAT_UNKNOWN) if the format has no equivalent.
+		[[nodiscard]] static constexpr u32 ImageFormatToDXGIFormat(Graphics::API::ImageFormat format) noexcept;
+
+		/// @brief Encode a 2D texture as DDS with a DX10 header.
+		/// @param format Image format, must have a DXGI_FORMAT equivalent.
+		/// @param width Width of the base level.
+		/// @param height Height of the base level.
+		/// @param mipLevels Tightly packed data of every mip level, starting with the base level.
+		/// @return Encoded DDS data, empty on error.
+		[[nodiscard]] static std::vector<u8> Encode(Graphics::API::ImageFormat format, u32 width, u32 height,
+		                                            std::span<const std::vector<u8>> mipLevels);
+
+	private:
+		/// @brief Decode the container.
+		/// @param data Encoded container data.
+		void Decode(std::span<const u8> data);
+
+		/// @brief Size of the magic number and header in the file.
+		static constexpr usize HeaderSize = 4 + 124;
+		/// @brief Size of the DX10 header extension in the file.
+		static constexpr usize HeaderDX10Size = 20;
+
+		struct PixelFormat
+		{
+			u32 Size = 0;
+			u32 Flags = 0;
+			u32 FourCC = 0;
+			u32 RGBBitCount = 0;
+			u32 RBitMask = 0;
+			u32 GBitMask = 0;
+			u32 BBitMask = 0;
+			u32 ABitMask = 0;
+		};
+
+		struct Header
+		{
+			std::array<u8, 4> MagicNumber{};
+			u32 Size = 0;
+			u32 Flags = 0;
+			u32 Height = 0;
+			u32 Width = 0;
+			u32 PitchOrLinearSize = 0;
+			u32 Depth = 0;
+			u32 MipMapCount = 0;
+			PixelFormat Format{};
+			u32 Caps = 0;
+			u32 Caps2 = 0;
+		};
+
+		struct HeaderDX10
+		{
+			u32 DXGIFormat = 0;
+			u32 ResourceDimension = 0;
+			u32 MiscFlag = 0;
+			u32 ArraySize = 0;
+			u32 MiscFlags2 = 0;
+		};
+	};
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] constexpr TRAP::Graphics::API::ImageFormat TRAP::INTERNAL::DDSContainer::DXGIFormatToImageFormat(const u32 dxgiFormat) noexcept
+{
+	using Graphics::API::ImageFormat;
+
+	//Values of the DXGI_FORMAT enum
+	switch(dxgiFormat)
+	{
+	case 2: return ImageFormat::R32G32B32A32_SFLOAT;
+	case 10: return ImageFormat::R16G16B16A16_SFLOAT;
+	case 11: return ImageFormat::R16G16B16A16_UNORM;
+	case 16: return ImageFormat::R32G32_SFLOAT;
+	case 26: return ImageFormat::B10G11R11_UFLOAT;
+	case 28: return ImageFormat::R8G8B8A8_UNORM;
+	case 29: return ImageFormat::R8G8B8A8_SRGB;
+	case 34: return ImageFormat::R16G16_SFLOAT;
+	case 35: return ImageFormat::R16G16_UNORM;
+	case 41: return ImageFormat::R32_SFLOAT;
+	case 49: return ImageFormat::R8G8_UNORM;
+	case 54: return ImageFormat::R16_SFLOAT;
+	case 56: return ImageFormat::R16_UNORM;
+	case 61: return ImageFormat::R8_UNORM;
+	case 67: return ImageFormat::E5B9G9R9_UFLOAT;
+	case 71: return ImageFormat::DXBC1_RGBA_UNORM;
+	case 72: return ImageFormat::DXBC1_RGBA_SRGB;
+	case 74: return ImageFormat::DXBC2_UNORM;
+	case 75: return ImageFormat::DXBC2_SRGB;
+	case 77: return ImageFormat::DXBC3_UNORM;
+	case 78: return ImageFormat::DXBC3_SRGB;
+	case 80: return ImageFormat::DXBC4_UNORM;
+	case 81: return ImageFormat::DXBC4_SNORM;
+	case 83: return ImageFormat::DXBC5_UNORM;
+	case 84: return ImageFormat::DXBC5_SNORM;
+	case 87: return ImageFormat::B8G8R8A8_UNORM;
+	case 91: return ImageFormat::B8G8R8A8_SRGB;
+	case 95: return ImageFormat::DXBC6H_UFLOAT;
+	case 96: return ImageFormat::DXBC6H_SFLOAT;
+	case 98: return ImageFormat::DXBC7_UNORM;
+	case 99: return ImageFormat::DXBC7_SRGB;
+	default: return ImageFormat::Undefined;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] constexpr u32 TRAP::INTERNAL::DDSContainer::ImageFormatToDXGIFormat(const Graphics::API::ImageFormat format) noexcept
+{
+	using Graphics::API::ImageFormat;
+
+	//DXGI has no BC1 format without alpha, the alpha variant decodes opaque blocks the same way
+	if(format == ImageFormat::DXBC1_RGB_UNORM)
+		return 71;
+	if(format == ImageFormat::DXBC1_RGB_SRGB)
+		return 72;
+
+	for(u32 dxgiFormat = 1; dxgiFormat <= 99; ++dxgiFormat)
+	{
+		if(DXGIFormatToImageFormat(dxgiFormat) == format)
+			return dxgiFormat;
+	}
+
+	return 0;
+}
+
+#endif /*TRAP_DDSCONTAINER_H*/
@@ -2,6 +2,7 @@
 #include "Image.h"
 
 #include "FileSystem/FileSystem.h"
+#include "ThreadPool/Parallel.h"
 #include "Utils/String/String.h"
 
 #include "PortableMaps/PGMImage.h"
@@ -17,6 +18,66 @@
 #include "CustomImage.h"
 #include "Embed.h"
 
+namespace
+{
+	/// @brief Create a new image from the pixel data of the given image transformed by a pixel transform.
+	/// @tparam T Channel type of the image.
+	/// @param img Source image.
+	/// @param width Width of the transformed image.
+	/// @param height Height of the transformed image.
+	/// @param transform Pixel transform, called with (src, dst, width, height, bytesPerPixel) of the source image.
+	/// @return Transformed image.
+	template<typename T>
+	[[nodiscard]] TRAP::Scope<TRAP::Image> TransformImage(const TRAP::Image& img, const u32 width, const u32 height,
+	                                                      void (*const transform)(std::span<const u8>, std::span<u8>, u32, u32, u32))
+	{
+		std::vector<T> data(img.GetPixelData().size() / sizeof(T));
+		transform(img.GetPixelData(), std::span<u8>(reinterpret_cast<u8*>(data.data()), data.size() * sizeof(T)),
+		          img.GetWidth(), img.GetHeight(), img.GetBitsPerPixel() / 8u);
+
+		return TRAP::MakeScope<TRAP::INTERNAL::CustomImage>("", width, height, img.GetColorFormat(), std::move(data),
+		                                                    std::same_as<T, u16> && img.IsHDR());
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Create a new image from the pixel data of the given image transformed by a pixel transform.
+	/// @param img Source image.
+	/// @param width Width of the transformed image.
+	/// @param height Height of the transformed image.
+	/// @param transform Pixel transform, called with (src, dst, width, height, bytesPerPixel) of the source image.
+	/// @return Transformed image.
+	[[nodiscard]] TRAP::Scope<TRAP::Image> TransformImage(const TRAP::Image& img, const u32 width, const u32 height,
+	                                                      void (*const transform)(std::span<const u8>, std::span<u8>, u32, u32, u32))
+	{
+		if(img.IsHDR() && img.GetBytesPerChannel() == 4)
+			return TransformImage<f32>(img, width, height, transform);
+		if(img.GetBytesPerChannel() == 2) //Also covers half float HDR images
+			return TransformImage<u16>(img, width, height, transform);
+
+		return TransformImage<u8>(img, width, height, transform);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Wait until the given image has been decoded, helping the ThreadPool with its pending tasks meanwhile.
+	/// @param threadPool ThreadPool the image was enqueued to.
+	/// @param result Future of the image.
+	void WaitForImage(TRAP::ThreadPool& threadPool, const std::future<TRAP::Scope<TRAP::Image>>& result)
+	{
+		while(result.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+		{
+			if(!threadPool.TryRunPendingTask())
+			{
+				//Nothing left to help with, the image is being decoded by another thread
+				result.wait();
+			}
+		}
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
 [[nodiscard]] const std::filesystem::path& TRAP::Image::GetFilePath() const noexcept
 {
 	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None &&
@@ -29,7 +90,8 @@
 //-------------------------------------------------------------------------------------------------------------------//
 //-------------------------------------------------------------------------------------------------------------------//
 
-[[nodiscard]] TRAP::Scope<TRAP::Image> TRAP::Image::LoadFromFile(const std::filesystem::path& filepath)
+[[nodiscard]] TRAP::Scope<TRAP::Image> TRAP::Image::LoadFromFile(const std::filesystem::path& filepath,
+                                                                 const HDRPrecision hdrPrecision)
 {
 	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
 
@@ -57,7 +119,7 @@
 	else if (fileFormat == ".pam")
 		result = MakeScope<INTERNAL::PAMImage>(filepath);
 	else if (fileFormat == ".pfm")
-		result = MakeScope<INTERNAL::PFMImage>(filepath);
+		result = MakeScope<INTERNAL::PFMImage>(filepath, hdrPrecision);
 	else if (fileFormat == ".tga" || fileFormat == ".icb" || fileFormat == ".vda" || fileFormat == ".vst")
 		result = MakeScope<INTERNAL::TGAImage>(filepath);
 	else if (fileFormat == ".bmp" || fileFormat == ".dib")
@@ -65,7 +127,7 @@
 	else if (fileFormat == ".png")
 		result = MakeScope<INTERNAL::PNGImage>(filepath);
 	else if (fileFormat == ".hdr" || fileFormat == ".pic")
-		result = MakeScope<INTERNAL::RadianceImage>(filepath);
+		result = MakeScope<INTERNAL::RadianceImage>(filepath, hdrPrecision);
 	else if (fileFormat == ".qoi")
 		result = MakeScope<INTERNAL::QOIImage>(filepath);
 	else //Shouldn't be reached, just in case
@@ -84,6 +146,130 @@
 
 //-------------------------------------------------------------------------------------------------------------------//
 
+void TRAP::Image::LoadFromFiles(ThreadPool& threadPool, const std::span<const std::filesystem::path> filepaths,
+                                const std::function<void(usize, Scope<Image>)>& onLoaded, const u64 maxInFlightBytes,
+                                const HDRPrecision hdrPrecision)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	TRAP_ASSERT(onLoaded, "Image::LoadFromFiles(): onLoaded is empty!");
+
+	struct PendingImage
+	{
+		usize Index;
+		std::future<Scope<Image>> Result;
+	};
+
+	std::atomic<u64> inFlightBytes = 0;
+	std::deque<PendingImage> pendingImages{};
+	usize nextFile = 0;
+
+	//Queued tasks reference inFlightBytes and filepaths, so every one of them
+	//has to finish before leaving, even if onLoaded or a decoder throws
+	struct PendingImagesGuard
+	{
+		ThreadPool& Pool;
+		std::deque<PendingImage>& Images;
+
+		~PendingImagesGuard()
+		{
+			for(const PendingImage& pendingImage : Images)
+			{
+				if(pendingImage.Result.valid())
+					WaitForImage(Pool, pendingImage.Result);
+			}
+		}
+	} const pendingImagesGuard{threadPool, pendingImages};
+
+	while(nextFile < filepaths.size() || !pendingImages.empty())
+	{
+		//Start decoding new files while the limit allows it
+		while(nextFile < filepaths.size())
+		{
+			//Until the image is decoded its encoded size is used as an estimate
+			std::error_code ec{};
+			u64 estimatedSize = std::filesystem::file_size(filepaths[nextFile], ec);
+			if(ec)
+				estimatedSize = 0;
+
+			if(!pendingImages.empty() && inFlightBytes.load(std::memory_order_relaxed) + estimatedSize > maxInFlightBytes)
+				break;
+
+			inFlightBytes.fetch_add(estimatedSize, std::memory_order_relaxed);
+
+			pendingImages.push_back({nextFile, threadPool.EnqueueTask(TaskPriority::Low,
+			                                                          [&inFlightBytes, estimatedSize, &filepath = filepaths[nextFile], hdrPrecision]()
+			{
+				Scope<Image> image = LoadFromFile(filepath, hdrPrecision);
+
+				//Replace the estimate with the real size
+				inFlightBytes.fetch_add(image ? image->GetPixelData().size() : 0u, std::memory_order_relaxed);
+				inFlightBytes.fetch_sub(estimatedSize, std::memory_order_relaxed);
+
+				return image;
+			})});
+			++nextFile;
+		}
+
+		//Hand the oldest image to the caller, help decoding while it isn't ready yet
+		PendingImage& pendingImage = pendingImages.front();
+		WaitForImage(threadPool, pendingImage.Result);
+
+		Scope<Image> image = pendingImage.Result.get();
+		if(!image)
+			image = LoadFallback();
+
+		const u64 imageSize = image->GetPixelData().size();
+		onLoaded(pendingImage.Index, std::move(image));
+		inFlightBytes.fetch_sub(imageSize, std::memory_order_relaxed);
+
+		pendingImages.pop_front();
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::Image::LoadFromFiles(const std::span<const std::filesystem::path> filepaths,
+                                const std::function<void(usize, Scope<Image>)>& onLoaded, const u64 maxInFlightBytes,
+                                const HDRPrecision hdrPrecision)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None &&
+	                                         (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	LoadFromFiles(TRAP::INTERNAL::GetParallelThreadPool(), filepaths, onLoaded, maxInFlightBytes, hdrPrecision);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] std::vector<TRAP::Scope<TRAP::Image>> TRAP::Image::LoadFromFiles(ThreadPool& threadPool,
+                                                                             const std::span<const std::filesystem::path> filepaths,
+                                                                             const HDRPrecision hdrPrecision)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	std::vector<Scope<Image>> images(filepaths.size());
+
+	LoadFromFiles(threadPool, filepaths, [&images](const usize index, Scope<Image> image)
+	{
+		images[index] = std::move(image);
+	}, std::numeric_limits<u64>::max(), hdrPrecision);
+
+	return images;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] std::vector<TRAP::Scope<TRAP::Image>> TRAP::Image::LoadFromFiles(const std::span<const std::filesystem::path> filepaths,
+                                                                             const HDRPrecision hdrPrecision)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None &&
+	                                         (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	return LoadFromFiles(TRAP::INTERNAL::GetParallelThreadPool(), filepaths, hdrPrecision);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
 [[nodiscard]] TRAP::Scope<TRAP::Image> TRAP::Image::LoadFromMemory(u32 width, u32 height, ColorFormat format, const std::vector<u8>& pixelData)
 {
 	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
@@ -111,6 +297,70 @@
 
 //-------------------------------------------------------------------------------------------------------------------//
 
+[[nodiscard]] TRAP::Scope<TRAP::Image> TRAP::Image::LoadHalfFloatFromMemory(const u32 width, const u32 height, const ColorFormat format,
+                                                                            const std::vector<u16>& pixelData)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	return MakeScope<INTERNAL::CustomImage>("", width, height, format, pixelData, true);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] TRAP::Scope<TRAP::Image> TRAP::Image::LoadFromMemory(const std::span<const u8> encodedImage,
+                                                                   const HDRPrecision hdrPrecision)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	static constexpr std::array<u8, 8> PNGMagicNumber{0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A};
+
+	const auto startsWith = [encodedImage](const std::span<const u8> magicNumber)
+	{
+		return encodedImage.size() >= magicNumber.size() &&
+		       std::ranges::equal(encodedImage.first(magicNumber.size()), magicNumber);
+	};
+	const auto startsWithString = [&startsWith](const std::string_view magicNumber)
+	{
+		return startsWith(Utils::AsBytes(std::span(magicNumber)));
+	};
+
+	if (encodedImage.empty())
+	{
+		TP_ERROR(Log::ImagePrefix, "Can't load image from empty data!");
+		TP_WARN(Log::ImagePrefix, "Using default image!");
+		return LoadFallback();
+	}
+
+	Scope<Image> result;
+
+	if (startsWith(PNGMagicNumber))
+		result = MakeScope<INTERNAL::PNGImage>(encodedImage);
+	else if (startsWithString("qoif"))
+		result = MakeScope<INTERNAL::QOIImage>(encodedImage);
+	else if (startsWithString("BM"))
+		result = MakeScope<INTERNAL::BMPImage>(encodedImage);
+	else if (startsWithString("#?"))
+		result = MakeScope<INTERNAL::RadianceImage>(encodedImage, hdrPrecision);
+	else if (startsWithString("P2") || startsWithString("P5"))
+		result = MakeScope<INTERNAL::PGMImage>(encodedImage);
+	else if (startsWithString("P3") || startsWithString("P6"))
+		result = MakeScope<INTERNAL::PPMImage>(encodedImage);
+	else if (startsWithString("P7"))
+		result = MakeScope<INTERNAL::PAMImage>(encodedImage);
+	else if (startsWithString("PF") || startsWithString("Pf"))
+		result = MakeScope<INTERNAL::PFMImage>(encodedImage, hdrPrecision);
+	else //Targa has no magic number
+		result = MakeScope<INTERNAL::TGAImage>(encodedImage);
+
+	//Test for Errors
+	if (result->GetPixelData().empty() || result->GetColorFormat() == ColorFormat::NONE)
+		result = LoadFallback();
+
+	return result;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
 [[nodiscard]] TRAP::Scope<TRAP::Image> TRAP::Image::LoadFallback()
 {
 	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
@@ -152,73 +402,84 @@ TRAP::Image::Image(std::filesystem::path filepath, u32 width, u32 height, ColorF
 
 //-------------------------------------------------------------------------------------------------------------------//
 
-[[nodiscard]] TRAP::Scope<TRAP::Image> TRAP::Image::FlipX(const Image* const img)
+bool TRAP::Image::SaveToFile(const Image* const img, const std::filesystem::path& filepath)
 {
 	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
 
-	if(img == nullptr)
-		return nullptr;
+	TRAP_ASSERT(img != nullptr, "Image::SaveToFile(): Image is nullptr!");
 
-	Scope<Image> result;
+	const auto fileEnding = FileSystem::GetFileEnding(filepath);
+	if(!fileEnding)
+		return false;
 
-	if (img->IsHDR() && img->GetBytesPerChannel() == 4)
-	{
-		const std::span<const f32> data{reinterpret_cast<const f32*>(img->GetPixelData().data()), img->GetPixelData().size() / sizeof(f32)};
-		const std::vector<f32> flipped = FlipX(img->GetWidth(), img->GetHeight(), img->GetColorFormat(), data);
+	const std::string fileFormat = Utils::String::ToLower(*fileEnding);
 
-		result = LoadFromMemory(img->GetWidth(), img->GetHeight(), img->GetColorFormat(), flipped);
-	}
-	else if (img->IsLDR() && img->GetBytesPerChannel() == 2)
+	bool success = false;
+	if(fileFormat == ".png")
+		success = INTERNAL::PNGImage::Save(img, filepath);
+	else if(fileFormat == ".qoi")
+		success = INTERNAL::QOIImage::Save(img, filepath);
+	else if(fileFormat == ".ppm")
+		success = INTERNAL::PPMImage::Save(img, filepath);
+	else
 	{
-		const std::span<const u16> data{reinterpret_cast<const u16*>(img->GetPixelData().data()), img->GetPixelData().size() / sizeof(u16)};
-		const std::vector<u16> flipped = FlipX(img->GetWidth(), img->GetHeight(), img->GetColorFormat(), data);
-
-		result = LoadFromMemory(img->GetWidth(), img->GetHeight(), img->GetColorFormat(), flipped);
+		TP_ERROR(Log::ImagePrefix, "Unsupported image format for saving ", fileFormat, "!");
+		return false;
 	}
-	else /*if(img->IsLDR() && img->GetBytesPerChannel() == 1)*/
+
+	if(!success)
+		TP_ERROR(Log::ImagePrefix, "Failed to save image: ", filepath, "!");
+
+	return success;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] std::future<bool> TRAP::Image::SaveToFileAsync(ThreadPool& threadPool, Scope<Image> img,
+                                                             std::filesystem::path filepath)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	TRAP_ASSERT(img != nullptr, "Image::SaveToFileAsync(): Image is nullptr!");
+
+	return threadPool.EnqueueTask(TaskPriority::Low, [image = std::move(img), path = std::move(filepath)]()
 	{
-		const std::vector<u8> flipped = FlipX(img->GetWidth(), img->GetHeight(), img->GetColorFormat(), img->GetPixelData());
+		return SaveToFile(image.get(), path);
+	});
+}
 
-		result = LoadFromMemory(img->GetWidth(), img->GetHeight(), img->GetColorFormat(), flipped);
-	}
+//-------------------------------------------------------------------------------------------------------------------//
 
-	return result;
+[[nodiscard]] std::future<bool> TRAP::Image::SaveToFileAsync(Scope<Image> img, std::filesystem::path filepath)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None &&
+	                                         (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	return SaveToFileAsync(TRAP::INTERNAL::GetParallelThreadPool(), std::move(img), std::move(filepath));
 }
 
 //-------------------------------------------------------------------------------------------------------------------//
 
-[[nodiscard]] TRAP::Scope<TRAP::Image> TRAP::Image::FlipY(const Image* const img)
+[[nodiscard]] TRAP::Scope<TRAP::Image> TRAP::Image::FlipX(const Image* const img)
 {
 	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
 
-	if (img == nullptr)
+	if(img == nullptr)
 		return nullptr;
 
-	Scope<Image> result;
-
-	if (img->IsHDR() && img->GetBytesPerChannel() == 4)
-	{
-		const std::span<const f32> data{reinterpret_cast<const f32*>(img->GetPixelData().data()), img->GetPixelData().size() / sizeof(f32)};
-		const std::vector<f32> flipped = FlipY(img->GetWidth(), img->GetHeight(), img->GetColorFormat(), data);
+	return TransformImage(*img, img->GetWidth(), img->GetHeight(), &INTERNAL::FlipPixelsX);
+}
 
-		result = LoadFromMemory(img->GetWidth(), img->GetHeight(), img->GetColorFormat(), flipped);
-	}
-	else if (img->IsLDR() && img->GetBytesPerChannel() == 2)
-	{
-		const std::span<const u16> data{reinterpret_cast<const u16*>(img->GetPixelData().data()), img->GetPixelData().size() / sizeof(u16)};
-		const std::vector<u16> flipped = FlipY(img->GetWidth(), img->GetHeight(), img->GetColorFormat(), data);
+//-------------------------------------------------------------------------------------------------------------------//
 
-		result = LoadFromMemory(img->GetWidth(), img->GetHeight(), img->GetColorFormat(), flipped);
-	}
-	else /*if(img->IsLDR() && img->GetBytesPerChannel() == 1)*/
-	{
-		const std::vector<u8> flipped = FlipY(img->GetWidth(), img->GetHeight(), img->GetColorFormat(),
-		                                      img->GetPixelData());
+[[nodiscard]] TRAP::Scope<TRAP::Image> TRAP::Image::FlipY(const Image* const img)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
 
-		result = LoadFromMemory(img->GetWidth(), img->GetHeight(), img->GetColorFormat(), flipped);
-	}
+	if(img == nullptr)
+		return nullptr;
 
-	return result;
+	return TransformImage(*img, img->GetWidth(), img->GetHeight(), &INTERNAL::FlipPixelsY);
 }
 
 //-------------------------------------------------------------------------------------------------------------------//
@@ -227,71 +488,65 @@ TRAP::Image::Image(std::filesystem::path filepath, u32 width, u32 height, ColorF
 {
 	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
 
-	if (img == nullptr)
+	if(img == nullptr)
 		return nullptr;
 
-	Scope<Image> result;
-
-	if (img->IsHDR() && img->GetBytesPerChannel() == 4)
-	{
-		const std::span<const f32> data{reinterpret_cast<const f32*>(img->GetPixelData().data()), img->GetPixelData().size() / sizeof(f32)};
-		const std::vector<f32> rotated = Rotate90Clockwise(img->GetWidth(), img->GetHeight(),
-		                                                   img->GetColorFormat(), data);
+	//Rotated images are height pixels wide and width pixels high
+	return TransformImage(*img, img->GetHeight(), img->GetWidth(), &INTERNAL::RotatePixels90Clockwise);
+}
 
-		result = LoadFromMemory(img->GetWidth(), img->GetHeight(), img->GetColorFormat(), rotated);
-	}
-	else if (img->IsLDR() && img->GetBytesPerChannel() == 2)
-	{
-		const std::span<const u16> data{reinterpret_cast<const u16*>(img->GetPixelData().data()), img->GetPixelData().size() / sizeof(u16)};
-		const std::vector<u16> rotated = Rotate90Clockwise(img->GetWidth(), img->GetHeight(),
-		                                                   img->GetColorFormat(), data);
+//-------------------------------------------------------------------------------------------------------------------//
 
-		result = LoadFromMemory(img->GetWidth(), img->GetHeight(), img->GetColorFormat(), rotated);
-	}
-	else /*if(img->IsLDR() && img->GetBytesPerChannel() == 1)*/
-	{
-		const std::vector<u8> rotated = Rotate90Clockwise(img->GetWidth(), img->GetHeight(),
-		                                                  img->GetColorFormat(), img->GetPixelData());
+[[nodiscard]] TRAP::Scope<TRAP::Image> TRAP::Image::Rotate90CounterClockwise(const Image* const img)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
 
-		result = LoadFromMemory(img->GetWidth(), img->GetHeight(), img->GetColorFormat(), rotated);
-	}
+	if(img == nullptr)
+		return nullptr;
 
-	return result;
+	//Rotated images are height pixels wide and width pixels high
+	return TransformImage(*img, img->GetHeight(), img->GetWidth(), &INTERNAL::RotatePixels90CounterClockwise);
 }
 
 //-------------------------------------------------------------------------------------------------------------------//
 
-[[nodiscard]] TRAP::Scope<TRAP::Image> TRAP::Image::Rotate90CounterClockwise(const Image* const img)
+[[nodiscard]] TRAP::Scope<TRAP::Image> TRAP::Image::ConvertRGBToRGBA(const Image* const img)
 {
 	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
 
-	if (img == nullptr)
+	if(img == nullptr)
 		return nullptr;
 
 	Scope<Image> result;
 
-	if (img->IsHDR() && img->GetBytesPerChannel() == 4)
+	//The converted data is moved into the new image instead of being copied by LoadFromMemory()
+	if(img->IsHDR() && img->GetBytesPerChannel() == 4)
 	{
 		const std::span<const f32> data{reinterpret_cast<const f32*>(img->GetPixelData().data()), img->GetPixelData().size() / sizeof(f32)};
-		const std::vector<f32> rotated = Rotate90CounterClockwise(img->GetWidth(), img->GetHeight(),
-		                                                          img->GetColorFormat(), data);
+		std::vector<f32> converted = ConvertRGBToRGBA(img->GetWidth(), img->GetHeight(), data);
 
-		result = LoadFromMemory(img->GetWidth(), img->GetHeight(), img->GetColorFormat(), rotated);
+		result = MakeScope<INTERNAL::CustomImage>("", img->GetWidth(), img->GetHeight(), ColorFormat::RGBA, std::move(converted));
 	}
-	else if (img->IsLDR() && img->GetBytesPerChannel() == 2)
+	else if (img->GetBytesPerChannel() == 2)
 	{
 		const std::span<const u16> data{reinterpret_cast<const u16*>(img->GetPixelData().data()), img->GetPixelData().size() / sizeof(u16)};
-		const std::vector<u16> rotated = Rotate90CounterClockwise(img->GetWidth(), img->GetHeight(),
-		                                                          img->GetColorFormat(), data);
+		std::vector<u16> converted = ConvertRGBToRGBA(img->GetWidth(), img->GetHeight(), data);
+
+		if(img->IsHDR())
+		{
+			//Opaque alpha for half floats is 1.0 instead of the maximum value
+			for(usize i = 3; i < converted.size(); i += 4)
+				converted[i] = INTERNAL::HalfFloatOne;
+		}
 
-		result = LoadFromMemory(img->GetWidth(), img->GetHeight(), img->GetColorFormat(), rotated);
+		result = MakeScope<INTERNAL::CustomImage>("", img->GetWidth(), img->GetHeight(), ColorFormat::RGBA, std::move(converted),
+		                                          img->IsHDR());
 	}
 	else /*if(img->IsLDR() && img->GetBytesPerChannel() == 1)*/
 	{
-		const std::vector<u8> rotated = Rotate90CounterClockwise(img->GetWidth(), img->GetHeight(),
-		                                                         img->GetColorFormat(), img->GetPixelData());
+		std::vector<u8> converted = ConvertRGBToRGBA(img->GetWidth(), img->GetHeight(), img->GetPixelData());
 
-		result = LoadFromMemory(img->GetWidth(), img->GetHeight(), img->GetColorFormat(), rotated);
+		result = MakeScope<INTERNAL::CustomImage>("", img->GetWidth(), img->GetHeight(), ColorFormat::RGBA, std::move(converted));
 	}
 
 	return result;
@@ -299,36 +554,61 @@ TRAP::Image::Image(std::filesystem::path filepath, u32 width, u32 height, ColorF
 
 //-------------------------------------------------------------------------------------------------------------------//
 
-[[nodiscard]] TRAP::Scope<TRAP::Image> TRAP::Image::ConvertRGBToRGBA(const Image* const img)
+[[nodiscard]] std::vector<u8> TRAP::Image::ConvertBGR16ToRGB24(const std::span<const u8> source, const u32 width, const u32 height)
 {
 	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
 
-	if(img == nullptr)
-		return nullptr;
+	const usize pixelCount = NumericCast<usize>(width) * height;
+	if(source.size() < pixelCount * 2u)
+	{
+		TRAP_ASSERT(false, "Image::ConvertBGR16ToRGB24(): Raw pixel data is too small!");
+		return std::vector<u8>();
+	}
 
-	Scope<Image> result;
+	std::vector<u8> data(pixelCount * 3u);
+	INTERNAL::ConvertBGR16ToRGB24(source.first(pixelCount * 2u), data);
 
-	if(img->IsHDR() && img->GetBytesPerChannel() == 4)
-	{
-		const std::span<const f32> data{reinterpret_cast<const f32*>(img->GetPixelData().data()), img->GetPixelData().size() / sizeof(f32)};
-		const std::vector<f32> converted = ConvertRGBToRGBA(img->GetWidth(), img->GetHeight(), data);
+	return data;
+}
 
-		result = LoadFromMemory(img->GetWidth(), img->GetHeight(), ColorFormat::RGBA, converted);
-	}
-	else if (img->IsLDR() && img->GetBytesPerChannel() == 2)
-	{
-		const std::span<const u16> data{reinterpret_cast<const u16*>(img->GetPixelData().data()), img->GetPixelData().size() / sizeof(u16)};
-		const std::vector<u16> converted = ConvertRGBToRGBA(img->GetWidth(), img->GetHeight(), data);
+//-------------------------------------------------------------------------------------------------------------------//
 
-		result = LoadFromMemory(img->GetWidth(), img->GetHeight(), ColorFormat::RGBA, converted);
-	}
-	else /*if(img->IsLDR() && img->GetBytesPerChannel() == 1)*/
-	{
-		const std::vector<u8> flipped = ConvertRGBToRGBA(img->GetWidth(), img->GetHeight(),
-		                                                 img->GetPixelData());
+[[nodiscard]] std::vector<u8> TRAP::Image::DecodeBGRAMap(const std::span<const u8> source, const u32 width, const u32 height,
+                                                         const u32 channels, const std::span<const u8> colorMap)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
 
-		result = LoadFromMemory(img->GetWidth(), img->GetHeight(), ColorFormat::RGBA, flipped);
+	const usize pixelCount = NumericCast<usize>(width) * height;
+	if(source.size() < pixelCount || channels < 1u || channels > 4u)
+	{
+		TRAP_ASSERT(false, "Image::DecodeBGRAMap(): Invalid indexed pixel data!");
+		return std::vector<u8>();
 	}
 
-	return result;
+	std::vector<u8> data(pixelCount * INTERNAL::GetDecodedBGRAMapChannels(channels));
+	INTERNAL::DecodeBGRAMap(source.first(pixelCount), colorMap, channels, data);
+
+	return data;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] std::vector<u8> TRAP::Image::ConvertBGR24ToRGB24(std::vector<u8> source, const u32 width, const u32 height)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	INTERNAL::ConvertBGRToRGB(std::span(source).first(std::min<usize>(NumericCast<usize>(width) * height * 3u, source.size())), 3);
+
+	return source;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] std::vector<u8> TRAP::Image::ConvertBGRA32ToRGBA32(std::vector<u8> source, const u32 width, const u32 height)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	INTERNAL::ConvertBGRToRGB(std::span(source).first(std::min<usize>(NumericCast<usize>(width) * height * 4u, source.size())), 4);
+
+	return source;
 }
\ No newline at end of file
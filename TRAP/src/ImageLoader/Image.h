@@ -2,6 +2,9 @@
 #define TRAP_IMAGE_H
 
 #include <algorithm>
+#include <functional>
+#include <future>
+#include <span>
 #include <vector>
 #include <filesystem>
 
@@ -10,9 +13,13 @@
 
 #include "Maths/Types.h"
 #include "Maths/Vec2.h"
+#include "ImageLoader/ImageTransform.h"
+#include "ImageLoader/PixelConversion.h"
 
 namespace TRAP
 {
+	class ThreadPool;
+
 	/// @brief Abstract image base class.
 	class Image
 	{
@@ -27,6 +34,16 @@ namespace TRAP
 			RGBA = 4
 		};
 
+		/// @brief Precision used to store the pixel data of decoded HDR images.
+		enum class HDRPrecision : u32
+		{
+			/// @brief 32-bit floats, RGB images stay RGB.
+			Float32,
+			/// @brief 16-bit half floats, RGB images are expanded to RGBA as GPUs rarely support RGB16F textures.
+			///        Halves the memory usage and upload size compared to uploading 32-bit RGBA floats.
+			Float16
+		};
+
 	protected:
 		/// @brief Constructor.
 		explicit Image(std::filesystem::path filepath);
@@ -78,6 +95,7 @@ namespace TRAP
 		/// @return True if image is colored, false otherwise.
 		[[nodiscard]] constexpr bool IsImageColored() const noexcept;
 		/// @brief Retrieve whether the image is HDR(High Dynamic Range) or not.
+		///        HDR images store 32-bit floats or, with 2 bytes per channel, 16-bit half floats.
 		/// @return True if image is HDR, false otherwise.
 		[[nodiscard]] constexpr bool IsHDR() const noexcept;
 		/// @brief Retrieve whether the image is LDR(Low Dynamic Range) or not.
@@ -98,8 +116,55 @@ namespace TRAP
 		///		- Bitmap: BMP, DIB
 		///		- Portable Network Graphics: PNG
 		///		- Radiance: HDR, PIC
+		/// @param hdrPrecision Precision to decode HDR images (Radiance, PFM) to. Default: Float32.
 		/// @return Loaded image on success, fallback image otherwise.
-		[[nodiscard]] static Scope<Image> LoadFromFile(const std::filesystem::path& filepath);
+		[[nodiscard]] static Scope<Image> LoadFromFile(const std::filesystem::path& filepath,
+		                                               HDRPrecision hdrPrecision = HDRPrecision::Float32);
+		/// @brief Load multiple images from disk in parallel.
+		///
+		///        Every file is decoded by its own task on the given ThreadPool,
+		///        the calling thread helps decoding while it waits.
+		///        Decoded images are handed to onLoaded on the calling thread in the order of filepaths.
+		///        New files are only started while the bytes in flight stay below maxInFlightBytes,
+		///        files that are still being decoded count with their encoded size,
+		///        decoded images count with their pixel data size until onLoaded returns.
+		///        At least one file is always in flight, so single images bigger than the limit still load.
+		/// @param threadPool ThreadPool to decode on.
+		/// @param filepaths Paths to the images.
+		/// @param onLoaded Called with the index into filepaths and the loaded image (fallback image on failure).
+		/// @param maxInFlightBytes Limit for the bytes in flight, bounds the peak memory usage.
+		/// @param hdrPrecision Precision to decode HDR images (Radiance, PFM) to. Default: Float32.
+		/// @note See LoadFromFile() for the supported formats.
+		static void LoadFromFiles(ThreadPool& threadPool, std::span<const std::filesystem::path> filepaths,
+		                          const std::function<void(usize, Scope<Image>)>& onLoaded,
+		                          u64 maxInFlightBytes = DefaultMaxInFlightBytes,
+		                          HDRPrecision hdrPrecision = HDRPrecision::Float32);
+		/// @brief Load multiple images from disk in parallel using the engine ThreadPool.
+		/// @param filepaths Paths to the images.
+		/// @param onLoaded Called with the index into filepaths and the loaded image (fallback image on failure).
+		/// @param maxInFlightBytes Limit for the bytes in flight, bounds the peak memory usage.
+		/// @param hdrPrecision Precision to decode HDR images (Radiance, PFM) to. Default: Float32.
+		/// @note See LoadFromFiles(ThreadPool&, std::span<const std::filesystem::path>, const std::function<void(usize, Scope<Image>)>&, u64, HDRPrecision) for details.
+		static void LoadFromFiles(std::span<const std::filesystem::path> filepaths,
+		                          const std::function<void(usize, Scope<Image>)>& onLoaded,
+		                          u64 maxInFlightBytes = DefaultMaxInFlightBytes,
+		                          HDRPrecision hdrPrecision = HDRPrecision::Float32);
+		/// @brief Load multiple images from disk in parallel.
+		/// @param threadPool ThreadPool to decode on.
+		/// @param filepaths Paths to the images.
+		/// @param hdrPrecision Precision to decode HDR images (Radiance, PFM) to. Default: Float32.
+		/// @return Loaded image for every file in filepaths, fallback image for files that failed to load.
+		/// @note As all images are returned at once, no limit for the bytes in flight is applied.
+		[[nodiscard]] static std::vector<Scope<Image>> LoadFromFiles(ThreadPool& threadPool,
+		                                                             std::span<const std::filesystem::path> filepaths,
+		                                                             HDRPrecision hdrPrecision = HDRPrecision::Float32);
+		/// @brief Load multiple images from disk in parallel using the engine ThreadPool.
+		/// @param filepaths Paths to the images.
+		/// @param hdrPrecision Precision to decode HDR images (Radiance, PFM) to. Default: Float32.
+		/// @return Loaded image for every file in filepaths, fallback image for files that failed to load.
+		/// @note As all images are returned at once, no limit for the bytes in flight is applied.
+		[[nodiscard]] static std::vector<Scope<Image>> LoadFromFiles(std::span<const std::filesystem::path> filepaths,
+		                                                             HDRPrecision hdrPrecision = HDRPrecision::Float32);
 		/// @brief Load an image from memory.
 		/// @param width Width for the image.
 		/// @param height Height for the image
@@ -127,6 +192,30 @@ namespace TRAP
 		/// @note There are no validation checks for images loaded from memory!
 		[[nodiscard]] static Scope<Image> LoadFromMemory(u32 width, u32 height, ColorFormat format,
 		                                                 const std::vector<f32>& pixelData);
+		/// @brief Load an HDR image with half float pixel data from memory.
+		/// @param width Width for the image.
+		/// @param height Height for the image
+		/// @param format Color format for the image.
+		/// @param pixelData Raw pixel data for the image, IEEE 754 half precision floats.
+		/// @return Loaded Image.
+		/// @note There are no validation checks for images loaded from memory!
+		[[nodiscard]] static Scope<Image> LoadHalfFloatFromMemory(u32 width, u32 height, ColorFormat format,
+		                                                          const std::vector<u16>& pixelData);
+		/// @brief Load an encoded image from memory.
+		///        The image format is detected from the data.
+		/// @param encodedImage Encoded image data, i.e. the content of an image file.
+		/// Supported formats:
+		///		- Portable Maps: PGM, PPM, PAM, PFM
+		///		- Targa: TGA, ICB, VDA, VST
+		///		- Bitmap: BMP, DIB
+		///		- Portable Network Graphics: PNG
+		///		- Radiance: HDR, PIC
+		///		- Quite OK Image: QOI
+		/// @param hdrPrecision Precision to decode HDR images (Radiance, PFM) to. Default: Float32.
+		/// @return Loaded image on success, fallback image otherwise.
+		/// @note Data without a known magic number is treated as Targa as it has none.
+		[[nodiscard]] static Scope<Image> LoadFromMemory(std::span<const u8> encodedImage,
+		                                                 HDRPrecision hdrPrecision = HDRPrecision::Float32);
 		/// @brief Load the fallback image.
 		/// @return Fallback image.
 		[[nodiscard]] static Scope<Image> LoadFallback();
@@ -136,6 +225,32 @@ namespace TRAP
 		/// @return True if given file is an image, false otherwise.
 		[[nodiscard]] static bool IsSupportedImageFile(const std::filesystem::path& filepath);
 
+		/// @brief Save an image to disk.
+		///        The image format is selected by the file extension.
+		/// @param img Image to save.
+		/// @param filepath File path to save the image to.
+		/// Supported formats:
+		///		- Portable Network Graphics: PNG
+		///		- Quite OK Image: QOI
+		///		- Portable Maps: PPM (8 bits per channel RGB(A) only)
+		/// @return True on success, false otherwise.
+		static bool SaveToFile(const Image* img, const std::filesystem::path& filepath);
+		/// @brief Encode and save an image to disk on the given ThreadPool.
+		///        Useful for screenshots, as encoding doesn't stall the calling thread.
+		/// @param threadPool ThreadPool to encode on.
+		/// @param img Image to save, ownership is transferred to the task.
+		/// @param filepath File path to save the image to.
+		/// @return Future which holds the result of SaveToFile().
+		/// @note See SaveToFile() for the supported formats.
+		[[nodiscard]] static std::future<bool> SaveToFileAsync(ThreadPool& threadPool, Scope<Image> img,
+		                                                       std::filesystem::path filepath);
+		/// @brief Encode and save an image to disk on the engine ThreadPool.
+		/// @param img Image to save, ownership is transferred to the task.
+		/// @param filepath File path to save the image to.
+		/// @return Future which holds the result of SaveToFile().
+		/// @note See SaveToFile() for the supported formats.
+		[[nodiscard]] static std::future<bool> SaveToFileAsync(Scope<Image> img, std::filesystem::path filepath);
+
 		/// @brief Flip an image on its X axis.
 		/// @param img Image to flip.
 		/// @return Flipped image.
@@ -157,6 +272,9 @@ namespace TRAP
 		/// @return Converted image.
 		[[nodiscard]] static Scope<Image> ConvertRGBToRGBA(const Image* img);
 
+		/// @brief Default limit for the bytes in flight used by LoadFromFiles().
+		static constexpr u64 DefaultMaxInFlightBytes = 256u * 1024u * 1024u;
+
 		static constexpr std::array<std::string_view, 15> SupportedImageFormatSuffixes
 		{
 			".pgm", ".ppm", ".pnm", ".pam", ".pfm",
@@ -194,7 +312,7 @@ namespace TRAP
 		/// @param height Height of image in pixels.
 		/// @param format Color format of the image data.
 		/// @param data Raw pixel data.
-		/// @return Rotated raw pixel data
+		/// @return Rotated raw pixel data, height pixels wide and width pixels high.
 		template<typename T>
 		requires std::same_as<T, u8> || std::same_as<T, u16> || std::same_as<T, f32>
 		[[nodiscard]] static std::vector<T> Rotate90Clockwise(u32 width, u32 height, ColorFormat format, std::span<const T> data);
@@ -204,7 +322,7 @@ namespace TRAP
 		/// @param height Height of image in pixels.
 		/// @param format Color format of the image data.
 		/// @param data Raw pixel data.
-		/// @return Rotate raw pixel data
+		/// @return Rotated raw pixel data, height pixels wide and width pixels high.
 		template<typename T>
 		requires std::same_as<T, u8> || std::same_as<T, u16> || std::same_as<T, f32>
 		[[nodiscard]] static std::vector<T> Rotate90CounterClockwise(u32 width, u32 height, ColorFormat format, std::span<const T> data);
@@ -232,32 +350,31 @@ namespace TRAP
 		/// @param width Width of the image.
 		/// @param height Height of the image.
 		/// @return RGB24 pixel data.
-		[[nodiscard]] static constexpr std::vector<u8> ConvertBGR16ToRGB24(std::vector<u8>& source,
-		                                                                        u32 width, u32 height);
+		[[nodiscard]] static std::vector<u8> ConvertBGR16ToRGB24(std::span<const u8> source, u32 width, u32 height);
 		/// @brief Converts BGR24 pixel data to RGB24.
+		///        The conversion happens in place, pass the source by move to avoid a copy.
 		/// @param source BGR24 pixel data.
 		/// @param width Width of the image.
 		/// @param height Height of the image.
 		/// @return RGB24 pixel data.
-		[[nodiscard]] static constexpr std::vector<u8> ConvertBGR24ToRGB24(std::vector<u8>& source,
-		                                                                        u32 width, u32 height);
+		[[nodiscard]] static std::vector<u8> ConvertBGR24ToRGB24(std::vector<u8> source, u32 width, u32 height);
 		/// @brief Converts BGR32 pixel data to RGB32.
+		///        The conversion happens in place, pass the source by move to avoid a copy.
 		/// @param source BGR32 pixel data.
 		/// @param width Width of the image.
 		/// @param height Height of the image.
 		/// @return RGB32 pixel data.
-		[[nodiscard]] static constexpr std::vector<u8> ConvertBGRA32ToRGBA32(std::vector<u8>& source,
-		                                                                          u32 width, u32 height);
+		[[nodiscard]] static std::vector<u8> ConvertBGRA32ToRGBA32(std::vector<u8> source, u32 width, u32 height);
 		/// @brief Decode BGRA indexed pixel data to RGBA.
-		/// Output format depends on channel count, if it is 4, output is RGBA, if it is 3, output is RGB and so on.
+		/// Output format depends on channel count, if it is 4, output is RGBA, if it is 3 or 2 (BGR16), output is RGB and so on.
 		/// @param source Indexed BGRA pixel data.
 		/// @param width Width of the image.
 		/// @param height Height of the image.
-		/// @param channels Amount of channels, i.e. 4 = RGBA, 3 = RGB.
+		/// @param channels Amount of channels of a color table entry, i.e. 4 = RGBA, 3 = RGB.
 		/// @param colorMap Color table.
 		/// @return Decoded pixel data.
-		[[nodiscard]] constexpr static std::vector<u8> DecodeBGRAMap(std::vector<u8>& source, u32 width, u32 height,
-		                                                                  u32 channels, std::vector<u8>& colorMap);
+		[[nodiscard]] static std::vector<u8> DecodeBGRAMap(std::span<const u8> source, u32 width, u32 height,
+		                                                   u32 channels, std::span<const u8> colorMap);
 
 		u32 m_width = 0;
 		u32 m_height = 0;
@@ -377,23 +494,10 @@ requires std::same_as<T, u8> || std::same_as<T, u16> || std::same_as<T, f32>
 		return std::vector<T>();
 	}
 
-	std::vector<T> newData{};
-	u32 stride = 0;
-	const u32 multiplier = std::to_underlying(format);
-
-	newData.assign(data.begin(), data.begin() + NumericCast<u64>(width) * height * multiplier);
-	stride = height * multiplier;
-
-	std::vector<T> row{};
-	row.resize(stride);
-
-	for (u32 lowOffset = 0, highOffset = (width - 1) * stride; lowOffset < highOffset;
-	     lowOffset += stride, highOffset -= stride)
-	{
-		std::copy(newData.data() + lowOffset, newData.data() + lowOffset + stride, row.data());
-		std::copy(newData.data() + highOffset, newData.data() + highOffset + stride, newData.data() + lowOffset);
-		std::copy(row.data(), row.data() + stride, newData.data() + highOffset);
-	}
+	std::vector<T> newData(NumericCast<usize>(width) * height * std::to_underlying(format));
+	INTERNAL::FlipPixelsX(std::span<const u8>(reinterpret_cast<const u8*>(data.data()), newData.size() * sizeof(T)),
+	                      std::span<u8>(reinterpret_cast<u8*>(newData.data()), newData.size() * sizeof(T)),
+	                      width, height, std::to_underlying(format) * NumericCast<u32>(sizeof(T)));
 
 	return newData;
 }
@@ -416,34 +520,20 @@ requires std::same_as<T, u8> || std::same_as<T, u16> || std::same_as<T, f32>
 		return std::vector<T>();
 	}
 
-	std::vector<T> newData{};
-	u32 stride = 0;
-	const u32 multiplier = std::to_underlying(format);
-
-	newData.assign(data.begin(), data.begin() + NumericCast<u64>(width) * height * multiplier);
-	stride = width * multiplier;
-
-	std::vector<T> row{};
-	row.resize(stride);
-
-	for (u32 lowOffset = 0, highOffset = (height - 1) * stride; lowOffset < highOffset;
-	     lowOffset += stride, highOffset -= stride)
-	{
-		std::copy(newData.data() + lowOffset, newData.data() + lowOffset + stride, row.data());
-		std::copy(newData.data() + highOffset, newData.data() + highOffset + stride, newData.data() + lowOffset);
-		std::copy(row.data(), row.data() + stride, newData.data() + highOffset);
-	}
+	std::vector<T> newData(NumericCast<usize>(width) * height * std::to_underlying(format));
+	INTERNAL::FlipPixelsY(std::span<const u8>(reinterpret_cast<const u8*>(data.data()), newData.size() * sizeof(T)),
+	                      std::span<u8>(reinterpret_cast<u8*>(newData.data()), newData.size() * sizeof(T)),
+	                      width, height, std::to_underlying(format) * NumericCast<u32>(sizeof(T)));
 
 	return newData;
 }
 
 //-------------------------------------------------------------------------------------------------------------------//
 
-template<typename T>
+template <typename T>
 requires std::same_as<T, u8> || std::same_as<T, u16> || std::same_as<T, f32>
-[[nodiscard]] std::vector<T> TRAP::Image::Rotate90Clockwise(const u32 width, const u32 height,
-                                                            const ColorFormat format,
-															const std::span<const T> data)
+[[nodiscard]] std::vector<T> TRAP::Image::Rotate90Clockwise(const u32 width, const u32 height, const ColorFormat format,
+                                                            const std::span<const T> data)
 {
 	if (format == ColorFormat::NONE)
 	{
@@ -452,36 +542,24 @@ requires std::same_as<T, u8> || std::same_as<T, u16> || std::same_as<T, f32>
 	}
 	if(data.size() < (width * height * std::to_underlying(format)))
 	{
-		TRAP_ASSERT(false, "Image::Rotate90Clockwise: Raw pixel data is too small!");
+		TRAP_ASSERT(false, "Image::Rotate90Clockwise(): Raw pixel data is too small!");
 		return std::vector<T>();
 	}
 
-	std::vector<T> rotated(width * height * std::to_underlying(format));
+	std::vector<T> newData(NumericCast<usize>(width) * height * std::to_underlying(format));
+	INTERNAL::RotatePixels90Clockwise(std::span<const u8>(reinterpret_cast<const u8*>(data.data()), newData.size() * sizeof(T)),
+	                                  std::span<u8>(reinterpret_cast<u8*>(newData.data()), newData.size() * sizeof(T)),
+	                                  width, height, std::to_underlying(format) * NumericCast<u32>(sizeof(T)));
 
-	for(u32 y = 0, destCol = height - 1; y < height; ++y, --destCol)
-	{
-		const u32 offset = y * width;
-
-		for(u32 x = 0; x < width; ++x)
-		{
-			for(u32 channel = 0; channel < std::to_underlying(format); ++channel)
-			{
-				rotated[(x * height + destCol) * std::to_underlying(format) + channel] =
-				data[(offset + x) * std::to_underlying(format) + channel];
-			}
-		}
-	}
-
-	return rotated;
+	return newData;
 }
 
 //-------------------------------------------------------------------------------------------------------------------//
 
-template<typename T>
+template <typename T>
 requires std::same_as<T, u8> || std::same_as<T, u16> || std::same_as<T, f32>
-[[nodiscard]] std::vector<T> TRAP::Image::Rotate90CounterClockwise(const u32 width, const u32 height,
-                                                                   const ColorFormat format,
-																   const std::span<const T> data)
+[[nodiscard]] std::vector<T> TRAP::Image::Rotate90CounterClockwise(const u32 width, const u32 height, const ColorFormat format,
+                                                                   const std::span<const T> data)
 {
 	if (format == ColorFormat::NONE)
 	{
@@ -490,33 +568,16 @@ requires std::same_as<T, u8> || std::same_as<T, u16> || std::same_as<T, f32>
 	}
 	if(data.size() < (width * height * std::to_underlying(format)))
 	{
-		TRAP_ASSERT(false, "Image::Rotate90CounterClockwise: Raw pixel data is too small!");
+		TRAP_ASSERT(false, "Image::Rotate90CounterClockwise(): Raw pixel data is too small!");
 		return std::vector<T>();
 	}
 
-	std::vector<T> rotated(NumericCast<usize>(width) * height * std::to_underlying(format));
-	std::ranges::copy_n(data.begin(), static_cast<std::iter_difference_t<decltype(data)>>(rotated.size()), rotated.begin());
-	for(u32 x = 0; x < width; ++x)
-	{
-		for(u32 y = 0; y < height; ++y)
-		{
-			u32 I = y;
-			u32 J = width - 1 - x;
-			while((x * height + y) > (I * width + J))
-			{
-				const u32 p = I * width + J;
-				I = p % height;
-				J = width - 1 - (p / height);
-			}
-			for(u32 channel = 0; channel < std::to_underlying(format); ++channel)
-			{
-				std::swap(rotated[(x * height + y) * std::to_underlying(format) + channel],
-						  rotated[(I * width + J) * std::to_underlying(format) + channel]);
-			}
-		}
-	}
+	std::vector<T> newData(NumericCast<usize>(width) * height * std::to_underlying(format));
+	INTERNAL::RotatePixels90CounterClockwise(std::span<const u8>(reinterpret_cast<const u8*>(data.data()), newData.size() * sizeof(T)),
+	                                         std::span<u8>(reinterpret_cast<u8*>(newData.data()), newData.size() * sizeof(T)),
+	                                         width, height, std::to_underlying(format) * NumericCast<u32>(sizeof(T)));
 
-	return rotated;
+	return newData;
 }
 
 //-------------------------------------------------------------------------------------------------------------------//
@@ -532,23 +593,9 @@ requires std::same_as<T, u8> || std::same_as<T, u16> || std::same_as<T, f32>
 		return std::vector<T>();
 	}
 
-	T whitePixelColor;
-	if constexpr (std::same_as<T, u8> || std::same_as<T, u16>)
-		whitePixelColor = std::numeric_limits<T>::max();
-	else
-		whitePixelColor = 1.0f;
-
-	std::vector<T> newData(width * height * std::to_underlying(ColorFormat::RGBA));
-	usize newDataIndex = 0;
-	for(usize oldDataIndex = 0; oldDataIndex < NumericCast<usize>(width) * height * std::to_underlying(ColorFormat::RGB);
-		oldDataIndex += 3)
-	{
-		newData[newDataIndex + 0] = data[oldDataIndex + 0];
-		newData[newDataIndex + 1] = data[oldDataIndex + 1];
-		newData[newDataIndex + 2] = data[oldDataIndex + 2];
-		newData[newDataIndex + 3] = whitePixelColor;
-		newDataIndex += 4;
-	}
+	std::vector<T> newData(NumericCast<usize>(width) * height * std::to_underlying(ColorFormat::RGBA));
+	INTERNAL::ConvertRGBToRGBA(data.first(NumericCast<usize>(width) * height * std::to_underlying(ColorFormat::RGB)),
+	                           std::span<T>(newData));
 
 	return newData;
 }
@@ -566,92 +613,11 @@ requires std::same_as<T, u8> || std::same_as<T, u16> || std::same_as<T, f32>
 		return std::vector<T>();
 	}
 
-	std::vector<T> newData(width * height * std::to_underlying(ColorFormat::RGB));
-	usize newDataIndex = 0;
-	for(usize oldDataIndex = 0; oldDataIndex < NumericCast<usize>(width) * height * std::to_underlying(ColorFormat::RGBA);
-		oldDataIndex += 4)
-	{
-		newData[newDataIndex + 0] = data[oldDataIndex + 0];
-		newData[newDataIndex + 1] = data[oldDataIndex + 1];
-		newData[newDataIndex + 2] = data[oldDataIndex + 2];
-		newDataIndex += 3;
-	}
+	std::vector<T> newData(NumericCast<usize>(width) * height * std::to_underlying(ColorFormat::RGB));
+	INTERNAL::ConvertRGBAToRGB(data.first(NumericCast<usize>(width) * height * std::to_underlying(ColorFormat::RGBA)),
+	                           std::span<T>(newData));
 
 	return newData;
 }
 
-//-------------------------------------------------------------------------------------------------------------------//
-
-[[nodiscard]] constexpr std::vector<u8> TRAP::Image::ConvertBGR16ToRGB24(std::vector<u8>& source, const u32 width, const u32 height)
-{
-	std::vector<u8> data{};
-	data.resize(NumericCast<usize>(width) * height * 3);
-
-	u32 index = 0;
-	for (u32 i = 0; i < width * height * 2; i += 2)
-	{
-		data[index++] = NumericCast<u8>(source[i + 1u] << 1u) & 0xF8u;
-		data[index++] = NumericCast<u8>(NumericCast<u8>((source[i + 1u]) << 6u) | NumericCast<u8>(source[i] >> 2u)) & 0xF8u;
-		data[index++] = NumericCast<u8>(source[i] << 3u) & 0xF8u;
-	}
-
-	return data;
-}
-
-//-------------------------------------------------------------------------------------------------------------------//
-
-[[nodiscard]] constexpr std::vector<u8> TRAP::Image::DecodeBGRAMap(std::vector<u8>& source, const u32 width, const u32 height, const u32 channels, std::vector<u8>& colorMap)
-{
-	std::vector<u8> data{};
-	data.resize(NumericCast<usize>(width) * height * channels);
-
-	u32 index = 0;
-	for (u32 i = 0; i < width * height; i++)
-	{
-		if (channels == 1)
-			data[index++] = colorMap[NumericCast<usize>(source[i]) * channels];
-		else if (channels == 2)
-		{
-			data[index++] = NumericCast<u8>(colorMap[NumericCast<usize>(source[i]) * channels + 1u] << 1u) & 0xF8u;
-			data[index++] = NumericCast<u8>(NumericCast<u8>(colorMap[NumericCast<usize>(source[i]) * channels + 1u] << 6u) | NumericCast<u8>(colorMap[NumericCast<usize>(source[i]) * channels] >> 2u)) & 0xF8u;
-			data[index++] = NumericCast<u8>(colorMap[NumericCast<usize>(source[i]) * channels] << 3u) & 0xF8u;
-		}
-		else if (channels == 3)
-		{
-			data[index++] = colorMap[NumericCast<usize>(source[i]) * channels + 2];
-			data[index++] = colorMap[NumericCast<usize>(source[i]) * channels + 1];
-			data[index++] = colorMap[NumericCast<usize>(source[i]) * channels + 0];
-		}
-		else if (channels == 4)
-		{
-			data[index++] = colorMap[NumericCast<usize>(source[i]) * channels + 2];
-			data[index++] = colorMap[NumericCast<usize>(source[i]) * channels + 1];
-			data[index++] = colorMap[NumericCast<usize>(source[i]) * channels + 0];
-			data[index++] = colorMap[NumericCast<usize>(source[i]) * channels + 3];
-		}
-	}
-
-	return data;
-}
-
-//-------------------------------------------------------------------------------------------------------------------//
-
-[[nodiscard]] constexpr std::vector<u8> TRAP::Image::ConvertBGR24ToRGB24(std::vector<u8>& source, const u32 width, const u32 height)
-{
-	for (u32 i = 0; i < width * height * 3; i += 3)
-		source[i] ^= source[i + 2] ^= source[i] ^= source[i + 2];
-
-	return source;
-}
-
-//-------------------------------------------------------------------------------------------------------------------//
-
-[[nodiscard]] constexpr std::vector<u8> TRAP::Image::ConvertBGRA32ToRGBA32(std::vector<u8>& source, const u32 width, const u32 height)
-{
-	for (u32 i = 0; i < width * height * 4; i += 4)
-		source[i] ^= source[i + 2] ^= source[i] ^= source[i + 2];
-
-	return source;
-}
-
 #endif /*TRAP_IMAGE_H*/
\ No newline at end of file
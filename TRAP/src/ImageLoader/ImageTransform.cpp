@@ -0,0 +1,867 @@
+#include "TRAPPCH.h"
+#include "ImageTransform.h"
+
+#include "ThreadPool/Parallel.h"
+#include "TRAP_Assert.h"
+#include "Utils/Utils.h"
+
+#include <immintrin.h>
+
+namespace
+{
+	using ImageTransformImplementation = TRAP::INTERNAL::ImageTransformImplementation;
+
+	/// @brief Minimum amount of bytes processed per ThreadPool task.
+	///        Smaller images are transformed on the calling thread only.
+	constexpr usize MinBytesPerTask = 256u * 1024u;
+
+	/// @brief Width and height of the tiles used for rotation in pixels.
+	///        A source and a destination tile fit into the L1 cache together.
+	template<u32 BPP>
+	constexpr u32 TileSize = BPP <= 2u ? 64u : 32u;
+
+	/// @brief Size of the biggest tile in bytes.
+	constexpr usize MaxTileBytes = 32u * 32u * 16u;
+
+	/// @brief Width and height of the blocks transposed in SIMD registers, 1 if there is no SIMD kernel.
+	template<u32 BPP>
+	constexpr u32 TransposeBlockSize = BPP == 1u ? 8u : BPP == 2u ? 8u : BPP == 4u ? 4u : BPP == 8u ? 2u : 1u;
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Check whether the given pixel size is supported by the transform kernels.
+	/// @param bytesPerPixel Size of a single pixel in bytes.
+	/// @return True if supported, false otherwise.
+	[[nodiscard]] constexpr bool IsSupportedPixelSize(const u32 bytesPerPixel) noexcept
+	{
+		switch(bytesPerPixel)
+		{
+		case 1u: case 2u: case 3u: case 4u: case 6u: case 8u: case 12u: case 16u:
+			return true;
+
+		default:
+			return false;
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Call the given functor with the pixel size as compile time constant.
+	/// @param bytesPerPixel Size of a single pixel in bytes, must be supported.
+	/// @param f Functor to call with a std::integral_constant<u32, bytesPerPixel>.
+	template<typename F>
+	void DispatchPixelSize(const u32 bytesPerPixel, F&& f)
+	{
+		switch(bytesPerPixel)
+		{
+		case 1u:
+			f(std::integral_constant<u32, 1u>{});
+			break;
+		case 2u:
+			f(std::integral_constant<u32, 2u>{});
+			break;
+		case 3u:
+			f(std::integral_constant<u32, 3u>{});
+			break;
+		case 4u:
+			f(std::integral_constant<u32, 4u>{});
+			break;
+		case 6u:
+			f(std::integral_constant<u32, 6u>{});
+			break;
+		case 8u:
+			f(std::integral_constant<u32, 8u>{});
+			break;
+		case 12u:
+			f(std::integral_constant<u32, 12u>{});
+			break;
+		case 16u:
+			f(std::integral_constant<u32, 16u>{});
+			break;
+
+		default:
+			TRAP_ASSERT(false, "ImageTransform: Unsupported pixel size!");
+			break;
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Retrieve the grain for ParallelFor() so every task processes at least MinBytesPerTask bytes.
+	/// @param bytesPerIndex Amount of bytes processed per index.
+	/// @return Grain.
+	[[nodiscard]] constexpr usize GetGrain(const usize bytesPerIndex) noexcept
+	{
+		return std::max<usize>(1u, MinBytesPerTask / std::max<usize>(1u, bytesPerIndex));
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	[[nodiscard]] __m128i Load128(const u8* const src) noexcept
+	{
+		return _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	void Store128(u8* const dst, const __m128i value) noexcept
+	{
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), value);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Transpose a block of TransposeBlockSize<BPP> x TransposeBlockSize<BPP> pixels in SSE2 registers.
+	///        All rows are loaded before anything is stored.
+	/// @tparam BPP Bytes per pixel, 1, 2, 4 or 8.
+	/// @param src First source row.
+	/// @param srcStride Distance between source rows in bytes, may be negative.
+	/// @param dst First destination row.
+	/// @param dstStride Distance between destination rows in bytes, may be negative.
+	template<u32 BPP>
+	void TransposeBlock(const u8* const src, const isize srcStride, u8* const dst, const isize dstStride) noexcept
+	{
+		if constexpr(BPP == 1u)
+		{
+			const __m128i r0 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src));
+			const __m128i r1 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + srcStride));
+			const __m128i r2 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + 2 * srcStride));
+			const __m128i r3 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + 3 * srcStride));
+			const __m128i r4 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + 4 * srcStride));
+			const __m128i r5 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + 5 * srcStride));
+			const __m128i r6 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + 6 * srcStride));
+			const __m128i r7 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + 7 * srcStride));
+
+			const __m128i t0 = _mm_unpacklo_epi8(r0, r1);
+			const __m128i t1 = _mm_unpacklo_epi8(r2, r3);
+			const __m128i t2 = _mm_unpacklo_epi8(r4, r5);
+			const __m128i t3 = _mm_unpacklo_epi8(r6, r7);
+
+			const __m128i u0 = _mm_unpacklo_epi16(t0, t1);
+			const __m128i u1 = _mm_unpackhi_epi16(t0, t1);
+			const __m128i u2 = _mm_unpacklo_epi16(t2, t3);
+			const __m128i u3 = _mm_unpackhi_epi16(t2, t3);
+
+			//Every register holds two destination rows
+			const __m128i c01 = _mm_unpacklo_epi32(u0, u2);
+			const __m128i c23 = _mm_unpackhi_epi32(u0, u2);
+			const __m128i c45 = _mm_unpacklo_epi32(u1, u3);
+			const __m128i c67 = _mm_unpackhi_epi32(u1, u3);
+
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(dst), c01);
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(dst + dstStride), _mm_srli_si128(c01, 8));
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(dst + 2 * dstStride), c23);
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(dst + 3 * dstStride), _mm_srli_si128(c23, 8));
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(dst + 4 * dstStride), c45);
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(dst + 5 * dstStride), _mm_srli_si128(c45, 8));
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(dst + 6 * dstStride), c67);
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(dst + 7 * dstStride), _mm_srli_si128(c67, 8));
+		}
+		else if constexpr(BPP == 2u)
+		{
+			const __m128i r0 = Load128(src);
+			const __m128i r1 = Load128(src + srcStride);
+			const __m128i r2 = Load128(src + 2 * srcStride);
+			const __m128i r3 = Load128(src + 3 * srcStride);
+			const __m128i r4 = Load128(src + 4 * srcStride);
+			const __m128i r5 = Load128(src + 5 * srcStride);
+			const __m128i r6 = Load128(src + 6 * srcStride);
+			const __m128i r7 = Load128(src + 7 * srcStride);
+
+			const __m128i t0 = _mm_unpacklo_epi16(r0, r1);
+			const __m128i t1 = _mm_unpackhi_epi16(r0, r1);
+			const __m128i t2 = _mm_unpacklo_epi16(r2, r3);
+			const __m128i t3 = _mm_unpackhi_epi16(r2, r3);
+			const __m128i t4 = _mm_unpacklo_epi16(r4, r5);
+			const __m128i t5 = _mm_unpackhi_epi16(r4, r5);
+			const __m128i t6 = _mm_unpacklo_epi16(r6, r7);
+			const __m128i t7 = _mm_unpackhi_epi16(r6, r7);
+
+			const __m128i u0 = _mm_unpacklo_epi32(t0, t2);
+			const __m128i u1 = _mm_unpackhi_epi32(t0, t2);
+			const __m128i u2 = _mm_unpacklo_epi32(t1, t3);
+			const __m128i u3 = _mm_unpackhi_epi32(t1, t3);
+			const __m128i u4 = _mm_unpacklo_epi32(t4, t6);
+			const __m128i u5 = _mm_unpackhi_epi32(t4, t6);
+			const __m128i u6 = _mm_unpacklo_epi32(t5, t7);
+			const __m128i u7 = _mm_unpackhi_epi32(t5, t7);
+
+			Store128(dst, _mm_unpacklo_epi64(u0, u4));
+			Store128(dst + dstStride, _mm_unpackhi_epi64(u0, u4));
+			Store128(dst + 2 * dstStride, _mm_unpacklo_epi64(u1, u5));
+			Store128(dst + 3 * dstStride, _mm_unpackhi_epi64(u1, u5));
+			Store128(dst + 4 * dstStride, _mm_unpacklo_epi64(u2, u6));
+			Store128(dst + 5 * dstStride, _mm_unpackhi_epi64(u2, u6));
+			Store128(dst + 6 * dstStride, _mm_unpacklo_epi64(u3, u7));
+			Store128(dst + 7 * dstStride, _mm_unpackhi_epi64(u3, u7));
+		}
+		else if constexpr(BPP == 4u)
+		{
+			const __m128i r0 = Load128(src);
+			const __m128i r1 = Load128(src + srcStride);
+			const __m128i r2 = Load128(src + 2 * srcStride);
+			const __m128i r3 = Load128(src + 3 * srcStride);
+
+			const __m128i t0 = _mm_unpacklo_epi32(r0, r1);
+			const __m128i t1 = _mm_unpackhi_epi32(r0, r1);
+			const __m128i t2 = _mm_unpacklo_epi32(r2, r3);
+			const __m128i t3 = _mm_unpackhi_epi32(r2, r3);
+
+			Store128(dst, _mm_unpacklo_epi64(t0, t2));
+			Store128(dst + dstStride, _mm_unpackhi_epi64(t0, t2));
+			Store128(dst + 2 * dstStride, _mm_unpacklo_epi64(t1, t3));
+			Store128(dst + 3 * dstStride, _mm_unpackhi_epi64(t1, t3));
+		}
+		else if constexpr(BPP == 8u)
+		{
+			const __m128i r0 = Load128(src);
+			const __m128i r1 = Load128(src + srcStride);
+
+			Store128(dst, _mm_unpacklo_epi64(r0, r1));
+			Store128(dst + dstStride, _mm_unpackhi_epi64(r0, r1));
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Transpose a range of pixels one by one.
+	///        Pixel (r, c) of the source is written to pixel (c, r) of the destination.
+	/// @tparam BPP Bytes per pixel.
+	template<u32 BPP>
+	void TransposeScalar(const u8* const src, const isize srcStride, u8* const dst, const isize dstStride,
+	                     const u32 rowBegin, const u32 rowEnd, const u32 colBegin, const u32 colEnd) noexcept
+	{
+		for(u32 r = rowBegin; r < rowEnd; ++r)
+		{
+			const u8* const srcRow = src + NumericCast<isize>(r) * srcStride;
+			for(u32 c = colBegin; c < colEnd; ++c)
+				std::memcpy(dst + NumericCast<isize>(c) * dstStride + r * BPP, srcRow + c * BPP, BPP);
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Transpose a tile of pixels, pixel (r, c) of the source is written to pixel (c, r) of the destination.
+	///        Full blocks are transposed in SIMD registers, the borders pixel by pixel.
+	/// @tparam BPP Bytes per pixel.
+	/// @param src First source row of the tile.
+	/// @param srcStride Distance between source rows in bytes, may be negative.
+	/// @param dst First destination row of the tile.
+	/// @param dstStride Distance between destination rows in bytes, may be negative.
+	/// @param rows Amount of source rows in the tile.
+	/// @param cols Amount of source columns in the tile.
+	/// @param impl Implementation to use, the blocks are transposed with SSE2 unless impl is Scalar.
+	template<u32 BPP>
+	void TransposeTile(const u8* const src, const isize srcStride, u8* const dst, const isize dstStride,
+	                   const u32 rows, const u32 cols, const ImageTransformImplementation impl) noexcept
+	{
+		constexpr u32 N = TransposeBlockSize<BPP>;
+
+		if constexpr(N > 1u)
+		{
+			if(impl != ImageTransformImplementation::Scalar)
+			{
+				const u32 blockRows = rows - rows % N;
+				const u32 blockCols = cols - cols % N;
+
+				for(u32 r = 0; r < blockRows; r += N)
+				{
+					for(u32 c = 0; c < blockCols; c += N)
+					{
+						TransposeBlock<BPP>(src + NumericCast<isize>(r) * srcStride + c * BPP, srcStride,
+						                    dst + NumericCast<isize>(c) * dstStride + r * BPP, dstStride);
+					}
+				}
+
+				TransposeScalar<BPP>(src, srcStride, dst, dstStride, 0u, blockRows, blockCols, cols);
+				TransposeScalar<BPP>(src, srcStride, dst, dstStride, blockRows, rows, 0u, cols);
+				return;
+			}
+		}
+
+		TransposeScalar<BPP>(src, srcStride, dst, dstStride, 0u, rows, 0u, cols);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Reverse the order of the pixels in a SSE2 register.
+	/// @tparam BPP Bytes per pixel, 1, 2, 4 or 8.
+	/// @param value Pixels to reverse.
+	/// @return Reversed pixels.
+	template<u32 BPP>
+	[[nodiscard]] __m128i ReversePixelsSSE2(const __m128i value) noexcept
+	{
+		if constexpr(BPP == 8u)
+			return _mm_shuffle_epi32(value, 0x4E);
+		else if constexpr(BPP == 4u)
+			return _mm_shuffle_epi32(value, 0x1B);
+		else
+		{
+			__m128i reversed = _mm_shuffle_epi32(value, 0x4E);
+			reversed = _mm_shufflelo_epi16(reversed, 0x1B);
+			reversed = _mm_shufflehi_epi16(reversed, 0x1B);
+			if constexpr(BPP == 1u)
+				reversed = _mm_or_si128(_mm_srli_epi16(reversed, 8), _mm_slli_epi16(reversed, 8));
+
+			return reversed;
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Reverse the order of the pixels in an AVX2 register.
+	/// @tparam BPP Bytes per pixel, 1, 2, 4 or 8.
+	/// @param value Pixels to reverse.
+	/// @return Reversed pixels.
+	/// @note Requires AVX2 support.
+	template<u32 BPP>
+	TRAP_TARGET_ISA("avx2")
+	[[nodiscard]] __m256i ReversePixelsAVX2(const __m256i value) noexcept
+	{
+		if constexpr(BPP == 8u)
+			return _mm256_permute4x64_epi64(value, 0x1B);
+		else if constexpr(BPP == 4u)
+			return _mm256_permutevar8x32_epi32(value, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+		else
+		{
+			//Reverse the pixels inside of both 128 bit lanes, then swap the lanes
+			const __m256i shuffle = BPP == 2u ?
+				_mm256_setr_epi8(14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1,
+				                 14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1) :
+				_mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+				                 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+
+			return _mm256_permute4x64_epi64(_mm256_shuffle_epi8(value, shuffle), 0x4E);
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Mirror the pixels in [left, right) of a row one by one.
+	///        Pixels are swapped from both ends towards the middle, so src may be the same as dst.
+	/// @tparam BPP Bytes per pixel.
+	template<u32 BPP>
+	void FlipRowXScalar(const u8* const src, u8* const dst, u32 left, u32 right) noexcept
+	{
+		for(; right - left >= 2u; ++left, --right)
+		{
+			std::array<u8, BPP> l{};
+			std::array<u8, BPP> r{};
+			std::memcpy(l.data(), src + left * BPP, BPP);
+			std::memcpy(r.data(), src + (right - 1u) * BPP, BPP);
+			std::memcpy(dst + left * BPP, r.data(), BPP);
+			std::memcpy(dst + (right - 1u) * BPP, l.data(), BPP);
+		}
+
+		if(right - left == 1u && src != dst)
+			std::memcpy(dst + left * BPP, src + left * BPP, BPP);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Mirror the pixels in [left, right) of a row using SSE2, 16 bytes from both ends at a time.
+	/// @tparam BPP Bytes per pixel, 1, 2, 4 or 8.
+	template<u32 BPP>
+	void FlipRowXSSE2(const u8* const src, u8* const dst, u32 left, u32 right) noexcept
+	{
+		constexpr u32 N = 16u / BPP;
+		for(; right - left >= 2u * N; left += N, right -= N)
+		{
+			const __m128i l = Load128(src + left * BPP);
+			const __m128i r = Load128(src + (right - N) * BPP);
+			Store128(dst + left * BPP, ReversePixelsSSE2<BPP>(r));
+			Store128(dst + (right - N) * BPP, ReversePixelsSSE2<BPP>(l));
+		}
+
+		FlipRowXScalar<BPP>(src, dst, left, right);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Mirror the pixels in [left, right) of a row using AVX2, 32 bytes from both ends at a time.
+	/// @tparam BPP Bytes per pixel, 1, 2, 4 or 8.
+	/// @note Requires AVX2 support.
+	template<u32 BPP>
+	TRAP_TARGET_ISA("avx2")
+	void FlipRowXAVX2(const u8* const src, u8* const dst, u32 left, u32 right) noexcept
+	{
+		constexpr u32 N = 32u / BPP;
+		for(; right - left >= 2u * N; left += N, right -= N)
+		{
+			const __m256i l = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + left * BPP));
+			const __m256i r = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + (right - N) * BPP));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + left * BPP), ReversePixelsAVX2<BPP>(r));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + (right - N) * BPP), ReversePixelsAVX2<BPP>(l));
+		}
+
+		FlipRowXSSE2<BPP>(src, dst, left, right);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Mirror a single row of pixels.
+	///        Pixels are swapped from both ends towards the middle, so src may be the same as dst.
+	/// @tparam BPP Bytes per pixel.
+	/// @param src Source row.
+	/// @param dst Destination row.
+	/// @param width Width of the row in pixels.
+	/// @param impl Implementation to use.
+	template<u32 BPP>
+	void FlipRowX(const u8* const src, u8* const dst, const u32 width, const ImageTransformImplementation impl) noexcept
+	{
+		if constexpr(BPP == 1u || BPP == 2u || BPP == 4u || BPP == 8u)
+		{
+			switch(impl)
+			{
+			case ImageTransformImplementation::AVX2:
+				FlipRowXAVX2<BPP>(src, dst, 0u, width);
+				return;
+
+			case ImageTransformImplementation::SSE2:
+				FlipRowXSSE2<BPP>(src, dst, 0u, width);
+				return;
+
+			case ImageTransformImplementation::Scalar:
+				[[fallthrough]];
+			default:
+				break;
+			}
+		}
+
+		FlipRowXScalar<BPP>(src, dst, 0u, width);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Rotate pixel data by 90 degrees, tile by tile.
+	///
+	///        Clockwise: Source rows are read bottom to top, so every transposed tile lands in ascending order.
+	///        Counter clockwise: Destination rows are written bottom to top.
+	/// @tparam BPP Bytes per pixel.
+	template<u32 BPP>
+	void Rotate90(TRAP::ThreadPool& threadPool, const u8* const src, u8* const dst, const u32 width, const u32 height,
+	              const bool clockwise, const ImageTransformImplementation impl)
+	{
+		constexpr u32 Tile = TileSize<BPP>;
+
+		const isize srcPitch = NumericCast<isize>(width) * BPP;
+		const isize dstPitch = NumericCast<isize>(height) * BPP;
+		const u32 tileRows = (height + Tile - 1u) / Tile;
+
+		TRAP::ParallelFor(threadPool, 0u, tileRows, GetGrain(NumericCast<usize>(width) * Tile * BPP), [&](const u32 tileY)
+		{
+			const u32 y0 = tileY * Tile;
+			const u32 rows = std::min(Tile, height - y0);
+
+			for(u32 x0 = 0; x0 < width; x0 += Tile)
+			{
+				const u32 cols = std::min(Tile, width - x0);
+
+				if(clockwise)
+				{
+					TransposeTile<BPP>(src + NumericCast<isize>(y0 + rows - 1u) * srcPitch + x0 * BPP, -srcPitch,
+					                   dst + NumericCast<isize>(x0) * dstPitch + (height - y0 - rows) * BPP, dstPitch,
+									   rows, cols, impl);
+				}
+				else
+				{
+					TransposeTile<BPP>(src + NumericCast<isize>(y0) * srcPitch + x0 * BPP, srcPitch,
+					                   dst + NumericCast<isize>(width - 1u - x0) * dstPitch + y0 * BPP, -dstPitch,
+									   rows, cols, impl);
+				}
+			}
+		});
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Transpose square pixel data in place.
+	///        Tiles above the diagonal are swapped with their mirrored tile through a temporary tile.
+	/// @tparam BPP Bytes per pixel.
+	template<u32 BPP>
+	void TransposeInPlace(TRAP::ThreadPool& threadPool, u8* const data, const u32 size,
+	                      const ImageTransformImplementation impl)
+	{
+		constexpr u32 Tile = TileSize<BPP>;
+		static_assert(static_cast<usize>(Tile) * Tile * BPP <= MaxTileBytes);
+
+		const isize pitch = NumericCast<isize>(size) * BPP;
+		const u32 tiles = (size + Tile - 1u) / Tile;
+
+		TRAP::ParallelFor(threadPool, 0u, tiles, GetGrain(NumericCast<usize>(size) * Tile * BPP), [&](const u32 tileY)
+		{
+			alignas(64) std::array<u8, MaxTileBytes> temp{};
+			constexpr isize TempPitch = static_cast<isize>(Tile) * BPP;
+
+			const u32 y0 = tileY * Tile;
+			const u32 rows = std::min(Tile, size - y0);
+			u8* const diagonal = data + NumericCast<isize>(y0) * pitch + y0 * BPP;
+
+			//Tile on the diagonal
+			TransposeTile<BPP>(diagonal, pitch, temp.data(), TempPitch, rows, rows, impl);
+			for(u32 r = 0; r < rows; ++r)
+				std::memcpy(diagonal + NumericCast<isize>(r) * pitch, temp.data() + NumericCast<isize>(r) * TempPitch, rows * BPP);
+
+			//Swap the tiles right of the diagonal with the ones below it
+			for(u32 x0 = y0 + Tile; x0 < size; x0 += Tile)
+			{
+				const u32 cols = std::min(Tile, size - x0);
+				u8* const upper = data + NumericCast<isize>(y0) * pitch + x0 * BPP;
+				u8* const lower = data + NumericCast<isize>(x0) * pitch + y0 * BPP;
+
+				TransposeTile<BPP>(upper, pitch, temp.data(), TempPitch, rows, cols, impl);
+				TransposeTile<BPP>(lower, pitch, upper, pitch, cols, rows, impl);
+				for(u32 r = 0; r < cols; ++r)
+					std::memcpy(lower + NumericCast<isize>(r) * pitch, temp.data() + NumericCast<isize>(r) * TempPitch, rows * BPP);
+			}
+		});
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Mirror every row of the pixel data.
+	/// @tparam BPP Bytes per pixel.
+	template<u32 BPP>
+	void FlipX(TRAP::ThreadPool& threadPool, const u8* const src, u8* const dst, const u32 width, const u32 height,
+	           const ImageTransformImplementation impl)
+	{
+		const usize pitch = NumericCast<usize>(width) * BPP;
+
+		TRAP::ParallelFor(threadPool, 0u, height, GetGrain(pitch), [&](const u32 y)
+		{
+			FlipRowX<BPP>(src + y * pitch, dst + y * pitch, width, impl);
+		});
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Reverse the row order of the pixel data.
+	void FlipY(TRAP::ThreadPool& threadPool, const u8* const src, u8* const dst, const u32 height, const usize pitch)
+	{
+		TRAP::ParallelFor(threadPool, 0u, (height + 1u) / 2u, GetGrain(2u * pitch), [&](const u32 y)
+		{
+			const u32 mirrored = height - 1u - y;
+
+			if(src == dst)
+			{
+				if(y != mirrored)
+					std::swap_ranges(dst + y * pitch, dst + (y + 1u) * pitch, dst + mirrored * pitch);
+			}
+			else
+			{
+				std::memcpy(dst + y * pitch, src + mirrored * pitch, pitch);
+				std::memcpy(dst + mirrored * pitch, src + y * pitch, pitch);
+			}
+		});
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Validate the arguments of a transform.
+	/// @param func Name of the calling function.
+	/// @param srcSize Size of the source in bytes.
+	/// @param dstSize Size of the destination in bytes.
+	/// @param width Width of the image in pixels.
+	/// @param height Height of the image in pixels.
+	/// @param bytesPerPixel Size of a single pixel in bytes.
+	/// @return True if the transform can be done, false otherwise.
+	[[nodiscard]] bool ValidateTransform([[maybe_unused]] const std::string_view func, const usize srcSize,
+	                                     const usize dstSize, const u32 width, const u32 height, const u32 bytesPerPixel)
+	{
+		if(!IsSupportedPixelSize(bytesPerPixel))
+		{
+			TRAP_ASSERT(false, func, "(): Unsupported pixel size!");
+			return false;
+		}
+
+		const usize imageSize = NumericCast<usize>(width) * height * bytesPerPixel;
+		if(srcSize < imageSize)
+		{
+			TRAP_ASSERT(false, func, "(): Source is too small!");
+			return false;
+		}
+		if(dstSize < imageSize)
+		{
+			TRAP_ASSERT(false, func, "(): Destination is too small!");
+			return false;
+		}
+
+		return imageSize != 0u;
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Retrieve the fastest image transform implementation supported by the CPU.
+	/// @return Fastest supported image transform implementation.
+	[[nodiscard]] ImageTransformImplementation GetBestImplementation()
+	{
+		using TRAP::INTERNAL::IsImageTransformImplementationSupported;
+
+		static const ImageTransformImplementation impl = []()
+		{
+			if(IsImageTransformImplementationSupported(ImageTransformImplementation::AVX2))
+				return ImageTransformImplementation::AVX2;
+			if(IsImageTransformImplementationSupported(ImageTransformImplementation::SSE2))
+				return ImageTransformImplementation::SSE2;
+
+			return ImageTransformImplementation::Scalar;
+		}();
+
+		return impl;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] bool TRAP::INTERNAL::IsImageTransformImplementationSupported(const ImageTransformImplementation impl)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None &&
+	                                         (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	switch(impl)
+	{
+	case ImageTransformImplementation::Scalar:
+		[[fallthrough]];
+	case ImageTransformImplementation::SSE2: //Part of x86-64
+		return true;
+
+	case ImageTransformImplementation::AVX2:
+		return Utils::GetCPUInfo().AVX2;
+
+	default:
+		return false;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::INTERNAL::FlipPixelsX(ThreadPool& threadPool, const std::span<const u8> src, const std::span<u8> dst,
+                                 const u32 width, const u32 height, const u32 bytesPerPixel)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None &&
+	                                         (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	FlipPixelsX(threadPool, src, dst, width, height, bytesPerPixel, GetBestImplementation());
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::INTERNAL::FlipPixelsX(ThreadPool& threadPool, const std::span<const u8> src, const std::span<u8> dst,
+                                 const u32 width, const u32 height, const u32 bytesPerPixel,
+                                 const ImageTransformImplementation impl)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	TRAP_ASSERT(IsImageTransformImplementationSupported(impl), "FlipPixelsX(): Implementation is not supported by the CPU!");
+
+	if(!ValidateTransform("FlipPixelsX", src.size(), dst.size(), width, height, bytesPerPixel))
+		return;
+
+	DispatchPixelSize(bytesPerPixel, [&](const auto bpp)
+	{
+		::FlipX<bpp()>(threadPool, src.data(), dst.data(), width, height, impl);
+	});
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::INTERNAL::FlipPixelsX(const std::span<const u8> src, const std::span<u8> dst, const u32 width,
+                                 const u32 height, const u32 bytesPerPixel)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None &&
+	                                         (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	FlipPixelsX(GetParallelThreadPool(), src, dst, width, height, bytesPerPixel);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::INTERNAL::FlipPixelsY(ThreadPool& threadPool, const std::span<const u8> src, const std::span<u8> dst,
+                                 const u32 width, const u32 height, const u32 bytesPerPixel)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	if(!ValidateTransform("FlipPixelsY", src.size(), dst.size(), width, height, bytesPerPixel))
+		return;
+
+	::FlipY(threadPool, src.data(), dst.data(), height, NumericCast<usize>(width) * bytesPerPixel);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::INTERNAL::FlipPixelsY(const std::span<const u8> src, const std::span<u8> dst, const u32 width,
+                                 const u32 height, const u32 bytesPerPixel)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None &&
+	                                         (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	FlipPixelsY(GetParallelThreadPool(), src, dst, width, height, bytesPerPixel);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::INTERNAL::RotatePixels90Clockwise(ThreadPool& threadPool, const std::span<const u8> src,
+                                             const std::span<u8> dst, const u32 width, const u32 height,
+											 const u32 bytesPerPixel)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None &&
+	                                         (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	RotatePixels90Clockwise(threadPool, src, dst, width, height, bytesPerPixel, GetBestImplementation());
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::INTERNAL::RotatePixels90Clockwise(ThreadPool& threadPool, const std::span<const u8> src,
+                                             const std::span<u8> dst, const u32 width, const u32 height,
+                                             const u32 bytesPerPixel, const ImageTransformImplementation impl)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	TRAP_ASSERT(IsImageTransformImplementationSupported(impl), "RotatePixels90Clockwise(): Implementation is not supported by the CPU!");
+
+	if(!ValidateTransform("RotatePixels90Clockwise", src.size(), dst.size(), width, height, bytesPerPixel))
+		return;
+
+	DispatchPixelSize(bytesPerPixel, [&](const auto bpp)
+	{
+		Rotate90<bpp()>(threadPool, src.data(), dst.data(), width, height, true, impl);
+	});
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::INTERNAL::RotatePixels90Clockwise(const std::span<const u8> src, const std::span<u8> dst, const u32 width,
+                                             const u32 height, const u32 bytesPerPixel)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None &&
+	                                         (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	RotatePixels90Clockwise(GetParallelThreadPool(), src, dst, width, height, bytesPerPixel);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::INTERNAL::RotatePixels90CounterClockwise(ThreadPool& threadPool, const std::span<const u8> src,
+                                                    const std::span<u8> dst, const u32 width, const u32 height,
+													const u32 bytesPerPixel)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None &&
+	                                         (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	RotatePixels90CounterClockwise(threadPool, src, dst, width, height, bytesPerPixel, GetBestImplementation());
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::INTERNAL::RotatePixels90CounterClockwise(ThreadPool& threadPool, const std::span<const u8> src,
+                                                    const std::span<u8> dst, const u32 width, const u32 height,
+                                                    const u32 bytesPerPixel, const ImageTransformImplementation impl)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	TRAP_ASSERT(IsImageTransformImplementationSupported(impl), "RotatePixels90CounterClockwise(): Implementation is not supported by the CPU!");
+
+	if(!ValidateTransform("RotatePixels90CounterClockwise", src.size(), dst.size(), width, height, bytesPerPixel))
+		return;
+
+	DispatchPixelSize(bytesPerPixel, [&](const auto bpp)
+	{
+		Rotate90<bpp()>(threadPool, src.data(), dst.data(), width, height, false, impl);
+	});
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::INTERNAL::RotatePixels90CounterClockwise(const std::span<const u8> src, const std::span<u8> dst,
+                                                    const u32 width, const u32 height, const u32 bytesPerPixel)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None &&
+	                                         (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	RotatePixels90CounterClockwise(GetParallelThreadPool(), src, dst, width, height, bytesPerPixel);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::INTERNAL::RotatePixels90ClockwiseInPlace(ThreadPool& threadPool, const std::span<u8> data, const u32 size,
+                                                    const u32 bytesPerPixel)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None &&
+	                                         (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	RotatePixels90ClockwiseInPlace(threadPool, data, size, bytesPerPixel, GetBestImplementation());
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::INTERNAL::RotatePixels90ClockwiseInPlace(ThreadPool& threadPool, const std::span<u8> data, const u32 size,
+                                                    const u32 bytesPerPixel, const ImageTransformImplementation impl)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	TRAP_ASSERT(IsImageTransformImplementationSupported(impl), "RotatePixels90ClockwiseInPlace(): Implementation is not supported by the CPU!");
+
+	if(!ValidateTransform("RotatePixels90ClockwiseInPlace", data.size(), data.size(), size, size, bytesPerPixel))
+		return;
+
+	//Clockwise rotation is a transpose followed by mirroring every row
+	DispatchPixelSize(bytesPerPixel, [&](const auto bpp)
+	{
+		TransposeInPlace<bpp()>(threadPool, data.data(), size, impl);
+		::FlipX<bpp()>(threadPool, data.data(), data.data(), size, size, impl);
+	});
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::INTERNAL::RotatePixels90ClockwiseInPlace(const std::span<u8> data, const u32 size, const u32 bytesPerPixel)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None &&
+	                                         (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	RotatePixels90ClockwiseInPlace(GetParallelThreadPool(), data, size, bytesPerPixel);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::INTERNAL::RotatePixels90CounterClockwiseInPlace(ThreadPool& threadPool, const std::span<u8> data,
+                                                           const u32 size, const u32 bytesPerPixel)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None &&
+	                                         (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	RotatePixels90CounterClockwiseInPlace(threadPool, data, size, bytesPerPixel, GetBestImplementation());
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::INTERNAL::RotatePixels90CounterClockwiseInPlace(ThreadPool& threadPool, const std::span<u8> data,
+                                                           const u32 size, const u32 bytesPerPixel,
+                                                           const ImageTransformImplementation impl)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	TRAP_ASSERT(IsImageTransformImplementationSupported(impl), "RotatePixels90CounterClockwiseInPlace(): Implementation is not supported by the CPU!");
+
+	if(!ValidateTransform("RotatePixels90CounterClockwiseInPlace", data.size(), data.size(), size, size, bytesPerPixel))
+		return;
+
+	//Counter clockwise rotation is a transpose followed by reversing the row order
+	DispatchPixelSize(bytesPerPixel, [&](const auto bpp)
+	{
+		TransposeInPlace<bpp()>(threadPool, data.data(), size, impl);
+	});
+	::FlipY(threadPool, data.data(), data.data(), size, NumericCast<usize>(size) * bytesPerPixel);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::INTERNAL::RotatePixels90CounterClockwiseInPlace(const std::span<u8> data, const u32 size,
+                                                           const u32 bytesPerPixel)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None &&
+	                                         (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	RotatePixels90CounterClockwiseInPlace(GetParallelThreadPool(), data, size, bytesPerPixel);
+}
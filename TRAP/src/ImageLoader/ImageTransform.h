@@ -0,0 +1,143 @@
+#ifndef TRAP_IMAGETRANSFORM_H
+#define TRAP_IMAGETRANSFORM_H
+
+#include <span>
+
+#include "Core/Types.h"
+
+namespace TRAP
+{
+	class ThreadPool;
+}
+
+namespace TRAP::INTERNAL
+{
+	/// @brief Available image transform implementations.
+	///        The transform functions automatically use the fastest one supported by the CPU.
+	enum class ImageTransformImplementation : u8
+	{
+		Scalar,
+		SSE2,
+		AVX2 //Mirrors rows with AVX2, transposes tiles with SSE2
+	};
+
+	/// @brief Check whether the given image transform implementation is supported by the CPU.
+	/// @param impl Image transform implementation.
+	/// @return True if supported, false otherwise.
+	[[nodiscard]] bool IsImageTransformImplementationSupported(ImageTransformImplementation impl);
+
+	/// @brief Flip pixel data on its X axis (mirror every row).
+	///        Rows are split across the ThreadPool for large images.
+	/// @param threadPool ThreadPool to use.
+	/// @param src Pixel data, width * height * bytesPerPixel bytes.
+	/// @param dst Output for the flipped pixel data, width * height * bytesPerPixel bytes.
+	/// @param width Width of the image in pixels.
+	/// @param height Height of the image in pixels.
+	/// @param bytesPerPixel Size of a single pixel in bytes (1 - 16).
+	/// @note dst may be the same as src to flip in place, any other overlap is not allowed.
+	void FlipPixelsX(ThreadPool& threadPool, std::span<const u8> src, std::span<u8> dst, u32 width, u32 height,
+	                 u32 bytesPerPixel);
+	/// @brief Flip pixel data on its X axis (mirror every row) using a specific implementation.
+	/// @param impl Image transform implementation to use, must be supported by the CPU.
+	/// @note See FlipPixelsX(ThreadPool&, std::span<const u8>, std::span<u8>, u32, u32, u32) for details.
+	/// @note Only intended for testing and benchmarking.
+	void FlipPixelsX(ThreadPool& threadPool, std::span<const u8> src, std::span<u8> dst, u32 width, u32 height,
+	                 u32 bytesPerPixel, ImageTransformImplementation impl);
+	/// @brief Flip pixel data on its X axis (mirror every row) using the engine ThreadPool.
+	/// @note See FlipPixelsX(ThreadPool&, std::span<const u8>, std::span<u8>, u32, u32, u32) for details.
+	void FlipPixelsX(std::span<const u8> src, std::span<u8> dst, u32 width, u32 height, u32 bytesPerPixel);
+
+	/// @brief Flip pixel data on its Y axis (reverse the row order).
+	///        Rows are split across the ThreadPool for large images.
+	/// @param threadPool ThreadPool to use.
+	/// @param src Pixel data, width * height * bytesPerPixel bytes.
+	/// @param dst Output for the flipped pixel data, width * height * bytesPerPixel bytes.
+	/// @param width Width of the image in pixels.
+	/// @param height Height of the image in pixels.
+	/// @param bytesPerPixel Size of a single pixel in bytes (1 - 16).
+	/// @note dst may be the same as src to flip in place, any other overlap is not allowed.
+	void FlipPixelsY(ThreadPool& threadPool, std::span<const u8> src, std::span<u8> dst, u32 width, u32 height,
+	                 u32 bytesPerPixel);
+	/// @brief Flip pixel data on its Y axis (reverse the row order) using the engine ThreadPool.
+	/// @note See FlipPixelsY(ThreadPool&, std::span<const u8>, std::span<u8>, u32, u32, u32) for details.
+	void FlipPixelsY(std::span<const u8> src, std::span<u8> dst, u32 width, u32 height, u32 bytesPerPixel);
+
+	/// @brief Rotate pixel data by 90 degrees clockwise.
+	///        The image is processed in cache sized tiles which are transposed in SIMD registers
+	///        and split across the ThreadPool for large images.
+	/// @param threadPool ThreadPool to use.
+	/// @param src Pixel data, width * height * bytesPerPixel bytes.
+	/// @param dst Output for the rotated pixel data, height pixels wide and width pixels high.
+	/// @param width Width of the source image in pixels.
+	/// @param height Height of the source image in pixels.
+	/// @param bytesPerPixel Size of a single pixel in bytes (1 - 16).
+	/// @note src and dst must not overlap, use RotatePixels90ClockwiseInPlace() for square images instead.
+	void RotatePixels90Clockwise(ThreadPool& threadPool, std::span<const u8> src, std::span<u8> dst, u32 width,
+	                             u32 height, u32 bytesPerPixel);
+	/// @brief Rotate pixel data by 90 degrees clockwise using a specific implementation.
+	/// @param impl Image transform implementation to use, must be supported by the CPU.
+	/// @note See RotatePixels90Clockwise(ThreadPool&, std::span<const u8>, std::span<u8>, u32, u32, u32) for details.
+	/// @note Only intended for testing and benchmarking.
+	void RotatePixels90Clockwise(ThreadPool& threadPool, std::span<const u8> src, std::span<u8> dst, u32 width,
+	                             u32 height, u32 bytesPerPixel, ImageTransformImplementation impl);
+	/// @brief Rotate pixel data by 90 degrees clockwise using the engine ThreadPool.
+	/// @note See RotatePixels90Clockwise(ThreadPool&, std::span<const u8>, std::span<u8>, u32, u32, u32) for details.
+	void RotatePixels90Clockwise(std::span<const u8> src, std::span<u8> dst, u32 width, u32 height, u32 bytesPerPixel);
+
+	/// @brief Rotate pixel data by 90 degrees counter clockwise.
+	///        The image is processed in cache sized tiles which are transposed in SIMD registers
+	///        and split across the ThreadPool for large images.
+	/// @param threadPool ThreadPool to use.
+	/// @param src Pixel data, width * height * bytesPerPixel bytes.
+	/// @param dst Output for the rotated pixel data, height pixels wide and width pixels high.
+	/// @param width Width of the source image in pixels.
+	/// @param height Height of the source image in pixels.
+	/// @param bytesPerPixel Size of a single pixel in bytes (1 - 16).
+	/// @note src and dst must not overlap, use RotatePixels90CounterClockwiseInPlace() for square images instead.
+	void RotatePixels90CounterClockwise(ThreadPool& threadPool, std::span<const u8> src, std::span<u8> dst, u32 width,
+	                                    u32 height, u32 bytesPerPixel);
+	/// @brief Rotate pixel data by 90 degrees counter clockwise using a specific implementation.
+	/// @param impl Image transform implementation to use, must be supported by the CPU.
+	/// @note See RotatePixels90CounterClockwise(ThreadPool&, std::span<const u8>, std::span<u8>, u32, u32, u32) for details.
+	/// @note Only intended for testing and benchmarking.
+	void RotatePixels90CounterClockwise(ThreadPool& threadPool, std::span<const u8> src, std::span<u8> dst, u32 width,
+	                                    u32 height, u32 bytesPerPixel, ImageTransformImplementation impl);
+	/// @brief Rotate pixel data by 90 degrees counter clockwise using the engine ThreadPool.
+	/// @note See RotatePixels90CounterClockwise(ThreadPool&, std::span<const u8>, std::span<u8>, u32, u32, u32) for details.
+	void RotatePixels90CounterClockwise(std::span<const u8> src, std::span<u8> dst, u32 width, u32 height,
+	                                    u32 bytesPerPixel);
+
+	/// @brief Rotate square pixel data by 90 degrees clockwise in place.
+	/// @param threadPool ThreadPool to use.
+	/// @param data Pixel data, size * size * bytesPerPixel bytes.
+	/// @param size Width and height of the image in pixels.
+	/// @param bytesPerPixel Size of a single pixel in bytes (1 - 16).
+	void RotatePixels90ClockwiseInPlace(ThreadPool& threadPool, std::span<u8> data, u32 size, u32 bytesPerPixel);
+	/// @brief Rotate square pixel data by 90 degrees clockwise in place using a specific implementation.
+	/// @param impl Image transform implementation to use, must be supported by the CPU.
+	/// @note See RotatePixels90ClockwiseInPlace(ThreadPool&, std::span<u8>, u32, u32) for details.
+	/// @note Only intended for testing and benchmarking.
+	void RotatePixels90ClockwiseInPlace(ThreadPool& threadPool, std::span<u8> data, u32 size, u32 bytesPerPixel,
+	                                    ImageTransformImplementation impl);
+	/// @brief Rotate square pixel data by 90 degrees clockwise in place using the engine ThreadPool.
+	/// @note See RotatePixels90ClockwiseInPlace(ThreadPool&, std::span<u8>, u32, u32) for details.
+	void RotatePixels90ClockwiseInPlace(std::span<u8> data, u32 size, u32 bytesPerPixel);
+
+	/// @brief Rotate square pixel data by 90 degrees counter clockwise in place.
+	/// @param threadPool ThreadPool to use.
+	/// @param data Pixel data, size * size * bytesPerPixel bytes.
+	/// @param size Width and height of the image in pixels.
+	/// @param bytesPerPixel Size of a single pixel in bytes (1 - 16).
+	void RotatePixels90CounterClockwiseInPlace(ThreadPool& threadPool, std::span<u8> data, u32 size, u32 bytesPerPixel);
+	/// @brief Rotate square pixel data by 90 degrees counter clockwise in place using a specific implementation.
+	/// @param impl Image transform implementation to use, must be supported by the CPU.
+	/// @note See RotatePixels90CounterClockwiseInPlace(ThreadPool&, std::span<u8>, u32, u32) for details.
+	/// @note Only intended for testing and benchmarking.
+	void RotatePixels90CounterClockwiseInPlace(ThreadPool& threadPool, std::span<u8> data, u32 size, u32 bytesPerPixel,
+	                                           ImageTransformImplementation impl);
+	/// @brief Rotate square pixel data by 90 degrees counter clockwise in place using the engine ThreadPool.
+	/// @note See RotatePixels90CounterClockwiseInPlace(ThreadPool&, std::span<u8>, u32, u32) for details.
+	void RotatePixels90CounterClockwiseInPlace(std::span<u8> data, u32 size, u32 bytesPerPixel);
+}
+
+#endif /*TRAP_IMAGETRANSFORM_H*/
@@ -0,0 +1,267 @@
+#include "TRAPPCH.h"
+#include "KTX2Container.h"
+
+#include "FileSystem/FileSystem.h"
+#include "FileSystem/MappedFile.h"
+#include "Utils/ByteReader.h"
+#include "Utils/Decompress/Inflater.h"
+#include "Utils/Hash/Adler32.h"
+#include "Utils/Memory.h"
+#include "Utils/Utils.h"
+
+namespace
+{
+	constexpr std::array<u8, 12> KTX2Identifier{0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'};
+
+	constexpr u32 SupercompressionNone = 0;
+	constexpr u32 SupercompressionZlib = 3;
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Inflate a zlib stream of a supercompressed level.
+	/// @param compressed zlib stream including header and Adler32 checksum.
+	/// @param destination Destination for the decompressed data.
+	/// @return True if the stream decompressed to exactly destination.size() bytes and the checksum matches, false otherwise.
+	[[nodiscard]] bool InflateZlib(const std::span<const u8> compressed, const std::span<u8> destination)
+	{
+		static constexpr usize ZlibHeaderSize = 2;
+		static constexpr usize Adler32Size = 4;
+
+		if(compressed.size() < ZlibHeaderSize + Adler32Size)
+			return false;
+
+		//Compression method must be deflate and a preset dictionary is not allowed
+		const u32 CMF = compressed[0];
+		const u32 FLG = compressed[1];
+		if((CMF * 256u + FLG) % 31u != 0u || (CMF & 15u) != 8u || (CMF >> 4u) > 7u || ((FLG >> 5u) & 1u) != 0u)
+			return false;
+
+		TRAP::Utils::Decompress::Inflater inflater{};
+		inflater.AppendInput(compressed.subspan(ZlibHeaderSize));
+		inflater.FinishInput();
+
+		//The level index is untrusted, the stream has to end exactly at the declared size
+		std::array<u8, 1> excess{};
+		if(inflater.Inflate(destination) != destination.size() || inflater.Inflate(excess) != 0 ||
+		   inflater.GetStatus() != TRAP::Utils::Decompress::Inflater::Status::Done)
+		{
+			return false;
+		}
+
+		const std::span<const u8> trailer = inflater.GetTrailingInput();
+		if(trailer.size() < Adler32Size)
+			return false;
+
+		TRAP::Utils::Hash::Adler32Hasher adler32{};
+		adler32.Update(destination);
+		const std::array<u8, 4> checksum = adler32.Finalize();
+
+		return std::ranges::equal(checksum, trailer.first(Adler32Size));
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+TRAP::INTERNAL::KTX2Container::KTX2Container(std::filesystem::path filepath)
+	: TextureContainer(std::move(filepath))
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	TP_DEBUG(Log::ImageKTX2Prefix, "Loading texture container: ", m_filepath);
+
+	if(!FileSystem::Exists(m_filepath))
+		return;
+
+	m_file = FileSystem::MapFile(m_filepath);
+	if(!m_file)
+	{
+		TP_ERROR(Log::ImageKTX2Prefix, "Couldn't open file path: ", m_filepath, "!");
+		return;
+	}
+
+	Decode(m_file->GetData());
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+TRAP::INTERNAL::KTX2Container::KTX2Container(const std::span<const u8> data)
+	: TextureContainer("")
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	TP_DEBUG(Log::ImageKTX2Prefix, "Loading texture container from memory");
+
+	m_data.assign(data.begin(), data.end());
+	Decode(m_data);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::INTERNAL::KTX2Container::Decode(const std::span<const u8> data)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	if(data.size() < HeaderSize + LevelIndexEntrySize)
+	{
+		TP_ERROR(Log::ImageKTX2Prefix, "File size is too small: ", m_filepath, "!");
+		return;
+	}
+
+	Utils::ByteReader reader(data);
+
+	Header header{};
+	reader.Read(header.Identifier);
+	reader.Read(header.VkFormat);
+	reader.Read(header.TypeSize);
+	reader.Read(header.PixelWidth);
+	reader.Read(header.PixelHeight);
+	reader.Read(header.PixelDepth);
+	reader.Read(header.LayerCount);
+	reader.Read(header.FaceCount);
+	reader.Read(header.LevelCount);
+	reader.Read(header.SupercompressionScheme);
+
+	if(header.Identifier != KTX2Identifier)
+	{
+		TP_ERROR(Log::ImageKTX2Prefix, "Invalid identifier!");
+		return;
+	}
+
+	//Convert to machines endian
+	if constexpr (Utils::GetEndian() != Utils::Endian::Little)
+	{
+		for(u32* const value : {&header.VkFormat, &header.TypeSize, &header.PixelWidth, &header.PixelHeight,
+		                        &header.PixelDepth, &header.LayerCount, &header.FaceCount, &header.LevelCount,
+								&header.SupercompressionScheme})
+		{
+			Utils::Memory::SwapBytes(*value);
+		}
+	}
+
+	//Validation checks
+	if(header.SupercompressionScheme != SupercompressionNone && header.SupercompressionScheme != SupercompressionZlib)
+	{
+		TP_ERROR(Log::ImageKTX2Prefix, "Unsupported supercompression scheme (", header.SupercompressionScheme, ")!");
+		return;
+	}
+	if(header.FaceCount != 1 && header.FaceCount != 6)
+	{
+		TP_ERROR(Log::ImageKTX2Prefix, "Invalid face count, must be 1 or 6 (", header.FaceCount, ")!");
+		return;
+	}
+
+	m_format = VkFormatToImageFormat(header.VkFormat);
+	if(m_format == Graphics::API::ImageFormat::Undefined)
+	{
+		TP_ERROR(Log::ImageKTX2Prefix, "Unsupported VkFormat (", header.VkFormat, ")!");
+		return;
+	}
+
+	//0 means the dimension is not used
+	m_width = header.PixelWidth;
+	m_height = std::max(header.PixelHeight, 1u);
+	m_depth = std::max(header.PixelDepth, 1u);
+	m_isCubemap = header.FaceCount == 6;
+	m_arraySize = std::max(header.LayerCount, 1u) * header.FaceCount;
+	//A level count of 0 requests mip generation at runtime, only the base level is stored
+	m_mipLevels = std::max(header.LevelCount, 1u);
+
+	//Every subresource is at least a single byte, this also prevents huge allocations for corrupted headers
+	if(m_width < 1 || m_mipLevels > std::bit_width(std::max({m_width, m_height, m_depth})) ||
+	   NumericCast<u64>(m_mipLevels) * m_arraySize > data.size())
+	{
+		TP_ERROR(Log::ImageKTX2Prefix, "Invalid dimensions (", m_width, "x", m_height, "x", m_depth, ", ", m_arraySize,
+		         " layers, ", m_mipLevels, " mip levels)!");
+		return;
+	}
+
+	//Skip the data format descriptor, key/value data and supercompression global data indices
+	reader.Seek(HeaderSize);
+
+	std::vector<LevelIndex> levels(m_mipLevels);
+	for(LevelIndex& level : levels)
+	{
+		reader.Read(level.ByteOffset);
+		reader.Read(level.ByteLength);
+		reader.Read(level.UncompressedByteLength);
+
+		if constexpr (Utils::GetEndian() != Utils::Endian::Little)
+		{
+			Utils::Memory::SwapBytes(level.ByteOffset);
+			Utils::Memory::SwapBytes(level.ByteLength);
+			Utils::Memory::SwapBytes(level.UncompressedByteLength);
+		}
+
+		if(reader.HasFailed() || level.ByteOffset > data.size() || level.ByteLength > data.size() - level.ByteOffset)
+		{
+			TP_ERROR(Log::ImageKTX2Prefix, "Level index is out of bounds!");
+			return;
+		}
+	}
+
+	if(header.SupercompressionScheme == SupercompressionZlib)
+	{
+		//Deflate can't compress better than 1032:1, bigger sizes are corrupted and would cause huge allocations
+		static constexpr u64 MaxDeflateRatio = 1032;
+
+		//Inflate every level into a single buffer, the level index is updated to point into it
+		u64 totalSize = 0;
+		for(const LevelIndex& level : levels)
+		{
+			if(level.UncompressedByteLength > level.ByteLength * MaxDeflateRatio)
+			{
+				TP_ERROR(Log::ImageKTX2Prefix, "Uncompressed level size is too big (", level.UncompressedByteLength, " bytes)!");
+				return;
+			}
+
+			totalSize += level.UncompressedByteLength;
+		}
+
+		std::vector<u8> inflated(static_cast<usize>(totalSize));
+		u64 offset = 0;
+		for(LevelIndex& level : levels)
+		{
+			const std::span<const u8> compressed = data.subspan(static_cast<usize>(level.ByteOffset), static_cast<usize>(level.ByteLength));
+			const std::span<u8> destination = std::span(inflated).subspan(static_cast<usize>(offset), static_cast<usize>(level.UncompressedByteLength));
+			if(!InflateZlib(compressed, destination))
+			{
+				TP_ERROR(Log::ImageKTX2Prefix, "Failed to inflate level data!");
+				return;
+			}
+
+			level.ByteOffset = offset;
+			level.ByteLength = level.UncompressedByteLength;
+			offset += level.UncompressedByteLength;
+		}
+
+		//The compressed data isn't needed anymore
+		m_data = std::move(inflated);
+		m_file.Reset();
+	}
+
+	//Every level stores its layers, faces and depth slices tightly packed in that order
+	m_subresources.resize(NumericCast<usize>(m_mipLevels) * m_arraySize);
+	for(u32 mip = 0; mip < m_mipLevels; ++mip)
+	{
+		const u64 subresourceSize = CalculateSubresourceSize(m_format, std::max(m_width >> mip, 1u), std::max(m_height >> mip, 1u),
+		                                                     std::max(m_depth >> mip, 1u));
+		if(subresourceSize * m_arraySize > levels[mip].ByteLength)
+		{
+			TP_ERROR(Log::ImageKTX2Prefix, "Level ", mip, " is truncated!");
+			m_subresources.clear();
+			return;
+		}
+
+		for(u32 layer = 0; layer < m_arraySize; ++layer)
+		{
+			m_subresources[NumericCast<usize>(mip) * m_arraySize + layer] = Subresource
+			{
+				.Offset = levels[mip].ByteOffset + layer * subresourceSize,
+				.Size = subresourceSize
+			};
+		}
+	}
+
+	if(!Validate(Log::ImageKTX2Prefix))
+		m_subresources.clear();
+}
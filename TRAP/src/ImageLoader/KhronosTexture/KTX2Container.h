@@ -0,0 +1,116 @@
+#ifndef TRAP_KTX2CONTAINER_H
+#define TRAP_KTX2CONTAINER_H
+
+#include "ImageLoader/TextureContainer.h"
+
+namespace TRAP::INTERNAL
+{
+	/// @brief Khronos Texture 2 (KTX2) container.
+	/// @note Supercompression is only supported for zlib, Basis Universal and Zstandard are not supported.
+	class KTX2Container final : public TextureContainer
+	{
+	public:
+		/// @brief Constructor.
+		/// @param filepath File path of the container to load.
+		explicit KTX2Container(std::filesystem::path filepath);
+		/// @brief Constructor.
+		/// @param data Encoded container data to load.
+		explicit KTX2Container(std::span<const u8> data);
+		/// @brief Copy constructor.
+		consteval KTX2Container(const KTX2Container&) = delete;
+		/// @brief Copy assignment operator.
+		consteval KTX2Container& operator=(const KTX2Container&) = delete;
+		/// @brief Move constructor.
+		KTX2Container(KTX2Container&&) noexcept = default;
+		/// @brief Move assignment operator.
+		KTX2Container& operator=(KTX2Container&&) noexcept = default;
+		/// @brief Destructor.
+		~KTX2Container() override = default;
+
+		/// @brief Convert a VkFormat value to an image format.
+		/// @param vkFormat VkFormat value.
+		/// @return Image format, ImageFormat::Undefined if the format is not supported.
+		[[nodiscard]] static constexpr Graphics::API::ImageFormat VkFormatToImageFormat(u32 vkFormat) noexcept;
+
+	private:
+		/// @brief Decode the container.
+		/// @param data Encoded container data.
+		void Decode(std::span<const u8> data);
+
+		/// @brief Size of the header in the file, including the index.
+		static constexpr usize HeaderSize = 80;
+		/// @brief Size of a single entry of the level index.
+		static constexpr usize LevelIndexEntrySize = 24;
+
+		struct Header
+		{
+			std::array<u8, 12> Identifier{};
+			u32 VkFormat = 0;
+			u32 TypeSize = 0;
+			u32 PixelWidth = 0;
+			u32 PixelHeight = 0;
+			u32 PixelDepth = 0;
+			u32 LayerCount = 0;
+			u32 FaceCount = 0;
+			u32 LevelCount = 0;
+			u32 SupercompressionScheme = 0;
+		};
+
+		struct LevelIndex
+		{
+			u64 ByteOffset = 0;
+			u64 ByteLength = 0;
+			u64 UncompressedByteLength = 0;
+		};
+	};
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] constexpr TRAP::Graphics::API::ImageFormat TRAP::INTERNAL::KTX2Container::VkFormatToImageFormat(const u32 vkFormat) noexcept
+{
+	using Graphics::API::ImageFormat;
+
+	//Values of the VkFormat enum, kept here so the container can be parsed without Vulkan
+	switch(vkFormat)
+	{
+	case 9: return ImageFormat::R8_UNORM;
+	case 15: return ImageFormat::R8_SRGB;
+	case 16: return ImageFormat::R8G8_UNORM;
+	case 22: return ImageFormat::R8G8_SRGB;
+	case 37: return ImageFormat::R8G8B8A8_UNORM;
+	case 43: return ImageFormat::R8G8B8A8_SRGB;
+	case 44: return ImageFormat::B8G8R8A8_UNORM;
+	case 50: return ImageFormat::B8G8R8A8_SRGB;
+	case 70: return ImageFormat::R16_UNORM;
+	case 76: return ImageFormat::R16_SFLOAT;
+	case 77: return ImageFormat::R16G16_UNORM;
+	case 83: return ImageFormat::R16G16_SFLOAT;
+	case 91: return ImageFormat::R16G16B16A16_UNORM;
+	case 97: return ImageFormat::R16G16B16A16_SFLOAT;
+	case 100: return ImageFormat::R32_SFLOAT;
+	case 103: return ImageFormat::R32G32_SFLOAT;
+	case 109: return ImageFormat::R32G32B32A32_SFLOAT;
+	case 122: return ImageFormat::B10G11R11_UFLOAT;
+	case 123: return ImageFormat::E5B9G9R9_UFLOAT;
+	case 131: return ImageFormat::DXBC1_RGB_UNORM;
+	case 132: return ImageFormat::DXBC1_RGB_SRGB;
+	case 133: return ImageFormat::DXBC1_RGBA_UNORM;
+	case 134: return ImageFormat::DXBC1_RGBA_SRGB;
+	case 135: return ImageFormat::DXBC2_UNORM;
+	case 136: return ImageFormat::DXBC2_SRGB;
+	case 137: return ImageFormat::DXBC3_UNORM;
+	case 138: return ImageFormat::DXBC3_SRGB;
+	case 139: return ImageFormat::DXBC4_UNORM;
+	case 140: return ImageFormat::DXBC4_SNORM;
+	case 141: return ImageFormat::DXBC5_UNORM;
+	case 142: return ImageFormat::DXBC5_SNORM;
+	case 143: return ImageFormat::DXBC6H_UFLOAT;
+	case 144: return ImageFormat::DXBC6H_SFLOAT;
+	case 145: return ImageFormat::DXBC7_UNORM;
+	case 146: return ImageFormat::DXBC7_SRGB;
+	default: return ImageFormat::Undefined;
+	}
+}
+
+#endif /*TRAP_KTX2CONTAINER_H*/
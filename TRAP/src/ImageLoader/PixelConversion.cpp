@@ -0,0 +1,1030 @@
+#include "TRAPPCH.h"
+#include "PixelConversion.h"
+
+#include "Utils/Utils.h"
+#include "TRAP_Assert.h"
+
+#include <immintrin.h>
+
+namespace
+{
+	using TRAP::INTERNAL::PixelConversionImplementation;
+
+	/// @brief Value of a fully opaque alpha channel.
+	template<typename T>
+	constexpr T OpaqueAlpha = std::numeric_limits<T>::max();
+	template<>
+	constexpr f32 OpaqueAlpha<f32> = 1.0f;
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Create the byte shuffle expanding 12 bytes of RGB pixels to 16 bytes of RGBA pixels.
+	///        The alpha bytes are zeroed.
+	/// @tparam T Channel type.
+	/// @return Byte shuffle for _mm_shuffle_epi8().
+	template<typename T>
+	[[nodiscard]] consteval std::array<u8, 16> MakeRGBToRGBAShuffle() noexcept
+	{
+		std::array<u8, 16> shuffle{};
+		for(usize i = 0; i < shuffle.size(); ++i)
+		{
+			const usize pixel = i / (4u * sizeof(T));
+			const usize byte = i % (4u * sizeof(T));
+			shuffle[i] = byte < 3u * sizeof(T) ? static_cast<u8>(pixel * 3u * sizeof(T) + byte) : 0x80u;
+		}
+
+		return shuffle;
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Create the byte shuffle compacting 16 bytes of RGBA pixels to 12 bytes of RGB pixels.
+	///        The upper 4 bytes are zeroed.
+	/// @tparam T Channel type.
+	/// @return Byte shuffle for _mm_shuffle_epi8().
+	template<typename T>
+	[[nodiscard]] consteval std::array<u8, 16> MakeRGBAToRGBShuffle() noexcept
+	{
+		std::array<u8, 16> shuffle{};
+		for(usize i = 0; i < shuffle.size(); ++i)
+		{
+			const usize pixel = i / (3u * sizeof(T));
+			const usize byte = i % (3u * sizeof(T));
+			shuffle[i] = i < 12u ? static_cast<u8>(pixel * 4u * sizeof(T) + byte) : 0x80u;
+		}
+
+		return shuffle;
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Create the opaque alpha bytes for 16 bytes of RGBA pixels.
+	/// @tparam T Channel type.
+	/// @return Alpha bytes, all color bytes are zero.
+	template<typename T>
+	[[nodiscard]] consteval std::array<u8, 16> MakeAlphaBytes() noexcept
+	{
+		const auto alpha = std::bit_cast<std::array<u8, sizeof(T)>>(OpaqueAlpha<T>);
+
+		std::array<u8, 16> bytes{};
+		for(usize i = 0; i < bytes.size(); ++i)
+		{
+			const usize byte = i % (4u * sizeof(T));
+			if(byte >= 3u * sizeof(T))
+				bytes[i] = alpha[byte - 3u * sizeof(T)];
+		}
+
+		return bytes;
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	template<typename T>
+	constexpr std::array<u8, 16> RGBToRGBAShuffle = MakeRGBToRGBAShuffle<T>();
+	template<typename T>
+	constexpr std::array<u8, 16> RGBAToRGBShuffle = MakeRGBAToRGBShuffle<T>();
+	template<typename T>
+	constexpr std::array<u8, 16> AlphaBytes = MakeAlphaBytes<T>();
+
+	constexpr std::array<u8, 16> SwapRedBlue3Shuffle
+	{
+		2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, 0x80, 0x80, 0x80, 0x80
+	};
+	constexpr std::array<u8, 16> SwapRedBlue4Shuffle
+	{
+		2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15
+	};
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	[[nodiscard]] __m128i Load128(const std::array<u8, 16>& bytes) noexcept
+	{
+		return _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes.data()));
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	TRAP_TARGET_ISA("avx2")
+	[[nodiscard]] __m256i Broadcast256(const std::array<u8, 16>& bytes) noexcept
+	{
+		return _mm256_broadcastsi128_si256(Load128(bytes));
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief 48 bytes split into four groups of 12 bytes, every group starts at the lowest byte of its register.
+	struct ByteGroups
+	{
+		__m128i G0;
+		__m128i G1;
+		__m128i G2;
+		__m128i G3;
+	};
+
+	/// @brief Load 48 bytes as four groups of 12 bytes.
+	/// @param src Data to load.
+	/// @return Loaded groups.
+	TRAP_TARGET_ISA("ssse3")
+	[[nodiscard]] ByteGroups Load12ByteGroupsSSSE3(const u8* const src) noexcept
+	{
+		const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+		const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 16u));
+		const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 32u));
+
+		return {a, _mm_alignr_epi8(b, a, 12), _mm_alignr_epi8(c, b, 8), _mm_srli_si128(c, 4)};
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Store four groups of 12 bytes as 48 contiguous bytes.
+	/// @param dst Output for the groups.
+	/// @param groups Groups to store, the upper 4 bytes of every group must be zero.
+	TRAP_TARGET_ISA("ssse3")
+	void Store12ByteGroupsSSSE3(u8* const dst, const ByteGroups& groups) noexcept
+	{
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_or_si128(groups.G0, _mm_slli_si128(groups.G1, 12)));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 16u), _mm_or_si128(_mm_srli_si128(groups.G1, 4),
+		                                                                     _mm_slli_si128(groups.G2, 8)));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 32u), _mm_or_si128(_mm_srli_si128(groups.G2, 8),
+		                                                                     _mm_slli_si128(groups.G3, 4)));
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Load 24 bytes as two groups of 12 bytes, one per 128 bit lane.
+	/// @param src Data to load, 32 bytes have to be readable.
+	/// @return Loaded groups.
+	TRAP_TARGET_ISA("avx2")
+	[[nodiscard]] __m256i Load12ByteGroupPairAVX2(const u8* const src) noexcept
+	{
+		return _mm256_permutevar8x32_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src)),
+		                                   _mm256_setr_epi32(0, 1, 2, 3, 3, 4, 5, 6));
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Store the lowest 12 bytes of both 128 bit lanes as 24 contiguous bytes.
+	/// @param dst Output for the groups.
+	/// @param groups Groups to store, the upper 4 bytes of every lane must be zero.
+	TRAP_TARGET_ISA("avx2")
+	void Store12ByteGroupPairAVX2(u8* const dst, const __m256i groups) noexcept
+	{
+		const __m256i packed = _mm256_permutevar8x32_epi32(groups, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm256_castsi256_si128(packed));
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(dst + 16u), _mm256_extracti128_si256(packed, 1));
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+	//RGB to RGBA--------------------------------------------------------------------------------------------------------//
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	template<typename T>
+	void RGBToRGBAScalar(const T* const src, T* const dst, const usize pixelCount) noexcept
+	{
+		for(usize i = 0; i < pixelCount; ++i)
+		{
+			dst[i * 4u + 0u] = src[i * 3u + 0u];
+			dst[i * 4u + 1u] = src[i * 3u + 1u];
+			dst[i * 4u + 2u] = src[i * 3u + 2u];
+			dst[i * 4u + 3u] = OpaqueAlpha<T>;
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	template<typename T>
+	TRAP_TARGET_ISA("ssse3")
+	void RGBToRGBASSSE3(const T* const src, T* const dst, const usize pixelCount) noexcept
+	{
+		static constexpr usize PixelsPerIteration = 64u / (4u * sizeof(T));
+
+		const __m128i shuffle = Load128(RGBToRGBAShuffle<T>);
+		const __m128i alpha = Load128(AlphaBytes<T>);
+
+		usize i = 0;
+		for(; i + PixelsPerIteration <= pixelCount; i += PixelsPerIteration)
+		{
+			const ByteGroups rgb = Load12ByteGroupsSSSE3(reinterpret_cast<const u8*>(src + i * 3u));
+			__m128i* const out = reinterpret_cast<__m128i*>(dst + i * 4u);
+
+			_mm_storeu_si128(out + 0, _mm_or_si128(_mm_shuffle_epi8(rgb.G0, shuffle), alpha));
+			_mm_storeu_si128(out + 1, _mm_or_si128(_mm_shuffle_epi8(rgb.G1, shuffle), alpha));
+			_mm_storeu_si128(out + 2, _mm_or_si128(_mm_shuffle_epi8(rgb.G2, shuffle), alpha));
+			_mm_storeu_si128(out + 3, _mm_or_si128(_mm_shuffle_epi8(rgb.G3, shuffle), alpha));
+		}
+
+		RGBToRGBAScalar(src + i * 3u, dst + i * 4u, pixelCount - i);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	template<typename T>
+	TRAP_TARGET_ISA("avx2")
+	void RGBToRGBAAVX2(const T* const src, T* const dst, const usize pixelCount) noexcept
+	{
+		static constexpr usize PixelsPerIteration = 128u / (4u * sizeof(T));
+
+		const __m256i shuffle = Broadcast256(RGBToRGBAShuffle<T>);
+		const __m256i alpha = Broadcast256(AlphaBytes<T>);
+
+		//The last load reads 8 bytes past the 96 bytes used per iteration
+		const usize srcBytes = pixelCount * 3u * sizeof(T);
+		usize i = 0;
+		for(; (i + PixelsPerIteration) * 3u * sizeof(T) + 8u <= srcBytes; i += PixelsPerIteration)
+		{
+			const u8* const in = reinterpret_cast<const u8*>(src + i * 3u);
+			__m256i* const out = reinterpret_cast<__m256i*>(dst + i * 4u);
+
+			for(usize pair = 0; pair < 4u; ++pair)
+			{
+				const __m256i rgb = Load12ByteGroupPairAVX2(in + pair * 24u);
+				_mm256_storeu_si256(out + pair, _mm256_or_si256(_mm256_shuffle_epi8(rgb, shuffle), alpha));
+			}
+		}
+
+		RGBToRGBASSSE3(src + i * 3u, dst + i * 4u, pixelCount - i);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	template<typename T>
+	void RGBToRGBA(const T* const src, T* const dst, const usize pixelCount, const PixelConversionImplementation impl) noexcept
+	{
+		switch(impl)
+		{
+		case PixelConversionImplementation::AVX2:
+			RGBToRGBAAVX2(src, dst, pixelCount);
+			break;
+
+		case PixelConversionImplementation::SSSE3:
+			RGBToRGBASSSE3(src, dst, pixelCount);
+			break;
+
+		case PixelConversionImplementation::Scalar:
+			[[fallthrough]];
+		default:
+			RGBToRGBAScalar(src, dst, pixelCount);
+			break;
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+	//RGBA to RGB--------------------------------------------------------------------------------------------------------//
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	template<typename T>
+	void RGBAToRGBScalar(const T* const src, T* const dst, const usize pixelCount) noexcept
+	{
+		//Forward order keeps dst == src working
+		for(usize i = 0; i < pixelCount; ++i)
+		{
+			dst[i * 3u + 0u] = src[i * 4u + 0u];
+			dst[i * 3u + 1u] = src[i * 4u + 1u];
+			dst[i * 3u + 2u] = src[i * 4u + 2u];
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	template<typename T>
+	TRAP_TARGET_ISA("ssse3")
+	void RGBAToRGBSSSE3(const T* const src, T* const dst, const usize pixelCount) noexcept
+	{
+		static constexpr usize PixelsPerIteration = 64u / (4u * sizeof(T));
+
+		const __m128i shuffle = Load128(RGBAToRGBShuffle<T>);
+
+		usize i = 0;
+		for(; i + PixelsPerIteration <= pixelCount; i += PixelsPerIteration)
+		{
+			//Everything is loaded before storing so dst == src works
+			const __m128i* const in = reinterpret_cast<const __m128i*>(src + i * 4u);
+			const ByteGroups rgb
+			{
+				_mm_shuffle_epi8(_mm_loadu_si128(in + 0), shuffle),
+				_mm_shuffle_epi8(_mm_loadu_si128(in + 1), shuffle),
+				_mm_shuffle_epi8(_mm_loadu_si128(in + 2), shuffle),
+				_mm_shuffle_epi8(_mm_loadu_si128(in + 3), shuffle)
+			};
+
+			Store12ByteGroupsSSSE3(reinterpret_cast<u8*>(dst + i * 3u), rgb);
+		}
+
+		RGBAToRGBScalar(src + i * 4u, dst + i * 3u, pixelCount - i);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	template<typename T>
+	TRAP_TARGET_ISA("avx2")
+	void RGBAToRGBAVX2(const T* const src, T* const dst, const usize pixelCount) noexcept
+	{
+		static constexpr usize PixelsPerIteration = 128u / (4u * sizeof(T));
+
+		const __m256i shuffle = Broadcast256(RGBAToRGBShuffle<T>);
+
+		usize i = 0;
+		for(; i + PixelsPerIteration <= pixelCount; i += PixelsPerIteration)
+		{
+			//Everything is loaded before storing so dst == src works
+			const __m256i* const in = reinterpret_cast<const __m256i*>(src + i * 4u);
+			const __m256i rgb0 = _mm256_shuffle_epi8(_mm256_loadu_si256(in + 0), shuffle);
+			const __m256i rgb1 = _mm256_shuffle_epi8(_mm256_loadu_si256(in + 1), shuffle);
+			const __m256i rgb2 = _mm256_shuffle_epi8(_mm256_loadu_si256(in + 2), shuffle);
+			const __m256i rgb3 = _mm256_shuffle_epi8(_mm256_loadu_si256(in + 3), shuffle);
+
+			u8* const out = reinterpret_cast<u8*>(dst + i * 3u);
+			Store12ByteGroupPairAVX2(out, rgb0);
+			Store12ByteGroupPairAVX2(out + 24u, rgb1);
+			Store12ByteGroupPairAVX2(out + 48u, rgb2);
+			Store12ByteGroupPairAVX2(out + 72u, rgb3);
+		}
+
+		RGBAToRGBSSSE3(src + i * 4u, dst + i * 3u, pixelCount - i);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	template<typename T>
+	void RGBAToRGB(const T* const src, T* const dst, const usize pixelCount, const PixelConversionImplementation impl) noexcept
+	{
+		switch(impl)
+		{
+		case PixelConversionImplementation::AVX2:
+			RGBAToRGBAVX2(src, dst, pixelCount);
+			break;
+
+		case PixelConversionImplementation::SSSE3:
+			RGBAToRGBSSSE3(src, dst, pixelCount);
+			break;
+
+		case PixelConversionImplementation::Scalar:
+			[[fallthrough]];
+		default:
+			RGBAToRGBScalar(src, dst, pixelCount);
+			break;
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+	//BGR to RGB---------------------------------------------------------------------------------------------------------//
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	void BGRToRGBScalar(u8* const data, const usize pixelCount, const u32 channels) noexcept
+	{
+		for(usize i = 0; i < pixelCount; ++i)
+			std::swap(data[i * channels], data[i * channels + 2u]);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	TRAP_TARGET_ISA("ssse3")
+	void BGRToRGBSSSE3(u8* const data, const usize pixelCount, const u32 channels) noexcept
+	{
+		usize i = 0;
+
+		if(channels == 4u)
+		{
+			const __m128i shuffle = Load128(SwapRedBlue4Shuffle);
+			for(; i + 4u <= pixelCount; i += 4u)
+			{
+				__m128i* const pixels = reinterpret_cast<__m128i*>(data + i * 4u);
+				_mm_storeu_si128(pixels, _mm_shuffle_epi8(_mm_loadu_si128(pixels), shuffle));
+			}
+		}
+		else
+		{
+			const __m128i shuffle = Load128(SwapRedBlue3Shuffle);
+			for(; i + 16u <= pixelCount; i += 16u)
+			{
+				const ByteGroups bgr = Load12ByteGroupsSSSE3(data + i * 3u);
+				const ByteGroups rgb
+				{
+					_mm_shuffle_epi8(bgr.G0, shuffle),
+					_mm_shuffle_epi8(bgr.G1, shuffle),
+					_mm_shuffle_epi8(bgr.G2, shuffle),
+					_mm_shuffle_epi8(bgr.G3, shuffle)
+				};
+
+				Store12ByteGroupsSSSE3(data + i * 3u, rgb);
+			}
+		}
+
+		BGRToRGBScalar(data + i * channels, pixelCount - i, channels);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	TRAP_TARGET_ISA("avx2")
+	void BGRToRGBAVX2(u8* const data, const usize pixelCount, const u32 channels) noexcept
+	{
+		usize i = 0;
+
+		if(channels == 4u)
+		{
+			const __m256i shuffle = Broadcast256(SwapRedBlue4Shuffle);
+			for(; i + 8u <= pixelCount; i += 8u)
+			{
+				__m256i* const pixels = reinterpret_cast<__m256i*>(data + i * 4u);
+				_mm256_storeu_si256(pixels, _mm256_shuffle_epi8(_mm256_loadu_si256(pixels), shuffle));
+			}
+		}
+		else
+		{
+			const __m256i shuffle = Broadcast256(SwapRedBlue3Shuffle);
+
+			//The last load reads 8 bytes past the 96 bytes used per iteration
+			for(; (i + 32u) * 3u + 8u <= pixelCount * 3u; i += 32u)
+			{
+				u8* const pixels = data + i * 3u;
+				const __m256i rgb0 = _mm256_shuffle_epi8(Load12ByteGroupPairAVX2(pixels), shuffle);
+				const __m256i rgb1 = _mm256_shuffle_epi8(Load12ByteGroupPairAVX2(pixels + 24u), shuffle);
+				const __m256i rgb2 = _mm256_shuffle_epi8(Load12ByteGroupPairAVX2(pixels + 48u), shuffle);
+				const __m256i rgb3 = _mm256_shuffle_epi8(Load12ByteGroupPairAVX2(pixels + 72u), shuffle);
+
+				Store12ByteGroupPairAVX2(pixels, rgb0);
+				Store12ByteGroupPairAVX2(pixels + 24u, rgb1);
+				Store12ByteGroupPairAVX2(pixels + 48u, rgb2);
+				Store12ByteGroupPairAVX2(pixels + 72u, rgb3);
+			}
+		}
+
+		BGRToRGBSSSE3(data + i * channels, pixelCount - i, channels);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+	//BGR16 to RGB24-----------------------------------------------------------------------------------------------------//
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Expand a little endian X1R5G5B5 pixel to RGBA32 with alpha set to 0.
+	/// @param lo Low byte of the pixel.
+	/// @param hi High byte of the pixel.
+	/// @return RGBA32 pixel, red in the lowest byte.
+	[[nodiscard]] constexpr u32 BGR16ToRGBA32(const u8 lo, const u8 hi) noexcept
+	{
+		const u32 value = lo | (static_cast<u32>(hi) << 8u);
+
+		const u32 r = (value >> 7u) & 0xF8u;
+		const u32 g = (value >> 2u) & 0xF8u;
+		const u32 b = (value << 3u) & 0xF8u;
+
+		return r | (g << 8u) | (b << 16u);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	void BGR16ToRGB24Scalar(const u8* const src, u8* const dst, const usize pixelCount) noexcept
+	{
+		for(usize i = 0; i < pixelCount; ++i)
+		{
+			const u32 rgba = BGR16ToRGBA32(src[i * 2u], src[i * 2u + 1u]);
+			dst[i * 3u + 0u] = static_cast<u8>(rgba);
+			dst[i * 3u + 1u] = static_cast<u8>(rgba >> 8u);
+			dst[i * 3u + 2u] = static_cast<u8>(rgba >> 16u);
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	TRAP_TARGET_ISA("ssse3")
+	void BGR16ToRGB24SSSE3(const u8* const src, u8* const dst, const usize pixelCount) noexcept
+	{
+		const __m128i channelMask = _mm_set1_epi16(0xF8);
+		const __m128i shuffle = Load128(RGBAToRGBShuffle<u8>);
+
+		usize i = 0;
+		for(; i + 8u <= pixelCount; i += 8u)
+		{
+			const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2u));
+
+			const __m128i r = _mm_and_si128(_mm_srli_epi16(pixels, 7), channelMask);
+			const __m128i g = _mm_and_si128(_mm_srli_epi16(pixels, 2), channelMask);
+			const __m128i b = _mm_and_si128(_mm_slli_epi16(pixels, 3), channelMask);
+
+			const __m128i rg = _mm_or_si128(r, _mm_slli_epi16(g, 8));
+			const __m128i lo = _mm_shuffle_epi8(_mm_unpacklo_epi16(rg, b), shuffle);
+			const __m128i hi = _mm_shuffle_epi8(_mm_unpackhi_epi16(rg, b), shuffle);
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 3u), _mm_or_si128(lo, _mm_slli_si128(hi, 12)));
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i * 3u + 16u), _mm_srli_si128(hi, 4));
+		}
+
+		BGR16ToRGB24Scalar(src + i * 2u, dst + i * 3u, pixelCount - i);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+	//Color map----------------------------------------------------------------------------------------------------------//
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Decode a BGR(A) color map into RGBA32 entries.
+	/// @param colorMap Color map.
+	/// @param channels Amount of bytes per color map entry (1 - 4).
+	/// @return Decoded entries, red (or gray) in the lowest byte. Missing entries are black.
+	[[nodiscard]] std::array<u32, 256> DecodeColorMap(const std::span<const u8> colorMap, const u32 channels) noexcept
+	{
+		std::array<u32, 256> palette{};
+
+		const usize entryCount = std::min<usize>(colorMap.size() / channels, palette.size());
+		for(usize i = 0; i < entryCount; ++i)
+		{
+			const u8* const entry = colorMap.data() + i * channels;
+
+			switch(channels)
+			{
+			case 1:
+				palette[i] = entry[0];
+				break;
+
+			case 2:
+				palette[i] = BGR16ToRGBA32(entry[0], entry[1]);
+				break;
+
+			case 3:
+				palette[i] = entry[2] | (static_cast<u32>(entry[1]) << 8u) | (static_cast<u32>(entry[0]) << 16u);
+				break;
+
+			default:
+				palette[i] = entry[2] | (static_cast<u32>(entry[1]) << 8u) | (static_cast<u32>(entry[0]) << 16u) |
+				             (static_cast<u32>(entry[3]) << 24u);
+				break;
+			}
+		}
+
+		return palette;
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	void DecodeBGRAMapScalar(const u8* const indices, const std::array<u32, 256>& palette, const u32 outChannels,
+	                         u8* const dst, const usize pixelCount) noexcept
+	{
+		switch(outChannels)
+		{
+		case 1:
+			for(usize i = 0; i < pixelCount; ++i)
+				dst[i] = static_cast<u8>(palette[indices[i]]);
+			break;
+
+		case 3:
+			for(usize i = 0; i < pixelCount; ++i)
+			{
+				const u32 rgba = palette[indices[i]];
+				dst[i * 3u + 0u] = static_cast<u8>(rgba);
+				dst[i * 3u + 1u] = static_cast<u8>(rgba >> 8u);
+				dst[i * 3u + 2u] = static_cast<u8>(rgba >> 16u);
+			}
+			break;
+
+		default:
+			for(usize i = 0; i < pixelCount; ++i)
+				std::memcpy(dst + i * 4u, &palette[indices[i]], sizeof(u32));
+			break;
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	TRAP_TARGET_ISA("avx2")
+	void DecodeBGRAMapAVX2(const u8* const indices, const std::array<u32, 256>& palette, const u32 outChannels,
+	                       u8* const dst, const usize pixelCount) noexcept
+	{
+		const i32* const entries = reinterpret_cast<const i32*>(palette.data());
+
+		usize i = 0;
+		if(outChannels == 4u)
+		{
+			for(; i + 8u <= pixelCount; i += 8u)
+			{
+				const __m256i index = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(indices + i)));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4u), _mm256_i32gather_epi32(entries, index, 4));
+			}
+		}
+		else if(outChannels == 3u)
+		{
+			const __m256i shuffle = Broadcast256(RGBAToRGBShuffle<u8>);
+			for(; i + 8u <= pixelCount; i += 8u)
+			{
+				const __m256i index = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(indices + i)));
+				const __m256i rgba = _mm256_i32gather_epi32(entries, index, 4);
+				Store12ByteGroupPairAVX2(dst + i * 3u, _mm256_shuffle_epi8(rgba, shuffle));
+			}
+		}
+
+		DecodeBGRAMapScalar(indices + i, palette, outChannels, dst + i * outChannels, pixelCount - i);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Convert a 32-bit float to an IEEE 754 half precision float.
+	///        Rounds to nearest even and quiets NaNs, matching the F16C instructions.
+	/// @param value 32-bit float.
+	/// @return Half precision float.
+	[[nodiscard]] constexpr u16 F32ToF16(const f32 value) noexcept
+	{
+		const u32 bits = std::bit_cast<u32>(value);
+		const u32 sign = (bits >> 16u) & 0x8000u;
+		const u32 absBits = bits & 0x7FFFFFFFu;
+
+		if(absBits >= 0x7F800000u) //Infinity or NaN
+			return static_cast<u16>(sign | (absBits > 0x7F800000u ? 0x7E00u | ((absBits >> 13u) & 0x3FFu) : 0x7C00u));
+		if(absBits >= 0x477FF000u) //65520 and above round to infinity
+			return static_cast<u16>(sign | 0x7C00u);
+
+		if(absBits < 0x38800000u) //Below 2^-14 the result is subnormal
+		{
+			if(absBits < 0x33000000u) //Below 2^-25 the result is zero
+				return static_cast<u16>(sign);
+
+			//Subnormal halfs count in steps of 2^-24
+			const u32 mantissa = (absBits & 0x7FFFFFu) | 0x800000u;
+			const u32 shift = 126u - (absBits >> 23u);
+			u32 result = mantissa >> shift;
+			const u32 remainder = mantissa & ((1u << shift) - 1u);
+			const u32 halfway = 1u << (shift - 1u);
+			if(remainder > halfway || (remainder == halfway && (result & 1u) != 0u))
+				++result;
+
+			return static_cast<u16>(sign | result);
+		}
+
+		//Rebias the exponent, a rounding carry out of the mantissa correctly increments the exponent
+		u32 result = (absBits - 0x38000000u) >> 13u;
+		const u32 remainder = absBits & 0x1FFFu;
+		if(remainder > 0x1000u || (remainder == 0x1000u && (result & 1u) != 0u))
+			++result;
+
+		return static_cast<u16>(sign | result);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	void F32ToF16Scalar(const f32* const src, u16* const dst, const usize count) noexcept
+	{
+		for(usize i = 0; i < count; ++i)
+			dst[i] = F32ToF16(src[i]);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	TRAP_TARGET_ISA("f16c")
+	void F32ToF16AVX2(const f32* const src, u16* const dst, const usize count) noexcept
+	{
+		usize i = 0;
+		for(; i + 16u <= count; i += 16u)
+		{
+			const __m128i lo = _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT);
+			const __m128i hi = _mm256_cvtps_ph(_mm256_loadu_ps(src + i + 8u), _MM_FROUND_TO_NEAREST_INT);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_set_m128i(hi, lo));
+		}
+		for(; i + 8u <= count; i += 8u)
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT));
+
+		F32ToF16Scalar(src + i, dst + i, count - i);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Retrieve the fastest pixel conversion implementation supported by the CPU.
+	/// @return Fastest supported pixel conversion implementation.
+	[[nodiscard]] PixelConversionImplementation GetBestImplementation()
+	{
+		using TRAP::INTERNAL::IsPixelConversionImplementationSupported;
+
+		static const PixelConversionImplementation impl = []()
+		{
+			if(IsPixelConversionImplementationSupported(PixelConversionImplementation::AVX2))
+				return PixelConversionImplementation::AVX2;
+			if(IsPixelConversionImplementationSupported(PixelConversionImplementation::SSSE3))
+				return PixelConversionImplementation::SSSE3;
+
+			return PixelConversionImplementation::Scalar;
+		}();
+
+		return impl;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] bool TRAP::INTERNAL::IsPixelConversionImplementationSupported(const PixelConversionImplementation impl)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None &&
+	                                         (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	switch(impl)
+	{
+	case PixelConversionImplementation::Scalar:
+		return true;
+
+	case PixelConversionImplementation::SSSE3:
+		return Utils::GetCPUInfo().SSSE3;
+
+	case PixelConversionImplementation::AVX2:
+		return Utils::GetCPUInfo().AVX2 && Utils::GetCPUInfo().F16C;
+
+	default:
+		return false;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename T>
+requires std::same_as<T, u8> || std::same_as<T, u16> || std::same_as<T, f32>
+void TRAP::INTERNAL::ConvertRGBToRGBA(const std::span<const T> src, const std::span<T> dst)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None &&
+	                                         (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	ConvertRGBToRGBA(src, dst, GetBestImplementation());
+}
+
+template void TRAP::INTERNAL::ConvertRGBToRGBA<u8>(std::span<const u8> src, std::span<u8> dst);
+template void TRAP::INTERNAL::ConvertRGBToRGBA<u16>(std::span<const u16> src, std::span<u16> dst);
+template void TRAP::INTERNAL::ConvertRGBToRGBA<f32>(std::span<const f32> src, std::span<f32> dst);
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename T>
+requires std::same_as<T, u8> || std::same_as<T, u16> || std::same_as<T, f32>
+void TRAP::INTERNAL::ConvertRGBToRGBA(const std::span<const T> src, const std::span<T> dst,
+                                      const PixelConversionImplementation impl)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	TRAP_ASSERT(IsPixelConversionImplementationSupported(impl), "ConvertRGBToRGBA(): Implementation is not supported by the CPU!");
+
+	const usize pixelCount = src.size() / 3u;
+	if(dst.size() < pixelCount * 4u)
+	{
+		TRAP_ASSERT(false, "ConvertRGBToRGBA(): Destination is too small!");
+		return;
+	}
+
+	RGBToRGBA(src.data(), dst.data(), pixelCount, impl);
+}
+
+template void TRAP::INTERNAL::ConvertRGBToRGBA<u8>(std::span<const u8> src, std::span<u8> dst, PixelConversionImplementation impl);
+template void TRAP::INTERNAL::ConvertRGBToRGBA<u16>(std::span<const u16> src, std::span<u16> dst, PixelConversionImplementation impl);
+template void TRAP::INTERNAL::ConvertRGBToRGBA<f32>(std::span<const f32> src, std::span<f32> dst, PixelConversionImplementation impl);
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename T>
+requires std::same_as<T, u8> || std::same_as<T, u16> || std::same_as<T, f32>
+void TRAP::INTERNAL::ConvertRGBToRGBAInPlace(const std::span<T> data)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	const PixelConversionImplementation impl = GetBestImplementation();
+
+	//Pixels [0, remaining) are still RGB.
+	//The RGBA output of the last quarter of them doesn't overlap any RGB data,
+	//so it can be converted with the regular kernels.
+	usize remaining = data.size() / 4u;
+	while(remaining >= 64u)
+	{
+		const usize first = remaining - remaining / 4u;
+		RGBToRGBA(data.data() + first * 3u, data.data() + first * 4u, remaining - first, impl);
+		remaining = first;
+	}
+
+	for(usize i = remaining; i-- > 0;)
+	{
+		const T r = data[i * 3u + 0u];
+		const T g = data[i * 3u + 1u];
+		const T b = data[i * 3u + 2u];
+		data[i * 4u + 0u] = r;
+		data[i * 4u + 1u] = g;
+		data[i * 4u + 2u] = b;
+		data[i * 4u + 3u] = OpaqueAlpha<T>;
+	}
+}
+
+template void TRAP::INTERNAL::ConvertRGBToRGBAInPlace<u8>(std::span<u8> data);
+template void TRAP::INTERNAL::ConvertRGBToRGBAInPlace<u16>(std::span<u16> data);
+template void TRAP::INTERNAL::ConvertRGBToRGBAInPlace<f32>(std::span<f32> data);
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::INTERNAL::ConvertRGBToRGBA(const std::span<const u8> src, const std::span<u8> dst, const u32 bytesPerChannel)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None &&
+	                                         (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	switch(bytesPerChannel)
+	{
+	case 1:
+		ConvertRGBToRGBA(src, dst);
+		break;
+
+	case 2:
+		ConvertRGBToRGBA(std::span(reinterpret_cast<const u16*>(src.data()), src.size() / sizeof(u16)),
+		                 std::span(reinterpret_cast<u16*>(dst.data()), dst.size() / sizeof(u16)));
+		break;
+
+	case 4:
+		ConvertRGBToRGBA(std::span(reinterpret_cast<const f32*>(src.data()), src.size() / sizeof(f32)),
+		                 std::span(reinterpret_cast<f32*>(dst.data()), dst.size() / sizeof(f32)));
+		break;
+
+	default:
+		TRAP_ASSERT(false, "ConvertRGBToRGBA(): Invalid bytes per channel!");
+		break;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename T>
+requires std::same_as<T, u8> || std::same_as<T, u16> || std::same_as<T, f32>
+void TRAP::INTERNAL::ConvertRGBAToRGB(const std::span<const T> src, const std::span<T> dst)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None &&
+	                                         (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	ConvertRGBAToRGB(src, dst, GetBestImplementation());
+}
+
+template void TRAP::INTERNAL::ConvertRGBAToRGB<u8>(std::span<const u8> src, std::span<u8> dst);
+template void TRAP::INTERNAL::ConvertRGBAToRGB<u16>(std::span<const u16> src, std::span<u16> dst);
+template void TRAP::INTERNAL::ConvertRGBAToRGB<f32>(std::span<const f32> src, std::span<f32> dst);
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename T>
+requires std::same_as<T, u8> || std::same_as<T, u16> || std::same_as<T, f32>
+void TRAP::INTERNAL::ConvertRGBAToRGB(const std::span<const T> src, const std::span<T> dst,
+                                      const PixelConversionImplementation impl)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	TRAP_ASSERT(IsPixelConversionImplementationSupported(impl), "ConvertRGBAToRGB(): Implementation is not supported by the CPU!");
+
+	const usize pixelCount = src.size() / 4u;
+	if(dst.size() < pixelCount * 3u)
+	{
+		TRAP_ASSERT(false, "ConvertRGBAToRGB(): Destination is too small!");
+		return;
+	}
+
+	RGBAToRGB(src.data(), dst.data(), pixelCount, impl);
+}
+
+template void TRAP::INTERNAL::ConvertRGBAToRGB<u8>(std::span<const u8> src, std::span<u8> dst, PixelConversionImplementation impl);
+template void TRAP::INTERNAL::ConvertRGBAToRGB<u16>(std::span<const u16> src, std::span<u16> dst, PixelConversionImplementation impl);
+template void TRAP::INTERNAL::ConvertRGBAToRGB<f32>(std::span<const f32> src, std::span<f32> dst, PixelConversionImplementation impl);
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::INTERNAL::ConvertBGRToRGB(const std::span<u8> data, const u32 channels)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None &&
+	                                         (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	ConvertBGRToRGB(data, channels, GetBestImplementation());
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::INTERNAL::ConvertBGRToRGB(const std::span<u8> data, const u32 channels, const PixelConversionImplementation impl)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	TRAP_ASSERT(IsPixelConversionImplementationSupported(impl), "ConvertBGRToRGB(): Implementation is not supported by the CPU!");
+
+	if(channels != 3u && channels != 4u)
+	{
+		TRAP_ASSERT(false, "ConvertBGRToRGB(): Invalid channel count!");
+		return;
+	}
+
+	const usize pixelCount = data.size() / channels;
+
+	switch(impl)
+	{
+	case PixelConversionImplementation::AVX2:
+		BGRToRGBAVX2(data.data(), pixelCount, channels);
+		break;
+
+	case PixelConversionImplementation::SSSE3:
+		BGRToRGBSSSE3(data.data(), pixelCount, channels);
+		break;
+
+	case PixelConversionImplementation::Scalar:
+		[[fallthrough]];
+	default:
+		BGRToRGBScalar(data.data(), pixelCount, channels);
+		break;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::INTERNAL::ConvertBGR16ToRGB24(const std::span<const u8> src, const std::span<u8> dst)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None &&
+	                                         (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	ConvertBGR16ToRGB24(src, dst, GetBestImplementation());
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::INTERNAL::ConvertBGR16ToRGB24(const std::span<const u8> src, const std::span<u8> dst,
+                                         const PixelConversionImplementation impl)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	TRAP_ASSERT(IsPixelConversionImplementationSupported(impl), "ConvertBGR16ToRGB24(): Implementation is not supported by the CPU!");
+
+	const usize pixelCount = src.size() / 2u;
+	if(dst.size() < pixelCount * 3u)
+	{
+		TRAP_ASSERT(false, "ConvertBGR16ToRGB24(): Destination is too small!");
+		return;
+	}
+
+	//AVX2 has no advantage here as the unpacks only work per 128 bit lane
+	if(impl == PixelConversionImplementation::Scalar)
+		BGR16ToRGB24Scalar(src.data(), dst.data(), pixelCount);
+	else
+		BGR16ToRGB24SSSE3(src.data(), dst.data(), pixelCount);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::INTERNAL::ConvertF32ToF16(const std::span<const f32> src, const std::span<u16> dst)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None &&
+	                                         (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	ConvertF32ToF16(src, dst, GetBestImplementation());
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::INTERNAL::ConvertF32ToF16(const std::span<const f32> src, const std::span<u16> dst,
+                                     const PixelConversionImplementation impl)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	TRAP_ASSERT(IsPixelConversionImplementationSupported(impl), "ConvertF32ToF16(): Implementation is not supported by the CPU!");
+
+	if(dst.size() < src.size())
+	{
+		TRAP_ASSERT(false, "ConvertF32ToF16(): Destination is too small!");
+		return;
+	}
+
+	//There are no SSSE3 half float conversions
+	if(impl == PixelConversionImplementation::AVX2)
+		F32ToF16AVX2(src.data(), dst.data(), src.size());
+	else
+		F32ToF16Scalar(src.data(), dst.data(), src.size());
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::INTERNAL::DecodeBGRAMap(const std::span<const u8> indices, const std::span<const u8> colorMap,
+                                   const u32 colorMapChannels, const std::span<u8> dst)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None &&
+	                                         (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	DecodeBGRAMap(indices, colorMap, colorMapChannels, dst, GetBestImplementation());
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::INTERNAL::DecodeBGRAMap(const std::span<const u8> indices, const std::span<const u8> colorMap,
+                                   const u32 colorMapChannels, const std::span<u8> dst,
+								   const PixelConversionImplementation impl)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	TRAP_ASSERT(IsPixelConversionImplementationSupported(impl), "DecodeBGRAMap(): Implementation is not supported by the CPU!");
+
+	if(colorMapChannels < 1u || colorMapChannels > 4u)
+	{
+		TRAP_ASSERT(false, "DecodeBGRAMap(): Invalid color map channel count!");
+		return;
+	}
+
+	const u32 outChannels = GetDecodedBGRAMapChannels(colorMapChannels);
+	if(dst.size() < indices.size() * outChannels)
+	{
+		TRAP_ASSERT(false, "DecodeBGRAMap(): Destination is too small!");
+		return;
+	}
+
+	//Decoding the color map once turns every pixel into a plain table lookup
+	const std::array<u32, 256> palette = DecodeColorMap(colorMap, colorMapChannels);
+
+	//SSSE3 has no gather, a table lookup per pixel is as fast as it gets there
+	if(impl == PixelConversionImplementation::AVX2)
+		DecodeBGRAMapAVX2(indices.data(), palette, outChannels, dst.data(), indices.size());
+	else
+		DecodeBGRAMapScalar(indices.data(), palette, outChannels, dst.data(), indices.size());
+}
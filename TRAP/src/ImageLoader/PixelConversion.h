@@ -0,0 +1,143 @@
+#ifndef TRAP_PIXELCONVERSION_H
+#define TRAP_PIXELCONVERSION_H
+
+#include <concepts>
+#include <span>
+
+#include "Core/Types.h"
+
+namespace TRAP::INTERNAL
+{
+	/// @brief Available pixel conversion implementations.
+	///        The conversion functions automatically use the fastest one supported by the CPU.
+	enum class PixelConversionImplementation : u8
+	{
+		Scalar,
+		SSSE3,
+		AVX2 //Also uses F16C, which every AVX2 capable CPU supports
+	};
+
+	/// @brief IEEE 754 half precision float with the value 1.0, used as opaque alpha for half float pixel data.
+	constexpr u16 HalfFloatOne = 0x3C00u;
+
+	/// @brief Check whether the given pixel conversion implementation is supported by the CPU.
+	/// @param impl Pixel conversion implementation.
+	/// @return True if supported, false otherwise.
+	[[nodiscard]] bool IsPixelConversionImplementationSupported(PixelConversionImplementation impl);
+
+	/// @brief Convert RGB pixel data to RGBA, alpha is set to fully opaque.
+	/// @tparam T u8, u16 or f32.
+	/// @param src RGB pixel data, the pixel count is src.size() / 3.
+	/// @param dst Output for the RGBA pixel data, must hold at least 4 values per pixel.
+	/// @note src and dst must not overlap, use ConvertRGBToRGBAInPlace() instead.
+	template<typename T>
+	requires std::same_as<T, u8> || std::same_as<T, u16> || std::same_as<T, f32>
+	void ConvertRGBToRGBA(std::span<const T> src, std::span<T> dst);
+	/// @brief Convert RGB pixel data to RGBA using a specific implementation.
+	/// @tparam T u8, u16 or f32.
+	/// @param src RGB pixel data, the pixel count is src.size() / 3.
+	/// @param dst Output for the RGBA pixel data, must hold at least 4 values per pixel.
+	/// @param impl Pixel conversion implementation to use, must be supported by the CPU.
+	/// @note Only intended for testing and benchmarking.
+	template<typename T>
+	requires std::same_as<T, u8> || std::same_as<T, u16> || std::same_as<T, f32>
+	void ConvertRGBToRGBA(std::span<const T> src, std::span<T> dst, PixelConversionImplementation impl);
+	/// @brief Convert RGB pixel data to RGBA in place, alpha is set to fully opaque.
+	/// @tparam T u8, u16 or f32.
+	/// @param data Buffer holding 4 values per pixel, the RGB pixel data is tightly packed at the start of it.
+	template<typename T>
+	requires std::same_as<T, u8> || std::same_as<T, u16> || std::same_as<T, f32>
+	void ConvertRGBToRGBAInPlace(std::span<T> data);
+	/// @brief Convert RGB pixel data to RGBA, alpha is set to fully opaque.
+	///        The channel type is selected by bytesPerChannel (1 = u8, 2 = u16, 4 = f32).
+	/// @param src RGB pixel data.
+	/// @param dst Output for the RGBA pixel data, must hold at least 4 channels per pixel.
+	/// @param bytesPerChannel Size of a single channel in bytes.
+	/// @note src and dst must not overlap and have to be aligned to the channel type.
+	void ConvertRGBToRGBA(std::span<const u8> src, std::span<u8> dst, u32 bytesPerChannel);
+
+	/// @brief Convert RGBA pixel data to RGB by dropping the alpha channel.
+	/// @tparam T u8, u16 or f32.
+	/// @param src RGBA pixel data, the pixel count is src.size() / 4.
+	/// @param dst Output for the RGB pixel data, must hold at least 3 values per pixel.
+	/// @note dst may be the same as src to convert in place, any other overlap is not allowed.
+	template<typename T>
+	requires std::same_as<T, u8> || std::same_as<T, u16> || std::same_as<T, f32>
+	void ConvertRGBAToRGB(std::span<const T> src, std::span<T> dst);
+	/// @brief Convert RGBA pixel data to RGB by dropping the alpha channel using a specific implementation.
+	/// @tparam T u8, u16 or f32.
+	/// @param src RGBA pixel data, the pixel count is src.size() / 4.
+	/// @param dst Output for the RGB pixel data, must hold at least 3 values per pixel.
+	/// @param impl Pixel conversion implementation to use, must be supported by the CPU.
+	/// @note Only intended for testing and benchmarking.
+	template<typename T>
+	requires std::same_as<T, u8> || std::same_as<T, u16> || std::same_as<T, f32>
+	void ConvertRGBAToRGB(std::span<const T> src, std::span<T> dst, PixelConversionImplementation impl);
+
+	/// @brief Swap the red and blue channel of 8 bit pixel data in place, i.e. BGR24 to RGB24 or BGRA32 to RGBA32.
+	/// @param data Pixel data.
+	/// @param channels Amount of channels, 3 or 4.
+	void ConvertBGRToRGB(std::span<u8> data, u32 channels);
+	/// @brief Swap the red and blue channel of 8 bit pixel data in place using a specific implementation.
+	/// @param data Pixel data.
+	/// @param channels Amount of channels, 3 or 4.
+	/// @param impl Pixel conversion implementation to use, must be supported by the CPU.
+	/// @note Only intended for testing and benchmarking.
+	void ConvertBGRToRGB(std::span<u8> data, u32 channels, PixelConversionImplementation impl);
+
+	/// @brief Convert little endian BGR16 (X1R5G5B5) pixel data to RGB24.
+	/// @param src BGR16 pixel data, the pixel count is src.size() / 2.
+	/// @param dst Output for the RGB24 pixel data, must hold at least 3 bytes per pixel.
+	void ConvertBGR16ToRGB24(std::span<const u8> src, std::span<u8> dst);
+	/// @brief Convert little endian BGR16 (X1R5G5B5) pixel data to RGB24 using a specific implementation.
+	/// @param src BGR16 pixel data, the pixel count is src.size() / 2.
+	/// @param dst Output for the RGB24 pixel data, must hold at least 3 bytes per pixel.
+	/// @param impl Pixel conversion implementation to use, must be supported by the CPU.
+	/// @note Only intended for testing and benchmarking.
+	void ConvertBGR16ToRGB24(std::span<const u8> src, std::span<u8> dst, PixelConversionImplementation impl);
+
+	/// @brief Convert 32-bit floats to IEEE 754 half precision floats.
+	///        Values are rounded to nearest even, values out of the half float range become infinity.
+	/// @param src 32-bit float values.
+	/// @param dst Output for the half precision floats, must hold at least src.size() values.
+	void ConvertF32ToF16(std::span<const f32> src, std::span<u16> dst);
+	/// @brief Convert 32-bit floats to IEEE 754 half precision floats using a specific implementation.
+	/// @param src 32-bit float values.
+	/// @param dst Output for the half precision floats, must hold at least src.size() values.
+	/// @param impl Pixel conversion implementation to use, must be supported by the CPU.
+	/// @note Only intended for testing and benchmarking.
+	void ConvertF32ToF16(std::span<const f32> src, std::span<u16> dst, PixelConversionImplementation impl);
+
+	/// @brief Decode 8 bit indexed pixel data with a BGR(A) color map.
+	/// Output channels depend on the color map channels:
+	///		- 1: Grayscale
+	///		- 2: BGR16, decoded to RGB
+	///		- 3: BGR, decoded to RGB
+	///		- 4: BGRA, decoded to RGBA
+	/// @param indices Indexed pixel data.
+	/// @param colorMap Color map.
+	/// @param colorMapChannels Amount of bytes per color map entry (1 - 4).
+	/// @param dst Output for the decoded pixel data, 1, 3, 3 or 4 bytes per pixel depending on colorMapChannels.
+	/// @note Indices outside of the color map are decoded as black.
+	void DecodeBGRAMap(std::span<const u8> indices, std::span<const u8> colorMap, u32 colorMapChannels,
+	                   std::span<u8> dst);
+	/// @brief Decode 8 bit indexed pixel data with a BGR(A) color map using a specific implementation.
+	/// @param indices Indexed pixel data.
+	/// @param colorMap Color map.
+	/// @param colorMapChannels Amount of bytes per color map entry (1 - 4).
+	/// @param dst Output for the decoded pixel data, 1, 3, 3 or 4 bytes per pixel depending on colorMapChannels.
+	/// @param impl Pixel conversion implementation to use, must be supported by the CPU.
+	/// @note Only intended for testing and benchmarking.
+	void DecodeBGRAMap(std::span<const u8> indices, std::span<const u8> colorMap, u32 colorMapChannels,
+	                   std::span<u8> dst, PixelConversionImplementation impl);
+
+	/// @brief Retrieve the amount of output channels produced by DecodeBGRAMap().
+	/// @param colorMapChannels Amount of bytes per color map entry (1 - 4).
+	/// @return Amount of output channels.
+	[[nodiscard]] constexpr u32 GetDecodedBGRAMapChannels(const u32 colorMapChannels) noexcept
+	{
+		return colorMapChannels == 2u ? 3u : colorMapChannels;
+	}
+}
+
+#endif /*TRAP_PIXELCONVERSION_H*/
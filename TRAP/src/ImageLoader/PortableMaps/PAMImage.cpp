@@ -2,6 +2,8 @@
 #include "PAMImage.h"
 
 #include "FileSystem/FileSystem.h"
+#include "FileSystem/MappedFile.h"
+#include "Utils/ByteReader.h"
 #include "Utils/Memory.h"
 #include "Utils/Utils.h"
 
@@ -15,43 +17,72 @@ TRAP::INTERNAL::PAMImage::PAMImage(std::filesystem::path filepath)
 	if (!FileSystem::Exists(m_filepath))
 		return;
 
-	std::ifstream file(m_filepath, std::ios::binary);
-	if (!file.is_open())
+	const auto file = FileSystem::MapFile(m_filepath);
+	if (!file)
 	{
 		TP_ERROR(Log::ImagePAMPrefix, "Couldn't open file path: ", m_filepath, "!");
 		TP_WARN(Log::ImagePAMPrefix, "Using default image!");
 		return;
 	}
 
-	std::string tempTrash;
+	Decode(file->GetData());
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+TRAP::INTERNAL::PAMImage::PAMImage(const std::span<const u8> data)
+	: Image("")
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	TP_DEBUG(Log::ImagePAMPrefix, "Loading image from memory");
+
+	Decode(data);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::INTERNAL::PAMImage::Decode(const std::span<const u8> data)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	Utils::ByteReader reader(data);
+
+	//Field names are skipped, fields are expected in the order WIDTH, HEIGHT, DEPTH, MAXVAL, TUPLTYPE, ENDHDR
 	Header header{};
-	file >> header.MagicNumber >> tempTrash >> header.Width >> tempTrash >> header.Height >> tempTrash >>
-	        header.Depth >> tempTrash >> header.MaxValue >> tempTrash >> header.TuplType >> tempTrash;
+	header.MagicNumber = reader.ReadToken();
+	static_cast<void>(reader.ReadToken());
+	reader.ReadNumber(header.Width);
+	static_cast<void>(reader.ReadToken());
+	reader.ReadNumber(header.Height);
+	static_cast<void>(reader.ReadToken());
+	reader.ReadNumber(header.Depth);
+	static_cast<void>(reader.ReadToken());
+	reader.ReadNumber(header.MaxValue);
+	static_cast<void>(reader.ReadToken());
+	header.TuplType = reader.ReadToken();
+	static_cast<void>(reader.ReadToken());
 
 	if (header.MagicNumber != "P7")
 	{
-		file.close();
 		TP_ERROR(Log::ImagePAMPrefix, "Invalid magic number ", header.MagicNumber, "!");
 		TP_WARN(Log::ImagePAMPrefix, "Using default image!");
 		return;
 	}
 	if (header.Width < 1)
 	{
-		file.close();
 		TP_ERROR(Log::ImagePAMPrefix, "Width is < 1 (", header.Width, ")!");
 		TP_WARN(Log::ImagePAMPrefix, "Using default image!");
 		return;
 	}
 	if (header.Height < 1)
 	{
-		file.close();
 		TP_ERROR(Log::ImagePAMPrefix, "Height is < 1 (", header.Height, ")!");
 		TP_WARN(Log::ImagePAMPrefix, "Using default image!");
 		return;
 	}
 	if (header.MaxValue < 1 || header.MaxValue > 65535)
 	{
-		file.close();
 		TP_ERROR(Log::ImagePAMPrefix, "MaxValue ", header.MaxValue, " is unsupported or invalid!");
 		TP_WARN(Log::ImagePAMPrefix, "Using default image!");
 		return;
@@ -60,7 +91,6 @@ TRAP::INTERNAL::PAMImage::PAMImage(std::filesystem::path filepath)
 	if (header.TuplType != "GRAYSCALE" && header.TuplType != "RGB" &&
 	    header.TuplType != "GRAYSCALE_ALPHA" && header.TuplType != "RGB_ALPHA")
 	{
-		file.close();
 		TP_ERROR(Log::ImagePAMPrefix, "TuplType ", header.TuplType, " is unsupported or invalid!");
 		TP_WARN(Log::ImagePAMPrefix, "Using default image!");
 		return;
@@ -69,7 +99,7 @@ TRAP::INTERNAL::PAMImage::PAMImage(std::filesystem::path filepath)
 	m_width = header.Width;
 	m_height = header.Height;
 
-	file.ignore(256, '\n'); //Skip ahead to the pixel data.
+	reader.SkipLine(); //Skip ahead to the pixel data.
 
 	if(header.MaxValue > 255)
 	{
@@ -99,19 +129,14 @@ TRAP::INTERNAL::PAMImage::PAMImage(std::filesystem::path filepath)
 		}
 
 		m_data2Byte.resize(NumericCast<usize>(m_width) * m_height * header.Depth);
-		if (!file.read(reinterpret_cast<char*>(m_data2Byte.data()),
-			           NumericCast<std::streamsize>(m_width) * m_height * header.Depth *
-					   NumericCast<std::streamsize>(sizeof(u16))))
+		if (!reader.Read(Utils::AsWritableBytes(std::span(m_data2Byte))))
 		{
-			file.close();
 			m_data2Byte.clear();
 			TP_ERROR(Log::ImagePAMPrefix, "Couldn't load pixel data!");
 			TP_WARN(Log::ImagePAMPrefix, "Using default image!");
 			return;
 		}
 
-		file.close();
-
 		//File uses big-endian
 		//Convert to machines endian
 		if constexpr (Utils::GetEndian() != Utils::Endian::Big)
@@ -148,15 +173,12 @@ TRAP::INTERNAL::PAMImage::PAMImage(std::filesystem::path filepath)
 		}
 
 		m_data.resize(NumericCast<usize>(m_width) * m_height * header.Depth);
-		if(!file.read(reinterpret_cast<char*>(m_data.data()), NumericCast<std::streamsize>(m_width) * m_height * header.Depth))
+		if(!reader.Read(Utils::AsWritableBytes(std::span(m_data))))
 		{
-			file.close();
 			m_data.clear();
 			TP_ERROR(Log::ImagePAMPrefix, "Couldn't load pixel data!");
 			TP_WARN(Log::ImagePAMPrefix, "Using default image!");
 			return;
 		}
-
-		file.close();
 	}
 }
@@ -2,49 +2,74 @@
 #include "PFMImage.h"
 
 #include "FileSystem/FileSystem.h"
+#include "FileSystem/MappedFile.h"
+#include "Utils/ByteReader.h"
 
-TRAP::INTERNAL::PFMImage::PFMImage(std::filesystem::path filepath)
+TRAP::INTERNAL::PFMImage::PFMImage(std::filesystem::path filepath, const HDRPrecision precision)
 	: Image(std::move(filepath))
 {
 	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
 
-	m_isHDR = true;
-
 	TP_DEBUG(Log::ImagePFMPrefix, "Loading image: ", m_filepath);
 
 	if (!FileSystem::Exists(m_filepath))
 		return;
 
-	std::ifstream file(m_filepath, std::ios::binary);
-	if (!file.is_open())
+	const auto file = FileSystem::MapFile(m_filepath);
+	if (!file)
 	{
 		TP_ERROR(Log::ImagePFMPrefix, "Couldn't open file path: ", m_filepath, "!");
 		TP_WARN(Log::ImagePFMPrefix, "Using default image!");
 		return;
 	}
 
+	Decode(file->GetData(), precision);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+TRAP::INTERNAL::PFMImage::PFMImage(const std::span<const u8> data, const HDRPrecision precision)
+	: Image("")
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	TP_DEBUG(Log::ImagePFMPrefix, "Loading image from memory");
+
+	Decode(data, precision);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::INTERNAL::PFMImage::Decode(const std::span<const u8> data, const HDRPrecision precision)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	m_isHDR = true;
+
+	Utils::ByteReader reader(data);
+
 	//Read in file header
 	Header header{};
-	file >> header.MagicNumber >> header.Width >> header.Height >> header.ByteOrder;
+	header.MagicNumber = reader.ReadToken();
+	reader.ReadNumber(header.Width);
+	reader.ReadNumber(header.Height);
+	reader.ReadNumber(header.ByteOrder);
 
 	//Do error/specification checking
 	if (header.MagicNumber != "PF" && header.MagicNumber != "Pf")
 	{
-		file.close();
 		TP_ERROR(Log::ImagePFMPrefix, "Invalid magic number", header.MagicNumber, "!");
 		TP_WARN(Log::ImagePFMPrefix, "Using default image!");
 		return;
 	}
 	if (header.Width < 1)
 	{
-		file.close();
 		TP_ERROR(Log::ImagePFMPrefix, "Width is < 1 (", header.Width, ")!");
 		TP_WARN(Log::ImagePFMPrefix, "Using default image!");
 		return;
 	}
 	if (header.Height < 1)
 	{
-		file.close();
 		TP_ERROR(Log::ImagePFMPrefix, "Height is < 1 (", header.Height, ")!");
 		TP_WARN(Log::ImagePFMPrefix, "Using default image!");
 		return;
@@ -53,7 +78,44 @@ TRAP::INTERNAL::PFMImage::PFMImage(std::filesystem::path filepath)
 	m_width = header.Width;
 	m_height = header.Height;
 
-	file.ignore(256, '\n'); //Skip ahead to the pixel data
+	reader.SkipLine(); //Skip ahead to the pixel data
+
+	const u32 channels = header.MagicNumber == "PF" ? 3u : 1u;
+
+	if(precision == HDRPrecision::Float16)
+	{
+		//RGB is expanded to RGBA as GPUs rarely support RGB16F textures
+		m_colorFormat = channels == 3u ? ColorFormat::RGBA : ColorFormat::GrayScale;
+		m_bitsPerPixel = 16u * std::to_underlying(m_colorFormat);
+
+		const usize rowSize = NumericCast<usize>(m_width) * std::to_underlying(m_colorFormat);
+		m_dataHalf.resize(rowSize * m_height);
+
+		//Rows are converted one at a time while the read floats are still in cache
+		std::vector<f32> row(NumericCast<usize>(m_width) * channels);
+		std::vector<f32> rgba(channels == 3u ? rowSize : 0u);
+		for(u32 y = 0; y < m_height; ++y)
+		{
+			if (!reader.Read(Utils::AsWritableBytes(std::span(row))))
+			{
+				m_dataHalf.clear();
+				TP_ERROR(Log::ImagePFMPrefix, "Couldn't load pixel data!");
+				TP_WARN(Log::ImagePFMPrefix, "Using default image!");
+				return;
+			}
+
+			const std::span<u16> halfRow = std::span(m_dataHalf).subspan(y * rowSize, rowSize);
+			if(channels == 3u)
+			{
+				INTERNAL::ConvertRGBToRGBA<f32>(row, rgba);
+				ConvertF32ToF16(rgba, halfRow);
+			}
+			else
+				ConvertF32ToF16(row, halfRow);
+		}
+
+		return;
+	}
 
 	if (header.MagicNumber == "PF")
 	{
@@ -61,18 +123,13 @@ TRAP::INTERNAL::PFMImage::PFMImage(std::filesystem::path filepath)
 		m_colorFormat = ColorFormat::RGB;
 		m_bitsPerPixel = 96;
 		m_data.resize(NumericCast<usize>(m_width) * m_height * 3);
-		if (!file.read(reinterpret_cast<char*>(m_data.data()),
-					   NumericCast<std::streamsize>(m_width) * m_height * 3 *
-                       NumericCast<std::streamsize>(sizeof(f32))))
+		if (!reader.Read(Utils::AsWritableBytes(std::span(m_data))))
 		{
-			file.close();
 			m_data.clear();
 			TP_ERROR(Log::ImagePFMPrefix, "Couldn't load pixel data!");
 			TP_WARN(Log::ImagePFMPrefix, "Using default image!");
 			return;
 		}
-
-		file.close();
 	}
 	else if(header.MagicNumber == "Pf")
 	{
@@ -80,17 +137,12 @@ TRAP::INTERNAL::PFMImage::PFMImage(std::filesystem::path filepath)
 		m_colorFormat = ColorFormat::GrayScale;
 		m_bitsPerPixel = 32;
 		m_data.resize(NumericCast<usize>(m_width) * m_height);
-		if (!file.read(reinterpret_cast<char*>(m_data.data()),
-					   NumericCast<std::streamsize>(m_width) * m_height *
-					   NumericCast<std::streamsize>(sizeof(f32))))
+		if (!reader.Read(Utils::AsWritableBytes(std::span(m_data))))
 		{
-			file.close();
 			m_data.clear();
 			TP_ERROR(Log::ImagePFMPrefix, "Couldn't load pixel data!");
 			TP_WARN(Log::ImagePFMPrefix, "Using default image!");
 			return;
 		}
-
-		file.close();
 	}
 }
@@ -10,7 +10,12 @@ namespace TRAP::INTERNAL
 	public:
 		/// @brief Constructor.
 		/// @param filepath File path of the image to load.
-		explicit PFMImage(std::filesystem::path filepath);
+		/// @param precision Precision to decode the pixel data to.
+		explicit PFMImage(std::filesystem::path filepath, HDRPrecision precision = HDRPrecision::Float32);
+		/// @brief Constructor.
+		/// @param data Encoded image data to load.
+		/// @param precision Precision to decode the pixel data to.
+		explicit PFMImage(std::span<const u8> data, HDRPrecision precision = HDRPrecision::Float32);
 		/// @brief Copy constructor.
 		PFMImage(const PFMImage&) noexcept = default;
 		/// @brief Copy assignment operator.
@@ -27,7 +32,13 @@ namespace TRAP::INTERNAL
 		[[nodiscard]] constexpr std::span<const u8> GetPixelData() const noexcept override;
 
 	private:
+		/// @brief Decode the image.
+		/// @param data Encoded image data.
+		/// @param precision Precision to decode the pixel data to.
+		void Decode(std::span<const u8> data, HDRPrecision precision);
+
 		std::vector<f32> m_data;
+		std::vector<u16> m_dataHalf;
 
 		struct Header
 		{
@@ -43,6 +54,12 @@ namespace TRAP::INTERNAL
 
 [[nodiscard]] constexpr std::span<const u8> TRAP::INTERNAL::PFMImage::GetPixelData() const noexcept
 {
+	if(!m_dataHalf.empty())
+	{
+		const std::span data(m_dataHalf);
+		return TRAP::Utils::AsBytes(data);
+	}
+
 	const std::span data(m_data);
 	return TRAP::Utils::AsBytes(data);
 }
@@ -2,6 +2,8 @@
 #include "PGMImage.h"
 
 #include "FileSystem/FileSystem.h"
+#include "FileSystem/MappedFile.h"
+#include "Utils/ByteReader.h"
 #include "Utils/Memory.h"
 #include "Utils/Utils.h"
 
@@ -10,48 +12,70 @@ TRAP::INTERNAL::PGMImage::PGMImage(std::filesystem::path filepath)
 {
 	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
 
-	m_colorFormat = ColorFormat::GrayScale;
-
 	TP_DEBUG(Log::ImagePGMPrefix, "Loading image: ", m_filepath);
 
 	if (!FileSystem::Exists(m_filepath))
 		return;
 
-	std::ifstream file(m_filepath, std::ios::binary);
-	if (!file.is_open())
+	const auto file = FileSystem::MapFile(m_filepath);
+	if (!file)
 	{
 		TP_ERROR(Log::ImagePGMPrefix, "Couldn't open file path: ", m_filepath, "!");
 		TP_WARN(Log::ImagePGMPrefix, "Using default image!");
 		return;
 	}
 
+	Decode(file->GetData());
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+TRAP::INTERNAL::PGMImage::PGMImage(const std::span<const u8> data)
+	: Image("")
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	TP_DEBUG(Log::ImagePGMPrefix, "Loading image from memory");
+
+	Decode(data);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::INTERNAL::PGMImage::Decode(const std::span<const u8> data)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	m_colorFormat = ColorFormat::GrayScale;
+
+	Utils::ByteReader reader(data);
+
 	Header header{};
-	file >> header.MagicNumber >> header.Width >> header.Height >> header.MaxValue;
+	header.MagicNumber = reader.ReadToken();
+	reader.ReadNumber(header.Width);
+	reader.ReadNumber(header.Height);
+	reader.ReadNumber(header.MaxValue);
 
 	if (!(header.MagicNumber == "P2" || header.MagicNumber == "P5"))
 	{
-		file.close();
 		TP_ERROR(Log::ImagePGMPrefix, "Unsupported format or invalid magic number (", header.MagicNumber, ")!");
 		TP_WARN(Log::ImagePGMPrefix, "Using default image!");
 		return;
 	}
 	if (header.Width < 1)
 	{
-		file.close();
 		TP_ERROR(Log::ImagePGMPrefix, "Width is < 1 (", header.Width, ")!");
 		TP_WARN(Log::ImagePGMPrefix, "Using default image!");
 		return;
 	}
 	if (header.Height < 1)
 	{
-		file.close();
 		TP_ERROR(Log::ImagePGMPrefix, "Height is < 1 (", header.Height, ")!");
 		TP_WARN(Log::ImagePGMPrefix, "Using default image!");
 		return;
 	}
 	if(header.MaxValue < 1 || header.MaxValue > 65535)
 	{
-		file.close();
 		TP_ERROR(Log::ImagePGMPrefix, "MaxValue ", header.MaxValue, " is unsupported or invalid!");
 		TP_WARN(Log::ImagePGMPrefix, "Using default image!");
 		return;
@@ -60,25 +84,20 @@ TRAP::INTERNAL::PGMImage::PGMImage(std::filesystem::path filepath)
 	m_width = header.Width;
 	m_height = header.Height;
 
-	file.ignore(256, '\n'); //Skip ahead to the pixel data.
+	reader.SkipLine(); //Skip ahead to the pixel data.
 
 	if(header.MaxValue > 255)
 	{
 		m_bitsPerPixel = 16;
 		m_data2Byte.resize(NumericCast<usize>(m_width) * m_height);
-		if(!file.read(reinterpret_cast<char*>(m_data2Byte.data()),
-		              NumericCast<std::streamsize>(m_width) * m_height *
-					  NumericCast<std::streamsize>(sizeof(u16))))
+		if(!reader.Read(Utils::AsWritableBytes(std::span(m_data2Byte))))
 		{
-			file.close();
-			m_data.clear();
+			m_data2Byte.clear();
 			TP_ERROR(Log::ImagePGMPrefix, "Couldn't load pixel data!");
 			TP_WARN(Log::ImagePGMPrefix, "Using default image!");
 			return;
 		}
 
-		file.close();
-
 		//File uses big-endian
 		//Convert to machines endian
 		if constexpr (Utils::GetEndian() != Utils::Endian::Big)
@@ -91,15 +110,12 @@ TRAP::INTERNAL::PGMImage::PGMImage(std::filesystem::path filepath)
 	{
 		m_bitsPerPixel = 8;
 		m_data.resize(NumericCast<usize>(m_width) * m_height);
-		if(!file.read(reinterpret_cast<char*>(m_data.data()), NumericCast<std::streamsize>(m_width) * m_height))
+		if(!reader.Read(Utils::AsWritableBytes(std::span(m_data))))
 		{
-			file.close();
 			m_data.clear();
 			TP_ERROR(Log::ImagePGMPrefix, "Couldn't load pixel data!");
 			TP_WARN(Log::ImagePGMPrefix, "Using default image!");
 			return;
 		}
-
-		file.close();
 	}
 }
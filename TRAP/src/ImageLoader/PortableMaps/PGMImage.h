@@ -11,6 +11,9 @@ namespace TRAP::INTERNAL
 		/// @brief Constructor.
 		/// @param filepath File path of the image to load.
 		explicit PGMImage(std::filesystem::path filepath);
+		/// @brief Constructor.
+		/// @param data Encoded image data to load.
+		explicit PGMImage(std::span<const u8> data);
 		/// @brief Copy constructor.
 		PGMImage(const PGMImage&) noexcept = default;
 		/// @brief Copy assignment operator.
@@ -27,6 +30,10 @@ namespace TRAP::INTERNAL
 		[[nodiscard]] constexpr std::span<const u8> GetPixelData() const noexcept override;
 
 	private:
+		/// @brief Decode the image.
+		/// @param data Encoded image data.
+		void Decode(std::span<const u8> data);
+
 		std::vector<u8> m_data;
 		std::vector<u16> m_data2Byte;
 
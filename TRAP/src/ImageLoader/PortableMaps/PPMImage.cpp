@@ -2,6 +2,8 @@
 #include "PPMImage.h"
 
 #include "FileSystem/FileSystem.h"
+#include "FileSystem/MappedFile.h"
+#include "Utils/ByteReader.h"
 #include "Utils/Memory.h"
 #include "Utils/Utils.h"
 
@@ -10,48 +12,70 @@ TRAP::INTERNAL::PPMImage::PPMImage(std::filesystem::path filepath)
 {
 	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
 
-	m_colorFormat = ColorFormat::RGB;
-
 	TP_DEBUG(Log::ImagePPMPrefix, "Loading image: ", m_filepath);
 
 	if (!FileSystem::Exists(m_filepath))
 		return;
 
-	std::ifstream file(m_filepath, std::ios::binary);
-	if (!file.is_open())
+	const auto file = FileSystem::MapFile(m_filepath);
+	if (!file)
 	{
 		TP_ERROR(Log::ImagePPMPrefix, "Couldn't open file path: ", m_filepath, "!");
 		TP_WARN(Log::ImagePPMPrefix, "Using default image!");
 		return;
 	}
 
+	Decode(file->GetData());
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+TRAP::INTERNAL::PPMImage::PPMImage(const std::span<const u8> data)
+	: Image("")
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	TP_DEBUG(Log::ImagePPMPrefix, "Loading image from memory");
+
+	Decode(data);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::INTERNAL::PPMImage::Decode(const std::span<const u8> data)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	m_colorFormat = ColorFormat::RGB;
+
+	Utils::ByteReader reader(data);
+
 	Header header{};
-	file >> header.MagicNumber >> header.Width >> header.Height >> header.MaxValue;
+	header.MagicNumber = reader.ReadToken();
+	reader.ReadNumber(header.Width);
+	reader.ReadNumber(header.Height);
+	reader.ReadNumber(header.MaxValue);
 
 	if (header.MagicNumber != "P3" && header.MagicNumber != "P6")
 	{
-		file.close();
 		TP_ERROR(Log::ImagePPMPrefix, "Unsupported format or invalid magic number (", header.MagicNumber, ")!");
 		TP_WARN(Log::ImagePPMPrefix, "Using default image!");
 		return;
 	}
 	if (header.Width < 1)
 	{
-		file.close();
 		TP_ERROR(Log::ImagePPMPrefix, "Width is < 1 (", header.Width, ")!");
 		TP_WARN(Log::ImagePPMPrefix, "Using default image!");
 		return;
 	}
 	if (header.Height < 1)
 	{
-		file.close();
 		TP_ERROR(Log::ImagePPMPrefix, "Height is < 1 (", header.Height, ")!");
 		TP_WARN(Log::ImagePPMPrefix, "Using default image!");
 		return;
 	}
 	if (header.MaxValue < 1 || header.MaxValue > 65535)
 	{
-		file.close();
 		TP_ERROR(Log::ImagePPMPrefix, "MaxValue ", header.MaxValue, " is unsupported or invalid!");
 		TP_WARN(Log::ImagePPMPrefix, "Using default image!");
 		return;
@@ -60,24 +84,20 @@ TRAP::INTERNAL::PPMImage::PPMImage(std::filesystem::path filepath)
 	m_width = header.Width;
 	m_height = header.Height;
 
-	file.ignore(256, '\n'); //Skip ahead to the pixel data.
+	reader.SkipLine(); //Skip ahead to the pixel data.
 
 	if(header.MaxValue > 255)
 	{
 		m_bitsPerPixel = 48;
 		m_data2Byte.resize(NumericCast<usize>(m_width) * m_height * 3);
-		if(!file.read(reinterpret_cast<char*>(m_data2Byte.data()),
-		              NumericCast<std::streamsize>(m_width) * m_height * 3 *
-					  NumericCast<std::streamsize>(sizeof(u16))))
+		if(!reader.Read(Utils::AsWritableBytes(std::span(m_data2Byte))))
 		{
-			file.close();
+			m_data2Byte.clear();
 			TP_ERROR(Log::ImagePPMPrefix, "Couldn't load pixel data!");
 			TP_WARN(Log::ImagePPMPrefix, "Using default image!");
 			return;
 		}
 
-		file.close();
-
 		//File uses big-endian
 		//Convert to machines endian
 		if constexpr (Utils::GetEndian() != Utils::Endian::Big)
@@ -90,28 +110,30 @@ TRAP::INTERNAL::PPMImage::PPMImage(std::filesystem::path filepath)
 	{
 		m_bitsPerPixel = 24;
 		m_data.resize(NumericCast<usize>(m_width) * m_height * 3);
-		if (!file.read(reinterpret_cast<char*>(m_data.data()),
-					   NumericCast<std::streamsize>(m_width) * m_height * 3))
+		if (!reader.Read(Utils::AsWritableBytes(std::span(m_data))))
 		{
-			file.close();
+			m_data.clear();
 			TP_ERROR(Log::ImagePPMPrefix, "Couldn't load pixel data!");
 			TP_WARN(Log::ImagePPMPrefix, "Using default image!");
 			return;
 		}
-
-		file.close();
 	}
 }
 
 //-------------------------------------------------------------------------------------------------------------------//
 
-void TRAP::INTERNAL::PPMImage::Save(const Image* const img, const std::filesystem::path& filepath)
+bool TRAP::INTERNAL::PPMImage::Save(const Image* const img, const std::filesystem::path& filepath)
 {
 	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
 
 	//NOTE Only supports 24/32BPP RGB(A) Input
 
 	std::ofstream file(filepath, std::ios::out | std::ios::binary);
+	if(!file.is_open())
+	{
+		TP_ERROR(Log::ImagePPMPrefix, "Couldn't open file path: ", filepath, "!");
+		return false;
+	}
 
 	//PPM Header
 	file << fmt::format("P6\n{}\n{}\n255\n", img->GetWidth(), img->GetHeight());
@@ -128,5 +150,5 @@ void TRAP::INTERNAL::PPMImage::Save(const Image* const img, const std::filesyste
 		file.write(reinterpret_cast<const char*>(pixelData.data()), NumericCast<std::streamsize>(pixelData.size()));
 	}
 
-	file.close();
+	return file.good();
 }
\ No newline at end of file
@@ -11,6 +11,9 @@ namespace TRAP::INTERNAL
 		/// @brief Constructor.
 		/// @param filepath File path of the image to load.
 		explicit PPMImage(std::filesystem::path filepath);
+		/// @brief Constructor.
+		/// @param data Encoded image data to load.
+		explicit PPMImage(std::span<const u8> data);
 		/// @brief Copy constructor.
 		PPMImage(const PPMImage&) noexcept = default;
 		/// @brief Copy assignment operator.
@@ -29,9 +32,14 @@ namespace TRAP::INTERNAL
 		/// @brief Save an TRAP::Image as a Portable Pixmap (PPM) file.
 		/// @param img Image to save.
 		/// @param filepath File path to save the image to.
-		static void Save(const Image* img, const std::filesystem::path& filepath);
+		/// @return True on success, false otherwise.
+		static bool Save(const Image* img, const std::filesystem::path& filepath);
 
 	private:
+		/// @brief Decode the image.
+		/// @param data Encoded image data.
+		void Decode(std::span<const u8> data);
+
 		std::vector<u8> m_data;
 		std::vector<u16> m_data2Byte;
 
@@ -29,13 +29,18 @@ Modified by Jan "GamesTrap" Schuerkamp
 #include "PNGImage.h"
 
 #include "FileSystem/FileSystem.h"
+#include "FileSystem/MappedFile.h"
+#include "Utils/ByteReader.h"
 #include "Maths/Math.h"
 #include "Utils/Memory.h"
 #include "Utils/Utils.h"
 #include "Utils/Hash/CRC32.h"
-#include "Utils/Decompress/Inflate.h"
+#include "Utils/Decompress/Inflater.h"
 #include "Utils/Hash/Adler32.h"
 #include "Utils/Hash/ConvertHashToString.h"
+#include "PNGUnFilter.h"
+
+#include <immintrin.h>
 
 namespace
 {
@@ -49,6 +54,28 @@ namespace
 
 	//-------------------------------------------------------------------------------------------------------------------//
 
+	/// @brief State for decoding the image data while the IDAT chunks are still being read.
+	struct IDATDecoder
+	{
+		TRAP::Utils::Decompress::Inflater Inflater{};
+		TRAP::Utils::Hash::Adler32Hasher Adler32{};
+		std::array<u8, 2> ZLibHeader{};
+		usize ZLibHeaderSize = 0;
+
+		u32 BitsPerPixel = 0;
+		usize ByteWidth = 0;
+		usize LineBytes = 0;
+		u32 NextScanline = 0;
+		//Without interlacing the current filtered scanline which gets unfiltered directly into Raw,
+		//with Adam7 interlacing all filtered data
+		std::vector<u8> Filtered{};
+		usize FilteredPos = 0;
+		//Unfiltered pixel data, only used without interlacing
+		std::vector<u8> Raw{};
+	};
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
 	struct Data
 	{
 		u32 Width = 0;
@@ -59,7 +86,7 @@ namespace
 		u8 FilterMethod = 0; //Always 0 others are unsupported extensions!
 		u8 InterlaceMethod = 0; //Always 0 or 1 others are unsupported extensions!
 		std::vector<RGBA> Palette{};
-		std::vector<u8> CompressedData{};
+		IDATDecoder Decoder{};
 	};
 
 	//-------------------------------------------------------------------------------------------------------------------//
@@ -219,24 +246,24 @@ namespace
 	/// @brief Process the IHDR chunk.
 	/// IHDR is the first chunk in the PNG file and contains the width, height,
 	/// bit depth, color type, compression method, filter method and interlace method.
-	/// @param file Open PNG file.
+	/// @param reader Reader positioned at the chunk data.
 	/// @param data Data containing information about the image.
 	/// @return True if the chunk was processed successfully, false otherwise.
-	[[nodiscard]] bool ProcessIHDR(std::ifstream& file, Data& data)
+	[[nodiscard]] bool ProcessIHDR(TRAP::Utils::ByteReader& reader, Data& data)
 	{
 		ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None &&
 												 (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
 
 		IHDRChunk ihdrChunk{};
 		//Read in IHDR Chunk
-		file.read(reinterpret_cast<char*>(&ihdrChunk.Width), sizeof(u32));
-		file.read(reinterpret_cast<char*>(&ihdrChunk.Height), sizeof(u32));
-		ihdrChunk.BitDepth = NumericCast<u8>(file.get());
-		ihdrChunk.ColorType = NumericCast<u8>(file.get());
-		ihdrChunk.CompressionMethod = NumericCast<u8>(file.get());
-		ihdrChunk.FilterMethod = NumericCast<u8>(file.get());
-		ihdrChunk.InterlaceMethod = NumericCast<u8>(file.get());
-		file.read(reinterpret_cast<char*>(ihdrChunk.CRC.data()), ihdrChunk.CRC.size());
+		reader.Read(ihdrChunk.Width);
+		reader.Read(ihdrChunk.Height);
+		ihdrChunk.BitDepth = reader.ReadByte();
+		ihdrChunk.ColorType = reader.ReadByte();
+		ihdrChunk.CompressionMethod = reader.ReadByte();
+		ihdrChunk.FilterMethod = reader.ReadByte();
+		ihdrChunk.InterlaceMethod = reader.ReadByte();
+		reader.Read(ihdrChunk.CRC);
 
 		//Convert to machines endian
 		if constexpr (TRAP::Utils::GetEndian() != TRAP::Utils::Endian::Big)
@@ -286,10 +313,10 @@ namespace
 
 	/// @brief Process the optional sBIT chunk.
 	/// sBIT contains the significant bits for each sample.
-	/// @param file Open PNG file.
+	/// @param reader Reader positioned at the chunk data.
 	/// @param data Data containing information about the image.
 	/// @return True if the chunk was processed successfully, false otherwise.
-	[[nodiscard]] bool ProcesssBIT(std::ifstream& file, const Data& data)
+	[[nodiscard]] bool ProcesssBIT(TRAP::Utils::ByteReader& reader, const Data& data)
 	{
 		ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None &&
 												 (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
@@ -298,7 +325,7 @@ namespace
 		{
 		case 0:
 		{
-			file.seekg(4 + 1, std::ios::cur);
+			reader.Skip(4u + 1u);
 			return true;
 		}
 
@@ -306,19 +333,19 @@ namespace
 			[[fallthrough]];
 		case 3:
 		{
-			file.seekg(4 + 3, std::ios::cur);
+			reader.Skip(4u + 3u);
 			return true;
 		}
 
 		case 4:
 		{
-			file.seekg(4 + 2, std::ios::cur);
+			reader.Skip(4u + 2u);
 			return true;
 		}
 
 		case 6:
 		{
-			file.seekg(4 + 4, std::ios::cur);
+			reader.Skip(4u + 4u);
 			return true;
 		}
 
@@ -331,17 +358,17 @@ namespace
 
 	/// @brief Process the optional sRGB chunk.
 	/// sRGB contains the rendering intent.
-	/// @param file Open PNG file.
+	/// @param reader Reader positioned at the chunk data.
 	/// @return True if the chunk was processed successfully, false otherwise.
-	[[nodiscard]] bool ProcesssRGB(std::ifstream& file)
+	[[nodiscard]] bool ProcesssRGB(TRAP::Utils::ByteReader& reader)
 	{
 		ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None &&
 												 (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
 
 		//TODO Treat image as sRGB
 		std::array<u8, 4> CRC{};
-		const u8 renderingIntent = static_cast<u8>(file.get());
-		file.read(reinterpret_cast<char*>(CRC.data()), CRC.size());
+		const u8 renderingIntent = reader.ReadByte();
+		reader.Read(CRC);
 
 		const std::array<u8, 5> CRCData{ 's', 'R', 'G', 'B', renderingIntent };
 
@@ -360,10 +387,10 @@ namespace
 
 	/// @brief Process the optional bKGD chunk.
 	/// bKGD contains the image background color.
-	/// @param file Open PNG file.
+	/// @param reader Reader positioned at the chunk data.
 	/// @param data Data containing information about the image.
 	/// @return True if the chunk was processed successfully, false otherwise.
-	[[nodiscard]] bool ProcessbKGD(std::ifstream& file, const Data& data)
+	[[nodiscard]] bool ProcessbKGD(TRAP::Utils::ByteReader& reader, const Data& data)
 	{
 		ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None &&
 												 (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
@@ -374,7 +401,7 @@ namespace
 			[[fallthrough]];
 		case 4:
 		{
-			file.seekg(4 + 2, std::ios::cur);
+			reader.Skip(4u + 2u);
 			return true;
 		}
 
@@ -382,13 +409,13 @@ namespace
 			[[fallthrough]];
 		case 6:
 		{
-			file.seekg(4 + 6, std::ios::cur);
+			reader.Skip(4u + 6u);
 			return true;
 		}
 
 		case 3:
 		{
-			file.seekg(4 + 1, std::ios::cur);
+			reader.Skip(4u + 1u);
 			return true;
 		}
 
@@ -401,11 +428,11 @@ namespace
 
 	/// @brief Process the optional tRNS chunk.
 	/// tRNS contains the transparency data.
-	/// @param file Open PNG file.
+	/// @param reader Reader positioned at the chunk data.
 	/// @param length Chunk length.
 	/// @param data Data containing information about the image.
 	/// @return True if the chunk was processed successfully, false otherwise.
-	[[nodiscard]] bool ProcesstRNS(std::ifstream& file, const u32 length, Data& data)
+	[[nodiscard]] bool ProcesstRNS(TRAP::Utils::ByteReader& reader, const u32 length, Data& data)
 	{
 		ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None &&
 												 (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
@@ -416,9 +443,9 @@ namespace
 		case 0:
 		{
 			std::array<u8, 4> CRC{};
-			const u8 grayAlpha1 = static_cast<u8>(file.get());
-			const u8 grayAlpha2 = static_cast<u8>(file.get());
-			file.read(reinterpret_cast<char*>(CRC.data()), CRC.size());
+			const u8 grayAlpha1 = reader.ReadByte();
+			const u8 grayAlpha2 = reader.ReadByte();
+			reader.Read(CRC);
 
 			const std::array<u8, 6> CRCData{ 't', 'R', 'N', 'S', grayAlpha1, grayAlpha2 };
 
@@ -436,13 +463,13 @@ namespace
 		case 2:
 		{
 			std::array<u8, 4> CRC{};
-			const u8 redAlpha1 = static_cast<u8>(file.get());
-			const u8 redAlpha2 = static_cast<u8>(file.get());
-			const u8 greenAlpha1 = static_cast<u8>(file.get());
-			const u8 greenAlpha2 = static_cast<u8>(file.get());
-			const u8 blueAlpha1 = static_cast<u8>(file.get());
-			const u8 blueAlpha2 = static_cast<u8>(file.get());
-			file.read(reinterpret_cast<char*>(CRC.data()), CRC.size());
+			const u8 redAlpha1 = reader.ReadByte();
+			const u8 redAlpha2 = reader.ReadByte();
+			const u8 greenAlpha1 = reader.ReadByte();
+			const u8 greenAlpha2 = reader.ReadByte();
+			const u8 blueAlpha1 = reader.ReadByte();
+			const u8 blueAlpha2 = reader.ReadByte();
+			reader.Read(CRC);
 
 			const std::array<u8, 10> CRCData
 			{
@@ -465,21 +492,14 @@ namespace
 
 		case 3:
 		{
-			std::vector<u8> paletteAlpha(length);
+			const std::span<const u8> paletteAlpha = reader.ReadSpan(length).ValueOr(std::span<const u8>{});
 			std::array<u8, 4> CRC{};
-			file.read(reinterpret_cast<char*>(paletteAlpha.data()),
-					NumericCast<std::streamsize>(paletteAlpha.size()));
-			file.read(reinterpret_cast<char*>(CRC.data()), CRC.size());
-
-			std::vector<u8> CRCData(paletteAlpha.size() + 4);
-			CRCData[0] = 't';
-			CRCData[1] = 'R';
-			CRCData[2] = 'N';
-			CRCData[3] = 'S';
-			for (u32 i = 0; i < paletteAlpha.size(); i++)
-				CRCData[i + 4] = paletteAlpha[i];
+			reader.Read(CRC);
 
-			const std::array<u8, 4> crc = TRAP::Utils::Hash::CRC32(CRCData.data(), CRCData.size());
+			TRAP::Utils::Hash::CRC32Hasher hasher{};
+			hasher.Update("tRNS");
+			hasher.Update(paletteAlpha);
+			const std::array<u8, 4> crc = hasher.Finalize();
 			if(crc != CRC)
 			{
 				TP_ERROR(TRAP::Log::ImagePNGPrefix, "tRNS CRC: ", TRAP::Utils::Hash::ConvertHashToString(CRC), " is wrong!");
@@ -502,11 +522,11 @@ namespace
 
 	/// @brief Process the optional PLTE chunk.
 	/// PLTE contains the palette.
-	/// @param file Open PNG file.
+	/// @param reader Reader positioned at the chunk data.
 	/// @param data Data containing information about the image.
 	/// @param length Chunk length.
 	/// @return True if the chunk was processed successfully, false otherwise.
-	[[nodiscard]] bool ProcessPLTE(std::ifstream& file, Data& data, const u32 length)
+	[[nodiscard]] bool ProcessPLTE(TRAP::Utils::ByteReader& reader, Data& data, const u32 length)
 	{
 		ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
 
@@ -530,30 +550,21 @@ namespace
 		for (u32 i = 0; i < length; i++)
 		{
 			RGBA rgba{};
-			rgba.Red = NumericCast<u8>(file.get());
+			rgba.Red = reader.ReadByte();
 			i++;
-			rgba.Green = NumericCast<u8>(file.get());
+			rgba.Green = reader.ReadByte();
 			i++;
-			rgba.Blue = NumericCast<u8>(file.get());
+			rgba.Blue = reader.ReadByte();
 
 			paletteData[paletteIndex++] = rgba;
 		}
-		file.read(reinterpret_cast<char*>(CRC.data()), CRC.size());
+		reader.Read(CRC);
 
-		std::vector<u8> CRCData(paletteData.size() * 3 + 4);
-		CRCData[0] = 'P';
-		CRCData[1] = 'L';
-		CRCData[2] = 'T';
-		CRCData[3] = 'E';
-		u32 j = 0;
+		TRAP::Utils::Hash::CRC32Hasher hasher{};
+		hasher.Update("PLTE");
 		for (const auto& i : paletteData)
-		{
-			CRCData[j++ + 4] = i.Red;
-			CRCData[j++ + 4] = i.Green;
-			CRCData[j++ + 4] = i.Blue;
-		}
-
-		const std::array<u8, 4> crc = TRAP::Utils::Hash::CRC32(CRCData.data(), CRCData.size());
+			hasher.Update(std::array<u8, 3>{i.Red, i.Green, i.Blue});
+		const std::array<u8, 4> crc = hasher.Finalize();
 		if(crc != CRC)
 		{
 			TP_ERROR(TRAP::Log::ImagePNGPrefix, "PLTE CRC: ", TRAP::Utils::Hash::ConvertHashToString(CRC), " is wrong!");
@@ -568,334 +579,6 @@ namespace
 
 	//-------------------------------------------------------------------------------------------------------------------//
 
-	/// @brief Process the IDAT chunk.
-	/// IDAT contains the image data.
-	/// @param file Open PNG file.
-	/// @param data Data containing information about the image.
-	/// @param length Chunk length.
-	/// @return True if the chunk was processed successfully, false otherwise.
-	[[nodiscard]] bool ProcessIDAT(std::ifstream& file, Data& data, const u32 length)
-	{
-		ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None &&
-												 (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
-
-		std::vector<u8> compressedData(length);
-		std::array<u8, 4> CRC{};
-		file.read(reinterpret_cast<char*>(compressedData.data()), NumericCast<std::streamsize>(compressedData.size()));
-		file.read(reinterpret_cast<char*>(CRC.data()), CRC.size());
-
-		std::vector<u8> CRCData(compressedData.size() + 4);
-		CRCData[0] = 'I';
-		CRCData[1] = 'D';
-		CRCData[2] = 'A';
-		CRCData[3] = 'T';
-		for (u32 i = 0; i < compressedData.size(); i++)
-			CRCData[i + 4] = compressedData[i];
-
-		const std::array<u8, 4> crc = TRAP::Utils::Hash::CRC32(CRCData.data(), CRCData.size());
-		if(crc != CRC)
-		{
-			TP_ERROR(TRAP::Log::ImagePNGPrefix, "IDAT CRC: ", TRAP::Utils::Hash::ConvertHashToString(CRC), " is wrong!");
-			TP_WARN(TRAP::Log::ImagePNGPrefix, "Using default image!");
-			return false;
-		}
-
-		data.CompressedData.insert(data.CompressedData.end(), compressedData.begin(), compressedData.end());
-
-		return true;
-	}
-
-	//-------------------------------------------------------------------------------------------------------------------//
-
-	/// @brief Decompress PNG data.
-	/// @param source Source data.
-	/// @param destination Destination for uncompressed data.
-	/// @return True if the data was decompressed successfully, false otherwise.
-	[[nodiscard]] bool DecompressData(const std::span<const u8> source, const std::span<u8> destination)
-	{
-		ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
-
-		if (source.size_bytes() < 2)
-		{
-			TP_ERROR(TRAP::Log::ImagePNGPrefix, "Compressed zlib data is too small!");
-			TP_WARN(TRAP::Log::ImagePNGPrefix, "Using default image!");
-			return false; //Error, size of zlib data too small
-		}
-		if ((source[0] * 256 + source[1]) % 31 != 0)
-		{
-			TP_ERROR(TRAP::Log::ImagePNGPrefix, "Decompression failed! 256 * source[0](", source[0], ") + source[1](",
-				source[1], ") must be a multiple of 31(", NumericCast<u32>(source[0] * 256 + source[1]), ")!");
-			TP_WARN(TRAP::Log::ImagePNGPrefix, "Using default image!");
-			return false; //Error: 256 * source[0] + source[1] must be a multiple of 31, the FCHECK value is supposed to be made this way
-		}
-
-		const u32 CM = source[0] & 15u;
-		const u32 CINFO = (source[0] >> 4u) & 15u;
-		//FCHECK = source[1] & 31u; //FCHECK is already tested above
-		const u32 FDICT = (source[1] >> 5u) & 1u;
-		//FLEVEL = (source[1] >> 6u) & 3u; //FLEVEL is not used here
-
-		if (CM != 8 || CINFO > 7)
-		{
-			TP_ERROR(TRAP::Log::ImagePNGPrefix, "Decompression failed! Only compression method 8(De/Inflate) with ",
-										"sliding window of 32K is supported by the PNG specification!");
-			TP_WARN(TRAP::Log::ImagePNGPrefix, "Using default image!");
-			return false; //Error: Only compression method 8: inflate with sliding window of 32K is supported by the PNG specification
-		}
-		if(FDICT != 0)
-		{
-			TP_ERROR(TRAP::Log::ImagePNGPrefix, "Decompression failed! Additional flags should ",
-										"not specify a preset dictionary!");
-			TP_WARN(TRAP::Log::ImagePNGPrefix, "Using default image!");
-			return false; //Error: The PNG specification says that the zlib stream should not specify a preset dictionary in the additional flags!
-		}
-
-		if (!TRAP::Utils::Decompress::Inflate(source.subspan<2>(), destination))
-		{
-			TP_ERROR(TRAP::Log::ImagePNGPrefix, "Decompression failed! Inflate error!");
-			TP_WARN(TRAP::Log::ImagePNGPrefix, "Using default image!");
-			return false;
-		}
-
-		const u8* const buf = &source[source.size_bytes() - 4];
-		const std::array<u8, 4> adler32 =
-		{
-			buf[0],
-			buf[1],
-			buf[2],
-			buf[3]
-		};
-		const std::array<u8, 4> checksum = TRAP::Utils::Hash::Adler32(destination.data(), destination.size_bytes());
-
-		if(checksum != adler32)
-		{
-			TP_ERROR(TRAP::Log::ImagePNGPrefix, "Decompression failed! Adler32 checksum: ",
-										        TRAP::Utils::Hash::ConvertHashToString(adler32),
-										        " doesnt match checksum: ",
-												TRAP::Utils::Hash::ConvertHashToString(checksum), "!");
-			TP_WARN(TRAP::Log::ImagePNGPrefix, "Using default image!");
-			return false; //Error: Adler checksum not correct, data must be corrupt
-		}
-
-		return true;
-	}
-
-	//-------------------------------------------------------------------------------------------------------------------//
-
-	/// @brief Paeth predictor used by PNG filter type 4.
-	/// @param a Left pixel.
-	/// @param b Above pixel.
-	/// @param c Above-left pixel.
-	/// @return Predicted pixel.
-	[[nodiscard]] constexpr u8 PaethPredictor(u16 a, const u16 b, const u16 c)
-	{
-		u16 pa = NumericCast<u16>(TRAP::Math::Abs(b - c));
-		const u16 pb = NumericCast<u16>(TRAP::Math::Abs(a - c));
-		const u16 pc = NumericCast<u16>(TRAP::Math::Abs(a + b - c - c));
-
-		//Return input value associated with smallest of pa, pb, pc(with certain priority if equal)
-		if (pb < pa)
-		{
-			a = b;
-			pa = pb;
-		}
-
-		return NumericCast<u8>((pc < pa) ? c : a);
-	}
-
-	//-------------------------------------------------------------------------------------------------------------------//
-
-	/// @brief Unfilter scanline depending on given filter type.
-	/// @param recon
-	/// @param scanline Pointer to scanline.
-	/// @param precon
-	/// @param byteWidth Width of the scanline in bytes.
-	/// @param filterType Filter type.
-	/// @param length Length of the scanline in bytes.
-	/// @return True if the scanline was unfiltered successfully, false otherwise.
-	[[nodiscard]] constexpr bool UnFilterScanline(u8* const recon, const u8* const scanline, const u8* const precon,
-										          const usize byteWidth, const u8 filterType, const usize length)
-	{
-		//For PNG Filter Method 0
-		//UnFilter a PNG Image Scanline by Scanline.
-		//When the pixels are smaller than 1 Byte, the Filter works Byte per Byte (byteWidth = 1)
-		//precon is the previous unFiltered Scanline, recon the result, scanline the current one the incoming
-		//Scanlines do NOT include the FilterType byte, that one is given in the parameter filterType instead
-		//recon and scanline MAY be the same memory address!
-		//precon must be disjoint.
-		usize i = 0;
-		switch (filterType)
-		{
-		case 0:
-		{
-			for (i = 0; i != length; ++i)
-				recon[i] = scanline[i];
-			break;
-		}
-
-		case 1:
-		{
-			usize j = 0;
-			for (i = 0; i != byteWidth; ++i)
-				recon[i] = scanline[i];
-			for (i = byteWidth; i != length; ++i, ++j)
-				recon[i] = scanline[i] + recon[j];
-			break;
-		}
-
-		case 2:
-		{
-			if (precon != nullptr)
-				for (i = 0; i != length; ++i)
-					recon[i] = scanline[i] + precon[i];
-			else
-				for (i = 0; i != length; ++i)
-					recon[i] = scanline[i];
-			break;
-		}
-
-		case 3:
-		{
-			if (precon != nullptr)
-			{
-				usize j = 0;
-
-				for (i = 0; i != byteWidth; ++i)
-					recon[i] = scanline[i] + (precon[i] >> 1u);
-
-				//Unroll independent paths of the Paeth predictor.
-				//A 6x and 8x version is also possible but that adds too much code.
-				//Whether this speeds up anything at all depends on compiler and settings.
-				if(byteWidth >= 4)
-				{
-					for(; i + 3 < length; i += 4, j += 4)
-					{
-						u8 s0 = scanline[i + 0], r0 = recon[j + 0], p0 = precon[i + 0];
-						u8 s1 = scanline[i + 1], r1 = recon[j + 1], p1 = precon[i + 1];
-						u8 s2 = scanline[i + 2], r2 = recon[j + 2], p2 = precon[i + 2];
-						u8 s3 = scanline[i + 3], r3 = recon[j + 3], p3 = precon[i + 3];
-
-						recon[i + 0] = NumericCast<u8>(s0 + ((r0 + p0) >> 1u));
-						recon[i + 1] = NumericCast<u8>(s1 + ((r1 + p1) >> 1u));
-						recon[i + 2] = NumericCast<u8>(s2 + ((r2 + p2) >> 1u));
-						recon[i + 3] = NumericCast<u8>(s3 + ((r3 + p3) >> 1u));
-					}
-				}
-				else if(byteWidth >= 3)
-				{
-					for(; i + 2 < length; i += 3, j += 3)
-					{
-						u8 s0 = scanline[i + 0], r0 = recon[j + 0], p0 = precon[i + 0];
-						u8 s1 = scanline[i + 1], r1 = recon[j + 1], p1 = precon[i + 1];
-						u8 s2 = scanline[i + 2], r2 = recon[j + 2], p2 = precon[i + 2];
-
-						recon[i + 0] = NumericCast<u8>(s0 + ((r0 + p0) >> 1u));
-						recon[i + 1] = NumericCast<u8>(s1 + ((r1 + p1) >> 1u));
-						recon[i + 2] = NumericCast<u8>(s2 + ((r2 + p2) >> 1u));
-					}
-				}
-				else if(byteWidth >= 2)
-				{
-					for(; i + 1 < length; i += 2, j += 2)
-					{
-						u8 s0 = scanline[i + 0], r0 = recon[j + 0], p0 = precon[i + 0];
-						u8 s1 = scanline[i + 1], r1 = recon[j + 1], p1 = precon[i + 1];
-
-						recon[i + 0] = NumericCast<u8>(s0 + ((r0 + p0) >> 1u));
-						recon[i + 1] = NumericCast<u8>(s1 + ((r1 + p1) >> 1u));
-					}
-				}
-
-				for(; i != length; ++i, ++j)
-					recon[i] = NumericCast<u8>(scanline[i] + ((recon[j] + precon[i]) >> 1u));
-			}
-			else
-			{
-				for (i = 0; i != byteWidth; ++i)
-					recon[i] = scanline[i];
-				usize j = 0;
-				for (i = byteWidth; i != length; ++i, ++j)
-					recon[i] = scanline[i] + (recon[j] >> 1u);
-			}
-			break;
-		}
-
-		case 4:
-		{
-			if (precon != nullptr)
-			{
-				usize j = 0;
-
-				for (i = 0; i != byteWidth; ++i)
-					recon[i] = (scanline[i] + precon[i]);
-
-				//Unroll independent paths of the Paeth predictor.
-				//A 6x and 8x version is also possible but that adds too much code.
-				//Whether this speeds up anything at all depends on compiler and settings.
-				if (byteWidth >= 4)
-				{
-					for (; i + 3 < length; i += 4, j += 4)
-					{
-						const u8 s0 = scanline[i + 0], s1 = scanline[i + 1];
-						const u8 s2 = scanline[i + 2], s3 = scanline[i + 3];
-						const u8 r0 = recon[j + 0], r1 = recon[j + 1], r2 = recon[j + 2], r3 = recon[j + 3];
-						const u8 p0 = precon[i + 0], p1 = precon[i + 1], p2 = precon[i + 2], p3 = precon[i + 3];
-						const u8 q0 = precon[j + 0], q1 = precon[j + 1], q2 = precon[j + 2], q3 = precon[j + 3];
-						recon[i + 0] = s0 + PaethPredictor(r0, p0, q0);
-						recon[i + 1] = s1 + PaethPredictor(r1, p1, q1);
-						recon[i + 2] = s2 + PaethPredictor(r2, p2, q2);
-						recon[i + 3] = s3 + PaethPredictor(r3, p3, q3);
-					}
-				}
-				else if (byteWidth >= 3)
-				{
-					for (; i + 2 < length; i += 3, j += 3)
-					{
-						const u8 s0 = scanline[i + 0], s1 = scanline[i + 1], s2 = scanline[i + 2];
-						const u8 r0 = recon[j + 0], r1 = recon[j + 1], r2 = recon[j + 2];
-						const u8 p0 = precon[i + 0], p1 = precon[i + 1], p2 = precon[i + 2];
-						const u8 q0 = precon[j + 0], q1 = precon[j + 1], q2 = precon[j + 2];
-						recon[i + 0] = s0 + PaethPredictor(r0, p0, q0);
-						recon[i + 1] = s1 + PaethPredictor(r1, p1, q1);
-						recon[i + 2] = s2 + PaethPredictor(r2, p2, q2);
-					}
-				}
-				else if (byteWidth >= 2)
-				{
-					for (; i + 1 < length; i += 2, j += 2)
-					{
-						const u8 s0 = scanline[i + 0], s1 = scanline[i + 1];
-						const u8 r0 = recon[j + 0], r1 = recon[j + 1];
-						const u8 p0 = precon[i + 0], p1 = precon[i + 1];
-						const u8 q0 = precon[j + 0], q1 = precon[j + 1];
-						recon[i + 0] = s0 + PaethPredictor(r0, p0, q0);
-						recon[i + 1] = s1 + PaethPredictor(r1, p1, q1);
-					}
-				}
-
-				for (; i != length; ++i, ++j)
-					recon[i] = (scanline[i] + PaethPredictor(recon[i - byteWidth], precon[i], precon[j]));
-			}
-			else
-			{
-				for (i = 0; i != byteWidth; ++i)
-					recon[i] = scanline[i];
-				usize j = 0;
-				for (i = byteWidth; i != length; ++i, ++j)
-					recon[i] = (scanline[i] + recon[j]);
-			}
-			break;
-		}
-
-		default:
-			return false;
-		}
-
-		return true;
-	}
-
-	//-------------------------------------------------------------------------------------------------------------------//
-
 	/// @brief Unfilter decompressed image data.
 	/// @param out Pointer to output storage.
 	/// @param in Pointer to decompressed data.
@@ -903,8 +586,8 @@ namespace
 	/// @param height Image height.
 	/// @param bitsPerPixel Image bits per pixel.
 	/// @return True on successful unfiltering, false otherwise.
-	[[nodiscard]] constexpr bool UnFilter(u8* const out, const u8* const in, const u32 width, const u32 height,
-	                                      const u32 bitsPerPixel)
+	[[nodiscard]] bool UnFilter(u8* const out, const u8* const in, const u32 width, const u32 height,
+	                            const u32 bitsPerPixel)
 	{
 		//For PNG Filter Method 0
 		//This function unFilters a single image(e.g. without interlacing this is called once, with Adam7 seven times)
@@ -924,7 +607,7 @@ namespace
 			const usize inIndex = (1 + lineBytes) * y; //The extra filterByte added to each row
 			const u8 filterType = in[inIndex];
 
-			if (!UnFilterScanline(&out[outIndex], &in[inIndex + 1], prevLine, byteWidth, filterType, lineBytes))
+			if (!TRAP::INTERNAL::PNGUnFilterScanline(&out[outIndex], &in[inIndex + 1], prevLine, byteWidth, filterType, lineBytes))
 				return false;
 
 			prevLine = &out[outIndex];
@@ -1017,42 +700,171 @@ namespace
 
 	//-------------------------------------------------------------------------------------------------------------------//
 
+	/// @brief Interleave two rows of pixels, starting with a pixel from even.
+	/// @tparam BW Bytes per pixel.
+	/// @param out Output for the interleaved pixels.
+	/// @param even Pixels for the even positions, (count + 1) / 2 pixels.
+	/// @param odd Pixels for the odd positions, count / 2 pixels.
+	/// @param count Amount of pixels to output.
+	template<usize BW>
+	void InterleavePixels(u8* out, const u8* even, const u8* odd, const usize count) noexcept
+	{
+		usize pairs = count / 2u;
+
+		if constexpr(BW == 1u || BW == 2u || BW == 4u || BW == 8u)
+		{
+			//SSE2 is part of x86-64, no runtime check needed
+			static constexpr usize PixelsPerVector = 16u / BW;
+
+			for(; pairs >= PixelsPerVector; pairs -= PixelsPerVector)
+			{
+				const __m128i e = _mm_loadu_si128(reinterpret_cast<const __m128i*>(even));
+				const __m128i o = _mm_loadu_si128(reinterpret_cast<const __m128i*>(odd));
+
+				__m128i low{}, high{};
+				if constexpr(BW == 1u)
+				{
+					low = _mm_unpacklo_epi8(e, o);
+					high = _mm_unpackhi_epi8(e, o);
+				}
+				else if constexpr(BW == 2u)
+				{
+					low = _mm_unpacklo_epi16(e, o);
+					high = _mm_unpackhi_epi16(e, o);
+				}
+				else if constexpr(BW == 4u)
+				{
+					low = _mm_unpacklo_epi32(e, o);
+					high = _mm_unpackhi_epi32(e, o);
+				}
+				else
+				{
+					low = _mm_unpacklo_epi64(e, o);
+					high = _mm_unpackhi_epi64(e, o);
+				}
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out), low);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16u), high);
+				out += 32u;
+				even += 16u;
+				odd += 16u;
+			}
+		}
+
+		for(; pairs != 0u; --pairs)
+		{
+			std::memcpy(out, even, BW);
+			std::memcpy(out + BW, odd, BW);
+			out += 2u * BW;
+			even += BW;
+			odd += BW;
+		}
+
+		if((count & 1u) != 0u)
+			std::memcpy(out, even, BW);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Deinterlace an Adam7 interlaced image.
+	/// @tparam BW Bytes per pixel.
+	/// @param out Same pixels as in, but re-ordered so that they are now a non-interlaced image with size width * height.
+	/// @param in Adam7 interlaced image, with no padding between scanlines or reduced images.
+	/// @param width Image width.
+	/// @param height Image height.
+	/// @param passW Width of the 7 passes.
+	/// @param passStart Index of the start of each reduced image.
+	template<usize BW>
+	void Adam7DeInterlace(u8* const out, const u8* const in, const u32 width, const u32 height,
+	                      const std::array<u32, 7>& passW, const std::array<usize, 8>& passStart)
+	{
+		//The image gets merged row by row instead of scattering every pass pixel by pixel:
+		//Odd rows are a row of pass 7.
+		//Even rows alternate between an even column pixel and a pixel from pass 6.
+		//The even columns are a row of pass 5, or for every 4th row alternate between
+		//every 4th column (pass 3, or pass 1 and 2 alternating for every 8th row) and pass 4.
+		const auto passRow = [in, &passW, &passStart](const u32 pass, const u32 row)
+		{
+			return in + passStart[pass] + NumericCast<usize>(row) * passW[pass] * BW;
+		};
+
+		const usize lineBytes = NumericCast<usize>(width) * BW;
+		std::vector<u8> everyFourthColumn((width + 3u) / 4u * BW);
+		std::vector<u8> evenColumns((width + 1u) / 2u * BW);
+
+		for(u32 y = 0; y < height; ++y)
+		{
+			u8* const outRow = out + y * lineBytes;
+
+			if((y & 1u) != 0u)
+			{
+				std::copy_n(passRow(6, y / 2u), lineBytes, outRow);
+				continue;
+			}
+
+			const u8* even = nullptr;
+			if((y & 3u) == 2u)
+				even = passRow(4, y / 4u);
+			else
+			{
+				const u8* quarter = nullptr;
+				if((y & 7u) == 4u)
+					quarter = passRow(2, y / 8u);
+				else
+				{
+					InterleavePixels<BW>(everyFourthColumn.data(), passRow(0, y / 8u), passRow(1, y / 8u), (width + 3u) / 4u);
+					quarter = everyFourthColumn.data();
+				}
+
+				InterleavePixels<BW>(evenColumns.data(), quarter, passRow(3, y / 4u), (width + 1u) / 2u);
+				even = evenColumns.data();
+			}
+
+			InterleavePixels<BW>(outRow, even, passRow(5, y / 2u), width);
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
 	/// @brief Deinterlace an Adam7 interlaced image.
 	/// @param out Same pixels as in, but re-ordered so that they are now a non-interlaced image with size width * height.
 	/// @param in Adam7 interlaced image, with no padding bits between scanlines, but between reduced images so that each reduced image starts at a byte.
 	/// @param width Image width.
 	/// @param height Image height.
 	/// @param bitsPerPixel Image bits per pixel.
-	constexpr void Adam7DeInterlace(u8* const out, const u8* const in, const u32 width, const u32 height, const u32 bitsPerPixel)
+	void Adam7DeInterlace(u8* const out, const u8* const in, const u32 width, const u32 height, const u32 bitsPerPixel)
 	{
 		//out has the following size in bits: width * height * bitsPerPixel.
 		//in is possibly bigger due to padding bits between reduced images.
-		//out must be big enough AND must be 0 everywhere
-		//if bitsPerPixel < 8 in the current implementation(because that is likely a little bit faster)
-		//NOTE: Comments about padding bits are only relevant if bitsPerPixel < 8
+		//NOTE: Images with bitsPerPixel < 8 are not supported
 
 		std::array<u32, 7> passW{}, passH{};
 		std::array<usize, 8> filterPassStart{}, paddedPassStart{}, passStart{};
 
 		Adam7GetPassValues(passW, passH, filterPassStart, paddedPassStart, passStart, width, height, bitsPerPixel);
 
-		if(bitsPerPixel < 8)
-			return;
-
-		for (u32 i = 0; i != 7; ++i)
+		switch(bitsPerPixel / 8u)
 		{
-			const usize byteWidth = bitsPerPixel / 8u;
-			for (u32 y = 0; y < passH[i]; ++y)
-			{
-				for (u32 x = 0; x < passW[i]; ++x)
-				{
-					const usize pixelInStart = passStart[i] + (y * passW[i] + x) * byteWidth;
-					const usize pixelOutStart = ((ADAM7_IY[i] + y * ADAM7_DY[i]) *
-													width + ADAM7_IX[i] + x * ADAM7_DX[i]) * byteWidth;
-					for (u32 b = 0; b < byteWidth; ++b)
-						out[pixelOutStart + b] = in[pixelInStart + b];
-				}
-			}
+		case 1:
+			Adam7DeInterlace<1>(out, in, width, height, passW, passStart);
+			break;
+		case 2:
+			Adam7DeInterlace<2>(out, in, width, height, passW, passStart);
+			break;
+		case 3:
+			Adam7DeInterlace<3>(out, in, width, height, passW, passStart);
+			break;
+		case 4:
+			Adam7DeInterlace<4>(out, in, width, height, passW, passStart);
+			break;
+		case 6:
+			Adam7DeInterlace<6>(out, in, width, height, passW, passStart);
+			break;
+		case 8:
+			Adam7DeInterlace<8>(out, in, width, height, passW, passStart);
+			break;
+		default:
+			break;
 		}
 	}
 
@@ -1068,8 +880,8 @@ namespace
 	/// @param interlaceMethod Interlace method.
 	/// @return True on successful post processing, false otherwise.
 	/// @note The in buffer will be overwritten with intermediate data!
-	[[nodiscard]] constexpr bool PostProcessScanlines(u8* const out, u8* const in, const u32 width, const u32 height,
-	                                                  const u32 bitsPerPixel, const u8 interlaceMethod)
+	[[nodiscard]] bool PostProcessScanlines(u8* const out, u8* const in, const u32 width, const u32 height,
+	                                        const u32 bitsPerPixel, const u8 interlaceMethod)
 	{
 		//out must be a buffer big enough to contain full image, and in must contain the full decompressed
 		//data from the IDAT chunks(with filter bytes and possible padding bits)
@@ -1108,33 +920,318 @@ namespace
 
 	//-------------------------------------------------------------------------------------------------------------------//
 
-	/// @brief Convert pixel data to 16 bits per channel with endianness correction.
-	/// @param raw Raw pixel data.
-	/// @return Converted 16 bpc pixel data.
-	[[nodiscard]] constexpr std::vector<u16> ConvertTo2Byte(std::vector<u8>& raw)
+	/// @brief Retrieve the raw/decompressed IDAT byte size of an Adam7 interlaced image.
+	/// @param width Image width.
+	/// @param height Image height.
+	/// @param bitsPerPixel Image bits per pixel.
+	/// @return Raw IDAT size.
+	[[nodiscard]] constexpr usize GetRawSizeIDATAdam7(const u32 width, const u32 height, const u32 bitsPerPixel)
 	{
-		std::vector<u16> result(raw.size() / 2, 0);
-		u32 resultIndex = 0;
-		if constexpr (TRAP::Utils::GetEndian() != TRAP::Utils::Endian::Big)
+		//Expected size is the sum of the 7 sub-images sizes
+		usize expectedSize = 0;
+		expectedSize += GetRawSizeIDAT((width + 7u) >> 3u, (height + 7u) >> 3u, bitsPerPixel);
+		if (width > 4)
+			expectedSize += GetRawSizeIDAT((width + 3u) >> 3u, (height + 7u) >> 3u, bitsPerPixel);
+		expectedSize += GetRawSizeIDAT((width + 3u) >> 2u, (height + 3u) >> 3u, bitsPerPixel);
+		if (width > 2)
+			expectedSize += GetRawSizeIDAT((width + 1u) >> 2u, (height + 3u) >> 2u, bitsPerPixel);
+		expectedSize += GetRawSizeIDAT((width + 1u) >> 1u, (height + 1u) >> 2u, bitsPerPixel);
+		if (width > 1)
+			expectedSize += GetRawSizeIDAT((width + 0u) >> 1u, (height + 1u) >> 1u, bitsPerPixel);
+		expectedSize += GetRawSizeIDAT((width + 0u), (height + 0u) >> 1u, bitsPerPixel);
+
+		return expectedSize;
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Retrieve the bits per pixel of the data stored in IDAT chunks.
+	/// @param colorType PNG color type.
+	/// @param bitDepth PNG bit depth.
+	/// @return Bits per pixel, 0 for invalid color types.
+	[[nodiscard]] constexpr u32 GetBitsPerPixelIDAT(const u8 colorType, const u8 bitDepth)
+	{
+		switch(colorType)
 		{
-			for (u32 i = 0; i < raw.size(); i += 2)
-			{
-				const u16 val = (NumericCast<u16>(raw[i + 1u] << 8u)) | raw[i];
-				result[resultIndex++] = val;
-			}
+		case 0: //GrayScale
+			[[fallthrough]];
+		case 3: //Indexed Color
+			return bitDepth;
+
+		case 2: //TrueColor
+			return 3u * bitDepth;
+
+		case 4: //GrayScale Alpha
+			return 2u * bitDepth;
+
+		case 6: //TrueColor Alpha
+			return 4u * bitDepth;
+
+		default:
+			return 0;
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Check the zlib header preceding the compressed image data.
+	/// @param header zlib header.
+	/// @return True if the header is valid for PNG, false otherwise.
+	[[nodiscard]] bool CheckZLibHeader(const std::array<u8, 2>& header)
+	{
+		ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None &&
+												 (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+		if ((std::get<0>(header) * 256 + std::get<1>(header)) % 31 != 0)
+		{
+			TP_ERROR(TRAP::Log::ImagePNGPrefix, "Decompression failed! 256 * source[0](", std::get<0>(header), ") + source[1](",
+				std::get<1>(header), ") must be a multiple of 31(", NumericCast<u32>(std::get<0>(header) * 256 + std::get<1>(header)), ")!");
+			TP_WARN(TRAP::Log::ImagePNGPrefix, "Using default image!");
+			return false; //Error: 256 * source[0] + source[1] must be a multiple of 31, the FCHECK value is supposed to be made this way
+		}
+
+		const u32 CM = std::get<0>(header) & 15u;
+		const u32 CINFO = (std::get<0>(header) >> 4u) & 15u;
+		//FCHECK = source[1] & 31u; //FCHECK is already tested above
+		const u32 FDICT = (std::get<1>(header) >> 5u) & 1u;
+		//FLEVEL = (source[1] >> 6u) & 3u; //FLEVEL is not used here
+
+		if (CM != 8 || CINFO > 7)
+		{
+			TP_ERROR(TRAP::Log::ImagePNGPrefix, "Decompression failed! Only compression method 8(De/Inflate) with ",
+										"sliding window of 32K is supported by the PNG specification!");
+			TP_WARN(TRAP::Log::ImagePNGPrefix, "Using default image!");
+			return false; //Error: Only compression method 8: inflate with sliding window of 32K is supported by the PNG specification
+		}
+		if(FDICT != 0)
+		{
+			TP_ERROR(TRAP::Log::ImagePNGPrefix, "Decompression failed! Additional flags should ",
+										"not specify a preset dictionary!");
+			TP_WARN(TRAP::Log::ImagePNGPrefix, "Using default image!");
+			return false; //Error: The PNG specification says that the zlib stream should not specify a preset dictionary in the additional flags!
+		}
+
+		return true;
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Prepare decoding of the image data.
+	///        Called before the first IDAT chunk gets processed, the IHDR chunk is already known at this point.
+	/// @param data Data containing information about the image.
+	/// @return True on success, false otherwise.
+	[[nodiscard]] bool InitIDATDecoder(Data& data)
+	{
+		ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None &&
+												 (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+		IDATDecoder& decoder = data.Decoder;
+
+		decoder.BitsPerPixel = GetBitsPerPixelIDAT(data.ColorType, data.BitDepth);
+		if(decoder.BitsPerPixel == 0)
+		{
+			TP_ERROR(TRAP::Log::ImagePNGPrefix, "Color type ", data.ColorType, " is invalid!");
+			TP_WARN(TRAP::Log::ImagePNGPrefix, "Using default image!");
+			return false;
+		}
+
+		//ByteWidth is used for filtering, is 1 when bitsPerPixel < 8, number of bytes per pixel otherwise
+		decoder.ByteWidth = (decoder.BitsPerPixel + 7u) / 8u;
+		decoder.LineBytes = (NumericCast<usize>(data.Width) * decoder.BitsPerPixel + 7u) / 8u;
+
+		if(data.InterlaceMethod == 0)
+		{
+			//Scanlines are unfiltered as soon as they are decompressed, so only one filtered scanline is kept
+			decoder.Filtered.resize(1u + decoder.LineBytes);
+			decoder.Raw.resize(decoder.LineBytes * data.Height);
 		}
 		else
+			decoder.Filtered.resize(GetRawSizeIDATAdam7(data.Width, data.Height, decoder.BitsPerPixel));
+
+		return true;
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Decompress as much image data as the IDAT chunks processed so far allow.
+	///        Without interlacing every completed scanline gets unfiltered right away.
+	/// @param data Data containing information about the image.
+	/// @return True on success, false otherwise.
+	[[nodiscard]] bool DecodeIDAT(Data& data)
+	{
+		ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+		IDATDecoder& decoder = data.Decoder;
+
+		while(true)
 		{
-			for (u32 i = 0; i < raw.size(); i += 2)
+			const std::span<u8> remaining = std::span(decoder.Filtered).subspan(decoder.FilteredPos);
+			const usize written = decoder.Inflater.Inflate(remaining);
+			decoder.Adler32.Update(remaining.first(written));
+			decoder.FilteredPos += written;
+
+			if(decoder.Inflater.GetStatus() == TRAP::Utils::Decompress::Inflater::Status::Error)
 			{
-				const u16 val = (NumericCast<u16>(raw[i + 1u] << 8u)) | raw[i];
-				result[resultIndex++] = val;
+				TP_ERROR(TRAP::Log::ImagePNGPrefix, "Decompression failed! Inflate error!");
+				TP_WARN(TRAP::Log::ImagePNGPrefix, "Using default image!");
+				return false;
 			}
 
-			for (u16& i : result)
-				TRAP::Utils::Memory::SwapBytes(i);
+			//Needs more input or all expected data was decompressed
+			if(decoder.FilteredPos != decoder.Filtered.size() || data.InterlaceMethod != 0 ||
+			   decoder.NextScanline == data.Height)
+			{
+				return true;
+			}
+
+			//Scanline complete, unfilter it directly into the pixel data
+			u8* const recon = decoder.Raw.data() + decoder.LineBytes * decoder.NextScanline;
+			const u8* const precon = (decoder.NextScanline == 0) ? nullptr : recon - decoder.LineBytes;
+			if(!TRAP::INTERNAL::PNGUnFilterScanline(recon, &decoder.Filtered[1], precon, decoder.ByteWidth,
+			                                        decoder.Filtered[0], decoder.LineBytes))
+			{
+				TP_ERROR(TRAP::Log::ImagePNGPrefix, "Filter type ", NumericCast<u32>(decoder.Filtered[0]), " is invalid!");
+				TP_WARN(TRAP::Log::ImagePNGPrefix, "Using default image!");
+				return false;
+			}
+
+			++decoder.NextScanline;
+			if(decoder.NextScanline != data.Height)
+				decoder.FilteredPos = 0;
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Process the IDAT chunk.
+	/// IDAT contains the image data.
+	/// The data gets decompressed right away, so the compressed data of all IDAT chunks never needs to be kept in memory.
+	/// @param reader Reader positioned at the chunk data.
+	/// @param data Data containing information about the image.
+	/// @param length Chunk length.
+	/// @return True if the chunk was processed successfully, false otherwise.
+	[[nodiscard]] bool ProcessIDAT(TRAP::Utils::ByteReader& reader, Data& data, const u32 length)
+	{
+		ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None &&
+												 (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+		//Chunk data is used in place, without copying it
+		const std::span<const u8> compressedData = reader.ReadSpan(length).ValueOr(std::span<const u8>{});
+		std::array<u8, 4> CRC{};
+		reader.Read(CRC);
+
+		TRAP::Utils::Hash::CRC32Hasher hasher{};
+		hasher.Update("IDAT");
+		hasher.Update(compressedData);
+		const std::array<u8, 4> crc = hasher.Finalize();
+		if(crc != CRC)
+		{
+			TP_ERROR(TRAP::Log::ImagePNGPrefix, "IDAT CRC: ", TRAP::Utils::Hash::ConvertHashToString(CRC), " is wrong!");
+			TP_WARN(TRAP::Log::ImagePNGPrefix, "Using default image!");
+			return false;
+		}
+
+		IDATDecoder& decoder = data.Decoder;
+		if(decoder.BitsPerPixel == 0 && !InitIDATDecoder(data))
+			return false;
+
+		//The 2 byte zlib header precedes the deflate stream
+		std::span<const u8> input = compressedData;
+		if(decoder.ZLibHeaderSize < decoder.ZLibHeader.size())
+		{
+			const usize count = TRAP::Math::Min(decoder.ZLibHeader.size() - decoder.ZLibHeaderSize, input.size());
+			std::copy_n(input.begin(), count, decoder.ZLibHeader.begin() + NumericCast<isize>(decoder.ZLibHeaderSize));
+			decoder.ZLibHeaderSize += count;
+			input = input.subspan(count);
+
+			if(decoder.ZLibHeaderSize < decoder.ZLibHeader.size())
+				return true;
+			if(!CheckZLibHeader(decoder.ZLibHeader))
+				return false;
+		}
+
+		decoder.Inflater.AppendInput(input);
+
+		return DecodeIDAT(data);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Finish decoding of the image data after all IDAT chunks were processed.
+	/// @param data Data containing information about the image.
+	/// @return True if the complete image data was decompressed successfully, false otherwise.
+	[[nodiscard]] bool FinishIDAT(Data& data)
+	{
+		ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+		IDATDecoder& decoder = data.Decoder;
+
+		if (decoder.ZLibHeaderSize < decoder.ZLibHeader.size())
+		{
+			TP_ERROR(TRAP::Log::ImagePNGPrefix, "Compressed zlib data is too small!");
+			TP_WARN(TRAP::Log::ImagePNGPrefix, "Using default image!");
+			return false; //Error, size of zlib data too small
+		}
+
+		decoder.Inflater.FinishInput();
+		if(!DecodeIDAT(data))
+			return false;
+
+		const bool complete = decoder.FilteredPos == decoder.Filtered.size() &&
+		                      (data.InterlaceMethod != 0 || decoder.NextScanline == data.Height);
+		//Lets the inflater reach the end of the stream, any output here means there is more data than expected
+		std::array<u8, 1> excess{};
+		if(!complete || decoder.Inflater.Inflate(excess) != 0 ||
+		   decoder.Inflater.GetStatus() != TRAP::Utils::Decompress::Inflater::Status::Done)
+		{
+			TP_ERROR(TRAP::Log::ImagePNGPrefix, "Decompression failed! Decompressed data has an unexpected size!");
+			TP_WARN(TRAP::Log::ImagePNGPrefix, "Using default image!");
+			return false;
+		}
+
+		const std::span<const u8> trailer = decoder.Inflater.GetTrailingInput();
+		if(trailer.size() < 4)
+		{
+			TP_ERROR(TRAP::Log::ImagePNGPrefix, "Compressed zlib data is too small!");
+			TP_WARN(TRAP::Log::ImagePNGPrefix, "Using default image!");
+			return false; //Error, Adler32 checksum is missing
+		}
+
+		const std::array<u8, 4> adler32 =
+		{
+			trailer[0],
+			trailer[1],
+			trailer[2],
+			trailer[3]
+		};
+		const std::array<u8, 4> checksum = decoder.Adler32.Finalize();
+
+		if(checksum != adler32)
+		{
+			TP_ERROR(TRAP::Log::ImagePNGPrefix, "Decompression failed! Adler32 checksum: ",
+										        TRAP::Utils::Hash::ConvertHashToString(adler32),
+										        " doesnt match checksum: ",
+												TRAP::Utils::Hash::ConvertHashToString(checksum), "!");
+			TP_WARN(TRAP::Log::ImagePNGPrefix, "Using default image!");
+			return false; //Error: Adler checksum not correct, data must be corrupt
 		}
 
+		return true;
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Convert pixel data to 16 bits per channel with endianness correction.
+	/// @param raw Raw pixel data.
+	/// @return Converted 16 bpc pixel data.
+	[[nodiscard]] constexpr std::vector<u16> ConvertTo2Byte(std::vector<u8>& raw)
+	{
+		std::vector<u16> result(raw.size() / 2, 0);
+
+		//PNG stores 16 bit values in big endian
+		for (usize i = 0; i < result.size(); ++i)
+			result[i] = NumericCast<u16>((raw[i * 2u] << 8u) | raw[i * 2u + 1u]);
+
 		return result;
 	}
 
@@ -1172,18 +1269,18 @@ namespace
 
 	/// @brief Process a PNG chunk.
 	/// @param nextChunk Length and magic number of the next chunk to process.
-	/// @param file Open PNG file.
+	/// @param reader Reader positioned at the chunk data.
 	/// @param data Data containing information about the image.
 	/// @param alreadyLoaded Flags to indicate which chunks have already been loaded.
 	/// @return True if the chunk was processed successfully, false otherwise.
-	[[nodiscard]] bool ProcessChunk(NextChunk& nextChunk, std::ifstream& file, Data& data, AlreadyLoaded& alreadyLoaded)
+	[[nodiscard]] bool ProcessChunk(NextChunk& nextChunk, TRAP::Utils::ByteReader& reader, Data& data, AlreadyLoaded& alreadyLoaded)
 	{
 		ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
 
 		if (nextChunk.MagicNumber == "IHDR" && !alreadyLoaded.IHDR)
 		{
 			alreadyLoaded.IHDR = true;
-			if (ProcessIHDR(file, data))
+			if (ProcessIHDR(reader, data))
 				return true;
 		}
 
@@ -1196,41 +1293,41 @@ namespace
 			if(unusedChunk)
 			{
 				//Optional chunk (ignored)
-				file.seekg(4 + nextChunk.Length, std::ios_base::cur); //4 = Magic number.
+				reader.Skip(4u + nextChunk.Length); //4 = Magic number.
 				return true;
 			}
 
 			if (nextChunk.MagicNumber == "sBIT" && !alreadyLoaded.PLTE && !alreadyLoaded.IDAT)
 			{
-				if (ProcesssBIT(file, data))
+				if (ProcesssBIT(reader, data))
 					return true;
 			}
 			if (nextChunk.MagicNumber == "sRGB" && !alreadyLoaded.sRGB && !alreadyLoaded.PLTE &&
 				!alreadyLoaded.IDAT)
 			{
 				alreadyLoaded.sRGB = true;
-				if (ProcesssRGB(file))
+				if (ProcesssRGB(reader))
 					return true;
 			}
 			if (nextChunk.MagicNumber == "bKGD" && !alreadyLoaded.IDAT)
 			{
-				if (ProcessbKGD(file, data))
+				if (ProcessbKGD(reader, data))
 					return true;
 			}
 			if (nextChunk.MagicNumber == "tRNS" && !alreadyLoaded.tRNS && !alreadyLoaded.IDAT)
 			{
 				alreadyLoaded.tRNS = true;
-				if (ProcesstRNS(file, nextChunk.Length, data))
+				if (ProcesstRNS(reader, nextChunk.Length, data))
 					return true;
 			}
 			if (nextChunk.MagicNumber == "PLTE" && !alreadyLoaded.PLTE && !alreadyLoaded.IDAT)
 			{
-				if (ProcessPLTE(file, data, nextChunk.Length))
+				if (ProcessPLTE(reader, data, nextChunk.Length))
 					return true;
 			}
 			if (nextChunk.MagicNumber == "IDAT")
 			{
-				if (ProcessIDAT(file, data, nextChunk.Length))
+				if (ProcessIDAT(reader, data, nextChunk.Length))
 					return true;
 			}
 			if (nextChunk.MagicNumber == "IEND")
@@ -1241,6 +1338,95 @@ namespace
 		TP_WARN(TRAP::Log::ImagePNGPrefix, "Using default image!");
 		return false;
 	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Append a chunk to the given PNG data.
+	/// @param out PNG data to append to.
+	/// @param type Chunk type.
+	/// @param data Chunk data.
+	void WritePNGChunk(std::vector<u8>& out, const std::string_view type, const std::span<const u8> data)
+	{
+		const u32 length = NumericCast<u32>(data.size());
+		out.insert(out.end(),
+		{
+			TRAP::Utils::Memory::GetByteFromInteger<3>(length),
+			TRAP::Utils::Memory::GetByteFromInteger<2>(length),
+			TRAP::Utils::Memory::GetByteFromInteger<1>(length),
+			TRAP::Utils::Memory::GetByteFromInteger<0>(length)
+		});
+
+		const usize typeStart = out.size();
+		out.insert(out.end(), type.begin(), type.end());
+		out.insert(out.end(), data.begin(), data.end());
+
+		//CRC covers the chunk type and data
+		const std::array<u8, 4> crc = TRAP::Utils::Hash::CRC32(out.data() + typeStart, out.size() - typeStart);
+		out.insert(out.end(), crc.begin(), crc.end());
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Filter all scanlines of an image for PNG encoding.
+	///        Every scanline uses the filter type with the smallest sum of absolute differences,
+	///        which usually compresses best. Without compression no filter is applied.
+	/// @param pixels Pixel data in PNG byte order (i.e. 16 bit values in big endian).
+	/// @param width Width of the image.
+	/// @param height Height of the image.
+	/// @param bytesPerPixel Bytes per pixel.
+	/// @param level Compression level.
+	/// @return Filtered scanlines, each one starts with its filter type.
+	[[nodiscard]] std::vector<u8> FilterScanlines(const std::span<const u8> pixels, const u32 width, const u32 height,
+	                                              const usize bytesPerPixel, const TRAP::Utils::Compress::CompressionLevel level)
+	{
+		ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+		const usize lineBytes = NumericCast<usize>(width) * bytesPerPixel;
+		std::vector<u8> filtered((lineBytes + 1u) * height);
+
+		std::array<std::vector<u8>, 5> candidates{};
+		for(auto& candidate : candidates)
+			candidate.resize(lineBytes);
+
+		for(usize y = 0; y < height; ++y)
+		{
+			const u8* const scanline = pixels.data() + y * lineBytes;
+			const u8* const prevline = y == 0u ? nullptr : scanline - lineBytes;
+			u8* const out = filtered.data() + y * (lineBytes + 1u);
+
+			if(level == TRAP::Utils::Compress::CompressionLevel::None)
+			{
+				out[0] = 0;
+				std::copy_n(scanline, lineBytes, out + 1u);
+				continue;
+			}
+
+			u8 bestFilterType = 0;
+			u64 bestSum = std::numeric_limits<u64>::max();
+			for(u8 filterType = 0; filterType < candidates.size(); ++filterType)
+			{
+				std::vector<u8>& candidate = candidates[filterType];
+				if(!TRAP::INTERNAL::PNGFilterScanline(candidate.data(), scanline, prevline, bytesPerPixel, filterType, lineBytes))
+					continue;
+
+				//Sum of the filtered bytes interpreted as signed values
+				u64 sum = 0;
+				for(const u8 b : candidate)
+					sum += b < 128u ? b : 256u - b;
+
+				if(sum < bestSum)
+				{
+					bestSum = sum;
+					bestFilterType = filterType;
+				}
+			}
+
+			out[0] = bestFilterType;
+			std::ranges::copy(candidates[bestFilterType], out + 1u);
+		}
+
+		return filtered;
+	}
 }
 
 //-------------------------------------------------------------------------------------------------------------------//
@@ -1255,17 +1441,40 @@ TRAP::INTERNAL::PNGImage::PNGImage(std::filesystem::path filepath)
 	if (!FileSystem::Exists(m_filepath))
 		return;
 
-	std::ifstream file(m_filepath, std::ios::binary);
-	if (!file.is_open())
+	const auto file = FileSystem::MapFile(m_filepath);
+	if (!file)
 	{
 		TP_ERROR(Log::ImagePNGPrefix, "Couldn't open file path: ", m_filepath, "!");
 		TP_WARN(Log::ImagePNGPrefix, "Using default image!");
 		return;
 	}
 
+	Decode(file->GetData());
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+TRAP::INTERNAL::PNGImage::PNGImage(const std::span<const u8> data)
+	: Image("")
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	TP_DEBUG(Log::ImagePNGPrefix, "Loading image from memory");
+
+	Decode(data);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::INTERNAL::PNGImage::Decode(const std::span<const u8> encodedData)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	Utils::ByteReader reader(encodedData);
+
 	//Read in MagicNumber
 	std::array<u8, 8> MagicNumber{};
-	file.read(reinterpret_cast<char*>(MagicNumber.data()), MagicNumber.size() * sizeof(u8));
+	reader.Read(MagicNumber);
 
 	//Check MagicNumber
 	if (std::get<0>(MagicNumber) != 0x89 || std::get<1>(MagicNumber) != 0x50 ||
@@ -1273,7 +1482,6 @@ TRAP::INTERNAL::PNGImage::PNGImage(std::filesystem::path filepath)
 		std::get<4>(MagicNumber) != 0x0D || std::get<5>(MagicNumber) != 0x0A ||
 		std::get<6>(MagicNumber) != 0x1A || std::get<7>(MagicNumber) != 0x0A)
 	{
-		file.close();
 		std::string mNum{};
 		for (const auto& i : MagicNumber)
 			mNum += std::to_string(i);
@@ -1290,35 +1498,35 @@ TRAP::INTERNAL::PNGImage::PNGImage(std::filesystem::path filepath)
 		AlreadyLoaded alreadyLoaded{};
 		while (nextChunk.MagicNumber != "IEND")
 		{
-			file.read(reinterpret_cast<char*>(&nextChunk.Length), sizeof(u32));
-			file.read(nextChunk.MagicNumber.data(), NumericCast<std::streamsize>(nextChunk.MagicNumber.size()));
+			reader.Read(nextChunk.Length);
+			reader.Read(Utils::AsWritableBytes(std::span(nextChunk.MagicNumber)));
+			if (reader.HasFailed())
+			{
+				TP_ERROR(Log::ImagePNGPrefix, "Unexpected end of file!");
+				TP_WARN(Log::ImagePNGPrefix, "Using default image!");
+				return;
+			}
 			if constexpr (Utils::GetEndian() != Utils::Endian::Big)
 				Utils::Memory::SwapBytes(nextChunk.Length);
 
 			if (nextChunk.Length > 2147483647)
 			{
-				file.close();
 				TP_ERROR(Log::ImagePNGPrefix, "Chunk length ", nextChunk.Length, " is invalid!");
 				TP_WARN(Log::ImagePNGPrefix, "Using default image!");
 				return;
 			}
 
-			if (!ProcessChunk(nextChunk, file, data, alreadyLoaded))
-			{
-				file.close();
+			if (!ProcessChunk(nextChunk, reader, data, alreadyLoaded))
 				return;
-			}
 		}
 		if (nextChunk.Length > std::numeric_limits<i32>::max())
 		{
-			file.close();
 			TP_ERROR(Log::ImagePNGPrefix, "Chunk length ", nextChunk.Length, " is invalid!");
 			TP_WARN(Log::ImagePNGPrefix, "Using default image!");
 			return;
 		}
 	}
 
-	file.close();
 
 	m_width = data.Width;
 	m_height = data.Height;
@@ -1417,41 +1625,22 @@ TRAP::INTERNAL::PNGImage::PNGImage(std::filesystem::path filepath)
 		TP_WARN(Log::ImagePNGPrefix, "Using default image!");
 		return;
 	}
-	std::vector<u8> decompressedData{};
-
-	if (data.InterlaceMethod == 0)
-		decompressedData.resize(GetRawSizeIDAT(m_width, m_height, m_bitsPerPixel));
-	else if (data.InterlaceMethod == 1)
-	{
-		//Adam7 Interlaced: Expected size is the sum of the 7 sub-images sizes
-		usize expectedSize = 0;
-		expectedSize += GetRawSizeIDAT((m_width + 7u) >> 3u, (m_height + 7u) >> 3u, m_bitsPerPixel);
-		if (m_width > 4)
-			expectedSize += GetRawSizeIDAT((m_width + 3u) >> 3u, (m_height + 7u) >> 3u, m_bitsPerPixel);
-		expectedSize += GetRawSizeIDAT((m_width + 3u) >> 2u, (m_height + 3u) >> 3u, m_bitsPerPixel);
-		if (m_width > 2)
-			expectedSize += GetRawSizeIDAT((m_width + 1u) >> 2u, (m_height + 3u) >> 2u, m_bitsPerPixel);
-		expectedSize += GetRawSizeIDAT((m_width + 1u) >> 1u, (m_height + 1u) >> 2u, m_bitsPerPixel);
-		if (m_width > 1)
-			expectedSize += GetRawSizeIDAT((m_width + 0u) >> 1u, (m_height + 1u) >> 1u, m_bitsPerPixel);
-		expectedSize += GetRawSizeIDAT((m_width + 0u), (m_height + 0u) >> 1u, m_bitsPerPixel);
-
-		decompressedData.resize(expectedSize);
-	}
-
-	if (!DecompressData(data.CompressedData, decompressedData))
-	{
-		decompressedData.clear();
+	if (!FinishIDAT(data))
 		return;
-	}
 
-	std::vector<u8> raw(GetRawSize(m_width, m_height, m_bitsPerPixel), 0);
-	if (!PostProcessScanlines(raw.data(), decompressedData.data(), m_width, m_height, m_bitsPerPixel,
-	                          data.InterlaceMethod))
+	std::vector<u8> raw{};
+	if (data.InterlaceMethod == 0)
+		raw = std::move(data.Decoder.Raw); //Already unfiltered while reading the IDAT chunks
+	else
 	{
-		TP_ERROR(Log::ImagePNGPrefix, "Deinterlacing failed!");
-		TP_WARN(Log::ImagePNGPrefix, "Using default image!");
-		return;
+		raw.resize(GetRawSize(m_width, m_height, m_bitsPerPixel), 0);
+		if (!PostProcessScanlines(raw.data(), data.Decoder.Filtered.data(), m_width, m_height, m_bitsPerPixel,
+		                          data.InterlaceMethod))
+		{
+			TP_ERROR(Log::ImagePNGPrefix, "Deinterlacing failed!");
+			TP_WARN(Log::ImagePNGPrefix, "Using default image!");
+			return;
+		}
 	}
 
 	switch (data.ColorType)
@@ -1527,3 +1716,109 @@ TRAP::INTERNAL::PNGImage::PNGImage(std::filesystem::path filepath)
 		break;
 	}
 }
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] std::vector<u8> TRAP::INTERNAL::PNGImage::Encode(const Image* const img, const Utils::Compress::CompressionLevel level)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	TRAP_ASSERT(img != nullptr, "PNGImage::Encode(): Image is nullptr!");
+
+	if(img->IsHDR())
+	{
+		TP_ERROR(Log::ImagePNGPrefix, "HDR images can't be saved as PNG!");
+		return {};
+	}
+
+	u8 colorType = 0;
+	switch(img->GetColorFormat())
+	{
+	case ColorFormat::GrayScale:
+		colorType = 0;
+		break;
+	case ColorFormat::GrayScaleAlpha:
+		colorType = 4;
+		break;
+	case ColorFormat::RGB:
+		colorType = 2;
+		break;
+	case ColorFormat::RGBA:
+		colorType = 6;
+		break;
+	default:
+		TP_ERROR(Log::ImagePNGPrefix, "Unsupported color format!");
+		return {};
+	}
+
+	const u32 width = img->GetWidth();
+	const u32 height = img->GetHeight();
+	const u8 bitDepth = NumericCast<u8>(img->GetBitsPerChannel());
+
+	//PNG stores 16 bit values in big endian
+	std::span<const u8> pixels = img->GetPixelData();
+	std::vector<u8> swappedPixels{};
+	if(bitDepth == 16u && Utils::GetEndian() != Utils::Endian::Big)
+	{
+		swappedPixels.resize(pixels.size());
+		for(usize i = 0; i + 1u < pixels.size(); i += 2u)
+		{
+			swappedPixels[i] = pixels[i + 1u];
+			swappedPixels[i + 1u] = pixels[i];
+		}
+		pixels = swappedPixels;
+	}
+
+	const std::vector<u8> filtered = FilterScanlines(pixels, width, height, img->GetBytesPerPixel(), level);
+	const std::vector<u8> compressed = Utils::Compress::ZlibCompress(filtered, level);
+
+	static constexpr std::array<u8, 8> PNGSignature{0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A};
+
+	std::vector<u8> result(PNGSignature.begin(), PNGSignature.end());
+	result.reserve(compressed.size() + 64u);
+
+	const std::array<u8, 13> ihdr
+	{
+		Utils::Memory::GetByteFromInteger<3>(width),
+		Utils::Memory::GetByteFromInteger<2>(width),
+		Utils::Memory::GetByteFromInteger<1>(width),
+		Utils::Memory::GetByteFromInteger<0>(width),
+		Utils::Memory::GetByteFromInteger<3>(height),
+		Utils::Memory::GetByteFromInteger<2>(height),
+		Utils::Memory::GetByteFromInteger<1>(height),
+		Utils::Memory::GetByteFromInteger<0>(height),
+		bitDepth, colorType,
+		0, //Compression method
+		0, //Filter method
+		0  //Interlace method
+	};
+	WritePNGChunk(result, "IHDR", ihdr);
+
+	//Split the image data into multiple IDAT chunks to keep the chunks at a reasonable size
+	static constexpr usize MaxIDATSize = 1u << 20u;
+	std::span<const u8> remaining = compressed;
+	do
+	{
+		const usize size = std::min(remaining.size(), MaxIDATSize);
+		WritePNGChunk(result, "IDAT", remaining.first(size));
+		remaining = remaining.subspan(size);
+	} while(!remaining.empty());
+
+	WritePNGChunk(result, "IEND", {});
+
+	return result;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+bool TRAP::INTERNAL::PNGImage::Save(const Image* const img, const std::filesystem::path& filepath,
+                                    const Utils::Compress::CompressionLevel level)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	const std::vector<u8> encoded = Encode(img, level);
+	if(encoded.empty())
+		return false;
+
+	return FileSystem::WriteFile(filepath, encoded);
+}
@@ -31,6 +31,7 @@ Modified by Jan "GamesTrap" Schuerkamp
 #include <array>
 
 #include "ImageLoader/Image.h"
+#include "Utils/Compress/Deflate.h"
 
 namespace TRAP::INTERNAL
 {
@@ -40,6 +41,9 @@ namespace TRAP::INTERNAL
 		/// @brief Constructor.
 		/// @param filepath File path of the image to load.
 		explicit PNGImage(std::filesystem::path filepath);
+		/// @brief Constructor.
+		/// @param data Encoded image data to load.
+		explicit PNGImage(std::span<const u8> data);
 		/// @brief Copy constructor.
 		PNGImage(const PNGImage&) noexcept = default;
 		/// @brief Copy assignment operator.
@@ -55,7 +59,25 @@ namespace TRAP::INTERNAL
 		/// @return Raw pixel data.
 		[[nodiscard]] constexpr std::span<const u8> GetPixelData() const noexcept override;
 
+		/// @brief Encode an TRAP::Image as Portable Network Graphics (PNG).
+		/// @param img Image to encode, HDR images are not supported.
+		/// @param level Compression level to use.
+		/// @return Encoded image on success, empty vector otherwise.
+		[[nodiscard]] static std::vector<u8> Encode(const Image* img,
+		                                            Utils::Compress::CompressionLevel level = Utils::Compress::CompressionLevel::Fast);
+		/// @brief Save an TRAP::Image as a Portable Network Graphics (PNG) file.
+		/// @param img Image to save, HDR images are not supported.
+		/// @param filepath File path to save the image to.
+		/// @param level Compression level to use.
+		/// @return True on success, false otherwise.
+		static bool Save(const Image* img, const std::filesystem::path& filepath,
+		                 Utils::Compress::CompressionLevel level = Utils::Compress::CompressionLevel::Fast);
+
 	private:
+		/// @brief Decode the image.
+		/// @param encodedData Encoded image data.
+		void Decode(std::span<const u8> encodedData);
+
 		std::vector<u8> m_data;
 		std::vector<u16> m_data2Byte;
 	};
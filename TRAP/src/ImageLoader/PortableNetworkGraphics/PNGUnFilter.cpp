@@ -0,0 +1,782 @@
+/*
+LodePNG version 20230410
+
+Copyright (c) 2005-2023 Lode Vandevenne
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+    claim that you wrote the original software. If you use this software
+    in a product, an acknowledgment in the product documentation would be
+    appreciated but is not required.
+
+    2. Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+
+    3. This notice may not be removed or altered from any source
+    distribution.
+
+Modified by Jan "GamesTrap" Schuerkamp
+*/
+
+#include "TRAPPCH.h"
+#include "PNGUnFilter.h"
+
+#include "Maths/Math.h"
+#include "Utils/Utils.h"
+#include "TRAP_Assert.h"
+
+#include <immintrin.h>
+
+namespace
+{
+	/// @brief Paeth predictor used by PNG filter type 4.
+	/// @param a Left pixel.
+	/// @param b Above pixel.
+	/// @param c Above-left pixel.
+	/// @return Predicted pixel.
+	[[nodiscard]] constexpr u8 PaethPredictor(u16 a, const u16 b, const u16 c) noexcept
+	{
+		u16 pa = NumericCast<u16>(TRAP::Math::Abs(b - c));
+		const u16 pb = NumericCast<u16>(TRAP::Math::Abs(a - c));
+		const u16 pc = NumericCast<u16>(TRAP::Math::Abs(a + b - c - c));
+
+		//Return input value associated with smallest of pa, pb, pc(with certain priority if equal)
+		if (pb < pa)
+		{
+			a = b;
+			pa = pb;
+		}
+
+		return NumericCast<u8>((pc < pa) ? c : a);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Unfilter scanline depending on given filter type, one byte at a time.
+	/// @param recon Output for the unfiltered scanline.
+	/// @param scanline Pointer to scanline.
+	/// @param precon Previous unfiltered scanline, nullptr for the first scanline.
+	/// @param byteWidth Width of the scanline in bytes.
+	/// @param filterType Filter type.
+	/// @param length Length of the scanline in bytes.
+	/// @return True if the scanline was unfiltered successfully, false otherwise.
+	[[nodiscard]] constexpr bool UnFilterScanlineScalar(u8* const recon, const u8* const scanline, const u8* const precon,
+	                                                    const usize byteWidth, const u8 filterType, const usize length) noexcept
+	{
+		//For PNG Filter Method 0
+		//UnFilter a PNG Image Scanline by Scanline.
+		//When the pixels are smaller than 1 Byte, the Filter works Byte per Byte (byteWidth = 1)
+		//precon is the previous unFiltered Scanline, recon the result, scanline the current one the incoming
+		//Scanlines do NOT include the FilterType byte, that one is given in the parameter filterType instead
+		//recon and scanline MAY be the same memory address!
+		//precon must be disjoint.
+		usize i = 0;
+		switch (filterType)
+		{
+		case 0:
+		{
+			for (i = 0; i != length; ++i)
+				recon[i] = scanline[i];
+			break;
+		}
+
+		case 1:
+		{
+			usize j = 0;
+			for (i = 0; i != byteWidth; ++i)
+				recon[i] = scanline[i];
+			for (i = byteWidth; i != length; ++i, ++j)
+				recon[i] = scanline[i] + recon[j];
+			break;
+		}
+
+		case 2:
+		{
+			if (precon != nullptr)
+				for (i = 0; i != length; ++i)
+					recon[i] = scanline[i] + precon[i];
+			else
+				for (i = 0; i != length; ++i)
+					recon[i] = scanline[i];
+			break;
+		}
+
+		case 3:
+		{
+			if (precon != nullptr)
+			{
+				usize j = 0;
+
+				for (i = 0; i != byteWidth; ++i)
+					recon[i] = scanline[i] + (precon[i] >> 1u);
+
+				//Unroll independent paths of the Paeth predictor.
+				//A 6x and 8x version is also possible but that adds too much code.
+				//Whether this speeds up anything at all depends on compiler and settings.
+				if(byteWidth >= 4)
+				{
+					for(; i + 3 < length; i += 4, j += 4)
+					{
+						u8 s0 = scanline[i + 0], r0 = recon[j + 0], p0 = precon[i + 0];
+						u8 s1 = scanline[i + 1], r1 = recon[j + 1], p1 = precon[i + 1];
+						u8 s2 = scanline[i + 2], r2 = recon[j + 2], p2 = precon[i + 2];
+						u8 s3 = scanline[i + 3], r3 = recon[j + 3], p3 = precon[i + 3];
+
+						recon[i + 0] = NumericCast<u8>(s0 + ((r0 + p0) >> 1u));
+						recon[i + 1] = NumericCast<u8>(s1 + ((r1 + p1) >> 1u));
+						recon[i + 2] = NumericCast<u8>(s2 + ((r2 + p2) >> 1u));
+						recon[i + 3] = NumericCast<u8>(s3 + ((r3 + p3) >> 1u));
+					}
+				}
+				else if(byteWidth >= 3)
+				{
+					for(; i + 2 < length; i += 3, j += 3)
+					{
+						u8 s0 = scanline[i + 0], r0 = recon[j + 0], p0 = precon[i + 0];
+						u8 s1 = scanline[i + 1], r1 = recon[j + 1], p1 = precon[i + 1];
+						u8 s2 = scanline[i + 2], r2 = recon[j + 2], p2 = precon[i + 2];
+
+						recon[i + 0] = NumericCast<u8>(s0 + ((r0 + p0) >> 1u));
+						recon[i + 1] = NumericCast<u8>(s1 + ((r1 + p1) >> 1u));
+						recon[i + 2] = NumericCast<u8>(s2 + ((r2 + p2) >> 1u));
+					}
+				}
+				else if(byteWidth >= 2)
+				{
+					for(; i + 1 < length; i += 2, j += 2)
+					{
+						u8 s0 = scanline[i + 0], r0 = recon[j + 0], p0 = precon[i + 0];
+						u8 s1 = scanline[i + 1], r1 = recon[j + 1], p1 = precon[i + 1];
+
+						recon[i + 0] = NumericCast<u8>(s0 + ((r0 + p0) >> 1u));
+						recon[i + 1] = NumericCast<u8>(s1 + ((r1 + p1) >> 1u));
+					}
+				}
+
+				for(; i != length; ++i, ++j)
+					recon[i] = NumericCast<u8>(scanline[i] + ((recon[j] + precon[i]) >> 1u));
+			}
+			else
+			{
+				for (i = 0; i != byteWidth; ++i)
+					recon[i] = scanline[i];
+				usize j = 0;
+				for (i = byteWidth; i != length; ++i, ++j)
+					recon[i] = scanline[i] + (recon[j] >> 1u);
+			}
+			break;
+		}
+
+		case 4:
+		{
+			if (precon != nullptr)
+			{
+				usize j = 0;
+
+				for (i = 0; i != byteWidth; ++i)
+					recon[i] = (scanline[i] + precon[i]);
+
+				//Unroll independent paths of the Paeth predictor.
+				//A 6x and 8x version is also possible but that adds too much code.
+				//Whether this speeds up anything at all depends on compiler and settings.
+				if (byteWidth >= 4)
+				{
+					for (; i + 3 < length; i += 4, j += 4)
+					{
+						const u8 s0 = scanline[i + 0], s1 = scanline[i + 1];
+						const u8 s2 = scanline[i + 2], s3 = scanline[i + 3];
+						const u8 r0 = recon[j + 0], r1 = recon[j + 1], r2 = recon[j + 2], r3 = recon[j + 3];
+						const u8 p0 = precon[i + 0], p1 = precon[i + 1], p2 = precon[i + 2], p3 = precon[i + 3];
+						const u8 q0 = precon[j + 0], q1 = precon[j + 1], q2 = precon[j + 2], q3 = precon[j + 3];
+						recon[i + 0] = s0 + PaethPredictor(r0, p0, q0);
+						recon[i + 1] = s1 + PaethPredictor(r1, p1, q1);
+						recon[i + 2] = s2 + PaethPredictor(r2, p2, q2);
+						recon[i + 3] = s3 + PaethPredictor(r3, p3, q3);
+					}
+				}
+				else if (byteWidth >= 3)
+				{
+					for (; i + 2 < length; i += 3, j += 3)
+					{
+						const u8 s0 = scanline[i + 0], s1 = scanline[i + 1], s2 = scanline[i + 2];
+						const u8 r0 = recon[j + 0], r1 = recon[j + 1], r2 = recon[j + 2];
+						const u8 p0 = precon[i + 0], p1 = precon[i + 1], p2 = precon[i + 2];
+						const u8 q0 = precon[j + 0], q1 = precon[j + 1], q2 = precon[j + 2];
+						recon[i + 0] = s0 + PaethPredictor(r0, p0, q0);
+						recon[i + 1] = s1 + PaethPredictor(r1, p1, q1);
+						recon[i + 2] = s2 + PaethPredictor(r2, p2, q2);
+					}
+				}
+				else if (byteWidth >= 2)
+				{
+					for (; i + 1 < length; i += 2, j += 2)
+					{
+						const u8 s0 = scanline[i + 0], s1 = scanline[i + 1];
+						const u8 r0 = recon[j + 0], r1 = recon[j + 1];
+						const u8 p0 = precon[i + 0], p1 = precon[i + 1];
+						const u8 q0 = precon[j + 0], q1 = precon[j + 1];
+						recon[i + 0] = s0 + PaethPredictor(r0, p0, q0);
+						recon[i + 1] = s1 + PaethPredictor(r1, p1, q1);
+					}
+				}
+
+				for (; i != length; ++i, ++j)
+					recon[i] = (scanline[i] + PaethPredictor(recon[i - byteWidth], precon[i], precon[j]));
+			}
+			else
+			{
+				for (i = 0; i != byteWidth; ++i)
+					recon[i] = scanline[i];
+				usize j = 0;
+				for (i = byteWidth; i != length; ++i, ++j)
+					recon[i] = (scanline[i] + recon[j]);
+			}
+			break;
+		}
+
+		default:
+			return false;
+		}
+
+		return true;
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Load a single pixel into the low bytes of a vector, the remaining bytes are zero.
+	/// @tparam BW Bytes per pixel (3, 4, 6 or 8).
+	/// @param data Pixel to load.
+	/// @return Loaded pixel.
+	template<usize BW>
+	[[nodiscard]] __m128i LoadPixel(const u8* const data) noexcept
+	{
+		if constexpr(BW == 8u)
+			return _mm_loadl_epi64(reinterpret_cast<const __m128i*>(data));
+		else if constexpr(BW > 4u)
+		{
+			u64 value = 0;
+			std::memcpy(&value, data, BW);
+			return _mm_cvtsi64_si128(std::bit_cast<i64>(value));
+		}
+		else
+		{
+			u32 value = 0;
+			std::memcpy(&value, data, BW);
+			return _mm_cvtsi32_si128(std::bit_cast<i32>(value));
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Store a single pixel from the low bytes of a vector.
+	/// @tparam BW Bytes per pixel (3, 4, 6 or 8).
+	/// @param data Destination for the pixel.
+	/// @param pixel Pixel to store.
+	template<usize BW>
+	void StorePixel(u8* const data, const __m128i pixel) noexcept
+	{
+		if constexpr(BW == 8u)
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(data), pixel);
+		else if constexpr(BW > 4u)
+		{
+			const i64 value = _mm_cvtsi128_si64(pixel);
+			std::memcpy(data, &value, BW);
+		}
+		else
+		{
+			const i32 value = _mm_cvtsi128_si32(pixel);
+			std::memcpy(data, &value, BW);
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Unfilter a scanline with filter type 1 (Sub) using SSE2.
+	///        The pixels of a block get summed up with a logarithmic prefix sum.
+	/// @tparam BW Bytes per pixel (1, 2, 3, 4, 6 or 8).
+	/// @param recon Output for the unfiltered scanline.
+	/// @param scanline Filtered scanline.
+	/// @param length Length of the scanline in bytes.
+	template<usize BW>
+	void UnFilterSubSSE2(u8* const recon, const u8* const scanline, const usize length) noexcept
+	{
+		//A block contains only whole pixels, so 3 and 6 bytes per pixel only use 12 bytes of a vector
+		static constexpr usize BlockSize = ((16u / BW) * BW == 16u) ? 16u : 12u;
+
+		const __m128i allOnes = _mm_set1_epi8(-1);
+		const __m128i blockMask = _mm_srli_si128(allOnes, 16u - BlockSize);
+		const __m128i pixelMask = _mm_srli_si128(allOnes, 16u - BW);
+
+		__m128i last = _mm_setzero_si128(); //Last unfiltered pixel of the previous block
+
+		usize i = 0;
+		for(; i + 16u <= length; i += BlockSize)
+		{
+			__m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(scanline + i));
+			x = _mm_add_epi8(_mm_and_si128(x, blockMask), last);
+
+			x = _mm_add_epi8(x, _mm_slli_si128(x, BW));
+			if constexpr(2u * BW < BlockSize)
+				x = _mm_add_epi8(x, _mm_slli_si128(x, 2u * BW));
+			if constexpr(4u * BW < BlockSize)
+				x = _mm_add_epi8(x, _mm_slli_si128(x, 4u * BW));
+			if constexpr(8u * BW < BlockSize)
+				x = _mm_add_epi8(x, _mm_slli_si128(x, 8u * BW));
+
+			if constexpr(BlockSize == 16u)
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(recon + i), x);
+			else
+			{
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(recon + i), x);
+				const i32 high = _mm_cvtsi128_si32(_mm_srli_si128(x, 8));
+				std::memcpy(recon + i + 8u, &high, sizeof(high));
+			}
+
+			last = _mm_and_si128(_mm_srli_si128(x, BlockSize - BW), pixelMask);
+		}
+
+		for(; i != length; ++i)
+			recon[i] = (i < BW) ? scanline[i] : static_cast<u8>(scanline[i] + recon[i - BW]);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Unfilter a scanline with filter type 2 (Up) using SSE2.
+	/// @param recon Output for the unfiltered scanline.
+	/// @param scanline Filtered scanline.
+	/// @param precon Previous unfiltered scanline.
+	/// @param length Length of the scanline in bytes.
+	void UnFilterUpSSE2(u8* const recon, const u8* const scanline, const u8* const precon, const usize length) noexcept
+	{
+		usize i = 0;
+		for(; i + 16u <= length; i += 16u)
+		{
+			const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(scanline + i));
+			const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(precon + i));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(recon + i), _mm_add_epi8(x, b));
+		}
+
+		for(; i != length; ++i)
+			recon[i] = static_cast<u8>(scanline[i] + precon[i]);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Unfilter a scanline with filter type 2 (Up) using AVX2.
+	/// @param recon Output for the unfiltered scanline.
+	/// @param scanline Filtered scanline.
+	/// @param precon Previous unfiltered scanline.
+	/// @param length Length of the scanline in bytes.
+	/// @note Requires AVX2 support.
+	TRAP_TARGET_ISA("avx2")
+	void UnFilterUpAVX2(u8* const recon, const u8* const scanline, const u8* const precon, const usize length) noexcept
+	{
+		usize i = 0;
+		for(; i + 32u <= length; i += 32u)
+		{
+			const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(scanline + i));
+			const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(precon + i));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(recon + i), _mm256_add_epi8(x, b));
+		}
+
+		for(; i != length; ++i)
+			recon[i] = static_cast<u8>(scanline[i] + precon[i]);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Unfilter a scanline with filter type 3 (Average) using SSE2, all bytes of a pixel at once.
+	/// @tparam BW Bytes per pixel (3, 4, 6 or 8).
+	/// @param recon Output for the unfiltered scanline.
+	/// @param scanline Filtered scanline.
+	/// @param precon Previous unfiltered scanline.
+	/// @param length Length of the scanline in bytes.
+	template<usize BW>
+	void UnFilterAverageSSE2(u8* const recon, const u8* const scanline, const u8* const precon, const usize length) noexcept
+	{
+		const __m128i one = _mm_set1_epi8(1);
+
+		__m128i a = _mm_setzero_si128(); //Left pixel
+		for(usize i = 0; i + BW <= length; i += BW)
+		{
+			const __m128i b = LoadPixel<BW>(precon + i);
+			const __m128i x = LoadPixel<BW>(scanline + i);
+
+			//_mm_avg_epu8() rounds up, the filter rounds down
+			const __m128i average = _mm_sub_epi8(_mm_avg_epu8(a, b), _mm_and_si128(_mm_xor_si128(a, b), one));
+			a = _mm_add_epi8(x, average);
+			StorePixel<BW>(recon + i, a);
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Retrieve the absolute value of signed 16-bit integers using SSE2.
+	/// @param x Values.
+	/// @return Absolute values.
+	[[nodiscard]] __m128i Abs16SSE2(const __m128i x) noexcept
+	{
+		return _mm_max_epi16(x, _mm_sub_epi16(_mm_setzero_si128(), x));
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Select values from two vectors.
+	/// @param mask Mask, all bits set selects from x, all bits cleared selects from y.
+	/// @param x Values selected by set mask bits.
+	/// @param y Values selected by cleared mask bits.
+	/// @return Selected values.
+	[[nodiscard]] __m128i SelectSSE2(const __m128i mask, const __m128i x, const __m128i y) noexcept
+	{
+		return _mm_or_si128(_mm_and_si128(mask, x), _mm_andnot_si128(mask, y));
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Unfilter a scanline with filter type 4 (Paeth) using SSE2, all bytes of a pixel at once.
+	/// @tparam BW Bytes per pixel (3, 4, 6 or 8).
+	/// @param recon Output for the unfiltered scanline.
+	/// @param scanline Filtered scanline.
+	/// @param precon Previous unfiltered scanline.
+	/// @param length Length of the scanline in bytes.
+	template<usize BW>
+	void UnFilterPaethSSE2(u8* const recon, const u8* const scanline, const u8* const precon, const usize length) noexcept
+	{
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i lowByte = _mm_set1_epi16(0xFF);
+
+		//Pixels are widened to 16-bit so the predictor distances don't overflow
+		__m128i a = zero; //Left pixel
+		__m128i c = zero; //Above-left pixel
+		for(usize i = 0; i + BW <= length; i += BW)
+		{
+			const __m128i b = _mm_unpacklo_epi8(LoadPixel<BW>(precon + i), zero);
+			const __m128i x = _mm_unpacklo_epi8(LoadPixel<BW>(scanline + i), zero);
+
+			const __m128i bc = _mm_sub_epi16(b, c);
+			const __m128i ac = _mm_sub_epi16(a, c);
+			const __m128i pa = Abs16SSE2(bc);
+			const __m128i pb = Abs16SSE2(ac);
+			const __m128i pc = Abs16SSE2(_mm_add_epi16(bc, ac));
+
+			//Smallest distance wins, ties prefer a over b over c
+			const __m128i smallest = _mm_min_epi16(pa, _mm_min_epi16(pb, pc));
+			const __m128i predicted = SelectSSE2(_mm_cmpeq_epi16(pa, smallest), a,
+			                                     SelectSSE2(_mm_cmpeq_epi16(pb, smallest), b, c));
+
+			a = _mm_and_si128(_mm_add_epi16(x, predicted), lowByte);
+			c = b;
+			StorePixel<BW>(recon + i, _mm_packus_epi16(a, a));
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Unfilter scanline depending on given filter type using SSE2.
+	/// @param recon Output for the unfiltered scanline.
+	/// @param scanline Pointer to scanline.
+	/// @param precon Previous unfiltered scanline, nullptr for the first scanline.
+	/// @param byteWidth Width of a pixel in bytes.
+	/// @param filterType Filter type.
+	/// @param length Length of the scanline in bytes.
+	/// @return True if the scanline was unfiltered successfully, false otherwise.
+	[[nodiscard]] bool UnFilterScanlineSSE2(u8* const recon, const u8* const scanline, const u8* const precon,
+	                                        const usize byteWidth, const u8 filterType, const usize length) noexcept
+	{
+		switch(filterType)
+		{
+		case 0:
+			if(recon != scanline)
+				std::memmove(recon, scanline, length);
+			return true;
+
+		case 2:
+			if(precon == nullptr)
+				return UnFilterScanlineSSE2(recon, scanline, precon, byteWidth, 0, length);
+
+			UnFilterUpSSE2(recon, scanline, precon, length);
+			return true;
+
+		case 4:
+			//Without a previous scanline Paeth always predicts the left pixel, just like Sub
+			if(precon == nullptr)
+				return UnFilterScanlineSSE2(recon, scanline, precon, byteWidth, 1, length);
+
+			switch(byteWidth)
+			{
+			case 3:
+				UnFilterPaethSSE2<3>(recon, scanline, precon, length);
+				return true;
+			case 4:
+				UnFilterPaethSSE2<4>(recon, scanline, precon, length);
+				return true;
+			case 6:
+				UnFilterPaethSSE2<6>(recon, scanline, precon, length);
+				return true;
+			case 8:
+				UnFilterPaethSSE2<8>(recon, scanline, precon, length);
+				return true;
+			default:
+				break;
+			}
+			break;
+
+		case 1:
+			switch(byteWidth)
+			{
+			case 1:
+				UnFilterSubSSE2<1>(recon, scanline, length);
+				return true;
+			case 2:
+				UnFilterSubSSE2<2>(recon, scanline, length);
+				return true;
+			case 3:
+				UnFilterSubSSE2<3>(recon, scanline, length);
+				return true;
+			case 4:
+				UnFilterSubSSE2<4>(recon, scanline, length);
+				return true;
+			case 6:
+				UnFilterSubSSE2<6>(recon, scanline, length);
+				return true;
+			case 8:
+				UnFilterSubSSE2<8>(recon, scanline, length);
+				return true;
+			default:
+				break;
+			}
+			break;
+
+		case 3:
+			if(precon == nullptr)
+				break;
+
+			switch(byteWidth)
+			{
+			case 3:
+				UnFilterAverageSSE2<3>(recon, scanline, precon, length);
+				return true;
+			case 4:
+				UnFilterAverageSSE2<4>(recon, scanline, precon, length);
+				return true;
+			case 6:
+				UnFilterAverageSSE2<6>(recon, scanline, precon, length);
+				return true;
+			case 8:
+				UnFilterAverageSSE2<8>(recon, scanline, precon, length);
+				return true;
+			default:
+				break;
+			}
+			break;
+
+		default:
+			return false;
+		}
+
+		//Pixel sizes without a vectorized kernel
+		return UnFilterScanlineScalar(recon, scanline, precon, byteWidth, filterType, length);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Unfilter scanline depending on given filter type using AVX2.
+	///        Only Up benefits from wider vectors, the other filters depend on the previous pixel.
+	/// @param recon Output for the unfiltered scanline.
+	/// @param scanline Pointer to scanline.
+	/// @param precon Previous unfiltered scanline, nullptr for the first scanline.
+	/// @param byteWidth Width of a pixel in bytes.
+	/// @param filterType Filter type.
+	/// @param length Length of the scanline in bytes.
+	/// @return True if the scanline was unfiltered successfully, false otherwise.
+	/// @note Requires AVX2 support.
+	[[nodiscard]] bool UnFilterScanlineAVX2(u8* const recon, const u8* const scanline, const u8* const precon,
+	                                        const usize byteWidth, const u8 filterType, const usize length) noexcept
+	{
+		if(filterType == 2 && precon != nullptr)
+		{
+			UnFilterUpAVX2(recon, scanline, precon, length);
+			return true;
+		}
+
+		return UnFilterScanlineSSE2(recon, scanline, precon, byteWidth, filterType, length);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	using PFN_UnFilterScanline = bool(*)(u8* recon, const u8* scanline, const u8* precon, usize byteWidth,
+	                                     u8 filterType, usize length) noexcept;
+
+	/// @brief Retrieve the function for the given PNG unfilter implementation.
+	/// @param impl PNG unfilter implementation.
+	/// @return Function implementing impl.
+	[[nodiscard]] constexpr PFN_UnFilterScanline GetUnFilterScanline(const TRAP::INTERNAL::PNGUnFilterImplementation impl) noexcept
+	{
+		switch(impl)
+		{
+		case TRAP::INTERNAL::PNGUnFilterImplementation::SSE2:
+			return UnFilterScanlineSSE2;
+
+		case TRAP::INTERNAL::PNGUnFilterImplementation::AVX2:
+			return UnFilterScanlineAVX2;
+
+		case TRAP::INTERNAL::PNGUnFilterImplementation::Scalar:
+			[[fallthrough]];
+		default:
+			return UnFilterScanlineScalar;
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Retrieve the fastest PNG unfilter implementation supported by the CPU.
+	/// @return Function implementing the fastest supported PNG unfilter implementation.
+	[[nodiscard]] PFN_UnFilterScanline GetBestUnFilterScanline()
+	{
+		using TRAP::INTERNAL::PNGUnFilterImplementation;
+		using TRAP::INTERNAL::IsPNGUnFilterImplementationSupported;
+
+		static const PFN_UnFilterScanline unFilterScanline = []()
+		{
+			if(IsPNGUnFilterImplementationSupported(PNGUnFilterImplementation::AVX2))
+				return GetUnFilterScanline(PNGUnFilterImplementation::AVX2);
+			if(IsPNGUnFilterImplementationSupported(PNGUnFilterImplementation::SSE2))
+				return GetUnFilterScanline(PNGUnFilterImplementation::SSE2);
+
+			return GetUnFilterScanline(PNGUnFilterImplementation::Scalar);
+		}();
+
+		return unFilterScanline;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] bool TRAP::INTERNAL::IsPNGUnFilterImplementationSupported(const PNGUnFilterImplementation impl)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None &&
+	                                         (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	switch(impl)
+	{
+	case PNGUnFilterImplementation::Scalar:
+		[[fallthrough]];
+	case PNGUnFilterImplementation::SSE2: //Part of x86-64
+		return true;
+
+	case PNGUnFilterImplementation::AVX2:
+		return Utils::GetCPUInfo().AVX2;
+
+	default:
+		return false;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] bool TRAP::INTERNAL::PNGUnFilterScanline(u8* const recon, const u8* const scanline, const u8* const precon,
+                                                       const usize byteWidth, const u8 filterType, const usize length)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None &&
+	                                         (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	return GetBestUnFilterScanline()(recon, scanline, precon, byteWidth, filterType, length);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] bool TRAP::INTERNAL::PNGUnFilterScanline(u8* const recon, const u8* const scanline, const u8* const precon,
+                                                       const usize byteWidth, const u8 filterType, const usize length,
+                                                       const PNGUnFilterImplementation impl)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None &&
+	                                         (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	TRAP_ASSERT(IsPNGUnFilterImplementationSupported(impl), "PNGUnFilterScanline(): Implementation is not supported by the CPU!");
+
+	return GetUnFilterScanline(impl)(recon, scanline, precon, byteWidth, filterType, length);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] bool TRAP::INTERNAL::PNGFilterScanline(u8* const out, const u8* const scanline, const u8* const prevline,
+                                                     const usize byteWidth, const u8 filterType, const usize length)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None &&
+	                                         (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	const usize start = std::min(byteWidth, length);
+
+	switch(filterType)
+	{
+	case 0: //None
+		std::copy_n(scanline, length, out);
+		return true;
+
+	case 1: //Sub
+		std::copy_n(scanline, start, out);
+		for(usize i = byteWidth; i < length; ++i)
+			out[i] = static_cast<u8>(scanline[i] - scanline[i - byteWidth]);
+		return true;
+
+	case 2: //Up
+		if(prevline == nullptr)
+		{
+			std::copy_n(scanline, length, out);
+			return true;
+		}
+		for(usize i = 0; i < length; ++i)
+			out[i] = static_cast<u8>(scanline[i] - prevline[i]);
+		return true;
+
+	case 3: //Average
+		if(prevline == nullptr)
+		{
+			std::copy_n(scanline, start, out);
+			for(usize i = byteWidth; i < length; ++i)
+				out[i] = static_cast<u8>(scanline[i] - (scanline[i - byteWidth] >> 1u));
+			return true;
+		}
+		for(usize i = 0; i < start; ++i)
+			out[i] = static_cast<u8>(scanline[i] - (prevline[i] >> 1u));
+		for(usize i = byteWidth; i < length; ++i)
+			out[i] = static_cast<u8>(scanline[i] - ((scanline[i - byteWidth] + prevline[i]) >> 1u));
+		return true;
+
+	case 4: //Paeth
+		if(prevline == nullptr)
+		{
+			//Paeth of the first scanline equals Sub
+			std::copy_n(scanline, start, out);
+			for(usize i = byteWidth; i < length; ++i)
+				out[i] = static_cast<u8>(scanline[i] - scanline[i - byteWidth]);
+			return true;
+		}
+		for(usize i = 0; i < start; ++i)
+			out[i] = static_cast<u8>(scanline[i] - prevline[i]);
+		for(usize i = byteWidth; i < length; ++i)
+		{
+			//Branchless form of PaethPredictor() so the loop gets vectorized,
+			//unlike unfiltering there is no dependency on previous results
+			const i32 a = scanline[i - byteWidth];
+			const i32 b = prevline[i];
+			const i32 c = prevline[i - byteWidth];
+			const i32 pa = std::abs(b - c);
+			const i32 pb = std::abs(a - c);
+			const i32 pc = std::abs(a + b - c - c);
+			const i32 predicted = (pa <= pb && pa <= pc) ? a : (pb <= pc ? b : c);
+			out[i] = static_cast<u8>(scanline[i] - predicted);
+		}
+		return true;
+
+	default:
+		return false; //Error: Nonexistent filter type given
+	}
+}
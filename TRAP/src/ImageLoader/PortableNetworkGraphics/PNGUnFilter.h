@@ -0,0 +1,86 @@
+/*
+LodePNG version 20230410
+
+Copyright (c) 2005-2023 Lode Vandevenne
+
+This software is provided 'as-is', without any express or implied
+warranty. In no event will the authors be held liable for any damages
+arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not
+    claim that you wrote the original software. If you use this software
+    in a product, an acknowledgment in the product documentation would be
+    appreciated but is not required.
+
+    2. Altered source versions must be plainly marked as such, and must not be
+    misrepresented as being the original software.
+
+    3. This notice may not be removed or altered from any source
+    distribution.
+
+Modified by Jan "GamesTrap" Schuerkamp
+*/
+
+#ifndef TRAP_PNGUNFILTER_H
+#define TRAP_PNGUNFILTER_H
+
+#include "Core/Types.h"
+
+namespace TRAP::INTERNAL
+{
+	/// @brief Available PNG unfilter implementations.
+	///        PNGUnFilterScanline() automatically uses the fastest one supported by the CPU.
+	enum class PNGUnFilterImplementation : u8
+	{
+		Scalar,
+		SSE2,
+		AVX2
+	};
+
+	/// @brief Check whether the given PNG unfilter implementation is supported by the CPU.
+	/// @param impl PNG unfilter implementation.
+	/// @return True if supported, false otherwise.
+	[[nodiscard]] bool IsPNGUnFilterImplementationSupported(PNGUnFilterImplementation impl);
+
+	/// @brief Unfilter a scanline depending on the given filter type (PNG filter method 0).
+	/// @param recon Output for the unfiltered scanline.
+	/// @param scanline Filtered scanline, without the filter type byte.
+	/// @param precon Previous unfiltered scanline, nullptr for the first scanline.
+	/// @param byteWidth Bytes per pixel, 1 if a pixel is smaller than a byte.
+	/// @param filterType Filter type.
+	/// @param length Length of the scanline in bytes.
+	/// @return True if the scanline was unfiltered successfully, false otherwise.
+	/// @note recon may be the same as or precede scanline, precon must not overlap with recon.
+	[[nodiscard]] bool PNGUnFilterScanline(u8* recon, const u8* scanline, const u8* precon, usize byteWidth,
+	                                       u8 filterType, usize length);
+	/// @brief Unfilter a scanline depending on the given filter type (PNG filter method 0) using a specific implementation.
+	/// @param recon Output for the unfiltered scanline.
+	/// @param scanline Filtered scanline, without the filter type byte.
+	/// @param precon Previous unfiltered scanline, nullptr for the first scanline.
+	/// @param byteWidth Bytes per pixel, 1 if a pixel is smaller than a byte.
+	/// @param filterType Filter type.
+	/// @param length Length of the scanline in bytes.
+	/// @param impl PNG unfilter implementation to use, must be supported by the CPU.
+	/// @return True if the scanline was unfiltered successfully, false otherwise.
+	/// @note Only intended for testing and benchmarking.
+	[[nodiscard]] bool PNGUnFilterScanline(u8* recon, const u8* scanline, const u8* precon, usize byteWidth,
+	                                       u8 filterType, usize length, PNGUnFilterImplementation impl);
+
+	/// @brief Filter a scanline with the given filter type (PNG filter method 0), the inverse of PNGUnFilterScanline().
+	/// @param out Output for the filtered scanline, without the filter type byte.
+	/// @param scanline Unfiltered scanline.
+	/// @param prevline Previous unfiltered scanline, nullptr for the first scanline.
+	/// @param byteWidth Bytes per pixel, 1 if a pixel is smaller than a byte.
+	/// @param filterType Filter type.
+	/// @param length Length of the scanline in bytes.
+	/// @return True if the scanline was filtered successfully, false otherwise.
+	/// @note out must not overlap with scanline or prevline.
+	[[nodiscard]] bool PNGFilterScanline(u8* out, const u8* scanline, const u8* prevline, usize byteWidth,
+	                                     u8 filterType, usize length);
+}
+
+#endif /*TRAP_PNGUNFILTER_H*/
@@ -12,6 +12,8 @@ Modified by Jan "GamesTrap" Schuerkamp
 #include "QOIImage.h"
 
 #include "FileSystem/FileSystem.h"
+#include "FileSystem/MappedFile.h"
+#include "Utils/ByteReader.h"
 #include "Utils/Memory.h"
 #include "Utils/Utils.h"
 #include "ImageLoader/Image.h"
@@ -30,42 +32,56 @@ TRAP::INTERNAL::QOIImage::QOIImage(std::filesystem::path filepath)
 	if (!FileSystem::Exists(m_filepath))
 		return;
 
-	std::ifstream file(m_filepath, std::ios::binary);
-	if (!file.is_open())
+	const auto file = FileSystem::MapFile(m_filepath);
+	if (!file)
 	{
 		TP_ERROR(Log::ImageQOIPrefix, "Couldn't open file path: ", m_filepath, "!");
 		TP_WARN(Log::ImageQOIPrefix, "Using default image!");
 		return;
 	}
 
-    const auto size = FileSystem::GetSize(m_filepath);
-    usize fileSize = 0;
-    if(size)
-        fileSize = *size;
-    else //Fallback
-    {
-        file.seekg(0, std::ios::end);
-        fileSize = static_cast<usize>(file.tellg());
-        file.seekg(0);
-    }
+	Decode(file->GetData());
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+TRAP::INTERNAL::QOIImage::QOIImage(const std::span<const u8> data)
+	: Image("")
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	TP_DEBUG(Log::ImageQOIPrefix, "Loading image from memory");
+
+	Decode(data);
+}
 
-    if(fileSize < sizeof(Header) + EndMarker.size())
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::INTERNAL::QOIImage::Decode(const std::span<const u8> data)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+    if(data.size() < HeaderSize + EndMarker.size())
     {
         TP_ERROR(Log::ImageQOIPrefix, "File size is too small: ", m_filepath, "!");
         TP_WARN(Log::ImageQOIPrefix, "Using default image!");
         return;
     }
 
+    Utils::ByteReader reader(data);
+
     Header header{};
-    file.read(header.MagicNumber.data(), NumericCast<u32>(header.MagicNumber.size()));
-    file.read(reinterpret_cast<char*>(&header.Width), sizeof(u32));
-    file.read(reinterpret_cast<char*>(&header.Height), sizeof(u32));
-    file >> header.Channels >> header.ColorSpace;
+    reader.Read(header.MagicNumber);
+    reader.Read(header.Width);
+    reader.Read(header.Height);
+    header.Channels = reader.ReadByte();
+    header.ColorSpace = reader.ReadByte();
 
     //Magic number must be "qoif"
-    if(header.MagicNumber != "qoif")
+    const std::string_view magicNumber(header.MagicNumber.data(), header.MagicNumber.size());
+    if(magicNumber != "qoif")
     {
-        TP_ERROR(Log::ImageQOIPrefix, "Invalid magic number: ", header.MagicNumber.data(), "!");
+        TP_ERROR(Log::ImageQOIPrefix, "Invalid magic number: ", magicNumber, "!");
         TP_WARN(Log::ImageQOIPrefix, "Using default image!");
         return;
     }
@@ -80,28 +96,24 @@ TRAP::INTERNAL::QOIImage::QOIImage(std::filesystem::path filepath)
     //Validation checks
 	if (header.Width < 1)
 	{
-		file.close();
 		TP_ERROR(Log::ImageQOIPrefix, "Width is < 1 (", header.Width, ")!");
 		TP_WARN(Log::ImageQOIPrefix, "Using default image!");
 		return;
 	}
 	if (header.Height < 1)
 	{
-		file.close();
 		TP_ERROR(Log::ImageQOIPrefix, "Height is < 1 (", header.Height, ")!");
 		TP_WARN(Log::ImageQOIPrefix, "Using default image!");
 		return;
 	}
     if(header.Channels != 3 && header.Channels != 4)
     {
-		file.close();
 		TP_ERROR(Log::ImageQOIPrefix, "Invalid channel count, must be 3 or 4 (", header.Channels, ")!");
 		TP_WARN(Log::ImageQOIPrefix, "Using default image!");
 		return;
     }
     if(header.ColorSpace != 0 && header.ColorSpace != 1)
     {
-		file.close();
 		TP_ERROR(Log::ImageQOIPrefix, "Invalid color space, must be 0 (sRGB) or 1 (Linear) (", header.Channels, ")!");
 		TP_WARN(Log::ImageQOIPrefix, "Using default image!");
 		return;
@@ -110,7 +122,6 @@ TRAP::INTERNAL::QOIImage::QOIImage(std::filesystem::path filepath)
 	m_width = header.Width;
 	m_height = header.Height;
 
-    m_data.resize(NumericCast<usize>(header.Width) * header.Height * header.Channels);
     m_bitsPerPixel = header.Channels * 8;
     m_colorFormat = header.Channels == 3 ? ColorFormat::RGB : ColorFormat::RGBA;
 
@@ -124,106 +135,354 @@ TRAP::INTERNAL::QOIImage::QOIImage(std::filesystem::path filepath)
 
     // }
 
-    DecodeImage(file, fileSize);
-
-    file.close();
+    DecodeImage(reader.GetRemainingData());
 }
 
 //-------------------------------------------------------------------------------------------------------------------//
 
-struct Pixel
+namespace
 {
-    u8 Red;
-    u8 Green;
-    u8 Blue;
-    u8 Alpha;
-};
-
-constexpr u8 QOI_OP_INDEX = 0x00;
-constexpr u8 QOI_OP_DIFF  = 0x40;
-constexpr u8 QOI_OP_LUMA  = 0x80;
-constexpr u8 QOI_OP_RUN   = 0xC0;
-constexpr u8 QOI_OP_RGB   = 0xFE;
-constexpr u8 QOI_OP_RGBA  = 0xFF;
-
-constexpr u8 QOI_MASK_2   = 0xC0;
-
-[[nodiscard]] constexpr u32 QOI_COLOR_HASH(const Pixel& p) noexcept
+	constexpr u8 QOI_OP_INDEX = 0x00;
+	constexpr u8 QOI_OP_DIFF  = 0x40;
+	constexpr u8 QOI_OP_LUMA  = 0x80;
+	constexpr u8 QOI_OP_RUN   = 0xC0;
+	constexpr u8 QOI_OP_RGB   = 0xFE;
+	constexpr u8 QOI_OP_RGBA  = 0xFF;
+
+	/// @brief Longest run a single QOI_OP_RUN can encode.
+	constexpr u32 QOI_MAX_RUN = 62;
+
+	static_assert(TRAP::Utils::GetEndian() == TRAP::Utils::Endian::Little,
+	              "QOIImage: Pixels are packed as little endian u32 (R in the lowest byte)!");
+
+	/// @brief Pixel packed as u32, red in the lowest byte, alpha in the highest byte.
+	using Pixel = u32;
+
+	/// @brief Initial previous pixel, opaque black.
+	constexpr Pixel QOI_START_PIXEL = 0xFF000000u;
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	[[nodiscard]] constexpr Pixel MakePixel(const u32 r, const u32 g, const u32 b, const u32 a) noexcept
+	{
+		return r | (g << 8u) | (b << 16u) | (a << 24u);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Compute the QOI index position of a pixel, (r * 3 + g * 5 + b * 7 + a * 11) % 64.
+	///        The channels are spread into 16 bit lanes so a single multiplication sums them in the top byte.
+	/// @param pixel Pixel.
+	/// @return Index position.
+	[[nodiscard]] constexpr u32 QOI_COLOR_HASH(const Pixel pixel) noexcept
+	{
+		const u64 spread = ((static_cast<u64>(pixel) & 0xFF00FF00u) << 24u) | (pixel & 0x00FF00FFu);
+		return static_cast<u32>((spread * ((3ull << 56u) | (7ull << 40u) | (5ull << 24u) | (11ull << 8u))) >> 56u) & 0x3Fu;
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Packed QOI_OP_DIFF differences, indexed by the lower 6 bits of the tag.
+	constexpr std::array<u32, 64> QOI_DIFF_DELTAS = []
+	{
+		std::array<u32, 64> deltas{};
+		for(u32 i = 0; i < deltas.size(); ++i)
+			deltas[i] = MakePixel(((i >> 4u) - 2u) & 0xFFu, (((i >> 2u) & 0x03u) - 2u) & 0xFFu, ((i & 0x03u) - 2u) & 0xFFu, 0u);
+		return deltas;
+	}();
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Add packed per channel differences to a pixel, every channel wraps around on its own.
+	/// @param pixel Pixel.
+	/// @param delta Packed differences.
+	/// @return Resulting pixel.
+	[[nodiscard]] constexpr Pixel AddPixelDelta(const Pixel pixel, const u32 delta) noexcept
+	{
+		return ((pixel & 0x7F7F7F7Fu) + (delta & 0x7F7F7F7Fu)) ^ ((pixel ^ delta) & 0x80808080u);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Decode QOI chunks.
+	///        Chunks are read straight from memory, the end marker guarantees that no chunk reads past the data.
+	///        If the chunks run out early, the remaining pixels are filled with the last pixel.
+	///        Pixels are always stored as full u32, for 3 channels the 4th byte is overwritten by the next pixel.
+	/// @tparam Channels Amount of output channels, 3 or 4.
+	/// @param chunks Chunk data including the end marker.
+	/// @param out Output for the decoded pixels.
+	/// @note For 3 channels one byte after out must be writable.
+	template<u32 Channels>
+	void DecodeChunks(const std::span<const u8> chunks, const std::span<u8> out)
+	{
+		const u8* in = chunks.data();
+		const u8* const inEnd = chunks.data() + (chunks.size() - EndMarker.size());
+		u8* dst = out.data();
+		u8* const dstEnd = out.data() + out.size();
+
+		std::array<Pixel, 64> index{};
+		Pixel pixel = QOI_START_PIXEL;
+
+		//Runs don't update the index because their pixel is already in it,
+		//except for the start pixel when the data begins with a run
+		if(in < inEnd && (*in & 0xC0u) == QOI_OP_RUN && *in < QOI_OP_RGB)
+			index[QOI_COLOR_HASH(pixel)] = pixel;
+
+		while(dst < dstEnd && in < inEnd)
+		{
+			const u8 tag = *in++;
+
+			//QOI_OP_RGB and QOI_OP_RGBA first, they make up most of the chunks in detailed images
+			if(tag == QOI_OP_RGB)
+			{
+				//Reading the next tag as 4th byte is fine, it is replaced by the alpha of the previous pixel
+				u32 rgb = 0;
+				std::memcpy(&rgb, in, sizeof(rgb));
+				pixel = (pixel & 0xFF000000u) | (rgb & 0x00FFFFFFu);
+				in += 3;
+			}
+			else if(tag == QOI_OP_RGBA)
+			{
+				std::memcpy(&pixel, in, sizeof(pixel));
+				in += 4;
+			}
+			else if(tag < QOI_OP_DIFF) //QOI_OP_INDEX
+				pixel = index[tag];
+			else if(tag < QOI_OP_LUMA) //QOI_OP_DIFF
+				pixel = AddPixelDelta(pixel, QOI_DIFF_DELTAS[tag & 0x3Fu]);
+			else if(tag < QOI_OP_RUN) //QOI_OP_LUMA
+			{
+				const u32 data = *in++;
+				const u32 vg = (tag & 0x3Fu) - 32u;
+				pixel = AddPixelDelta(pixel, MakePixel((vg - 8u + (data >> 4u)) & 0xFFu, vg & 0xFFu,
+				                                       (vg - 8u + (data & 0x0Fu)) & 0xFFu, 0u));
+			}
+			else //QOI_OP_RUN, the whole run is written at once
+			{
+				usize run = (tag & 0x3Fu) + 1u;
+				if(run * Channels > NumericCast<usize>(dstEnd - dst))
+					run = NumericCast<usize>(dstEnd - dst) / Channels;
+
+				//Two pixels per store, for 3 channels the 2 extra bytes have to stay inside the run
+				const u64 pixelPair = Channels == 4u ? (pixel | (static_cast<u64>(pixel) << 32u)) :
+				                      ((pixel & 0xFFFFFFu) | (static_cast<u64>(pixel & 0xFFFFFFu) << 24u) |
+				                       (static_cast<u64>(pixel) << 48u));
+				usize i = 0;
+				for(; i + (Channels == 4u ? 1u : 2u) < run; i += 2u, dst += 2u * Channels)
+					std::memcpy(dst, &pixelPair, sizeof(pixelPair));
+				for(; i < run; ++i, dst += Channels)
+					std::memcpy(dst, &pixel, sizeof(Pixel));
+
+				continue;
+			}
+
+			index[QOI_COLOR_HASH(pixel)] = pixel;
+			std::memcpy(dst, &pixel, sizeof(Pixel));
+			dst += Channels;
+		}
+
+		for(; dst < dstEnd; dst += Channels)
+			std::memcpy(dst, &pixel, sizeof(Pixel));
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Load a single input pixel.
+	/// @tparam InChannels Amount of input channels (1 - 4), grayscale for 1 and 2.
+	template<u32 InChannels>
+	[[nodiscard]] Pixel LoadPixel(const u8* const in) noexcept
+	{
+		if constexpr(InChannels == 1u)
+			return MakePixel(in[0], in[0], in[0], 0xFFu);
+		else if constexpr(InChannels == 2u)
+			return MakePixel(in[0], in[0], in[0], in[1]);
+		else if constexpr(InChannels == 3u)
+			return MakePixel(in[0], in[1], in[2], 0xFFu);
+		else
+		{
+			Pixel pixel{};
+			std::memcpy(&pixel, in, 4u);
+			return pixel;
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Encode pixels as QOI chunks.
+	/// @tparam InChannels Amount of input channels (1 - 4), grayscale for 1 and 2.
+	/// @param pixels Input pixels.
+	/// @param pixelCount Amount of pixels.
+	/// @param out Output for the chunks, must hold the worst case of 5 bytes per pixel.
+	/// @return One past the last written byte.
+	template<u32 InChannels>
+	[[nodiscard]] u8* EncodeChunks(const u8* const pixels, const usize pixelCount, u8* out) noexcept
+	{
+		std::array<Pixel, 64> index{};
+		Pixel prevPixel = QOI_START_PIXEL;
+
+		for(usize i = 0; i < pixelCount;)
+		{
+			const Pixel pixel = LoadPixel<InChannels>(pixels + i * InChannels);
+
+			if(pixel == prevPixel)
+			{
+				//Find the end of the run before writing it
+				usize runEnd = i + 1u;
+				while(runEnd < pixelCount && LoadPixel<InChannels>(pixels + runEnd * InChannels) == pixel)
+					++runEnd;
+
+				for(usize run = runEnd - i; run > 0u;)
+				{
+					const usize chunk = std::min<usize>(run, QOI_MAX_RUN);
+					*out++ = QOI_OP_RUN | NumericCast<u8>(chunk - 1u);
+					run -= chunk;
+				}
+
+				i = runEnd;
+				continue;
+			}
+
+			const u32 hashIndex = QOI_COLOR_HASH(pixel);
+			if(index[hashIndex] == pixel)
+				*out++ = QOI_OP_INDEX | NumericCast<u8>(hashIndex);
+			else
+			{
+				index[hashIndex] = pixel;
+
+				if((pixel >> 24u) == (prevPixel >> 24u))
+				{
+					//Intended narrowing, differences wrap around
+					const i8 vr = static_cast<i8>(pixel - prevPixel);
+					const i8 vg = static_cast<i8>((pixel >> 8u) - (prevPixel >> 8u));
+					const i8 vb = static_cast<i8>((pixel >> 16u) - (prevPixel >> 16u));
+					const i8 vgr = static_cast<i8>(vr - vg);
+					const i8 vgb = static_cast<i8>(vb - vg);
+
+					if(vr > -3 && vr < 2 && vg > -3 && vg < 2 && vb > -3 && vb < 2)
+						*out++ = QOI_OP_DIFF | NumericCast<u8>(((vr + 2) << 4) | ((vg + 2) << 2) | (vb + 2));
+					else if(vgr > -9 && vgr < 8 && vg > -33 && vg < 32 && vgb > -9 && vgb < 8)
+					{
+						*out++ = QOI_OP_LUMA | NumericCast<u8>(vg + 32);
+						*out++ = NumericCast<u8>(((vgr + 8) << 4) | (vgb + 8));
+					}
+					else
+					{
+						//Tag and RGB in a single store
+						const u32 chunk = QOI_OP_RGB | (pixel << 8u);
+						std::memcpy(out, &chunk, 4u);
+						out += 4;
+					}
+				}
+				else
+				{
+					*out++ = QOI_OP_RGBA;
+					std::memcpy(out, &pixel, 4u);
+					out += 4;
+				}
+			}
+
+			prevPixel = pixel;
+			++i;
+		}
+
+		return out;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::INTERNAL::QOIImage::DecodeImage(const std::span<const u8> chunks)
 {
-    return p.Red * 3 + p.Green * 5 + p.Blue * 7 + p.Alpha * 11;
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	const usize size = NumericCast<usize>(m_width) * m_height * GetBytesPerPixel();
+
+	if(m_colorFormat == ColorFormat::RGBA)
+	{
+		m_data.resize(size);
+		DecodeChunks<4u>(chunks, m_data);
+	}
+	else
+	{
+		//Room for the 4 byte store of the last pixel, shrinking keeps the allocation
+		m_data.resize(size + 1u);
+		DecodeChunks<3u>(chunks, std::span(m_data).first(size));
+		m_data.pop_back();
+	}
 }
 
-void TRAP::INTERNAL::QOIImage::DecodeImage(std::ifstream& file, const usize& fileSize)
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] std::vector<u8> TRAP::INTERNAL::QOIImage::Encode(const Image* const img)
 {
 	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
 
-    Pixel prevPixel{0, 0, 0, 255};
-    std::array<Pixel, 64> prevPixels{};
+	TRAP_ASSERT(img != nullptr, "QOIImage::Encode(): Image is nullptr!");
 
-    const usize size = NumericCast<usize>(m_width) * m_height * (m_bitsPerPixel / 8);
-    usize index = sizeof(Header);
+	if(img->IsHDR() || img->GetBitsPerChannel() != 8u)
+	{
+		TP_ERROR(Log::ImageQOIPrefix, "Only 8 bits per channel images can be saved as QOI!");
+		return {};
+	}
 
-    for(usize pixelIndex = 0; pixelIndex < size;)
-    {
-        if(index < (fileSize - EndMarker.size()))
-        {
-            const u8 tag = NumericCast<u8>(file.get());
-
-            if(tag == QOI_OP_RGB)
-            {
-                prevPixel.Red = NumericCast<u8>(file.get());
-                prevPixel.Green = NumericCast<u8>(file.get());
-                prevPixel.Blue = NumericCast<u8>(file.get());
-            }
-            else if(tag == QOI_OP_RGBA)
-            {
-                prevPixel.Red = NumericCast<u8>(file.get());
-                prevPixel.Green = NumericCast<u8>(file.get());
-                prevPixel.Blue = NumericCast<u8>(file.get());
-                prevPixel.Alpha = NumericCast<u8>(file.get());
-            }
-            else
-            {
-                if((tag & QOI_MASK_2) == QOI_OP_INDEX)
-                    prevPixel = prevPixels[tag & 0x3Fu];
-                else if((tag & QOI_MASK_2) == QOI_OP_DIFF)
-                {
-                    prevPixel.Red   += NumericCast<u8>((((tag & 0x30u) >> 4u) & 0x03u) - 2);
-                    prevPixel.Green += NumericCast<u8>((((tag & 0x0Cu) >> 2u) & 0x03u) - 2);
-                    prevPixel.Blue  += NumericCast<u8>((((tag & 0x03u) >> 0u) & 0x03u) - 2);
-                }
-                else if((tag & QOI_MASK_2) == QOI_OP_LUMA)
-                {
-                    const u8 data = NumericCast<u8>(file.get());
-                    const u8 vg = static_cast<u8>((tag & 0x3Fu) - 32); //Intended narrowing
-                    prevPixel.Red   += NumericCast<u8>(vg - 8u + ((data >> 4u) & 0xFu));
-                    prevPixel.Green += vg;
-                    prevPixel.Blue  += NumericCast<u8>(vg - 8u + ((data >> 0u) & 0xFu));
-                }
-                else if((tag & QOI_MASK_2) == QOI_OP_RUN)
-                {
-                    const u8 run = tag & 0x3Fu;
-                    for(usize j = 0; j < run; ++j)
-                    {
-                        m_data[pixelIndex++] = prevPixel.Red;
-                        m_data[pixelIndex++] = prevPixel.Green;
-                        m_data[pixelIndex++] = prevPixel.Blue;
-
-                        if(m_bitsPerPixel / 8 == 4)
-                            m_data[pixelIndex++] = prevPixel.Alpha;
-                    }
-                }
-            }
-
-            const u32 pixelHashIndex = (QOI_COLOR_HASH(prevPixel) % 64);
-            prevPixels[NumericCast<usize>(pixelHashIndex)] = prevPixel;
-        }
-
-        m_data[pixelIndex++] = prevPixel.Red;
-        m_data[pixelIndex++] = prevPixel.Green;
-        m_data[pixelIndex++] = prevPixel.Blue;
-
-        if(m_bitsPerPixel / 8 == 4)
-            m_data[pixelIndex++] = prevPixel.Alpha;
-    }
-}
\ No newline at end of file
+	const ColorFormat colorFormat = img->GetColorFormat();
+	const bool hasAlpha = colorFormat == ColorFormat::RGBA || colorFormat == ColorFormat::GrayScaleAlpha;
+	const u8 inChannels = NumericCast<u8>(img->GetBytesPerPixel());
+	const u8 outChannels = hasAlpha ? 4u : 3u;
+
+	const u32 width = img->GetWidth();
+	const u32 height = img->GetHeight();
+	const usize pixelCount = NumericCast<usize>(width) * height;
+	const std::span<const u8> pixels = img->GetPixelData();
+
+	//Worst case every pixel is stored as QOI_OP_RGB(A)
+	std::vector<u8> result(HeaderSize + pixelCount * (outChannels + 1u) + EndMarker.size());
+	u8* out = result.data();
+
+	//Header
+	static constexpr std::array<u8, 4> MagicNumber{'q', 'o', 'i', 'f'};
+	out = std::ranges::copy(MagicNumber, out).out;
+	for(const u32 value : {width, height})
+	{
+		*out++ = Utils::Memory::GetByteFromInteger<3>(value);
+		*out++ = Utils::Memory::GetByteFromInteger<2>(value);
+		*out++ = Utils::Memory::GetByteFromInteger<1>(value);
+		*out++ = Utils::Memory::GetByteFromInteger<0>(value);
+	}
+	*out++ = outChannels;
+	*out++ = 0; //sRGB with linear alpha
+
+	switch(inChannels)
+	{
+	case 1u:
+		out = EncodeChunks<1u>(pixels.data(), pixelCount, out);
+		break;
+	case 2u:
+		out = EncodeChunks<2u>(pixels.data(), pixelCount, out);
+		break;
+	case 3u:
+		out = EncodeChunks<3u>(pixels.data(), pixelCount, out);
+		break;
+	default:
+		out = EncodeChunks<4u>(pixels.data(), pixelCount, out);
+		break;
+	}
+
+	out = std::ranges::copy(EndMarker, out).out;
+	result.resize(NumericCast<usize>(out - result.data()));
+
+	return result;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+bool TRAP::INTERNAL::QOIImage::Save(const Image* const img, const std::filesystem::path& filepath)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	const std::vector<u8> encoded = Encode(img);
+	if(encoded.empty())
+		return false;
+
+	return FileSystem::WriteFile(filepath, encoded);
+}
@@ -21,6 +21,9 @@ namespace TRAP::INTERNAL
 		/// @brief Constructor.
 		/// @param filepath File path of the image to load.
 		explicit QOIImage(std::filesystem::path filepath);
+		/// @brief Constructor.
+		/// @param data Encoded image data to load.
+		explicit QOIImage(std::span<const u8> data);
 		/// @brief Copy constructor.
 		QOIImage(const QOIImage&) noexcept = default;
 		/// @brief Copy assignment operator.
@@ -36,17 +39,33 @@ namespace TRAP::INTERNAL
 		/// @return Raw pixel data.
 		[[nodiscard]] constexpr std::span<const u8> GetPixelData() const noexcept override;
 
+		/// @brief Encode an TRAP::Image as Quite OK Image (QOI).
+		/// @param img Image to encode, only 8 bits per channel images are supported.
+		/// @return Encoded image on success, empty vector otherwise.
+		/// @note Grayscale images are expanded to RGB(A).
+		[[nodiscard]] static std::vector<u8> Encode(const Image* img);
+		/// @brief Save an TRAP::Image as a Quite OK Image (QOI) file.
+		/// @param img Image to save, only 8 bits per channel images are supported.
+		/// @param filepath File path to save the image to.
+		/// @return True on success, false otherwise.
+		static bool Save(const Image* img, const std::filesystem::path& filepath);
+
 	private:
-        /// @brief Decode the image QOI pixel data.
-        /// @param file Open file stream of the image.
-		/// @param fileSize Size of the file to decode.
-        void DecodeImage(std::ifstream& file, const usize& fileSize);
+		/// @brief Decode the image.
+		/// @param data Encoded image data.
+		void Decode(std::span<const u8> data);
+		/// @brief Decode the QOI chunks of the image.
+		/// @param chunks Chunk data following the header, including the end marker.
+		void DecodeImage(std::span<const u8> chunks);
 
 		std::vector<u8> m_data;
 
+		/// @brief Size of the header in the file.
+		static constexpr usize HeaderSize = 14;
+
 		struct Header
 		{
-            std::string MagicNumber = std::string(4, '\0');
+            std::array<char, 4> MagicNumber{};
 			u32 Width = 0;
 			u32 Height = 0;
             u8 Channels = 0;
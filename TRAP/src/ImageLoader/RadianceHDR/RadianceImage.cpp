@@ -3,6 +3,8 @@
 
 #include "Utils/String/String.h"
 #include "FileSystem/FileSystem.h"
+#include "FileSystem/MappedFile.h"
+#include "Utils/ByteReader.h"
 
 namespace
 {
@@ -10,21 +12,6 @@ namespace
 
 	//-------------------------------------------------------------------------------------------------------------------//
 
-	/// @brief Convert exponent and value to floating point.
-	/// As specified in the Radiance HDR specification.
-	/// @param exponent Exponent.
-	/// @param value Value.
-	/// @return Floating point value.
-	[[nodiscard]] constexpr f32 ConvertComponent(const i8 exponent, const i32 value)
-	{
-		const f32 v = NumericCast<f32>(value) / 256.0f;
-		const f32 d = TRAP::Math::Pow(2.0f, NumericCast<f32>(exponent));
-
-		return v * d;
-	}
-
-	//-------------------------------------------------------------------------------------------------------------------//
-
 	constexpr u32 MinEncodingLength = 8; //Minimum scanline length for encoding
 	constexpr u32 MaxEncodingLength = 0x7FFF; //Maximum scanline length for encoding
 	constexpr u32 R = 0;
@@ -37,9 +24,9 @@ namespace
 	/// @param scanline Storage for the decoded scanline.
 	/// @param scanlineIndex Start index for decoding.
 	/// @param length Scanline length.
-	/// @param file Open Radiance HDR file.
+	/// @param reader Reader positioned at the scanline data.
 	/// @return True if successful, false otherwise.
-	[[nodiscard]] bool OldDecrunch(std::vector<RGBE>& scanline, u32 scanlineIndex, u32 length, std::ifstream& file)
+	[[nodiscard]] bool OldDecrunch(std::vector<RGBE>& scanline, u32 scanlineIndex, u32 length, TRAP::Utils::ByteReader& reader)
 	{
 		ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
 
@@ -47,18 +34,25 @@ namespace
 
 		while (length > 0u)
 		{
-			scanline[scanlineIndex][R] = NumericCast<u8>(file.get());
-			scanline[scanlineIndex][G] = NumericCast<u8>(file.get());
-			scanline[scanlineIndex][B] = NumericCast<u8>(file.get());
-			scanline[scanlineIndex][E] = NumericCast<u8>(file.get());
-			if (file.eof())
+			scanline[scanlineIndex][R] = reader.ReadByte();
+			scanline[scanlineIndex][G] = reader.ReadByte();
+			scanline[scanlineIndex][B] = reader.ReadByte();
+			scanline[scanlineIndex][E] = reader.ReadByte();
+			if (reader.HasFailed())
 				return false;
 
 			if (scanline[scanlineIndex][R] == 1u &&
 				scanline[scanlineIndex][G] == 1u &&
 				scanline[scanlineIndex][B] == 1u)
 			{
-				for (u32 i = NumericCast<u32>(scanline[scanlineIndex][E] << rshift); i > 0u; i--)
+				//A run repeats the previous pixel and has to fit into the scanline
+				if (scanlineIndex == 0u || rshift >= 32u)
+					return false;
+				const u32 count = NumericCast<u32>(scanline[scanlineIndex][E]) << rshift;
+				if (count > length)
+					return false;
+
+				for (u32 i = count; i > 0u; i--)
 				{
 					memcpy(scanline[scanlineIndex].data(), scanline[scanlineIndex - 1].data(), 4u * sizeof(u8));
 					scanlineIndex++;
@@ -81,113 +75,117 @@ namespace
 	/// Used for RLE encoding and uncompressed data.
 	/// @param scanline Storage for the decoded scanline.
 	/// @param length Scanline length.
-	/// @param file Open Radiance HDR file.
+	/// @param reader Reader positioned at the scanline data.
 	/// @return True if successful, false otherwise.
-	[[nodiscard]] bool Decrunch(std::vector<RGBE>& scanline, const u32 length, std::ifstream& file)
+	[[nodiscard]] bool Decrunch(std::vector<RGBE>& scanline, const u32 length, TRAP::Utils::ByteReader& reader)
 	{
 		if (length < MinEncodingLength || length > MaxEncodingLength)
-			return OldDecrunch(scanline, 0u, length, file);
+			return OldDecrunch(scanline, 0u, length, reader);
 
-		i32 i = file.get();
-		if (i != 2)
-		{
-			file.seekg(-1, std::ios::cur);
-			return OldDecrunch(scanline, 0u, length, file);
-		}
+		if (reader.Peek() != 2u)
+			return OldDecrunch(scanline, 0u, length, reader);
 
-		scanline[0u][G] = NumericCast<u8>(file.get());
-		scanline[0u][B] = NumericCast<u8>(file.get());
-		i = file.get();
+		reader.Skip(1);
+		scanline[0u][G] = reader.ReadByte();
+		scanline[0u][B] = reader.ReadByte();
+		const u8 e = reader.ReadByte();
 
 		if (scanline[0u][G] != 2u || (scanline[0][B] & 128u) != 0u)
 		{
 			scanline[0u][R] = 2u;
-			scanline[0u][E] = NumericCast<u8>(i);
-			return OldDecrunch(scanline, 1u, length - 1u, file);
+			scanline[0u][E] = e;
+			return OldDecrunch(scanline, 1u, length - 1u, reader);
 		}
 
 		// read each component
-		for (i = 0; i < 4; i++)
+		for (usize i = 0; i < 4; i++)
 		{
 			for (u32 j = 0; j < length; )
 			{
-				u8 code = NumericCast<u8>(file.get());
-				if (code > 128u) //RLE
-				{
+				u8 code = reader.ReadByte();
+				const bool rle = code > 128u;
+				if (rle)
 					code &= 127u;
-					const u8 value = NumericCast<u8>(file.get());
+				//Empty or overlong packets only appear in truncated or corrupted data
+				if (code == 0u || code > length - j || reader.HasFailed())
+					return false;
+
+				if (rle)
+				{
+					const u8 value = reader.ReadByte();
 					while ((code--) != 0u)
-						scanline[j++][NumericCast<usize>(i)] = value;
+						scanline[j++][i] = value;
 				}
 				else //Dump
 				{
 					while((code--) != 0u)
-						scanline[j++][NumericCast<usize>(i)] = NumericCast<u8>(file.get());
+						scanline[j++][i] = reader.ReadByte();
 				}
 			}
 		}
 
-		return !file.eof();
+		return !reader.HasFailed();
 	}
 
 	//-------------------------------------------------------------------------------------------------------------------//
 
-	/// @brief Extract color values from the scanlines.
-	/// @param scanline Scanlines.
-	/// @param data Output storage for color data.
-	/// @param dataIndex Index in the output storage to store data at.
-	/// @param width Width in pixels of the image.
-	constexpr void WorkOnRGBE(std::vector<RGBE>& scanline, std::vector<f32>& data, u64 dataIndex, const u32 width)
+	/// @brief Extract color values from a decoded scanline.
+	/// As specified in the Radiance HDR specification, every component is (value / 256) * 2^(exponent - 128).
+	/// @tparam Channels Amount of output channels, 3 for RGB or 4 for RGBA with opaque alpha.
+	/// @param scanline Decoded scanline.
+	/// @param data Output storage for the color data, scanline.size() * Channels values.
+	template<u32 Channels>
+	requires (Channels == 3u || Channels == 4u)
+	void WorkOnRGBE(const std::vector<RGBE>& scanline, const std::span<f32> data)
 	{
-		u32 length = width;
-		u32 scanlineIndex = 0;
-
-		while (length-- > 0u)
+		for(usize i = 0; i < scanline.size(); ++i)
 		{
-			const i8 exponent = NumericCast<i8>(scanline[scanlineIndex][E] - 128);
-			data[0 + dataIndex] = ConvertComponent(exponent, scanline[scanlineIndex][R]);
-			data[1 + dataIndex] = ConvertComponent(exponent, scanline[scanlineIndex][G]);
-			data[2 + dataIndex] = ConvertComponent(exponent, scanline[scanlineIndex][B]);
-			dataIndex += 3;
-			scanlineIndex++;
+			//The exponent is shared by all components, build the scale directly from its bits when it is a normal float
+			const i32 exponent = NumericCast<i32>(scanline[i][E]) - 136;
+			const f32 scale = exponent > -127 ? std::bit_cast<f32>(NumericCast<u32>(exponent + 127) << 23u) :
+			                                    std::ldexp(1.0f, exponent);
+
+			data[i * Channels + 0u] = NumericCast<f32>(scanline[i][R]) * scale;
+			data[i * Channels + 1u] = NumericCast<f32>(scanline[i][G]) * scale;
+			data[i * Channels + 2u] = NumericCast<f32>(scanline[i][B]) * scale;
+			if constexpr(Channels == 4u)
+				data[i * Channels + 3u] = 1.0f;
 		}
 	}
 
 	//-------------------------------------------------------------------------------------------------------------------//
 
 	/// @brief Check if file contains the magic number "#?".
-	/// @param file File to check.
+	/// @param reader Reader positioned at the start of the file.
 	/// @return True if magic number was found, false otherwise.
-	[[nodiscard]] bool ContainsMagicNumber(std::ifstream& file)
+	[[nodiscard]] bool ContainsMagicNumber(TRAP::Utils::ByteReader& reader)
 	{
 		ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
 
 		//Magic Numbers: "#?RGBE" or "#?RADIANCE"
 		//Some software uses #? and then its own name... so we have to just check for #?
 
-		std::string tmp;
-		std::getline(file, tmp);
+		const TRAP::Optional<std::string_view> line = reader.ReadLine();
 
-		return TRAP::Utils::String::Contains(tmp, "#?");
+		return line && TRAP::Utils::String::Contains(*line, "#?");
 	}
 
 	//-------------------------------------------------------------------------------------------------------------------//
 
 	/// @brief Check if file contains a valid/known format.
 	/// Currently only "32-bit_rle_rgbe" is supported.
-	/// @param file File to check.
+	/// @param reader Reader positioned at the header lines.
 	/// @return True if valid/known format was found, false otherwise.
-	[[nodiscard]] bool ContainsSupportedFormat(std::ifstream& file)
+	[[nodiscard]] bool ContainsSupportedFormat(TRAP::Utils::ByteReader& reader)
 	{
 		ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
 
 		//We only support the "32-bit_rle_rgbe" format
 
-		std::string tmp{};
-		while(!file.eof())
+		while(!reader.IsEOF())
 		{
-			std::getline(file, tmp);
-			if(TRAP::Utils::String::Contains(tmp, "FORMAT=32-bit_rle_rgbe"))
+			const TRAP::Optional<std::string_view> line = reader.ReadLine();
+			if(line && TRAP::Utils::String::Contains(*line, "FORMAT=32-bit_rle_rgbe"))
 				return true;
 		}
 
@@ -197,31 +195,28 @@ namespace
 	//-------------------------------------------------------------------------------------------------------------------//
 
 	/// @brief Skip lines which are not used for decoding.
-	/// @param file File to skip lines.
-	void SkipUnusedLines(std::ifstream& file)
+	/// @param reader Reader positioned at the header lines.
+	void SkipUnusedLines(TRAP::Utils::ByteReader& reader)
 	{
 		ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
 
-		if(file.eof())
-			return;
-
-		std::string tmp{};
+		TRAP::Optional<std::string_view> line{};
 		do
 		{
-			std::getline(file, tmp);
-		} while(!tmp.empty());
+			line = reader.ReadLine();
+		} while(line && !line->empty());
 	}
 
 	//-------------------------------------------------------------------------------------------------------------------//
 
 	/// @brief Retrieve the resolution data from file.
-	/// @param file File to retrieve data from.
+	/// @param reader Reader positioned at the resolution line.
 	/// @param outNeedXFlip True if image needs to be flipped on X axis.
 	/// @param outNeedYFlip True if image needs to be flipped on Y axis.
 	/// @param outNeedRotateClockwise True if image needs to be rotated 90 degrees clockwise.
 	/// @param outNeedRotateCounterClockwise True if image needs to be rotated 90 degrees counter clockwise.
 	/// @return Image resolution on success, empty optional otherwise.
-	[[nodiscard]] std::optional<TRAP::Math::Vec2ui> RetrieveImageResolution(std::ifstream& file, bool& outNeedXFlip,
+	[[nodiscard]] std::optional<TRAP::Math::Vec2ui> RetrieveImageResolution(TRAP::Utils::ByteReader& reader, bool& outNeedXFlip,
 																			bool& outNeedYFlip,
 																			bool& outNeedRotateClockwise,
 																			bool& outNeedRotateCounterClockwise)
@@ -233,13 +228,12 @@ namespace
 		outNeedRotateClockwise = false;
 		outNeedRotateCounterClockwise = false;
 
-		std::string resStr{};
-		std::getline(file, resStr);
+		const std::string_view resStr = reader.ReadLine().ValueOr(std::string_view{});
 
 		usize yIndex = resStr.find("Y ");
 		usize xIndex = resStr.find("X ");
 
-		if(yIndex == std::string::npos || xIndex == std::string::npos ||
+		if(yIndex == std::string_view::npos || xIndex == std::string_view::npos ||
 		NumericCast<i64>(yIndex - 1) < 0 || NumericCast<i64>(xIndex - 1) < 0)
 		{
 			TP_ERROR(TRAP::Log::ImageRadiancePrefix, "Failed to retrieve image resolution!");
@@ -321,46 +315,71 @@ namespace
 
 //-------------------------------------------------------------------------------------------------------------------//
 
-TRAP::INTERNAL::RadianceImage::RadianceImage(std::filesystem::path filepath)
+TRAP::INTERNAL::RadianceImage::RadianceImage(std::filesystem::path filepath, const HDRPrecision precision)
 	: Image(std::move(filepath))
 {
 	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
 
-	m_isHDR = true;
-	m_bitsPerPixel = 96;
-	m_colorFormat = ColorFormat::RGB;
-
 	TP_DEBUG(Log::ImageRadiancePrefix, "Loading image: ", m_filepath);
 
 	if (!FileSystem::Exists(m_filepath))
 		return;
 
-	std::ifstream file(m_filepath, std::ios::binary);
-	if (!file.is_open())
+	const auto file = FileSystem::MapFile(m_filepath);
+	if (!file)
 	{
 		TP_ERROR(Log::ImageRadiancePrefix, "Couldn't open file path: ", m_filepath, "!");
 		TP_WARN(Log::ImageRadiancePrefix, "Using default image!");
 		return;
 	}
 
-	if(!ContainsMagicNumber(file))
+	Decode(file->GetData(), precision);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+TRAP::INTERNAL::RadianceImage::RadianceImage(const std::span<const u8> data, const HDRPrecision precision)
+	: Image("")
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	TP_DEBUG(Log::ImageRadiancePrefix, "Loading image from memory");
+
+	Decode(data, precision);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::INTERNAL::RadianceImage::Decode(const std::span<const u8> data, const HDRPrecision precision)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	const bool halfFloat = precision == HDRPrecision::Float16;
+
+	m_isHDR = true;
+	m_bitsPerPixel = halfFloat ? 64 : 96;
+	m_colorFormat = halfFloat ? ColorFormat::RGBA : ColorFormat::RGB;
+
+	Utils::ByteReader reader(data);
+
+	if(!ContainsMagicNumber(reader))
 	{
 		TP_ERROR(Log::ImageRadiancePrefix, "Couldn't find magic number \"#?\"!");
 		TP_WARN(Log::ImageRadiancePrefix, "Using default image!");
 		return;
 	}
 
-	if(!ContainsSupportedFormat(file))
+	if(!ContainsSupportedFormat(reader))
 	{
 		TP_ERROR(Log::ImageRadiancePrefix, "Unknown or unsupported file format!");
 		TP_WARN(Log::ImageRadiancePrefix, "Using default image!");
 		return;
 	}
 
-	SkipUnusedLines(file);
+	SkipUnusedLines(reader);
 
 	bool needXFlip = false, needYFlip = false, need90RotateCW = false, need90RotateCCW = false;
-	const std::optional<TRAP::Math::Vec2ui> resolution = RetrieveImageResolution(file, needXFlip, needYFlip,
+	const std::optional<TRAP::Math::Vec2ui> resolution = RetrieveImageResolution(reader, needXFlip, needYFlip,
 	                                                                             need90RotateCW, need90RotateCCW);
 	if(!resolution)
 	{
@@ -373,48 +392,71 @@ TRAP::INTERNAL::RadianceImage::RadianceImage(std::filesystem::path filepath)
 
 	if(m_width == 0)
 	{
-		file.close();
 		TP_ERROR(Log::ImageRadiancePrefix, "Invalid width ", m_width, "!");
 		TP_WARN(Log::ImageRadiancePrefix, "Using default image!");
 		return;
 	}
 	if(m_height == 0)
 	{
-
-		file.close();
 		TP_ERROR(Log::ImageRadiancePrefix, "Invalid height ", m_height, "!");
 		TP_WARN(Log::ImageRadiancePrefix, "Using default image!");
 		return;
 	}
 
-	m_data.resize(NumericCast<usize>(m_width) * m_height * std::to_underlying(m_colorFormat), 0.0f);
-	u64 dataIndex = 0;
+	const usize rowSize = NumericCast<usize>(m_width) * std::to_underlying(m_colorFormat);
+	if(halfFloat)
+		m_dataHalf.resize(rowSize * m_height);
+	else
+		m_data.resize(rowSize * m_height, 0.0f);
 
 	std::vector<RGBE> scanline(m_width);
+	//Half floats are converted per scanline while the decoded floats are still in cache
+	std::vector<f32> rgba(halfFloat ? rowSize : 0u);
 
 	//Convert image
-	for(i64 y = m_height - 1; y >= 0; y--)
+	for(u32 y = 0; y < m_height; ++y)
 	{
-		if (!Decrunch(scanline, m_width, file))
+		if (!Decrunch(scanline, m_width, reader))
 		{
 			m_data.clear();
+			m_dataHalf.clear();
 			TP_ERROR(Log::ImageRadiancePrefix, "Decrunching failed!");
 			TP_WARN(Log::ImageRadiancePrefix, "Using default image!");
 			return;
 		}
-		WorkOnRGBE(scanline, m_data, dataIndex, m_width);
-		dataIndex += NumericCast<u64>(m_width) * std::to_underlying(m_colorFormat);
+
+		if(halfFloat)
+		{
+			WorkOnRGBE<4>(scanline, rgba);
+			ConvertF32ToF16(rgba, std::span(m_dataHalf).subspan(y * rowSize, rowSize));
+		}
+		else
+			WorkOnRGBE<3>(scanline, std::span(m_data).subspan(y * rowSize, rowSize));
 	}
 
-	file.close();
+	const auto orientate = [&](auto& pixelData)
+	{
+		using T = typename std::remove_reference_t<decltype(pixelData)>::value_type;
 
-	if (needXFlip)
-		m_data = FlipX<f32>(m_width, m_height, m_colorFormat, m_data);
-	if (needYFlip)
-		m_data = FlipY<f32>(m_width, m_height, m_colorFormat, m_data);
+		if (needXFlip)
+			pixelData = FlipX<T>(m_width, m_height, m_colorFormat, pixelData);
+		if (needYFlip)
+			pixelData = FlipY<T>(m_width, m_height, m_colorFormat, pixelData);
+
+		if(need90RotateCW)
+		{
+			pixelData = Rotate90Clockwise<T>(m_width, m_height, m_colorFormat, pixelData);
+			std::swap(m_width, m_height);
+		}
+		if(need90RotateCCW)
+		{
+			pixelData = Rotate90CounterClockwise<T>(m_width, m_height, m_colorFormat, pixelData);
+			std::swap(m_width, m_height);
+		}
+	};
 
-	if(need90RotateCW)
-		m_data = Rotate90Clockwise<f32>(m_width, m_height, m_colorFormat, m_data);
-	if(need90RotateCCW)
-		m_data = Rotate90CounterClockwise<f32>(m_width, m_height, m_colorFormat, m_data);
+	if(halfFloat)
+		orientate(m_dataHalf);
+	else
+		orientate(m_data);
 }
@@ -2,6 +2,8 @@
 #include "TGAImage.h"
 
 #include "FileSystem/FileSystem.h"
+#include "FileSystem/MappedFile.h"
+#include "Utils/ByteReader.h"
 #include "Utils/Memory.h"
 #include "Utils/Utils.h"
 
@@ -70,6 +72,10 @@ namespace
 			if ((count * channels + l) > (width * height * channels))
 				count = (width * height * channels - l) / channels;
 
+			//Stop on truncated data, the caller treats an empty result as a failed load
+			if ((i + (raw ? count : 1u)) > source.size())
+				return {};
+
 			for (u32 j = 0; j < count; j++)
 			{
 				if (channels == 1)
@@ -107,6 +113,10 @@ namespace
 				i++;
 		}
 
+		//Stop on truncated data that ends between two packets
+		if (index < data.size())
+			return {};
+
 		return data;
 	}
 
@@ -140,6 +150,10 @@ namespace
 			if ((count + l) > (width * height))
 				count = width * height - l;
 
+			//Stop on truncated data, the caller treats an empty result as a failed load
+			if ((i + (raw ? count : 1u)) > source.size())
+				return {};
+
 			for (u32 j = 0; j < count; j++)
 			{
 				data[index++] = source[i];
@@ -152,6 +166,10 @@ namespace
 				i++;
 		}
 
+		//Stop on truncated data that ends between two packets
+		if (index < data.size())
+			return {};
+
 		return data;
 	}
 
@@ -184,6 +202,10 @@ namespace
 			if ((count * 3 + l) > (width * height * 3))
 				count = (width * height * 3 - l) / 3;
 
+			//Stop on truncated data, the caller treats an empty result as a failed load
+			if ((i + (raw ? count : 1u) * 2u) > source.size())
+				return {};
+
 			for (u32 j = 0; j < count; j++)
 			{
 				data[index++] = NumericCast<u8>(source[i + 1u] << 1u) & 0xF8u;
@@ -198,6 +220,10 @@ namespace
 				i += 2;
 		}
 
+		//Stop on truncated data that ends between two packets
+		if (index < data.size())
+			return {};
+
 		return data;
 	}
 
@@ -230,6 +256,10 @@ namespace
 			if ((count * 3 + l) > (width * height * 3))
 				count = (width * height * 3 - l) / 3;
 
+			//Stop on truncated data, the caller treats an empty result as a failed load
+			if ((i + (raw ? count : 1u) * 3u) > source.size())
+				return {};
+
 			for (u32 j = 0; j < count; j++)
 			{
 				data[index++] = source[i + 2]; //Red
@@ -244,6 +274,10 @@ namespace
 				i += 3;
 		}
 
+		//Stop on truncated data that ends between two packets
+		if (index < data.size())
+			return {};
+
 		return data;
 	}
 
@@ -276,6 +310,10 @@ namespace
 			if ((count * 4 + l) > (width * height * 4))
 				count = (width * height * 4 - l) / 4;
 
+			//Stop on truncated data, the caller treats an empty result as a failed load
+			if ((i + (raw ? count : 1u) * 4u) > source.size())
+				return {};
+
 			for (u32 j = 0; j < count; j++)
 			{
 				data[index++] = source[i + 2]; //Red
@@ -291,6 +329,10 @@ namespace
 				i += 4;
 		}
 
+		//Stop on truncated data that ends between two packets
+		if (index < data.size())
+			return {};
+
 		return data;
 	}
 }
@@ -307,29 +349,52 @@ TRAP::INTERNAL::TGAImage::TGAImage(std::filesystem::path filepath)
 	if (!FileSystem::Exists(m_filepath))
 		return;
 
-	std::ifstream file(m_filepath, std::ios::binary);
-	if (!file.is_open())
+	const auto file = FileSystem::MapFile(m_filepath);
+	if (!file)
 	{
 		TP_ERROR(Log::ImageTGAPrefix, "Couldn't open file path: ", m_filepath, "!");
 		TP_WARN(Log::ImageTGAPrefix, "Using default image!");
 		return;
 	}
 
+	Decode(file->GetData());
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+TRAP::INTERNAL::TGAImage::TGAImage(const std::span<const u8> data)
+	: Image("")
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	TP_DEBUG(Log::ImageTGAPrefix, "Loading image from memory");
+
+	Decode(data);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::INTERNAL::TGAImage::Decode(const std::span<const u8> data)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	Utils::ByteReader reader(data);
+
 	//Start TGA Loading here
 	Header header{};
 
-	header.IDLength = NumericCast<u8>(file.get());
-	header.ColorMapType = NumericCast<u8>(file.get());
-	header.ImageType = NumericCast<u8>(file.get());
-	file.read(reinterpret_cast<char*>(&header.ColorMapOffset), sizeof(u16));
-	file.read(reinterpret_cast<char*>(&header.NumOfColorMaps), sizeof(u16));
-	header.ColorMapDepth = NumericCast<u8>(file.get());
-	file.read(reinterpret_cast<char*>(&header.XOffset), sizeof(u16));
-	file.read(reinterpret_cast<char*>(&header.YOffset), sizeof(u16));
-	file.read(reinterpret_cast<char*>(&header.Width), sizeof(u16));
-	file.read(reinterpret_cast<char*>(&header.Height), sizeof(u16));
-	header.BitsPerPixel = NumericCast<u8>(file.get());
-	header.ImageDescriptor = NumericCast<u8>(file.get());
+	header.IDLength = reader.ReadByte();
+	header.ColorMapType = reader.ReadByte();
+	header.ImageType = reader.ReadByte();
+	reader.Read(header.ColorMapOffset);
+	reader.Read(header.NumOfColorMaps);
+	header.ColorMapDepth = reader.ReadByte();
+	reader.Read(header.XOffset);
+	reader.Read(header.YOffset);
+	reader.Read(header.Width);
+	reader.Read(header.Height);
+	header.BitsPerPixel = reader.ReadByte();
+	header.ImageDescriptor = reader.ReadByte();
 
 	//File uses little-endian
 	//Convert to machines endian
@@ -347,7 +412,6 @@ TRAP::INTERNAL::TGAImage::TGAImage(std::filesystem::path filepath)
 
 	if (header.ImageType == 0)
 	{
-		file.close();
 		TP_ERROR(Log::ImageTGAPrefix, "Image doesn't contain pixel data!");
 		TP_WARN(Log::ImageTGAPrefix, "Using default image!");
 		return;
@@ -355,15 +419,13 @@ TRAP::INTERNAL::TGAImage::TGAImage(std::filesystem::path filepath)
 	if (header.IDLength != 0)
 	{
 		colorMapData.ImageID.resize(header.IDLength);
-		file.read(colorMapData.ImageID.data(), header.IDLength);
+		reader.Read(Utils::AsWritableBytes(std::span(colorMapData.ImageID)));
 	}
 	if (header.ColorMapType == 1)
 	{
 		colorMapData.ColorMap.resize(NumericCast<usize>(header.ColorMapDepth / 8) * header.NumOfColorMaps);
-		if(!file.read(reinterpret_cast<char*>(colorMapData.ColorMap.data()),
-		              NumericCast<std::streamsize>(header.ColorMapDepth / 8) * header.NumOfColorMaps))
+		if(!reader.Read(colorMapData.ColorMap))
 		{
-			file.close();
 			TP_ERROR(Log::ImageTGAPrefix, "Couldn't load color map!");
 			TP_WARN(Log::ImageTGAPrefix, "Using default image!");
 			return;
@@ -371,7 +433,6 @@ TRAP::INTERNAL::TGAImage::TGAImage(std::filesystem::path filepath)
 	}
 	if(header.BitsPerPixel == 15)
 	{
-		file.close();
 		TP_ERROR(Log::ImageTGAPrefix, "Bits per pixel 15 is unsupported!");
 		TP_WARN(Log::ImageTGAPrefix, "Using default image!");
 		return;
@@ -386,34 +447,31 @@ TRAP::INTERNAL::TGAImage::TGAImage(std::filesystem::path filepath)
 		needYFlip = true;
 	if (header.Width < 2)
 	{
-		file.close();
 		TP_ERROR(Log::ImageTGAPrefix, "Image width ", header.Width, " is invalid or unsupported!");
 		TP_WARN(Log::ImageTGAPrefix, "Using default image!");
 		return;
 	}
 	if(header.Height < 2)
 	{
-		file.close();
 		TP_ERROR(Log::ImageTGAPrefix, "Image height ", header.Height, " is invalid or unsupported!");
 		TP_WARN(Log::ImageTGAPrefix, "Using default image!");
 		return;
 	}
 	if(header.ImageType == 9 || header.ImageType == 11 || header.ImageType == 10) //All RLE formats
 	{
-		const u32 currentPosition = static_cast<u32>(file.tellg()); //Store current position in file
-		file.seekg(0, std::ios::end); //Go to the end of file
-		u32 pixelDataSize = static_cast<u32>(file.tellg()) - currentPosition;
-		file.seekg(-18, std::ios::end); //Check if there is a footer
-		std::string offsetCheck(16, '\0');
-		file.read(offsetCheck.data(), 16);
-		if (offsetCheck == "TRUEVISION-XFILE")
-			pixelDataSize -= 26; //If a footer was found subtract the 26 bytes from pixelDataSize
-		file.seekg(currentPosition); //Go back to starting position
+		usize pixelDataSize = reader.GetRemainingSize();
+		//Check if there is a footer
+		static constexpr std::string_view FooterSignature = "TRUEVISION-XFILE";
+		if(pixelDataSize >= 26)
+		{
+			const std::span<const u8> signature = reader.GetRemainingData().last(18).first(FooterSignature.size());
+			if (std::ranges::equal(signature, FooterSignature))
+				pixelDataSize -= 26; //If a footer was found subtract the 26 bytes from pixelDataSize
+		}
 
 		colorMapData.ImageData.resize(pixelDataSize);
-		if (!file.read(reinterpret_cast<char*>(colorMapData.ImageData.data()), pixelDataSize))
+		if (!reader.Read(colorMapData.ImageData))
 		{
-			file.close();
 			TP_ERROR(Log::ImageTGAPrefix, "Couldn't read pixel data!");
 			TP_WARN(Log::ImageTGAPrefix, "Using default image!");
 			return;
@@ -423,18 +481,14 @@ TRAP::INTERNAL::TGAImage::TGAImage(std::filesystem::path filepath)
 	{
 		colorMapData.ImageData.resize(NumericCast<usize>(header.Width) * header.Height *
 		                              (header.BitsPerPixel / 8));
-		if (!file.read(reinterpret_cast<char*>(colorMapData.ImageData.data()),
-		                                       NumericCast<std::streamsize>(header.Width) *
-											   header.Height * (header.BitsPerPixel / 8)))
+		if (!reader.Read(colorMapData.ImageData))
 		{
-			file.close();
 			TP_ERROR(Log::ImageTGAPrefix, "Couldn't read pixel data!");
 			TP_WARN(Log::ImageTGAPrefix, "Using default image!");
 			return;
 		}
 	}
 
-	file.close();
 
 	m_width = header.Width;
 	m_height = header.Height;
@@ -537,14 +591,14 @@ TRAP::INTERNAL::TGAImage::TGAImage(std::filesystem::path filepath)
 		case 24:
 		{
 			m_colorFormat = ColorFormat::RGB;
-			m_data = ConvertBGR24ToRGB24(colorMapData.ImageData, m_width, m_height);
+			m_data = ConvertBGR24ToRGB24(std::move(colorMapData.ImageData), m_width, m_height);
 			break;
 		}
 
 		case 32:
 		{
 			m_colorFormat = ColorFormat::RGBA;
-			m_data = ConvertBGRA32ToRGBA32(colorMapData.ImageData, m_width, m_height);
+			m_data = ConvertBGRA32ToRGBA32(std::move(colorMapData.ImageData), m_width, m_height);
 			break;
 		}
 
@@ -601,8 +655,15 @@ TRAP::INTERNAL::TGAImage::TGAImage(std::filesystem::path filepath)
 		return;
 	}
 
+	if (m_data.empty())
+	{
+		TP_ERROR(Log::ImageTGAPrefix, "Couldn't decode pixel data!");
+		TP_WARN(Log::ImageTGAPrefix, "Using default image!");
+		return;
+	}
+
 	if (needXFlip)
-		m_data = FlipX<u8>(m_width, m_height, m_colorFormat, m_data);
+		INTERNAL::FlipPixelsX(m_data, m_data, m_width, m_height, std::to_underlying(m_colorFormat));
 	if (needYFlip)
-		m_data = FlipY<u8>(m_width, m_height, m_colorFormat, m_data);
+		INTERNAL::FlipPixelsY(m_data, m_data, m_width, m_height, std::to_underlying(m_colorFormat));
 }
@@ -11,6 +11,9 @@ namespace TRAP::INTERNAL
 		/// @brief Constructor.
 		/// @param filepath File path of the image to load.
 		explicit TGAImage(std::filesystem::path filepath);
+		/// @brief Constructor.
+		/// @param data Encoded image data to load.
+		explicit TGAImage(std::span<const u8> data);
 		/// @brief Copy constructor.
 		TGAImage(const TGAImage&) noexcept = default;
 		/// @brief Copy assignment operator.
@@ -26,6 +29,10 @@ namespace TRAP::INTERNAL
 		/// @return Raw pixel data.
 		[[nodiscard]] constexpr std::span<const u8> GetPixelData() const noexcept override;
 	private:
+		/// @brief Decode the image.
+		/// @param data Encoded image data.
+		void Decode(std::span<const u8> data);
+
 		std::vector<u8> m_data;
 	};
 }
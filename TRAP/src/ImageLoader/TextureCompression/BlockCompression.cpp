@@ -0,0 +1,899 @@
+#include "TRAPPCH.h"
+#include "BlockCompression.h"
+
+#include "ThreadPool/Parallel.h"
+#include "TRAP_Assert.h"
+#include "Utils/Optional.h"
+#include "Utils/Utils.h"
+
+#include <immintrin.h>
+
+namespace
+{
+	using BlockCompressionImplementation = TRAP::INTERNAL::BlockCompressionImplementation;
+
+	constexpr usize PixelsPerBlock = 16;
+
+	/// @brief 4x4 block of pixels in structure of arrays layout, channel values are in [0, 255].
+	/// @tparam N Number of channels, 3 (RGB) or 4 (RGBA).
+	template<usize N>
+	struct Pixels
+	{
+		alignas(32) std::array<std::array<f32, PixelsPerBlock>, N> Channels{};
+	};
+
+	template<usize N>
+	using Color = std::array<f32, N>;
+
+	/// @brief Result of encoding a block with a single pair of endpoints.
+	struct EndpointFit
+	{
+		std::array<u8, PixelsPerBlock> Indices{};
+		f32 Error = std::numeric_limits<f32>::max();
+	};
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	TRAP_TARGET_ISA("avx2")
+	[[nodiscard]] f32 HorizontalSum(const __m256 v) noexcept
+	{
+		__m128 sum = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+		sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+		sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 0x55));
+		return _mm_cvtss_f32(sum);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Convert 16 RGBA8 pixels to structure of arrays floating point.
+	template<usize N>
+	[[nodiscard]] Pixels<N> LoadPixelsScalar(const std::span<const u8, 64> rgba) noexcept
+	{
+		Pixels<N> pixels{};
+
+		for(usize i = 0; i < PixelsPerBlock; ++i)
+		{
+			for(usize c = 0; c < N; ++c)
+				pixels.Channels[c][i] = static_cast<f32>(rgba[i * 4u + c]);
+		}
+
+		return pixels;
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Convert 16 RGBA8 pixels to structure of arrays floating point using AVX2.
+	template<usize N>
+	TRAP_TARGET_ISA("avx2")
+	[[nodiscard]] Pixels<N> LoadPixelsAVX2(const std::span<const u8, 64> rgba) noexcept
+	{
+		Pixels<N> pixels{};
+
+		const __m256i byteMask = _mm256_set1_epi32(0xFF);
+		for(usize half = 0; half < 2; ++half)
+		{
+			//Every pixel is a little endian u32 with red in the lowest byte
+			const __m256i packed = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rgba.data() + half * 32u));
+			for(usize c = 0; c < N; ++c)
+			{
+				const __m256i channel = _mm256_and_si256(_mm256_srlv_epi32(packed, _mm256_set1_epi32(NumericCast<i32>(c * 8u))), byteMask);
+				_mm256_store_ps(pixels.Channels[c].data() + half * 8u, _mm256_cvtepi32_ps(channel));
+			}
+		}
+
+		return pixels;
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Convert 16 RGBA8 pixels to structure of arrays floating point.
+	/// @param rgba Pixels of the block in row-major order.
+	/// @param impl Implementation to use.
+	template<usize N>
+	[[nodiscard]] Pixels<N> LoadPixels(const std::span<const u8, 64> rgba, const BlockCompressionImplementation impl) noexcept
+	{
+		if(impl == BlockCompressionImplementation::AVX2)
+			return LoadPixelsAVX2<N>(rgba);
+
+		return LoadPixelsScalar<N>(rgba);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Find the nearest palette entry for every pixel.
+	/// @param pixels Block pixels.
+	/// @param palette Palette to choose from.
+	/// @param indices Output for the palette index of every pixel.
+	/// @param distances Output for the squared distance of every pixel to its palette entry.
+	template<usize N>
+	void SelectIndicesScalar(const Pixels<N>& pixels, const std::span<const Color<N>> palette,
+	                         std::array<u8, PixelsPerBlock>& indices, std::array<f32, PixelsPerBlock>& distances) noexcept
+	{
+		for(usize i = 0; i < PixelsPerBlock; ++i)
+		{
+			f32 bestDistance = std::numeric_limits<f32>::max();
+			usize bestIndex = 0;
+
+			for(usize k = 0; k < palette.size(); ++k)
+			{
+				f32 distance = 0.0f;
+				for(usize c = 0; c < N; ++c)
+				{
+					const f32 diff = pixels.Channels[c][i] - palette[k][c];
+					distance += diff * diff;
+				}
+
+				if(distance < bestDistance)
+				{
+					bestDistance = distance;
+					bestIndex = k;
+				}
+			}
+
+			indices[i] = static_cast<u8>(bestIndex);
+			distances[i] = bestDistance;
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Find the nearest palette entry for every pixel using AVX2, 8 pixels at a time.
+	/// @param pixels Block pixels.
+	/// @param palette Palette to choose from.
+	/// @param indices Output for the palette index of every pixel.
+	/// @param distances Output for the squared distance of every pixel to its palette entry.
+	template<usize N>
+	TRAP_TARGET_ISA("avx2")
+	void SelectIndicesAVX2(const Pixels<N>& pixels, const std::span<const Color<N>> palette,
+	                       std::array<u8, PixelsPerBlock>& indices, std::array<f32, PixelsPerBlock>& distances) noexcept
+	{
+		for(usize half = 0; half < 2; ++half)
+		{
+			__m256 bestDistance = _mm256_set1_ps(std::numeric_limits<f32>::max());
+			__m256 bestIndex = _mm256_setzero_ps();
+
+			for(usize k = 0; k < palette.size(); ++k)
+			{
+				__m256 distance = _mm256_setzero_ps();
+				for(usize c = 0; c < N; ++c)
+				{
+					const __m256 diff = _mm256_sub_ps(_mm256_load_ps(pixels.Channels[c].data() + half * 8u),
+					                                  _mm256_set1_ps(palette[k][c]));
+					distance = _mm256_add_ps(distance, _mm256_mul_ps(diff, diff));
+				}
+
+				const __m256 closer = _mm256_cmp_ps(distance, bestDistance, _CMP_LT_OQ);
+				bestDistance = _mm256_blendv_ps(bestDistance, distance, closer);
+				bestIndex = _mm256_blendv_ps(bestIndex, _mm256_set1_ps(static_cast<f32>(k)), closer);
+			}
+
+			alignas(32) std::array<i32, 8> halfIndices{};
+			_mm256_store_si256(reinterpret_cast<__m256i*>(halfIndices.data()), _mm256_cvttps_epi32(bestIndex));
+			_mm256_storeu_ps(distances.data() + half * 8u, bestDistance);
+			for(usize i = 0; i < halfIndices.size(); ++i)
+				indices[half * 8u + i] = static_cast<u8>(halfIndices[i]);
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Find the nearest palette entry for every pixel.
+	/// @param pixels Block pixels.
+	/// @param palette Palette to choose from.
+	/// @param indices Output for the palette index of every pixel.
+	/// @param distances Output for the squared distance of every pixel to its palette entry.
+	/// @param impl Implementation to use.
+	template<usize N>
+	void SelectIndices(const Pixels<N>& pixels, const std::span<const Color<N>> palette,
+	                   std::array<u8, PixelsPerBlock>& indices, std::array<f32, PixelsPerBlock>& distances,
+	                   const BlockCompressionImplementation impl) noexcept
+	{
+		if(impl == BlockCompressionImplementation::AVX2)
+			SelectIndicesAVX2<N>(pixels, palette, indices, distances);
+		else
+			SelectIndicesScalar<N>(pixels, palette, indices, distances);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Compute the mean of the pixels with a non zero weight.
+	template<usize N>
+	[[nodiscard]] Color<N> ComputeMeanScalar(const Pixels<N>& pixels, const std::array<f32, PixelsPerBlock>& weights) noexcept
+	{
+		const f32 totalWeight = std::accumulate(weights.begin(), weights.end(), 0.0f);
+
+		Color<N> mean{};
+		for(usize c = 0; c < N; ++c)
+		{
+			f32 sum = 0.0f;
+			for(usize i = 0; i < PixelsPerBlock; ++i)
+				sum += pixels.Channels[c][i] * weights[i];
+			mean[c] = sum / totalWeight;
+		}
+
+		return mean;
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Compute the mean of the pixels with a non zero weight using AVX2.
+	template<usize N>
+	TRAP_TARGET_ISA("avx2")
+	[[nodiscard]] Color<N> ComputeMeanAVX2(const Pixels<N>& pixels, const std::array<f32, PixelsPerBlock>& weights) noexcept
+	{
+		const __m256 weights0 = _mm256_loadu_ps(weights.data());
+		const __m256 weights1 = _mm256_loadu_ps(weights.data() + 8u);
+		const f32 totalWeight = HorizontalSum(_mm256_add_ps(weights0, weights1));
+
+		Color<N> mean{};
+		for(usize c = 0; c < N; ++c)
+		{
+			const __m256 sum = _mm256_add_ps(_mm256_mul_ps(_mm256_load_ps(pixels.Channels[c].data()), weights0),
+			                                 _mm256_mul_ps(_mm256_load_ps(pixels.Channels[c].data() + 8u), weights1));
+			mean[c] = HorizontalSum(sum) / totalWeight;
+		}
+
+		return mean;
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Compute the mean of the pixels with a non zero weight.
+	template<usize N>
+	[[nodiscard]] Color<N> ComputeMean(const Pixels<N>& pixels, const std::array<f32, PixelsPerBlock>& weights,
+	                                   const BlockCompressionImplementation impl) noexcept
+	{
+		if(impl == BlockCompressionImplementation::AVX2)
+			return ComputeMeanAVX2<N>(pixels, weights);
+
+		return ComputeMeanScalar<N>(pixels, weights);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Compute the principal axis of the pixels via power iteration on the covariance matrix.
+	/// @return Normalized axis or a zero vector if all pixels have the same color.
+	template<usize N>
+	[[nodiscard]] Color<N> ComputePrincipalAxis(const Pixels<N>& pixels, const std::array<f32, PixelsPerBlock>& weights,
+	                                            const Color<N>& mean) noexcept
+	{
+		std::array<std::array<f32, N>, N> covariance{};
+		for(usize i = 0; i < PixelsPerBlock; ++i)
+		{
+			Color<N> centered{};
+			for(usize c = 0; c < N; ++c)
+				centered[c] = pixels.Channels[c][i] - mean[c];
+
+			for(usize row = 0; row < N; ++row)
+			{
+				for(usize col = row; col < N; ++col)
+					covariance[row][col] += centered[row] * centered[col] * weights[i];
+			}
+		}
+		for(usize row = 1; row < N; ++row)
+		{
+			for(usize col = 0; col < row; ++col)
+				covariance[row][col] = covariance[col][row];
+		}
+
+		//Start with the row of the channel with the biggest variance
+		usize biggest = 0;
+		for(usize c = 1; c < N; ++c)
+		{
+			if(covariance[c][c] > covariance[biggest][biggest])
+				biggest = c;
+		}
+		Color<N> axis = covariance[biggest];
+
+		for(u32 iteration = 0; iteration < 8; ++iteration)
+		{
+			Color<N> next{};
+			f32 maxComponent = 0.0f;
+			for(usize row = 0; row < N; ++row)
+			{
+				for(usize col = 0; col < N; ++col)
+					next[row] += covariance[row][col] * axis[col];
+				maxComponent = std::max(maxComponent, std::abs(next[row]));
+			}
+
+			if(maxComponent < 1e-6f)
+				return Color<N>{};
+
+			for(usize c = 0; c < N; ++c)
+				axis[c] = next[c] / maxComponent;
+		}
+
+		f32 length = 0.0f;
+		for(const f32 component : axis)
+			length += component * component;
+		length = std::sqrt(length);
+
+		for(f32& component : axis)
+			component /= length;
+
+		return axis;
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Initial endpoints, the extremes of the pixels projected onto the principal axis.
+	template<usize N>
+	[[nodiscard]] std::pair<Color<N>, Color<N>> ComputeInitialEndpoints(const Pixels<N>& pixels,
+	                                                                  const std::array<f32, PixelsPerBlock>& weights,
+	                                                                  const BlockCompressionImplementation impl)
+	{
+		const Color<N> mean = ComputeMean(pixels, weights, impl);
+		const Color<N> axis = ComputePrincipalAxis(pixels, weights, mean);
+
+		f32 minProjection = std::numeric_limits<f32>::max();
+		f32 maxProjection = std::numeric_limits<f32>::lowest();
+		for(usize i = 0; i < PixelsPerBlock; ++i)
+		{
+			if(weights[i] == 0.0f)
+				continue;
+
+			f32 projection = 0.0f;
+			for(usize c = 0; c < N; ++c)
+				projection += (pixels.Channels[c][i] - mean[c]) * axis[c];
+
+			minProjection = std::min(minProjection, projection);
+			maxProjection = std::max(maxProjection, projection);
+		}
+
+		std::pair<Color<N>, Color<N>> endpoints{};
+		for(usize c = 0; c < N; ++c)
+		{
+			endpoints.first[c] = std::clamp(mean[c] + axis[c] * minProjection, 0.0f, 255.0f);
+			endpoints.second[c] = std::clamp(mean[c] + axis[c] * maxProjection, 0.0f, 255.0f);
+		}
+
+		return endpoints;
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Compute the endpoints which minimize the squared error for fixed indices (least squares).
+	/// @param pixels Block pixels.
+	/// @param weights Weight of every pixel, 0 to ignore a pixel.
+	/// @param indices Palette index of every pixel.
+	/// @param interpolation Interpolation factor towards the second endpoint for every palette index.
+	/// @return Refined endpoints, empty if the system is singular (i.e. only a single palette entry is used).
+	template<usize N>
+	[[nodiscard]] TRAP::Optional<std::pair<Color<N>, Color<N>>> RefineEndpoints(const Pixels<N>& pixels,
+	                                                                           const std::array<f32, PixelsPerBlock>& weights,
+	                                                                           const std::array<u8, PixelsPerBlock>& indices,
+	                                                                           const std::span<const f32> interpolation)
+	{
+		f32 a = 0.0f;
+		f32 b = 0.0f;
+		f32 c = 0.0f;
+		Color<N> x{};
+		Color<N> y{};
+		for(usize i = 0; i < PixelsPerBlock; ++i)
+		{
+			const f32 t = interpolation[indices[i]];
+			const f32 s = 1.0f - t;
+
+			a += s * s * weights[i];
+			b += t * t * weights[i];
+			c += s * t * weights[i];
+			for(usize ch = 0; ch < N; ++ch)
+			{
+				x[ch] += s * pixels.Channels[ch][i] * weights[i];
+				y[ch] += t * pixels.Channels[ch][i] * weights[i];
+			}
+		}
+
+		const f32 determinant = a * b - c * c;
+		if(std::abs(determinant) < 1e-6f)
+			return TRAP::NullOpt;
+
+		std::pair<Color<N>, Color<N>> endpoints{};
+		for(usize ch = 0; ch < N; ++ch)
+		{
+			endpoints.first[ch] = std::clamp((b * x[ch] - c * y[ch]) / determinant, 0.0f, 255.0f);
+			endpoints.second[ch] = std::clamp((a * y[ch] - c * x[ch]) / determinant, 0.0f, 255.0f);
+		}
+
+		return endpoints;
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Fit endpoints to the block, starting at the principal axis followed by least squares refinement.
+	/// @param pixels Block pixels.
+	/// @param weights Weight of every pixel, 0 to ignore a pixel.
+	/// @param evaluate Quantizes a pair of endpoints and fills in the indices and error of the fit.
+	/// @param interpolation Interpolation factor towards the second endpoint for every palette index.
+	/// @param impl Implementation to use.
+	/// @return Best fit found.
+	template<usize N, typename Fit, typename F>
+	[[nodiscard]] Fit FitEndpoints(const Pixels<N>& pixels, const std::array<f32, PixelsPerBlock>& weights, F&& evaluate,
+	                               const std::span<const f32> interpolation, const BlockCompressionImplementation impl)
+	{
+		static constexpr u32 RefinementIterations = 2;
+
+		const auto [initial0, initial1] = ComputeInitialEndpoints(pixels, weights, impl);
+		Fit best = evaluate(initial0, initial1);
+
+		for(u32 iteration = 0; iteration < RefinementIterations && best.Fit.Error > 0.0f; ++iteration)
+		{
+			const auto refined = RefineEndpoints(pixels, weights, best.Fit.Indices, interpolation);
+			if(!refined)
+				break;
+
+			Fit candidate = evaluate(refined->first, refined->second);
+			if(candidate.Fit.Error >= best.Fit.Error)
+				break;
+
+			best = candidate;
+		}
+
+		return best;
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+	//BC1-----------------------------------------------------------------------------------------------------------------//
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	struct BC1Fit
+	{
+		u16 Color0 = 0;
+		u16 Color1 = 0;
+		EndpointFit Fit{};
+	};
+
+	constexpr std::array<f32, 4> BC1FourColorInterpolation{0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f};
+	constexpr std::array<f32, 4> BC1ThreeColorInterpolation{0.0f, 1.0f, 0.5f, 0.0f};
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	[[nodiscard]] constexpr u16 QuantizeRGB565(const Color<3>& color) noexcept
+	{
+		const u32 r = static_cast<u32>(color[0] * (31.0f / 255.0f) + 0.5f);
+		const u32 g = static_cast<u32>(color[1] * (63.0f / 255.0f) + 0.5f);
+		const u32 b = static_cast<u32>(color[2] * (31.0f / 255.0f) + 0.5f);
+
+		return static_cast<u16>((r << 11u) | (g << 5u) | b);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	[[nodiscard]] constexpr Color<3> DequantizeRGB565(const u16 color) noexcept
+	{
+		const u32 r = (color >> 11u) & 0x1Fu;
+		const u32 g = (color >> 5u) & 0x3Fu;
+		const u32 b = color & 0x1Fu;
+
+		return {static_cast<f32>((r << 3u) | (r >> 2u)), static_cast<f32>((g << 2u) | (g >> 4u)),
+		        static_cast<f32>((b << 3u) | (b >> 2u))};
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Quantize the endpoints to RGB565 and select the indices.
+	/// @param threeColor Use the 3 color mode (index 3 is transparent black) instead of the 4 color mode.
+	[[nodiscard]] BC1Fit EvaluateBC1Endpoints(const Pixels<3>& pixels, const std::array<f32, PixelsPerBlock>& weights,
+	                                          const Color<3>& endpoint0, const Color<3>& endpoint1, const bool threeColor,
+	                                          const BlockCompressionImplementation impl)
+	{
+		BC1Fit result{.Color0 = QuantizeRGB565(endpoint0), .Color1 = QuantizeRGB565(endpoint1)};
+
+		//The endpoint order selects the mode: Color0 > Color1 is the 4 color mode, Color0 <= Color1 the 3 color mode
+		if(threeColor ? result.Color0 > result.Color1 : result.Color0 < result.Color1)
+			std::swap(result.Color0, result.Color1);
+
+		const Color<3> color0 = DequantizeRGB565(result.Color0);
+		const Color<3> color1 = DequantizeRGB565(result.Color1);
+
+		std::array<Color<3>, 4> palette{color0, color1};
+		usize paletteSize = 0;
+		if(threeColor)
+		{
+			for(usize c = 0; c < 3; ++c)
+				palette[2][c] = (color0[c] + color1[c]) / 2.0f;
+			paletteSize = 3;
+		}
+		else if(result.Color0 == result.Color1)
+			paletteSize = 1; //Equal endpoints switch to the 3 color mode, only index 0 is safe to use
+		else
+		{
+			for(usize c = 0; c < 3; ++c)
+			{
+				palette[2][c] = (2.0f * color0[c] + color1[c]) / 3.0f;
+				palette[3][c] = (color0[c] + 2.0f * color1[c]) / 3.0f;
+			}
+			paletteSize = 4;
+		}
+
+		std::array<f32, PixelsPerBlock> distances{};
+		SelectIndices<3>(pixels, std::span(palette).first(paletteSize), result.Fit.Indices, distances, impl);
+
+		result.Fit.Error = 0.0f;
+		for(usize i = 0; i < PixelsPerBlock; ++i)
+		{
+			if(weights[i] == 0.0f)
+				result.Fit.Indices[i] = 3; //Transparent
+			else
+				result.Fit.Error += distances[i];
+		}
+
+		return result;
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	void WriteBC1Block(const BC1Fit& fit, const std::span<u8, 8> block) noexcept
+	{
+		u32 indices = 0;
+		for(usize i = 0; i < PixelsPerBlock; ++i)
+			indices |= static_cast<u32>(fit.Fit.Indices[i]) << (i * 2u);
+
+		block[0] = static_cast<u8>(fit.Color0 & 0xFFu);
+		block[1] = static_cast<u8>(fit.Color0 >> 8u);
+		block[2] = static_cast<u8>(fit.Color1 & 0xFFu);
+		block[3] = static_cast<u8>(fit.Color1 >> 8u);
+		for(usize i = 0; i < 4; ++i)
+			block[4 + i] = static_cast<u8>((indices >> (i * 8u)) & 0xFFu);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	void CompressBC1Color(const std::span<const u8, 64> rgba, const std::span<u8, 8> block, const bool allowTransparency,
+	                      const BlockCompressionImplementation impl)
+	{
+		const Pixels<3> pixels = LoadPixels<3>(rgba, impl);
+
+		std::array<f32, PixelsPerBlock> weights{};
+		bool threeColor = false;
+		for(usize i = 0; i < PixelsPerBlock; ++i)
+		{
+			const bool transparent = allowTransparency && rgba[i * 4u + 3u] < 128u;
+			weights[i] = transparent ? 0.0f : 1.0f;
+			threeColor |= transparent;
+		}
+
+		if(std::ranges::all_of(weights, [](const f32 weight){ return weight == 0.0f; }))
+		{
+			//Fully transparent
+			WriteBC1Block(BC1Fit{.Fit{.Indices = std::to_array<u8, PixelsPerBlock>({3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3})}}, block);
+			return;
+		}
+
+		const BC1Fit fit = FitEndpoints<3, BC1Fit>(pixels, weights, [&](const Color<3>& endpoint0, const Color<3>& endpoint1)
+		{
+			return EvaluateBC1Endpoints(pixels, weights, endpoint0, endpoint1, threeColor, impl);
+		}, threeColor ? BC1ThreeColorInterpolation : BC1FourColorInterpolation, impl);
+
+		WriteBC1Block(fit, block);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+	//BC3-----------------------------------------------------------------------------------------------------------------//
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Encode the alpha channel as a BC4 style block, using the 8 value mode.
+	void CompressBC3Alpha(const std::span<const u8, 64> rgba, const std::span<u8, 8> block) noexcept
+	{
+		u8 minAlpha = 255;
+		u8 maxAlpha = 0;
+		for(usize i = 0; i < PixelsPerBlock; ++i)
+		{
+			minAlpha = std::min(minAlpha, rgba[i * 4u + 3u]);
+			maxAlpha = std::max(maxAlpha, rgba[i * 4u + 3u]);
+		}
+
+		block[0] = maxAlpha;
+		block[1] = minAlpha;
+
+		u64 indices = 0;
+		if(maxAlpha != minAlpha)
+		{
+			//Palette: 0 = max, 1 = min, 2..7 = interpolated from max to min
+			const f32 scale = 7.0f / static_cast<f32>(maxAlpha - minAlpha);
+			for(usize i = 0; i < PixelsPerBlock; ++i)
+			{
+				const u32 step = static_cast<u32>(static_cast<f32>(rgba[i * 4u + 3u] - minAlpha) * scale + 0.5f);
+				const u64 index = step == 7 ? 0u : (step == 0 ? 1u : 8u - step);
+				indices |= index << (i * 3u);
+			}
+		}
+
+		for(usize i = 0; i < 6; ++i)
+			block[2 + i] = static_cast<u8>((indices >> (i * 8u)) & 0xFFu);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+	//BC7-----------------------------------------------------------------------------------------------------------------//
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	struct BC7Mode6Fit
+	{
+		std::array<std::array<u8, 4>, 2> Endpoints{}; //7 bits per channel
+		std::array<u8, 2> PBits{};
+		EndpointFit Fit{};
+	};
+
+	constexpr std::array<u32, 16> BC7Weights4{0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+	constexpr std::array<f32, 16> BC7Interpolation4 = []()
+	{
+		std::array<f32, 16> result{};
+		for(usize i = 0; i < result.size(); ++i)
+			result[i] = static_cast<f32>(BC7Weights4[i]) / 64.0f;
+		return result;
+	}();
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Quantize an endpoint to 7 bits per channel plus a shared p-bit, choosing the p-bit with the lowest error.
+	void QuantizeBC7Mode6Endpoint(const Color<4>& endpoint, std::array<u8, 4>& quantized, u8& pBit) noexcept
+	{
+		f32 bestError = std::numeric_limits<f32>::max();
+		for(u8 p = 0; p < 2; ++p)
+		{
+			std::array<u8, 4> candidate{};
+			f32 error = 0.0f;
+			for(usize c = 0; c < 4; ++c)
+			{
+				const f32 value = std::clamp(std::round((endpoint[c] - static_cast<f32>(p)) / 2.0f), 0.0f, 127.0f);
+				candidate[c] = static_cast<u8>(value);
+
+				const f32 diff = static_cast<f32>((candidate[c] << 1u) | p) - endpoint[c];
+				error += diff * diff;
+			}
+
+			if(error < bestError)
+			{
+				bestError = error;
+				quantized = candidate;
+				pBit = p;
+			}
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	[[nodiscard]] BC7Mode6Fit EvaluateBC7Mode6Endpoints(const Pixels<4>& pixels, const Color<4>& endpoint0, const Color<4>& endpoint1,
+	                                                    const BlockCompressionImplementation impl)
+	{
+		BC7Mode6Fit result{};
+		QuantizeBC7Mode6Endpoint(endpoint0, result.Endpoints[0], result.PBits[0]);
+		QuantizeBC7Mode6Endpoint(endpoint1, result.Endpoints[1], result.PBits[1]);
+
+		std::array<Color<4>, 16> palette{};
+		for(usize i = 0; i < palette.size(); ++i)
+		{
+			for(usize c = 0; c < 4; ++c)
+			{
+				const u32 e0 = (static_cast<u32>(result.Endpoints[0][c]) << 1u) | result.PBits[0];
+				const u32 e1 = (static_cast<u32>(result.Endpoints[1][c]) << 1u) | result.PBits[1];
+				palette[i][c] = static_cast<f32>(((64u - BC7Weights4[i]) * e0 + BC7Weights4[i] * e1 + 32u) >> 6u);
+			}
+		}
+
+		std::array<f32, PixelsPerBlock> distances{};
+		SelectIndices<4>(pixels, palette, result.Fit.Indices, distances, impl);
+		result.Fit.Error = std::accumulate(distances.begin(), distances.end(), 0.0f);
+
+		return result;
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Writes bits LSB first into a 128 bit block.
+	class BitWriter
+	{
+	public:
+		explicit constexpr BitWriter(const std::span<u8, 16> block) noexcept
+			: m_block(block)
+		{
+			std::ranges::fill(m_block, u8(0));
+		}
+
+		constexpr void Write(const u32 value, const u32 bitCount) noexcept
+		{
+			for(u32 i = 0; i < bitCount; ++i, ++m_position)
+			{
+				if(((value >> i) & 1u) != 0u)
+					m_block[m_position / 8u] |= static_cast<u8>(1u << (m_position % 8u));
+			}
+		}
+
+	private:
+		std::span<u8, 16> m_block;
+		u32 m_position = 0;
+	};
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	void WriteBC7Mode6Block(BC7Mode6Fit fit, const std::span<u8, 16> block) noexcept
+	{
+		//The MSB of the first index is implicitly 0, swap the endpoints if needed
+		if(fit.Fit.Indices[0] >= 8)
+		{
+			std::swap(fit.Endpoints[0], fit.Endpoints[1]);
+			std::swap(fit.PBits[0], fit.PBits[1]);
+			for(u8& index : fit.Fit.Indices)
+				index = static_cast<u8>(15u - index);
+		}
+
+		BitWriter writer(block);
+		writer.Write(1u << 6u, 7); //Mode 6
+		for(usize c = 0; c < 4; ++c)
+		{
+			writer.Write(fit.Endpoints[0][c], 7);
+			writer.Write(fit.Endpoints[1][c], 7);
+		}
+		writer.Write(fit.PBits[0], 1);
+		writer.Write(fit.PBits[1], 1);
+		writer.Write(fit.Fit.Indices[0], 3);
+		for(usize i = 1; i < PixelsPerBlock; ++i)
+			writer.Write(fit.Fit.Indices[i], 4);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	void CompressBC7Mode6(const std::span<const u8, 64> rgba, const std::span<u8, 16> block,
+	                      const BlockCompressionImplementation impl)
+	{
+		const Pixels<4> pixels = LoadPixels<4>(rgba, impl);
+		std::array<f32, PixelsPerBlock> weights{};
+		std::ranges::fill(weights, 1.0f);
+
+		const BC7Mode6Fit fit = FitEndpoints<4, BC7Mode6Fit>(pixels, weights, [&pixels, impl](const Color<4>& endpoint0, const Color<4>& endpoint1)
+		{
+			return EvaluateBC7Mode6Endpoints(pixels, endpoint0, endpoint1, impl);
+		}, BC7Interpolation4, impl);
+
+		WriteBC7Mode6Block(fit, block);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Retrieve the fastest block compression implementation supported by the CPU.
+	/// @return Fastest supported block compression implementation.
+	[[nodiscard]] BlockCompressionImplementation GetBestImplementation()
+	{
+		using TRAP::INTERNAL::IsBlockCompressionImplementationSupported;
+
+		static const BlockCompressionImplementation impl = []()
+		{
+			if(IsBlockCompressionImplementationSupported(BlockCompressionImplementation::AVX2))
+				return BlockCompressionImplementation::AVX2;
+
+			return BlockCompressionImplementation::Scalar;
+		}();
+
+		return impl;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] bool TRAP::INTERNAL::IsBlockCompressionImplementationSupported(const BlockCompressionImplementation impl)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None &&
+	                                         (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	switch(impl)
+	{
+	case BlockCompressionImplementation::Scalar:
+		return true;
+
+	case BlockCompressionImplementation::AVX2:
+		return Utils::GetCPUInfo().AVX2;
+
+	default:
+		return false;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::INTERNAL::CompressBC1Block(const std::span<const u8, 64> rgba, const std::span<u8, 8> block, const bool allowTransparency)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None &&
+	                                         (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	CompressBC1Color(rgba, block, allowTransparency, GetBestImplementation());
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::INTERNAL::CompressBC3Block(const std::span<const u8, 64> rgba, const std::span<u8, 16> block)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None &&
+	                                         (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	CompressBC3Alpha(rgba, block.first<8>());
+	CompressBC1Color(rgba, block.last<8>(), false, GetBestImplementation());
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::INTERNAL::CompressBC7Block(const std::span<const u8, 64> rgba, const std::span<u8, 16> block)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None &&
+	                                         (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	CompressBC7Mode6(rgba, block, GetBestImplementation());
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] std::vector<u8> TRAP::INTERNAL::CompressImage(ThreadPool& threadPool, const std::span<const u8> rgba,
+                                                           const u32 width, const u32 height,
+														   const Graphics::API::ImageFormat format)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None &&
+	                                         (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	return CompressImage(threadPool, rgba, width, height, format, GetBestImplementation());
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] std::vector<u8> TRAP::INTERNAL::CompressImage(ThreadPool& threadPool, const std::span<const u8> rgba,
+                                                           const u32 width, const u32 height,
+                                                           const Graphics::API::ImageFormat format,
+                                                           const BlockCompressionImplementation impl)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	TRAP_ASSERT(IsBlockCompressionImplementationSupported(impl), "CompressImage(): Implementation is not supported by the CPU!");
+
+	if(!IsBlockCompressionFormatSupported(format) || width == 0 || height == 0 ||
+	   rgba.size() != NumericCast<usize>(width) * height * 4u)
+	{
+		return {};
+	}
+
+	using Graphics::API::ImageFormat;
+
+	const u32 blocksX = (width + 3u) / 4u;
+	const u32 blocksY = (height + 3u) / 4u;
+	const usize blockSize = Graphics::API::ImageFormatBitSizeOfBlock(format) / 8u;
+	const bool allowTransparency = format == ImageFormat::DXBC1_RGBA_UNORM || format == ImageFormat::DXBC1_RGBA_SRGB;
+
+	std::vector<u8> result(NumericCast<usize>(blocksX) * blocksY * blockSize);
+
+	ParallelFor(threadPool, 0u, blocksY, 1, [&](const u32 blockY)
+	{
+		std::array<u8, 64> pixels{};
+
+		for(u32 blockX = 0; blockX < blocksX; ++blockX)
+		{
+			//Gather the block, repeating the last row/column for partial edge blocks
+			for(u32 y = 0; y < 4; ++y)
+			{
+				const u32 srcY = std::min(blockY * 4u + y, height - 1u);
+				for(u32 x = 0; x < 4; ++x)
+				{
+					const u32 srcX = std::min(blockX * 4u + x, width - 1u);
+					std::copy_n(rgba.data() + (NumericCast<usize>(srcY) * width + srcX) * 4u, 4, pixels.data() + (y * 4u + x) * 4u);
+				}
+			}
+
+			u8* const dst = result.data() + (NumericCast<usize>(blockY) * blocksX + blockX) * blockSize;
+			switch(format)
+			{
+			case ImageFormat::DXBC3_UNORM: [[fallthrough]];
+			case ImageFormat::DXBC3_SRGB:
+				CompressBC3Alpha(pixels, std::span<u8, 8>(dst, 8));
+				CompressBC1Color(pixels, std::span<u8, 8>(dst + 8, 8), false, impl);
+				break;
+
+			case ImageFormat::DXBC7_UNORM: [[fallthrough]];
+			case ImageFormat::DXBC7_SRGB:
+				CompressBC7Mode6(pixels, std::span<u8, 16>(dst, 16), impl);
+				break;
+
+			default:
+				CompressBC1Color(pixels, std::span<u8, 8>(dst, 8), allowTransparency, impl);
+				break;
+			}
+		}
+	});
+
+	return result;
+}
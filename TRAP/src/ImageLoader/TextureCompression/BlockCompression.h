@@ -0,0 +1,99 @@
+#ifndef TRAP_BLOCKCOMPRESSION_H
+#define TRAP_BLOCKCOMPRESSION_H
+
+#include <span>
+#include <vector>
+
+#include "Core/Types.h"
+#include "Graphics/API/ImageFormat.h"
+
+namespace TRAP
+{
+	class ThreadPool;
+}
+
+namespace TRAP::INTERNAL
+{
+	/// @brief Available block compression implementations.
+	///        The block compression functions automatically use the fastest one supported by the CPU.
+	enum class BlockCompressionImplementation : u8
+	{
+		Scalar,
+		AVX2
+	};
+
+	/// @brief Check whether the given block compression implementation is supported by the CPU.
+	/// @param impl Block compression implementation.
+	/// @return True if supported, false otherwise.
+	[[nodiscard]] bool IsBlockCompressionImplementationSupported(BlockCompressionImplementation impl);
+
+	/// @brief Check whether CompressImage() can encode the given format.
+	///        Supported are BC1 (with and without alpha), BC3 and BC7, each in UNORM and SRGB.
+	/// @param format Image format.
+	/// @return True if the format is supported, false otherwise.
+	[[nodiscard]] constexpr bool IsBlockCompressionFormatSupported(Graphics::API::ImageFormat format) noexcept;
+
+	/// @brief Encode a 4x4 block of RGBA8 pixels as BC1.
+	/// @param rgba Pixels of the block in row-major order.
+	/// @param block Output for the 8 byte BC1 block.
+	/// @param allowTransparency Whether pixels with an alpha below 128 may be encoded as transparent black
+	///                          (BC1 3 color mode). If false, alpha is ignored.
+	void CompressBC1Block(std::span<const u8, 64> rgba, std::span<u8, 8> block, bool allowTransparency);
+	/// @brief Encode a 4x4 block of RGBA8 pixels as BC3.
+	/// @param rgba Pixels of the block in row-major order.
+	/// @param block Output for the 16 byte BC3 block.
+	void CompressBC3Block(std::span<const u8, 64> rgba, std::span<u8, 16> block);
+	/// @brief Encode a 4x4 block of RGBA8 pixels as BC7.
+	///        Only mode 6 (single subset, RGBA endpoints with p-bits, 4 bit indices) is used,
+	///        which trades some quality on blocks with multiple distinct colors for speed.
+	/// @param rgba Pixels of the block in row-major order.
+	/// @param block Output for the 16 byte BC7 block.
+	void CompressBC7Block(std::span<const u8, 64> rgba, std::span<u8, 16> block);
+
+	/// @brief Encode an RGBA8 image with the given block compression format.
+	///        Rows of blocks are split across the ThreadPool, edge blocks repeat the last row/column.
+	/// @param threadPool ThreadPool to use.
+	/// @param rgba Pixel data, 4 bytes per pixel.
+	/// @param width Width of the image.
+	/// @param height Height of the image.
+	/// @param format Target format, must be supported by IsBlockCompressionFormatSupported().
+	/// @return Tightly packed blocks in row-major order, empty on error.
+	[[nodiscard]] std::vector<u8> CompressImage(ThreadPool& threadPool, std::span<const u8> rgba, u32 width, u32 height,
+	                                            Graphics::API::ImageFormat format);
+	/// @brief Encode an RGBA8 image with the given block compression format using a specific implementation.
+	/// @param threadPool ThreadPool to use.
+	/// @param rgba Pixel data, 4 bytes per pixel.
+	/// @param width Width of the image.
+	/// @param height Height of the image.
+	/// @param format Target format, must be supported by IsBlockCompressionFormatSupported().
+	/// @param impl Block compression implementation to use, must be supported by the CPU.
+	/// @return Tightly packed blocks in row-major order, empty on error.
+	/// @note Only intended for testing and benchmarking.
+	[[nodiscard]] std::vector<u8> CompressImage(ThreadPool& threadPool, std::span<const u8> rgba, u32 width, u32 height,
+	                                            Graphics::API::ImageFormat format, BlockCompressionImplementation impl);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] constexpr bool TRAP::INTERNAL::IsBlockCompressionFormatSupported(const Graphics::API::ImageFormat format) noexcept
+{
+	using Graphics::API::ImageFormat;
+
+	switch(format)
+	{
+	case ImageFormat::DXBC1_RGB_UNORM: [[fallthrough]];
+	case ImageFormat::DXBC1_RGB_SRGB: [[fallthrough]];
+	case ImageFormat::DXBC1_RGBA_UNORM: [[fallthrough]];
+	case ImageFormat::DXBC1_RGBA_SRGB: [[fallthrough]];
+	case ImageFormat::DXBC3_UNORM: [[fallthrough]];
+	case ImageFormat::DXBC3_SRGB: [[fallthrough]];
+	case ImageFormat::DXBC7_UNORM: [[fallthrough]];
+	case ImageFormat::DXBC7_SRGB:
+		return true;
+
+	default:
+		return false;
+	}
+}
+
+#endif /*TRAP_BLOCKCOMPRESSION_H*/
@@ -0,0 +1,272 @@
+#include "TRAPPCH.h"
+#include "MipChain.h"
+
+#include "ThreadPool/Parallel.h"
+
+#include <immintrin.h>
+
+namespace
+{
+	/// @brief Contributions of the source pixels to a single destination pixel along one axis.
+	struct FilterContribution
+	{
+		u32 First = 0;
+		u32 Count = 0;
+		//Offset into FilterWeights::Weights
+		usize WeightOffset = 0;
+	};
+
+	/// @brief Precomputed filter weights for resampling one axis.
+	struct FilterWeights
+	{
+		std::vector<FilterContribution> Contributions{};
+		std::vector<f32> Weights{};
+	};
+
+	constexpr f32 KaiserRadius = 3.0f;
+	constexpr f32 KaiserAlpha = 4.0f;
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Zeroth order modified bessel function of the first kind.
+	[[nodiscard]] f32 BesselI0(const f32 x) noexcept
+	{
+		f32 sum = 1.0f;
+		f32 term = 1.0f;
+		const f32 halfX = x * 0.5f;
+		for(u32 k = 1; k < 32; ++k)
+		{
+			term *= (halfX / static_cast<f32>(k)) * (halfX / static_cast<f32>(k));
+			sum += term;
+			if(term < sum * 1e-8f)
+				break;
+		}
+
+		return sum;
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Evaluate the filter kernel.
+	/// @param filter Filter to evaluate.
+	/// @param x Distance to the filter center in destination pixels.
+	/// @return Unnormalized weight.
+	[[nodiscard]] f32 EvaluateFilter(const TRAP::TextureContainer::MipFilter filter, const f32 x) noexcept
+	{
+		if(filter == TRAP::TextureContainer::MipFilter::Box)
+			return (x >= -0.5f && x < 0.5f) ? 1.0f : 0.0f;
+
+		//Kaiser windowed sinc
+		if(std::abs(x) >= KaiserRadius)
+			return 0.0f;
+
+		const f32 sinc = x == 0.0f ? 1.0f : std::sin(std::numbers::pi_v<f32> * x) / (std::numbers::pi_v<f32> * x);
+		const f32 ratio = x / KaiserRadius;
+		return sinc * BesselI0(KaiserAlpha * std::sqrt(1.0f - ratio * ratio)) / BesselI0(KaiserAlpha);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Compute the filter weights for resampling an axis from srcSize to dstSize pixels.
+	///        Taps outside the source are clamped to the edge.
+	[[nodiscard]] FilterWeights ComputeFilterWeights(const TRAP::TextureContainer::MipFilter filter, const u32 srcSize,
+	                                                 const u32 dstSize)
+	{
+		const f32 scale = static_cast<f32>(srcSize) / static_cast<f32>(dstSize);
+		const f32 support = (filter == TRAP::TextureContainer::MipFilter::Box ? 0.5f : KaiserRadius) * scale;
+
+		FilterWeights result{};
+		result.Contributions.resize(dstSize);
+
+		for(u32 x = 0; x < dstSize; ++x)
+		{
+			const f32 center = (static_cast<f32>(x) + 0.5f) * scale;
+			const i64 firstTap = static_cast<i64>(std::floor(center - support));
+			const i64 lastTap = static_cast<i64>(std::ceil(center + support));
+
+			const i64 first = std::clamp<i64>(firstTap, 0, srcSize - 1);
+			const i64 last = std::clamp<i64>(lastTap, 0, srcSize - 1);
+
+			FilterContribution& contribution = result.Contributions[x];
+			contribution.First = NumericCast<u32>(first);
+			contribution.Count = NumericCast<u32>(last - first + 1);
+			contribution.WeightOffset = result.Weights.size();
+			result.Weights.resize(result.Weights.size() + contribution.Count, 0.0f);
+
+			f32 totalWeight = 0.0f;
+			for(i64 tap = firstTap; tap <= lastTap; ++tap)
+			{
+				const f32 weight = EvaluateFilter(filter, (static_cast<f32>(tap) + 0.5f - center) / scale);
+				const i64 clampedTap = std::clamp<i64>(tap, 0, srcSize - 1);
+				result.Weights[contribution.WeightOffset + NumericCast<usize>(clampedTap - first)] += weight;
+				totalWeight += weight;
+			}
+
+			//Normalize so that constant images stay constant
+			for(u32 i = 0; i < contribution.Count; ++i)
+				result.Weights[contribution.WeightOffset + i] /= totalWeight;
+		}
+
+		return result;
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	[[nodiscard]] f32 SRGBToLinear(const f32 value) noexcept
+	{
+		if(value <= 0.04045f)
+			return value / 12.92f;
+
+		return std::pow((value + 0.055f) / 1.055f, 2.4f);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	[[nodiscard]] f32 LinearToSRGB(const f32 value) noexcept
+	{
+		if(value <= 0.0031308f)
+			return value * 12.92f;
+
+		return 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Convert a single RGBA8 pixel to linear floating point.
+	[[nodiscard]] __m128 LoadPixel(const u8* const pixel, const std::array<f32, 256>& colorLUT) noexcept
+	{
+		return _mm_setr_ps(colorLUT[pixel[0]], colorLUT[pixel[1]], colorLUT[pixel[2]], static_cast<f32>(pixel[3]) / 255.0f);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Convert a single linear floating point pixel to RGBA8.
+	void StorePixel(u8* const pixel, const __m128 value, const bool sRGB) noexcept
+	{
+		alignas(16) std::array<f32, 4> channels{};
+		_mm_store_ps(channels.data(), _mm_min_ps(_mm_max_ps(value, _mm_setzero_ps()), _mm_set1_ps(1.0f)));
+
+		for(usize c = 0; c < 3; ++c)
+		{
+			const f32 encoded = sRGB ? LinearToSRGB(channels[c]) : channels[c];
+			pixel[c] = static_cast<u8>(encoded * 255.0f + 0.5f);
+		}
+		pixel[3] = static_cast<u8>(channels[3] * 255.0f + 0.5f);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Downsample a linear RGBA float image, horizontal pass first, then vertical.
+	void Downsample(TRAP::ThreadPool& threadPool, const std::vector<f32>& src, const u32 srcWidth, const u32 srcHeight,
+	                std::vector<f32>& dst, const u32 dstWidth, const u32 dstHeight, const TRAP::TextureContainer::MipFilter filter)
+	{
+		const FilterWeights horizontal = ComputeFilterWeights(filter, srcWidth, dstWidth);
+		const FilterWeights vertical = ComputeFilterWeights(filter, srcHeight, dstHeight);
+
+		//Horizontal pass, srcHeight rows of dstWidth pixels
+		std::vector<f32> temp(NumericCast<usize>(dstWidth) * srcHeight * 4u);
+		TRAP::ParallelFor(threadPool, 0u, srcHeight, 16, [&](const u32 y)
+		{
+			const f32* const srcRow = src.data() + NumericCast<usize>(y) * srcWidth * 4u;
+			f32* const dstRow = temp.data() + NumericCast<usize>(y) * dstWidth * 4u;
+
+			for(u32 x = 0; x < dstWidth; ++x)
+			{
+				const FilterContribution& contribution = horizontal.Contributions[x];
+				const f32* const weights = horizontal.Weights.data() + contribution.WeightOffset;
+
+				__m128 sum = _mm_setzero_ps();
+				for(u32 i = 0; i < contribution.Count; ++i)
+				{
+					const __m128 pixel = _mm_loadu_ps(srcRow + NumericCast<usize>(contribution.First + i) * 4u);
+					sum = _mm_add_ps(sum, _mm_mul_ps(pixel, _mm_set1_ps(weights[i])));
+				}
+				_mm_storeu_ps(dstRow + NumericCast<usize>(x) * 4u, sum);
+			}
+		});
+
+		//Vertical pass, whole rows are accumulated at once
+		dst.assign(NumericCast<usize>(dstWidth) * dstHeight * 4u, 0.0f);
+		const usize rowFloats = NumericCast<usize>(dstWidth) * 4u;
+		TRAP::ParallelFor(threadPool, 0u, dstHeight, 16, [&](const u32 y)
+		{
+			const FilterContribution& contribution = vertical.Contributions[y];
+			const f32* const weights = vertical.Weights.data() + contribution.WeightOffset;
+			f32* const dstRow = dst.data() + y * rowFloats;
+
+			for(u32 i = 0; i < contribution.Count; ++i)
+			{
+				const f32* const srcRow = temp.data() + (contribution.First + i) * rowFloats;
+				const __m128 weight = _mm_set1_ps(weights[i]);
+				for(usize x = 0; x < rowFloats; x += 4)
+				{
+					const __m128 sum = _mm_add_ps(_mm_loadu_ps(dstRow + x), _mm_mul_ps(_mm_loadu_ps(srcRow + x), weight));
+					_mm_storeu_ps(dstRow + x, sum);
+				}
+			}
+		});
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] std::vector<std::vector<u8>> TRAP::INTERNAL::GenerateMipChain(ThreadPool& threadPool, const std::span<const u8> rgba,
+                                                                          const u32 width, const u32 height,
+																		  const TextureContainer::MipFilter filter,
+																		  const bool sRGB)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	TRAP_ASSERT(rgba.size() == NumericCast<usize>(width) * height * 4u, "GenerateMipChain(): Invalid pixel data size!");
+
+	std::vector<std::vector<u8>> mipLevels{};
+	if(width == 0 || height == 0)
+		return mipLevels;
+
+	static const std::array<f32, 256> SRGBLUT = []()
+	{
+		std::array<f32, 256> lut{};
+		for(usize i = 0; i < lut.size(); ++i)
+			lut[i] = SRGBToLinear(static_cast<f32>(i) / 255.0f);
+		return lut;
+	}();
+	static const std::array<f32, 256> LinearLUT = []()
+	{
+		std::array<f32, 256> lut{};
+		for(usize i = 0; i < lut.size(); ++i)
+			lut[i] = static_cast<f32>(i) / 255.0f;
+		return lut;
+	}();
+	const std::array<f32, 256>& colorLUT = sRGB ? SRGBLUT : LinearLUT;
+
+	//Base level in linear floating point
+	std::vector<f32> current(NumericCast<usize>(width) * height * 4u);
+	ParallelFor(threadPool, usize{0}, NumericCast<usize>(width) * height, 4096, [&](const usize begin, const usize end)
+	{
+		for(usize i = begin; i < end; ++i)
+			_mm_storeu_ps(current.data() + i * 4u, LoadPixel(rgba.data() + i * 4u, colorLUT));
+	});
+
+	u32 currentWidth = width;
+	u32 currentHeight = height;
+	std::vector<f32> next{};
+	while(currentWidth > 1 || currentHeight > 1)
+	{
+		const u32 nextWidth = std::max(currentWidth / 2u, 1u);
+		const u32 nextHeight = std::max(currentHeight / 2u, 1u);
+		Downsample(threadPool, current, currentWidth, currentHeight, next, nextWidth, nextHeight, filter);
+
+		std::vector<u8>& mipLevel = mipLevels.emplace_back(NumericCast<usize>(nextWidth) * nextHeight * 4u);
+		ParallelFor(threadPool, usize{0}, NumericCast<usize>(nextWidth) * nextHeight, 4096, [&](const usize begin, const usize end)
+		{
+			for(usize i = begin; i < end; ++i)
+				StorePixel(mipLevel.data() + i * 4u, _mm_loadu_ps(next.data() + i * 4u), sRGB);
+		});
+
+		std::swap(current, next);
+		currentWidth = nextWidth;
+		currentHeight = nextHeight;
+	}
+
+	return mipLevels;
+}
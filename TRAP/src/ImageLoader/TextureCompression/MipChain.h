@@ -0,0 +1,33 @@
+#ifndef TRAP_MIPCHAIN_H
+#define TRAP_MIPCHAIN_H
+
+#include <span>
+#include <vector>
+
+#include "Core/Types.h"
+#include "ImageLoader/TextureContainer.h"
+
+namespace TRAP
+{
+	class ThreadPool;
+}
+
+namespace TRAP::INTERNAL
+{
+	/// @brief Generate the mip chain for the given RGBA8 image on the CPU.
+	///        Every level is resampled from the previous one in linear floating point.
+	/// @param threadPool ThreadPool to split the rows of every level across.
+	/// @param rgba Pixel data of the base level, 4 bytes per pixel.
+	/// @param width Width of the base level.
+	/// @param height Height of the base level.
+	/// @param filter Filter used for downsampling.
+	/// @param sRGB Whether the color channels are sRGB encoded.
+	///             If true, filtering happens in linear space so the result doesn't darken.
+	///             Alpha is always treated as linear.
+	/// @return RGBA8 pixel data for mip level 1 and all smaller levels down to 1x1.
+	[[nodiscard]] std::vector<std::vector<u8>> GenerateMipChain(ThreadPool& threadPool, std::span<const u8> rgba,
+	                                                            u32 width, u32 height, TextureContainer::MipFilter filter,
+																bool sRGB);
+}
+
+#endif /*TRAP_MIPCHAIN_H*/
@@ -0,0 +1,388 @@
+#include "TRAPPCH.h"
+#include "TextureContainer.h"
+
+#include "FileSystem/FileSystem.h"
+#include "Image.h"
+#include "ThreadPool/Parallel.h"
+#include "Utils/String/String.h"
+
+#include "KhronosTexture/KTX2Container.h"
+#include "DirectDrawSurface/DDSContainer.h"
+#include "TextureCompression/BlockCompression.h"
+#include "TextureCompression/MipChain.h"
+
+namespace
+{
+	/// @brief Check whether the given format can be created from an image by TextureContainer::CreateFromImage().
+	[[nodiscard]] constexpr bool IsCreateFromImageFormatSupported(const TRAP::Graphics::API::ImageFormat format) noexcept
+	{
+		return format == TRAP::Graphics::API::ImageFormat::R8G8B8A8_UNORM ||
+		       format == TRAP::Graphics::API::ImageFormat::R8G8B8A8_SRGB ||
+			   TRAP::INTERNAL::IsBlockCompressionFormatSupported(format);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Expand the pixel data of an 8 bit per channel image to RGBA.
+	[[nodiscard]] std::vector<u8> ConvertToRGBA8(const TRAP::Image& image)
+	{
+		const std::span<const u8> pixelData = image.GetPixelData();
+		const usize pixelCount = NumericCast<usize>(image.GetWidth()) * image.GetHeight();
+
+		std::vector<u8> rgba(pixelCount * 4u);
+		switch(image.GetColorFormat())
+		{
+		case TRAP::Image::ColorFormat::GrayScale:
+			for(usize i = 0; i < pixelCount; ++i)
+			{
+				std::fill_n(rgba.data() + i * 4u, 3, pixelData[i]);
+				rgba[i * 4u + 3u] = 255;
+			}
+			break;
+
+		case TRAP::Image::ColorFormat::GrayScaleAlpha:
+			for(usize i = 0; i < pixelCount; ++i)
+			{
+				std::fill_n(rgba.data() + i * 4u, 3, pixelData[i * 2u]);
+				rgba[i * 4u + 3u] = pixelData[i * 2u + 1u];
+			}
+			break;
+
+		case TRAP::Image::ColorFormat::RGB:
+			for(usize i = 0; i < pixelCount; ++i)
+			{
+				std::copy_n(pixelData.data() + i * 3u, 3, rgba.data() + i * 4u);
+				rgba[i * 4u + 3u] = 255;
+			}
+			break;
+
+		case TRAP::Image::ColorFormat::RGBA:
+			std::ranges::copy(pixelData, rgba.begin());
+			break;
+
+		default:
+			return {};
+		}
+
+		return rgba;
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Generate the mip chain of an image, block compress it if requested and encode the result as DDS.
+	[[nodiscard]] std::vector<u8> EncodeImageAsDDS(TRAP::ThreadPool& threadPool, const TRAP::Image& image,
+	                                               const TRAP::Graphics::API::ImageFormat format,
+												   const TRAP::TextureContainer::MipFilter mipFilter)
+	{
+		using TRAP::Graphics::API::ImageFormat;
+
+		if(!IsCreateFromImageFormatSupported(format))
+		{
+			TP_ERROR(TRAP::Log::ImagePrefix, "Unsupported texture container format (", std::to_underlying(format), ")!");
+			return {};
+		}
+		if(!image.IsLDR() || image.GetBitsPerChannel() != 8 || image.GetWidth() == 0 || image.GetHeight() == 0)
+		{
+			TP_ERROR(TRAP::Log::ImagePrefix, "Only images with 8 bits per channel can be converted to a texture container!");
+			return {};
+		}
+
+		const bool sRGB = format == ImageFormat::R8G8B8A8_SRGB || format == ImageFormat::DXBC1_RGB_SRGB ||
+		                  format == ImageFormat::DXBC1_RGBA_SRGB || format == ImageFormat::DXBC3_SRGB ||
+						  format == ImageFormat::DXBC7_SRGB;
+
+		std::vector<std::vector<u8>> mipLevels{};
+		mipLevels.push_back(ConvertToRGBA8(image));
+		std::ranges::move(TRAP::INTERNAL::GenerateMipChain(threadPool, mipLevels[0], image.GetWidth(), image.GetHeight(),
+		                                                   mipFilter, sRGB), std::back_inserter(mipLevels));
+
+		if(TRAP::INTERNAL::IsBlockCompressionFormatSupported(format))
+		{
+			for(usize mip = 0; mip < mipLevels.size(); ++mip)
+			{
+				mipLevels[mip] = TRAP::INTERNAL::CompressImage(threadPool, mipLevels[mip], std::max(image.GetWidth() >> mip, 1u),
+				                                               std::max(image.GetHeight() >> mip, 1u), format);
+			}
+		}
+
+		return TRAP::INTERNAL::DDSContainer::Encode(format, image.GetWidth(), image.GetHeight(), mipLevels);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Tag marking DDS files written by TextureContainer::LoadFromImageFileCached(), followed by the mip filter.
+	constexpr std::array<u8, 4> CacheTag{'T', 'R', 'A', 'P'};
+	/// @brief Offset of the cache tag, it is stored in the last 2 reserved fields of the DDS header.
+	constexpr usize CacheTagOffset = 4u /*Magic number*/ + 7u * sizeof(u32) + 9u * sizeof(u32);
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Mark encoded DDS data as cache created with the given mip filter.
+	void WriteCacheTag(std::vector<u8>& dds, const TRAP::TextureContainer::MipFilter mipFilter)
+	{
+		std::ranges::copy(CacheTag, dds.begin() + CacheTagOffset);
+		dds[CacheTagOffset + CacheTag.size()] = std::to_underlying(mipFilter);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Check whether the cache file was created with the given mip filter.
+	[[nodiscard]] bool HasCacheTag(const std::filesystem::path& cacheFilepath, const TRAP::TextureContainer::MipFilter mipFilter)
+	{
+		std::array<u8, CacheTagOffset + CacheTag.size() + 1u> header{};
+		std::ifstream file(cacheFilepath, std::ios::binary);
+		if(!file.read(reinterpret_cast<char*>(header.data()), header.size()))
+			return false;
+
+		return std::ranges::equal(std::span(header).subspan(CacheTagOffset, CacheTag.size()), CacheTag) &&
+		       header.back() == std::to_underlying(mipFilter);
+	}
+}
+
+TRAP::TextureContainer::TextureContainer(std::filesystem::path filepath)
+	: m_filepath(std::move(filepath))
+{
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] const std::filesystem::path& TRAP::TextureContainer::GetFilePath() const noexcept
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None &&
+	                                         (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	return m_filepath;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] std::span<const u8> TRAP::TextureContainer::GetSubresourceData(const u32 mipLevel, const u32 arrayLayer) const
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None &&
+	                                         (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	TRAP_ASSERT(mipLevel < m_mipLevels, "TextureContainer::GetSubresourceData(): Mip level out of range!");
+	TRAP_ASSERT(arrayLayer < m_arraySize, "TextureContainer::GetSubresourceData(): Array layer out of range!");
+
+	const usize index = NumericCast<usize>(mipLevel) * m_arraySize + arrayLayer;
+	if(index >= m_subresources.size())
+		return {};
+
+	const Subresource& subresource = m_subresources[index];
+	return GetData().subspan(static_cast<usize>(subresource.Offset), static_cast<usize>(subresource.Size));
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] TRAP::Scope<TRAP::TextureContainer> TRAP::TextureContainer::LoadFromFile(const std::filesystem::path& filepath)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	if(!IsSupportedTextureContainerFile(filepath))
+	{
+		TP_ERROR(Log::ImagePrefix, "Unsupported or unknown texture container ", filepath, "!");
+		return nullptr;
+	}
+
+	const auto fileEnding = FileSystem::GetFileEnding(filepath);
+	if(!fileEnding)
+		return nullptr;
+
+	const std::string fileFormat = Utils::String::ToLower(*fileEnding);
+
+	Scope<TextureContainer> result = nullptr;
+	if(fileFormat == ".ktx2")
+		result = MakeScope<INTERNAL::KTX2Container>(filepath);
+	else if(fileFormat == ".dds")
+		result = MakeScope<INTERNAL::DDSContainer>(filepath);
+
+	//Test for Errors
+	if(!result || result->m_subresources.empty())
+		return nullptr;
+
+	return result;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] TRAP::Scope<TRAP::TextureContainer> TRAP::TextureContainer::LoadFromMemory(const std::span<const u8> data)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	static constexpr std::array<u8, 4> KTX2MagicNumber{0xAB, 'K', 'T', 'X'};
+	static constexpr std::array<u8, 4> DDSMagicNumber{'D', 'D', 'S', ' '};
+
+	Scope<TextureContainer> result = nullptr;
+	if(data.size() >= KTX2MagicNumber.size() && std::ranges::equal(data.first(KTX2MagicNumber.size()), KTX2MagicNumber))
+		result = MakeScope<INTERNAL::KTX2Container>(data);
+	else if(data.size() >= DDSMagicNumber.size() && std::ranges::equal(data.first(DDSMagicNumber.size()), DDSMagicNumber))
+		result = MakeScope<INTERNAL::DDSContainer>(data);
+	else
+	{
+		TP_ERROR(Log::ImagePrefix, "Unsupported or unknown texture container data!");
+		return nullptr;
+	}
+
+	//Test for Errors
+	if(result->m_subresources.empty())
+		return nullptr;
+
+	return result;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] TRAP::Scope<TRAP::TextureContainer> TRAP::TextureContainer::CreateFromImage(ThreadPool& threadPool, const Image& image,
+                                                                                         const Graphics::API::ImageFormat format,
+																						 const MipFilter mipFilter)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	const std::vector<u8> encoded = EncodeImageAsDDS(threadPool, image, format, mipFilter);
+	if(encoded.empty())
+		return nullptr;
+
+	return LoadFromMemory(encoded);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] TRAP::Scope<TRAP::TextureContainer> TRAP::TextureContainer::CreateFromImage(const Image& image,
+                                                                                         const Graphics::API::ImageFormat format,
+																						 const MipFilter mipFilter)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None &&
+	                                         (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	return CreateFromImage(TRAP::INTERNAL::GetParallelThreadPool(), image, format, mipFilter);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] TRAP::Scope<TRAP::TextureContainer> TRAP::TextureContainer::LoadFromImageFileCached(ThreadPool& threadPool,
+                                                                                                 const std::filesystem::path& imageFilepath,
+                                                                                                 const std::filesystem::path& cacheFilepath,
+																								 const Graphics::API::ImageFormat format,
+																								 const MipFilter mipFilter)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	//Use the cache if it is up to date
+	const auto imageWriteTime = FileSystem::GetLastWriteTime(imageFilepath);
+	const auto cacheWriteTime = FileSystem::Exists(cacheFilepath) ? FileSystem::GetLastWriteTime(cacheFilepath) : TRAP::NullOpt;
+	if(cacheWriteTime && (!imageWriteTime || *cacheWriteTime >= *imageWriteTime) && HasCacheTag(cacheFilepath, mipFilter))
+	{
+		Scope<TextureContainer> cached = LoadFromFile(cacheFilepath);
+		if(cached && cached->GetImageFormat() == format)
+			return cached;
+	}
+
+	const Scope<Image> image = Image::LoadFromFile(imageFilepath);
+	if(!image)
+		return nullptr;
+
+	std::vector<u8> encoded = EncodeImageAsDDS(threadPool, *image, format, mipFilter);
+	if(encoded.empty())
+		return nullptr;
+
+	WriteCacheTag(encoded, mipFilter);
+	if(!FileSystem::WriteFile(cacheFilepath, encoded))
+		TP_WARN(Log::ImagePrefix, "Failed to write texture container cache ", cacheFilepath, "!");
+
+	return LoadFromMemory(encoded);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] TRAP::Scope<TRAP::TextureContainer> TRAP::TextureContainer::LoadFromImageFileCached(const std::filesystem::path& imageFilepath,
+                                                                                                 const std::filesystem::path& cacheFilepath,
+																								 const Graphics::API::ImageFormat format,
+																								 const MipFilter mipFilter)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None &&
+	                                         (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	return LoadFromImageFileCached(TRAP::INTERNAL::GetParallelThreadPool(), imageFilepath, cacheFilepath, format, mipFilter);
+}
+
+[[nodiscard]] bool TRAP::TextureContainer::IsSupportedTextureContainerFile(const std::filesystem::path& filepath)
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	const auto fileEnding = FileSystem::GetFileEnding(filepath);
+	if(!fileEnding)
+		return false;
+
+	const std::string fileFormat = Utils::String::ToLower(*fileEnding);
+
+	return std::ranges::any_of(SupportedTextureContainerSuffixes, [&fileFormat](const std::string_view suffix)
+	{
+		return fileFormat == suffix;
+	});
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] bool TRAP::TextureContainer::Validate(const std::string_view logPrefix) const
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None);
+
+	if(m_format == Graphics::API::ImageFormat::Undefined)
+	{
+		TP_ERROR(logPrefix, "Unsupported image format!");
+		return false;
+	}
+	if(m_width < 1 || m_height < 1 || m_depth < 1 || m_arraySize < 1 || m_mipLevels < 1)
+	{
+		TP_ERROR(logPrefix, "Invalid dimensions (", m_width, "x", m_height, "x", m_depth, ", ", m_arraySize, " layers, ",
+		         m_mipLevels, " mip levels)!");
+		return false;
+	}
+	if(m_isCubemap && (m_width != m_height || m_depth != 1 || m_arraySize % 6 != 0))
+	{
+		TP_ERROR(logPrefix, "Invalid cube map!");
+		return false;
+	}
+	if(m_mipLevels > std::bit_width(std::max({m_width, m_height, m_depth})))
+	{
+		TP_ERROR(logPrefix, "Too many mip levels (", m_mipLevels, ")!");
+		return false;
+	}
+	if(m_subresources.size() != NumericCast<usize>(m_mipLevels) * m_arraySize)
+	{
+		TP_ERROR(logPrefix, "Missing subresources!");
+		return false;
+	}
+
+	const u64 dataSize = GetData().size();
+	for(u32 mip = 0; mip < m_mipLevels; ++mip)
+	{
+		const u64 expectedSize = CalculateSubresourceSize(m_format, std::max(m_width >> mip, 1u),
+		                                                  std::max(m_height >> mip, 1u), std::max(m_depth >> mip, 1u));
+
+		for(u32 layer = 0; layer < m_arraySize; ++layer)
+		{
+			const Subresource& subresource = m_subresources[NumericCast<usize>(mip) * m_arraySize + layer];
+			if(subresource.Size != expectedSize || subresource.Offset > dataSize || subresource.Size > dataSize - subresource.Offset)
+			{
+				TP_ERROR(logPrefix, "Data of mip level ", mip, " layer ", layer, " is truncated or has an invalid size!");
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] std::span<const u8> TRAP::TextureContainer::GetData() const noexcept
+{
+	ZoneNamedC(__tracy, tracy::Color::Green, (GetTRAPProfileSystems() & ProfileSystems::ImageLoader) != ProfileSystems::None &&
+	                                         (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	if(m_file)
+		return m_file->GetData();
+
+	return m_data;
+}
@@ -0,0 +1,258 @@
+#ifndef TRAP_TEXTURECONTAINER_H
+#define TRAP_TEXTURECONTAINER_H
+
+#include <array>
+#include <filesystem>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "Core/Base.h"
+#include "FileSystem/MappedFile.h"
+#include "Graphics/API/ImageFormat.h"
+
+namespace TRAP
+{
+	class Image;
+	class ThreadPool;
+
+	/// @brief Abstract texture container base class.
+	///        Unlike TRAP::Image a texture container holds GPU ready data, i.e. block compressed formats,
+	///        pre-built mip chains, array layers, cube faces and 3D slices. The data is not decoded,
+	///        it is meant to be uploaded as-is.
+	class TextureContainer
+	{
+	protected:
+		/// @brief Constructor.
+		/// @param filepath File path of the texture container.
+		explicit TextureContainer(std::filesystem::path filepath);
+	public:
+		/// @brief Copy constructor.
+		consteval TextureContainer(const TextureContainer&) = delete;
+		/// @brief Copy assignment operator.
+		consteval TextureContainer& operator=(const TextureContainer&) = delete;
+		/// @brief Move constructor.
+		TextureContainer(TextureContainer&&) noexcept = default;
+		/// @brief Move assignment operator.
+		TextureContainer& operator=(TextureContainer&&) noexcept = default;
+		/// @brief Destructor.
+		virtual ~TextureContainer() = default;
+
+		/// @brief Filters available for CPU mip map generation.
+		enum class MipFilter : u8
+		{
+			/// @brief Average of the covered source pixels, fast.
+			Box,
+			/// @brief Kaiser windowed sinc, sharper mip levels with less aliasing.
+			Kaiser
+		};
+
+		/// @brief Retrieve the image format of the texture data.
+		/// @return Image format.
+		[[nodiscard]] constexpr Graphics::API::ImageFormat GetImageFormat() const noexcept;
+		/// @brief Retrieve the width of the base mip level.
+		/// @return Width in pixels.
+		[[nodiscard]] constexpr u32 GetWidth() const noexcept;
+		/// @brief Retrieve the height of the base mip level.
+		/// @return Height in pixels.
+		[[nodiscard]] constexpr u32 GetHeight() const noexcept;
+		/// @brief Retrieve the depth of the base mip level.
+		/// @return Depth in pixels, 1 for non 3D textures.
+		[[nodiscard]] constexpr u32 GetDepth() const noexcept;
+		/// @brief Retrieve the amount of array layers.
+		///        Every face of a cube map counts as its own layer.
+		/// @return Amount of array layers.
+		[[nodiscard]] constexpr u32 GetArraySize() const noexcept;
+		/// @brief Retrieve the amount of mip levels stored in the container.
+		/// @return Amount of mip levels.
+		[[nodiscard]] constexpr u32 GetMipLevels() const noexcept;
+		/// @brief Retrieve whether the container holds cube map(s) or not.
+		/// @return True if the container holds cube map(s), false otherwise.
+		[[nodiscard]] constexpr bool IsCubemap() const noexcept;
+		/// @brief Retrieve the file path of the texture container.
+		/// @return Path to the texture container file, or empty path for containers loaded from memory.
+		[[nodiscard]] const std::filesystem::path& GetFilePath() const noexcept;
+
+		/// @brief Retrieve the data of a single subresource.
+		///        The data is tightly packed, rows of blocks without padding followed by the next depth slice.
+		/// @param mipLevel Mip level.
+		/// @param arrayLayer Array layer, for cube maps this is layer * 6 + face.
+		/// @return Subresource data.
+		[[nodiscard]] std::span<const u8> GetSubresourceData(u32 mipLevel, u32 arrayLayer) const;
+
+		/// @brief Load a texture container from disk.
+		/// @param filepath File path of the texture container.
+		/// Supported formats:
+		///		- Khronos Texture 2: KTX2 (no supercompression or zlib)
+		///		- DirectDraw Surface: DDS (legacy and DX10 headers)
+		/// @return Loaded texture container on success, nullptr otherwise.
+		[[nodiscard]] static Scope<TextureContainer> LoadFromFile(const std::filesystem::path& filepath);
+		/// @brief Load a texture container from memory.
+		///        The container format is detected from the data.
+		/// @param data Encoded texture container, i.e. the content of a KTX2 or DDS file.
+		/// @return Loaded texture container on success, nullptr otherwise.
+		[[nodiscard]] static Scope<TextureContainer> LoadFromMemory(std::span<const u8> data);
+
+		/// @brief Create a texture container from an image on the CPU.
+		///        The whole mip chain is generated and block compressed (if requested) on the ThreadPool,
+		///        so neither has to happen on the GPU queue when the texture gets loaded.
+		///        Mip maps of sRGB formats are filtered in linear space.
+		/// @param threadPool ThreadPool to use.
+		/// @param image 8 bit per channel image to use as the base level.
+		/// @param format Target format, R8G8B8A8_UNORM/SRGB or a BC1, BC3 or BC7 format.
+		/// @param mipFilter Filter used for mip map generation.
+		/// @return Texture container on success, nullptr otherwise.
+		[[nodiscard]] static Scope<TextureContainer> CreateFromImage(ThreadPool& threadPool, const Image& image,
+		                                                             Graphics::API::ImageFormat format,
+																	 MipFilter mipFilter = MipFilter::Kaiser);
+		/// @brief Create a texture container from an image on the CPU using the engine ThreadPool.
+		/// @param image 8 bit per channel image to use as the base level.
+		/// @param format Target format, R8G8B8A8_UNORM/SRGB or a BC1, BC3 or BC7 format.
+		/// @param mipFilter Filter used for mip map generation.
+		/// @return Texture container on success, nullptr otherwise.
+		[[nodiscard]] static Scope<TextureContainer> CreateFromImage(const Image& image, Graphics::API::ImageFormat format,
+		                                                             MipFilter mipFilter = MipFilter::Kaiser);
+		/// @brief Load the cached texture container for an image file or create it.
+		///        The cache is (re)created as DDS file if it doesn't exist, is older than the image file
+		///        or holds a different format or mip filter. The cache file can be passed to Texture::Create2D() afterwards.
+		/// @param threadPool ThreadPool to use.
+		/// @param imageFilepath File path of the source image.
+		/// @param cacheFilepath File path of the cached DDS file.
+		/// @param format Target format, R8G8B8A8_UNORM/SRGB or a BC1, BC3 or BC7 format.
+		/// @param mipFilter Filter used for mip map generation.
+		/// @return Texture container on success, nullptr otherwise.
+		[[nodiscard]] static Scope<TextureContainer> LoadFromImageFileCached(ThreadPool& threadPool,
+		                                                                     const std::filesystem::path& imageFilepath,
+		                                                                     const std::filesystem::path& cacheFilepath,
+		                                                                     Graphics::API::ImageFormat format,
+		                                                                     MipFilter mipFilter = MipFilter::Kaiser);
+		/// @brief Load the cached texture container for an image file or create it using the engine ThreadPool.
+		/// @param imageFilepath File path of the source image.
+		/// @param cacheFilepath File path of the cached DDS file.
+		/// @param format Target format, R8G8B8A8_UNORM/SRGB or a BC1, BC3 or BC7 format.
+		/// @param mipFilter Filter used for mip map generation.
+		/// @return Texture container on success, nullptr otherwise.
+		[[nodiscard]] static Scope<TextureContainer> LoadFromImageFileCached(const std::filesystem::path& imageFilepath,
+		                                                                     const std::filesystem::path& cacheFilepath,
+		                                                                     Graphics::API::ImageFormat format,
+		                                                                     MipFilter mipFilter = MipFilter::Kaiser);
+
+		/// @brief Check if the given file is a supported texture container.
+		/// @param filepath Path to a file.
+		/// @return True if given file is a texture container, false otherwise.
+		[[nodiscard]] static bool IsSupportedTextureContainerFile(const std::filesystem::path& filepath);
+
+		/// @brief Calculate the size of a single tightly packed subresource.
+		/// @param format Image format.
+		/// @param width Width of the subresource in pixels.
+		/// @param height Height of the subresource in pixels.
+		/// @param depth Depth of the subresource in pixels.
+		/// @return Size in bytes.
+		[[nodiscard]] static constexpr u64 CalculateSubresourceSize(Graphics::API::ImageFormat format, u32 width,
+		                                                            u32 height, u32 depth) noexcept;
+
+		static constexpr std::array<std::string_view, 2> SupportedTextureContainerSuffixes
+		{
+			".ktx2", ".dds"
+		};
+
+	protected:
+		/// @brief Validate the container properties and the size of every subresource.
+		/// @param logPrefix Log prefix to use for errors.
+		/// @return True if the container is valid, false otherwise.
+		[[nodiscard]] bool Validate(std::string_view logPrefix) const;
+
+		Graphics::API::ImageFormat m_format = Graphics::API::ImageFormat::Undefined;
+		u32 m_width = 0;
+		u32 m_height = 0;
+		u32 m_depth = 1;
+		u32 m_arraySize = 1;
+		u32 m_mipLevels = 1;
+		bool m_isCubemap = false;
+		std::filesystem::path m_filepath;
+
+		/// @brief Location of a subresource inside the container data.
+		struct Subresource
+		{
+			u64 Offset = 0;
+			u64 Size = 0;
+		};
+
+		/// @brief Retrieve the container data the subresources point into.
+		/// @return Mapped file if there is one, m_data otherwise.
+		[[nodiscard]] std::span<const u8> GetData() const noexcept;
+
+		//Index is mipLevel * m_arraySize + arrayLayer
+		std::vector<Subresource> m_subresources{};
+		TRAP::Optional<FileSystem::MappedFile> m_file = TRAP::NullOpt;
+		//Used when loaded from memory or when the file data had to be decompressed
+		std::vector<u8> m_data{};
+	};
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] constexpr TRAP::Graphics::API::ImageFormat TRAP::TextureContainer::GetImageFormat() const noexcept
+{
+	return m_format;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] constexpr u32 TRAP::TextureContainer::GetWidth() const noexcept
+{
+	return m_width;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] constexpr u32 TRAP::TextureContainer::GetHeight() const noexcept
+{
+	return m_height;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] constexpr u32 TRAP::TextureContainer::GetDepth() const noexcept
+{
+	return m_depth;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] constexpr u32 TRAP::TextureContainer::GetArraySize() const noexcept
+{
+	return m_arraySize;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] constexpr u32 TRAP::TextureContainer::GetMipLevels() const noexcept
+{
+	return m_mipLevels;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] constexpr bool TRAP::TextureContainer::IsCubemap() const noexcept
+{
+	return m_isCubemap;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] constexpr u64 TRAP::TextureContainer::CalculateSubresourceSize(const Graphics::API::ImageFormat format,
+                                                                             const u32 width, const u32 height,
+                                                                             const u32 depth) noexcept
+{
+	const u64 blockWidth = Graphics::API::ImageFormatWidthOfBlock(format);
+	const u64 blockHeight = Graphics::API::ImageFormatHeightOfBlock(format);
+	const u64 blockBytes = Graphics::API::ImageFormatBitSizeOfBlock(format) / 8u;
+
+	const u64 blocksWide = (width + blockWidth - 1u) / blockWidth;
+	const u64 blocksHigh = (height + blockHeight - 1u) / blockHeight;
+
+	return blocksWide * blocksHigh * depth * blockBytes;
+}
+
+#endif /*TRAP_TEXTURECONTAINER_H*/
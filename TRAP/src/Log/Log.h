@@ -148,6 +148,8 @@ namespace TRAP
 		static constexpr auto ImageQOIPrefix =                       "[Image][QOI] ";
 		static constexpr auto ImageBMPPrefix =                       "[Image][BMP] ";
 		static constexpr auto ImageRadiancePrefix =                  "[Image][Radiance] ";
+		static constexpr auto ImageKTX2Prefix =                      "[Image][KTX2] ";
+		static constexpr auto ImageDDSPrefix =                       "[Image][DDS] ";
 		static constexpr auto Renderer2DPrefix =                     "[Renderer2D] ";
 		static constexpr auto RendererPrefix =                       "[Renderer] ";
 		static constexpr auto RendererBufferPrefix =                 "[Renderer][Buffer] ";
@@ -202,6 +204,7 @@ namespace TRAP
 		static constexpr auto NetworkTCPListenerPrefix =             "[Network][TCPListener] ";
 		static constexpr auto NetworkTCPSocketPrefix =               "[Network][TCPSocket] ";
 		static constexpr auto NetworkUDPSocketPrefix =               "[Network][UDPSocket] ";
+		static constexpr auto NetworkReactorPrefix =                 "[Network][Reactor] ";
 		static constexpr auto NetworkSocketUnixPrefix =              "[Network][Socket][Unix] ";
 		static constexpr auto SceneSerializerPrefix =                "[SceneSerializer] ";
 		static constexpr auto DiscordGameSDKPrefix =                 "[Discord] ";
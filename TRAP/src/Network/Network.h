@@ -34,6 +34,12 @@ Modified by: Jan "GamesTrap" Schuerkamp
 #include "IP/IPv4Address.h"
 #include "IP/IPv6Address.h"
 #include "Packet.h"
+#include "PacketPool.h"
+#include "PacketReader.h"
+#include "PacketWriter.h"
+#include "Reactor.h"
+#include "Serialization.h"
+#include "Sockets/DatagramBatch.h"
 #include "Sockets/Socket.h"
 #include "Sockets/SocketHandle.h"
 #include "Sockets/SocketSelector.h"
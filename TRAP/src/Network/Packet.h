@@ -33,6 +33,8 @@ Modified by: Jan "GamesTrap" Schuerkamp
 #include "Utils/Memory.h"
 
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -43,6 +45,7 @@ namespace TRAP::Network
 	class UDPSocket;
 	class TCPSocketIPv6;
 	class UDPSocketIPv6;
+	class PacketPool;
 
 	/// @brief Utility class to build blocks of data to transfer.
 	/// over the network
@@ -181,6 +184,7 @@ namespace TRAP::Network
 		friend class UDPSocket;
 		friend class TCPSocketIPv6;
 		friend class UDPSocketIPv6;
+		friend class PacketPool;
 
 		/// @brief Called before the packet is sent over the network.
 		///
@@ -222,6 +226,12 @@ namespace TRAP::Network
 		/// @return True if size bytes can be read from the packet.
 		[[nodiscard]] constexpr bool CheckSize(usize size) noexcept;
 
+		/// @brief Read the bytes of a value at the current reading position.
+		/// The caller has to check the size beforehand.
+		/// @return Value made from the bytes as they are stored in the packet.
+		template<typename T>
+		[[nodiscard]] constexpr T ReadBytes() const noexcept;
+
 		std::vector<u8> m_data{}; //Data stored in the packet
 		usize m_readPos = 0;  //Current reading position in the packet
 		usize m_sendPos = 0;  //Current send position in the packet (for handling partial sends)
@@ -294,6 +304,19 @@ constexpr TRAP::Network::Packet::operator bool() const noexcept
 	return m_isValid;
 }
 
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename T>
+[[nodiscard]] constexpr T TRAP::Network::Packet::ReadBytes() const noexcept
+{
+	std::array<u8, sizeof(T)> bytes{};
+	std::copy_n(&m_data[m_readPos], sizeof(T), bytes.begin());
+
+	return std::bit_cast<T>(bytes);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
 constexpr TRAP::Network::Packet& TRAP::Network::Packet::operator>>(bool& data)
 {
 	u8 value = 0;
@@ -309,7 +332,7 @@ constexpr TRAP::Network::Packet& TRAP::Network::Packet::operator>>(i8& data)
 {
 	if(CheckSize(sizeof(i8)))
 	{
-		std::copy_n(&m_data[m_readPos], sizeof(i8), &data);
+		data = ReadBytes<i8>();
 		m_readPos += sizeof(i8);
 	}
 
@@ -322,7 +345,7 @@ constexpr TRAP::Network::Packet& TRAP::Network::Packet::operator>>(u8& data)
 {
 	if(CheckSize(sizeof(u8)))
 	{
-		std::copy_n(&m_data[m_readPos], sizeof(u8), &data);
+		data = ReadBytes<u8>();
 		m_readPos += sizeof(u8);
 	}
 
@@ -335,7 +358,7 @@ constexpr TRAP::Network::Packet& TRAP::Network::Packet::operator>>(i16& data)
 {
 	if(CheckSize(sizeof(i16)))
 	{
-		std::copy_n(&m_data[m_readPos], sizeof(i16), &data);
+		data = ReadBytes<i16>();
 
 		if constexpr (Utils::GetEndian() == Utils::Endian::Little) //Need to convert to little endian
 			TRAP::Utils::Memory::SwapBytes(data);
@@ -352,7 +375,7 @@ constexpr TRAP::Network::Packet& TRAP::Network::Packet::operator>>(u16& data)
 {
 	if (CheckSize(sizeof(u16)))
 	{
-		std::copy_n(&m_data[m_readPos], sizeof(u16), &data);
+		data = ReadBytes<u16>();
 
 		if constexpr (Utils::GetEndian() == Utils::Endian::Little) //Need to convert to little endian
 			TRAP::Utils::Memory::SwapBytes(data);
@@ -369,7 +392,7 @@ constexpr TRAP::Network::Packet& TRAP::Network::Packet::operator>>(i32& data)
 {
 	if (CheckSize(sizeof(i32)))
 	{
-		std::copy_n(&m_data[m_readPos], sizeof(i32), &data);
+		data = ReadBytes<i32>();
 
 		if constexpr (Utils::GetEndian() == Utils::Endian::Little) //Need to convert to little endian
 			TRAP::Utils::Memory::SwapBytes(data);
@@ -386,7 +409,7 @@ constexpr TRAP::Network::Packet& TRAP::Network::Packet::operator>>(u32& data)
 {
 	if (CheckSize(sizeof(u32)))
 	{
-		std::copy_n(&m_data[m_readPos], sizeof(u32), &data);
+		data = ReadBytes<u32>();
 
 		if constexpr (Utils::GetEndian() == Utils::Endian::Little) //Need to convert to little endian
 			TRAP::Utils::Memory::SwapBytes(data);
@@ -403,7 +426,7 @@ constexpr TRAP::Network::Packet& TRAP::Network::Packet::operator>>(i64& data)
 {
 	if(CheckSize(sizeof(i64)))
 	{
-		std::copy_n(&m_data[m_readPos], sizeof(i64), &data);
+		data = ReadBytes<i64>();
 
 		if constexpr (Utils::GetEndian() == Utils::Endian::Little) //Need to convert to little endian
 			TRAP::Utils::Memory::SwapBytes(data);
@@ -420,7 +443,7 @@ constexpr TRAP::Network::Packet& TRAP::Network::Packet::operator>>(u64& data)
 {
 	if (CheckSize(sizeof(u64)))
 	{
-		std::copy_n(&m_data[m_readPos], sizeof(u64), &data);
+		data = ReadBytes<u64>();
 
 		if constexpr (Utils::GetEndian() == Utils::Endian::Little) //Need to convert to little endian
 			TRAP::Utils::Memory::SwapBytes(data);
@@ -437,7 +460,7 @@ constexpr TRAP::Network::Packet& TRAP::Network::Packet::operator>>(f32& data)
 {
 	if(CheckSize(sizeof(f32)))
 	{
-		std::copy_n(&m_data[m_readPos], sizeof(f32), &data);
+		data = ReadBytes<f32>();
 		m_readPos += sizeof(f32);
 	}
 
@@ -450,7 +473,7 @@ constexpr TRAP::Network::Packet& TRAP::Network::Packet::operator>>(f64& data)
 {
 	if (CheckSize(sizeof(f64)))
 	{
-		std::copy_n(&m_data[m_readPos], sizeof(f64), &data);
+		data = ReadBytes<f64>();
 		m_readPos += sizeof(f64);
 	}
 
@@ -656,8 +679,8 @@ constexpr TRAP::Network::Packet& TRAP::Network::Packet::operator<<(const f64 dat
 
 constexpr TRAP::Network::Packet& TRAP::Network::Packet::operator<<(const std::string_view data)
 {
-	//First insert string length
-	const usize length = data.size();
+	//First insert string length (as u32, matching what operator>> reads)
+	const u32 length = NumericCast<u32>(data.size());
 	*this << length;
 
 	//Then insert characters
@@ -671,13 +694,13 @@ constexpr TRAP::Network::Packet& TRAP::Network::Packet::operator<<(const std::st
 
 constexpr TRAP::Network::Packet& TRAP::Network::Packet::operator<<(const std::wstring_view data)
 {
-	//First insert string length
-	const usize length = data.size();
+	//First insert string length (as u32, matching what operator>> reads)
+	const u32 length = NumericCast<u32>(data.size());
 	*this << length;
 
-	//Then insert characters
-	if (length > 0)
-		Append(data.data(), length * sizeof(std::wstring::value_type));
+	//Then insert characters, wchar_t differs in size between platforms so each one is sent as u32
+	for(const wchar_t c : data)
+		*this << static_cast<u32>(c);
 
 	return *this;
 }
@@ -0,0 +1,59 @@
+#include "TRAPPCH.h"
+#include "PacketPool.h"
+
+[[nodiscard]] TRAP::Network::Packet TRAP::Network::PacketPool::Acquire()
+{
+	ZoneNamedC(__tracy, tracy::Color::Azure, (GetTRAPProfileSystems() & ProfileSystems::Network) != ProfileSystems::None &&
+	                                         (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	if(m_packets.empty())
+	{
+		Packet packet{};
+		packet.m_data.reserve(m_packetCapacity);
+		return packet;
+	}
+
+	Packet packet = std::move(m_packets.back());
+	m_packets.pop_back();
+	return packet;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] TRAP::Network::Packet TRAP::Network::PacketPool::Acquire(const std::span<const u8> data)
+{
+	ZoneNamedC(__tracy, tracy::Color::Azure, (GetTRAPProfileSystems() & ProfileSystems::Network) != ProfileSystems::None &&
+	                                         (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	Packet packet = Acquire();
+	packet.OnReceive(data.data(), data.size());
+	return packet;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::Network::PacketPool::Release(Packet&& packet)
+{
+	ZoneNamedC(__tracy, tracy::Color::Azure, (GetTRAPProfileSystems() & ProfileSystems::Network) != ProfileSystems::None &&
+	                                         (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	//Clear() keeps the memory of the packet
+	packet.Clear();
+	packet.m_sendPos = 0;
+	m_packets.push_back(std::move(packet));
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::Network::PacketPool::Reserve(const usize count)
+{
+	ZoneNamedC(__tracy, tracy::Color::Azure, (GetTRAPProfileSystems() & ProfileSystems::Network) != ProfileSystems::None);
+
+	m_packets.reserve(count);
+	while(m_packets.size() < count)
+	{
+		Packet packet{};
+		packet.m_data.reserve(m_packetCapacity);
+		m_packets.push_back(std::move(packet));
+	}
+}
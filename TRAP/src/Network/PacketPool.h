@@ -0,0 +1,81 @@
+#ifndef TRAP_NETWORK_PACKETPOOL_H
+#define TRAP_NETWORK_PACKETPOOL_H
+
+#include <span>
+#include <vector>
+
+#include "Packet.h"
+
+namespace TRAP::Network
+{
+	/// @brief Pool of reusable packets.
+	///
+	/// Released packets keep their memory, so acquiring a packet of a
+	/// similar size again doesn't allocate.
+	/// Use it together with a DatagramBatch to turn received datagrams
+	/// into packets without allocating for each datagram.
+	class PacketPool
+	{
+	public:
+		/// @brief Constructor.
+		/// @param packetCapacity Number of bytes reserved by packets that are newly created by the pool.
+		explicit constexpr PacketPool(usize packetCapacity = 0) noexcept;
+
+		/// @brief Destructor.
+		constexpr ~PacketPool() = default;
+
+		/// @brief Copy constructor.
+		consteval PacketPool(const PacketPool&) = delete;
+		/// @brief Copy assignment operator.
+		consteval PacketPool& operator=(const PacketPool&) = delete;
+		/// @brief Move constructor.
+		constexpr PacketPool(PacketPool&&) noexcept = default;
+		/// @brief Move assignment operator.
+		constexpr PacketPool& operator=(PacketPool&&) noexcept = default;
+
+		/// @brief Retrieve an empty packet.
+		///
+		/// Reuses a released packet if one is available.
+		/// @return Empty packet.
+		[[nodiscard]] Packet Acquire();
+
+		/// @brief Retrieve a packet filled with received data.
+		///
+		/// Reuses a released packet if one is available.
+		/// @param data Received data, i.e. the data of a datagram.
+		/// @return Packet holding the data, ready to be read from.
+		[[nodiscard]] Packet Acquire(std::span<const u8> data);
+
+		/// @brief Give a packet back to the pool, so its memory can be reused.
+		/// @param packet Packet to release.
+		void Release(Packet&& packet);
+
+		/// @brief Create packets up front, so later calls to Acquire() don't allocate.
+		/// @param count Number of packets that should be available.
+		void Reserve(usize count);
+
+		/// @brief Retrieve the number of packets that can be acquired without creating new ones.
+		/// @return Number of available packets.
+		[[nodiscard]] constexpr usize GetAvailable() const noexcept;
+
+	private:
+		std::vector<Packet> m_packets{}; //Released packets
+		usize m_packetCapacity;
+	};
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+constexpr TRAP::Network::PacketPool::PacketPool(const usize packetCapacity) noexcept
+	: m_packetCapacity(packetCapacity)
+{
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] constexpr usize TRAP::Network::PacketPool::GetAvailable() const noexcept
+{
+	return m_packets.size();
+}
+
+#endif /*TRAP_NETWORK_PACKETPOOL_H*/
@@ -0,0 +1,146 @@
+#ifndef TRAP_NETWORK_PACKETREADER_H
+#define TRAP_NETWORK_PACKETREADER_H
+
+#include <span>
+
+#include "Core/Types.h"
+#include "Network/Serialization.h"
+
+namespace TRAP::Network
+{
+	/// @brief Reads a packet directly from received memory,
+	/// e.g. a datagram of a DatagramBatch or a buffer filled by TCPSocket::Receive().
+	///
+	/// Unlike Packet this never copies or allocates memory,
+	/// strings are read as std::string_view pointing into the received memory.
+	/// Values are deserialized with a single bounds check per read value,
+	/// only the length of each string needs an additional check.
+	/// Reads data written by Packet and PacketWriter.
+	class PacketReader
+	{
+	public:
+		/// @brief Constructor.
+		/// @param data Data to read, must outlive the reader and all strings read from it.
+		explicit constexpr PacketReader(std::span<const u8> data) noexcept;
+
+		/// @brief Destructor.
+		constexpr ~PacketReader() = default;
+
+		/// @brief Copy constructor.
+		constexpr PacketReader(const PacketReader&) noexcept = default;
+		/// @brief Copy assignment operator.
+		constexpr PacketReader& operator=(const PacketReader&) noexcept = default;
+		/// @brief Move constructor.
+		constexpr PacketReader(PacketReader&&) noexcept = default;
+		/// @brief Move assignment operator.
+		constexpr PacketReader& operator=(PacketReader&&) noexcept = default;
+
+		/// @brief Deserialize a value from the current reading position.
+		/// If not enough data is left the reading position doesn't
+		/// change and the reader becomes invalid.
+		/// @param value Value to read into.
+		/// @return Reference to this.
+		template<Serializable T>
+		constexpr PacketReader& Read(T& value) noexcept;
+
+		/// @brief Deserialize a value from the current reading position.
+		/// @param value Value to read into.
+		/// @return Reference to this.
+		template<Serializable T>
+		constexpr PacketReader& operator>>(T& value) noexcept;
+
+		/// @brief Get the current reading position in the data.
+		/// @return The bytes offset of the current read position.
+		[[nodiscard]] constexpr usize GetReadPosition() const noexcept;
+		/// @brief Get the data that was not read yet.
+		/// @return Remaining data.
+		[[nodiscard]] constexpr std::span<const u8> GetRemainingData() const noexcept;
+
+		/// @brief Tell if the reading position has reached the end of the data.
+		/// @return True if all data was read, false otherwise.
+		[[nodiscard]] constexpr bool EndOfPacket() const noexcept;
+
+		/// @brief Test the validity of the reader.
+		/// A reader becomes invalid when a value couldn't be read.
+		/// @return True if all reads succeeded, false otherwise.
+		[[nodiscard]] constexpr explicit operator bool() const noexcept;
+
+	private:
+		std::span<const u8> m_data;
+		usize m_readPos = 0;
+		bool m_isValid = true;
+	};
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+constexpr TRAP::Network::PacketReader::PacketReader(const std::span<const u8> data) noexcept
+	: m_data(data)
+{
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<TRAP::Network::Serializable T>
+constexpr TRAP::Network::PacketReader& TRAP::Network::PacketReader::Read(T& value) noexcept
+{
+	//The only bounds check for all members with a fixed size,
+	//the slack is what strings can take their characters from
+	constexpr usize MinimumSize = INTERNAL::Network::Serialization::GetMinimumSize<T>();
+	const usize remaining = m_data.size() - m_readPos;
+	if(!m_isValid || MinimumSize > remaining)
+	{
+		m_isValid = false;
+		return *this;
+	}
+
+	usize slack = remaining - MinimumSize;
+	const u8* in = m_data.data() + m_readPos;
+	if(!INTERNAL::Network::Serialization::ReadUnchecked(in, slack, value))
+	{
+		m_isValid = false;
+		return *this;
+	}
+
+	m_readPos = static_cast<usize>(in - m_data.data());
+
+	return *this;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<TRAP::Network::Serializable T>
+constexpr TRAP::Network::PacketReader& TRAP::Network::PacketReader::operator>>(T& value) noexcept
+{
+	return Read(value);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] constexpr usize TRAP::Network::PacketReader::GetReadPosition() const noexcept
+{
+	return m_readPos;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] constexpr std::span<const u8> TRAP::Network::PacketReader::GetRemainingData() const noexcept
+{
+	return m_data.subspan(m_readPos);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] constexpr bool TRAP::Network::PacketReader::EndOfPacket() const noexcept
+{
+	return m_readPos >= m_data.size();
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] constexpr TRAP::Network::PacketReader::operator bool() const noexcept
+{
+	return m_isValid;
+}
+
+#endif /*TRAP_NETWORK_PACKETREADER_H*/
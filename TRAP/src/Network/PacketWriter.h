@@ -0,0 +1,148 @@
+#ifndef TRAP_NETWORK_PACKETWRITER_H
+#define TRAP_NETWORK_PACKETWRITER_H
+
+#include <span>
+
+#include "Core/Types.h"
+#include "Network/Serialization.h"
+
+namespace TRAP::Network
+{
+	/// @brief Builds a packet inside memory provided by the caller,
+	/// e.g. a fixed size array or memory from an arena.
+	///
+	/// Unlike Packet this never allocates memory and values are
+	/// serialized with a single bounds check per written value,
+	/// aggregates are written member by member without further checks.
+	/// The produced data is compatible with Packet and PacketReader.
+	class PacketWriter
+	{
+	public:
+		/// @brief Constructor.
+		/// @param buffer Memory to write the packet into, must outlive the writer.
+		explicit constexpr PacketWriter(std::span<u8> buffer) noexcept;
+
+		/// @brief Destructor.
+		constexpr ~PacketWriter() = default;
+
+		/// @brief Copy constructor.
+		consteval PacketWriter(const PacketWriter&) = delete;
+		/// @brief Copy assignment operator.
+		consteval PacketWriter& operator=(const PacketWriter&) = delete;
+		/// @brief Move constructor.
+		constexpr PacketWriter(PacketWriter&&) noexcept = default;
+		/// @brief Move assignment operator.
+		constexpr PacketWriter& operator=(PacketWriter&&) noexcept = default;
+
+		/// @brief Serialize a value to the end of the packet.
+		/// If the value doesn't fit into the remaining memory nothing
+		/// is written and the writer becomes invalid.
+		/// @param value Value to write.
+		/// @return Reference to this.
+		template<Serializable T>
+		constexpr PacketWriter& Write(const T& value) noexcept;
+
+		/// @brief Serialize a value to the end of the packet.
+		/// @param value Value to write.
+		/// @return Reference to this.
+		template<Serializable T>
+		constexpr PacketWriter& operator<<(const T& value) noexcept;
+
+		/// @brief Clear the packet and reset the writer to a valid state.
+		/// The memory is kept.
+		constexpr void Clear() noexcept;
+
+		/// @brief Get the written data.
+		/// @return Written data.
+		[[nodiscard]] constexpr std::span<const u8> GetData() const noexcept;
+		/// @brief Get the number of written bytes.
+		/// @return Size of the data in bytes.
+		[[nodiscard]] constexpr usize GetDataSize() const noexcept;
+		/// @brief Get the size of the memory the writer writes into.
+		/// @return Capacity in bytes.
+		[[nodiscard]] constexpr usize GetCapacity() const noexcept;
+
+		/// @brief Test the validity of the writer.
+		/// A writer becomes invalid when a value didn't fit into its memory.
+		/// @return True if all writes succeeded, false otherwise.
+		[[nodiscard]] constexpr explicit operator bool() const noexcept;
+
+	private:
+		std::span<u8> m_buffer;
+		usize m_size = 0;
+		bool m_isValid = true;
+	};
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+constexpr TRAP::Network::PacketWriter::PacketWriter(const std::span<u8> buffer) noexcept
+	: m_buffer(buffer)
+{
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<TRAP::Network::Serializable T>
+constexpr TRAP::Network::PacketWriter& TRAP::Network::PacketWriter::Write(const T& value) noexcept
+{
+	//The only bounds check for the whole value
+	const usize size = INTERNAL::Network::Serialization::GetSize(value);
+	if(!m_isValid || size > m_buffer.size() - m_size)
+	{
+		m_isValid = false;
+		return *this;
+	}
+
+	u8* out = m_buffer.data() + m_size;
+	INTERNAL::Network::Serialization::WriteUnchecked(out, value);
+	m_size += size;
+
+	return *this;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<TRAP::Network::Serializable T>
+constexpr TRAP::Network::PacketWriter& TRAP::Network::PacketWriter::operator<<(const T& value) noexcept
+{
+	return Write(value);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+constexpr void TRAP::Network::PacketWriter::Clear() noexcept
+{
+	m_size = 0;
+	m_isValid = true;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] constexpr std::span<const u8> TRAP::Network::PacketWriter::GetData() const noexcept
+{
+	return m_buffer.first(m_size);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] constexpr usize TRAP::Network::PacketWriter::GetDataSize() const noexcept
+{
+	return m_size;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] constexpr usize TRAP::Network::PacketWriter::GetCapacity() const noexcept
+{
+	return m_buffer.size();
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] constexpr TRAP::Network::PacketWriter::operator bool() const noexcept
+{
+	return m_isValid;
+}
+
+#endif /*TRAP_NETWORK_PACKETWRITER_H*/
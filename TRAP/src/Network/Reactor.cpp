@@ -0,0 +1,907 @@
+#include "TRAPPCH.h"
+#include "Reactor.h"
+
+#include "TCPListener.h"
+#include "Sockets/SocketImpl.h"
+#include "Sockets/TCPSocket.h"
+#include "Sockets/UDPSocket.h"
+#include "Utils/String/String.h"
+
+#ifdef TRAP_PLATFORM_WINDOWS
+#define far
+#else
+#include <sys/epoll.h>
+#endif /*TRAP_PLATFORM_WINDOWS*/
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	/// @brief Convert a time step to a clock duration.
+	/// @param time Time step to convert.
+	/// @return Clock duration.
+	[[nodiscard]] Clock::duration ToDuration(const TRAP::Utils::TimeStep time)
+	{
+		return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<f64>(time.GetSeconds()));
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Convert a duration to a wait timeout in milliseconds.
+	///        Rounds up so short waits don't turn into polling.
+	/// @param duration Duration to convert.
+	/// @return Timeout in milliseconds.
+	[[nodiscard]] i32 ToTimeoutMs(const Clock::duration duration)
+	{
+		if(duration <= Clock::duration::zero())
+			return 0;
+
+		const auto ms = std::chrono::ceil<std::chrono::milliseconds>(duration).count();
+		return NumericCast<i32>(std::min<decltype(ms)>(ms, std::numeric_limits<i32>::max()));
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+namespace TRAP::Network
+{
+	struct Reactor::ReactorImpl
+	{
+		/// @brief Constructor.
+		ReactorImpl();
+		/// @brief Destructor.
+		~ReactorImpl();
+
+		/// @brief Copy constructor.
+		ReactorImpl(const ReactorImpl&) = delete;
+		/// @brief Copy assignment operator.
+		ReactorImpl& operator=(const ReactorImpl&) = delete;
+		/// @brief Move constructor.
+		ReactorImpl(ReactorImpl&&) = delete;
+		/// @brief Move assignment operator.
+		ReactorImpl& operator=(ReactorImpl&&) = delete;
+
+		struct PendingSend
+		{
+			Packet Data;
+			SendCallback OnSent;
+		};
+
+		/// @brief Socket watched by the reactor.
+		struct Registration
+		{
+			u64 ID = 0; //Unique ID, detects registrations that got removed by a callback
+			Socket* Sock = nullptr;
+			SocketHandle Handle = INTERNAL::Network::SocketImpl::InvalidSocket();
+
+			AcceptCallback OnAccept{};
+			ConnectCallback OnConnect{};
+			PacketCallback OnPacket{};
+			DatagramCallback OnDatagram{};
+			std::deque<PendingSend> Sends{};
+
+			bool Read = false;  //Registered for read readiness
+			bool Write = false; //Registered for write readiness
+		};
+
+		struct Timer
+		{
+			Clock::time_point Deadline;
+			Clock::duration Interval;
+			TimerCallback OnTimer;
+		};
+
+		/// @brief Retrieve the registration of a socket, registers the socket if necessary.
+		/// @param socket Socket to retrieve the registration for.
+		/// @return Registration on success, nullptr if the socket is invalid.
+		[[nodiscard]] Registration* GetOrCreate(Socket& socket);
+		/// @brief Retrieve a registration if it still exists.
+		/// @param handle Socket handle of the registration.
+		/// @param id ID of the registration.
+		/// @return Registration if it still exists, nullptr otherwise.
+		[[nodiscard]] Registration* Find(SocketHandle handle, u64 id);
+		/// @brief Stop watching a socket.
+		/// @param handle Socket handle to stop watching.
+		void Unregister(SocketHandle handle);
+
+		/// @brief Update the readiness the poller waits for, based on the callbacks and queued sends.
+		/// @param reg Registration to update.
+		void UpdateInterest(Registration& reg);
+
+		/// @brief Handle the readiness of a socket.
+		/// @param handle Socket handle that is ready.
+		/// @param readable Whether the socket is readable.
+		/// @param writable Whether the socket is writable.
+		/// @param failed Whether the socket reported an error or a hang up.
+		/// @return Number of callbacks that ran.
+		[[nodiscard]] usize Dispatch(SocketHandle handle, bool readable, bool writable, bool failed);
+		[[nodiscard]] usize HandleConnect(Registration& reg);
+		[[nodiscard]] usize HandleAccept(Registration& reg);
+		[[nodiscard]] usize HandleReceive(Registration& reg);
+		[[nodiscard]] usize HandleReceiveFrom(Registration& reg);
+		[[nodiscard]] usize FlushSends(Registration& reg);
+		/// @brief Run a callback stored in a registration.
+		///        The callback is moved out while it runs, so re-arming it from inside (i.e. calling
+		///        Accept() or Receive() again) doesn't destroy it mid-call.
+		///        Afterwards it is put back, unless it was replaced or the registration was removed.
+		/// @param reg Registration owning the callback.
+		/// @param callback Member of the registration holding the callback.
+		/// @param args Arguments for the callback.
+		template<typename Callback, typename... Args>
+		void InvokeCallback(Registration& reg, Callback Registration::* callback, Args&&... args);
+
+		/// @brief Wait for socket readiness and dispatch it.
+		/// @param timeoutMs Maximum time to wait in milliseconds, -1 for infinity.
+		/// @return Number of callbacks that ran.
+		[[nodiscard]] usize Poll(i32 timeoutMs);
+		/// @brief Wake up a thread waiting in Poll().
+		void Wake();
+
+		/// @brief Run all timers that are due.
+		/// @return Number of callbacks that ran.
+		[[nodiscard]] usize RunTimers();
+		/// @brief Run all posted tasks and deferred completions.
+		/// @return Number of callbacks that ran.
+		[[nodiscard]] usize RunTasks();
+
+		std::unordered_map<SocketHandle, Scope<Registration>> Registrations{};
+		std::vector<Scope<Registration>> RemovedRegistrations{}; //Kept alive until their callbacks returned
+		u64 NextRegistrationID = 1;
+
+		std::unordered_map<TimerID, Timer> Timers{};
+		std::priority_queue<std::pair<Clock::time_point, TimerID>, std::vector<std::pair<Clock::time_point, TimerID>>,
+		                    std::greater<>> TimerQueue{};
+		TimerID NextTimerID = 1;
+
+		std::vector<Task> Completions{}; //Callbacks deferred to the end of the current iteration
+		std::mutex PostedMutex{};
+		std::vector<Task> Posted{};
+		std::atomic<bool> StopRequested = false;
+
+#ifdef TRAP_PLATFORM_WINDOWS
+		UDPSocket WakeSocket{}; //Loopback socket that sends to itself to wake up WSAPoll()
+		u16 WakePort = 0;
+		std::vector<WSAPOLLFD> PollFDs{};
+#else
+		i32 EPoll = -1;
+		i32 WakeFD = -1; //eventfd to wake up epoll_wait()
+		std::vector<epoll_event> Events{};
+#endif
+	};
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+TRAP::Network::Reactor::ReactorImpl::ReactorImpl()
+{
+#ifdef TRAP_PLATFORM_WINDOWS
+	if(WakeSocket.Bind(Socket::AnyPort, IPv4Address::LocalHost) != Status::Done)
+		TP_ERROR(Log::NetworkReactorPrefix, "Failed to bind wake up socket!");
+	WakeSocket.SetBlocking(false);
+	WakePort = WakeSocket.GetLocalPort();
+#else
+	EPoll = epoll_create1(EPOLL_CLOEXEC);
+	WakeFD = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	if(EPoll < 0 || WakeFD < 0)
+	{
+		TP_ERROR(Log::NetworkReactorPrefix, "Failed to create epoll instance!");
+		TP_ERROR(Log::NetworkReactorPrefix, Utils::String::GetStrError());
+		return;
+	}
+
+	epoll_event event{};
+	event.events = EPOLLIN;
+	event.data.fd = WakeFD;
+	if(epoll_ctl(EPoll, EPOLL_CTL_ADD, WakeFD, &event) < 0)
+	{
+		TP_ERROR(Log::NetworkReactorPrefix, "Failed to register wake up eventfd!");
+		TP_ERROR(Log::NetworkReactorPrefix, Utils::String::GetStrError());
+	}
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+TRAP::Network::Reactor::ReactorImpl::~ReactorImpl()
+{
+#ifndef TRAP_PLATFORM_WINDOWS
+	if(WakeFD >= 0)
+		::close(WakeFD);
+	if(EPoll >= 0)
+		::close(EPoll);
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] TRAP::Network::Reactor::ReactorImpl::Registration* TRAP::Network::Reactor::ReactorImpl::GetOrCreate(Socket& socket)
+{
+	const SocketHandle handle = socket.GetHandle();
+	if(handle == INTERNAL::Network::SocketImpl::InvalidSocket())
+	{
+		TP_ERROR(Log::NetworkReactorPrefix, "Can't watch an invalid socket!");
+		return nullptr;
+	}
+
+	Scope<Registration>& reg = Registrations[handle];
+	//A different socket with the same handle means the old socket was closed without being removed
+	if(reg && reg->Sock != &socket)
+		Unregister(handle);
+
+	if(!reg)
+	{
+		reg = MakeScope<Registration>();
+		reg->ID = NextRegistrationID++;
+		reg->Sock = &socket;
+		reg->Handle = handle;
+
+		socket.SetBlocking(false);
+	}
+
+	return reg.get();
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] TRAP::Network::Reactor::ReactorImpl::Registration* TRAP::Network::Reactor::ReactorImpl::Find(const SocketHandle handle,
+                                                                                                           const u64 id)
+{
+	const auto it = Registrations.find(handle);
+	if(it == Registrations.end() || !it->second || it->second->ID != id)
+		return nullptr;
+
+	return it->second.get();
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::Network::Reactor::ReactorImpl::Unregister(const SocketHandle handle)
+{
+	const auto it = Registrations.find(handle);
+	if(it == Registrations.end())
+		return;
+
+#ifndef TRAP_PLATFORM_WINDOWS
+	//Fails if the socket was already closed, which removed it from the epoll instance
+	if(it->second && (it->second->Read || it->second->Write))
+		epoll_ctl(EPoll, EPOLL_CTL_DEL, handle, nullptr);
+#endif
+
+	//The callbacks of the registration may currently be running
+	RemovedRegistrations.push_back(std::move(it->second));
+	Registrations.erase(it);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::Network::Reactor::ReactorImpl::UpdateInterest(Registration& reg)
+{
+	const bool read = reg.OnAccept || reg.OnPacket || reg.OnDatagram;
+	const bool write = reg.OnConnect || !reg.Sends.empty();
+
+	if(read == reg.Read && write == reg.Write)
+		return;
+
+#ifndef TRAP_PLATFORM_WINDOWS
+	epoll_event event{};
+	event.events = (read ? static_cast<u32>(EPOLLIN) : 0u) | (write ? static_cast<u32>(EPOLLOUT) : 0u);
+	event.data.fd = reg.Handle;
+
+	i32 result = 0;
+	if(!read && !write)
+		result = epoll_ctl(EPoll, EPOLL_CTL_DEL, reg.Handle, nullptr);
+	else if(!reg.Read && !reg.Write)
+		result = epoll_ctl(EPoll, EPOLL_CTL_ADD, reg.Handle, &event);
+	else
+	{
+		result = epoll_ctl(EPoll, EPOLL_CTL_MOD, reg.Handle, &event);
+		//The socket was closed and reopened with the same handle
+		if(result < 0 && errno == ENOENT)
+			result = epoll_ctl(EPoll, EPOLL_CTL_ADD, reg.Handle, &event);
+	}
+
+	if(result < 0 && (read || write))
+	{
+		TP_ERROR(Log::NetworkReactorPrefix, "Failed to watch socket!");
+		TP_ERROR(Log::NetworkReactorPrefix, Utils::String::GetStrError());
+	}
+#endif
+
+	reg.Read = read;
+	reg.Write = write;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] usize TRAP::Network::Reactor::ReactorImpl::Dispatch(const SocketHandle handle, const bool readable,
+                                                                  const bool writable, const bool failed)
+{
+	const auto it = Registrations.find(handle);
+	if(it == Registrations.end() || !it->second)
+		return 0;
+
+	const u64 id = it->second->ID;
+	usize count = 0;
+
+	//Errors are handled by the operation that is waiting, it will see the error status
+	if((writable || failed) && it->second->OnConnect)
+		count += HandleConnect(*it->second);
+
+	Registration* reg = Find(handle, id);
+	if(reg != nullptr && (writable || failed) && !reg->Sends.empty())
+	{
+		count += FlushSends(*reg);
+		reg = Find(handle, id);
+	}
+
+	if(reg != nullptr && (readable || failed))
+	{
+		if(reg->OnAccept)
+			count += HandleAccept(*reg);
+		else if(reg->OnPacket)
+			count += HandleReceive(*reg);
+		else if(reg->OnDatagram)
+			count += HandleReceiveFrom(*reg);
+	}
+
+	//Nothing handles the failure, stop watching so a hang up doesn't wake the poller forever
+	reg = Find(handle, id);
+	if(reg != nullptr && failed && !reg->Read && !reg->Write)
+		Unregister(handle);
+
+	return count;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename Callback, typename... Args>
+void TRAP::Network::Reactor::ReactorImpl::InvokeCallback(Registration& reg, Callback Registration::* const callback,
+                                                         Args&&... args)
+{
+	const SocketHandle handle = reg.Handle;
+	const u64 id = reg.ID;
+
+	Callback running = std::move(reg.*callback);
+	reg.*callback = nullptr;
+
+	running(std::forward<Args>(args)...);
+
+	Registration* const current = Find(handle, id);
+	if(current == nullptr || current->*callback)
+		return;
+
+	current->*callback = std::move(running);
+	//Interest may have been dropped while the callback was moved out
+	UpdateInterest(*current);
+}
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] usize TRAP::Network::Reactor::ReactorImpl::HandleConnect(Registration& reg)
+{
+	i32 error = 0;
+	INTERNAL::Network::SocketImpl::AddressLength length = sizeof(error);
+	if(getsockopt(reg.Handle, SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&error), &length) < 0)
+		error = -1;
+
+	const ConnectCallback onConnect = std::move(reg.OnConnect);
+	reg.OnConnect = nullptr;
+	UpdateInterest(reg);
+
+	onConnect(error == 0 ? Status::Done : Status::Error);
+
+	return 1;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] usize TRAP::Network::Reactor::ReactorImpl::HandleAccept(Registration& reg)
+{
+	const SocketHandle handle = reg.Handle;
+	const u64 id = reg.ID;
+	const TCPListener& listener = *static_cast<TCPListener*>(reg.Sock);
+
+	usize count = 0;
+	for(Registration* current = &reg; current != nullptr; current = Find(handle, id))
+	{
+		Scope<TCPSocket> socket = MakeScope<TCPSocket>();
+		const Status status = listener.Accept(*socket);
+		if(status == Status::NotReady)
+			break;
+
+		++count;
+		if(status != Status::Done)
+		{
+			InvokeCallback(*current, &Registration::OnAccept, status, nullptr);
+			break;
+		}
+
+		InvokeCallback(*current, &Registration::OnAccept, Status::Done, std::move(socket));
+	}
+
+	return count;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] usize TRAP::Network::Reactor::ReactorImpl::HandleReceive(Registration& reg)
+{
+	const SocketHandle handle = reg.Handle;
+	const u64 id = reg.ID;
+	TCPSocket& socket = *static_cast<TCPSocket*>(reg.Sock);
+
+	usize count = 0;
+	Packet packet{};
+	for(Registration* current = &reg; current != nullptr; current = Find(handle, id))
+	{
+		const Status status = socket.Receive(packet);
+		if(status == Status::NotReady)
+			break;
+
+		++count;
+		if(status != Status::Done)
+		{
+			//The connection is gone, remove the socket before reporting it so the callback may destroy it
+			const PacketCallback onPacket = current->OnPacket;
+			Unregister(handle);
+			onPacket(status, packet);
+			break;
+		}
+
+		InvokeCallback(*current, &Registration::OnPacket, Status::Done, packet);
+	}
+
+	return count;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] usize TRAP::Network::Reactor::ReactorImpl::HandleReceiveFrom(Registration& reg)
+{
+	const SocketHandle handle = reg.Handle;
+	const u64 id = reg.ID;
+	UDPSocket& socket = *static_cast<UDPSocket*>(reg.Sock);
+
+	usize count = 0;
+	Packet packet{};
+	IPv4Address remoteAddress{};
+	u16 remotePort = 0;
+	for(Registration* current = &reg; current != nullptr; current = Find(handle, id))
+	{
+		//Errors of connectionless sockets (i.e. ICMP port unreachable) are cleared by reading them
+		const Status status = socket.Receive(packet, remoteAddress, remotePort);
+		if(status != Status::Done)
+			break;
+
+		++count;
+		InvokeCallback(*current, &Registration::OnDatagram, packet, remoteAddress, remotePort);
+	}
+
+	return count;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] usize TRAP::Network::Reactor::ReactorImpl::FlushSends(Registration& reg)
+{
+	const SocketHandle handle = reg.Handle;
+	const u64 id = reg.ID;
+	const TCPSocket& socket = *static_cast<TCPSocket*>(reg.Sock);
+
+	usize count = 0;
+	for(Registration* current = &reg; current != nullptr && !current->Sends.empty(); current = Find(handle, id))
+	{
+		const Status status = socket.Send(current->Sends.front().Data);
+		if(status == Status::NotReady || status == Status::Partial)
+		{
+			UpdateInterest(*current);
+			break;
+		}
+
+		if(status != Status::Done)
+		{
+			//All queued packets fail with the same status
+			std::deque<PendingSend> failed = std::move(current->Sends);
+			current->Sends.clear();
+			UpdateInterest(*current);
+
+			for(PendingSend& send : failed)
+			{
+				if(send.OnSent)
+				{
+					send.OnSent(status);
+					++count;
+				}
+			}
+			break;
+		}
+
+		const SendCallback onSent = std::move(current->Sends.front().OnSent);
+		current->Sends.pop_front();
+		UpdateInterest(*current);
+
+		if(onSent)
+		{
+			onSent(Status::Done);
+			++count;
+		}
+	}
+
+	return count;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] usize TRAP::Network::Reactor::ReactorImpl::Poll(const i32 timeoutMs)
+{
+	usize count = 0;
+
+#ifdef TRAP_PLATFORM_WINDOWS
+	PollFDs.clear();
+	PollFDs.push_back({WakeSocket.GetHandle(), POLLRDNORM, 0});
+	for(const auto& [handle, reg] : Registrations)
+	{
+		if(reg && (reg->Read || reg->Write))
+			PollFDs.push_back({handle, static_cast<SHORT>((reg->Read ? POLLRDNORM : 0) | (reg->Write ? POLLWRNORM : 0)), 0});
+	}
+
+	const i32 ready = WSAPoll(PollFDs.data(), NumericCast<ULONG>(PollFDs.size()), timeoutMs);
+	if(ready <= 0)
+		return 0;
+
+	if(PollFDs[0].revents != 0)
+	{
+		//Drain the wake up datagrams
+		std::array<u8, 16> buffer{};
+		usize received = 0;
+		IPv4Address address{};
+		u16 port = 0;
+		while(WakeSocket.Receive(buffer.data(), buffer.size(), received, address, port) == Status::Done)
+		{
+		}
+	}
+
+	for(const WSAPOLLFD& pollFD : std::span(PollFDs).subspan(1))
+	{
+		if(pollFD.revents == 0)
+			continue;
+
+		count += Dispatch(pollFD.fd, (pollFD.revents & POLLRDNORM) != 0, (pollFD.revents & POLLWRNORM) != 0,
+		                  (pollFD.revents & (POLLERR | POLLHUP | POLLNVAL)) != 0);
+	}
+#else
+	if(EPoll < 0)
+		return 0;
+
+	//Room for every socket, so a single iteration handles all ready sockets
+	if(Events.size() < Registrations.size() + 1u)
+		Events.resize(Registrations.size() + 1u);
+
+	const i32 ready = epoll_wait(EPoll, Events.data(), NumericCast<i32>(Events.size()), timeoutMs);
+	if(ready <= 0)
+		return 0;
+
+	for(const epoll_event& event : std::span(Events).first(NumericCast<usize>(ready)))
+	{
+		if(event.data.fd == WakeFD)
+		{
+			u64 value = 0;
+			while(::read(WakeFD, &value, sizeof(value)) > 0)
+			{
+			}
+			continue;
+		}
+
+		count += Dispatch(event.data.fd, (event.events & EPOLLIN) != 0u, (event.events & EPOLLOUT) != 0u,
+		                  (event.events & (EPOLLERR | EPOLLHUP)) != 0u);
+	}
+#endif
+
+	return count;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::Network::Reactor::ReactorImpl::Wake()
+{
+#ifdef TRAP_PLATFORM_WINDOWS
+	const u8 data = 0;
+	if(WakeSocket.Send(&data, sizeof(data), IPv4Address::LocalHost, WakePort) == Status::Error)
+		TP_ERROR(Log::NetworkReactorPrefix, "Failed to wake up the reactor!");
+#else
+	const u64 value = 1;
+	if(::write(WakeFD, &value, sizeof(value)) < 0 && errno != EAGAIN)
+	{
+		TP_ERROR(Log::NetworkReactorPrefix, "Failed to wake up the reactor!");
+		TP_ERROR(Log::NetworkReactorPrefix, Utils::String::GetStrError());
+	}
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] usize TRAP::Network::Reactor::ReactorImpl::RunTimers()
+{
+	//Timers added by callbacks with no delay run in the next iteration
+	const Clock::time_point now = Clock::now();
+
+	usize count = 0;
+	while(!TimerQueue.empty() && TimerQueue.top().first <= now)
+	{
+		const TimerID id = TimerQueue.top().second;
+		TimerQueue.pop();
+
+		const auto it = Timers.find(id);
+		if(it == Timers.end()) //Cancelled
+			continue;
+
+		//The callback may cancel its own timer
+		TimerCallback onTimer = std::move(it->second.OnTimer);
+		const Clock::duration interval = it->second.Interval;
+		if(interval <= Clock::duration::zero())
+			Timers.erase(it);
+
+		onTimer();
+		++count;
+
+		if(interval <= Clock::duration::zero())
+			continue;
+
+		const auto repeatIt = Timers.find(id);
+		if(repeatIt == Timers.end())
+			continue;
+
+		//Skip missed intervals instead of running the timer repeatedly to catch up
+		repeatIt->second.Deadline = std::max(repeatIt->second.Deadline + interval, now);
+		repeatIt->second.OnTimer = std::move(onTimer);
+		TimerQueue.emplace(repeatIt->second.Deadline, id);
+	}
+
+	return count;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] usize TRAP::Network::Reactor::ReactorImpl::RunTasks()
+{
+	std::vector<Task> tasks{};
+	{
+		const std::lock_guard lock(PostedMutex);
+		std::swap(tasks, Posted);
+	}
+
+	//Completions are only touched by the thread running the loop
+	tasks.insert(tasks.end(), std::make_move_iterator(Completions.begin()), std::make_move_iterator(Completions.end()));
+	Completions.clear();
+
+	for(Task& task : tasks)
+		task();
+
+	return tasks.size();
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------------//
+
+TRAP::Network::Reactor::Reactor()
+	: m_impl(MakeScope<ReactorImpl>())
+{
+	ZoneNamedC(__tracy, tracy::Color::Azure, (GetTRAPProfileSystems() & ProfileSystems::Network) != ProfileSystems::None);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+TRAP::Network::Reactor::~Reactor() = default;
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::Network::Reactor::Accept(TCPListener& listener, AcceptCallback onAccept)
+{
+	ZoneNamedC(__tracy, tracy::Color::Azure, (GetTRAPProfileSystems() & ProfileSystems::Network) != ProfileSystems::None);
+
+	ReactorImpl::Registration* const reg = m_impl->GetOrCreate(listener);
+	if(reg == nullptr)
+		return;
+
+	reg->OnAccept = std::move(onAccept);
+	m_impl->UpdateInterest(*reg);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::Network::Reactor::Connect(TCPSocket& socket, const IPv4Address& remoteAddress, const u16 remotePort,
+                                     ConnectCallback onConnected)
+{
+	ZoneNamedC(__tracy, tracy::Color::Azure, (GetTRAPProfileSystems() & ProfileSystems::Network) != ProfileSystems::None);
+
+	//Connecting replaces the socket handle
+	Remove(socket);
+
+	socket.SetBlocking(false);
+	const Status status = socket.Connect(remoteAddress, remotePort);
+	if(status != Status::NotReady)
+	{
+		//Finished (or failed) right away, report it from the event loop like every other result
+		m_impl->Completions.emplace_back([onConnected = std::move(onConnected), status]()
+		{
+			onConnected(status);
+		});
+		return;
+	}
+
+	ReactorImpl::Registration* const reg = m_impl->GetOrCreate(socket);
+	if(reg == nullptr)
+		return;
+
+	reg->OnConnect = std::move(onConnected);
+	m_impl->UpdateInterest(*reg);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::Network::Reactor::Receive(TCPSocket& socket, PacketCallback onPacket)
+{
+	ZoneNamedC(__tracy, tracy::Color::Azure, (GetTRAPProfileSystems() & ProfileSystems::Network) != ProfileSystems::None);
+
+	ReactorImpl::Registration* const reg = m_impl->GetOrCreate(socket);
+	if(reg == nullptr)
+		return;
+
+	reg->OnPacket = std::move(onPacket);
+	m_impl->UpdateInterest(*reg);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::Network::Reactor::Receive(UDPSocket& socket, DatagramCallback onDatagram)
+{
+	ZoneNamedC(__tracy, tracy::Color::Azure, (GetTRAPProfileSystems() & ProfileSystems::Network) != ProfileSystems::None);
+
+	ReactorImpl::Registration* const reg = m_impl->GetOrCreate(socket);
+	if(reg == nullptr)
+		return;
+
+	reg->OnDatagram = std::move(onDatagram);
+	m_impl->UpdateInterest(*reg);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::Network::Reactor::Send(TCPSocket& socket, Packet packet, SendCallback onSent)
+{
+	ZoneNamedC(__tracy, tracy::Color::Azure, (GetTRAPProfileSystems() & ProfileSystems::Network) != ProfileSystems::None);
+
+	ReactorImpl::Registration* const reg = m_impl->GetOrCreate(socket);
+	if(reg == nullptr)
+	{
+		if(onSent)
+			m_impl->Completions.emplace_back([onSent = std::move(onSent)](){ onSent(Status::Error); });
+		return;
+	}
+
+	//Queued packets go first to keep the order
+	if(!reg->Sends.empty())
+	{
+		reg->Sends.push_back({std::move(packet), std::move(onSent)});
+		return;
+	}
+
+	//Most sends fit into the socket buffer, try right away instead of waiting for the next iteration
+	const Status status = socket.Send(packet);
+	if(status == Status::NotReady || status == Status::Partial)
+	{
+		reg->Sends.push_back({std::move(packet), std::move(onSent)});
+		m_impl->UpdateInterest(*reg);
+		return;
+	}
+
+	if(onSent)
+		m_impl->Completions.emplace_back([onSent = std::move(onSent), status](){ onSent(status); });
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::Network::Reactor::Remove(Socket& socket)
+{
+	ZoneNamedC(__tracy, tracy::Color::Azure, (GetTRAPProfileSystems() & ProfileSystems::Network) != ProfileSystems::None);
+
+	const SocketHandle handle = socket.GetHandle();
+	if(handle == INTERNAL::Network::SocketImpl::InvalidSocket())
+		return;
+
+	const auto it = m_impl->Registrations.find(handle);
+	if(it != m_impl->Registrations.end() && it->second && it->second->Sock == &socket)
+		m_impl->Unregister(handle);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+TRAP::Network::Reactor::TimerID TRAP::Network::Reactor::AddTimer(const Utils::TimeStep delay, TimerCallback onTimer,
+                                                                 const Utils::TimeStep interval)
+{
+	ZoneNamedC(__tracy, tracy::Color::Azure, (GetTRAPProfileSystems() & ProfileSystems::Network) != ProfileSystems::None);
+
+	const TimerID id = m_impl->NextTimerID++;
+	const Clock::time_point deadline = Clock::now() + ToDuration(delay);
+
+	m_impl->Timers.emplace(id, ReactorImpl::Timer{deadline, ToDuration(interval), std::move(onTimer)});
+	m_impl->TimerQueue.emplace(deadline, id);
+
+	return id;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::Network::Reactor::CancelTimer(const TimerID timer)
+{
+	ZoneNamedC(__tracy, tracy::Color::Azure, (GetTRAPProfileSystems() & ProfileSystems::Network) != ProfileSystems::None);
+
+	//The queue entry is skipped once it is due
+	m_impl->Timers.erase(timer);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::Network::Reactor::Post(Task task)
+{
+	ZoneNamedC(__tracy, tracy::Color::Azure, (GetTRAPProfileSystems() & ProfileSystems::Network) != ProfileSystems::None);
+
+	{
+		const std::lock_guard lock(m_impl->PostedMutex);
+		m_impl->Posted.push_back(std::move(task));
+	}
+
+	m_impl->Wake();
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+usize TRAP::Network::Reactor::RunOnce(const Utils::TimeStep timeout)
+{
+	ZoneNamedC(__tracy, tracy::Color::Azure, (GetTRAPProfileSystems() & ProfileSystems::Network) != ProfileSystems::None);
+
+	i32 timeoutMs = timeout != Utils::TimeStep(0.0f) ? ToTimeoutMs(ToDuration(timeout)) : -1;
+
+	//Don't sleep past the next timer or while completions are waiting
+	if(!m_impl->TimerQueue.empty())
+	{
+		const i32 timerMs = ToTimeoutMs(m_impl->TimerQueue.top().first - Clock::now());
+		timeoutMs = timeoutMs < 0 ? timerMs : std::min(timeoutMs, timerMs);
+	}
+	if(!m_impl->Completions.empty())
+		timeoutMs = 0;
+
+	usize count = m_impl->Poll(timeoutMs);
+	count += m_impl->RunTimers();
+	count += m_impl->RunTasks();
+
+	m_impl->RemovedRegistrations.clear();
+
+	return count;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::Network::Reactor::Run()
+{
+	ZoneNamedC(__tracy, tracy::Color::Azure, (GetTRAPProfileSystems() & ProfileSystems::Network) != ProfileSystems::None);
+
+	//Resets the request so the reactor can be run again
+	while(!m_impl->StopRequested.exchange(false))
+		RunOnce(Utils::TimeStep(0.0f));
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::Network::Reactor::Stop()
+{
+	ZoneNamedC(__tracy, tracy::Color::Azure, (GetTRAPProfileSystems() & ProfileSystems::Network) != ProfileSystems::None);
+
+	m_impl->StopRequested = true;
+	m_impl->Wake();
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+#ifdef TRAP_PLATFORM_WINDOWS
+#undef far
+#endif /*TRAP_PLATFORM_WINDOWS*/
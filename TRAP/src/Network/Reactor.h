@@ -0,0 +1,152 @@
+#ifndef TRAP_NETWORK_REACTOR_H
+#define TRAP_NETWORK_REACTOR_H
+
+#include <functional>
+
+#include "Core/Base.h"
+#include "IP/IPv4Address.h"
+#include "Packet.h"
+#include "Sockets/Socket.h"
+#include "Utils/Time/TimeStep.h"
+
+namespace TRAP::Network
+{
+	class TCPListener;
+	class TCPSocket;
+	class UDPSocket;
+
+	/// @brief Event loop that drives non-blocking sockets and timers with callbacks.
+	///
+	///        Sockets handed to the reactor are switched to non-blocking mode.
+	///        Like SocketSelector the reactor only keeps references to the sockets,
+	///        so a socket must be removed with Remove() before it is destroyed.
+	///        All callbacks run on the thread calling Run() or RunOnce().
+	///
+	///        On Linux the reactor is backed by epoll, on Windows by WSAPoll().
+	///
+	///        Example (echo server):
+	///        TRAP::Network::Reactor reactor{};
+	///        reactor.Accept(listener, [&](const Status status, TRAP::Scope<TRAP::Network::TCPSocket> socket)
+	///        {
+	///            TRAP::Network::TCPSocket& s = *clients.emplace_back(std::move(socket));
+	///            reactor.Receive(s, [&](const Status status, TRAP::Network::Packet& packet)
+	///            {
+	///                if(status == Status::Done)
+	///                    reactor.Send(s, std::move(packet));
+	///            });
+	///        });
+	///        reactor.Run();
+	/// @threadsafety Only Post() and Stop() may be called from other threads.
+	///               To use multiple threads, run one Reactor per thread and hand
+	///               accepted sockets to the other reactors with Post().
+	class Reactor
+	{
+	public:
+		using Status = Socket::Status;
+		using TimerID = u64;
+
+		/// @brief Called for every accepted connection.
+		///        On failure the status is Status::Error and the socket is nullptr.
+		using AcceptCallback = std::function<void(Status, Scope<TCPSocket>)>;
+		/// @brief Called once the connection attempt finished, with Status::Done on success.
+		using ConnectCallback = std::function<void(Status)>;
+		/// @brief Called for every received packet with Status::Done.
+		///        Called a last time with Status::Disconnected or Status::Error,
+		///        after which the socket was removed from the reactor.
+		using PacketCallback = std::function<void(Status, Packet&)>;
+		/// @brief Called for every received datagram together with the address and port of the sender.
+		using DatagramCallback = std::function<void(Packet&, const IPv4Address&, u16)>;
+		/// @brief Called once the packet has been sent completely, or with the status that made sending fail.
+		using SendCallback = std::function<void(Status)>;
+		using TimerCallback = std::function<void()>;
+		using Task = std::function<void()>;
+
+		/// @brief Constructor.
+		Reactor();
+		/// @brief Destructor.
+		~Reactor();
+
+		/// @brief Copy constructor.
+		Reactor(const Reactor&) = delete;
+		/// @brief Copy assignment operator.
+		Reactor& operator=(const Reactor&) = delete;
+		/// @brief Move constructor.
+		Reactor(Reactor&&) = delete;
+		/// @brief Move assignment operator.
+		Reactor& operator=(Reactor&&) = delete;
+
+		/// @brief Accept all incoming connections of a listening socket.
+		/// @param listener Listener to accept connections from, must be listening already.
+		/// @param onAccept Called for every accepted connection.
+		void Accept(TCPListener& listener, AcceptCallback onAccept);
+
+		/// @brief Connect a socket to a remote peer without blocking.
+		/// @param socket Socket to connect.
+		/// @param remoteAddress Address of the remote peer.
+		/// @param remotePort Port of the remote peer.
+		/// @param onConnected Called once the connection attempt finished.
+		void Connect(TCPSocket& socket, const IPv4Address& remoteAddress, u16 remotePort, ConnectCallback onConnected);
+
+		/// @brief Receive all packets arriving on a connected socket.
+		/// @param socket Connected socket.
+		/// @param onPacket Called for every received packet.
+		void Receive(TCPSocket& socket, PacketCallback onPacket);
+
+		/// @brief Receive all datagrams arriving on a bound socket.
+		/// @param socket Bound socket.
+		/// @param onDatagram Called for every received datagram.
+		void Receive(UDPSocket& socket, DatagramCallback onDatagram);
+
+		/// @brief Send a packet over a connected socket.
+		///
+		///        Packets are sent in the order of the calls.
+		///        If the socket can't take the whole packet right away,
+		///        the rest is sent once the socket becomes writable again.
+		/// @param socket Connected socket.
+		/// @param packet Packet to send.
+		/// @param onSent Optional callback, called from the event loop once the packet has been sent.
+		void Send(TCPSocket& socket, Packet packet, SendCallback onSent = {});
+
+		/// @brief Stop watching a socket.
+		///
+		///        Queued packets that have not been sent yet are dropped.
+		///        This function doesn't close the socket.
+		/// @param socket Socket to remove.
+		void Remove(Socket& socket);
+
+		/// @brief Run a callback after a delay.
+		/// @param delay Delay after which the callback gets called.
+		/// @param onTimer Callback to run.
+		/// @param interval Interval in which the callback gets called again, TimeStep(0.0f) to only call it once.
+		/// @return ID of the timer, can be used to cancel it.
+		TimerID AddTimer(Utils::TimeStep delay, TimerCallback onTimer, Utils::TimeStep interval = Utils::TimeStep(0.0f));
+		/// @brief Cancel a timer.
+		///        Does nothing if the timer already finished.
+		/// @param timer ID of the timer to cancel.
+		void CancelTimer(TimerID timer);
+
+		/// @brief Run a task on the thread of the event loop.
+		/// @param task Task to run.
+		/// @threadsafety This function is thread safe.
+		void Post(Task task);
+
+		/// @brief Wait for events once and run all callbacks that are ready.
+		/// @param timeout Maximum time to wait, (use TRAP::Utils::TimeStep(0.0f) for infinity).
+		/// @return Number of callbacks that ran.
+		usize RunOnce(Utils::TimeStep timeout);
+
+		/// @brief Run the event loop until Stop() gets called.
+		void Run();
+
+		/// @brief Make Run() return after the current iteration.
+		/// @threadsafety This function is thread safe.
+		void Stop();
+
+	private:
+		struct ReactorImpl;
+
+		Scope<ReactorImpl> m_impl; //Opaque pointer to the implementation (which requires OS-specific types)
+	};
+}
+
+#endif /*TRAP_NETWORK_REACTOR_H*/
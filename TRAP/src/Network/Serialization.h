@@ -0,0 +1,297 @@
+#ifndef TRAP_NETWORK_SERIALIZATION_H
+#define TRAP_NETWORK_SERIALIZATION_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <limits>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "Core/Types.h"
+#include "Utils/Utils.h"
+#include "Utils/Memory.h"
+
+/// @brief Compile-time serialization of plain aggregates, used by PacketWriter and PacketReader.
+///
+/// The members of an aggregate are found with structured bindings,
+/// no reflection or registration macros are needed.
+/// The wire format is the same as the one of TRAP::Network::Packet:
+/// integers in network byte order, floating points as is, bools as u8
+/// and strings as u32 length followed by the characters.
+namespace TRAP::INTERNAL::Network::Serialization
+{
+	/// @brief Maximum number of members of an aggregate that can be serialized.
+	inline constexpr usize MaxAggregateMembers = 16;
+
+	/// @brief Type that converts to any member type, used to count the members of an aggregate.
+	struct AnyMember
+	{
+		template<typename T>
+		constexpr operator T() const noexcept; //Only used in unevaluated contexts
+	};
+
+	template<typename T, typename... Args>
+	concept BraceConstructible = requires { T{std::declval<Args>()...}; };
+
+	/// @brief Count the members of an aggregate.
+	/// @return Number of members.
+	template<typename T, typename... Members>
+	[[nodiscard]] consteval usize CountMembers()
+	{
+		if constexpr (sizeof...(Members) <= MaxAggregateMembers && BraceConstructible<T, Members..., AnyMember>)
+			return CountMembers<T, Members..., AnyMember>();
+		else
+			return sizeof...(Members);
+	}
+
+	/// @brief Retrieve references to all members of an aggregate.
+	/// @param value Aggregate.
+	/// @return Tuple of references to the members.
+	template<typename T>
+	[[nodiscard]] constexpr auto TieMembers(T& value) noexcept
+	{
+		constexpr usize Count = CountMembers<std::remove_cv_t<T>>();
+
+		if constexpr (Count == 1) { auto& [m0] = value; return std::tie(m0); }
+		else if constexpr (Count == 2) { auto& [m0, m1] = value; return std::tie(m0, m1); }
+		else if constexpr (Count == 3) { auto& [m0, m1, m2] = value; return std::tie(m0, m1, m2); }
+		else if constexpr (Count == 4) { auto& [m0, m1, m2, m3] = value; return std::tie(m0, m1, m2, m3); }
+		else if constexpr (Count == 5) { auto& [m0, m1, m2, m3, m4] = value; return std::tie(m0, m1, m2, m3, m4); }
+		else if constexpr (Count == 6) { auto& [m0, m1, m2, m3, m4, m5] = value; return std::tie(m0, m1, m2, m3, m4, m5); }
+		else if constexpr (Count == 7) { auto& [m0, m1, m2, m3, m4, m5, m6] = value; return std::tie(m0, m1, m2, m3, m4, m5, m6); }
+		else if constexpr (Count == 8) { auto& [m0, m1, m2, m3, m4, m5, m6, m7] = value; return std::tie(m0, m1, m2, m3, m4, m5, m6, m7); }
+		else if constexpr (Count == 9) { auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8] = value; return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8); }
+		else if constexpr (Count == 10) { auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9] = value; return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9); }
+		else if constexpr (Count == 11) { auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10] = value; return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10); }
+		else if constexpr (Count == 12) { auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11] = value; return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11); }
+		else if constexpr (Count == 13) { auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12] = value; return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12); }
+		else if constexpr (Count == 14) { auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13] = value; return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13); }
+		else if constexpr (Count == 15) { auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14] = value; return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14); }
+		else if constexpr (Count == 16) { auto& [m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15] = value; return std::tie(m0, m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12, m13, m14, m15); }
+		else
+			static_assert(Count != 0 && Count <= MaxAggregateMembers, "Aggregate has no members or too many members to be serialized!");
+	}
+
+	template<typename T>
+	using MemberTuple = decltype(TieMembers(std::declval<T&>()));
+
+	template<typename T>
+	struct IsStdArray : std::false_type {};
+	template<typename T, usize N>
+	struct IsStdArray<std::array<T, N>> : std::true_type {};
+
+	/// @brief Types that are serialized as they are.
+	template<typename T>
+	concept Scalar = std::is_arithmetic_v<T> || std::is_enum_v<T>;
+
+	template<typename T>
+	concept SerializableAggregate = std::is_aggregate_v<T> && std::is_class_v<T> && !IsStdArray<T>::value &&
+	                                (CountMembers<T>() != 0) && (CountMembers<T>() <= MaxAggregateMembers);
+
+	/// @brief Check whether a type can be serialized.
+	/// @return True if the type can be serialized, false otherwise.
+	template<typename T>
+	[[nodiscard]] consteval bool IsSerializable()
+	{
+		if constexpr (Scalar<T> || std::same_as<T, std::string_view>)
+			return true;
+		else if constexpr (IsStdArray<T>::value)
+			return IsSerializable<typename T::value_type>();
+		else if constexpr (SerializableAggregate<T>)
+		{
+			return []<usize... I>(std::index_sequence<I...>)
+			{
+				return (IsSerializable<std::remove_cvref_t<std::tuple_element_t<I, MemberTuple<T>>>>() && ...);
+			}(std::make_index_sequence<std::tuple_size_v<MemberTuple<T>>>{});
+		}
+		else
+			return false;
+	}
+
+	/// @brief Retrieve the number of bytes a type needs at least,
+	/// strings only count with their length prefix.
+	/// @return Minimum serialized size in bytes.
+	template<typename T>
+	[[nodiscard]] consteval usize GetMinimumSize()
+	{
+		if constexpr (std::same_as<T, bool>)
+			return sizeof(u8);
+		else if constexpr (std::is_enum_v<T>)
+			return sizeof(std::underlying_type_t<T>);
+		else if constexpr (std::is_arithmetic_v<T>)
+			return sizeof(T);
+		else if constexpr (std::same_as<T, std::string_view>)
+			return sizeof(u32);
+		else if constexpr (IsStdArray<T>::value)
+			return std::tuple_size_v<T> * GetMinimumSize<typename T::value_type>();
+		else
+		{
+			return []<usize... I>(std::index_sequence<I...>)
+			{
+				return (GetMinimumSize<std::remove_cvref_t<std::tuple_element_t<I, MemberTuple<T>>>>() + ...);
+			}(std::make_index_sequence<std::tuple_size_v<MemberTuple<T>>>{});
+		}
+	}
+
+	/// @brief Check whether the serialized size of a type is known at compile-time.
+	/// @return True if the type contains no strings, false otherwise.
+	template<typename T>
+	[[nodiscard]] consteval bool HasFixedSize()
+	{
+		if constexpr (Scalar<T>)
+			return true;
+		else if constexpr (std::same_as<T, std::string_view>)
+			return false;
+		else if constexpr (IsStdArray<T>::value)
+			return HasFixedSize<typename T::value_type>();
+		else
+		{
+			return []<usize... I>(std::index_sequence<I...>)
+			{
+				return (HasFixedSize<std::remove_cvref_t<std::tuple_element_t<I, MemberTuple<T>>>>() && ...);
+			}(std::make_index_sequence<std::tuple_size_v<MemberTuple<T>>>{});
+		}
+	}
+
+	/// @brief Retrieve the serialized size of a value.
+	/// @param value Value to retrieve the size for.
+	/// @return Serialized size in bytes.
+	template<typename T>
+	[[nodiscard]] constexpr usize GetSize(const T& value) noexcept
+	{
+		if constexpr (HasFixedSize<T>())
+			return GetMinimumSize<T>();
+		else if constexpr (std::same_as<T, std::string_view>)
+			return sizeof(u32) + value.size();
+		else if constexpr (IsStdArray<T>::value)
+		{
+			usize size = 0;
+			for(const auto& element : value)
+				size += GetSize(element);
+			return size;
+		}
+		else
+			return std::apply([](const auto&... members){ return (GetSize(members) + ...); }, TieMembers(value));
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Write a value without bounds checks, the caller checked that it fits.
+	/// @param out Destination, advanced past the written bytes.
+	/// @param value Value to write.
+	template<typename T>
+	constexpr void WriteUnchecked(u8*& out, const T& value) noexcept
+	{
+		if constexpr (std::same_as<T, bool>)
+			*out++ = static_cast<u8>(value);
+		else if constexpr (std::is_enum_v<T>)
+			WriteUnchecked(out, static_cast<std::underlying_type_t<T>>(value));
+		else if constexpr (std::integral<T>)
+		{
+			T data = value;
+			if constexpr (sizeof(T) > 1 && Utils::GetEndian() == Utils::Endian::Little)
+				TRAP::Utils::Memory::SwapBytes(data); //Need to convert to big endian
+
+			const auto bytes = std::bit_cast<std::array<u8, sizeof(T)>>(data);
+			out = std::ranges::copy(bytes, out).out;
+		}
+		else if constexpr (std::floating_point<T>)
+		{
+			const auto bytes = std::bit_cast<std::array<u8, sizeof(T)>>(value);
+			out = std::ranges::copy(bytes, out).out;
+		}
+		else if constexpr (std::same_as<T, std::string_view>)
+		{
+			WriteUnchecked(out, NumericCast<u32>(value.size()));
+			out = std::ranges::transform(value, out, [](const char c){ return static_cast<u8>(c); }).out;
+		}
+		else if constexpr (IsStdArray<T>::value)
+		{
+			for(const auto& element : value)
+				WriteUnchecked(out, element);
+		}
+		else
+			std::apply([&out](const auto&... members){ (WriteUnchecked(out, members), ...); }, TieMembers(value));
+	}
+
+	/// @brief Read a value, only strings are bounds checked.
+	/// The caller checked that GetMinimumSize<T>() bytes are available,
+	/// slack holds the number of bytes available beyond that.
+	/// String contents can only be taken from the slack, so the members
+	/// following a string are still guaranteed to fit.
+	/// @param in Source, advanced past the read bytes.
+	/// @param slack Bytes available for string contents, reduced by the read strings.
+	/// @param value Value to read into, strings point into the source.
+	/// @return True on success, false if a string is longer than the remaining data.
+	template<typename T>
+	[[nodiscard]] constexpr bool ReadUnchecked(const u8*& in, usize& slack, T& value) noexcept
+	{
+		if constexpr (std::same_as<T, bool>)
+		{
+			value = (*in++ != 0);
+			return true;
+		}
+		else if constexpr (std::is_enum_v<T>)
+		{
+			std::underlying_type_t<T> data{};
+			(void)ReadUnchecked(in, slack, data);
+			value = static_cast<T>(data);
+			return true;
+		}
+		else if constexpr (std::integral<T> || std::floating_point<T>)
+		{
+			std::array<u8, sizeof(T)> bytes{};
+			std::copy_n(in, sizeof(T), bytes.data());
+			in += sizeof(T);
+
+			value = std::bit_cast<T>(bytes);
+			if constexpr (std::integral<T> && sizeof(T) > 1 && Utils::GetEndian() == Utils::Endian::Little)
+				TRAP::Utils::Memory::SwapBytes(value); //Need to convert to little endian
+
+			return true;
+		}
+		else if constexpr (std::same_as<T, std::string_view>)
+		{
+			u32 length = 0;
+			(void)ReadUnchecked(in, slack, length);
+
+			//The length comes from the data, so it has to be checked
+			if(length > slack)
+				return false;
+
+			value = std::string_view(reinterpret_cast<const char*>(in), length);
+			in += length;
+			slack -= length;
+
+			return true;
+		}
+		else if constexpr (IsStdArray<T>::value)
+		{
+			for(auto& element : value)
+			{
+				if(!ReadUnchecked(in, slack, element))
+					return false;
+			}
+			return true;
+		}
+		else
+			return std::apply([&in, &slack](auto&... members){ return (ReadUnchecked(in, slack, members) && ...); }, TieMembers(value));
+	}
+}
+
+namespace TRAP::Network
+{
+	/// @brief Types that can be written by PacketWriter and read by PacketReader.
+	///
+	/// These are arithmetic types, enums, std::string_view, std::array of
+	/// serializable types, and aggregates (up to 16 members) whose members
+	/// are all serializable.
+	template<typename T>
+	concept Serializable = INTERNAL::Network::Serialization::IsSerializable<std::remove_cvref_t<T>>();
+}
+
+#endif /*TRAP_NETWORK_SERIALIZATION_H*/
@@ -0,0 +1,260 @@
+#ifndef TRAP_NETWORK_DATAGRAMBATCH_H
+#define TRAP_NETWORK_DATAGRAMBATCH_H
+
+#include <span>
+#include <vector>
+
+#include "Core/Types.h"
+#include "TRAP_Assert.h"
+#include "Network/IP/IPv4Address.h"
+#include "Network/IP/IPv6Address.h"
+
+namespace TRAP::Network
+{
+	class UDPSocket;
+	class UDPSocketIPv6;
+
+	/// @brief A single datagram together with the address and port of its peer.
+	///
+	/// For received datagrams the data points into the storage of the
+	/// BasicDatagramBatch it was received into.
+	/// For datagrams to send the data points to memory owned by the caller.
+	template<typename AddressType>
+	struct BasicDatagram
+	{
+		std::span<const u8> Data{};
+		AddressType RemoteAddress{};
+		u16 RemotePort = 0;
+	};
+
+	/// @brief Preallocated ring of datagram buffers, used to receive
+	/// many datagrams with a single system call.
+	///
+	/// Datagrams are appended by UDPSocket::Receive(DatagramBatch&) and
+	/// stay valid until they are popped, so new datagrams can be received
+	/// while older ones are still being processed.
+	/// No memory is allocated after construction.
+	template<typename AddressType>
+	class BasicDatagramBatch
+	{
+	public:
+		/// @brief Constructor.
+		/// @param capacity Maximum number of datagrams the batch can hold.
+		/// @param maxDatagramSize Maximum size of a single datagram in bytes.
+		///                        Bigger datagrams are discarded when received.
+		constexpr BasicDatagramBatch(usize capacity, usize maxDatagramSize);
+
+		/// @brief Destructor.
+		constexpr ~BasicDatagramBatch() = default;
+
+		/// @brief Copy constructor.
+		consteval BasicDatagramBatch(const BasicDatagramBatch&) = delete;
+		/// @brief Copy assignment operator.
+		consteval BasicDatagramBatch& operator=(const BasicDatagramBatch&) = delete;
+		/// @brief Move constructor.
+		constexpr BasicDatagramBatch(BasicDatagramBatch&&) noexcept = default;
+		/// @brief Move assignment operator.
+		constexpr BasicDatagramBatch& operator=(BasicDatagramBatch&&) noexcept = default;
+
+		/// @brief Retrieve the maximum number of datagrams the batch can hold.
+		/// @return Capacity of the batch.
+		[[nodiscard]] constexpr usize GetCapacity() const noexcept;
+		/// @brief Retrieve the maximum size of a single datagram.
+		/// @return Maximum datagram size in bytes.
+		[[nodiscard]] constexpr usize GetMaxDatagramSize() const noexcept;
+
+		/// @brief Retrieve the number of datagrams that were received and not popped yet.
+		/// @return Number of datagrams.
+		[[nodiscard]] constexpr usize GetSize() const noexcept;
+		/// @brief Check whether the batch holds no datagrams.
+		/// @return True if the batch is empty, false otherwise.
+		[[nodiscard]] constexpr bool IsEmpty() const noexcept;
+		/// @brief Check whether all slots of the batch are in use.
+		/// @return True if the batch is full, false otherwise.
+		[[nodiscard]] constexpr bool IsFull() const noexcept;
+
+		/// @brief Retrieve a datagram.
+		/// @param index Index of the datagram, 0 being the oldest one.
+		/// @return Datagram.
+		[[nodiscard]] constexpr const BasicDatagram<AddressType>& operator[](usize index) const;
+		/// @brief Retrieve the oldest datagram.
+		/// @return Datagram.
+		[[nodiscard]] constexpr const BasicDatagram<AddressType>& Front() const;
+
+		/// @brief Release the oldest datagrams so their slots can be reused.
+		/// @param count Number of datagrams to release.
+		constexpr void Pop(usize count = 1);
+		/// @brief Release all datagrams.
+		constexpr void Clear() noexcept;
+
+	private:
+		friend class UDPSocket;
+		friend class UDPSocketIPv6;
+
+		/// @brief Retrieve the first free slot, new datagrams are received into it.
+		/// @return Physical index of the first free slot.
+		[[nodiscard]] constexpr usize GetFreeSlot() const noexcept;
+		/// @brief Retrieve the number of free slots following GetFreeSlot() without wrapping around.
+		/// @return Number of contiguous free slots.
+		[[nodiscard]] constexpr usize GetContiguousFreeSlots() const noexcept;
+		/// @brief Retrieve the buffer of a slot.
+		/// @param slot Physical index of the slot.
+		/// @return Buffer of the slot.
+		[[nodiscard]] constexpr std::span<u8> GetSlotBuffer(usize slot) noexcept;
+		/// @brief Append a datagram that was received into the first free slot.
+		/// @param size Size of the received datagram.
+		/// @param remoteAddress Address of the peer that sent the datagram.
+		/// @param remotePort Port of the peer that sent the datagram.
+		constexpr void Push(usize size, const AddressType& remoteAddress, u16 remotePort);
+
+		std::vector<u8> m_storage;                           //Buffers of all slots
+		std::vector<BasicDatagram<AddressType>> m_datagrams; //Received datagrams, indexed by slot
+		usize m_maxDatagramSize;
+		usize m_head = 0;  //Physical index of the oldest datagram
+		usize m_count = 0; //Number of datagrams in use
+	};
+
+	using Datagram = BasicDatagram<IPv4Address>;
+	using DatagramIPv6 = BasicDatagram<IPv6Address>;
+	using DatagramBatch = BasicDatagramBatch<IPv4Address>;
+	using DatagramBatchIPv6 = BasicDatagramBatch<IPv6Address>;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename AddressType>
+constexpr TRAP::Network::BasicDatagramBatch<AddressType>::BasicDatagramBatch(const usize capacity,
+                                                                             const usize maxDatagramSize)
+	: m_storage(capacity * maxDatagramSize), m_datagrams(capacity), m_maxDatagramSize(maxDatagramSize)
+{
+	TRAP_ASSERT(capacity > 0, "BasicDatagramBatch::BasicDatagramBatch(): Capacity must not be 0!");
+	TRAP_ASSERT(maxDatagramSize > 0, "BasicDatagramBatch::BasicDatagramBatch(): Max datagram size must not be 0!");
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename AddressType>
+[[nodiscard]] constexpr usize TRAP::Network::BasicDatagramBatch<AddressType>::GetCapacity() const noexcept
+{
+	return m_datagrams.size();
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename AddressType>
+[[nodiscard]] constexpr usize TRAP::Network::BasicDatagramBatch<AddressType>::GetMaxDatagramSize() const noexcept
+{
+	return m_maxDatagramSize;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename AddressType>
+[[nodiscard]] constexpr usize TRAP::Network::BasicDatagramBatch<AddressType>::GetSize() const noexcept
+{
+	return m_count;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename AddressType>
+[[nodiscard]] constexpr bool TRAP::Network::BasicDatagramBatch<AddressType>::IsEmpty() const noexcept
+{
+	return m_count == 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename AddressType>
+[[nodiscard]] constexpr bool TRAP::Network::BasicDatagramBatch<AddressType>::IsFull() const noexcept
+{
+	return m_count == GetCapacity();
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename AddressType>
+[[nodiscard]] constexpr const TRAP::Network::BasicDatagram<AddressType>& TRAP::Network::BasicDatagramBatch<AddressType>::operator[](const usize index) const
+{
+	TRAP_ASSERT(index < m_count, "BasicDatagramBatch::operator[]: Index out of range!");
+
+	return m_datagrams[(m_head + index) % GetCapacity()];
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename AddressType>
+[[nodiscard]] constexpr const TRAP::Network::BasicDatagram<AddressType>& TRAP::Network::BasicDatagramBatch<AddressType>::Front() const
+{
+	return (*this)[0];
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename AddressType>
+constexpr void TRAP::Network::BasicDatagramBatch<AddressType>::Pop(const usize count)
+{
+	TRAP_ASSERT(count <= m_count, "BasicDatagramBatch::Pop(): Can't pop more datagrams than the batch holds!");
+
+	m_head = (m_head + count) % GetCapacity();
+	m_count -= count;
+
+	//Start over at the beginning so the next receive gets as many contiguous slots as possible
+	if(m_count == 0)
+		m_head = 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename AddressType>
+constexpr void TRAP::Network::BasicDatagramBatch<AddressType>::Clear() noexcept
+{
+	m_head = 0;
+	m_count = 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename AddressType>
+[[nodiscard]] constexpr usize TRAP::Network::BasicDatagramBatch<AddressType>::GetFreeSlot() const noexcept
+{
+	return (m_head + m_count) % GetCapacity();
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename AddressType>
+[[nodiscard]] constexpr usize TRAP::Network::BasicDatagramBatch<AddressType>::GetContiguousFreeSlots() const noexcept
+{
+	if(IsFull())
+		return 0;
+
+	const usize freeSlot = GetFreeSlot();
+	if(freeSlot < m_head)
+		return m_head - freeSlot;
+
+	return GetCapacity() - freeSlot;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename AddressType>
+[[nodiscard]] constexpr std::span<u8> TRAP::Network::BasicDatagramBatch<AddressType>::GetSlotBuffer(const usize slot) noexcept
+{
+	return std::span(m_storage).subspan(slot * m_maxDatagramSize, m_maxDatagramSize);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename AddressType>
+constexpr void TRAP::Network::BasicDatagramBatch<AddressType>::Push(const usize size, const AddressType& remoteAddress,
+                                                                    const u16 remotePort)
+{
+	TRAP_ASSERT(!IsFull(), "BasicDatagramBatch::Push(): Batch is full!");
+
+	const usize slot = GetFreeSlot();
+	m_datagrams[slot] = BasicDatagram<AddressType>{GetSlotBuffer(slot).first(size), remoteAddress, remotePort};
+	++m_count;
+}
+
+#endif /*TRAP_NETWORK_DATAGRAMBATCH_H*/
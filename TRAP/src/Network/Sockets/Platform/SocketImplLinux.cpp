@@ -115,4 +115,67 @@ void TRAP::INTERNAL::Network::SocketImpl::SetBlocking(const TRAP::Network::Socke
 	}
 }
 
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] TRAP::Network::Socket::Status TRAP::INTERNAL::Network::SocketImpl::SendBuffers(const TRAP::Network::SocketHandle sock,
+                                                                                             const std::span<const std::span<const u8>> buffers,
+                                                                                             const usize offset,
+                                                                                             usize& sent)
+{
+	ZoneNamedC(__tracy, tracy::Color::Azure, (GetTRAPProfileSystems() & ProfileSystems::Network) != ProfileSystems::None);
+
+	//Enough for a batch of small packets (header + data each), IOV_MAX is much larger
+	static constexpr usize MaxBuffersPerCall = 64;
+
+	sent = 0;
+
+	//Position of the first byte that still has to be sent
+	usize bufferIndex = 0;
+	usize bufferOffset = offset;
+
+	while(true)
+	{
+		//Skip buffers that are empty or were sent completely
+		while(bufferIndex < buffers.size() && bufferOffset >= buffers[bufferIndex].size())
+		{
+			bufferOffset -= buffers[bufferIndex].size();
+			++bufferIndex;
+		}
+		if(bufferIndex == buffers.size())
+			return TRAP::Network::Socket::Status::Done;
+
+		//Point the I/O vectors directly at the remaining buffers, no copy needed
+		std::array<iovec, MaxBuffersPerCall> vectors{};
+		usize vectorCount = 0;
+		for(usize i = bufferIndex; i < buffers.size() && vectorCount < vectors.size(); ++i)
+		{
+			const usize start = (i == bufferIndex) ? bufferOffset : 0u;
+			if(start == buffers[i].size())
+				continue;
+
+			vectors[vectorCount].iov_base = const_cast<u8*>(buffers[i].data() + start);
+			vectors[vectorCount].iov_len = buffers[i].size() - start;
+			++vectorCount;
+		}
+
+		msghdr message{};
+		message.msg_iov = vectors.data();
+		message.msg_iovlen = vectorCount;
+
+		const isize result = sendmsg(sock, &message, MSG_NOSIGNAL);
+		if(result < 0)
+		{
+			const TRAP::Network::Socket::Status status = GetErrorStatus();
+
+			if((status == TRAP::Network::Socket::Status::NotReady) && (sent != 0u))
+				return TRAP::Network::Socket::Status::Partial;
+
+			return status;
+		}
+
+		sent += static_cast<usize>(result);
+		bufferOffset += static_cast<usize>(result);
+	}
+}
+
 #endif /*TRAP_PLATFORM_LINUX*/
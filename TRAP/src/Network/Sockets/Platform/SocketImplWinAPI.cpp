@@ -88,6 +88,65 @@ void TRAP::INTERNAL::Network::SocketImpl::SetBlocking(const TRAP::Network::Socke
 
 //-------------------------------------------------------------------------------------------------------------------//
 
+[[nodiscard]] TRAP::Network::Socket::Status TRAP::INTERNAL::Network::SocketImpl::SendBuffers(const TRAP::Network::SocketHandle sock,
+                                                                                             const std::span<const std::span<const u8>> buffers,
+                                                                                             const usize offset,
+                                                                                             usize& sent)
+{
+	ZoneNamedC(__tracy, tracy::Color::Azure, (GetTRAPProfileSystems() & ProfileSystems::Network) != ProfileSystems::None);
+
+	//Enough for a batch of small packets (header + data each)
+	static constexpr usize MaxBuffersPerCall = 64;
+
+	sent = 0;
+
+	//Position of the first byte that still has to be sent
+	usize bufferIndex = 0;
+	usize bufferOffset = offset;
+
+	while(true)
+	{
+		//Skip buffers that are empty or were sent completely
+		while(bufferIndex < buffers.size() && bufferOffset >= buffers[bufferIndex].size())
+		{
+			bufferOffset -= buffers[bufferIndex].size();
+			++bufferIndex;
+		}
+		if(bufferIndex == buffers.size())
+			return TRAP::Network::Socket::Status::Done;
+
+		//Point the WSA buffers directly at the remaining buffers, no copy needed
+		std::array<WSABUF, MaxBuffersPerCall> wsaBuffers{};
+		DWORD wsaBufferCount = 0;
+		for(usize i = bufferIndex; i < buffers.size() && wsaBufferCount < wsaBuffers.size(); ++i)
+		{
+			const usize start = (i == bufferIndex) ? bufferOffset : 0u;
+			if(start == buffers[i].size())
+				continue;
+
+			wsaBuffers[wsaBufferCount].buf = reinterpret_cast<CHAR*>(const_cast<u8*>(buffers[i].data() + start));
+			wsaBuffers[wsaBufferCount].len = NumericCast<ULONG>(buffers[i].size() - start);
+			++wsaBufferCount;
+		}
+
+		DWORD result = 0;
+		if(WSASend(sock, wsaBuffers.data(), wsaBufferCount, &result, 0, nullptr, nullptr) == SOCKET_ERROR)
+		{
+			const TRAP::Network::Socket::Status status = GetErrorStatus();
+
+			if((status == TRAP::Network::Socket::Status::NotReady) && (sent != 0u))
+				return TRAP::Network::Socket::Status::Partial;
+
+			return status;
+		}
+
+		sent += result;
+		bufferOffset += result;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
 /// @brief Windows needs some initialization and cleanup to get
 /// sockets working properly... so let's create a class that will
 /// do it automatically
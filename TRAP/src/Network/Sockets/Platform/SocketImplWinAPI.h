@@ -29,6 +29,8 @@ Modified by: Jan "GamesTrap" Schuerkamp
 #ifndef TRAP_NETWORK_SOCKETIMPLWINAPI_H
 #define TRAP_NETWORK_SOCKETIMPLWINAPI_H
 
+#include <span>
+
 #include "Core/PlatformDetection.h"
 #include "Core/Types.h"
 #include "Network/Sockets/Socket.h"
@@ -73,6 +75,18 @@ namespace TRAP::INTERNAL::Network::SocketImpl
 	/// @brief Get the last socket error status.
 	/// @return Status corresponding to the last socket error.
 	[[nodiscard]] TRAP::Network::Socket::Status GetErrorStatus();
+
+	/// @brief Send multiple buffers in order with as few system calls as possible (scatter-gather I/O).
+	///
+	/// In blocking mode, this function returns once all bytes have been sent.
+	/// @param sock Handle of the socket.
+	/// @param buffers Buffers to send.
+	/// @param offset Number of bytes at the start of the buffers that were already sent by a previous call.
+	/// @param sent The number of bytes sent by this call will be written here.
+	/// @return Status code, Status::Partial if only some of the remaining bytes were sent.
+	[[nodiscard]] TRAP::Network::Socket::Status SendBuffers(TRAP::Network::SocketHandle sock,
+	                                                        std::span<const std::span<const u8>> buffers,
+	                                                        usize offset, usize& sent);
 }
 
 //-------------------------------------------------------------------------------------------------------------------//
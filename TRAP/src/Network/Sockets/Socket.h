@@ -36,6 +36,7 @@ Modified by: Jan "GamesTrap" Schuerkamp
 namespace TRAP::Network
 {
 	class SocketSelector;
+	class Reactor;
 
 	class Socket
 	{
@@ -134,6 +135,7 @@ namespace TRAP::Network
 
 	private:
 		friend class SocketSelector;
+		friend class Reactor;
 
 		Type m_type = Type::TCP; //Type of the socket (TCP or UDP)
 #ifdef TRAP_PLATFORM_LINUX
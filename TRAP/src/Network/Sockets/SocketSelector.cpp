@@ -32,35 +32,156 @@ Modified by: Jan "GamesTrap" Schuerkamp
 #include "Socket.h"
 #include "SocketHandle.h"
 #include "SocketImpl.h"
+#include "Utils/String/String.h"
 #include "Utils/Time/TimeStep.h"
 
 #ifdef TRAP_PLATFORM_WINDOWS
 #define far
+#else
+#include <sys/epoll.h>
 #endif /*TRAP_PLATFORM_WINDOWS*/
 
 namespace TRAP::Network
 {
 	struct SocketSelector::SocketSelectorImpl
 	{
-		fd_set AllSockets;   //Set containing all the sockets handles
-		fd_set SocketsReady; //Set containing handles of the sockets that are ready
-		i32 MaxSockets;  //Maximum socket handle
-		i32 SocketCount; //Number of socket handles
+		/// @brief Constructor.
+		/// @param mode Mode in which ready sockets are reported.
+		explicit SocketSelectorImpl(TriggerMode mode);
+		/// @brief Destructor.
+		~SocketSelectorImpl();
+		/// @brief Copy constructor.
+		SocketSelectorImpl(const SocketSelectorImpl& other);
+		/// @brief Copy assignment operator.
+		SocketSelectorImpl& operator=(const SocketSelectorImpl&) = delete;
+		/// @brief Move constructor.
+		SocketSelectorImpl(SocketSelectorImpl&&) = delete;
+		/// @brief Move assignment operator.
+		SocketSelectorImpl& operator=(SocketSelectorImpl&&) = delete;
+
+		/// @brief Socket registered in the selector.
+		struct Entry
+		{
+			Socket* Sock = nullptr;
+			u64 ReadyWait = 0; //Index of the last Wait() that reported the socket as ready
+		};
+
+		TriggerMode Mode;
+		std::unordered_map<SocketHandle, Entry> Sockets{}; //All the sockets in the selector
+		std::vector<Socket*> ReadySockets{}; //Sockets reported as ready by the last Wait()
+		u64 WaitCount = 1; //Index of the current Wait(), 0 is never ready
+
+#ifdef TRAP_PLATFORM_WINDOWS
+		fd_set AllSockets{};   //Set containing all the sockets handles
+		fd_set SocketsReady{}; //Set containing handles of the sockets that are ready
+#else
+		i32 EPoll = -1; //epoll instance
+		std::vector<epoll_event> Events{}; //Output storage for epoll_wait()
+
+		/// @brief Register a socket handle in the epoll instance.
+		/// @param handle Socket handle to register.
+		/// @return True on success, false otherwise.
+		[[nodiscard]] bool Register(SocketHandle handle) const;
+#endif
 	};
 }
 
 //-------------------------------------------------------------------------------------------------------------------//
 
+TRAP::Network::SocketSelector::SocketSelectorImpl::SocketSelectorImpl(const TriggerMode mode)
+	: Mode(mode)
+{
+#ifdef TRAP_PLATFORM_WINDOWS
+	if(Mode == TriggerMode::Edge)
+	{
+		TP_WARN(Log::NetworkSocketPrefix, "Edge triggered socket selectors are not supported on this platform, using level triggered mode");
+		Mode = TriggerMode::Level;
+	}
+
+	FD_ZERO(&AllSockets);
+	FD_ZERO(&SocketsReady);
+#else
+	EPoll = epoll_create1(EPOLL_CLOEXEC);
+	if(EPoll < 0)
+	{
+		TP_ERROR(Log::NetworkSocketPrefix, "Failed to create epoll instance!");
+		TP_ERROR(Log::NetworkSocketPrefix, Utils::String::GetStrError());
+	}
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+TRAP::Network::SocketSelector::SocketSelectorImpl::~SocketSelectorImpl()
+{
+#ifndef TRAP_PLATFORM_WINDOWS
+	if(EPoll >= 0)
+		::close(EPoll);
+#endif
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+TRAP::Network::SocketSelector::SocketSelectorImpl::SocketSelectorImpl(const SocketSelectorImpl& other)
+	: SocketSelectorImpl(other.Mode)
+{
+	//The ready state is not copied, the copy starts waiting from scratch
+	for(const auto& [handle, entry] : other.Sockets)
+	{
+#ifdef TRAP_PLATFORM_WINDOWS
+		FD_SET(handle, &AllSockets);
+#else
+		if(!Register(handle))
+			continue;
+#endif
+
+		Sockets.emplace(handle, Entry{entry.Sock, 0});
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+#ifndef TRAP_PLATFORM_WINDOWS
+[[nodiscard]] bool TRAP::Network::SocketSelector::SocketSelectorImpl::Register(const SocketHandle handle) const
+{
+	epoll_event event{};
+	event.events = EPOLLIN | (Mode == TriggerMode::Edge ? EPOLLET : 0u);
+	event.data.fd = handle;
+
+	//EEXIST means the handle is already registered, the socket only needs to be updated
+	if(epoll_ctl(EPoll, EPOLL_CTL_ADD, handle, &event) < 0 && errno != EEXIST)
+	{
+		TP_ERROR(Log::NetworkSocketPrefix, "The socket can't be added to the selector!");
+		TP_ERROR(Log::NetworkSocketPrefix, Utils::String::GetStrError());
+		return false;
+	}
+
+	return true;
+}
+#endif
+
+//-------------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------------//
+
 TRAP::Network::SocketSelector::SocketSelector()
-	: m_impl(TRAP::MakeScope<SocketSelectorImpl>())
+	: SocketSelector(TriggerMode::Level)
 {
-	ZoneNamedC(__tracy, tracy::Color::Azure, (GetTRAPProfileSystems() & ProfileSystems::Network) != ProfileSystems::None);
+}
 
-	Clear();
+//-------------------------------------------------------------------------------------------------------------------//
+
+TRAP::Network::SocketSelector::SocketSelector(const TriggerMode mode)
+	: m_impl(TRAP::MakeScope<SocketSelectorImpl>(mode))
+{
+	ZoneNamedC(__tracy, tracy::Color::Azure, (GetTRAPProfileSystems() & ProfileSystems::Network) != ProfileSystems::None);
 }
 
 //-------------------------------------------------------------------------------------------------------------------//
 
+TRAP::Network::SocketSelector::~SocketSelector() = default;
+
+//-------------------------------------------------------------------------------------------------------------------//
+
 TRAP::Network::SocketSelector::SocketSelector(const SocketSelector& copy)
 	: m_impl(TRAP::MakeScope<SocketSelectorImpl>(*copy.m_impl))
 {
@@ -92,34 +213,29 @@ void TRAP::Network::SocketSelector::Add(Socket& socket)
 	ZoneNamedC(__tracy, tracy::Color::Azure, (GetTRAPProfileSystems() & ProfileSystems::Network) != ProfileSystems::None);
 
 	const SocketHandle handle = socket.GetHandle();
-	if(handle != INTERNAL::Network::SocketImpl::InvalidSocket())
-	{
+	if(handle == INTERNAL::Network::SocketImpl::InvalidSocket())
+		return;
+
 #ifdef TRAP_PLATFORM_WINDOWS
-		if(m_impl->SocketCount >= FD_SETSIZE)
-		{
-			TP_ERROR(Log::NetworkSocketPrefix, "The socket can't be added to the selector because the ",
-				"selector is full. This is a limitation of your operating system's FD_SETSIZE setting.");
-			return;
-		}
+	if (FD_ISSET(handle, &m_impl->AllSockets))
+		return;
 
-		if (FD_ISSET(handle, &m_impl->AllSockets))
-			return;
+	if(m_impl->Sockets.size() >= FD_SETSIZE)
+	{
+		TP_ERROR(Log::NetworkSocketPrefix, "The socket can't be added to the selector because the ",
+			"selector is full. This is a limitation of your operating system's FD_SETSIZE setting.");
+		return;
+	}
 
-		m_impl->SocketCount++;
+	FD_SET(handle, &m_impl->AllSockets);
 #else
-		if(handle >= FD_SETSIZE)
-		{
-			TP_ERROR(Log::NetworkSocketPrefix, "The socket can't be added to the selector because its ",
-				"ID is too high. This is a limitation of your operating system's FD_SETSIZE setting.");
-			return;
-		}
-
-		//SocketHandle is an i32 in POSIX
-		m_impl->MaxSockets = std::max(m_impl->MaxSockets, handle);
+	//A closed socket is removed from the epoll instance by the kernel,
+	//so a known handle may belong to a new socket and is registered again
+	if(!m_impl->Register(handle))
+		return;
 #endif
 
-		FD_SET(handle, &m_impl->AllSockets);
-	}
+	m_impl->Sockets[handle].Sock = &socket;
 }
 
 //-------------------------------------------------------------------------------------------------------------------//
@@ -129,21 +245,24 @@ void TRAP::Network::SocketSelector::Remove(Socket& socket) const
 	ZoneNamedC(__tracy, tracy::Color::Azure, (GetTRAPProfileSystems() & ProfileSystems::Network) != ProfileSystems::None);
 
 	const SocketHandle handle = socket.GetHandle();
-	if(handle != INTERNAL::Network::SocketImpl::InvalidSocket())
-	{
-#ifdef TRAP_PLATFORM_WINDOWS
-		if (!FD_ISSET(handle, &m_impl->AllSockets))
-			return;
+	if(handle == INTERNAL::Network::SocketImpl::InvalidSocket())
+		return;
 
-		m_impl->SocketCount--;
+	const auto it = m_impl->Sockets.find(handle);
+	if(it == m_impl->Sockets.end())
+		return;
+
+	if(it->second.ReadyWait == m_impl->WaitCount)
+		std::erase(m_impl->ReadySockets, it->second.Sock);
+	m_impl->Sockets.erase(it);
+
+#ifdef TRAP_PLATFORM_WINDOWS
+	FD_CLR(handle, &m_impl->AllSockets);
+	FD_CLR(handle, &m_impl->SocketsReady);
 #else
-		if (handle >= FD_SETSIZE)
-			return;
+	//Fails if the socket was already closed, which removed it from the epoll instance
+	epoll_ctl(m_impl->EPoll, EPOLL_CTL_DEL, handle, nullptr);
 #endif
-
-		FD_CLR(handle, &m_impl->AllSockets);
-		FD_CLR(handle, &m_impl->SocketsReady);
-	}
 }
 
 //-------------------------------------------------------------------------------------------------------------------//
@@ -152,11 +271,16 @@ void TRAP::Network::SocketSelector::Clear() const
 {
 	ZoneNamedC(__tracy, tracy::Color::Azure, (GetTRAPProfileSystems() & ProfileSystems::Network) != ProfileSystems::None);
 
+#ifdef TRAP_PLATFORM_WINDOWS
 	FD_ZERO(&m_impl->AllSockets);
 	FD_ZERO(&m_impl->SocketsReady);
+#else
+	for(const auto& [handle, entry] : m_impl->Sockets)
+		epoll_ctl(m_impl->EPoll, EPOLL_CTL_DEL, handle, nullptr);
+#endif
 
-	m_impl->MaxSockets = 0;
-	m_impl->SocketCount = 0;
+	m_impl->Sockets.clear();
+	m_impl->ReadySockets.clear();
 }
 
 //-------------------------------------------------------------------------------------------------------------------//
@@ -165,20 +289,68 @@ bool TRAP::Network::SocketSelector::Wait(const Utils::TimeStep timeout) const
 {
 	ZoneNamedC(__tracy, tracy::Color::Azure, (GetTRAPProfileSystems() & ProfileSystems::Network) != ProfileSystems::None);
 
+	//Invalidates the ready state of the previous Wait()
+	++m_impl->WaitCount;
+	m_impl->ReadySockets.clear();
+
+#ifdef TRAP_PLATFORM_WINDOWS
 	//Setup the timeout
+	const i64 timeoutMs = static_cast<i64>(timeout.GetMilliseconds());
 	timeval time{};
-	time.tv_sec = static_cast<time_t>(timeout.GetSeconds());
-	time.tv_usec = static_cast<time_t>(timeout.GetSeconds());
+	time.tv_sec = static_cast<long>(timeoutMs / 1000);
+	time.tv_usec = static_cast<long>((timeoutMs % 1000) * 1000);
 
 	//initialize the set that will contain the sockets that are ready
 	m_impl->SocketsReady = m_impl->AllSockets;
 
 	//Wait until one of the sockets is ready for reading, or timeout is reached
 	//The first parameter is ignored on Windows
-	const i32 count = select(m_impl->MaxSockets + 1, &m_impl->SocketsReady, nullptr, nullptr,
-	                             timeout != Utils::TimeStep(0.0f) ? &time : nullptr);
+	const i32 count = select(0, &m_impl->SocketsReady, nullptr, nullptr,
+	                         timeout != Utils::TimeStep(0.0f) ? &time : nullptr);
+	if(count <= 0)
+		return false;
 
-	return count > 0;
+	//On Windows the set is a list of the ready handles
+	for(u32 i = 0; i < m_impl->SocketsReady.fd_count; ++i)
+	{
+		const auto it = m_impl->Sockets.find(m_impl->SocketsReady.fd_array[i]);
+		if(it == m_impl->Sockets.end())
+			continue;
+
+		it->second.ReadyWait = m_impl->WaitCount;
+		m_impl->ReadySockets.push_back(it->second.Sock);
+	}
+#else
+	if(m_impl->EPoll < 0)
+		return false;
+
+	//Round up so short timeouts don't turn into polling, epoll_wait() takes at most i32 milliseconds
+	const i32 timeoutMs = timeout != Utils::TimeStep(0.0f) ?
+	                      NumericCast<i32>(std::clamp(std::ceil(static_cast<f64>(timeout.GetMilliseconds())), 0.0,
+	                                                  static_cast<f64>(std::numeric_limits<i32>::max()))) : -1;
+
+	//Room for every socket, so a single Wait() reports all ready sockets like select() does.
+	//An empty selector still waits for the timeout, so polling loops don't spin
+	if(m_impl->Events.size() < std::max<usize>(m_impl->Sockets.size(), 1))
+		m_impl->Events.resize(std::max<usize>(m_impl->Sockets.size(), 1));
+
+	const i32 count = epoll_wait(m_impl->EPoll, m_impl->Events.data(), NumericCast<i32>(m_impl->Events.size()), timeoutMs);
+	if(count <= 0)
+		return false;
+
+	//Errors and hang ups are reported as ready, the following receive reports them
+	for(const epoll_event& event : std::span(m_impl->Events).first(NumericCast<usize>(count)))
+	{
+		const auto it = m_impl->Sockets.find(event.data.fd);
+		if(it == m_impl->Sockets.end())
+			continue;
+
+		it->second.ReadyWait = m_impl->WaitCount;
+		m_impl->ReadySockets.push_back(it->second.Sock);
+	}
+#endif
+
+	return !m_impl->ReadySockets.empty();
 }
 
 //-------------------------------------------------------------------------------------------------------------------//
@@ -188,17 +360,31 @@ bool TRAP::Network::SocketSelector::Wait(const Utils::TimeStep timeout) const
 	ZoneNamedC(__tracy, tracy::Color::Azure, (GetTRAPProfileSystems() & ProfileSystems::Network) != ProfileSystems::None);
 
 	const SocketHandle handle = socket.GetHandle();
-	if(handle != INTERNAL::Network::SocketImpl::InvalidSocket())
-	{
-#ifndef TRAP_PLATFORM_WINDOWS
-		if (handle >= FD_SETSIZE)
-			return false;
-#else
-		return FD_ISSET(handle, &m_impl->SocketsReady) != 0;
-#endif
-	}
+	if(handle == INTERNAL::Network::SocketImpl::InvalidSocket())
+		return false;
 
-	return false;
+	const auto it = m_impl->Sockets.find(handle);
+	return it != m_impl->Sockets.end() && it->second.ReadyWait == m_impl->WaitCount;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] std::span<TRAP::Network::Socket* const> TRAP::Network::SocketSelector::GetReadySockets() const noexcept
+{
+	ZoneNamedC(__tracy, tracy::Color::Azure, (GetTRAPProfileSystems() & ProfileSystems::Network) != ProfileSystems::None &&
+	                                         (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	return m_impl->ReadySockets;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] TRAP::Network::SocketSelector::TriggerMode TRAP::Network::SocketSelector::GetTriggerMode() const noexcept
+{
+	ZoneNamedC(__tracy, tracy::Color::Azure, (GetTRAPProfileSystems() & ProfileSystems::Network) != ProfileSystems::None &&
+	                                         (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	return m_impl->Mode;
 }
 
 //-------------------------------------------------------------------------------------------------------------------//
@@ -218,4 +404,4 @@ TRAP::Network::SocketSelector& TRAP::Network::SocketSelector::operator=(const So
 
 #ifdef TRAP_PLATFORM_WINDOWS
 #undef far
-#endif /*TRAP_PLATFORM_WINDOWS*/
\ No newline at end of file
+#endif /*TRAP_PLATFORM_WINDOWS*/
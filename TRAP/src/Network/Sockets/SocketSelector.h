@@ -29,6 +29,8 @@ Modified by: Jan "GamesTrap" Schuerkamp
 #ifndef TRAP_NETWORK_SOCKETSELECTOR_H
 #define TRAP_NETWORK_SOCKETSELECTOR_H
 
+#include <span>
+
 #include "Core/Base.h"
 
 namespace TRAP::Utils
@@ -41,14 +43,35 @@ namespace TRAP::Network
 	class Socket;
 
 	/// @brief Multiplexer that allows to read form multiple sockets.
+	///
+	/// On Linux the selector is backed by epoll, so the amount of sockets and
+	/// their handles are not limited by FD_SETSIZE and Wait() only does work
+	/// for the sockets that are ready.
+	/// On Windows the selector is backed by select() and limited to FD_SETSIZE sockets.
 	class SocketSelector
 	{
 	public:
+		/// @brief Modes in which ready sockets are reported.
+		enum class TriggerMode
+		{
+			//Sockets are reported by every Wait() as long as they have data available to be received
+			Level,
+			//Sockets are only reported by Wait() when new data arrives.
+			//All available data must be received (until Status::NotReady) before waiting again,
+			//which requires non-blocking sockets.
+			//Only supported on Linux, other platforms fall back to TriggerMode::Level
+			Edge
+		};
+
 		/// @brief Constructor.
 		SocketSelector();
 
+		/// @brief Constructor.
+		/// @param mode Mode in which ready sockets are reported.
+		explicit SocketSelector(TriggerMode mode);
+
 		/// @brief Destructor.
-		~SocketSelector() = default;
+		~SocketSelector();
 
 		/// @brief Copy constructor.
 		SocketSelector(const SocketSelector& copy);
@@ -71,6 +94,8 @@ namespace TRAP::Network
 		///
 		/// This function doesn't destroy the socket, it simply
 		/// removes the reference that the selector has to it.
+		/// Sockets should be removed before they are closed,
+		/// as a closed socket no longer knows its handle.
 		/// @param socket Reference to the socket to remove.
 		void Remove(Socket& socket) const;
 
@@ -104,6 +129,19 @@ namespace TRAP::Network
 		/// @return True if the socket is ready to read, false otherwise.
 		[[nodiscard]] bool IsReady(Socket& socket) const;
 
+		/// @brief Retrieve all sockets that are ready to receive data.
+		///
+		/// This function must be used after a call to Wait, it allows
+		/// to handle the ready sockets without testing every socket
+		/// of the selector with IsReady.
+		/// @return Sockets that are ready to receive data.
+		/// @note The returned span is invalidated by the next call to Wait, Remove or Clear.
+		[[nodiscard]] std::span<Socket* const> GetReadySockets() const noexcept;
+
+		/// @brief Retrieve the mode in which ready sockets are reported.
+		/// @return Trigger mode.
+		[[nodiscard]] TriggerMode GetTriggerMode() const noexcept;
+
 		/// @brief Overload of assignment operator.
 		/// @param right Instance to assign.
 		/// @return Reference to self.
@@ -290,32 +290,30 @@ TRAP::Network::Socket::Status TRAP::Network::TCPSocketIPv6::Send(Packet& packet)
 	//This means that we have to send the packet size first, so that the
 	//receiver knows the actual end of the packet in the data stream.
 
-	//We allocate an extra memory block so that the size can be sent
-	//together with the data in a single call.
-	//This may seem inefficient, but is is actually required to avoid
-	//partial send, which could cause data corruption on the receiving end.
+	//The size and the data are sent together with a single scatter-gather
+	//call, this avoids copying the packet into a temporary block just to
+	//prevent partial sends, which could cause data corruption on the receiving end.
 
 	//Get the data to send from the packet
 	usize size = 0;
 	const void* const data = packet.OnSend(size);
 
 	//First convert the packet size to network byte order
-	usize packetSize = size;
+	//The size is sent as u32, matching what Receive(Packet&) reads
+	u32 packetSize = NumericCast<u32>(size);
 
 	if constexpr (Utils::GetEndian() != Utils::Endian::Big)
 		TRAP::Utils::Memory::SwapBytes(packetSize);
 
-	//Allocate memory for the data block to send
-	std::vector<u8> blockToSend(sizeof(packetSize) + size);
-
-	//Copy the packet size and data into the block to send
-	std::copy_n(reinterpret_cast<const u8*>(&packetSize), sizeof(packetSize), blockToSend.data());
-	if (size > 0)
-		std::copy_n(static_cast<const u8*>(data), size, blockToSend.data() + sizeof(packetSize));
+	const std::array<std::span<const u8>, 2> buffers
+	{
+		std::span<const u8>(reinterpret_cast<const u8*>(&packetSize), sizeof(packetSize)),
+		std::span<const u8>(static_cast<const u8*>(data), size)
+	};
 
-	//Send the data block
+	//Send the size and data, resuming after the bytes sent by a previous partial send
 	usize sent = 0;
-	const Status status = Send(blockToSend.data() + packet.m_sendPos, blockToSend.size() - packet.m_sendPos, sent);
+	const Status status = INTERNAL::Network::SocketImpl::SendBuffers(GetHandle(), buffers, packet.m_sendPos, sent);
 
 	//In the case of a partial send, record the location to resume from
 	if (status == Status::Partial)
@@ -328,6 +326,87 @@ TRAP::Network::Socket::Status TRAP::Network::TCPSocketIPv6::Send(Packet& packet)
 
 //-------------------------------------------------------------------------------------------------------------------//
 
+TRAP::Network::Socket::Status TRAP::Network::TCPSocketIPv6::Send(const std::span<Packet> packets) const
+{
+	ZoneNamedC(__tracy, tracy::Color::Azure, (GetTRAPProfileSystems() & ProfileSystems::Network) != ProfileSystems::None);
+
+	if (!IsBlocking())
+		TP_WARN(Log::NetworkTCPSocketPrefix, "Partial sends might not be handled properly.");
+
+	usize sentPackets = 0;
+
+	return Send(packets, sentPackets);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+TRAP::Network::Socket::Status TRAP::Network::TCPSocketIPv6::Send(const std::span<Packet> packets, usize& sentPackets) const
+{
+	ZoneNamedC(__tracy, tracy::Color::Azure, (GetTRAPProfileSystems() & ProfileSystems::Network) != ProfileSystems::None);
+
+	//Packets coalesced into one scatter-gather call (size + data each)
+	static constexpr usize MaxPacketsPerCall = 32;
+
+	sentPackets = 0;
+	bool sentAnything = false;
+
+	while(sentPackets < packets.size())
+	{
+		const std::span<Packet> batch = packets.subspan(sentPackets, std::min(packets.size() - sentPackets, MaxPacketsPerCall));
+
+		//Sizes in network byte order, the buffers point at them and at the packet data directly
+		std::array<u32, MaxPacketsPerCall> packetSizes{};
+		std::array<std::span<const u8>, MaxPacketsPerCall * 2> buffers{};
+		for(usize i = 0; i < batch.size(); ++i)
+		{
+			usize size = 0;
+			const void* const data = batch[i].OnSend(size);
+
+			packetSizes[i] = NumericCast<u32>(size);
+			if constexpr (Utils::GetEndian() != Utils::Endian::Big)
+				TRAP::Utils::Memory::SwapBytes(packetSizes[i]);
+
+			buffers[i * 2] = std::span<const u8>(reinterpret_cast<const u8*>(&packetSizes[i]), sizeof(u32));
+			buffers[(i * 2) + 1] = std::span<const u8>(static_cast<const u8*>(data), size);
+		}
+
+		//Only the first packet can have been sent partially by a previous call
+		usize sent = 0;
+		const Status status = INTERNAL::Network::SocketImpl::SendBuffers(GetHandle(),
+		                                                                  std::span(buffers).first(batch.size() * 2),
+		                                                                  batch.front().m_sendPos, sent);
+		sentAnything = sentAnything || (sent != 0u);
+
+		//Record which packets are done and where to resume the first unfinished one
+		usize remaining = batch.front().m_sendPos + sent;
+		for(usize i = 0; i < batch.size(); ++i)
+		{
+			const usize packetBytes = buffers[i * 2].size() + buffers[(i * 2) + 1].size();
+			if(remaining < packetBytes)
+			{
+				batch[i].m_sendPos = remaining;
+				break;
+			}
+
+			remaining -= packetBytes;
+			batch[i].m_sendPos = 0;
+			++sentPackets;
+		}
+
+		if(status == Status::Done)
+			continue;
+
+		if((status == Status::NotReady) && sentAnything)
+			return Status::Partial;
+
+		return status;
+	}
+
+	return Status::Done;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
 TRAP::Network::Socket::Status TRAP::Network::TCPSocketIPv6::Receive(Packet& packet)
 {
 	ZoneNamedC(__tracy, tracy::Color::Azure, (GetTRAPProfileSystems() & ProfileSystems::Network) != ProfileSystems::None);
@@ -398,6 +477,58 @@ TRAP::Network::Socket::Status TRAP::Network::TCPSocketIPv6::Receive(Packet& pack
 
 //-------------------------------------------------------------------------------------------------------------------//
 
+TRAP::Network::Socket::Status TRAP::Network::TCPSocketIPv6::Receive(const std::span<u8> buffer, std::span<const u8>& packetData)
+{
+	ZoneNamedC(__tracy, tracy::Color::Azure, (GetTRAPProfileSystems() & ProfileSystems::Network) != ProfileSystems::None);
+
+	packetData = {};
+
+	//Loop until we've received the entire size of the packet
+	//(even a 4 byte variable may be received in more than one call)
+	usize received = 0;
+	while(m_pendingPacket.SizeReceived < sizeof(m_pendingPacket.Size))
+	{
+		u8* const data = reinterpret_cast<u8*>(&m_pendingPacket.Size) + m_pendingPacket.SizeReceived;
+		const Status status = Receive(data, sizeof(m_pendingPacket.Size) - m_pendingPacket.SizeReceived,
+		                              received);
+		m_pendingPacket.SizeReceived += received;
+
+		if (status != Status::Done)
+			return status;
+	}
+
+	u32 packetSize = m_pendingPacket.Size;
+	if constexpr (Utils::GetEndian() != Utils::Endian::Big)
+		TRAP::Utils::Memory::SwapBytes(packetSize);
+
+	if(packetSize > buffer.size())
+	{
+		TP_ERROR(Log::NetworkTCPSocketPrefix, "Packet of ", packetSize, " bytes doesn't fit into the receive buffer of ",
+		         buffer.size(), " bytes!");
+		return Status::Error;
+	}
+
+	//Loop until we receive all the packet data, it goes straight into the buffer of the caller
+	while(m_pendingPacket.DataReceived < packetSize)
+	{
+		const Status status = Receive(buffer.data() + m_pendingPacket.DataReceived,
+		                              packetSize - m_pendingPacket.DataReceived, received);
+		if (status != Status::Done)
+			return status;
+
+		m_pendingPacket.DataReceived += received;
+	}
+
+	packetData = buffer.first(packetSize);
+
+	//Clear the pending packet data
+	m_pendingPacket = PendingPacket();
+
+	return Status::Done;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
 #ifdef TRAP_PLATFORM_WINDOWS
 #undef far
 #endif /*TRAP_PLATFORM_WINDOWS*/
\ No newline at end of file
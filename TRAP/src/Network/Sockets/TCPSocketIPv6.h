@@ -1,6 +1,7 @@
 #ifndef TRAP_NETWORK_TCPSOCKETIPV6_H
 #define TRAP_NETWORK_TCPSOCKETIPV6_H
 
+#include <span>
 #include <vector>
 
 #include "Socket.h"
@@ -113,6 +114,30 @@ namespace TRAP::Network
 		/// @return Status code.
 		[[nodiscard]] Status Send(Packet& packet) const;
 
+		/// @brief Send multiple formatted packets to the remote peer.
+		///
+		/// The packets are coalesced so that many small packets only need a single system call.
+		/// To be able to handle partial sends over non-blocking
+		/// sockets, use the Send(std::span<Packet>, usize&)
+		/// overload instead.
+		/// This function will fail if the socket is not connected.
+		/// @param packets Packets to send.
+		/// @return Status code.
+		[[nodiscard]] Status Send(std::span<Packet> packets) const;
+
+		/// @brief Send multiple formatted packets to the remote peer.
+		///
+		/// The packets are coalesced so that many small packets only need a single system call.
+		/// In non-blocking mode, if this function returns TRAP::Network::Socket::Status::Partial,
+		/// the first sentPackets packets have been sent completely.
+		/// You must retry sending the remaining unmodified packets
+		/// (packets.subspan(sentPackets)) before sending anything else.
+		/// This function will fail if the socket is not connected.
+		/// @param packets Packets to send.
+		/// @param sentPackets The number of packets sent completely will be written here.
+		/// @return Status code.
+		[[nodiscard]] Status Send(std::span<Packet> packets, usize& sentPackets) const;
+
 		/// @brief Receive a formatted packet of data from the remote peer.
 		///
 		/// In blocking mode, this function will wait until the whole packet
@@ -122,6 +147,20 @@ namespace TRAP::Network
 		/// @return Status code.
 		[[nodiscard]] Status Receive(Packet& packet);
 
+		/// @brief Receive a formatted packet of data from the remote peer
+		/// directly into a buffer provided by the caller, without allocating memory.
+		///
+		/// In blocking mode, this function will wait until the whole packet
+		/// has been received.
+		/// In non-blocking mode the same buffer must be passed again until Done is returned.
+		/// Don't mix this with Receive(Packet&) while a packet is pending.
+		/// This function will fail if the socket is not connected or
+		/// if the packet doesn't fit into the buffer.
+		/// @param buffer Buffer to receive the packet data into, e.g. from an arena.
+		/// @param packetData The received packet data, pointing into buffer, will be written here.
+		/// @return Status code.
+		[[nodiscard]] Status Receive(std::span<u8> buffer, std::span<const u8>& packetData);
+
 	private:
 		friend class TCPListenerIPv6;
 
@@ -130,6 +169,7 @@ namespace TRAP::Network
 		{
 			u32 Size = 0; //Data of packet size
 			usize SizeReceived = 0; //Number of size bytes received so far
+			usize DataReceived = 0; //Number of data bytes received into the buffer of the caller so far
 			std::vector<u8> Data{}; //Data of the packet
 		};
 
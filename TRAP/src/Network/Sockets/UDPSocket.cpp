@@ -34,6 +34,31 @@ Modified by: Jan "GamesTrap" Schuerkamp
 #include "Utils/Utils.h"
 #include "Utils/Memory.h"
 
+namespace
+{
+	/// @brief Maximum number of datagrams sent or received with a single system call.
+	constexpr usize MaxDatagramsPerCall = 64;
+
+	/// @brief Convert an internal address to an address and a port.
+	/// @param address Internal address.
+	/// @return Address and port.
+	[[nodiscard]] std::pair<TRAP::Network::IPv4Address, u16> ToAddressAndPort(const sockaddr_in& address)
+	{
+		u32 addr = address.sin_addr.s_addr;
+		u16 port = address.sin_port;
+
+		if constexpr (TRAP::Utils::GetEndian() != TRAP::Utils::Endian::Big)
+		{
+			TRAP::Utils::Memory::SwapBytes(addr);
+			TRAP::Utils::Memory::SwapBytes(port);
+		}
+
+		return {TRAP::Network::IPv4Address(addr), port};
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
 [[nodiscard]] u16 TRAP::Network::UDPSocket::GetLocalPort() const
 {
 	ZoneNamedC(__tracy, tracy::Color::Azure, (GetTRAPProfileSystems() & ProfileSystems::Network) != ProfileSystems::None);
@@ -225,4 +250,186 @@ TRAP::Network::Socket::Status TRAP::Network::UDPSocket::Receive(Packet& packet,
 		packet.OnReceive(m_buffer.data(), received);
 
 	return status;
-}
\ No newline at end of file
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+TRAP::Network::Socket::Status TRAP::Network::UDPSocket::Send(const std::span<const Datagram> datagrams, usize& sent)
+{
+	ZoneNamedC(__tracy, tracy::Color::Azure, (GetTRAPProfileSystems() & ProfileSystems::Network) != ProfileSystems::None);
+
+	sent = 0;
+
+	//Create the internal socket if it doesn't exist
+	CreateIPv4();
+
+	//Make sure that every datagram fits
+	if(std::ranges::any_of(datagrams, [](const Datagram& datagram){ return datagram.Data.size() > MaxDatagramSize; }))
+	{
+		TP_ERROR(Log::NetworkUDPSocketPrefix, "Can't send data over the network (the number of bytes",
+			" to send is greater than TRAP::Network::UDPSocket::MaxDatagramSize)");
+		return Status::Error;
+	}
+
+#ifdef TRAP_PLATFORM_LINUX
+	while(sent < datagrams.size())
+	{
+		const std::span<const Datagram> batch = datagrams.subspan(sent, std::min(datagrams.size() - sent, MaxDatagramsPerCall));
+
+		//Describe all datagrams of the batch, the data itself isn't copied
+		std::array<sockaddr_in, MaxDatagramsPerCall> addresses{};
+		std::array<iovec, MaxDatagramsPerCall> vectors{};
+		std::array<mmsghdr, MaxDatagramsPerCall> messages{};
+		for(usize i = 0; i < batch.size(); ++i)
+		{
+			addresses[i] = INTERNAL::Network::SocketImpl::CreateAddress(batch[i].RemoteAddress.ToInteger(), batch[i].RemotePort);
+			vectors[i].iov_base = const_cast<u8*>(batch[i].Data.data());
+			vectors[i].iov_len = batch[i].Data.size();
+			messages[i].msg_hdr.msg_name = &addresses[i];
+			messages[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+			messages[i].msg_hdr.msg_iov = &vectors[i];
+			messages[i].msg_hdr.msg_iovlen = 1;
+		}
+
+		const i32 result = sendmmsg(GetHandle(), messages.data(), NumericCast<u32>(batch.size()), 0);
+		if(result < 0)
+		{
+			const Status status = INTERNAL::Network::SocketImpl::GetErrorStatus();
+
+			if((status == Status::NotReady) && (sent != 0u))
+				return Status::Partial;
+
+			return status;
+		}
+
+		sent += NumericCast<usize>(result);
+	}
+#else
+	//Windows has no equivalent to sendmmsg()
+	for(; sent < datagrams.size(); ++sent)
+	{
+		const Datagram& datagram = datagrams[sent];
+		const sockaddr_in address = INTERNAL::Network::SocketImpl::CreateAddress(datagram.RemoteAddress.ToInteger(), datagram.RemotePort);
+
+		if(sendto(GetHandle(), reinterpret_cast<const char*>(datagram.Data.data()), NumericCast<i32>(datagram.Data.size()), 0,
+		          reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0)
+		{
+			const Status status = INTERNAL::Network::SocketImpl::GetErrorStatus();
+
+			if((status == Status::NotReady) && (sent != 0u))
+				return Status::Partial;
+
+			return status;
+		}
+	}
+#endif /*TRAP_PLATFORM_LINUX*/
+
+	return Status::Done;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+TRAP::Network::Socket::Status TRAP::Network::UDPSocket::Receive(DatagramBatch& batch, usize& received) const
+{
+	ZoneNamedC(__tracy, tracy::Color::Azure, (GetTRAPProfileSystems() & ProfileSystems::Network) != ProfileSystems::None);
+
+	//First clear the variables to fill
+	received = 0;
+
+	//Check the destination batch
+	if(batch.IsFull())
+	{
+		TP_ERROR(Log::NetworkUDPSocketPrefix,
+		         "Can't receive data from the network (the destination batch is full)");
+		return Status::Error;
+	}
+
+#ifdef TRAP_PLATFORM_LINUX
+	while(!batch.IsFull())
+	{
+		//Receive directly into the free slots of the batch
+		const usize firstSlot = batch.GetFreeSlot();
+		const usize count = std::min(batch.GetContiguousFreeSlots(), MaxDatagramsPerCall);
+
+		std::array<sockaddr_in, MaxDatagramsPerCall> addresses{};
+		std::array<iovec, MaxDatagramsPerCall> vectors{};
+		std::array<mmsghdr, MaxDatagramsPerCall> messages{};
+		for(usize i = 0; i < count; ++i)
+		{
+			const std::span<u8> buffer = batch.GetSlotBuffer(firstSlot + i);
+			vectors[i].iov_base = buffer.data();
+			vectors[i].iov_len = buffer.size();
+			messages[i].msg_hdr.msg_name = &addresses[i];
+			messages[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+			messages[i].msg_hdr.msg_iov = &vectors[i];
+			messages[i].msg_hdr.msg_iovlen = 1;
+		}
+
+		//Only wait for the first datagram, the following ones are only received if they are available already
+		const i32 flags = (received == 0u) ? MSG_WAITFORONE : MSG_DONTWAIT;
+		const i32 result = recvmmsg(GetHandle(), messages.data(), NumericCast<u32>(count), flags, nullptr);
+		if(result < 0)
+		{
+			if(received != 0u)
+				break;
+
+			return INTERNAL::Network::SocketImpl::GetErrorStatus();
+		}
+
+		for(usize i = 0; i < NumericCast<usize>(result); ++i)
+		{
+			//The datagram didn't fit into the slot, discard it
+			if((messages[i].msg_hdr.msg_flags & MSG_TRUNC) != 0)
+				continue;
+
+			//Move it forward if a discarded datagram left a gap
+			const usize slot = batch.GetFreeSlot();
+			if(slot != firstSlot + i)
+				std::copy_n(batch.GetSlotBuffer(firstSlot + i).data(), messages[i].msg_len, batch.GetSlotBuffer(slot).data());
+
+			const auto [remoteAddress, remotePort] = ToAddressAndPort(addresses[i]);
+			batch.Push(messages[i].msg_len, remoteAddress, remotePort);
+			++received;
+		}
+
+		//Less datagrams than requested means no more are available
+		if(NumericCast<usize>(result) < count)
+			break;
+	}
+#else
+	//Windows has no equivalent to recvmmsg()
+	while(!batch.IsFull())
+	{
+		//Only wait for the first datagram, the following ones are only received if they are available already
+		if(received != 0u)
+		{
+			u_long available = 0;
+			if((ioctlsocket(GetHandle(), FIONREAD, &available) != 0) || (available == 0))
+				break;
+		}
+
+		const std::span<u8> buffer = batch.GetSlotBuffer(batch.GetFreeSlot());
+		sockaddr_in address{};
+		INTERNAL::Network::SocketImpl::AddressLength addressSize = sizeof(address);
+		const i32 result = recvfrom(GetHandle(), reinterpret_cast<char*>(buffer.data()), NumericCast<i32>(buffer.size()), 0,
+		                            reinterpret_cast<sockaddr*>(&address), &addressSize);
+		if(result < 0)
+		{
+			//The datagram didn't fit into the slot, it's discarded
+			if(WSAGetLastError() == WSAEMSGSIZE)
+				continue;
+
+			if(received != 0u)
+				break;
+
+			return INTERNAL::Network::SocketImpl::GetErrorStatus();
+		}
+
+		const auto [remoteAddress, remotePort] = ToAddressAndPort(address);
+		batch.Push(NumericCast<usize>(result), remoteAddress, remotePort);
+		++received;
+	}
+#endif /*TRAP_PLATFORM_LINUX*/
+
+	return Status::Done;
+}
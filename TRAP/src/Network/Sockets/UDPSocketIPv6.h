@@ -1,8 +1,10 @@
 #ifndef TRAP_NETWORK_UDPSOCKETIPV6_H
 #define TRAP_NETWORK_UDPSOCKETIPV6_H
 
+#include <span>
 #include <vector>
 
+#include "DatagramBatch.h"
 #include "Socket.h"
 #include "Network/IP/IPv6Address.h"
 
@@ -113,6 +115,31 @@ namespace TRAP::Network
 		/// @return Status code.
 		[[nodiscard]] Status Receive(Packet& packet, IPv6Address& remoteAddress, u16& remotePort);
 
+		/// @brief Send multiple datagrams with as few system calls as possible.
+		///
+		/// Make sure that no datagram is bigger than
+		/// UDPSocketIPv6::MaxDatagramSize, otherwise this function will
+		/// fail and no data will be sent.
+		/// In non-blocking mode, if this function returns TRAP::Network::Socket::Status::Partial,
+		/// only the first sent datagrams have been sent.
+		/// @param datagrams Datagrams to send.
+		/// @param sent The number of datagrams sent will be written here.
+		/// @return Status code.
+		[[nodiscard]] Status Send(std::span<const DatagramIPv6> datagrams, usize& sent);
+
+		/// @brief Receive multiple datagrams with as few system calls as possible.
+		///
+		/// The received datagrams are appended to the batch.
+		/// In blocking mode, this function will wait until at least one
+		/// datagram is received, more datagrams are only received if
+		/// they are available already.
+		/// Datagrams that are bigger than the maximum datagram size of
+		/// the batch are discarded.
+		/// @param batch Batch to append the received datagrams to, must not be full.
+		/// @param received The number of datagrams received will be written here.
+		/// @return Status code.
+		[[nodiscard]] Status Receive(DatagramBatchIPv6& batch, usize& received) const;
+
 	private:
 		std::vector<u8> m_buffer; //Temporary buffer holding the received data in Receive(Packet)
 	};
@@ -58,6 +58,7 @@
 #include "../src/Utils/Random/Random.h"
 #include "../src/Utils/Hash/Adler32.h"
 #include "../src/Utils/Hash/CRC32.h"
+#include "../src/Utils/Hash/HashFile.h"
 #include "../src/Utils/Hash/SHA-2.h"
 #include "../src/Utils/Hash/SHA-3.h"
 #include "../src/Utils/Hash/UID.h"
@@ -14,6 +14,7 @@
 	#pragma warning(pop)
 #endif /*_MSC_VER*/
 
+#include "Core/Base.h"
 #include "Core/Types.h"
 
 namespace TRAP
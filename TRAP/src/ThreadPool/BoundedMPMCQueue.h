@@ -0,0 +1,454 @@
+#ifndef TRAP_BOUNDEDMPMCQUEUE_H
+#define TRAP_BOUNDEDMPMCQUEUE_H
+
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#ifdef _MSC_VER
+	#pragma warning(push, 0)
+#endif /*_MSC_VER*/
+//Tracy - Profiler
+#include <tracy/Tracy.hpp>
+#ifdef _MSC_VER
+	#pragma warning(pop)
+#endif /*_MSC_VER*/
+
+#include "Core/Base.h"
+#include "Core/Types.h"
+
+namespace TRAP
+{
+	/// @brief Bounded multi-producer multi-consumer lock-free ring queue (Dmitry Vyukov's algorithm).
+	///
+	///        Every cell carries a sequence number which tells producers and consumers
+	///        whether the cell is ready for them, so TryPush() and TryPop() only need a single
+	///        CAS on the enqueue/dequeue position and never allocate.
+	///        Push() and Pop() block while the queue is full/empty, Pop() returns false after Done() was called
+	///        and the queue ran empty, Push() returns false after Done() was called and the queue is full.
+	///
+	///        Provides the same interface as BlockingQueue, with the difference that TryPush() fails when the queue is full
+	///        (BlockingQueue::TryPush() fails when its lock is contended).
+	/// @tparam T Type of items, must be nothrow move constructible.
+	/// @threadsafety This class is thread safe.
+	template<typename T>
+	requires std::is_nothrow_move_constructible_v<T>
+	class BoundedMPMCQueue
+	{
+	public:
+		/// @brief Constructor.
+		/// @param capacity Max amount of items in the queue, must be a power of two.
+		explicit BoundedMPMCQueue(usize capacity = 1024);
+		/// @brief Destructor.
+		/// @note Destroys all items still in the queue.
+		~BoundedMPMCQueue();
+
+		/// @brief Copy constructor.
+		consteval BoundedMPMCQueue(const BoundedMPMCQueue&) = delete;
+		/// @brief Copy assignment operator.
+		consteval BoundedMPMCQueue& operator=(const BoundedMPMCQueue&) = delete;
+		/// @brief Move constructor.
+		consteval BoundedMPMCQueue(BoundedMPMCQueue&&) noexcept = delete;
+		/// @brief Move assignment operator.
+		consteval BoundedMPMCQueue& operator=(BoundedMPMCQueue&&) noexcept = delete;
+
+		/// @brief Push a copy constructable item to the queue.
+		///        Blocks while the queue is full and Done() wasn't called.
+		/// @param item Item to push.
+		/// @return True on success, false if the queue is full and marked as done.
+		template<typename Q = T>
+		requires std::copy_constructible<Q>
+		bool Push(const T& item);
+
+		/// @brief Push a move constructable item to the queue.
+		///        Blocks while the queue is full and Done() wasn't called.
+		/// @param item Item to push. Left untouched on failure.
+		/// @return True on success, false if the queue is full and marked as done.
+		bool Push(T&& item);
+
+		/// @brief Try to push a copy constructable item to the queue.
+		/// @param item Item to push.
+		/// @return True on success, false if the queue is full.
+		template<typename Q = T>
+		requires std::copy_constructible<Q>
+		[[nodiscard]] bool TryPush(const T& item);
+
+		/// @brief Try to push a move constructable item to the queue.
+		/// @param item Item to push. Left untouched on failure.
+		/// @return True on success, false if the queue is full.
+		[[nodiscard]] bool TryPush(T&& item);
+
+		/// @brief Pop an item from the queue.
+		///        Blocks while the queue is empty and Done() wasn't called.
+		/// @param item Item to pop.
+		/// @return True on success, false if the queue is empty and marked as done.
+		[[nodiscard]] bool Pop(T& item);
+
+		/// @brief Try to pop an item from the queue.
+		/// @param item Item to pop.
+		/// @return True on success, false if the queue is empty.
+		[[nodiscard]] bool TryPop(T& item);
+
+		/// @brief Mark the queue as done.
+		///        Wakes up all threads blocked in Push() or Pop().
+		void Done() noexcept;
+
+		/// @brief Check if queue is empty.
+		/// @return True if queue is empty, false otherwise.
+		/// @note The result may already be outdated when used.
+		[[nodiscard]] bool Empty() const noexcept;
+
+		/// @brief Retrieve the size of the queue.
+		/// @return Queue size.
+		/// @note The result may already be outdated when used.
+		[[nodiscard]] u32 Size() const noexcept;
+
+		/// @brief Retrieve the max amount of items in the queue.
+		/// @return Capacity.
+		[[nodiscard]] usize Capacity() const noexcept;
+
+	private:
+		/// @brief Slot of the ring buffer.
+		struct Cell
+		{
+			std::atomic<usize> Sequence = 0;
+			alignas(T) std::byte Storage[sizeof(T)];
+		};
+
+		/// @brief Try to construct a new item in the next free cell.
+		/// @param args Constructor arguments.
+		/// @return True on success, false if the queue is full.
+		template<typename... Args>
+		[[nodiscard]] bool TryEmplace(Args&&... args);
+
+		/// @brief Block until the given condition is met, Done() was called or the epoch changes.
+		/// @param waiters Waiter counter to register at.
+		/// @param epoch Epoch to wait on.
+		/// @param isReady Condition to wait for.
+		template<typename F>
+		void WaitFor(std::atomic<u32>& waiters, const std::atomic<u32>& epoch, F isReady);
+
+		/// @brief Wake up all threads waiting on the given epoch.
+		/// @param waiters Waiter counter of the epoch.
+		/// @param epoch Epoch to signal.
+		static void Notify(const std::atomic<u32>& waiters, std::atomic<u32>& epoch) noexcept;
+
+		/// @brief Amount of failed attempts before a blocking Push() or Pop() goes to sleep.
+		static constexpr u32 SpinCountBeforeSleep = 64;
+
+		std::unique_ptr<Cell[]> m_cells;
+		usize m_mask;
+
+		alignas(std::hardware_destructive_interference_size) std::atomic<usize> m_enqueuePosition = 0;
+		alignas(std::hardware_destructive_interference_size) std::atomic<usize> m_dequeuePosition = 0;
+
+		alignas(std::hardware_destructive_interference_size) std::atomic<u32> m_itemEpoch = 0;
+		std::atomic<u32> m_itemWaiters = 0;
+		std::atomic<u32> m_spaceEpoch = 0;
+		std::atomic<u32> m_spaceWaiters = 0;
+		std::atomic<bool> m_done = false;
+	};
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename T>
+requires std::is_nothrow_move_constructible_v<T>
+TRAP::BoundedMPMCQueue<T>::BoundedMPMCQueue(const usize capacity)
+	: m_cells(std::make_unique<Cell[]>(capacity)), m_mask(capacity - 1u)
+{
+	TRAP_ASSERT(capacity >= 2u && std::has_single_bit(capacity), "BoundedMPMCQueue(): Capacity must be a power of two!");
+
+	for(usize i = 0; i < capacity; ++i)
+		m_cells[i].Sequence.store(i, std::memory_order_relaxed);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename T>
+requires std::is_nothrow_move_constructible_v<T>
+TRAP::BoundedMPMCQueue<T>::~BoundedMPMCQueue()
+{
+	if constexpr(!std::is_trivially_destructible_v<T>)
+	{
+		const usize dequeuePosition = m_dequeuePosition.load(std::memory_order_relaxed);
+		const usize enqueuePosition = m_enqueuePosition.load(std::memory_order_relaxed);
+
+		for(usize position = dequeuePosition; position != enqueuePosition; ++position)
+			std::destroy_at(std::launder(reinterpret_cast<T*>(m_cells[position & m_mask].Storage)));
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename T>
+requires std::is_nothrow_move_constructible_v<T>
+template<typename Q>
+requires std::copy_constructible<Q>
+bool TRAP::BoundedMPMCQueue<T>::Push(const T& item)
+{
+	return Push(T(item));
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename T>
+requires std::is_nothrow_move_constructible_v<T>
+bool TRAP::BoundedMPMCQueue<T>::Push(T&& item)
+{
+	ZoneNamed(__tracy, (GetTRAPProfileSystems() & ProfileSystems::ThreadPool) != ProfileSystems::None &&
+	                   (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	while(!TryEmplace(std::move(item)))
+	{
+		//Consumers may have stopped, nobody is guaranteed to make room anymore
+		if(m_done.load(std::memory_order_acquire))
+			return false;
+
+		WaitFor(m_spaceWaiters, m_spaceEpoch, [this]()
+		{
+			return Size() < Capacity();
+		});
+	}
+
+	return true;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename T>
+requires std::is_nothrow_move_constructible_v<T>
+template<typename Q>
+requires std::copy_constructible<Q>
+[[nodiscard]] bool TRAP::BoundedMPMCQueue<T>::TryPush(const T& item)
+{
+	ZoneNamed(__tracy, (GetTRAPProfileSystems() & ProfileSystems::ThreadPool) != ProfileSystems::None &&
+	                   (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	return TryEmplace(item);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename T>
+requires std::is_nothrow_move_constructible_v<T>
+[[nodiscard]] bool TRAP::BoundedMPMCQueue<T>::TryPush(T&& item)
+{
+	ZoneNamed(__tracy, (GetTRAPProfileSystems() & ProfileSystems::ThreadPool) != ProfileSystems::None &&
+	                   (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	return TryEmplace(std::move(item));
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename T>
+requires std::is_nothrow_move_constructible_v<T>
+[[nodiscard]] bool TRAP::BoundedMPMCQueue<T>::Pop(T& item)
+{
+	ZoneNamed(__tracy, (GetTRAPProfileSystems() & ProfileSystems::ThreadPool) != ProfileSystems::None &&
+	                   (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	while(!TryPop(item))
+	{
+		if(m_done.load(std::memory_order_acquire))
+		{
+			//Items pushed before Done() must still be delivered
+			return TryPop(item);
+		}
+
+		WaitFor(m_itemWaiters, m_itemEpoch, [this]()
+		{
+			return !Empty();
+		});
+	}
+
+	return true;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename T>
+requires std::is_nothrow_move_constructible_v<T>
+[[nodiscard]] bool TRAP::BoundedMPMCQueue<T>::TryPop(T& item)
+{
+	ZoneNamed(__tracy, (GetTRAPProfileSystems() & ProfileSystems::ThreadPool) != ProfileSystems::None &&
+	                   (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	Cell* cell = nullptr;
+	usize position = m_dequeuePosition.load(std::memory_order_relaxed);
+
+	while(true)
+	{
+		cell = &m_cells[position & m_mask];
+		const usize sequence = cell->Sequence.load(std::memory_order_acquire);
+		const auto difference = static_cast<std::make_signed_t<usize>>(sequence - (position + 1u));
+
+		if(difference == 0)
+		{
+			if(m_dequeuePosition.compare_exchange_weak(position, position + 1u, std::memory_order_relaxed))
+				break;
+		}
+		else if(difference < 0)
+			return false; //Empty
+		else
+			position = m_dequeuePosition.load(std::memory_order_relaxed);
+	}
+
+	T* const storedItem = std::launder(reinterpret_cast<T*>(cell->Storage));
+	item = std::move(*storedItem);
+	std::destroy_at(storedItem);
+
+	//Hand the cell over to the producer of the next round
+	cell->Sequence.store(position + m_mask + 1u, std::memory_order_release);
+
+	Notify(m_spaceWaiters, m_spaceEpoch);
+
+	return true;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename T>
+requires std::is_nothrow_move_constructible_v<T>
+void TRAP::BoundedMPMCQueue<T>::Done() noexcept
+{
+	ZoneNamed(__tracy, (GetTRAPProfileSystems() & ProfileSystems::ThreadPool) != ProfileSystems::None);
+
+	m_done.store(true, std::memory_order_seq_cst);
+
+	m_itemEpoch.fetch_add(1, std::memory_order_seq_cst);
+	m_itemEpoch.notify_all();
+	m_spaceEpoch.fetch_add(1, std::memory_order_seq_cst);
+	m_spaceEpoch.notify_all();
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename T>
+requires std::is_nothrow_move_constructible_v<T>
+[[nodiscard]] bool TRAP::BoundedMPMCQueue<T>::Empty() const noexcept
+{
+	ZoneNamed(__tracy, (GetTRAPProfileSystems() & ProfileSystems::ThreadPool) != ProfileSystems::None &&
+	                   (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	return Size() == 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename T>
+requires std::is_nothrow_move_constructible_v<T>
+[[nodiscard]] u32 TRAP::BoundedMPMCQueue<T>::Size() const noexcept
+{
+	ZoneNamed(__tracy, (GetTRAPProfileSystems() & ProfileSystems::ThreadPool) != ProfileSystems::None &&
+	                   (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	const usize dequeuePosition = m_dequeuePosition.load(std::memory_order_acquire);
+	const usize enqueuePosition = m_enqueuePosition.load(std::memory_order_acquire);
+
+	//Positions are read separately, so the difference may be temporarily out of range
+	const auto size = static_cast<std::make_signed_t<usize>>(enqueuePosition - dequeuePosition);
+	if(size <= 0)
+		return 0;
+
+	return static_cast<u32>(std::min(static_cast<usize>(size), Capacity()));
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename T>
+requires std::is_nothrow_move_constructible_v<T>
+[[nodiscard]] usize TRAP::BoundedMPMCQueue<T>::Capacity() const noexcept
+{
+	ZoneNamed(__tracy, (GetTRAPProfileSystems() & ProfileSystems::ThreadPool) != ProfileSystems::None &&
+	                   (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	return m_mask + 1u;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename T>
+requires std::is_nothrow_move_constructible_v<T>
+template<typename... Args>
+[[nodiscard]] bool TRAP::BoundedMPMCQueue<T>::TryEmplace(Args&&... args)
+{
+	Cell* cell = nullptr;
+	usize position = m_enqueuePosition.load(std::memory_order_relaxed);
+
+	while(true)
+	{
+		cell = &m_cells[position & m_mask];
+		const usize sequence = cell->Sequence.load(std::memory_order_acquire);
+		const auto difference = static_cast<std::make_signed_t<usize>>(sequence - position);
+
+		if(difference == 0)
+		{
+			if(m_enqueuePosition.compare_exchange_weak(position, position + 1u, std::memory_order_relaxed))
+				break;
+		}
+		else if(difference < 0)
+			return false; //Full
+		else
+			position = m_enqueuePosition.load(std::memory_order_relaxed);
+	}
+
+	::new(static_cast<void*>(cell->Storage)) T(std::forward<Args>(args)...);
+
+	//Publish the item to consumers
+	cell->Sequence.store(position + 1u, std::memory_order_release);
+
+	Notify(m_itemWaiters, m_itemEpoch);
+
+	return true;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename T>
+requires std::is_nothrow_move_constructible_v<T>
+template<typename F>
+void TRAP::BoundedMPMCQueue<T>::WaitFor(std::atomic<u32>& waiters, const std::atomic<u32>& epoch, F isReady)
+{
+	for(u32 i = 0; i < SpinCountBeforeSleep; ++i)
+	{
+		if(isReady() || m_done.load(std::memory_order_acquire))
+			return;
+
+		std::this_thread::yield();
+	}
+
+	waiters.fetch_add(1, std::memory_order_seq_cst);
+	const u32 currentEpoch = epoch.load(std::memory_order_seq_cst);
+
+	//Recheck after announcing that we want to sleep, a thread which missed
+	//our announcement must have published its change before this check.
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if(!isReady() && !m_done.load(std::memory_order_seq_cst))
+		epoch.wait(currentEpoch, std::memory_order_seq_cst);
+
+	waiters.fetch_sub(1, std::memory_order_seq_cst);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename T>
+requires std::is_nothrow_move_constructible_v<T>
+void TRAP::BoundedMPMCQueue<T>::Notify(const std::atomic<u32>& waiters, std::atomic<u32>& epoch) noexcept
+{
+	//Order the preceding publish before checking for sleeping threads
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	if(waiters.load(std::memory_order_relaxed) == 0)
+		return;
+
+	epoch.fetch_add(1, std::memory_order_seq_cst);
+	epoch.notify_all();
+}
+
+#endif /*TRAP_BOUNDEDMPMCQUEUE_H*/
@@ -0,0 +1,185 @@
+#ifndef TRAP_MOVEONLYTASK_H
+#define TRAP_MOVEONLYTASK_H
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "TaskAllocator.h"
+
+namespace TRAP
+{
+	/// @brief Type erased, move-only void() callable with small buffer optimization.
+	///
+	///        Unlike std::function this doesn't require the callable to be copyable,
+	///        so it can hold lambdas capturing std::promise or other move-only objects.
+	///        Callables which fit into InlineSize bytes and are nothrow move constructible are stored inline,
+	///        bigger callables are stored in memory provided by INTERNAL::TaskAllocator.
+	class MoveOnlyTask
+	{
+	public:
+		/// @brief Amount of bytes available for inline storage of the callable.
+		///        Chosen so that a whole task fills exactly one cache line.
+		static constexpr usize InlineSize = 64 - sizeof(void*);
+
+		/// @brief Check whether the given callable type gets stored inline.
+		/// @tparam F Callable type.
+		template<typename F>
+		static constexpr bool IsStoredInline = sizeof(F) <= InlineSize && alignof(F) <= alignof(std::max_align_t) &&
+		                                       std::is_nothrow_move_constructible_v<F>;
+
+		/// @brief Constructor.
+		///        Creates an empty task.
+		constexpr MoveOnlyTask() noexcept = default;
+
+		/// @brief Constructor.
+		/// @param f Callable to store.
+		template<typename F>
+		requires (!std::same_as<std::remove_cvref_t<F>, MoveOnlyTask>) && std::invocable<std::decay_t<F>&>
+		explicit(false) MoveOnlyTask(F&& f);
+
+		/// @brief Destructor.
+		~MoveOnlyTask();
+
+		/// @brief Copy constructor.
+		consteval MoveOnlyTask(const MoveOnlyTask&) = delete;
+		/// @brief Copy assignment operator.
+		consteval MoveOnlyTask& operator=(const MoveOnlyTask&) = delete;
+		/// @brief Move constructor.
+		MoveOnlyTask(MoveOnlyTask&& other) noexcept;
+		/// @brief Move assignment operator.
+		MoveOnlyTask& operator=(MoveOnlyTask&& other) noexcept;
+
+		/// @brief Invoke the stored callable.
+		/// @warning Must not be called on an empty task.
+		void operator()();
+
+		/// @brief Check whether the task holds a callable.
+		/// @return True if the task holds a callable, false otherwise.
+		[[nodiscard]] constexpr explicit operator bool() const noexcept;
+
+	private:
+		/// @brief Operations for the stored callable type.
+		struct VTable
+		{
+			void(*Invoke)(void* storage);
+			/// @brief Move construct the callable into dst and destroy the one in src.
+			void(*Relocate)(void* dst, void* src) noexcept;
+			void(*Destroy)(void* storage) noexcept;
+		};
+
+		template<typename F>
+		static constexpr VTable InlineVTable
+		{
+			.Invoke = [](void* const storage){std::invoke(*std::launder(static_cast<F*>(storage)));},
+			.Relocate = [](void* const dst, void* const src) noexcept
+			{
+				F* const srcFunc = std::launder(static_cast<F*>(src));
+				::new(dst) F(std::move(*srcFunc));
+				std::destroy_at(srcFunc);
+			},
+			.Destroy = [](void* const storage) noexcept {std::destroy_at(std::launder(static_cast<F*>(storage)));}
+		};
+
+		template<typename F>
+		static constexpr VTable HeapVTable
+		{
+			.Invoke = [](void* const storage){std::invoke(**static_cast<F**>(storage));},
+			.Relocate = [](void* const dst, void* const src) noexcept
+			{
+				::new(dst) F*(*static_cast<F**>(src));
+			},
+			.Destroy = [](void* const storage) noexcept {INTERNAL::TaskAllocator::Delete(*static_cast<F**>(storage));}
+		};
+
+		/// @brief Destroy the stored callable.
+		void Reset() noexcept;
+
+		alignas(std::max_align_t) std::byte m_storage[InlineSize];
+		const VTable* m_vtable = nullptr;
+	};
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename F>
+requires (!std::same_as<std::remove_cvref_t<F>, TRAP::MoveOnlyTask>) && std::invocable<std::decay_t<F>&>
+TRAP::MoveOnlyTask::MoveOnlyTask(F&& f)
+{
+	using Func = std::decay_t<F>;
+
+	if constexpr(IsStoredInline<Func>)
+	{
+		::new(static_cast<void*>(m_storage)) Func(std::forward<F>(f));
+		m_vtable = &InlineVTable<Func>;
+	}
+	else
+	{
+		::new(static_cast<void*>(m_storage)) Func*(INTERNAL::TaskAllocator::New<Func>(std::forward<F>(f)));
+		m_vtable = &HeapVTable<Func>;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+inline TRAP::MoveOnlyTask::~MoveOnlyTask()
+{
+	Reset();
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+inline TRAP::MoveOnlyTask::MoveOnlyTask(MoveOnlyTask&& other) noexcept
+	: m_vtable(std::exchange(other.m_vtable, nullptr))
+{
+	if(m_vtable != nullptr)
+		m_vtable->Relocate(m_storage, other.m_storage);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+inline TRAP::MoveOnlyTask& TRAP::MoveOnlyTask::operator=(MoveOnlyTask&& other) noexcept
+{
+	if(this == &other)
+		return *this;
+
+	Reset();
+
+	m_vtable = std::exchange(other.m_vtable, nullptr);
+	if(m_vtable != nullptr)
+		m_vtable->Relocate(m_storage, other.m_storage);
+
+	return *this;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+inline void TRAP::MoveOnlyTask::operator()()
+{
+	TRAP_ASSERT(m_vtable, "MoveOnlyTask::operator(): Task is empty!");
+
+	m_vtable->Invoke(m_storage);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] constexpr TRAP::MoveOnlyTask::operator bool() const noexcept
+{
+	return m_vtable != nullptr;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+inline void TRAP::MoveOnlyTask::Reset() noexcept
+{
+	if(m_vtable == nullptr)
+		return;
+
+	m_vtable->Destroy(m_storage);
+	m_vtable = nullptr;
+}
+
+#endif /*TRAP_MOVEONLYTASK_H*/
@@ -0,0 +1,12 @@
+#include "TRAPPCH.h"
+#include "Parallel.h"
+
+#include "Application.h"
+
+[[nodiscard]] TRAP::ThreadPool& TRAP::INTERNAL::GetParallelThreadPool()
+{
+	ZoneNamed(__tracy, (GetTRAPProfileSystems() & ProfileSystems::ThreadPool) != ProfileSystems::None &&
+	                   (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	return Application::GetThreadPool();
+}
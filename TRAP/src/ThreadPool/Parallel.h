@@ -0,0 +1,310 @@
+#ifndef TRAP_PARALLEL_H
+#define TRAP_PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <functional>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include "ThreadPool.h"
+
+namespace TRAP
+{
+	namespace INTERNAL
+	{
+		/// @brief Retrieve the engine ThreadPool used by the ParallelFor()/ParallelReduce() overloads without a pool.
+		/// @return Engine ThreadPool.
+		[[nodiscard]] ThreadPool& GetParallelThreadPool();
+
+		/// @brief Amount of chunks created per participating thread.
+		///        More chunks give the work stealing scheduler room to balance uneven workloads,
+		///        less chunks reduce the scheduling overhead.
+		inline constexpr usize ParallelChunksPerThread = 4;
+
+		/// @brief Compute the size of a single chunk for the given range.
+		/// @param count Number of elements in the range.
+		/// @param grain Minimum number of elements per chunk.
+		/// @param threadCount Number of worker threads of the ThreadPool.
+		/// @return Number of elements per chunk.
+		[[nodiscard]] constexpr usize GetParallelChunkSize(usize count, usize grain, u32 threadCount) noexcept;
+
+		/// @brief Partial result of a single ParallelReduce() chunk.
+		///        Each partial lives on its own cache line, so chunks never write to shared memory
+		///        (std::vector<bool> would pack the partials into shared words) and don't false share.
+		template<typename V>
+		struct alignas(std::hardware_destructive_interference_size) ParallelPartial
+		{
+			V Value;
+		};
+
+		/// @brief Splits chunk ranges in halves and enqueues the upper halves to the ThreadPool
+		///        until a single chunk is left, which is then processed by the current thread.
+		///
+		///        Halves enqueued from worker threads land in the workers own deque, so idle
+		///        workers steal the biggest remaining halves first.
+		template<typename F>
+		class ParallelChunkRunner
+		{
+		public:
+			/// @brief Constructor.
+			/// @param threadPool ThreadPool to run the chunks on.
+			/// @param chunkFunc Functor to call for every chunk index.
+			constexpr ParallelChunkRunner(ThreadPool& threadPool, F& chunkFunc) noexcept;
+
+			/// @brief Process all chunks in [0, chunkCount).
+			///        The calling thread takes part in processing and helps the ThreadPool while waiting.
+			/// @param chunkCount Number of chunks.
+			void Run(usize chunkCount);
+
+		private:
+			/// @brief Process the chunks in [firstChunk, lastChunk).
+			/// @param firstChunk First chunk to process.
+			/// @param lastChunk One past the last chunk to process.
+			/// @note After this returns for the last outstanding range, the runner may be destroyed at any time.
+			void Process(usize firstChunk, usize lastChunk);
+
+			ThreadPool& m_threadPool;
+			F& m_chunkFunc;
+			std::atomic<usize> m_remaining = 0;
+		};
+	}
+
+	/// @brief Call the given functor for every index in [begin, end) using the ThreadPool.
+	///
+	///        The range is recursively split into chunks of at least grain elements.
+	///        Ranges which fit into a single chunk are processed directly on the calling thread
+	///        without touching the ThreadPool. The calling thread always processes a part of the range
+	///        and runs other pending tasks while waiting for the remaining chunks.
+	///
+	///        The functor is either called once per chunk with f(chunkBegin, chunkEnd)
+	///        or once per index with f(index).
+	/// @tparam T Integral index type.
+	/// @tparam F Functor type.
+	/// @param threadPool ThreadPool to use.
+	/// @param begin First index.
+	/// @param end One past the last index.
+	/// @param grain Minimum number of indices per chunk, use bigger values for cheap functors.
+	/// @param f Functor to call.
+	/// @note Safe to call from worker threads of the ThreadPool (nested parallelism).
+	/// @warning The functor must not throw.
+	template<std::integral T, typename F>
+	requires std::invocable<F&, T, T> || std::invocable<F&, T>
+	void ParallelFor(ThreadPool& threadPool, T begin, T end, usize grain, F&& f);
+
+	/// @brief Call the given functor for every index in [begin, end) using the engine ThreadPool.
+	/// @tparam T Integral index type.
+	/// @tparam F Functor type.
+	/// @param begin First index.
+	/// @param end One past the last index.
+	/// @param grain Minimum number of indices per chunk, use bigger values for cheap functors.
+	/// @param f Functor to call, either f(chunkBegin, chunkEnd) or f(index).
+	/// @note See ParallelFor(ThreadPool&, T, T, usize, F&&) for details.
+	template<std::integral T, typename F>
+	requires std::invocable<F&, T, T> || std::invocable<F&, T>
+	void ParallelFor(T begin, T end, usize grain, F&& f);
+
+	/// @brief Reduce the range [begin, end) in parallel using the ThreadPool.
+	///
+	///        Every chunk is mapped to a partial result with map(chunkBegin, chunkEnd, identity).
+	///        The partial results are then combined in chunk order with reduce(lhs, rhs) on the calling thread,
+	///        so the result is deterministic for a given range, grain and thread count, even for floating point values.
+	/// @tparam T Integral index type.
+	/// @tparam V Value type.
+	/// @tparam Map Map functor type.
+	/// @tparam Reduce Reduce functor type.
+	/// @param threadPool ThreadPool to use.
+	/// @param begin First index.
+	/// @param end One past the last index.
+	/// @param grain Minimum number of indices per chunk.
+	/// @param identity Identity value of the reduction.
+	/// @param map Functor which computes the partial result of a chunk.
+	/// @param reduce Functor which combines two partial results.
+	/// @return Reduced value or identity if the range is empty.
+	/// @warning The functors must not throw.
+	template<std::integral T, typename V, typename Map, typename Reduce>
+	requires std::is_invocable_r_v<V, Map&, T, T, V> && std::is_invocable_r_v<V, Reduce&, V, V>
+	[[nodiscard]] V ParallelReduce(ThreadPool& threadPool, T begin, T end, usize grain, V identity, Map&& map, Reduce&& reduce);
+
+	/// @brief Reduce the range [begin, end) in parallel using the engine ThreadPool.
+	/// @tparam T Integral index type.
+	/// @tparam V Value type.
+	/// @tparam Map Map functor type.
+	/// @tparam Reduce Reduce functor type.
+	/// @param begin First index.
+	/// @param end One past the last index.
+	/// @param grain Minimum number of indices per chunk.
+	/// @param identity Identity value of the reduction.
+	/// @param map Functor which computes the partial result of a chunk.
+	/// @param reduce Functor which combines two partial results.
+	/// @return Reduced value or identity if the range is empty.
+	/// @note See ParallelReduce(ThreadPool&, T, T, usize, V, Map&&, Reduce&&) for details.
+	template<std::integral T, typename V, typename Map, typename Reduce>
+	requires std::is_invocable_r_v<V, Map&, T, T, V> && std::is_invocable_r_v<V, Reduce&, V, V>
+	[[nodiscard]] V ParallelReduce(T begin, T end, usize grain, V identity, Map&& map, Reduce&& reduce);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] constexpr usize TRAP::INTERNAL::GetParallelChunkSize(const usize count, const usize grain,
+                                                                   const u32 threadCount) noexcept
+{
+	//Worker threads plus the calling thread
+	const usize participants = static_cast<usize>(threadCount) + 1u;
+	const usize targetChunkCount = participants * ParallelChunksPerThread;
+
+	return std::max({(count + targetChunkCount - 1u) / targetChunkCount, grain, usize(1u)});
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename F>
+constexpr TRAP::INTERNAL::ParallelChunkRunner<F>::ParallelChunkRunner(ThreadPool& threadPool, F& chunkFunc) noexcept
+	: m_threadPool(threadPool), m_chunkFunc(chunkFunc)
+{
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename F>
+void TRAP::INTERNAL::ParallelChunkRunner<F>::Run(const usize chunkCount)
+{
+	ZoneNamed(__tracy, (GetTRAPProfileSystems() & ProfileSystems::ThreadPool) != ProfileSystems::None);
+
+	m_remaining.store(1, std::memory_order_relaxed);
+	Process(0, chunkCount);
+
+	//Help with pending tasks until all chunks are done
+	while(m_remaining.load(std::memory_order_acquire) != 0)
+	{
+		if(!m_threadPool.TryRunPendingTask())
+			std::this_thread::yield();
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename F>
+void TRAP::INTERNAL::ParallelChunkRunner<F>::Process(const usize firstChunk, usize lastChunk)
+{
+	while(lastChunk - firstChunk > 1u)
+	{
+		const usize middleChunk = firstChunk + ((lastChunk - firstChunk) / 2u);
+
+		m_remaining.fetch_add(1, std::memory_order_relaxed);
+		m_threadPool.EnqueueWork([this, middleChunk, lastChunk](){Process(middleChunk, lastChunk);});
+
+		lastChunk = middleChunk;
+	}
+
+	std::invoke(m_chunkFunc, firstChunk);
+
+	//Note: Must be the last access to this runner
+	m_remaining.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<std::integral T, typename F>
+requires std::invocable<F&, T, T> || std::invocable<F&, T>
+void TRAP::ParallelFor(ThreadPool& threadPool, const T begin, const T end, const usize grain, F&& f)
+{
+	ZoneNamed(__tracy, (GetTRAPProfileSystems() & ProfileSystems::ThreadPool) != ProfileSystems::None);
+
+	if(end <= begin)
+		return;
+
+	const auto processRange = [&f](const T rangeBegin, const T rangeEnd)
+	{
+		if constexpr(std::invocable<F&, T, T>)
+			std::invoke(f, rangeBegin, rangeEnd);
+		else
+		{
+			for(T i = rangeBegin; i < rangeEnd; ++i)
+				std::invoke(f, i);
+		}
+	};
+
+	const usize count = static_cast<usize>(end - begin);
+	const usize chunkSize = INTERNAL::GetParallelChunkSize(count, grain, threadPool.GetThreadCount());
+	const usize chunkCount = (count + chunkSize - 1u) / chunkSize;
+
+	//Small ranges stay on the calling thread
+	if(chunkCount <= 1u)
+	{
+		processRange(begin, end);
+		return;
+	}
+
+	auto chunkFunc = [&processRange, begin, end, chunkSize](const usize chunk)
+	{
+		const T chunkBegin = static_cast<T>(begin + static_cast<T>(chunk * chunkSize));
+		const T chunkEnd = static_cast<usize>(end - chunkBegin) > chunkSize ? static_cast<T>(chunkBegin + static_cast<T>(chunkSize)) : end;
+		processRange(chunkBegin, chunkEnd);
+	};
+
+	INTERNAL::ParallelChunkRunner runner(threadPool, chunkFunc);
+	runner.Run(chunkCount);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<std::integral T, typename F>
+requires std::invocable<F&, T, T> || std::invocable<F&, T>
+void TRAP::ParallelFor(const T begin, const T end, const usize grain, F&& f)
+{
+	ParallelFor(INTERNAL::GetParallelThreadPool(), begin, end, grain, std::forward<F>(f));
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<std::integral T, typename V, typename Map, typename Reduce>
+requires std::is_invocable_r_v<V, Map&, T, T, V> && std::is_invocable_r_v<V, Reduce&, V, V>
+[[nodiscard]] V TRAP::ParallelReduce(ThreadPool& threadPool, const T begin, const T end, const usize grain,
+                                     V identity, Map&& map, Reduce&& reduce)
+{
+	ZoneNamed(__tracy, (GetTRAPProfileSystems() & ProfileSystems::ThreadPool) != ProfileSystems::None);
+
+	if(end <= begin)
+		return identity;
+
+	const usize count = static_cast<usize>(end - begin);
+	const usize chunkSize = INTERNAL::GetParallelChunkSize(count, grain, threadPool.GetThreadCount());
+	const usize chunkCount = (count + chunkSize - 1u) / chunkSize;
+
+	//Small ranges stay on the calling thread
+	if(chunkCount <= 1u)
+		return std::invoke(map, begin, end, std::move(identity));
+
+	std::vector<INTERNAL::ParallelPartial<V>> partials(chunkCount, INTERNAL::ParallelPartial<V>{identity});
+
+	auto chunkFunc = [&partials, &map, &identity, begin, end, chunkSize](const usize chunk)
+	{
+		const T chunkBegin = static_cast<T>(begin + static_cast<T>(chunk * chunkSize));
+		const T chunkEnd = static_cast<usize>(end - chunkBegin) > chunkSize ? static_cast<T>(chunkBegin + static_cast<T>(chunkSize)) : end;
+		partials[chunk].Value = std::invoke(map, chunkBegin, chunkEnd, identity);
+	};
+
+	INTERNAL::ParallelChunkRunner runner(threadPool, chunkFunc);
+	runner.Run(chunkCount);
+
+	V result = std::move(identity);
+	for(INTERNAL::ParallelPartial<V>& partial : partials)
+		result = std::invoke(reduce, std::move(result), std::move(partial.Value));
+
+	return result;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<std::integral T, typename V, typename Map, typename Reduce>
+requires std::is_invocable_r_v<V, Map&, T, T, V> && std::is_invocable_r_v<V, Reduce&, V, V>
+[[nodiscard]] V TRAP::ParallelReduce(const T begin, const T end, const usize grain, V identity, Map&& map, Reduce&& reduce)
+{
+	return ParallelReduce(INTERNAL::GetParallelThreadPool(), begin, end, grain, std::move(identity),
+	                      std::forward<Map>(map), std::forward<Reduce>(reduce));
+}
+
+#endif /*TRAP_PARALLEL_H*/
@@ -0,0 +1,206 @@
+#include "TRAPPCH.h"
+#include "TaskAllocator.h"
+
+namespace
+{
+	/// @brief Smallest block size, every size class doubles the block size.
+	constexpr usize MinBlockSize = 64;
+	constexpr usize SizeClassCount = 4;
+	static_assert((MinBlockSize << (SizeClassCount - 1u)) == TRAP::INTERNAL::TaskAllocator::MaxBlockSize);
+
+	/// @brief Amount of blocks moved between a thread local cache and the global list at once.
+	constexpr u32 BatchSize = 32;
+	/// @brief Max amount of memory kept per size class in the global list, more gets freed.
+	constexpr usize MaxGlobalBytesPerSizeClass = 1024u * 1024u;
+
+	/// @brief Header of an unused block.
+	struct FreeBlock
+	{
+		FreeBlock* Next = nullptr;
+	};
+
+	/// @brief Singly linked chain of unused blocks.
+	struct FreeList
+	{
+		FreeBlock* Head = nullptr;
+		u32 Count = 0;
+	};
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	[[nodiscard]] constexpr usize GetSizeClass(const usize size) noexcept
+	{
+		usize sizeClass = 0;
+		while((MinBlockSize << sizeClass) < size)
+			++sizeClass;
+
+		return sizeClass;
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	[[nodiscard]] constexpr usize GetBlockSize(const usize sizeClass) noexcept
+	{
+		return MinBlockSize << sizeClass;
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	[[nodiscard]] constexpr usize GetMaxGlobalBatches(const usize sizeClass) noexcept
+	{
+		return MaxGlobalBytesPerSizeClass / (GetBlockSize(sizeClass) * BatchSize);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Global lists of block batches shared by all threads.
+	struct GlobalFreeLists
+	{
+		std::mutex Mutex{};
+		std::array<std::vector<FreeList>, SizeClassCount> Batches{};
+
+		GlobalFreeLists()
+		{
+			for(usize sizeClass = 0; sizeClass < SizeClassCount; ++sizeClass)
+				Batches[sizeClass].reserve(GetMaxGlobalBatches(sizeClass));
+		}
+
+		/// @brief Retrieve a batch of blocks for the given size class.
+		/// @param sizeClass Size class.
+		/// @return Batch of blocks, empty if no batch is available.
+		[[nodiscard]] FreeList Acquire(const usize sizeClass)
+		{
+			const std::lock_guard lock(Mutex);
+
+			auto& batches = Batches[sizeClass];
+			if(batches.empty())
+				return {};
+
+			const FreeList batch = batches.back();
+			batches.pop_back();
+			return batch;
+		}
+
+		/// @brief Hand over a batch of blocks for the given size class.
+		/// @param sizeClass Size class.
+		/// @param batch Batch of blocks.
+		void Release(const usize sizeClass, FreeList batch) noexcept
+		{
+			{
+				const std::lock_guard lock(Mutex);
+
+				auto& batches = Batches[sizeClass];
+				if(batches.size() < GetMaxGlobalBatches(sizeClass))
+				{
+					batches.push_back(batch);
+					return;
+				}
+			}
+
+			//Global list is full, give the memory back
+			while(batch.Head != nullptr)
+			{
+				FreeBlock* const block = batch.Head;
+				batch.Head = block->Next;
+				::operator delete(block, GetBlockSize(sizeClass));
+			}
+		}
+	};
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Retrieve the global lists.
+	/// @return Global lists.
+	/// @note Intentionally never destroyed, blocks may get freed during static destruction.
+	[[nodiscard]] GlobalFreeLists& GetGlobalFreeLists()
+	{
+		static GlobalFreeLists* const lists = new GlobalFreeLists();
+		return *lists;
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Per thread cache of unused blocks.
+	struct ThreadCache
+	{
+		std::array<FreeList, SizeClassCount> Lists{};
+
+		constexpr ThreadCache() noexcept = default;
+
+		/// @brief Destructor.
+		///        Hands all cached blocks over to the global lists.
+		~ThreadCache()
+		{
+			for(usize sizeClass = 0; sizeClass < SizeClassCount; ++sizeClass)
+			{
+				if(Lists[sizeClass].Head != nullptr)
+					GetGlobalFreeLists().Release(sizeClass, Lists[sizeClass]);
+			}
+		}
+
+		consteval ThreadCache(const ThreadCache&) = delete;
+		consteval ThreadCache& operator=(const ThreadCache&) = delete;
+		consteval ThreadCache(ThreadCache&&) noexcept = delete;
+		consteval ThreadCache& operator=(ThreadCache&&) noexcept = delete;
+	};
+
+	thread_local ThreadCache LocalCache{};
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] void* TRAP::INTERNAL::TaskAllocator::Allocate(const usize size, const usize alignment)
+{
+	if(size > MaxBlockSize || alignment > alignof(std::max_align_t))
+		return ::operator new(size, std::align_val_t(alignment));
+
+	const usize sizeClass = GetSizeClass(size);
+	FreeList& list = LocalCache.Lists[sizeClass];
+
+	if(list.Head == nullptr)
+	{
+		list = GetGlobalFreeLists().Acquire(sizeClass);
+		if(list.Head == nullptr)
+			return ::operator new(GetBlockSize(sizeClass));
+	}
+
+	FreeBlock* const block = list.Head;
+	list.Head = block->Next;
+	--list.Count;
+
+	return block;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::INTERNAL::TaskAllocator::Deallocate(void* const ptr, const usize size, const usize alignment) noexcept
+{
+	if(ptr == nullptr)
+		return;
+
+	if(size > MaxBlockSize || alignment > alignof(std::max_align_t))
+	{
+		::operator delete(ptr, size, std::align_val_t(alignment));
+		return;
+	}
+
+	const usize sizeClass = GetSizeClass(size);
+	FreeList& list = LocalCache.Lists[sizeClass];
+
+	list.Head = ::new(ptr) FreeBlock{list.Head};
+	++list.Count;
+
+	if(list.Count < 2u * BatchSize)
+		return;
+
+	//Cache overflows, hand a batch over to the other threads
+	FreeList batch{list.Head, BatchSize};
+	FreeBlock* last = list.Head;
+	for(u32 i = 1; i < BatchSize; ++i)
+		last = last->Next;
+	list.Head = last->Next;
+	list.Count -= BatchSize;
+	last->Next = nullptr;
+
+	GetGlobalFreeLists().Release(sizeClass, batch);
+}
@@ -0,0 +1,142 @@
+#ifndef TRAP_TASKALLOCATOR_H
+#define TRAP_TASKALLOCATOR_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "Core/Base.h"
+#include "Core/Types.h"
+
+namespace TRAP::INTERNAL
+{
+	/// @brief Recycling allocator for small and short lived ThreadPool allocations like
+	///        task nodes and the shared states of futures.
+	///
+	///        Memory blocks are grouped into size classes (64, 128, 256 and 512 bytes).
+	///        Freed blocks are kept in a thread local cache, overflowing caches hand batches of blocks
+	///        over to a global list from where other threads refill their empty caches.
+	///        This way blocks allocated by the submitting thread and freed by a worker thread get recycled too.
+	///        Bigger allocations are forwarded to the global operator new.
+	/// @threadsafety This class is thread safe.
+	class TaskAllocator
+	{
+	public:
+		/// @brief Size of the biggest block managed by the allocator.
+		static constexpr usize MaxBlockSize = 512;
+
+		/// @brief Constructor.
+		consteval TaskAllocator() = delete;
+
+		/// @brief Allocate memory.
+		/// @param size Size in bytes.
+		/// @param alignment Alignment in bytes.
+		/// @return Pointer to the allocated memory.
+		[[nodiscard]] static void* Allocate(usize size, usize alignment = alignof(std::max_align_t));
+		/// @brief Free memory allocated with Allocate().
+		/// @param ptr Pointer to free.
+		/// @param size Size in bytes which was passed to Allocate().
+		/// @param alignment Alignment in bytes which was passed to Allocate().
+		static void Deallocate(void* ptr, usize size, usize alignment = alignof(std::max_align_t)) noexcept;
+
+		/// @brief Allocate and construct an object.
+		/// @tparam T Type of object.
+		/// @param args Arguments for the constructor.
+		/// @return Pointer to the new object.
+		template<typename T, typename... Args>
+		[[nodiscard]] static T* New(Args&&... args);
+		/// @brief Destroy and free an object created with New().
+		/// @tparam T Type of object.
+		/// @param ptr Object to delete.
+		template<typename T>
+		static void Delete(T* ptr) noexcept;
+	};
+
+	/// @brief Standard library compatible allocator using TaskAllocator.
+	///        Used to recycle the shared states of std::promise/std::future pairs.
+	/// @tparam T Type of object to allocate.
+	template<typename T>
+	class TaskStdAllocator
+	{
+	public:
+		using value_type = T;
+
+		/// @brief Constructor.
+		constexpr TaskStdAllocator() noexcept = default;
+
+		/// @brief Rebinding constructor.
+		template<typename U>
+		constexpr explicit(false) TaskStdAllocator(const TaskStdAllocator<U>&) noexcept;
+
+		/// @brief Allocate memory for n objects.
+		/// @param n Number of objects.
+		/// @return Pointer to the allocated memory.
+		[[nodiscard]] T* allocate(usize n);
+		/// @brief Free memory for n objects.
+		/// @param ptr Pointer to free.
+		/// @param n Number of objects.
+		void deallocate(T* ptr, usize n) noexcept;
+
+		template<typename U>
+		[[nodiscard]] constexpr bool operator==(const TaskStdAllocator<U>&) const noexcept;
+	};
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename T, typename... Args>
+[[nodiscard]] T* TRAP::INTERNAL::TaskAllocator::New(Args&&... args)
+{
+	void* const memory = Allocate(sizeof(T), alignof(T));
+	return ::new(memory) T(std::forward<Args>(args)...);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename T>
+void TRAP::INTERNAL::TaskAllocator::Delete(T* const ptr) noexcept
+{
+	if(ptr == nullptr)
+		return;
+
+	std::destroy_at(ptr);
+	Deallocate(ptr, sizeof(T), alignof(T));
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename T>
+template<typename U>
+constexpr TRAP::INTERNAL::TaskStdAllocator<T>::TaskStdAllocator(const TaskStdAllocator<U>&) noexcept
+{
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename T>
+[[nodiscard]] T* TRAP::INTERNAL::TaskStdAllocator<T>::allocate(const usize n)
+{
+	return static_cast<T*>(TaskAllocator::Allocate(n * sizeof(T), alignof(T)));
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename T>
+void TRAP::INTERNAL::TaskStdAllocator<T>::deallocate(T* const ptr, const usize n) noexcept
+{
+	TaskAllocator::Deallocate(ptr, n * sizeof(T), alignof(T));
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename T>
+template<typename U>
+[[nodiscard]] constexpr bool TRAP::INTERNAL::TaskStdAllocator<T>::operator==(const TaskStdAllocator<U>&) const noexcept
+{
+	return true;
+}
+
+#endif /*TRAP_TASKALLOCATOR_H*/
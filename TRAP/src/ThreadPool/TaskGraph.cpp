@@ -0,0 +1,197 @@
+#include "TRAPPCH.h"
+#include "TaskGraph.h"
+
+[[nodiscard]] u32 TRAP::TaskGraph::Task::GetPredecessorCount() const noexcept
+{
+	ZoneNamed(__tracy, (GetTRAPProfileSystems() & ProfileSystems::ThreadPool) != ProfileSystems::None &&
+	                   (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	TRAP_ASSERT(m_node, "TaskGraph::Task::GetPredecessorCount(): Invalid task!");
+
+	return m_node->PredecessorCount;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] u32 TRAP::TaskGraph::Task::GetSuccessorCount() const noexcept
+{
+	ZoneNamed(__tracy, (GetTRAPProfileSystems() & ProfileSystems::ThreadPool) != ProfileSystems::None &&
+	                   (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	TRAP_ASSERT(m_node, "TaskGraph::Task::GetSuccessorCount(): Invalid task!");
+
+	return NumericCast<u32>(m_node->Successors.size());
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------------//
+
+TRAP::TaskGraph::TaskGraph(ThreadPool& threadPool)
+	: m_threadPool(threadPool)
+{
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+TRAP::TaskGraph::~TaskGraph()
+{
+	ZoneNamed(__tracy, (GetTRAPProfileSystems() & ProfileSystems::ThreadPool) != ProfileSystems::None);
+
+	Wait();
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::TaskGraph::Run(const TaskPriority priority)
+{
+	ZoneNamed(__tracy, (GetTRAPProfileSystems() & ProfileSystems::ThreadPool) != ProfileSystems::None);
+
+	//Make sure a previous run has fully finished
+	Wait();
+
+	if(m_nodes.empty())
+		return;
+
+	m_priority = priority;
+
+	for(const auto& node : m_nodes)
+		node->PendingPredecessors.store(node->PredecessorCount, std::memory_order_relaxed);
+
+	{
+		const std::lock_guard lock(m_mutex);
+		m_done = false;
+	}
+	m_remainingTasks.store(m_nodes.size(), std::memory_order_release);
+
+	//Collect roots first, running tasks may already decrement counters of other nodes
+	std::vector<Node*> roots{};
+	for(const auto& node : m_nodes)
+	{
+		if(node->PredecessorCount == 0)
+			roots.push_back(node.get());
+	}
+
+	TRAP_ASSERT(!roots.empty(), "TaskGraph::Run(): Graph contains a cycle!");
+
+	for(Node* const root : roots)
+		Schedule(root);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::TaskGraph::Wait()
+{
+	ZoneNamed(__tracy, (GetTRAPProfileSystems() & ProfileSystems::ThreadPool) != ProfileSystems::None);
+
+	m_waiterCount.fetch_add(1, std::memory_order_seq_cst);
+
+	while(true)
+	{
+		u64 generation = 0;
+		{
+			const std::lock_guard lock(m_mutex);
+			if(m_done)
+				break;
+			generation = m_scheduleGeneration;
+		}
+
+		//Help instead of sleeping
+		if(m_threadPool.TryRunPendingTask())
+			continue;
+
+		//Nothing to help with, sleep until new tasks got enqueued or the graph finished
+		std::unique_lock lock(m_mutex);
+		m_condition.wait(lock, [this, generation](){return m_done || m_scheduleGeneration != generation;});
+	}
+
+	m_waiterCount.fetch_sub(1, std::memory_order_seq_cst);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] bool TRAP::TaskGraph::IsDone() const noexcept
+{
+	ZoneNamed(__tracy, (GetTRAPProfileSystems() & ProfileSystems::ThreadPool) != ProfileSystems::None &&
+	                   (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	return m_remainingTasks.load(std::memory_order_acquire) == 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] usize TRAP::TaskGraph::GetTaskCount() const noexcept
+{
+	ZoneNamed(__tracy, (GetTRAPProfileSystems() & ProfileSystems::ThreadPool) != ProfileSystems::None &&
+	                   (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	return m_nodes.size();
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::TaskGraph::Clear()
+{
+	ZoneNamed(__tracy, (GetTRAPProfileSystems() & ProfileSystems::ThreadPool) != ProfileSystems::None);
+
+	TRAP_ASSERT(IsDone(), "TaskGraph::Clear(): Graph must not be modified while running!");
+
+	m_nodes.clear();
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::TaskGraph::Schedule(Node* const node)
+{
+	m_threadPool.EnqueueWork(m_priority, [this, node](){Execute(node);});
+
+	NotifyWaiters();
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::TaskGraph::Execute(Node* node)
+{
+	ZoneNamed(__tracy, (GetTRAPProfileSystems() & ProfileSystems::ThreadPool) != ProfileSystems::None);
+
+	while(node != nullptr)
+	{
+		if(node->Work)
+			node->Work();
+
+		//Release successors, keep one ready successor to run as continuation on this thread
+		Node* continuation = nullptr;
+		for(Node* const successor : node->Successors)
+		{
+			if(successor->PendingPredecessors.fetch_sub(1, std::memory_order_acq_rel) != 1)
+				continue;
+
+			if(continuation != nullptr)
+				Schedule(continuation);
+			continuation = successor;
+		}
+
+		//Note: After the last task finished the graph may get destroyed at any time
+		if(m_remainingTasks.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			const std::lock_guard lock(m_mutex);
+			m_done = true;
+			m_condition.notify_all();
+			return;
+		}
+
+		node = continuation;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::TaskGraph::NotifyWaiters()
+{
+	if(m_waiterCount.load(std::memory_order_seq_cst) == 0)
+		return;
+
+	const std::lock_guard lock(m_mutex);
+	++m_scheduleGeneration;
+	m_condition.notify_all();
+}
@@ -0,0 +1,227 @@
+#ifndef TRAP_TASKGRAPH_H
+#define TRAP_TASKGRAPH_H
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "ThreadPool.h"
+
+namespace TRAP
+{
+	/// @brief TaskGraph describes a set of tasks with dependencies between them
+	///        and executes them on the worker threads of a ThreadPool.
+	///
+	///        A task becomes ready once all of its predecessors have finished.
+	///        Ready tasks are enqueued to the ThreadPool, except for one ready successor
+	///        which gets run directly as a continuation by the thread that finished its last predecessor.
+	///
+	///        Example:
+	///        TRAP::TaskGraph graph(TRAP::Application::GetThreadPool());
+	///        auto load = graph.Emplace([](){ /*Load scene*/ });
+	///        auto build = graph.Emplace([](){ /*Build frame*/ });
+	///        load.Precede(build);
+	///        graph.Run();
+	///        graph.Wait();
+	/// @threadsafety Building the graph (Emplace(), Precede(), Succeed()) is not thread safe
+	///               and must not happen while the graph is running.
+	class TaskGraph
+	{
+		struct Node;
+
+	public:
+		/// @brief Lightweight handle to a task inside a TaskGraph.
+		class Task
+		{
+		public:
+			/// @brief Constructor.
+			constexpr Task() noexcept = default;
+
+			/// @brief Make the given tasks run after this task has finished.
+			/// @param tasks Tasks which depend on this task.
+			/// @return Reference to this task.
+			template<typename... Tasks>
+			requires (std::same_as<Tasks, Task> && ...)
+			Task& Precede(const Tasks&... tasks);
+
+			/// @brief Make this task run after the given tasks have finished.
+			/// @param tasks Tasks this task depends on.
+			/// @return Reference to this task.
+			template<typename... Tasks>
+			requires (std::same_as<Tasks, Task> && ...)
+			Task& Succeed(const Tasks&... tasks);
+
+			/// @brief Retrieve the number of tasks this task depends on.
+			/// @return Number of predecessors.
+			[[nodiscard]] u32 GetPredecessorCount() const noexcept;
+
+			/// @brief Retrieve the number of tasks which depend on this task.
+			/// @return Number of successors.
+			[[nodiscard]] u32 GetSuccessorCount() const noexcept;
+
+			/// @brief Check whether the handle refers to a task.
+			/// @return True if handle is valid, false otherwise.
+			[[nodiscard]] constexpr bool IsValid() const noexcept;
+
+		private:
+			friend class TaskGraph;
+
+			/// @brief Constructor.
+			/// @param node Node of the task.
+			constexpr explicit Task(Node* node) noexcept;
+
+			Node* m_node = nullptr;
+		};
+
+		/// @brief Constructor.
+		/// @param threadPool ThreadPool to run the tasks on.
+		explicit TaskGraph(ThreadPool& threadPool);
+		/// @brief Destructor.
+		/// @note Waits for a running graph to finish.
+		~TaskGraph();
+
+		/// @brief Copy constructor.
+		consteval TaskGraph(const TaskGraph&) = delete;
+		/// @brief Copy assignment operator.
+		consteval TaskGraph& operator=(const TaskGraph&) = delete;
+		/// @brief Move constructor.
+		consteval TaskGraph(TaskGraph&&) noexcept = delete;
+		/// @brief Move assignment operator.
+		consteval TaskGraph& operator=(TaskGraph&&) noexcept = delete;
+
+		/// @brief Add a new task to the graph.
+		/// @param f Functor to run.
+		/// @return Handle to the new task.
+		template<typename F>
+		requires std::invocable<F>
+		Task Emplace(F&& f);
+
+		/// @brief Start executing the graph.
+		///        All tasks without predecessors get enqueued to the ThreadPool.
+		/// @param priority Priority with which the tasks get enqueued.
+		/// @note A graph can be run multiple times, Run() waits for the previous run to finish.
+		/// @warning The graph must not contain cycles.
+		void Run(TaskPriority priority = TaskPriority::Normal);
+
+		/// @brief Wait until all tasks of the current run have finished.
+		///        Instead of sleeping the calling thread helps by running pending tasks of the ThreadPool.
+		/// @note Safe to call from worker threads of the ThreadPool.
+		void Wait();
+
+		/// @brief Check whether the current run has finished.
+		/// @return True if all tasks have finished or the graph was never run, false otherwise.
+		[[nodiscard]] bool IsDone() const noexcept;
+
+		/// @brief Retrieve the number of tasks in the graph.
+		/// @return Number of tasks.
+		[[nodiscard]] usize GetTaskCount() const noexcept;
+
+		/// @brief Remove all tasks from the graph.
+		/// @note Must not be called while the graph is running.
+		void Clear();
+
+	private:
+		struct Node
+		{
+			MoveOnlyTask Work{};
+			std::vector<Node*> Successors{};
+			u32 PredecessorCount = 0;
+			std::atomic<u32> PendingPredecessors = 0;
+		};
+
+		/// @brief Enqueue the given node to the ThreadPool.
+		/// @param node Node to enqueue.
+		void Schedule(Node* node);
+
+		/// @brief Run the given node and its continuations.
+		/// @param node Node to run.
+		void Execute(Node* node);
+
+		/// @brief Signal helping waiters that new tasks were enqueued.
+		void NotifyWaiters();
+
+		ThreadPool& m_threadPool;
+		std::vector<std::unique_ptr<Node>> m_nodes{};
+		TaskPriority m_priority = TaskPriority::Normal;
+
+		std::atomic<usize> m_remainingTasks = 0;
+		std::atomic<u32> m_waiterCount = 0;
+
+		std::mutex m_mutex{};
+		std::condition_variable m_condition{};
+		u64 m_scheduleGeneration = 0; //Protected by m_mutex
+		bool m_done = true; //Protected by m_mutex
+	};
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename... Tasks>
+requires (std::same_as<Tasks, TRAP::TaskGraph::Task> && ...)
+TRAP::TaskGraph::Task& TRAP::TaskGraph::Task::Precede(const Tasks&... tasks)
+{
+	TRAP_ASSERT(m_node, "TaskGraph::Task::Precede(): Invalid task!");
+
+	const auto link = [this](const Task& successor)
+	{
+		TRAP_ASSERT(successor.m_node, "TaskGraph::Task::Precede(): Invalid successor task!");
+
+		m_node->Successors.push_back(successor.m_node);
+		++successor.m_node->PredecessorCount;
+	};
+	(link(tasks), ...);
+
+	return *this;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename... Tasks>
+requires (std::same_as<Tasks, TRAP::TaskGraph::Task> && ...)
+TRAP::TaskGraph::Task& TRAP::TaskGraph::Task::Succeed(const Tasks&... tasks)
+{
+	TRAP_ASSERT(m_node, "TaskGraph::Task::Succeed(): Invalid task!");
+
+	const auto link = [this](Task predecessor)
+	{
+		predecessor.Precede(*this);
+	};
+	(link(tasks), ...);
+
+	return *this;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] constexpr bool TRAP::TaskGraph::Task::IsValid() const noexcept
+{
+	return m_node != nullptr;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+constexpr TRAP::TaskGraph::Task::Task(Node* const node) noexcept
+	: m_node(node)
+{
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename F>
+requires std::invocable<F>
+TRAP::TaskGraph::Task TRAP::TaskGraph::Emplace(F&& f)
+{
+	ZoneNamed(__tracy, (GetTRAPProfileSystems() & ProfileSystems::ThreadPool) != ProfileSystems::None);
+
+	TRAP_ASSERT(IsDone(), "TaskGraph::Emplace(): Graph must not be modified while running!");
+
+	auto node = std::make_unique<Node>();
+	node->Work = std::forward<F>(f);
+	m_nodes.push_back(std::move(node));
+
+	return Task(m_nodes.back().get());
+}
+
+#endif /*TRAP_TASKGRAPH_H*/
@@ -3,48 +3,250 @@
 
 #include "Utils/Utils.h"
 
+namespace
+{
+	/// @brief Worker context of the current thread.
+	///        Only set for threads owned by a ThreadPool.
+	struct WorkerContext
+	{
+		const void* Pool = nullptr;
+		u32 Index = 0;
+	};
+
+	thread_local WorkerContext LocalWorker{};
+
+	/// @brief State of the victim selection PRNG of the current thread.
+	thread_local u64 LocalRandomState = 0;
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Small and fast xorshift64 PRNG used for victim selection.
+	/// @param state State of the PRNG.
+	/// @return Next random number.
+	[[nodiscard]] constexpr u64 NextRandom(u64& state) noexcept
+	{
+		state ^= state << 13u;
+		state ^= state >> 7u;
+		state ^= state << 17u;
+		return state;
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Amount of failed task searches before an idle worker goes to sleep.
+	constexpr u32 SpinCountBeforeSleep = 64;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
 TRAP::ThreadPool::ThreadPool(const u32 threads)
-	: m_queues(threads), m_maxThreadsCount(threads)
+	: m_maxThreadsCount(threads)
 {
 	ZoneNamed(__tracy, (GetTRAPProfileSystems() & ProfileSystems::ThreadPool) != ProfileSystems::None);
 
 	if (m_maxThreadsCount == 0)
-	{
 		m_maxThreadsCount = 3; //Fallback to 3 threads
-		m_queues = Queues(3);
+
+	m_workers.reserve(m_maxThreadsCount);
+	for (u32 i = 0; i < m_maxThreadsCount; ++i)
+		m_workers.emplace_back(std::make_unique<Worker>());
+
+	m_threads.reserve(m_maxThreadsCount);
+	for (u32 i = 0; i < m_maxThreadsCount; ++i)
+		m_threads.emplace_back(&ThreadPool::WorkerLoop, this, i);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+TRAP::ThreadPool::~ThreadPool()
+{
+	ZoneNamed(__tracy, (GetTRAPProfileSystems() & ProfileSystems::ThreadPool) != ProfileSystems::None);
+
+	m_stop.store(true, std::memory_order_seq_cst);
+	m_wakeEpoch.fetch_add(1, std::memory_order_seq_cst);
+	m_wakeEpoch.notify_all();
+
+	//Join workers before the worker data gets destroyed
+	m_threads.clear();
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] u32 TRAP::ThreadPool::GetThreadCount() const noexcept
+{
+	ZoneNamed(__tracy, (GetTRAPProfileSystems() & ProfileSystems::ThreadPool) != ProfileSystems::None &&
+	                   (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	return m_maxThreadsCount;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+bool TRAP::ThreadPool::TryRunPendingTask()
+{
+	ZoneNamed(__tracy, (GetTRAPProfileSystems() & ProfileSystems::ThreadPool) != ProfileSystems::None);
+
+	const u32 index = LocalWorker.Pool == this ? LocalWorker.Index : ExternalThreadIndex;
+
+	Proc* const task = TryGetTask(index);
+	if(task == nullptr)
+		return false;
+
+	RunTask(task);
+
+	return true;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::ThreadPool::Submit(Proc* const proc, const TaskPriority priority)
+{
+	ZoneNamed(__tracy, (GetTRAPProfileSystems() & ProfileSystems::ThreadPool) != ProfileSystems::None);
+
+	const usize priorityIndex = std::to_underlying(priority);
+
+	//Count the task before publishing it, so a worker that takes it never sees the counter underflow
+	m_pendingTasks.fetch_add(1, std::memory_order_seq_cst);
+
+	if(LocalWorker.Pool == this)
+	{
+		m_workers[LocalWorker.Index]->Deques[priorityIndex].Push(proc);
+		WakeWorker();
+		return;
 	}
 
-	auto worker = [&](const u32 i)
+	const u32 start = m_index++;
+	for(u32 n = 0; n < m_maxThreadsCount; ++n)
 	{
-		//Set Thread name for profiler
-		Utils::SetThreadName(fmt::format("Worker {}", i));
+		if(m_workers[(start + n) % m_maxThreadsCount]->Inboxes[priorityIndex].TryPush(proc))
+		{
+			WakeWorker();
+			return;
+		}
+	}
+
+	//All inboxes are full, wait until a worker made room
+	WakeWorker();
+	m_workers[start % m_maxThreadsCount]->Inboxes[priorityIndex].Push(proc);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::ThreadPool::RunTask(Proc* const proc)
+{
+	(*proc)();
+
+	INTERNAL::TaskAllocator::Delete(proc);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::ThreadPool::WorkerLoop(const u32 index)
+{
+	//Set Thread name for profiler
+	Utils::SetThreadName(fmt::format("Worker {}", index));
+
+	LocalWorker = WorkerContext{this, index};
+	LocalRandomState = 0x9E3779B97F4A7C15ull * (static_cast<u64>(index) + 1u);
+
+	u32 failedSearches = 0;
+
+	while (true)
+	{
+		if (Proc* const task = TryGetTask(index))
+		{
+			failedSearches = 0;
+
+			RunTask(task);
+			continue;
+		}
 
-		while (true)
+		if (m_pendingTasks.load(std::memory_order_seq_cst) != 0)
 		{
-			Proc f;
-			for (u32 n = 0; n < m_maxThreadsCount; ++n)
+			//Work exists but we lost the race for it, retry
+			if (++failedSearches % SpinCountBeforeSleep == 0)
+				std::this_thread::yield();
+			continue;
+		}
+
+		if (m_stop.load(std::memory_order_seq_cst))
+			break;
+
+		if (++failedSearches < SpinCountBeforeSleep)
+			continue;
+
+		WaitForWork();
+		failedSearches = 0;
+	}
+
+	LocalWorker = WorkerContext{};
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] TRAP::ThreadPool::Proc* TRAP::ThreadPool::TryGetTask(const u32 index)
+{
+	if(LocalRandomState == 0) //Seed PRNG of threads not owned by the pool
+		LocalRandomState = std::hash<std::thread::id>{}(std::this_thread::get_id()) | 1u;
+
+	const u32 victimStart = static_cast<u32>(NextRandom(LocalRandomState) % m_maxThreadsCount);
+
+	for(usize priority = 0; priority < PriorityCount; ++priority)
+	{
+		Proc* task = nullptr;
+
+		if(index != ExternalThreadIndex)
+		{
+			Worker& self = *m_workers[index];
+			if(self.Deques[priority].Pop(task) || self.Inboxes[priority].TryPop(task))
 			{
-				if (m_queues[(i + n) % m_maxThreadsCount].TryPop(f))
-					break;
+				m_pendingTasks.fetch_sub(1, std::memory_order_seq_cst);
+				return task;
 			}
+		}
 
-			if (!f && !m_queues[i].Pop(f))
-				break;
+		for(u32 n = 0; n < m_maxThreadsCount; ++n)
+		{
+			const u32 victimIndex = (victimStart + n) % m_maxThreadsCount;
+			if(victimIndex == index)
+				continue;
 
-			f();
+			Worker& victim = *m_workers[victimIndex];
+			if(victim.Deques[priority].Steal(task) || victim.Inboxes[priority].TryPop(task))
+			{
+				m_pendingTasks.fetch_sub(1, std::memory_order_seq_cst);
+				return task;
+			}
 		}
-	};
+	}
 
-	for (u32 i = 0; i < m_maxThreadsCount; ++i)
-		m_threads.emplace_back(worker, i);
+	return nullptr;
 }
 
 //-------------------------------------------------------------------------------------------------------------------//
 
-TRAP::ThreadPool::~ThreadPool()
+void TRAP::ThreadPool::WaitForWork()
 {
 	ZoneNamed(__tracy, (GetTRAPProfileSystems() & ProfileSystems::ThreadPool) != ProfileSystems::None);
 
-	for (Queue& queue : m_queues)
-		queue.Done();
-}
\ No newline at end of file
+	m_sleepingWorkers.fetch_add(1, std::memory_order_seq_cst);
+	const u32 epoch = m_wakeEpoch.load(std::memory_order_seq_cst);
+
+	//Recheck after announcing that we want to sleep, a submitter which missed
+	//our announcement must have published its task before this load.
+	if(m_pendingTasks.load(std::memory_order_seq_cst) == 0 && !m_stop.load(std::memory_order_seq_cst))
+		m_wakeEpoch.wait(epoch, std::memory_order_seq_cst);
+
+	m_sleepingWorkers.fetch_sub(1, std::memory_order_seq_cst);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::ThreadPool::WakeWorker()
+{
+	if(m_sleepingWorkers.load(std::memory_order_seq_cst) == 0)
+		return;
+
+	m_wakeEpoch.fetch_add(1, std::memory_order_seq_cst);
+	m_wakeEpoch.notify_one();
+}
@@ -1,16 +1,39 @@
 #ifndef TRAP_THREADPOOL_H
 #define TRAP_THREADPOOL_H
 
+#include <array>
 #include <functional>
 #include <future>
+#include <tuple>
 #include <atomic>
+#include <limits>
+#include <memory>
 #include <thread>
 
-#include "BlockingQueue.h"
+#include "BoundedMPMCQueue.h"
+#include "MoveOnlyTask.h"
+#include "WorkStealingDeque.h"
 
 namespace TRAP
 {
-	/// @brief ThreadPool is a multi-threading task scheduler.
+	/// @brief Priority of a task enqueued to the ThreadPool.
+	///        Workers always prefer tasks with a higher priority.
+	enum class TaskPriority : u8
+	{
+		/// @brief Frame critical work.
+		High,
+		/// @brief Default priority.
+		Normal,
+		/// @brief Background work like asset streaming.
+		Low
+	};
+
+	/// @brief ThreadPool is a multi-threading work stealing task scheduler.
+	///
+	///        Every worker owns a Chase-Lev deque per priority.
+	///        Tasks enqueued from a worker are pushed to its own deque and popped in LIFO order,
+	///        tasks enqueued from other threads are distributed round-robin over the workers inbox queues.
+	///        Idle workers steal from the deques and inboxes of randomly selected victims.
 	class ThreadPool
 	{
 	public:
@@ -18,6 +41,7 @@ namespace TRAP
 		/// @param threads Max amount of threads to use for tasks.
 		explicit ThreadPool(u32 threads = (std::thread::hardware_concurrency() - 1));
 		/// @brief Destructor.
+		/// @note Waits until all enqueued tasks have finished.
 		~ThreadPool();
 
 		/// @brief Copy constructor.
@@ -38,6 +62,16 @@ namespace TRAP
 		requires std::invocable<F, Args...>
 		void EnqueueWork(F&& f, Args&&... args);
 
+		/// @brief Enqueue work with the given priority (Call given function on separate thread).
+		/// @tparam F Functor to work on.
+		/// @tparam Args Parameters of the functor.
+		/// @param priority Priority of the work.
+		/// @param f Functor to work on.
+		/// @param args Optional arguments.
+		template<typename F, typename... Args>
+		requires std::invocable<F, Args...>
+		void EnqueueWork(TaskPriority priority, F&& f, Args&&... args);
+
 		/// @brief Enqueue task (Call given function on seperate thread and get a future).
 		/// @tparam F Functor to work on.
 		/// @tparam Args Parameters of the functor.
@@ -48,19 +82,88 @@ namespace TRAP
 		requires std::invocable<F, Args...>
 		[[nodiscard]] auto EnqueueTask(F&& f, Args&&... args) -> std::future<std::invoke_result_t<F, Args...>>;
 
+		/// @brief Enqueue task with the given priority (Call given function on seperate thread and get a future).
+		/// @tparam F Functor to work on.
+		/// @tparam Args Parameters of the functor.
+		/// @param priority Priority of the task.
+		/// @param f Functor to work on.
+		/// @param args Optional arguments.
+		/// @return Future for the result of the given functor.
+		template<typename F, typename... Args>
+		requires std::invocable<F, Args...>
+		[[nodiscard]] auto EnqueueTask(TaskPriority priority, F&& f, Args&&... args) -> std::future<std::invoke_result_t<F, Args...>>;
+
+		/// @brief Retrieve the number of worker threads.
+		/// @return Number of worker threads.
+		[[nodiscard]] u32 GetThreadCount() const noexcept;
+
+		/// @brief Take a single pending task from the pool and run it on the calling thread.
+		///        Used to help the pool instead of sleeping while waiting for other tasks to finish.
+		/// @return True if a task was run, false if no task was pending.
+		/// @note Can be called from any thread, including the workers of this pool.
+		bool TryRunPendingTask();
+
 	private:
-		using Proc = std::function<void()>;
-		using Queue = BlockingQueue<Proc>;
-		using Queues = std::vector<Queue>;
-		Queues m_queues;
+		using Proc = MoveOnlyTask;
+
+		static constexpr usize PriorityCount = 3;
+		static constexpr u32 ExternalThreadIndex = std::numeric_limits<u32>::max();
+
+		/// @brief Data owned by a single worker thread.
+		struct Worker
+		{
+			std::array<WorkStealingDeque<Proc*>, PriorityCount> Deques;
+			std::array<BoundedMPMCQueue<Proc*>, PriorityCount> Inboxes;
+		};
+
+		/// @brief Store the given functor together with copies of its arguments in a callable without parameters.
+		/// @param f Functor.
+		/// @param args Arguments for the functor.
+		/// @return Callable without parameters.
+		template<typename F, typename... Args>
+		[[nodiscard]] static auto BindArguments(F&& f, Args&&... args);
 
-		using Threads = std::vector<std::jthread>;
-		Threads m_threads;
+		/// @brief Submit a task to the pool.
+		///        Pushes to the local deque when called from a worker of this pool,
+		///        otherwise to the inbox of the next worker (round-robin) which isn't full.
+		///        If all inboxes are full the call blocks until a worker made room.
+		/// @param proc Task to submit, allocated with INTERNAL::TaskAllocator. The pool takes ownership.
+		/// @param priority Priority of the task.
+		void Submit(Proc* proc, TaskPriority priority);
+
+		/// @brief Run the given task and free it.
+		/// @param proc Task to run.
+		static void RunTask(Proc* proc);
+
+		/// @brief Main loop of a worker thread.
+		/// @param index Index of the worker.
+		void WorkerLoop(u32 index);
+
+		/// @brief Try to retrieve the next task for the given worker.
+		///        Checks all priorities from high to low, for every priority the local deque,
+		///        the local inbox and then the deques and inboxes of all other workers (random start) are checked.
+		/// @param index Index of the worker or ExternalThreadIndex for threads not owned by the pool.
+		/// @return Task on success, nullptr if no task is available.
+		[[nodiscard]] Proc* TryGetTask(u32 index);
+
+		/// @brief Put the given worker to sleep until new work arrives or the pool shuts down.
+		void WaitForWork();
+
+		/// @brief Wake up a sleeping worker if there is one.
+		void WakeWorker();
+
+		std::vector<std::unique_ptr<Worker>> m_workers;
 
 		u32 m_maxThreadsCount;
 		std::atomic<u32> m_index = 0;
 
-		static constexpr u32 K = 3;
+		alignas(std::hardware_destructive_interference_size) std::atomic<u64> m_pendingTasks = 0;
+		alignas(std::hardware_destructive_interference_size) std::atomic<u32> m_sleepingWorkers = 0;
+		alignas(std::hardware_destructive_interference_size) std::atomic<u32> m_wakeEpoch = 0;
+		std::atomic<bool> m_stop = false;
+
+		using Threads = std::vector<std::jthread>;
+		Threads m_threads;
 	};
 }
 
@@ -70,21 +173,18 @@ template <typename F, typename ... Args>
 requires std::invocable<F, Args...>
 void TRAP::ThreadPool::EnqueueWork(F&& f, Args&&... args)
 {
-	ZoneNamed(__tracy, (GetTRAPProfileSystems() & ProfileSystems::Scene) != ProfileSystems::None);
+	EnqueueWork(TaskPriority::Normal, std::forward<F>(f), std::forward<Args>(args)...);
+}
 
-	auto work = [p = std::forward<F>(f), t = { std::forward<Args>(args)... }]()
-	{
-		std::apply(p, t);
-	};
-	const u32 i = m_index++;
+//-------------------------------------------------------------------------------------------------------------------//
 
-	for (u32 n = 0; n < m_maxThreadsCount * K; ++n)
-	{
-		if (m_queues[(i + n) % m_maxThreadsCount].TryPush(std::move(work)))
-			return;
-	}
+template <typename F, typename ... Args>
+requires std::invocable<F, Args...>
+void TRAP::ThreadPool::EnqueueWork(const TaskPriority priority, F&& f, Args&&... args)
+{
+	ZoneNamed(__tracy, (GetTRAPProfileSystems() & ProfileSystems::ThreadPool) != ProfileSystems::None);
 
-	m_queues[i % m_maxThreadsCount].Push(work);
+	Submit(INTERNAL::TaskAllocator::New<Proc>(BindArguments(std::forward<F>(f), std::forward<Args>(args)...)), priority);
 }
 
 //-------------------------------------------------------------------------------------------------------------------//
@@ -93,29 +193,60 @@ template <typename F, typename ... Args>
 requires std::invocable<F, Args...>
 [[nodiscard]] auto TRAP::ThreadPool::EnqueueTask(F&& f, Args&&... args) -> std::future<std::invoke_result_t<F, Args...>>
 {
-	ZoneNamed(__tracy, (GetTRAPProfileSystems() & ProfileSystems::Scene) != ProfileSystems::None);
+	return EnqueueTask(TaskPriority::Normal, std::forward<F>(f), std::forward<Args>(args)...);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template <typename F, typename ... Args>
+requires std::invocable<F, Args...>
+[[nodiscard]] auto TRAP::ThreadPool::EnqueueTask(const TaskPriority priority, F&& f, Args&&... args) -> std::future<std::invoke_result_t<F, Args...>>
+{
+	ZoneNamed(__tracy, (GetTRAPProfileSystems() & ProfileSystems::ThreadPool) != ProfileSystems::None);
 
 	using TaskReturnType = std::invoke_result_t<F, Args...>;
-	using TaskType = std::packaged_task<TaskReturnType()>;
 
-	const auto task = std::make_shared<TaskType>(std::bind(std::forward<F>(f), std::forward<Args>(args)...));
-	const std::future<TaskReturnType> result = task->get_future();
+	//Shared state of the promise/future pair gets recycled by the TaskAllocator
+	std::promise<TaskReturnType> promise(std::allocator_arg, INTERNAL::TaskStdAllocator<u8>{});
+	std::future<TaskReturnType> result = promise.get_future();
 
-	auto work = [task]()
+	auto work = [promise = std::move(promise), func = BindArguments(std::forward<F>(f), std::forward<Args>(args)...)]() mutable
 	{
-		(*task)();
+		try
+		{
+			if constexpr(std::is_void_v<TaskReturnType>)
+			{
+				std::invoke(func);
+				promise.set_value();
+			}
+			else
+				promise.set_value(std::invoke(func));
+		}
+		catch(...)
+		{
+			promise.set_exception(std::current_exception());
+		}
 	};
-	const u32 i = m_index++;
 
-	for (u32 n = 0; n < m_maxThreadsCount * K; ++n)
-	{
-		if (m_queues[(i + n) % m_maxThreadsCount].TryPush(work))
-			return result;
-	}
-
-	m_queues[i % m_maxThreadsCount].Push(std::move(work));
+	Submit(INTERNAL::TaskAllocator::New<Proc>(std::move(work)), priority);
 
 	return result;
 }
 
-#endif /*TRAP_THREADPOOL_H*/
\ No newline at end of file
+//-------------------------------------------------------------------------------------------------------------------//
+
+template <typename F, typename ... Args>
+[[nodiscard]] auto TRAP::ThreadPool::BindArguments(F&& f, Args&&... args)
+{
+	if constexpr(sizeof...(Args) == 0)
+		return std::decay_t<F>(std::forward<F>(f));
+	else
+	{
+		return [func = std::forward<F>(f), arguments = std::make_tuple(std::forward<Args>(args)...)]() mutable
+		{
+			return std::apply(func, arguments);
+		};
+	}
+}
+
+#endif /*TRAP_THREADPOOL_H*/
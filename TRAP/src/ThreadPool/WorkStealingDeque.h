@@ -0,0 +1,294 @@
+#ifndef TRAP_WORKSTEALINGDEQUE_H
+#define TRAP_WORKSTEALINGDEQUE_H
+
+#include <atomic>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include "Core/Base.h"
+#include "Core/Types.h"
+
+namespace TRAP
+{
+	/// @brief Lock-free Chase-Lev work stealing deque.
+	///        The owning thread pushes and pops items at the bottom (LIFO),
+	///        all other threads steal items from the top (FIFO).
+	///        Based on "Correct and Efficient Work-Stealing for Weak Memory Models" by Lê, Pop, Cohen and Nardelli.
+	/// @tparam T Trivially copyable item type (usually a pointer to the actual work item).
+	/// @threadsafety Push() and Pop() must only be called by the owning thread, Steal() is thread safe.
+	template<typename T>
+	requires std::is_trivially_copyable_v<T>
+	class WorkStealingDeque
+	{
+	public:
+		/// @brief Constructor.
+		/// @param capacity Initial capacity, must be a power of two.
+		explicit WorkStealingDeque(i64 capacity = 1024);
+		/// @brief Destructor.
+		~WorkStealingDeque();
+
+		/// @brief Copy constructor.
+		consteval WorkStealingDeque(const WorkStealingDeque&) = delete;
+		/// @brief Copy assignment operator.
+		consteval WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+		/// @brief Move constructor.
+		consteval WorkStealingDeque(WorkStealingDeque&&) noexcept = delete;
+		/// @brief Move assignment operator.
+		consteval WorkStealingDeque& operator=(WorkStealingDeque&&) noexcept = delete;
+
+		/// @brief Push an item to the bottom of the deque.
+		///        Grows the deque if it is full.
+		/// @param item Item to push.
+		/// @threadsafety This function must only be called by the owning thread.
+		void Push(T item);
+
+		/// @brief Pop the most recently pushed item from the bottom of the deque.
+		/// @param item Output for the popped item.
+		/// @return True on success, false if the deque was empty.
+		/// @threadsafety This function must only be called by the owning thread.
+		[[nodiscard]] bool Pop(T& item);
+
+		/// @brief Steal the oldest item from the top of the deque.
+		/// @param item Output for the stolen item.
+		/// @return True on success, false if the deque was empty or another thread won the race for the item.
+		/// @threadsafety This function is thread safe.
+		[[nodiscard]] bool Steal(T& item);
+
+		/// @brief Check if the deque is empty.
+		/// @return True if deque is empty, false otherwise.
+		/// @note The result is only a snapshot and may be outdated immediately.
+		[[nodiscard]] bool Empty() const noexcept;
+
+		/// @brief Retrieve the number of items in the deque.
+		/// @return Number of items.
+		/// @note The result is only a snapshot and may be outdated immediately.
+		[[nodiscard]] usize Size() const noexcept;
+
+		/// @brief Retrieve the current capacity of the deque.
+		/// @return Capacity.
+		[[nodiscard]] i64 Capacity() const noexcept;
+
+	private:
+		/// @brief Circular array holding the items of the deque.
+		class RingBuffer
+		{
+		public:
+			/// @brief Constructor.
+			/// @param capacity Capacity, must be a power of two.
+			explicit RingBuffer(i64 capacity);
+
+			/// @brief Retrieve the capacity of the buffer.
+			/// @return Capacity.
+			[[nodiscard]] i64 Capacity() const noexcept;
+
+			/// @brief Store an item at the given logical index.
+			/// @param index Logical index.
+			/// @param item Item to store.
+			void Store(i64 index, T item) noexcept;
+
+			/// @brief Load an item from the given logical index.
+			/// @param index Logical index.
+			/// @return Loaded item.
+			[[nodiscard]] T Load(i64 index) const noexcept;
+
+			/// @brief Create a buffer with twice the capacity containing all items in [top, bottom).
+			/// @param top Logical top index.
+			/// @param bottom Logical bottom index.
+			/// @return Grown buffer.
+			[[nodiscard]] std::unique_ptr<RingBuffer> Grow(i64 top, i64 bottom) const;
+
+		private:
+			i64 m_capacity;
+			i64 m_mask;
+			std::unique_ptr<std::atomic<T>[]> m_data;
+		};
+
+		alignas(std::hardware_destructive_interference_size) std::atomic<i64> m_top = 0;
+		alignas(std::hardware_destructive_interference_size) std::atomic<i64> m_bottom = 0;
+		alignas(std::hardware_destructive_interference_size) std::atomic<RingBuffer*> m_buffer;
+
+		//Owns the current and all previous buffers.
+		//Previous buffers are kept alive because concurrent thieves may still read from them.
+		std::vector<std::unique_ptr<RingBuffer>> m_buffers{};
+	};
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename T>
+requires std::is_trivially_copyable_v<T>
+TRAP::WorkStealingDeque<T>::WorkStealingDeque(const i64 capacity)
+{
+	TRAP_ASSERT(capacity > 0 && (capacity & (capacity - 1)) == 0, "WorkStealingDeque::WorkStealingDeque(): Capacity must be a power of two!");
+
+	m_buffers.emplace_back(std::make_unique<RingBuffer>(capacity));
+	m_buffer.store(m_buffers.back().get(), std::memory_order_relaxed);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename T>
+requires std::is_trivially_copyable_v<T>
+TRAP::WorkStealingDeque<T>::~WorkStealingDeque() = default;
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename T>
+requires std::is_trivially_copyable_v<T>
+void TRAP::WorkStealingDeque<T>::Push(const T item)
+{
+	const i64 bottom = m_bottom.load(std::memory_order_relaxed);
+	const i64 top = m_top.load(std::memory_order_acquire);
+	RingBuffer* buffer = m_buffer.load(std::memory_order_relaxed);
+
+	if(bottom - top > buffer->Capacity() - 1)
+	{
+		m_buffers.emplace_back(buffer->Grow(top, bottom));
+		buffer = m_buffers.back().get();
+		m_buffer.store(buffer, std::memory_order_release);
+	}
+
+	buffer->Store(bottom, item);
+	std::atomic_thread_fence(std::memory_order_release);
+	m_bottom.store(bottom + 1, std::memory_order_relaxed);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename T>
+requires std::is_trivially_copyable_v<T>
+[[nodiscard]] bool TRAP::WorkStealingDeque<T>::Pop(T& item)
+{
+	const i64 bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+	const RingBuffer* const buffer = m_buffer.load(std::memory_order_relaxed);
+	m_bottom.store(bottom, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	i64 top = m_top.load(std::memory_order_relaxed);
+
+	if(top > bottom) //Deque is empty
+	{
+		m_bottom.store(bottom + 1, std::memory_order_relaxed);
+		return false;
+	}
+
+	item = buffer->Load(bottom);
+
+	if(top == bottom) //Last item, race against thieves
+	{
+		const bool won = m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+		m_bottom.store(bottom + 1, std::memory_order_relaxed);
+		return won;
+	}
+
+	return true;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename T>
+requires std::is_trivially_copyable_v<T>
+[[nodiscard]] bool TRAP::WorkStealingDeque<T>::Steal(T& item)
+{
+	i64 top = m_top.load(std::memory_order_acquire);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	const i64 bottom = m_bottom.load(std::memory_order_acquire);
+
+	if(top >= bottom) //Deque is empty
+		return false;
+
+	const RingBuffer* const buffer = m_buffer.load(std::memory_order_acquire);
+	const T stolen = buffer->Load(top);
+
+	if(!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+		return false; //Lost the race against the owner or another thief
+
+	item = stolen;
+	return true;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename T>
+requires std::is_trivially_copyable_v<T>
+[[nodiscard]] bool TRAP::WorkStealingDeque<T>::Empty() const noexcept
+{
+	return Size() == 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename T>
+requires std::is_trivially_copyable_v<T>
+[[nodiscard]] usize TRAP::WorkStealingDeque<T>::Size() const noexcept
+{
+	const i64 bottom = m_bottom.load(std::memory_order_relaxed);
+	const i64 top = m_top.load(std::memory_order_relaxed);
+
+	return bottom >= top ? static_cast<usize>(bottom - top) : 0u;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename T>
+requires std::is_trivially_copyable_v<T>
+[[nodiscard]] i64 TRAP::WorkStealingDeque<T>::Capacity() const noexcept
+{
+	return m_buffer.load(std::memory_order_relaxed)->Capacity();
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename T>
+requires std::is_trivially_copyable_v<T>
+TRAP::WorkStealingDeque<T>::RingBuffer::RingBuffer(const i64 capacity)
+	: m_capacity(capacity), m_mask(capacity - 1), m_data(std::make_unique<std::atomic<T>[]>(static_cast<usize>(capacity)))
+{
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename T>
+requires std::is_trivially_copyable_v<T>
+[[nodiscard]] i64 TRAP::WorkStealingDeque<T>::RingBuffer::Capacity() const noexcept
+{
+	return m_capacity;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename T>
+requires std::is_trivially_copyable_v<T>
+void TRAP::WorkStealingDeque<T>::RingBuffer::Store(const i64 index, const T item) noexcept
+{
+	m_data[static_cast<usize>(index & m_mask)].store(item, std::memory_order_relaxed);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename T>
+requires std::is_trivially_copyable_v<T>
+[[nodiscard]] T TRAP::WorkStealingDeque<T>::RingBuffer::Load(const i64 index) const noexcept
+{
+	return m_data[static_cast<usize>(index & m_mask)].load(std::memory_order_relaxed);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename T>
+requires std::is_trivially_copyable_v<T>
+[[nodiscard]] std::unique_ptr<typename TRAP::WorkStealingDeque<T>::RingBuffer> TRAP::WorkStealingDeque<T>::RingBuffer::Grow(const i64 top,
+                                                                                                                            const i64 bottom) const
+{
+	auto grown = std::make_unique<RingBuffer>(m_capacity * 2);
+
+	for(i64 i = top; i != bottom; ++i)
+		grown->Store(i, Load(i));
+
+	return grown;
+}
+
+#endif /*TRAP_WORKSTEALINGDEQUE_H*/
@@ -0,0 +1,347 @@
+#ifndef TRAP_BYTEREADER_H
+#define TRAP_BYTEREADER_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <span>
+#include <string_view>
+#include <type_traits>
+
+#include "Core/Types.h"
+#include "Utils/Optional.h"
+
+namespace TRAP::Utils
+{
+	/// @brief Sequential reader over a span of bytes.
+	///
+	///        Used by decoders to parse directly from memory (i.e. a mapped file) instead of a stream.
+	///        Like a stream the reader remembers whether any read failed, so a sequence of reads
+	///        can be checked once via HasFailed().
+	///        A failed read moves the read position to the end of the data.
+	/// @note The reader doesn't own the data, the data must outlive the reader.
+	class ByteReader
+	{
+	public:
+		/// @brief Constructor.
+		/// @param data Data to read from.
+		constexpr explicit ByteReader(std::span<const u8> data) noexcept;
+
+		/// @brief Retrieve the size of the data.
+		/// @return Size in bytes.
+		[[nodiscard]] constexpr usize GetSize() const noexcept;
+		/// @brief Retrieve the current read position.
+		/// @return Read position in bytes from the start of the data.
+		[[nodiscard]] constexpr usize GetPosition() const noexcept;
+		/// @brief Retrieve the amount of bytes left to read.
+		/// @return Remaining bytes.
+		[[nodiscard]] constexpr usize GetRemainingSize() const noexcept;
+		/// @brief Retrieve the data that is left to read.
+		/// @return Remaining data.
+		[[nodiscard]] constexpr std::span<const u8> GetRemainingData() const noexcept;
+		/// @brief Retrieve whether the end of the data was reached.
+		/// @return True if there is nothing left to read, false otherwise.
+		[[nodiscard]] constexpr bool IsEOF() const noexcept;
+		/// @brief Retrieve whether any read, skip or seek failed so far.
+		/// @return True if an operation failed, false otherwise.
+		[[nodiscard]] constexpr bool HasFailed() const noexcept;
+
+		/// @brief Move the read position to the given position.
+		/// @param position Position in bytes from the start of the data.
+		/// @return True on success, false if position is past the end of the data.
+		constexpr bool Seek(usize position) noexcept;
+		/// @brief Skip the given amount of bytes.
+		/// @param count Amount of bytes to skip.
+		/// @return True on success, false if there are not enough bytes left.
+		constexpr bool Skip(usize count) noexcept;
+
+		/// @brief Copy bytes into the given destination.
+		/// @param destination Destination, is filled completely.
+		/// @return True on success, false if there are not enough bytes left.
+		constexpr bool Read(std::span<u8> destination) noexcept;
+		/// @brief Read a value in its in-memory representation (i.e. without byte order conversion).
+		/// @tparam T Trivially copyable type.
+		/// @param value Output for the read value.
+		/// @return True on success, false if there are not enough bytes left.
+		template<typename T>
+		requires std::is_trivially_copyable_v<T>
+		constexpr bool Read(T& value) noexcept;
+		/// @brief Read a single byte.
+		/// @return Read byte, 0 if there is nothing left to read.
+		[[nodiscard]] constexpr u8 ReadByte() noexcept;
+		/// @brief Read the given amount of bytes without copying them.
+		/// @param count Amount of bytes to read.
+		/// @return View of the read bytes on success, empty optional if there are not enough bytes left.
+		[[nodiscard]] constexpr TRAP::Optional<std::span<const u8>> ReadSpan(usize count) noexcept;
+		/// @brief Retrieve the next byte without consuming it.
+		/// @return Next byte, empty optional if there is nothing left to read.
+		[[nodiscard]] constexpr TRAP::Optional<u8> Peek() const noexcept;
+
+		/// @brief Read the next whitespace separated token, like operator>> on a stream does for strings.
+		/// @return Read token, empty if there is nothing left to read.
+		[[nodiscard]] std::string_view ReadToken() noexcept;
+		/// @brief Read the next whitespace separated number, like operator>> on a stream does for numbers.
+		/// @tparam T Integral or floating point type.
+		/// @param value Output for the read number.
+		/// @return True on success, false if the next token is not a valid number of type T.
+		template<typename T>
+		requires std::integral<T> || std::floating_point<T>
+		bool ReadNumber(T& value) noexcept;
+		/// @brief Read the next line, like std::getline() does.
+		/// @return Line without the trailing '\n', empty optional if there is nothing left to read.
+		[[nodiscard]] TRAP::Optional<std::string_view> ReadLine() noexcept;
+		/// @brief Skip everything up to and including the next '\n'.
+		constexpr void SkipLine() noexcept;
+
+	private:
+		/// @brief Mark the reader as failed and move to the end of the data.
+		constexpr void Fail() noexcept;
+
+		/// @brief Skip whitespace characters.
+		constexpr void SkipWhitespace() noexcept;
+
+		/// @brief Retrieve whether the given byte is a whitespace character.
+		/// @param c Byte to check.
+		/// @return True if c is a whitespace character, false otherwise.
+		[[nodiscard]] static constexpr bool IsWhitespace(u8 c) noexcept;
+
+		std::span<const u8> m_data;
+		usize m_position = 0;
+		bool m_failed = false;
+	};
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+constexpr TRAP::Utils::ByteReader::ByteReader(const std::span<const u8> data) noexcept
+	: m_data(data)
+{
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] constexpr usize TRAP::Utils::ByteReader::GetSize() const noexcept
+{
+	return m_data.size();
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] constexpr usize TRAP::Utils::ByteReader::GetPosition() const noexcept
+{
+	return m_position;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] constexpr usize TRAP::Utils::ByteReader::GetRemainingSize() const noexcept
+{
+	return m_data.size() - m_position;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] constexpr std::span<const u8> TRAP::Utils::ByteReader::GetRemainingData() const noexcept
+{
+	return m_data.subspan(m_position);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] constexpr bool TRAP::Utils::ByteReader::IsEOF() const noexcept
+{
+	return m_position == m_data.size();
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] constexpr bool TRAP::Utils::ByteReader::HasFailed() const noexcept
+{
+	return m_failed;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+constexpr bool TRAP::Utils::ByteReader::Seek(const usize position) noexcept
+{
+	if(position > m_data.size())
+	{
+		Fail();
+		return false;
+	}
+
+	m_position = position;
+	return true;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+constexpr bool TRAP::Utils::ByteReader::Skip(const usize count) noexcept
+{
+	if(count > GetRemainingSize())
+	{
+		Fail();
+		return false;
+	}
+
+	m_position += count;
+	return true;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+constexpr bool TRAP::Utils::ByteReader::Read(const std::span<u8> destination) noexcept
+{
+	if(destination.size() > GetRemainingSize())
+	{
+		Fail();
+		return false;
+	}
+
+	std::copy_n(m_data.begin() + static_cast<isize>(m_position), destination.size(), destination.begin());
+	m_position += destination.size();
+	return true;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename T>
+requires std::is_trivially_copyable_v<T>
+constexpr bool TRAP::Utils::ByteReader::Read(T& value) noexcept
+{
+	std::array<u8, sizeof(T)> bytes{};
+	if(!Read(std::span<u8>(bytes)))
+		return false;
+
+	value = std::bit_cast<T>(bytes);
+	return true;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] constexpr u8 TRAP::Utils::ByteReader::ReadByte() noexcept
+{
+	if(IsEOF())
+	{
+		Fail();
+		return 0;
+	}
+
+	return m_data[m_position++];
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] constexpr TRAP::Optional<std::span<const u8>> TRAP::Utils::ByteReader::ReadSpan(const usize count) noexcept
+{
+	if(count > GetRemainingSize())
+	{
+		Fail();
+		return TRAP::NullOpt;
+	}
+
+	const std::span<const u8> result = m_data.subspan(m_position, count);
+	m_position += count;
+	return result;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] constexpr TRAP::Optional<u8> TRAP::Utils::ByteReader::Peek() const noexcept
+{
+	if(IsEOF())
+		return TRAP::NullOpt;
+
+	return m_data[m_position];
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] inline std::string_view TRAP::Utils::ByteReader::ReadToken() noexcept
+{
+	SkipWhitespace();
+
+	const usize start = m_position;
+	while(!IsEOF() && !IsWhitespace(m_data[m_position]))
+		++m_position;
+
+	if(start == m_position)
+		m_failed = true;
+
+	return std::string_view(reinterpret_cast<const char*>(m_data.data()) + start, m_position - start);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<typename T>
+requires std::integral<T> || std::floating_point<T>
+bool TRAP::Utils::ByteReader::ReadNumber(T& value) noexcept
+{
+	const std::string_view token = ReadToken();
+
+	const auto [end, ec] = std::from_chars(token.data(), token.data() + token.size(), value);
+	if(ec != std::errc{} || end != token.data() + token.size())
+	{
+		m_failed = true;
+		return false;
+	}
+
+	return true;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] inline TRAP::Optional<std::string_view> TRAP::Utils::ByteReader::ReadLine() noexcept
+{
+	if(IsEOF())
+	{
+		Fail();
+		return TRAP::NullOpt;
+	}
+
+	const usize start = m_position;
+	while(!IsEOF() && m_data[m_position] != '\n')
+		++m_position;
+
+	const std::string_view line(reinterpret_cast<const char*>(m_data.data()) + start, m_position - start);
+
+	if(!IsEOF())
+		++m_position; //Skip '\n'
+
+	return line;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+constexpr void TRAP::Utils::ByteReader::SkipLine() noexcept
+{
+	while(!IsEOF() && m_data[m_position++] != '\n')
+	{
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+constexpr void TRAP::Utils::ByteReader::Fail() noexcept
+{
+	m_position = m_data.size();
+	m_failed = true;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+constexpr void TRAP::Utils::ByteReader::SkipWhitespace() noexcept
+{
+	while(!IsEOF() && IsWhitespace(m_data[m_position]))
+		++m_position;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] constexpr bool TRAP::Utils::ByteReader::IsWhitespace(const u8 c) noexcept
+{
+	return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+
+#endif /*TRAP_BYTEREADER_H*/
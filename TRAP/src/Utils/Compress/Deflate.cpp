@@ -0,0 +1,837 @@
+#include "TRAPPCH.h"
+#include "Deflate.h"
+
+#include "Utils/Hash/Adler32.h"
+
+namespace
+{
+	constexpr usize WindowSize = 32768u;
+	constexpr usize MinMatchLength = 4u; //Matches are found via a hash of 4 bytes
+	constexpr usize MaxMatchLength = 258u;
+	constexpr usize MaxStoredBlockSize = 65535u;
+	/// @brief Amount of LZ77 tokens collected before a block is emitted.
+	constexpr usize MaxBlockTokens = 1u << 16u;
+
+	constexpr u32 HashBits = 15u;
+	constexpr usize NoPosition = std::numeric_limits<usize>::max();
+
+	constexpr u32 MaxCodeLength = 15u;
+	constexpr u32 MaxCodeLengthCodeLength = 7u;
+	constexpr u32 LiteralLengthSymbolCount = 286u;
+	constexpr u32 DistanceSymbolCount = 30u;
+	constexpr u32 CodeLengthSymbolCount = 19u;
+	constexpr u32 EndOfBlockSymbol = 256u;
+
+	/// @brief Order in which the code length code lengths are stored in a dynamic block header.
+	constexpr std::array<u32, CodeLengthSymbolCount> CodeLengthCodeOrder
+	{
+		16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+	};
+
+	/// @brief Parameters of the LZ77 matcher for a compression level.
+	struct MatchParameters
+	{
+		/// @brief Maximum amount of candidates checked per position.
+		u32 MaxChainLength;
+		/// @brief Matches of at least this length end the search immediately.
+		usize NiceLength;
+		/// @brief Whether to check if the next position has a longer match before emitting a match.
+		bool LazyMatching;
+		/// @brief Whether positions inside of matches are added to the hash table.
+		bool InsertMatchPositions;
+	};
+
+	constexpr MatchParameters FastestParameters{1u, 32u, false, false};
+	constexpr MatchParameters FastParameters{32u, 128u, true, true};
+
+	/// @brief LZ77 token, either a literal or a match.
+	struct Token
+	{
+		/// @brief Literal byte or match length.
+		u16 LiteralLength;
+		/// @brief Match distance, 0 for literals.
+		u16 Distance;
+	};
+
+	/// @brief Huffman code, bits are stored reversed so they can be written LSB first.
+	struct HuffmanCode
+	{
+		u16 Code;
+		u8 Length;
+	};
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Writes bits LSB first, like Deflate expects them.
+	class BitWriter
+	{
+	public:
+		/// @brief Constructor.
+		/// @param out Output to append to.
+		constexpr explicit BitWriter(std::vector<u8>& out) noexcept
+			: m_out(out)
+		{
+		}
+
+		/// @brief Write the given amount of bits.
+		/// @param bits Bits to write.
+		/// @param count Amount of bits to write, at most 32.
+		constexpr void Write(const u32 bits, const u32 count)
+		{
+			m_buffer |= NumericCast<u64>(bits) << m_bitCount;
+			m_bitCount += count;
+
+			//Flush 32 bits at once
+			if(m_bitCount >= 32u)
+			{
+				const u32 flushed = static_cast<u32>(m_buffer);
+				m_out.insert(m_out.end(), {static_cast<u8>(flushed), static_cast<u8>(flushed >> 8u),
+				                           static_cast<u8>(flushed >> 16u), static_cast<u8>(flushed >> 24u)});
+				m_buffer >>= 32u;
+				m_bitCount -= 32u;
+			}
+		}
+
+		/// @brief Write a huffman code.
+		/// @param code Code to write.
+		constexpr void Write(const HuffmanCode& code)
+		{
+			Write(code.Code, code.Length);
+		}
+
+		/// @brief Pad the output with zero bits up to the next byte boundary.
+		constexpr void AlignToByte()
+		{
+			for(; m_bitCount > 0u; m_bitCount -= std::min(m_bitCount, 8u))
+			{
+				m_out.push_back(static_cast<u8>(m_buffer));
+				m_buffer >>= 8u;
+			}
+		}
+
+		/// @brief Write bytes, the output must be byte aligned.
+		/// @param data Bytes to write.
+		void WriteBytes(const std::span<const u8> data)
+		{
+			m_out.insert(m_out.end(), data.begin(), data.end());
+		}
+
+	private:
+		std::vector<u8>& m_out;
+		u64 m_buffer = 0u;
+		u32 m_bitCount = 0u;
+	};
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Retrieve the literal/length symbol, extra bit count and extra bits for a match length.
+	/// @param length Match length in [3, 258].
+	/// @param outExtraBitCount Output for the amount of extra bits.
+	/// @param outExtraBits Output for the extra bits.
+	/// @return Literal/length symbol.
+	[[nodiscard]] constexpr u32 GetLengthSymbol(const u32 length, u32& outExtraBitCount, u32& outExtraBits) noexcept
+	{
+		const u32 x = length - 3u;
+		outExtraBitCount = 0u;
+		outExtraBits = 0u;
+
+		if(x < 8u)
+			return 257u + x;
+		if(x == 255u)
+			return 285u;
+
+		const u32 bits = static_cast<u32>(std::bit_width(x)) - 1u;
+		outExtraBitCount = bits - 2u;
+		outExtraBits = x & ((1u << outExtraBitCount) - 1u);
+		return 257u + 4u * (bits - 1u) + ((x >> outExtraBitCount) & 3u);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Retrieve the distance symbol, extra bit count and extra bits for a match distance.
+	/// @param distance Match distance in [1, 32768].
+	/// @param outExtraBitCount Output for the amount of extra bits.
+	/// @param outExtraBits Output for the extra bits.
+	/// @return Distance symbol.
+	[[nodiscard]] constexpr u32 GetDistanceSymbol(const u32 distance, u32& outExtraBitCount, u32& outExtraBits) noexcept
+	{
+		const u32 x = distance - 1u;
+		outExtraBitCount = 0u;
+		outExtraBits = 0u;
+
+		if(x < 4u)
+			return x;
+
+		const u32 bits = static_cast<u32>(std::bit_width(x)) - 1u;
+		outExtraBitCount = bits - 1u;
+		outExtraBits = x & ((1u << outExtraBitCount) - 1u);
+		return 2u * bits + ((x >> outExtraBitCount) & 1u);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Compute length limited huffman code lengths for the given symbol frequencies.
+	///        Uses the in-place algorithm of Moffat and Katajainen, lengths exceeding the limit are
+	///        redistributed afterwards so the code stays complete.
+	///        At least 2 symbols always get a code, so the code is complete even for a single used symbol.
+	/// @param frequencies Frequency of every symbol.
+	/// @param maxLength Maximum code length.
+	/// @param outLengths Output for the code length of every symbol.
+	void ComputeCodeLengths(const std::span<const u32> frequencies, const u32 maxLength, const std::span<u8> outLengths)
+	{
+		std::ranges::fill(outLengths, u8(0));
+
+		struct SymbolFrequency
+		{
+			u32 Frequency;
+			u32 Symbol;
+		};
+
+		std::vector<SymbolFrequency> symbols{};
+		symbols.reserve(frequencies.size());
+		for(u32 i = 0; i < frequencies.size(); ++i)
+		{
+			if(frequencies[i] != 0u)
+				symbols.push_back({frequencies[i], i});
+		}
+
+		//Pad with unused symbols so there are at least 2 codes
+		for(u32 i = 0; symbols.size() < 2u; ++i)
+		{
+			if(std::ranges::none_of(symbols, [i](const SymbolFrequency& s){ return s.Symbol == i; }))
+				symbols.push_back({1u, i});
+		}
+
+		std::ranges::sort(symbols, [](const SymbolFrequency& lhs, const SymbolFrequency& rhs)
+		{
+			return lhs.Frequency < rhs.Frequency || (lhs.Frequency == rhs.Frequency && lhs.Symbol < rhs.Symbol);
+		});
+
+		//Moffat-Katajainen, A[i] becomes the code length of the i-th least frequent symbol
+		const usize n = symbols.size();
+		std::vector<usize> a(n);
+		for(usize i = 0; i < n; ++i)
+			a[i] = symbols[i].Frequency;
+
+		a[0] += a[1];
+		usize root = 0;
+		usize leaf = 2;
+		for(usize next = 1; next < n - 1u; ++next)
+		{
+			if(leaf >= n || a[root] < a[leaf])
+			{
+				a[next] = a[root];
+				a[root++] = next;
+			}
+			else
+				a[next] = a[leaf++];
+
+			if(leaf >= n || (root < next && a[root] < a[leaf]))
+			{
+				a[next] += a[root];
+				a[root++] = next;
+			}
+			else
+				a[next] += a[leaf++];
+		}
+
+		a[n - 2u] = 0;
+		for(usize next = n - 2u; next-- > 0u;)
+			a[next] = a[a[next]] + 1u;
+
+		isize rootIndex = NumericCast<isize>(n) - 2;
+		usize nextIndex = n - 1u;
+		usize available = 1;
+		usize depth = 0;
+		while(available > 0u)
+		{
+			usize used = 0;
+			while(rootIndex >= 0 && a[NumericCast<usize>(rootIndex)] == depth)
+			{
+				++used;
+				--rootIndex;
+			}
+			while(available > used)
+			{
+				a[nextIndex--] = depth;
+				--available;
+			}
+			available = 2u * used;
+			++depth;
+		}
+
+		//Count codes per length, lengths above the limit are clamped
+		std::array<u32, 64> lengthCounts{};
+		for(const usize length : a)
+			++lengthCounts[std::min<usize>(length, lengthCounts.size() - 1u)];
+		for(usize length = maxLength + 1u; length < lengthCounts.size(); ++length)
+		{
+			lengthCounts[maxLength] += lengthCounts[length];
+			lengthCounts[length] = 0;
+		}
+
+		//Restore the Kraft equality by moving leaves down the tree
+		u64 kraftSum = 0;
+		for(u32 length = 1; length <= maxLength; ++length)
+			kraftSum += NumericCast<u64>(lengthCounts[length]) << (maxLength - length);
+		while(kraftSum > (1ull << maxLength))
+		{
+			--lengthCounts[maxLength];
+			for(u32 length = maxLength - 1u; length > 0u; --length)
+			{
+				if(lengthCounts[length] != 0u)
+				{
+					--lengthCounts[length];
+					lengthCounts[length + 1u] += 2u;
+					break;
+				}
+			}
+			--kraftSum;
+		}
+
+		//Least frequent symbols get the longest codes
+		usize symbolIndex = 0;
+		for(u32 length = maxLength; length > 0u; --length)
+		{
+			for(u32 i = 0; i < lengthCounts[length]; ++i)
+				outLengths[symbols[symbolIndex++].Symbol] = NumericCast<u8>(length);
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Create canonical huffman codes from code lengths.
+	/// @param lengths Code length of every symbol.
+	/// @param outCodes Output for the code of every symbol.
+	constexpr void ComputeCodes(const std::span<const u8> lengths, const std::span<HuffmanCode> outCodes) noexcept
+	{
+		std::array<u32, MaxCodeLength + 1u> lengthCounts{};
+		for(const u8 length : lengths)
+			++lengthCounts[length];
+		lengthCounts[0] = 0;
+
+		std::array<u32, MaxCodeLength + 2u> nextCode{};
+		u32 code = 0;
+		for(u32 length = 1; length <= MaxCodeLength; ++length)
+		{
+			code = (code + lengthCounts[length - 1u]) << 1u;
+			nextCode[length] = code;
+		}
+
+		for(usize i = 0; i < lengths.size(); ++i)
+		{
+			const u32 length = lengths[i];
+			if(length == 0u)
+			{
+				outCodes[i] = {};
+				continue;
+			}
+
+			//Reverse the code so it can be written LSB first
+			const u32 c = nextCode[length]++;
+			u32 reversed = 0;
+			for(u32 bit = 0; bit < length; ++bit)
+				reversed |= ((c >> bit) & 1u) << (length - 1u - bit);
+
+			outCodes[i] = {NumericCast<u16>(reversed), NumericCast<u8>(length)};
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Retrieve the amount of equal bytes at the start of a and b.
+	/// @param a First position.
+	/// @param b Second position.
+	/// @param maxLength Maximum amount of bytes to compare.
+	/// @return Amount of equal bytes.
+	[[nodiscard]] inline usize GetMatchLength(const u8* const a, const u8* const b, const usize maxLength) noexcept
+	{
+		usize length = 0;
+		while(length + 8u <= maxLength)
+		{
+			u64 x = 0;
+			u64 y = 0;
+			std::memcpy(&x, a + length, sizeof(u64));
+			std::memcpy(&y, b + length, sizeof(u64));
+			if(x != y)
+				return length + NumericCast<usize>(std::countr_zero(x ^ y) / 8);
+			length += 8u;
+		}
+
+		while(length < maxLength && a[length] == b[length])
+			++length;
+
+		return length;
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Hash the 4 bytes at the given position.
+	/// @param data Position to hash.
+	/// @return Hash.
+	[[nodiscard]] inline u32 Hash4(const u8* const data) noexcept
+	{
+		u32 value = 0;
+		std::memcpy(&value, data, sizeof(u32));
+		return (value * 2654435761u) >> (32u - HashBits);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief LZ77 matcher using a hash table with chains over the last WindowSize positions.
+	class Matcher
+	{
+	public:
+		/// @brief Constructor.
+		/// @param data Data to find matches in.
+		/// @param parameters Matcher parameters.
+		Matcher(const std::span<const u8> data, const MatchParameters& parameters)
+			: m_data(data), m_parameters(parameters), m_head(1u << HashBits, NoPosition),
+			  m_chain(parameters.MaxChainLength > 1u ? WindowSize : 0u, NoPosition)
+		{
+		}
+
+		/// @brief Add the given position to the hash table.
+		/// @param position Position to add, must have at least MinMatchLength bytes left.
+		void Insert(const usize position)
+		{
+			Insert(position, Hash4(m_data.data() + position));
+		}
+
+		/// @brief Add the given position to the hash table.
+		/// @param position Position to add.
+		/// @param hash Hash of the position.
+		void Insert(const usize position, const u32 hash)
+		{
+			if(!m_chain.empty())
+				m_chain[position % WindowSize] = m_head[hash];
+			m_head[hash] = position;
+		}
+
+		/// @brief Find the longest match for the given position and add the position to the hash table.
+		/// @param position Position to find a match for.
+		/// @param outDistance Output for the match distance.
+		/// @return Match length, 0 if no match of at least MinMatchLength bytes was found.
+		[[nodiscard]] usize FindMatch(const usize position, usize& outDistance)
+		{
+			const usize remaining = m_data.size() - position;
+			if(remaining < MinMatchLength)
+				return 0;
+
+			const usize maxLength = std::min(remaining, MaxMatchLength);
+			const u8* const current = m_data.data() + position;
+
+			const u32 hash = Hash4(current);
+			usize candidate = m_head[hash];
+			usize bestLength = 0;
+			for(u32 chain = 0; chain < m_parameters.MaxChainLength && candidate != NoPosition; ++chain)
+			{
+				if(candidate >= position || position - candidate > WindowSize)
+					break;
+
+				//Only compare in full if the candidate could be longer than the current best
+				const u8* const match = m_data.data() + candidate;
+				if(match[bestLength] == current[bestLength] || bestLength == 0u)
+				{
+					const usize length = GetMatchLength(match, current, maxLength);
+					if(length > bestLength)
+					{
+						bestLength = length;
+						outDistance = position - candidate;
+						if(length >= m_parameters.NiceLength || length == maxLength)
+							break;
+					}
+				}
+
+				if(m_chain.empty())
+					break;
+				candidate = m_chain[candidate % WindowSize];
+			}
+
+			Insert(position, hash);
+
+			return bestLength >= MinMatchLength ? bestLength : 0u;
+		}
+
+	private:
+		std::span<const u8> m_data;
+		MatchParameters m_parameters;
+		std::vector<usize> m_head;
+		std::vector<usize> m_chain;
+	};
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Write the given input range as stored blocks.
+	/// @param writer BitWriter.
+	/// @param data Data to store.
+	/// @param final Whether the last stored block is the final block of the stream.
+	void WriteStoredBlocks(BitWriter& writer, std::span<const u8> data, const bool final)
+	{
+		do
+		{
+			const usize size = std::min(data.size(), MaxStoredBlockSize);
+			const bool last = final && size == data.size();
+
+			writer.Write(last ? 1u : 0u, 1u);
+			writer.Write(0u, 2u); //BTYPE 00
+			writer.AlignToByte();
+
+			const u32 len = NumericCast<u32>(size);
+			writer.Write(len | ((~len & 0xFFFFu) << 16u), 32u);
+			writer.WriteBytes(data.first(size));
+
+			data = data.subspan(size);
+		} while(!data.empty());
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Run length encode the given code lengths with the code length alphabet.
+	/// @param lengths Literal/length and distance code lengths.
+	/// @param outSymbols Output for the code length symbols, the extra bits are stored in bits 8-15.
+	void EncodeCodeLengths(const std::span<const u8> lengths, std::vector<u16>& outSymbols)
+	{
+		outSymbols.clear();
+
+		for(usize i = 0; i < lengths.size();)
+		{
+			const u8 length = lengths[i];
+			usize run = 1;
+			while(i + run < lengths.size() && lengths[i + run] == length)
+				++run;
+			i += run;
+
+			if(length == 0u)
+			{
+				while(run >= 11u)
+				{
+					const usize count = std::min<usize>(run, 138u);
+					outSymbols.push_back(NumericCast<u16>(18u | ((count - 11u) << 8u)));
+					run -= count;
+				}
+				if(run >= 3u)
+				{
+					outSymbols.push_back(NumericCast<u16>(17u | ((run - 3u) << 8u)));
+					run = 0;
+				}
+			}
+			else
+			{
+				outSymbols.push_back(length);
+				--run;
+				while(run >= 3u)
+				{
+					const usize count = std::min<usize>(run, 6u);
+					outSymbols.push_back(NumericCast<u16>(16u | ((count - 3u) << 8u)));
+					run -= count;
+				}
+			}
+
+			for(; run > 0u; --run)
+				outSymbols.push_back(length);
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Retrieve the amount of extra bits of a code length symbol.
+	/// @param symbol Code length symbol.
+	/// @return Amount of extra bits.
+	[[nodiscard]] constexpr u32 GetCodeLengthExtraBitCount(const u32 symbol) noexcept
+	{
+		switch(symbol)
+		{
+		case 16u:
+			return 2u;
+		case 17u:
+			return 3u;
+		case 18u:
+			return 7u;
+		default:
+			return 0u;
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Encodes LZ77 tokens as Deflate blocks.
+	class BlockWriter
+	{
+	public:
+		/// @brief Constructor.
+		/// @param writer BitWriter to write to.
+		explicit BlockWriter(BitWriter& writer)
+			: m_writer(writer)
+		{
+			//Fixed huffman codes (RFC 1951 section 3.2.6)
+			std::array<u8, 288> fixedLiteralLengthLengths{};
+			std::fill_n(fixedLiteralLengthLengths.begin(), 144, u8(8));
+			std::fill_n(fixedLiteralLengthLengths.begin() + 144, 112, u8(9));
+			std::fill_n(fixedLiteralLengthLengths.begin() + 256, 24, u8(7));
+			std::fill_n(fixedLiteralLengthLengths.begin() + 280, 8, u8(8));
+			std::array<u8, 32> fixedDistanceLengths{};
+			std::ranges::fill(fixedDistanceLengths, u8(5));
+
+			ComputeCodes(fixedLiteralLengthLengths, m_fixedLiteralLengthCodes);
+			ComputeCodes(fixedDistanceLengths, m_fixedDistanceCodes);
+		}
+
+		/// @brief Write a block for the given tokens, choosing the smallest block type.
+		/// @param tokens LZ77 tokens of the block.
+		/// @param input Input data covered by the tokens.
+		/// @param final Whether this is the final block of the stream.
+		void WriteBlock(const std::span<const Token> tokens, const std::span<const u8> input, const bool final)
+		{
+			std::array<u32, LiteralLengthSymbolCount> literalLengthFrequencies{};
+			std::array<u32, DistanceSymbolCount> distanceFrequencies{};
+			u64 extraBits = 0;
+			for(const Token& token : tokens)
+			{
+				if(token.Distance == 0u)
+				{
+					++literalLengthFrequencies[token.LiteralLength];
+					continue;
+				}
+
+				u32 extraBitCount = 0;
+				u32 extra = 0;
+				++literalLengthFrequencies[GetLengthSymbol(token.LiteralLength, extraBitCount, extra)];
+				extraBits += extraBitCount;
+				++distanceFrequencies[GetDistanceSymbol(token.Distance, extraBitCount, extra)];
+				extraBits += extraBitCount;
+			}
+			++literalLengthFrequencies[EndOfBlockSymbol];
+
+			//Dynamic huffman codes
+			std::array<u8, LiteralLengthSymbolCount> literalLengthLengths{};
+			std::array<u8, DistanceSymbolCount> distanceLengths{};
+			ComputeCodeLengths(literalLengthFrequencies, MaxCodeLength, literalLengthLengths);
+			ComputeCodeLengths(distanceFrequencies, MaxCodeLength, distanceLengths);
+
+			usize literalLengthCount = LiteralLengthSymbolCount;
+			while(literalLengthCount > 257u && literalLengthLengths[literalLengthCount - 1u] == 0u)
+				--literalLengthCount;
+			usize distanceCount = DistanceSymbolCount;
+			while(distanceCount > 1u && distanceLengths[distanceCount - 1u] == 0u)
+				--distanceCount;
+
+			std::vector<u8> lengths(literalLengthLengths.begin(), literalLengthLengths.begin() + NumericCast<isize>(literalLengthCount));
+			lengths.insert(lengths.end(), distanceLengths.begin(), distanceLengths.begin() + NumericCast<isize>(distanceCount));
+			EncodeCodeLengths(lengths, m_codeLengthSymbols);
+
+			std::array<u32, CodeLengthSymbolCount> codeLengthFrequencies{};
+			for(const u16 symbol : m_codeLengthSymbols)
+				++codeLengthFrequencies[symbol & 0xFFu];
+			std::array<u8, CodeLengthSymbolCount> codeLengthLengths{};
+			ComputeCodeLengths(codeLengthFrequencies, MaxCodeLengthCodeLength, codeLengthLengths);
+
+			usize codeLengthCount = CodeLengthSymbolCount;
+			while(codeLengthCount > 4u && codeLengthLengths[CodeLengthCodeOrder[codeLengthCount - 1u]] == 0u)
+				--codeLengthCount;
+
+			//Sizes of the different block types in bits
+			u64 dynamicSize = 3u + 5u + 5u + 4u + 3u * codeLengthCount;
+			for(const u16 symbol : m_codeLengthSymbols)
+				dynamicSize += codeLengthLengths[symbol & 0xFFu] + GetCodeLengthExtraBitCount(symbol & 0xFFu);
+			u64 fixedSize = 3u;
+			for(u32 i = 0; i < LiteralLengthSymbolCount; ++i)
+			{
+				dynamicSize += NumericCast<u64>(literalLengthFrequencies[i]) * literalLengthLengths[i];
+				fixedSize += NumericCast<u64>(literalLengthFrequencies[i]) * m_fixedLiteralLengthCodes[i].Length;
+			}
+			for(u32 i = 0; i < DistanceSymbolCount; ++i)
+			{
+				dynamicSize += NumericCast<u64>(distanceFrequencies[i]) * distanceLengths[i];
+				fixedSize += NumericCast<u64>(distanceFrequencies[i]) * 5u;
+			}
+			dynamicSize += extraBits;
+			fixedSize += extraBits;
+			const u64 storedBlockCount = std::max<u64>((input.size() + MaxStoredBlockSize - 1u) / MaxStoredBlockSize, 1u);
+			const u64 storedSize = storedBlockCount * (3u + 7u + 32u) + 8u * input.size();
+
+			if(storedSize <= dynamicSize && storedSize <= fixedSize)
+			{
+				WriteStoredBlocks(m_writer, input, final);
+				return;
+			}
+
+			m_writer.Write(final ? 1u : 0u, 1u);
+
+			if(fixedSize <= dynamicSize)
+			{
+				m_writer.Write(1u, 2u); //BTYPE 01
+				WriteTokens(tokens, m_fixedLiteralLengthCodes, m_fixedDistanceCodes);
+				return;
+			}
+
+			m_writer.Write(2u, 2u); //BTYPE 10
+			m_writer.Write(NumericCast<u32>(literalLengthCount - 257u), 5u);
+			m_writer.Write(NumericCast<u32>(distanceCount - 1u), 5u);
+			m_writer.Write(NumericCast<u32>(codeLengthCount - 4u), 4u);
+			for(usize i = 0; i < codeLengthCount; ++i)
+				m_writer.Write(codeLengthLengths[CodeLengthCodeOrder[i]], 3u);
+
+			std::array<HuffmanCode, CodeLengthSymbolCount> codeLengthCodes{};
+			ComputeCodes(codeLengthLengths, codeLengthCodes);
+			for(const u16 symbol : m_codeLengthSymbols)
+			{
+				const u32 codeLengthSymbol = symbol & 0xFFu;
+				m_writer.Write(codeLengthCodes[codeLengthSymbol]);
+				m_writer.Write(symbol >> 8u, GetCodeLengthExtraBitCount(codeLengthSymbol));
+			}
+
+			std::array<HuffmanCode, LiteralLengthSymbolCount> literalLengthCodes{};
+			std::array<HuffmanCode, DistanceSymbolCount> distanceCodes{};
+			ComputeCodes(literalLengthLengths, literalLengthCodes);
+			ComputeCodes(distanceLengths, distanceCodes);
+			WriteTokens(tokens, literalLengthCodes, distanceCodes);
+		}
+
+	private:
+		/// @brief Write the given tokens and the end of block symbol.
+		/// @param tokens LZ77 tokens.
+		/// @param literalLengthCodes Literal/length huffman codes.
+		/// @param distanceCodes Distance huffman codes.
+		void WriteTokens(const std::span<const Token> tokens, const std::span<const HuffmanCode> literalLengthCodes,
+		                 const std::span<const HuffmanCode> distanceCodes)
+		{
+			for(const Token& token : tokens)
+			{
+				if(token.Distance == 0u)
+				{
+					m_writer.Write(literalLengthCodes[token.LiteralLength]);
+					continue;
+				}
+
+				u32 extraBitCount = 0;
+				u32 extra = 0;
+				m_writer.Write(literalLengthCodes[GetLengthSymbol(token.LiteralLength, extraBitCount, extra)]);
+				m_writer.Write(extra, extraBitCount);
+				m_writer.Write(distanceCodes[GetDistanceSymbol(token.Distance, extraBitCount, extra)]);
+				m_writer.Write(extra, extraBitCount);
+			}
+
+			m_writer.Write(literalLengthCodes[EndOfBlockSymbol]);
+		}
+
+		BitWriter& m_writer;
+		std::array<HuffmanCode, 288> m_fixedLiteralLengthCodes{};
+		std::array<HuffmanCode, 32> m_fixedDistanceCodes{};
+		std::vector<u16> m_codeLengthSymbols{};
+	};
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Compress the given data with LZ77 and huffman coding.
+	/// @param writer BitWriter to write to.
+	/// @param data Data to compress, must not be empty.
+	/// @param parameters Matcher parameters.
+	void DeflateLZ77(BitWriter& writer, const std::span<const u8> data, const MatchParameters& parameters)
+	{
+		ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None);
+
+		Matcher matcher(data, parameters);
+		BlockWriter blockWriter(writer);
+
+		std::vector<Token> tokens{};
+		tokens.reserve(MaxBlockTokens + 2u);
+
+		usize blockStart = 0;
+		usize position = 0;
+		usize distance = 0;
+		usize length = matcher.FindMatch(position, distance);
+
+		while(position < data.size())
+		{
+			if(length == 0u)
+			{
+				tokens.push_back({data[position], 0u});
+				++position;
+				length = matcher.FindMatch(position, distance);
+			}
+			else
+			{
+				bool nextInserted = false;
+				if(parameters.LazyMatching && length < parameters.NiceLength && position + 1u < data.size())
+				{
+					nextInserted = true;
+					//Emit a literal instead if the next position has a longer match
+					usize nextDistance = 0;
+					const usize nextLength = matcher.FindMatch(position + 1u, nextDistance);
+					if(nextLength > length)
+					{
+						tokens.push_back({data[position], 0u});
+						++position;
+						length = nextLength;
+						distance = nextDistance;
+						continue;
+					}
+				}
+
+				tokens.push_back({NumericCast<u16>(length), NumericCast<u16>(distance)});
+
+				const usize matchEnd = position + length;
+				if(parameters.InsertMatchPositions)
+				{
+					//The lazy check may have inserted position + 1 already
+					const usize insertEnd = std::min(matchEnd, data.size() - std::min(data.size(), MinMatchLength - 1u));
+					for(usize p = position + (nextInserted ? 2u : 1u); p < insertEnd; ++p)
+						matcher.Insert(p);
+				}
+				position = matchEnd;
+				length = matcher.FindMatch(position, distance);
+			}
+
+			if(tokens.size() >= MaxBlockTokens && position < data.size())
+			{
+				blockWriter.WriteBlock(tokens, data.subspan(blockStart, position - blockStart), false);
+				tokens.clear();
+				blockStart = position;
+			}
+		}
+
+		blockWriter.WriteBlock(tokens, data.subspan(blockStart), true);
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] std::vector<u8> TRAP::Utils::Compress::Deflate(const std::span<const u8> data, const CompressionLevel level)
+{
+	ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None);
+
+	std::vector<u8> result{};
+	result.reserve(level == CompressionLevel::None ? data.size() + (data.size() / MaxStoredBlockSize + 1u) * 5u :
+	                                                 data.size() / 2u + 64u);
+	BitWriter writer(result);
+
+	if(level == CompressionLevel::None || data.empty())
+		WriteStoredBlocks(writer, data, true);
+	else
+		DeflateLZ77(writer, data, level == CompressionLevel::Fastest ? FastestParameters : FastParameters);
+
+	writer.AlignToByte();
+
+	return result;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] std::vector<u8> TRAP::Utils::Compress::ZlibCompress(const std::span<const u8> data, const CompressionLevel level)
+{
+	ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None);
+
+	//CMF: Deflate with 32K window, FLG: compression level hint and check bits
+	const u8 flags = level == CompressionLevel::Fast ? 0x5Eu : 0x01u;
+	std::vector<u8> result{0x78u, flags};
+
+	const std::vector<u8> compressed = Deflate(data, level);
+	result.reserve(compressed.size() + 6u);
+	result.insert(result.end(), compressed.begin(), compressed.end());
+
+	const std::array<u8, 4> adler32 = Hash::Adler32(data.data(), data.size());
+	result.insert(result.end(), adler32.begin(), adler32.end());
+
+	return result;
+}
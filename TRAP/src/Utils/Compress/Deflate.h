@@ -0,0 +1,38 @@
+#ifndef TRAP_DEFLATE_H
+#define TRAP_DEFLATE_H
+
+#include <span>
+#include <vector>
+
+#include "Core/Types.h"
+
+namespace TRAP::Utils::Compress
+{
+	/// @brief Compression levels supported by Deflate().
+	///        Only fast levels are offered, as the compressor is meant for runtime use (i.e. screenshots).
+	enum class CompressionLevel : u8
+	{
+		/// @brief Store the data uncompressed.
+		None,
+		/// @brief Greedy matching with a single probe per position, optimized for speed.
+		Fastest,
+		/// @brief Short hash chains with lazy matching, better ratio at a moderate speed.
+		Fast
+	};
+
+	/// @brief Compress the given data with the Deflate algorithm (RFC 1951).
+	///        Every block is emitted with dynamic or fixed huffman codes or stored, whichever is the smallest.
+	/// @param data Data to compress.
+	/// @param level Compression level to use.
+	/// @return Raw Deflate stream.
+	[[nodiscard]] std::vector<u8> Deflate(std::span<const u8> data, CompressionLevel level = CompressionLevel::Fast);
+
+	/// @brief Compress the given data into a zlib stream (RFC 1950).
+	///        The Deflate stream is wrapped with the 2 byte zlib header and the Adler32 checksum, like PNG expects it.
+	/// @param data Data to compress.
+	/// @param level Compression level to use.
+	/// @return zlib stream.
+	[[nodiscard]] std::vector<u8> ZlibCompress(std::span<const u8> data, CompressionLevel level = CompressionLevel::Fast);
+}
+
+#endif /*TRAP_DEFLATE_H*/
@@ -30,9 +30,12 @@ Modified by Jan "GamesTrap" Schuerkamp
 
 #include <array>
 #include <cstdint>
+#include <cstring>
+#include <type_traits>
 #include <vector>
 
 #include "Maths/Math.h"
+#include "Utils/Memory.h"
 #include "Utils/NumericCasts.h"
 
 namespace TRAP::Utils::Decompress
@@ -151,6 +154,11 @@ namespace TRAP::Utils::Decompress
 			/// @param reader BitReader to decode symbol from.
 			/// @return Code.
 			[[nodiscard]] constexpr u32 DecodeSymbol(BitReader& reader) const;
+			/// @brief Decode a symbol from the given bits without using a BitReader.
+			/// @param bits Bits to decode, the first bit is the LSB. Must contain at least 15 valid bits.
+			/// @param outLength Output for the length of the decoded symbol in bits.
+			/// @return Code.
+			[[nodiscard]] constexpr u32 LookupSymbol(u32 bits, u32& outLength) const;
 
 			//The base lengths represented by codes 257-285
 			static constexpr std::array<u32, 29> LengthBase
@@ -249,9 +257,135 @@ namespace TRAP::Utils::Decompress
 		static constexpr u16 FirstLengthCodeIndex = 257;
 		static constexpr u16 LastLengthCodeIndex = 285;
 
+		/// @brief Combined lookup tables used by the fast path of InflateHuffmanBlock().
+		///        Every entry holds a fully decoded literal/length or distance symbol, including its base value
+		///        and amount of extra bits, so no further table lookups are needed.
+		///        Literal entries may hold two consecutive literals if both codes fit into the index bits.
+		struct FastHuffmanTable
+		{
+			/// @brief Constructor.
+			/// @param treeLL Literal length huffman tree.
+			/// @param treeD Distance huffman tree.
+			constexpr FastHuffmanTable(const HuffmanTree& treeLL, const HuffmanTree& treeD);
+
+			/// @brief Copy constructor.
+			consteval FastHuffmanTable(const FastHuffmanTable&) = delete;
+			/// @brief Copy assignment operator.
+			consteval FastHuffmanTable& operator=(const FastHuffmanTable&) = delete;
+			/// @brief Move constructor.
+			constexpr FastHuffmanTable(FastHuffmanTable&&) noexcept = default;
+			/// @brief Move assignment operator,
+			constexpr FastHuffmanTable& operator=(FastHuffmanTable&&) noexcept = default;
+
+			/// @brief Destructor.
+			constexpr ~FastHuffmanTable() = default;
+
+			enum class EntryKind : u8
+			{
+				Literal,
+				LiteralPair,
+				Length,
+				EndOfBlock,
+				Distance,
+				/// @brief Code is longer than the index bits, decode it via HuffmanTree::LookupSymbol().
+				Slow,
+				/// @brief Disallowed symbol.
+				Invalid
+			};
+
+			/// @brief Amount of bits used to index LiteralLength.
+			static constexpr u32 LiteralLengthBits = 11u;
+			/// @brief Amount of bits used to index Distance.
+			static constexpr u32 DistanceBits = 9u;
+
+			//Entries are packed as: Bits 0-3 EntryKind, bits 4-7 code length, bits 8-11 extra bits,
+			//bits 16-31 value (literal(s), base length or base distance)
+			std::array<u32, 1u << LiteralLengthBits> LiteralLength{};
+			std::array<u32, 1u << DistanceBits> Distance{};
+
+			/// @brief Create the entry for the given literal/length symbol.
+			/// @param symbol Literal/length symbol.
+			/// @param length Length of the code in bits.
+			/// @return Packed entry.
+			[[nodiscard]] static constexpr u32 MakeLiteralLengthEntry(u32 symbol, u32 length) noexcept;
+			/// @brief Create the entry for the given distance symbol.
+			/// @param symbol Distance symbol.
+			/// @param length Length of the code in bits.
+			/// @return Packed entry.
+			[[nodiscard]] static constexpr u32 MakeDistanceEntry(u32 symbol, u32 length) noexcept;
+
+			[[nodiscard]] static constexpr EntryKind GetKind(u32 entry) noexcept;
+			[[nodiscard]] static constexpr u32 GetCodeLength(u32 entry) noexcept;
+			[[nodiscard]] static constexpr u32 GetExtraBits(u32 entry) noexcept;
+			[[nodiscard]] static constexpr u32 GetValue(u32 entry) noexcept;
+
+		private:
+			[[nodiscard]] static constexpr u32 MakeEntry(EntryKind kind, u32 length, u32 extraBits, u32 value) noexcept;
+		};
+
+		/// @brief Amount of bytes that must be left in the output for the fast path.
+		///        Longest possible match plus the overshoot of the wide stores used by CopyMatch().
+		static constexpr usize FastPathOutputSlack = 258u + 16u;
+		/// @brief Amount of bytes that must be left in the input for the fast path.
+		///        Every symbol refills the bit buffer with an 8 byte load.
+		static constexpr usize FastPathInputSlack = 8u;
+
+		/// @brief Copy a match using wide stores which may overlap the source.
+		/// @param out Pointer to the current output position.
+		/// @param distance Backwards distance of the match, must not exceed the already written output.
+		/// @param length Length of the match.
+		/// @note May write up to 16 bytes past out + length.
+		constexpr void CopyMatch(u8* out, usize distance, usize length);
+
+		/// @brief Decode symbols of a huffman block as long as enough input and output slack remains.
+		///        The bit buffer is refilled once per symbol with a 64-bit load and symbols are
+		///        decoded via FastHuffmanTable.
+		///        Stops at the end of the block, when the slack runs out or on any error in which case
+		///        the reader is rewound to the start of the offending symbol so the careful path
+		///        in InflateHuffmanBlock() can report it.
+		/// @param out Output buffer.
+		/// @param pos Current position in the output buffer.
+		/// @param reader BitReader.
+		/// @param table Fast lookup tables of the block.
+		/// @param treeLL Literal length huffman tree.
+		/// @param treeD Distance huffman tree.
+		/// @return True if the end of the block was reached, false otherwise.
+		[[nodiscard]] constexpr bool InflateHuffmanBlockFast(std::span<u8> out, usize& pos, BitReader& reader,
+		                                                     const FastHuffmanTable& table, const HuffmanTree& treeLL,
+		                                                     const HuffmanTree& treeD);
+
+		enum class InflateImplementation : u8
+		{
+			/// @brief Decode every symbol with bounds checked bit refills.
+			Careful,
+			/// @brief Use InflateHuffmanBlockFast() while enough input and output slack remains,
+			///        the careful path handles the tail.
+			FastPath
+		};
+
 		[[nodiscard]] constexpr bool InflateNoCompression(std::span<u8> out, usize& pos, BitReader& reader);
+		/// @brief Decode one literal/length symbol (two if the first one is a literal) including the
+		///        distance of a match, using bounds checked bit refills.
+		/// @param out Output buffer, decoding fails if a symbol doesn't fit into it.
+		/// @param pos Current position in the output buffer.
+		/// @param reader BitReader.
+		/// @param treeLL Literal length huffman tree.
+		/// @param treeD Distance huffman tree.
+		/// @param done Set to true when the end code was decoded.
+		/// @return True on success, false otherwise.
+		[[nodiscard]] constexpr bool InflateHuffmanSymbol(std::span<u8> out, usize& pos, BitReader& reader,
+		                                                  const HuffmanTree& treeLL, const HuffmanTree& treeD,
+		                                                  bool& done);
 		[[nodiscard]] constexpr bool InflateHuffmanBlock(std::span<u8> out, usize& pos, BitReader& reader,
-		                                                 u32 btype);
+		                                                 u32 btype, InflateImplementation impl);
+
+		/// @brief Inflate algorithm using the given implementation.
+		/// @param source Source data in bytes.
+		/// @param destination Destination where to put inflated data to.
+		/// @param impl Implementation to use.
+		/// @return True on success, false otherwise.
+		[[nodiscard]] constexpr bool Inflate(std::span<const u8> source, std::span<u8> destination,
+		                                     InflateImplementation impl);
 	}
 
 	/// @brief Inflate algorithm.
@@ -647,6 +781,24 @@ constexpr void TRAP::Utils::Decompress::INTERNAL::BitReader::AdvanceBits(const u
 
 //-------------------------------------------------------------------------------------------------------------------//
 
+[[nodiscard]] constexpr u32 TRAP::Utils::Decompress::INTERNAL::HuffmanTree::LookupSymbol(const u32 bits, u32& outLength) const
+{
+	const u32 code = bits & ((1u << FirstBits) - 1u);
+	const u32 l = TableLength[code];
+	if(l <= FirstBits)
+	{
+		outLength = l;
+		return TableValue[code];
+	}
+
+	const u32 index = TableValue[code] + ((bits >> FirstBits) & ((1u << (l - FirstBits)) - 1u));
+	outLength = TableLength[index];
+
+	return TableValue[index];
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
 //Get the literal and length code of a deflated block with fixed tree, as per the deflate specification
 [[nodiscard]] constexpr bool TRAP::Utils::Decompress::INTERNAL::HuffmanTree::GenerateFixedLiteralLengthTree()
 {
@@ -876,6 +1028,260 @@ constexpr void TRAP::Utils::Decompress::INTERNAL::BitReader::AdvanceBits(const u
 
 //-------------------------------------------------------------------------------------------------------------------//
 
+constexpr TRAP::Utils::Decompress::INTERNAL::FastHuffmanTable::FastHuffmanTable(const HuffmanTree& treeLL,
+                                                                                const HuffmanTree& treeD)
+{
+	for(u32 bits = 0; bits < LiteralLength.size(); ++bits)
+	{
+		u32 length = 0;
+		const u32 symbol = treeLL.LookupSymbol(bits, length);
+		if(length > LiteralLengthBits)
+		{
+			LiteralLength[bits] = MakeEntry(EntryKind::Slow, 0, 0, 0);
+			continue;
+		}
+
+		LiteralLength[bits] = MakeLiteralLengthEntry(symbol, length);
+		if(symbol > 255 || length == LiteralLengthBits)
+			continue;
+
+		//Try to fit a second literal into the remaining bits.
+		//The missing high bits are zero, which is fine as long as the second code fits completely.
+		u32 secondLength = 0;
+		const u32 secondSymbol = treeLL.LookupSymbol(bits >> length, secondLength);
+		if(secondSymbol <= 255 && length + secondLength <= LiteralLengthBits)
+			LiteralLength[bits] = MakeEntry(EntryKind::LiteralPair, length + secondLength, 0, symbol | (secondSymbol << 8u));
+	}
+
+	for(u32 bits = 0; bits < Distance.size(); ++bits)
+	{
+		u32 length = 0;
+		const u32 symbol = treeD.LookupSymbol(bits, length);
+		if(length > DistanceBits)
+			Distance[bits] = MakeEntry(EntryKind::Slow, 0, 0, 0);
+		else
+			Distance[bits] = MakeDistanceEntry(symbol, length);
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] constexpr u32 TRAP::Utils::Decompress::INTERNAL::FastHuffmanTable::MakeLiteralLengthEntry(const u32 symbol,
+                                                                                                       const u32 length) noexcept
+{
+	if(symbol <= 255)
+		return MakeEntry(EntryKind::Literal, length, 0, symbol);
+	if(symbol == 256)
+		return MakeEntry(EntryKind::EndOfBlock, length, 0, 0);
+	if(symbol >= FirstLengthCodeIndex && symbol <= LastLengthCodeIndex)
+	{
+		return MakeEntry(EntryKind::Length, length, HuffmanTree::LengthExtra[symbol - FirstLengthCodeIndex],
+		                 HuffmanTree::LengthBase[symbol - FirstLengthCodeIndex]);
+	}
+
+	return MakeEntry(EntryKind::Invalid, 0, 0, 0);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] constexpr u32 TRAP::Utils::Decompress::INTERNAL::FastHuffmanTable::MakeDistanceEntry(const u32 symbol,
+                                                                                                  const u32 length) noexcept
+{
+	//Distance codes 30-31 are never used
+	if(symbol > 29)
+		return MakeEntry(EntryKind::Invalid, 0, 0, 0);
+
+	return MakeEntry(EntryKind::Distance, length, HuffmanTree::DistanceExtra[symbol], HuffmanTree::DistanceBase[symbol]);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] constexpr TRAP::Utils::Decompress::INTERNAL::FastHuffmanTable::EntryKind TRAP::Utils::Decompress::INTERNAL::FastHuffmanTable::GetKind(const u32 entry) noexcept
+{
+	return static_cast<EntryKind>(entry & 0xFu);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] constexpr u32 TRAP::Utils::Decompress::INTERNAL::FastHuffmanTable::GetCodeLength(const u32 entry) noexcept
+{
+	return (entry >> 4u) & 0xFu;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] constexpr u32 TRAP::Utils::Decompress::INTERNAL::FastHuffmanTable::GetExtraBits(const u32 entry) noexcept
+{
+	return (entry >> 8u) & 0xFu;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] constexpr u32 TRAP::Utils::Decompress::INTERNAL::FastHuffmanTable::GetValue(const u32 entry) noexcept
+{
+	return entry >> 16u;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] constexpr u32 TRAP::Utils::Decompress::INTERNAL::FastHuffmanTable::MakeEntry(const EntryKind kind, const u32 length,
+                                                                                          const u32 extraBits,
+                                                                                          const u32 value) noexcept
+{
+	return static_cast<u32>(kind) | (length << 4u) | (extraBits << 8u) | (value << 16u);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+constexpr void TRAP::Utils::Decompress::INTERNAL::CopyMatch(u8* out, const usize distance, const usize length)
+{
+	const u8* src = out - distance;
+	u8* const end = out + length;
+
+	if(std::is_constant_evaluated())
+	{
+		while(out != end)
+			*out++ = *src++;
+		return;
+	}
+
+	if(distance >= 16u)
+	{
+		//Source and destination of every 16 byte chunk don't overlap
+		do
+		{
+			std::memcpy(out, src, 16u);
+			out += 16u;
+			src += 16u;
+		} while(out < end);
+	}
+	else if(distance >= 8u)
+	{
+		do
+		{
+			std::memcpy(out, src, 8u);
+			out += 8u;
+			src += 8u;
+		} while(out < end);
+	}
+	else if(distance == 1u)
+		std::memset(out, *src, length);
+	else
+	{
+		//Short repeating pattern (i.e. repeated pixels), expand it to 8 bytes once and advance by
+		//the largest multiple of distance that fits into 8 bytes so the pattern stays in phase
+		std::array<u8, 8u> pattern{};
+		for(usize i = 0; i < pattern.size(); ++i)
+			pattern[i] = src[i % distance];
+		const usize step = (8u / distance) * distance;
+
+		do
+		{
+			std::memcpy(out, pattern.data(), pattern.size());
+			out += step;
+		} while(out < end);
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] constexpr bool TRAP::Utils::Decompress::INTERNAL::InflateHuffmanBlockFast(const std::span<u8> out, usize& pos,
+                                                                                        BitReader& reader,
+                                                                                        const FastHuffmanTable& table,
+                                                                                        const HuffmanTree& treeLL,
+                                                                                        const HuffmanTree& treeD)
+{
+	using EntryKind = FastHuffmanTable::EntryKind;
+
+	constexpr u32 LiteralLengthMask = (1u << FastHuffmanTable::LiteralLengthBits) - 1u;
+	constexpr u32 DistanceMask = (1u << FastHuffmanTable::DistanceBits) - 1u;
+
+	const usize inSize = reader.Data.size_bytes();
+	if(inSize < FastPathInputSlack || out.size() < FastPathOutputSlack)
+		return false;
+	const usize inLimit = inSize - FastPathInputSlack;
+	const usize outLimit = out.size() - FastPathOutputSlack;
+
+	//The bit position is only written back to the reader after complete symbols,
+	//so returning early leaves the reader at the start of the current symbol
+	usize bitPos = reader.BP;
+	while((bitPos >> 3u) <= inLimit && pos <= outLimit)
+	{
+		reader.BP = bitPos;
+
+		//At least 57 valid bits, enough for the longest length code (15 + 5 extra bits)
+		//followed by the longest distance code (15 + 13 extra bits)
+		u64 bits = Memory::ConvertByte<u64>(reader.Data.data() + (bitPos >> 3u)) >> (bitPos & 7u);
+
+		u32 entry = table.LiteralLength[bits & LiteralLengthMask];
+		if(FastHuffmanTable::GetKind(entry) == EntryKind::Slow)
+		{
+			u32 length = 0;
+			const u32 symbol = treeLL.LookupSymbol(static_cast<u32>(bits), length);
+			entry = FastHuffmanTable::MakeLiteralLengthEntry(symbol, length);
+		}
+
+		const u32 codeLength = FastHuffmanTable::GetCodeLength(entry);
+		bits >>= codeLength;
+		bitPos += codeLength;
+
+		switch(FastHuffmanTable::GetKind(entry))
+		{
+		case EntryKind::Literal:
+			out[pos++] = static_cast<u8>(FastHuffmanTable::GetValue(entry));
+			continue;
+
+		case EntryKind::LiteralPair:
+			out[pos++] = static_cast<u8>(FastHuffmanTable::GetValue(entry));
+			out[pos++] = static_cast<u8>(FastHuffmanTable::GetValue(entry) >> 8u);
+			continue;
+
+		case EntryKind::EndOfBlock:
+			reader.BP = bitPos;
+			return true;
+
+		case EntryKind::Length:
+			break;
+
+		default:
+			return false; //Let the careful path report the error
+		}
+
+		const u32 lengthExtraBits = FastHuffmanTable::GetExtraBits(entry);
+		const usize length = FastHuffmanTable::GetValue(entry) + (static_cast<u32>(bits) & ((1u << lengthExtraBits) - 1u));
+		bits >>= lengthExtraBits;
+		bitPos += lengthExtraBits;
+
+		u32 distanceEntry = table.Distance[bits & DistanceMask];
+		if(FastHuffmanTable::GetKind(distanceEntry) == EntryKind::Slow)
+		{
+			u32 codeLengthD = 0;
+			const u32 symbol = treeD.LookupSymbol(static_cast<u32>(bits), codeLengthD);
+			distanceEntry = FastHuffmanTable::MakeDistanceEntry(symbol, codeLengthD);
+		}
+		if(FastHuffmanTable::GetKind(distanceEntry) != EntryKind::Distance)
+			return false; //Let the careful path report the error
+
+		const u32 codeLengthD = FastHuffmanTable::GetCodeLength(distanceEntry);
+		bits >>= codeLengthD;
+		const u32 distanceExtraBits = FastHuffmanTable::GetExtraBits(distanceEntry);
+		const usize distance = FastHuffmanTable::GetValue(distanceEntry) +
+		                       (static_cast<u32>(bits) & ((1u << distanceExtraBits) - 1u));
+		bitPos += codeLengthD + distanceExtraBits;
+
+		if(distance > pos)
+			return false; //Let the careful path report the error
+
+		CopyMatch(out.data() + pos, distance, length);
+		pos += length;
+	}
+
+	reader.BP = bitPos;
+	return false;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
 [[nodiscard]] constexpr bool TRAP::Utils::Decompress::INTERNAL::InflateNoCompression(const std::span<u8> out, usize& pos,
                                                                                      BitReader& reader)
 {
@@ -903,6 +1309,8 @@ constexpr void TRAP::Utils::Decompress::INTERNAL::BitReader::AdvanceBits(const u
 	//Read the literal data: LEN bytes are now stored in the out buffer
 	if (bytePos + LEN > size)
 		return false; //Error: Reading outside of in buffer
+	if (LEN > out.size() - pos)
+		return false; //Error: Writing outside of out buffer
 
 	std::copy_n(reader.Data.data() + bytePos, LEN, out.data() + pos);
 	pos += LEN;
@@ -915,8 +1323,104 @@ constexpr void TRAP::Utils::Decompress::INTERNAL::BitReader::AdvanceBits(const u
 
 //-------------------------------------------------------------------------------------------------------------------//
 
+[[nodiscard]] constexpr bool TRAP::Utils::Decompress::INTERNAL::InflateHuffmanSymbol(const std::span<u8> out, usize& pos,
+                                                                                     BitReader& reader,
+                                                                                     const HuffmanTree& treeLL,
+                                                                                     const HuffmanTree& treeD,
+                                                                                     bool& done)
+{
+	//Ensure enough bits for 2 huffman code reads (15 bits each): if the first is a literal,
+	//a second literal is read at once. This appears to be slightly faster, than ensuring 20
+	//bits here for 1 huffman symbol and the potential 5 extra bits for the length symbol.
+	reader.EnsureBits32();
+	u32 codeLL = treeLL.DecodeSymbol(reader);
+	if(codeLL <= 255)
+	{
+		//Slightly faster code path if multiple literals in a row
+		if(pos >= out.size())
+			return false; //Error: Writing outside of out buffer
+		out[pos] = static_cast<u8>(codeLL);
+		++(pos);
+		codeLL = treeLL.DecodeSymbol(reader);
+	}
+
+	if(codeLL <= 255) //Literal symbol
+	{
+		if(pos >= out.size())
+			return false; //Error: Writing outside of out buffer
+		out[pos] = static_cast<u8>(codeLL);
+		++(pos);
+	}
+	else if(codeLL >= FirstLengthCodeIndex && codeLL <= LastLengthCodeIndex) //Length code
+	{
+		//Part 1: Get Length base
+		usize length = HuffmanTree::LengthBase[codeLL - FirstLengthCodeIndex];
+
+		//Part 2: Get Extra bits and add the value of that to length
+		const u32 numExtraBitsL = HuffmanTree::LengthExtra[codeLL - FirstLengthCodeIndex];
+		if (numExtraBitsL != 0)
+		{
+			//Bits already ensured above
+			reader.EnsureBits25();
+			length += reader.ReadBits(numExtraBitsL);
+		}
+
+		//Part 3: Get Distance code
+		reader.EnsureBits32(); //Up to 15 for the Huffman symbol, up to 13 for the extra bits
+		const u32 codeD = treeD.DecodeSymbol(reader);
+		if(codeD > 29)
+		{
+			if(codeD <= 31)
+				return false; //Error: Invalid distance code (30-31 are never used)
+
+			return false; //Error: Tried to read disallowed Huffman symbol
+		}
+		u32 distance = HuffmanTree::DistanceBase[codeD];
+
+		//Part 4: Get Extra bits from distance
+		const u32 numExtraBitsD = HuffmanTree::DistanceExtra[codeD];
+		if(numExtraBitsD != 0)
+			//Bits already ensured above
+			distance += reader.ReadBits(numExtraBitsD);
+
+		//Part 5: Fill in all the out[n] values based on the length and distance
+		const usize start = pos;
+		if(distance > start)
+			return false; //Error: Too long backward distance
+		usize backward = start - distance;
+
+		if(length > out.size() - pos)
+			return false; //Error: Writing outside of out buffer
+		if(distance < length)
+		{
+			std::copy_n(out.data() + backward, distance, out.data() + pos);
+			pos += distance;
+			for (usize forward = distance; forward < length; ++forward)
+				out[pos++] = out[backward++];
+		}
+		else
+		{
+			std::copy_n(out.data() + backward, length, out.data() + pos);
+			pos += length;
+		}
+	}
+	else if(codeLL == 256)
+		done = true; //End code
+	else //if(codeLL == 66535u)
+		return false; //Error: Tried to read disallowed Huffman symbol
+
+	//Check if any of the EnsureBits above went out of bounds
+	if(reader.BP > reader.BitSize)
+		return false; //Error: Bit pointer jumps past memory
+
+	return true;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
 [[nodiscard]] constexpr bool TRAP::Utils::Decompress::INTERNAL::InflateHuffmanBlock(const std::span<u8> out, usize& pos,
-                                                                                    BitReader& reader, const u32 btype)
+                                                                                    BitReader& reader, const u32 btype,
+                                                                                    const InflateImplementation impl)
 {
 	HuffmanTree treeLL; //The Huffman tree for literal and length codes
 	HuffmanTree treeD; //The Huffman tree for distance codes
@@ -932,114 +1436,33 @@ constexpr void TRAP::Utils::Decompress::INTERNAL::BitReader::AdvanceBits(const u
 		if (!HuffmanTree::GetTreeInflateDynamic(treeLL, treeD, reader))
 			return false;
 
-	bool error = false, done = false;
-	while(!error && !done) //Decode all symbols until end reached, breaks at end code
-	{
-		//Ensure enough bits for 2 huffman code reads (15 bits each): if the first is a literal,
-		//a second literal is read at once. This appears to be slightly faster, than ensuring 20
-		//bits here for 1 huffman symbol and the potential 5 extra bits for the length symbol.
-		reader.EnsureBits32();
-		u32 codeLL = treeLL.DecodeSymbol(reader);
-		if(codeLL <= 255)
-		{
-			//Slightly faster code path if multiple literals in a row
-			// out.resize(pos + 1);
-			out[pos] = static_cast<u8>(codeLL);
-			++(pos);
-			codeLL = treeLL.DecodeSymbol(reader);
-		}
-
-		if(codeLL <= 255) //Literal symbol
-		{
-			// out.resize(pos + 1);
-			out[pos] = static_cast<u8>(codeLL);
-			++(pos);
-		}
-		else if(codeLL >= FirstLengthCodeIndex && codeLL <= LastLengthCodeIndex) //Length code
-		{
-			//Part 1: Get Length base
-			usize length = HuffmanTree::LengthBase[codeLL - FirstLengthCodeIndex];
+	bool done = false;
 
-			//Part 2: Get Extra bits and add the value of that to length
-			const u32 numExtraBitsL = HuffmanTree::LengthExtra[codeLL - FirstLengthCodeIndex];
-			if (numExtraBitsL != 0)
-			{
-				//Bits already ensured above
-				reader.EnsureBits25();
-				length += reader.ReadBits(numExtraBitsL);
-			}
-
-			//Part 3: Get Distance code
-			reader.EnsureBits32(); //Up to 15 for the Huffman symbol, up to 13 for the extra bits
-			const u32 codeD = treeD.DecodeSymbol(reader);
-			if(codeD > 29)
-			{
-				if(codeD <= 31)
-				{
-					error = true; //Error: Invalid distance code (30-31 are never used)
-					break;
-				}
-
-				error = true; //Error: Tried to read disallowed Huffman symbol
-				break;
-			}
-			u32 distance = HuffmanTree::DistanceBase[codeD];
-
-			//Part 4: Get Extra bits from distance
-			const u32 numExtraBitsD = HuffmanTree::DistanceExtra[codeD];
-			if(numExtraBitsD != 0)
-				//Bits already ensured above
-				distance += reader.ReadBits(numExtraBitsD);
-
-			//Part 5: Fill in all the out[n] values based on the length and distance
-			const usize start = pos;
-			if(distance > start)
-			{
-				error = true; //Error: Too long backward distance
-				break;
-			}
-			usize backward = start - distance;
+	//Building the lookup tables only pays off if the fast path can actually run
+	if(impl == InflateImplementation::FastPath && pos + FastPathOutputSlack <= out.size())
+	{
+		const FastHuffmanTable table(treeLL, treeD);
+		done = InflateHuffmanBlockFast(out, pos, reader, table, treeLL, treeD);
+	}
 
-			// out.resize(pos + length);
-			if(distance < length)
-			{
-				std::copy_n(out.data() + backward, distance, out.data() + pos);
-				pos += distance;
-				for (usize forward = distance; forward < length; ++forward)
-					out[pos++] = out[backward++];
-			}
-			else
-			{
-				std::copy_n(out.data() + backward, length, out.data() + pos);
-				pos += length;
-			}
-		}
-		else if(codeLL == 256)
-			done = true; //End code, break the loop
-		else //if(codeLL == 66535u)
-		{
-			error = true; //Error: Tried to read disallowed Huffman symbol
-			break;
-		}
-		//Check if any of the EnsureBits above went out of bounds
-		if(reader.BP > reader.BitSize)
-		{
-			error = true; //Error: Bit pointer jumps past memory
-			break;
-		}
+	while(!done) //Decode all symbols until end reached, breaks at end code
+	{
+		if(!InflateHuffmanSymbol(out, pos, reader, treeLL, treeD, done))
+			return false;
 	}
 
-	return !error;
+	return true;
 }
 
 //-------------------------------------------------------------------------------------------------------------------//
 
-[[nodiscard]] constexpr bool TRAP::Utils::Decompress::Inflate(const std::span<const u8> source,
-                                                              const std::span<u8> destination)
+[[nodiscard]] constexpr bool TRAP::Utils::Decompress::INTERNAL::Inflate(const std::span<const u8> source,
+                                                                        const std::span<u8> destination,
+                                                                        const InflateImplementation impl)
 {
 	u32 BFINAL = 0;
 	usize pos = 0; //Byte position in the destination buffer
-	INTERNAL::BitReader reader(source);
+	BitReader reader(source);
 	if (reader.Error)
 		return false;
 
@@ -1055,13 +1478,13 @@ constexpr void TRAP::Utils::Decompress::INTERNAL::BitReader::AdvanceBits(const u
 			return false; //Invalid BTYPE
 		if (BTYPE == 0)
 		{
-			if (!TRAP::Utils::Decompress::INTERNAL::InflateNoCompression(destination, pos, reader))
+			if (!InflateNoCompression(destination, pos, reader))
 				return false;
 		}
 		else
 		{
 			//Compression, BTYPE 01 or 10
-			if (!TRAP::Utils::Decompress::INTERNAL::InflateHuffmanBlock(destination, pos, reader, BTYPE))
+			if (!InflateHuffmanBlock(destination, pos, reader, BTYPE, impl))
 				return false;
 		}
 	}
@@ -1069,4 +1492,12 @@ constexpr void TRAP::Utils::Decompress::INTERNAL::BitReader::AdvanceBits(const u
 	return true;
 }
 
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] constexpr bool TRAP::Utils::Decompress::Inflate(const std::span<const u8> source,
+                                                              const std::span<u8> destination)
+{
+	return INTERNAL::Inflate(source, destination, INTERNAL::InflateImplementation::FastPath);
+}
+
 #endif /*TRAP_INFLATE_H*/
\ No newline at end of file
@@ -0,0 +1,290 @@
+#include "TRAPPCH.h"
+#include "Inflater.h"
+
+namespace
+{
+	/// @brief Max backwards distance of deflate, the amount of decoded data that must be kept.
+	constexpr usize WindowHistorySize = 32u * 1024u;
+	/// @brief Amount of data decoded into the window before it needs to be drained.
+	constexpr usize WindowChunkSize = 64u * 1024u;
+
+	/// @brief Amount of input needed before decoding a block header while more input may follow.
+	///        The biggest possible header (dynamic huffman trees) is below 600 bytes.
+	constexpr usize MaxBlockHeaderSize = 1024u;
+	/// @brief Amount of input needed before decoding a symbol with the careful path while more input may follow.
+	///        Covers a literal followed by a length code, distance code and their extra bits.
+	constexpr usize MaxSymbolSize = 16u;
+	/// @brief Max amount of output of a single careful path step (a literal followed by the longest match).
+	constexpr usize MaxSymbolOutput = 1u + 258u;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+TRAP::Utils::Decompress::Inflater::Inflater()
+	: m_window(WindowHistorySize + WindowChunkSize)
+{
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::Utils::Decompress::Inflater::AppendInput(const std::span<const u8> input)
+{
+	ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None);
+
+	//Drop already consumed input
+	const usize consumedBytes = m_inputBitPos >> 3u;
+	m_input.erase(m_input.begin(), m_input.begin() + NumericCast<isize>(consumedBytes));
+	m_inputBitPos &= 7u;
+
+	m_input.insert(m_input.end(), input.begin(), input.end());
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::Utils::Decompress::Inflater::FinishInput() noexcept
+{
+	ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None &&
+	                                          (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	m_inputFinished = true;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] usize TRAP::Utils::Decompress::Inflater::Inflate(const std::span<u8> output)
+{
+	ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None);
+
+	usize written = 0;
+	while(true)
+	{
+		written += Drain(output.subspan(written));
+		if(written == output.size() || m_state == State::Done || m_state == State::Error)
+			return written;
+
+		//Everything got drained, so old data can be dropped
+		SlideWindow();
+
+		const usize windowPos = m_windowPos;
+		const usize inputBitPos = m_inputBitPos;
+		const State state = m_state;
+
+		Decode();
+
+		if(m_windowPos == windowPos && m_inputBitPos == inputBitPos && m_state == state)
+			return written; //Needs more input
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] std::span<const u8> TRAP::Utils::Decompress::Inflater::GetTrailingInput() const noexcept
+{
+	ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None &&
+	                                          (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	if(m_state != State::Done)
+		return {};
+
+	//The deflate stream ends at the next byte boundary
+	return std::span(m_input).subspan((m_inputBitPos + 7u) >> 3u);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::Utils::Decompress::Inflater::Decode()
+{
+	ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None);
+
+	INTERNAL::BitReader reader(m_input);
+	reader.BP = m_inputBitPos;
+
+	bool progress = true;
+	while(progress)
+	{
+		switch(m_state)
+		{
+		case State::BlockHeader:
+			progress = DecodeBlockHeader(reader);
+			break;
+
+		case State::StoredBlock:
+			progress = DecodeStoredBlock(reader);
+			break;
+
+		case State::HuffmanBlock:
+			progress = DecodeHuffmanBlock(reader);
+			break;
+
+		case State::Done:
+			[[fallthrough]];
+		case State::Error:
+			progress = false;
+			break;
+		}
+	}
+
+	m_inputBitPos = reader.BP;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] bool TRAP::Utils::Decompress::Inflater::DecodeBlockHeader(INTERNAL::BitReader& reader)
+{
+	ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None &&
+	                                          (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	const usize available = m_input.size() - (reader.BP >> 3u);
+	if(!m_inputFinished && available < MaxBlockHeaderSize)
+		return false;
+
+	if(reader.BitSize - reader.BP < 3) //Error, bit pointer will jump past memory
+	{
+		m_state = State::Error;
+		return false;
+	}
+
+	reader.EnsureBits9();
+	m_finalBlock = reader.ReadBits(1) != 0u;
+	const u32 BTYPE = reader.ReadBits(2);
+
+	if(BTYPE == 0)
+	{
+		//Go to first boundary of byte
+		const usize bytePos = (reader.BP + 7u) >> 3u;
+
+		//Read LEN(2Bytes) and NLEN(2Bytes)
+		if(bytePos + 4u > m_input.size())
+		{
+			m_state = State::Error; //Error, bit pointer will jump past memory
+			return false;
+		}
+		const u32 LEN = static_cast<u32>(m_input[bytePos]) + (static_cast<u32>(m_input[bytePos + 1]) << 8u);
+		const u32 NLEN = static_cast<u32>(m_input[bytePos + 2]) + (static_cast<u32>(m_input[bytePos + 3]) << 8u);
+
+		//Check if 16-bit NLEN is really the ones complement of LEN
+		if(LEN + NLEN != 65535)
+		{
+			m_state = State::Error;
+			return false;
+		}
+
+		reader.BP = (bytePos + 4u) << 3u;
+		m_storedRemaining = LEN;
+		m_state = State::StoredBlock;
+		return true;
+	}
+
+	//Trees must not be reused, building the lookup tables relies on freshly initialized trees
+	m_treeLL = INTERNAL::HuffmanTree{};
+	m_treeD = INTERNAL::HuffmanTree{};
+
+	bool valid = false;
+	if(BTYPE == 1)
+		valid = INTERNAL::HuffmanTree::GetTreeInflateFixed(m_treeLL, m_treeD);
+	else if(BTYPE == 2)
+		valid = INTERNAL::HuffmanTree::GetTreeInflateDynamic(m_treeLL, m_treeD, reader);
+
+	if(!valid || reader.BP > reader.BitSize)
+	{
+		m_state = State::Error;
+		return false;
+	}
+
+	m_fastTable.Emplace(m_treeLL, m_treeD);
+	m_state = State::HuffmanBlock;
+	return true;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] bool TRAP::Utils::Decompress::Inflater::DecodeStoredBlock(INTERNAL::BitReader& reader)
+{
+	ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None &&
+	                                          (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	//Stored data is byte aligned
+	const usize bytePos = reader.BP >> 3u;
+	const usize available = m_input.size() - bytePos;
+	const usize count = Math::Min(m_storedRemaining, Math::Min(available, m_window.size() - m_windowPos));
+
+	std::copy_n(m_input.data() + bytePos, count, m_window.data() + m_windowPos);
+	m_windowPos += count;
+	m_storedRemaining -= count;
+	reader.BP += count << 3u;
+
+	if(m_storedRemaining == 0)
+	{
+		m_state = m_finalBlock ? State::Done : State::BlockHeader;
+		return true;
+	}
+
+	if(available == 0 && m_inputFinished)
+		m_state = State::Error; //Error: Reading outside of in buffer
+
+	return count != 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] bool TRAP::Utils::Decompress::Inflater::DecodeHuffmanBlock(INTERNAL::BitReader& reader)
+{
+	ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None &&
+	                                          (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	const usize windowPos = m_windowPos;
+	const usize inputBitPos = reader.BP;
+
+	bool done = false;
+	if(m_windowPos + INTERNAL::FastPathOutputSlack <= m_window.size())
+		done = INTERNAL::InflateHuffmanBlockFast(m_window, m_windowPos, reader, *m_fastTable, m_treeLL, m_treeD);
+
+	while(!done)
+	{
+		const usize available = m_input.size() - (reader.BP >> 3u);
+		if((!m_inputFinished && available < MaxSymbolSize) || m_windowPos + MaxSymbolOutput > m_window.size())
+			return m_windowPos != windowPos || reader.BP != inputBitPos;
+
+		if(!INTERNAL::InflateHuffmanSymbol(m_window, m_windowPos, reader, m_treeLL, m_treeD, done))
+		{
+			m_state = State::Error;
+			return false;
+		}
+	}
+
+	m_state = m_finalBlock ? State::Done : State::BlockHeader;
+	return true;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] usize TRAP::Utils::Decompress::Inflater::Drain(const std::span<u8> output) noexcept
+{
+	ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None &&
+	                                          (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	const usize count = Math::Min(output.size(), m_windowPos - m_drainPos);
+	std::copy_n(m_window.data() + m_drainPos, count, output.data());
+	m_drainPos += count;
+
+	return count;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::Utils::Decompress::Inflater::SlideWindow() noexcept
+{
+	ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None &&
+	                                          (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	TRAP_ASSERT(m_drainPos == m_windowPos, "Inflater::SlideWindow(): Window must be drained!");
+
+	//Enough space left for the fast path
+	if(m_windowPos + INTERNAL::FastPathOutputSlack <= m_window.size())
+		return;
+
+	const usize keep = Math::Min(m_windowPos, WindowHistorySize);
+	std::copy_n(m_window.data() + m_windowPos - keep, keep, m_window.data());
+	m_windowPos = keep;
+	m_drainPos = keep;
+}
@@ -0,0 +1,132 @@
+#ifndef TRAP_INFLATER_H
+#define TRAP_INFLATER_H
+
+#include <span>
+#include <vector>
+
+#include "Core/Types.h"
+#include "Inflate.h"
+#include "Utils/Optional.h"
+
+namespace TRAP::Utils::Decompress
+{
+	/// @brief Resumable inflate decoder.
+	///
+	///        Unlike Inflate() the compressed data doesn't need to be available at once and the size of the
+	///        decompressed data doesn't need to be known in advance.
+	///        Compressed data is fed in any amount of pieces via AppendInput() and decompressed data is
+	///        retrieved in caller provided chunks via Inflate(), which decodes as far as the available input allows.
+	///        Only the 32 KiB deflate window and the not yet consumed input are kept in memory.
+	class Inflater
+	{
+	public:
+		enum class Status : u8
+		{
+			/// @brief More input or more output space is needed to continue.
+			Running,
+			/// @brief The end of the deflate stream was reached and all output was retrieved.
+			Done,
+			/// @brief The deflate stream is invalid.
+			Error
+		};
+
+		/// @brief Constructor.
+		Inflater();
+
+		/// @brief Copy constructor.
+		consteval Inflater(const Inflater&) = delete;
+		/// @brief Copy assignment operator.
+		consteval Inflater& operator=(const Inflater&) = delete;
+		/// @brief Move constructor.
+		Inflater(Inflater&&) noexcept = default;
+		/// @brief Move assignment operator.
+		Inflater& operator=(Inflater&&) noexcept = default;
+
+		/// @brief Destructor.
+		~Inflater() = default;
+
+		/// @brief Append compressed data.
+		/// @param input Compressed data, gets copied.
+		void AppendInput(std::span<const u8> input);
+		/// @brief Signal that all compressed data was appended.
+		///        Afterwards the remaining input gets decoded even if it may not be enough for a whole symbol.
+		void FinishInput() noexcept;
+
+		/// @brief Decompress data into the given output.
+		/// @param output Destination for decompressed data.
+		/// @return Amount of bytes written to output.
+		///         If less than output.size() bytes were written the inflater either needs more input,
+		///         is done or encountered an error, see GetStatus().
+		[[nodiscard]] usize Inflate(std::span<u8> output);
+
+		/// @brief Retrieve the current status.
+		/// @return Current status.
+		[[nodiscard]] constexpr Status GetStatus() const noexcept;
+
+		/// @brief Retrieve the input that follows the end of the deflate stream (i.e. the Adler32 checksum of zlib).
+		/// @return Input following the deflate stream, empty if the end of the stream wasn't reached yet.
+		[[nodiscard]] std::span<const u8> GetTrailingInput() const noexcept;
+
+	private:
+		enum class State : u8
+		{
+			BlockHeader,
+			StoredBlock,
+			HuffmanBlock,
+			Done,
+			Error
+		};
+
+		/// @brief Decode as much as the available input and window space allows.
+		void Decode();
+		/// @brief Decode the header of the next block.
+		/// @param reader BitReader.
+		/// @return False if more input is needed, true otherwise.
+		[[nodiscard]] bool DecodeBlockHeader(INTERNAL::BitReader& reader);
+		/// @brief Copy data of the current stored block into the window.
+		/// @param reader BitReader.
+		/// @return False if more input or window space is needed, true otherwise.
+		[[nodiscard]] bool DecodeStoredBlock(INTERNAL::BitReader& reader);
+		/// @brief Decode symbols of the current huffman block into the window.
+		/// @param reader BitReader.
+		/// @return False if more input or window space is needed, true otherwise.
+		[[nodiscard]] bool DecodeHuffmanBlock(INTERNAL::BitReader& reader);
+
+		/// @brief Copy decoded data from the window to the given output.
+		/// @param output Destination for decompressed data.
+		/// @return Amount of bytes copied.
+		[[nodiscard]] usize Drain(std::span<u8> output) noexcept;
+		/// @brief Move the last 32 KiB of decoded data to the start of the window to make room for new data.
+		///        Must only be called once all data was drained.
+		void SlideWindow() noexcept;
+
+		std::vector<u8> m_input{};
+		usize m_inputBitPos = 0;
+		bool m_inputFinished = false;
+
+		std::vector<u8> m_window;
+		usize m_windowPos = 0;
+		usize m_drainPos = 0;
+
+		State m_state = State::BlockHeader;
+		bool m_finalBlock = false;
+		usize m_storedRemaining = 0;
+		INTERNAL::HuffmanTree m_treeLL{};
+		INTERNAL::HuffmanTree m_treeD{};
+		TRAP::Optional<INTERNAL::FastHuffmanTable> m_fastTable = TRAP::NullOpt;
+	};
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] constexpr TRAP::Utils::Decompress::Inflater::Status TRAP::Utils::Decompress::Inflater::GetStatus() const noexcept
+{
+	if(m_state == State::Error)
+		return Status::Error;
+	if(m_state == State::Done && m_drainPos == m_windowPos)
+		return Status::Done;
+
+	return Status::Running;
+}
+
+#endif /*TRAP_INFLATER_H*/
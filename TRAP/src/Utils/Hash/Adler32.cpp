@@ -2,32 +2,265 @@
 #include "Adler32.h"
 
 #include "Utils/Memory.h"
+#include "Utils/Utils.h"
+#include "TRAP_Assert.h"
 
-[[nodiscard]] std::array<u8, 4> TRAP::Utils::Hash::Adler32(const void* const data, u64 length)
+#include <immintrin.h>
+
+namespace
 {
-	ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None);
+	/// @brief Largest prime smaller than 65536.
+	constexpr u32 Adler32Base = 65521u;
+	/// @brief Largest amount of bytes which can be summed up before s2 may overflow.
+	constexpr u64 Adler32NMax = 5552u;
 
-	const u8* dataPtr = static_cast<const u8*>(data);
+	/// @brief Process the given data.
+	/// @param s1 Running sum of all bytes.
+	/// @param s2 Running sum of all s1 values.
+	/// @param data Data to process.
+	/// @param length Length of the data in bytes.
+	void UpdateAdler32Scalar(u32& s1, u32& s2, const u8* data, u64 length) noexcept
+	{
+		while (length != 0u)
+		{
+			//At least 5552 sums can be done before the sums overflow, saving a lot of module divisions
+			const u64 amount = length > Adler32NMax ? Adler32NMax : length;
+			length -= amount;
+			for (u64 i = 0; i != amount; ++i)
+			{
+				s1 += (*data++);
+				s2 += s1;
+			}
+			s1 %= Adler32Base;
+			s2 %= Adler32Base;
+		}
+	}
 
-	u32 s1 = 1u & 0xFFFFu;
-	u32 s2 = (1u >> 16u) & 0xFFFFu;
+	//-------------------------------------------------------------------------------------------------------------------//
 
-	while (length != 0u)
+	/// @brief Process the given data using SSSE3, 32 bytes per iteration.
+	/// @param s1 Running sum of all bytes.
+	/// @param s2 Running sum of all s1 values.
+	/// @param data Data to process.
+	/// @param length Length of the data in bytes.
+	/// @note Requires SSSE3 support.
+	TRAP_TARGET_ISA("ssse3")
+	void UpdateAdler32SSSE3(u32& s1, u32& s2, const u8* data, u64 length) noexcept
 	{
-		//At least 5552 sums can be done before the sums overflow, saving a lot of module divisions
-		const u64 amount = length > 5552u ? 5552u : length;
-		length -= amount;
-		for (u64 i = 0; i != amount; ++i)
+		static constexpr u64 BlockSize = 32;
+
+		u64 blocks = length / BlockSize;
+		length -= blocks * BlockSize;
+
+		//Weights of the bytes for s2, the first byte of a block gets added BlockSize times
+		const __m128i tap1 = _mm_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17);
+		const __m128i tap2 = _mm_setr_epi8(16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1);
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i ones = _mm_set1_epi16(1);
+
+		while(blocks != 0u)
 		{
-			s1 += (*dataPtr++);
-			s2 += s1;
+			u64 n = std::min(Adler32NMax / BlockSize, blocks);
+			blocks -= n;
+
+			//Every block adds s1 (of all previous blocks) BlockSize times to s2
+			__m128i vPrevS1Sum = _mm_cvtsi32_si128(std::bit_cast<i32>(s1 * static_cast<u32>(n)));
+			__m128i vS2 = _mm_cvtsi32_si128(std::bit_cast<i32>(s2));
+			__m128i vS1 = zero;
+
+			do
+			{
+				const __m128i bytes1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+				const __m128i bytes2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16));
+
+				vPrevS1Sum = _mm_add_epi32(vPrevS1Sum, vS1);
+
+				vS1 = _mm_add_epi32(vS1, _mm_sad_epu8(bytes1, zero));
+				vS2 = _mm_add_epi32(vS2, _mm_madd_epi16(_mm_maddubs_epi16(bytes1, tap1), ones));
+				vS1 = _mm_add_epi32(vS1, _mm_sad_epu8(bytes2, zero));
+				vS2 = _mm_add_epi32(vS2, _mm_madd_epi16(_mm_maddubs_epi16(bytes2, tap2), ones));
+
+				data += BlockSize;
+			} while(--n != 0u);
+
+			vS2 = _mm_add_epi32(vS2, _mm_slli_epi32(vPrevS1Sum, 5));
+
+			//Horizontal sums
+			vS1 = _mm_add_epi32(vS1, _mm_shuffle_epi32(vS1, _MM_SHUFFLE(1, 0, 3, 2)));
+			s1 += std::bit_cast<u32>(_mm_cvtsi128_si32(vS1));
+			vS2 = _mm_add_epi32(vS2, _mm_shuffle_epi32(vS2, _MM_SHUFFLE(2, 3, 0, 1)));
+			vS2 = _mm_add_epi32(vS2, _mm_shuffle_epi32(vS2, _MM_SHUFFLE(1, 0, 3, 2)));
+			s2 = std::bit_cast<u32>(_mm_cvtsi128_si32(vS2));
+
+			s1 %= Adler32Base;
+			s2 %= Adler32Base;
 		}
-		s1 %= 65521u;
-		s2 %= 65521u;
+
+		//Remaining 0 to 31 bytes
+		UpdateAdler32Scalar(s1, s2, data, length);
 	}
 
-	u32 adler32 = (s2 << 16u) | s1;
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Process the given data using AVX2, 32 bytes per iteration.
+	/// @param s1 Running sum of all bytes.
+	/// @param s2 Running sum of all s1 values.
+	/// @param data Data to process.
+	/// @param length Length of the data in bytes.
+	/// @note Requires AVX2 support.
+	TRAP_TARGET_ISA("avx2")
+	void UpdateAdler32AVX2(u32& s1, u32& s2, const u8* data, u64 length) noexcept
+	{
+		static constexpr u64 BlockSize = 32;
+
+		u64 blocks = length / BlockSize;
+		length -= blocks * BlockSize;
+
+		//Weights of the bytes for s2, the first byte of a block gets added BlockSize times
+		const __m256i tap = _mm256_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17,
+		                                     16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1);
+		const __m256i zero = _mm256_setzero_si256();
+		const __m256i ones = _mm256_set1_epi16(1);
+
+		while(blocks != 0u)
+		{
+			u64 n = std::min(Adler32NMax / BlockSize, blocks);
+			blocks -= n;
+
+			//Every block adds s1 (of all previous blocks) BlockSize times to s2
+			__m256i vPrevS1Sum = _mm256_setr_epi32(std::bit_cast<i32>(s1 * static_cast<u32>(n)), 0, 0, 0, 0, 0, 0, 0);
+			__m256i vS2 = _mm256_setr_epi32(std::bit_cast<i32>(s2), 0, 0, 0, 0, 0, 0, 0);
+			__m256i vS1 = zero;
+
+			do
+			{
+				const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+
+				vPrevS1Sum = _mm256_add_epi32(vPrevS1Sum, vS1);
+
+				vS1 = _mm256_add_epi32(vS1, _mm256_sad_epu8(bytes, zero));
+				vS2 = _mm256_add_epi32(vS2, _mm256_madd_epi16(_mm256_maddubs_epi16(bytes, tap), ones));
+
+				data += BlockSize;
+			} while(--n != 0u);
+
+			vS2 = _mm256_add_epi32(vS2, _mm256_slli_epi32(vPrevS1Sum, 5));
+
+			//Horizontal sums
+			__m128i s1Sum = _mm_add_epi32(_mm256_castsi256_si128(vS1), _mm256_extracti128_si256(vS1, 1));
+			s1Sum = _mm_add_epi32(s1Sum, _mm_shuffle_epi32(s1Sum, _MM_SHUFFLE(1, 0, 3, 2)));
+			s1 += std::bit_cast<u32>(_mm_cvtsi128_si32(s1Sum));
+			__m128i s2Sum = _mm_add_epi32(_mm256_castsi256_si128(vS2), _mm256_extracti128_si256(vS2, 1));
+			s2Sum = _mm_add_epi32(s2Sum, _mm_shuffle_epi32(s2Sum, _MM_SHUFFLE(2, 3, 0, 1)));
+			s2Sum = _mm_add_epi32(s2Sum, _mm_shuffle_epi32(s2Sum, _MM_SHUFFLE(1, 0, 3, 2)));
+			s2 = std::bit_cast<u32>(_mm_cvtsi128_si32(s2Sum));
+
+			s1 %= Adler32Base;
+			s2 %= Adler32Base;
+		}
+
+		//Remaining 0 to 31 bytes
+		UpdateAdler32Scalar(s1, s2, data, length);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	using PFN_UpdateAdler32 = void(*)(u32& s1, u32& s2, const u8* data, u64 length) noexcept;
+
+	/// @brief Retrieve the function for the given Adler32 implementation.
+	/// @param impl Adler32 implementation.
+	/// @return Function implementing impl.
+	[[nodiscard]] constexpr PFN_UpdateAdler32 GetUpdateAdler32(const TRAP::Utils::Hash::INTERNAL::Adler32Implementation impl) noexcept
+	{
+		switch(impl)
+		{
+		case TRAP::Utils::Hash::INTERNAL::Adler32Implementation::SSSE3:
+			return UpdateAdler32SSSE3;
+
+		case TRAP::Utils::Hash::INTERNAL::Adler32Implementation::AVX2:
+			return UpdateAdler32AVX2;
+
+		case TRAP::Utils::Hash::INTERNAL::Adler32Implementation::Scalar:
+			[[fallthrough]];
+		default:
+			return UpdateAdler32Scalar;
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Retrieve the fastest Adler32 implementation supported by the CPU.
+	/// @return Function implementing the fastest supported Adler32 implementation.
+	[[nodiscard]] PFN_UpdateAdler32 GetBestUpdateAdler32()
+	{
+		using TRAP::Utils::Hash::INTERNAL::Adler32Implementation;
+		using TRAP::Utils::Hash::INTERNAL::IsAdler32ImplementationSupported;
+
+		static const PFN_UpdateAdler32 updateAdler32 = []()
+		{
+			if(IsAdler32ImplementationSupported(Adler32Implementation::AVX2))
+				return GetUpdateAdler32(Adler32Implementation::AVX2);
+			if(IsAdler32ImplementationSupported(Adler32Implementation::SSSE3))
+				return GetUpdateAdler32(Adler32Implementation::SSSE3);
+
+			return GetUpdateAdler32(Adler32Implementation::Scalar);
+		}();
+
+		return updateAdler32;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] std::array<u8, 4> TRAP::Utils::Hash::Adler32(const void* const data, const u64 length)
+{
+	ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None);
+
+	Adler32Hasher hasher{};
+	hasher.Update(std::span<const u8>(static_cast<const u8*>(data), length));
+	return hasher.Finalize();
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] std::array<u8, 4> TRAP::Utils::Hash::Adler32(const std::string_view str)
+{
+	ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None &&
+	                                          (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	return Adler32(str.data(), str.length());
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::Utils::Hash::Adler32Hasher::Update(const std::span<const u8> data) noexcept
+{
+	ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None);
+
+	GetBestUpdateAdler32()(m_s1, m_s2, data.data(), data.size_bytes());
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::Utils::Hash::Adler32Hasher::Update(const std::string_view str) noexcept
+{
+	ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None &&
+	                                          (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	Update(Utils::AsBytes(std::span(str)));
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] std::array<u8, 4> TRAP::Utils::Hash::Adler32Hasher::Finalize() noexcept
+{
+	ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None);
+
+	u32 adler32 = (m_s2 << 16u) | m_s1;
 	Memory::SwapBytes(adler32);
+	Reset();
 
 	std::array<u8, 4> result{};
 	std::copy_n(reinterpret_cast<const u8*>(&adler32), result.size(), result.data());
@@ -35,12 +268,48 @@
 	return result;
 }
 
+//-------------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------------//
 //-------------------------------------------------------------------------------------------------------------------//
 
-[[nodiscard]] std::array<u8, 4> TRAP::Utils::Hash::Adler32(const std::string_view str)
+[[nodiscard]] bool TRAP::Utils::Hash::INTERNAL::IsAdler32ImplementationSupported(const Adler32Implementation impl)
 {
 	ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None &&
 	                                          (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
 
-	return Adler32(str.data(), str.length());
+	switch(impl)
+	{
+	case Adler32Implementation::Scalar:
+		return true;
+
+	case Adler32Implementation::SSSE3:
+		return Utils::GetCPUInfo().SSSE3;
+
+	case Adler32Implementation::AVX2:
+		return Utils::GetCPUInfo().AVX2;
+
+	default:
+		return false;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] std::array<u8, 4> TRAP::Utils::Hash::INTERNAL::Adler32(const std::span<const u8> data, const Adler32Implementation impl)
+{
+	ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None);
+
+	TRAP_ASSERT(IsAdler32ImplementationSupported(impl), "Hash::INTERNAL::Adler32(): Implementation is not supported by the CPU!");
+
+	u32 s1 = 1u;
+	u32 s2 = 0u;
+	GetUpdateAdler32(impl)(s1, s2, data.data(), data.size_bytes());
+
+	u32 adler32 = (s2 << 16u) | s1;
+	Memory::SwapBytes(adler32);
+
+	std::array<u8, 4> result{};
+	std::copy_n(reinterpret_cast<const u8*>(&adler32), result.size(), result.data());
+
+	return result;
 }
\ No newline at end of file
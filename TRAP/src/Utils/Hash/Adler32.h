@@ -2,6 +2,7 @@
 #define TRAP_ADLER32_H
 
 #include <array>
+#include <span>
 #include <string_view>
 
 #include "Core/Types.h"
@@ -17,6 +18,67 @@ namespace TRAP::Utils::Hash
 	/// @param str String to get checksum from.
 	/// @return Adler32 checksum of input.
 	[[nodiscard]] std::array<u8, 4> Adler32(std::string_view str);
+
+	/// @brief Incremental Adler32 checksum calculator.
+	///        Feed data in any amount of pieces via Update() and retrieve the checksum via Finalize().
+	///        The resulting checksum is the same as calling Adler32() with the concatenated data.
+	class Adler32Hasher
+	{
+	public:
+		/// @brief Type of the resulting checksum.
+		using HashType = std::array<u8, 4>;
+
+		/// @brief Process the given data.
+		/// @param data Data to process.
+		void Update(std::span<const u8> data) noexcept;
+		/// @brief Process the given string.
+		/// @param str String to process.
+		void Update(std::string_view str) noexcept;
+
+		/// @brief Retrieve the Adler32 checksum of all processed data.
+		///        Afterwards the hasher is reset and can be reused.
+		/// @return Adler32 checksum of processed data.
+		[[nodiscard]] HashType Finalize() noexcept;
+
+		/// @brief Reset the hasher, discarding all processed data.
+		constexpr void Reset() noexcept;
+
+	private:
+		u32 m_s1 = 1u;
+		u32 m_s2 = 0u;
+	};
+
+	namespace INTERNAL
+	{
+		/// @brief Available Adler32 implementations.
+		///        Adler32() and Adler32Hasher automatically use the fastest one supported by the CPU.
+		enum class Adler32Implementation : u8
+		{
+			Scalar,
+			SSSE3,
+			AVX2
+		};
+
+		/// @brief Check whether the given Adler32 implementation is supported by the CPU.
+		/// @param impl Adler32 implementation.
+		/// @return True if supported, false otherwise.
+		[[nodiscard]] bool IsAdler32ImplementationSupported(Adler32Implementation impl);
+
+		/// @brief Retrieve the Adler32 checksum of the given data using a specific implementation.
+		/// @param data Data to get checksum from.
+		/// @param impl Adler32 implementation to use, must be supported by the CPU.
+		/// @return Adler32 checksum of input.
+		/// @note Only intended for testing and benchmarking.
+		[[nodiscard]] std::array<u8, 4> Adler32(std::span<const u8> data, Adler32Implementation impl);
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+constexpr void TRAP::Utils::Hash::Adler32Hasher::Reset() noexcept
+{
+	m_s1 = 1u;
+	m_s2 = 0u;
 }
 
 #endif /*TRAP_ADLER32_H*/
\ No newline at end of file
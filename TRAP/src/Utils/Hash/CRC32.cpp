@@ -3,6 +3,9 @@
 
 #include "Utils/Utils.h"
 #include "Utils/Memory.h"
+#include "TRAP_Assert.h"
+
+#include <immintrin.h>
 
 namespace
 {
@@ -555,84 +558,285 @@ namespace
 			}
 		}
 	};
-}
-
-//-------------------------------------------------------------------------------------------------------------------//
 
-[[nodiscard]] std::array<u8, 4> TRAP::Utils::Hash::CRC32(const void* const data, u64 length)
-{
-    ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None);
+	//-------------------------------------------------------------------------------------------------------------------//
 
-	u32 crc = std::numeric_limits<u32>::max(); //Same as previousCRC32 ^ 0xFFFFFFFF
-	const u32* current = static_cast<const u32*>(data);
+	/// @brief Process the given data using slicing-by-16 lookup tables.
+	/// @param crc Current CRC value (inverted).
+	/// @param data Data to process.
+	/// @param length Length of the data in bytes.
+	/// @return Updated CRC value (inverted).
+	[[nodiscard]] u32 UpdateCRC32Scalar(u32 crc, const void* const data, u64 length) noexcept
+	{
+		const u32* current = static_cast<const u32*>(data);
 
-	//Enabling optimization (at least -O2) automatically unrolls the inner for-loop
-	const usize Unroll = 4;
-	const usize BytesAtOnce = 16 * Unroll;
+		//Enabling optimization (at least -O2) automatically unrolls the inner for-loop
+		const usize Unroll = 4;
+		const usize BytesAtOnce = 16 * Unroll;
 
-	while (length >= BytesAtOnce)
-	{
-		for (usize unrolling = 0; unrolling < Unroll; unrolling++)
+		while (length >= BytesAtOnce)
 		{
-			if constexpr (Utils::GetEndian() == Utils::Endian::Big)
+			for (usize unrolling = 0; unrolling < Unroll; unrolling++)
 			{
-				Memory::SwapBytes(crc);
-				const u32 one = *current++ ^ crc;
-				const u32 two = *current++;
-				const u32 three = *current++;
-				const u32 four = *current++;
-				crc = std::get<0>(CRC32Lookup)[four & 0xFFu] ^
-					  std::get<1>(CRC32Lookup)[(four >> 8u) & 0xFFu] ^
-					  std::get<2>(CRC32Lookup)[(four >> 16u) & 0xFFu] ^
-					  std::get<3>(CRC32Lookup)[(four >> 24u) & 0xFFu] ^
-					  std::get<4>(CRC32Lookup)[three & 0xFFu] ^
-					  std::get<5>(CRC32Lookup)[(three >> 8u) & 0xFFu] ^
-					  std::get<6>(CRC32Lookup)[(three >> 16u) & 0xFFu] ^
-					  std::get<7>(CRC32Lookup)[(three >> 24u) & 0xFFu] ^
-					  std::get<8>(CRC32Lookup)[two & 0xFFu] ^
-					  std::get<9>(CRC32Lookup)[(two >> 8u) & 0xFFu] ^
-					  std::get<10>(CRC32Lookup)[(two >> 16u) & 0xFFu] ^
-					  std::get<11>(CRC32Lookup)[(two >> 24u) & 0xFFu] ^
-					  std::get<12>(CRC32Lookup)[one & 0xFFu] ^
-					  std::get<13>(CRC32Lookup)[(one >> 8u) & 0xFFu] ^
-					  std::get<14>(CRC32Lookup)[(one >> 16u) & 0xFFu] ^
-					  std::get<15>(CRC32Lookup)[(one >> 24u) & 0xFFu];
-			}
-			else
-			{
-				const u32 one = *current++ ^ crc;
-				const u32 two = *current++;
-				const u32 three = *current++;
-				const u32 four = *current++;
-				crc = std::get<0>(CRC32Lookup)[(four >> 24u) & 0xFFu] ^
-					  std::get<1>(CRC32Lookup)[(four >> 16u) & 0xFFu] ^
-					  std::get<2>(CRC32Lookup)[(four >> 8u) & 0xFFu] ^
-					  std::get<3>(CRC32Lookup)[four & 0xFFu] ^
-					  std::get<4>(CRC32Lookup)[(three >> 24u) & 0xFFu] ^
-					  std::get<5>(CRC32Lookup)[(three >> 16u) & 0xFFu] ^
-					  std::get<6>(CRC32Lookup)[(three >> 8u) & 0xFFu] ^
-					  std::get<7>(CRC32Lookup)[three & 0xFFu] ^
-					  std::get<8>(CRC32Lookup)[(two >> 24u) & 0xFFu] ^
-					  std::get<9>(CRC32Lookup)[(two >> 16u) & 0xFFu] ^
-					  std::get<10>(CRC32Lookup)[(two >> 8u) & 0xFFu] ^
-					  std::get<11>(CRC32Lookup)[two & 0xFFu] ^
-					  std::get<12>(CRC32Lookup)[(one >> 24u) & 0xFFu] ^
-					  std::get<13>(CRC32Lookup)[(one >> 16u) & 0xFFu] ^
-					  std::get<14>(CRC32Lookup)[(one >> 8u) & 0xFFu] ^
-					  std::get<15>(CRC32Lookup)[one & 0xFFu];
+				if constexpr (TRAP::Utils::GetEndian() == TRAP::Utils::Endian::Big)
+				{
+					TRAP::Utils::Memory::SwapBytes(crc);
+					const u32 one = *current++ ^ crc;
+					const u32 two = *current++;
+					const u32 three = *current++;
+					const u32 four = *current++;
+					crc = std::get<0>(CRC32Lookup)[four & 0xFFu] ^
+						  std::get<1>(CRC32Lookup)[(four >> 8u) & 0xFFu] ^
+						  std::get<2>(CRC32Lookup)[(four >> 16u) & 0xFFu] ^
+						  std::get<3>(CRC32Lookup)[(four >> 24u) & 0xFFu] ^
+						  std::get<4>(CRC32Lookup)[three & 0xFFu] ^
+						  std::get<5>(CRC32Lookup)[(three >> 8u) & 0xFFu] ^
+						  std::get<6>(CRC32Lookup)[(three >> 16u) & 0xFFu] ^
+						  std::get<7>(CRC32Lookup)[(three >> 24u) & 0xFFu] ^
+						  std::get<8>(CRC32Lookup)[two & 0xFFu] ^
+						  std::get<9>(CRC32Lookup)[(two >> 8u) & 0xFFu] ^
+						  std::get<10>(CRC32Lookup)[(two >> 16u) & 0xFFu] ^
+						  std::get<11>(CRC32Lookup)[(two >> 24u) & 0xFFu] ^
+						  std::get<12>(CRC32Lookup)[one & 0xFFu] ^
+						  std::get<13>(CRC32Lookup)[(one >> 8u) & 0xFFu] ^
+						  std::get<14>(CRC32Lookup)[(one >> 16u) & 0xFFu] ^
+						  std::get<15>(CRC32Lookup)[(one >> 24u) & 0xFFu];
+				}
+				else
+				{
+					const u32 one = *current++ ^ crc;
+					const u32 two = *current++;
+					const u32 three = *current++;
+					const u32 four = *current++;
+					crc = std::get<0>(CRC32Lookup)[(four >> 24u) & 0xFFu] ^
+						  std::get<1>(CRC32Lookup)[(four >> 16u) & 0xFFu] ^
+						  std::get<2>(CRC32Lookup)[(four >> 8u) & 0xFFu] ^
+						  std::get<3>(CRC32Lookup)[four & 0xFFu] ^
+						  std::get<4>(CRC32Lookup)[(three >> 24u) & 0xFFu] ^
+						  std::get<5>(CRC32Lookup)[(three >> 16u) & 0xFFu] ^
+						  std::get<6>(CRC32Lookup)[(three >> 8u) & 0xFFu] ^
+						  std::get<7>(CRC32Lookup)[three & 0xFFu] ^
+						  std::get<8>(CRC32Lookup)[(two >> 24u) & 0xFFu] ^
+						  std::get<9>(CRC32Lookup)[(two >> 16u) & 0xFFu] ^
+						  std::get<10>(CRC32Lookup)[(two >> 8u) & 0xFFu] ^
+						  std::get<11>(CRC32Lookup)[two & 0xFFu] ^
+						  std::get<12>(CRC32Lookup)[(one >> 24u) & 0xFFu] ^
+						  std::get<13>(CRC32Lookup)[(one >> 16u) & 0xFFu] ^
+						  std::get<14>(CRC32Lookup)[(one >> 8u) & 0xFFu] ^
+						  std::get<15>(CRC32Lookup)[one & 0xFFu];
+				}
 			}
+
+			length -= BytesAtOnce;
 		}
 
-		length -= BytesAtOnce;
+		const u8* currentChar = reinterpret_cast<const u8*>(current);
+		//Remaining 1 to 63 bytes (standard algorithm)
+		while (length-- != 0)
+			crc = (crc >> 8u) ^ std::get<0>(CRC32Lookup)[(crc & 0xFFu) ^ *currentChar++];
+
+		return crc;
 	}
 
-	const u8* currentChar = reinterpret_cast<const u8*>(current);
-	//Remaining 1 to 63 bytes (standard algorithm)
-	while (length-- != 0)
-		crc = (crc >> 8u) ^ std::get<0>(CRC32Lookup)[(crc & 0xFFu) ^ *currentChar++];
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	//Folding constants for the reflected CRC32 polynomial 0x04C11DB7.
+	//See "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction" by Intel.
+	alignas(16) constexpr std::array<u64, 2> CRC32K1K2{0x0154442BD4u, 0x01C6E41596u}; //Fold by 4 (x^(4*128+32), x^(4*128-32))
+	alignas(16) constexpr std::array<u64, 2> CRC32K3K4{0x01751997D0u, 0x00CCAA009Eu}; //Fold by 1 (x^(128+32), x^(128-32))
+	alignas(16) constexpr std::array<u64, 2> CRC32K5K0{0x0163CD6124u, 0x0000000000u}; //Fold 96 to 64 bits
+	alignas(16) constexpr std::array<u64, 2> CRC32Poly{0x01DB710641u, 0x01F7011641u}; //Polynomial and its Barrett constant
+
+	/// @brief Fold a 16 byte block into the next one.
+	/// @param x Block to fold.
+	/// @param next Next block.
+	/// @param k Folding constants.
+	/// @return Folded block.
+	TRAP_TARGET_ISA("pclmul,sse4.1")
+	[[nodiscard]] inline __m128i FoldBy1(const __m128i x, const __m128i next, const __m128i k) noexcept
+	{
+		const __m128i low = _mm_clmulepi64_si128(x, k, 0x00);
+		const __m128i high = _mm_clmulepi64_si128(x, k, 0x11);
+		return _mm_xor_si128(_mm_xor_si128(high, low), next);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Process the given data using carry-less multiplication.
+	/// @param crc Current CRC value (inverted).
+	/// @param data Data to process.
+	/// @param length Length of the data in bytes.
+	/// @return Updated CRC value (inverted).
+	/// @note Requires PCLMULQDQ and SSE4.1 support.
+	TRAP_TARGET_ISA("pclmul,sse4.1")
+	[[nodiscard]] u32 UpdateCRC32PCLMULQDQ(u32 crc, const void* const data, u64 length) noexcept
+	{
+		//Folding needs at least 64 bytes
+		if(length < 64)
+			return UpdateCRC32Scalar(crc, data, length);
+
+		const u8* buffer = static_cast<const u8*>(data);
+
+		__m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer + 0x00));
+		__m128i x2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer + 0x10));
+		__m128i x3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer + 0x20));
+		__m128i x4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer + 0x30));
+		x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(std::bit_cast<i32>(crc)));
+		buffer += 64;
+		length -= 64;
+
+		//Fold 4 blocks of 16 bytes in parallel
+		__m128i k = _mm_load_si128(reinterpret_cast<const __m128i*>(CRC32K1K2.data()));
+		while(length >= 64)
+		{
+			const __m128i x5 = _mm_clmulepi64_si128(x1, k, 0x00);
+			const __m128i x6 = _mm_clmulepi64_si128(x2, k, 0x00);
+			const __m128i x7 = _mm_clmulepi64_si128(x3, k, 0x00);
+			const __m128i x8 = _mm_clmulepi64_si128(x4, k, 0x00);
+
+			x1 = _mm_clmulepi64_si128(x1, k, 0x11);
+			x2 = _mm_clmulepi64_si128(x2, k, 0x11);
+			x3 = _mm_clmulepi64_si128(x3, k, 0x11);
+			x4 = _mm_clmulepi64_si128(x4, k, 0x11);
+
+			x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer + 0x00)));
+			x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer + 0x10)));
+			x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer + 0x20)));
+			x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer + 0x30)));
+
+			buffer += 64;
+			length -= 64;
+		}
+
+		//Fold the 4 blocks into a single one
+		k = _mm_load_si128(reinterpret_cast<const __m128i*>(CRC32K3K4.data()));
+		x1 = FoldBy1(x1, x2, k);
+		x1 = FoldBy1(x1, x3, k);
+		x1 = FoldBy1(x1, x4, k);
+
+		//Fold remaining blocks of 16 bytes
+		while(length >= 16)
+		{
+			x1 = FoldBy1(x1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer)), k);
+			buffer += 16;
+			length -= 16;
+		}
+
+		//Fold 128 to 64 bits
+		const __m128i mask32 = _mm_setr_epi32(-1, 0, -1, 0);
+		x2 = _mm_clmulepi64_si128(x1, k, 0x10);
+		x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+
+		k = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(CRC32K5K0.data()));
+		x2 = _mm_srli_si128(x1, 4);
+		x1 = _mm_and_si128(x1, mask32);
+		x1 = _mm_clmulepi64_si128(x1, k, 0x00);
+		x1 = _mm_xor_si128(x1, x2);
+
+		//Barrett reduction to 32 bits
+		k = _mm_load_si128(reinterpret_cast<const __m128i*>(CRC32Poly.data()));
+		x2 = _mm_and_si128(x1, mask32);
+		x2 = _mm_clmulepi64_si128(x2, k, 0x10);
+		x2 = _mm_and_si128(x2, mask32);
+		x2 = _mm_clmulepi64_si128(x2, k, 0x00);
+		x1 = _mm_xor_si128(x1, x2);
+
+		crc = std::bit_cast<u32>(_mm_extract_epi32(x1, 1));
+
+		//Remaining 0 to 15 bytes
+		return UpdateCRC32Scalar(crc, buffer, length);
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	using PFN_UpdateCRC32 = u32(*)(u32 crc, const void* data, u64 length) noexcept;
+
+	/// @brief Retrieve the implementation for the given CRC32 implementation.
+	/// @param impl CRC32 implementation.
+	/// @return Function implementing impl.
+	[[nodiscard]] constexpr PFN_UpdateCRC32 GetUpdateCRC32(const TRAP::Utils::Hash::INTERNAL::CRC32Implementation impl) noexcept
+	{
+		switch(impl)
+		{
+		case TRAP::Utils::Hash::INTERNAL::CRC32Implementation::PCLMULQDQ:
+			return UpdateCRC32PCLMULQDQ;
+
+		case TRAP::Utils::Hash::INTERNAL::CRC32Implementation::Scalar:
+			[[fallthrough]];
+		default:
+			return UpdateCRC32Scalar;
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------------------------------//
+
+	/// @brief Retrieve the fastest CRC32 implementation supported by the CPU.
+	/// @return Function implementing the fastest supported CRC32 implementation.
+	[[nodiscard]] PFN_UpdateCRC32 GetBestUpdateCRC32()
+	{
+		using TRAP::Utils::Hash::INTERNAL::CRC32Implementation;
+
+		static const PFN_UpdateCRC32 updateCRC32 = GetUpdateCRC32
+		(
+			TRAP::Utils::Hash::INTERNAL::IsCRC32ImplementationSupported(CRC32Implementation::PCLMULQDQ) ?
+			CRC32Implementation::PCLMULQDQ : CRC32Implementation::Scalar
+		);
+
+		return updateCRC32;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] std::array<u8, 4> TRAP::Utils::Hash::CRC32(const void* const data, const u64 length)
+{
+    ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None);
 
-	crc = ~crc; //Same as crc ^ 0xFFFFFFFF
+	CRC32Hasher hasher{};
+	hasher.Update(std::span<const u8>(static_cast<const u8*>(data), length));
+	return hasher.Finalize();
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] std::array<u8, 4> TRAP::Utils::Hash::CRC32(const std::string_view str)
+{
+    ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None &&
+	                                          (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	return CRC32(str.data(), str.length());
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::Utils::Hash::CRC32Hasher::Update(const std::span<const u8> data) noexcept
+{
+    ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None);
+
+	m_crc = GetBestUpdateCRC32()(m_crc, data.data(), data.size_bytes());
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::Utils::Hash::CRC32Hasher::Update(const std::string_view str) noexcept
+{
+    ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None &&
+	                                          (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	Update(Utils::AsBytes(std::span(str)));
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] std::array<u8, 4> TRAP::Utils::Hash::CRC32Hasher::Finalize() noexcept
+{
+    ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None);
+
+	u32 crc = ~m_crc; //Same as crc ^ 0xFFFFFFFF
 	Memory::SwapBytes(crc);
+	Reset();
 
 	std::array<u8, 4> result{};
 	std::copy_n(reinterpret_cast<const u8*>(&crc), result.size(), result.data());
@@ -640,12 +844,42 @@ namespace
 	return result;
 }
 
+
+//-------------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------------//
 //-------------------------------------------------------------------------------------------------------------------//
 
-[[nodiscard]] std::array<u8, 4> TRAP::Utils::Hash::CRC32(const std::string_view str)
+[[nodiscard]] bool TRAP::Utils::Hash::INTERNAL::IsCRC32ImplementationSupported(const CRC32Implementation impl)
 {
-    ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None &&
+	ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None &&
 	                                          (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
 
-	return CRC32(str.data(), str.length());
+	switch(impl)
+	{
+	case CRC32Implementation::Scalar:
+		return true;
+
+	case CRC32Implementation::PCLMULQDQ:
+		return Utils::GetCPUInfo().PCLMULQDQ && Utils::GetCPUInfo().SSE4_1;
+
+	default:
+		return false;
+	}
 }
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] std::array<u8, 4> TRAP::Utils::Hash::INTERNAL::CRC32(const std::span<const u8> data, const CRC32Implementation impl)
+{
+	ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None);
+
+	TRAP_ASSERT(IsCRC32ImplementationSupported(impl), "Hash::INTERNAL::CRC32(): Implementation is not supported by the CPU!");
+
+	u32 crc = ~GetUpdateCRC32(impl)(0xFFFFFFFFu, data.data(), data.size_bytes());
+	Memory::SwapBytes(crc);
+
+	std::array<u8, 4> result{};
+	std::copy_n(reinterpret_cast<const u8*>(&crc), result.size(), result.data());
+
+	return result;
+}
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define TRAP_CRC32_H
 
 #include <array>
+#include <span>
 #include <string_view>
 
 #include "Core/Types.h"
@@ -17,6 +18,64 @@ namespace TRAP::Utils::Hash
 	/// @param str String to get hash from.
 	/// @return CRC32 hash of input.
 	[[nodiscard]] std::array<u8, 4> CRC32(std::string_view str);
+
+	/// @brief Incremental CRC32 hasher.
+	///        Feed data in any amount of pieces via Update() and retrieve the hash via Finalize().
+	///        The resulting hash is the same as calling CRC32() with the concatenated data.
+	class CRC32Hasher
+	{
+	public:
+		/// @brief Type of the resulting hash.
+		using HashType = std::array<u8, 4>;
+
+		/// @brief Process the given data.
+		/// @param data Data to process.
+		void Update(std::span<const u8> data) noexcept;
+		/// @brief Process the given string.
+		/// @param str String to process.
+		void Update(std::string_view str) noexcept;
+
+		/// @brief Retrieve the CRC32 hash of all processed data.
+		///        Afterwards the hasher is reset and can be reused.
+		/// @return CRC32 hash of processed data.
+		[[nodiscard]] HashType Finalize() noexcept;
+
+		/// @brief Reset the hasher, discarding all processed data.
+		constexpr void Reset() noexcept;
+
+	private:
+		u32 m_crc = 0xFFFFFFFFu;
+	};
+
+	namespace INTERNAL
+	{
+		/// @brief Available CRC32 implementations.
+		///        CRC32() and CRC32Hasher automatically use the fastest one supported by the CPU.
+		enum class CRC32Implementation : u8
+		{
+			Scalar,
+			PCLMULQDQ
+		};
+
+		/// @brief Check whether the given CRC32 implementation is supported by the CPU.
+		/// @param impl CRC32 implementation.
+		/// @return True if supported, false otherwise.
+		[[nodiscard]] bool IsCRC32ImplementationSupported(CRC32Implementation impl);
+
+		/// @brief Retrieve the CRC32 hash of the given data using a specific implementation.
+		/// @param data Data to get hash from.
+		/// @param impl CRC32 implementation to use, must be supported by the CPU.
+		/// @return CRC32 hash of input.
+		/// @note Only intended for testing and benchmarking.
+		[[nodiscard]] std::array<u8, 4> CRC32(std::span<const u8> data, CRC32Implementation impl);
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+constexpr void TRAP::Utils::Hash::CRC32Hasher::Reset() noexcept
+{
+	m_crc = 0xFFFFFFFFu;
 }
 
 #endif /*TRAP_CRC32_H*/
\ No newline at end of file
@@ -0,0 +1,97 @@
+#include "TRAPPCH.h"
+#include "HashFile.h"
+
+#include "ThreadPool/Parallel.h"
+
+namespace
+{
+	/// @brief Files up to this size are read as a whole and hashed with SHA2_256Batch().
+	constexpr u64 SmallFileSize = 64u * 1024u;
+
+	/// @brief Amount of files processed per ThreadPool task at least.
+	constexpr usize FilesPerTask = 8;
+
+	/// @brief Read the whole content of the given file.
+	/// @param path File path.
+	/// @param fileSize Size of the file in bytes.
+	/// @return File content on success, empty optional otherwise.
+	[[nodiscard]] TRAP::Optional<std::vector<u8>> ReadSmallFile(const std::filesystem::path& path, const u64 fileSize)
+	{
+		std::ifstream file(path, std::ios::binary);
+		if(!file.is_open() || !file.good())
+		{
+			TP_ERROR(TRAP::Log::FileSystemPrefix, "Couldn't hash file: ", path, " (failed to open file)!");
+			return TRAP::NullOpt;
+		}
+
+		std::vector<u8> content(fileSize);
+		file.read(reinterpret_cast<char*>(content.data()), NumericCast<std::streamsize>(content.size()));
+		if(file.fail())
+		{
+			TP_ERROR(TRAP::Log::FileSystemPrefix, "Couldn't hash file: ", path, " (failed to read data)!");
+			return TRAP::NullOpt;
+		}
+
+		return content;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] std::vector<TRAP::Optional<std::array<u8, 32>>> TRAP::Utils::Hash::HashFiles(ThreadPool& threadPool,
+                                                                                           const std::span<const std::filesystem::path> paths)
+{
+	ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None);
+
+	std::vector<TRAP::Optional<std::array<u8, 32>>> results(paths.size());
+
+	ParallelFor(threadPool, usize(0), paths.size(), FilesPerTask, [&](const usize begin, const usize end)
+	{
+		std::vector<std::vector<u8>> smallFiles{};
+		std::vector<usize> smallFileIndices{};
+
+		for(usize i = begin; i < end; ++i)
+		{
+			std::error_code ec{};
+			const u64 fileSize = std::filesystem::file_size(paths[i], ec);
+			if(ec)
+			{
+				TP_ERROR(Log::FileSystemPrefix, "Couldn't hash file: ", paths[i], " (", ec.message(), ")!");
+				continue;
+			}
+
+			if(fileSize > SmallFileSize)
+			{
+				results[i] = HashFile<SHA2_256Hasher>(paths[i]);
+				continue;
+			}
+
+			auto content = ReadSmallFile(paths[i], fileSize);
+			if(!content)
+				continue;
+
+			smallFiles.push_back(std::move(*content));
+			smallFileIndices.push_back(i);
+		}
+
+		if(smallFiles.empty())
+			return;
+
+		const std::vector<std::span<const u8>> messages(smallFiles.begin(), smallFiles.end());
+		const std::vector<std::array<u8, 32>> hashes = SHA2_256Batch(messages);
+		for(usize i = 0; i < hashes.size(); ++i)
+			results[smallFileIndices[i]] = hashes[i];
+	});
+
+	return results;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] std::vector<TRAP::Optional<std::array<u8, 32>>> TRAP::Utils::Hash::HashFiles(const std::span<const std::filesystem::path> paths)
+{
+	ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None &&
+	                                          (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	return HashFiles(TRAP::INTERNAL::GetParallelThreadPool(), paths);
+}
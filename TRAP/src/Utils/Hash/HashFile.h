@@ -0,0 +1,109 @@
+#ifndef TRAP_HASHFILE_H
+#define TRAP_HASHFILE_H
+
+#include <array>
+#include <concepts>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <vector>
+
+#ifdef _MSC_VER
+	#pragma warning(push, 0)
+#endif /*_MSC_VER*/
+//Tracy - Profiler
+#include <tracy/Tracy.hpp>
+#ifdef _MSC_VER
+	#pragma warning(pop)
+#endif /*_MSC_VER*/
+
+#include "Core/Base.h"
+#include "Core/Types.h"
+#include "Log/Log.h"
+#include "TRAP_Assert.h"
+#include "Utils/Optional.h"
+
+#include "Adler32.h"
+#include "CRC32.h"
+#include "SHA-2.h"
+#include "SHA-3.h"
+
+namespace TRAP
+{
+	class ThreadPool;
+}
+
+namespace TRAP::Utils::Hash
+{
+	/// @brief Concept for incremental hashers like CRC32Hasher or SHA2_256Hasher.
+	template<typename T>
+	concept IncrementalHasher = std::default_initializable<T> && requires(T hasher, std::span<const u8> data)
+	{
+		typename T::HashType;
+		hasher.Update(data);
+		{ hasher.Finalize() } -> std::same_as<typename T::HashType>;
+	};
+
+	/// @brief Size of the chunks in which HashFile() reads files.
+	inline constexpr usize HashFileChunkSize = 64u * 1024u;
+
+	/// @brief Retrieve the hash of the given file.
+	///        The file is read in chunks of HashFileChunkSize bytes, so memory usage
+	///        stays constant regardless of the file size.
+	/// @tparam Hasher Incremental hasher to use, i.e. SHA2_256Hasher.
+	/// @param path File path.
+	/// @return Hash of the file content on success, empty optional otherwise.
+	template<IncrementalHasher Hasher>
+	[[nodiscard]] TRAP::Optional<typename Hasher::HashType> HashFile(const std::filesystem::path& path);
+
+	/// @brief Retrieve the SHA2 256 hashes of the given files.
+	///        Files are read and hashed on the given ThreadPool, so reading one file overlaps with hashing others.
+	///        Small files are read as a whole and hashed together via SHA2_256Batch(),
+	///        bigger files are streamed in chunks like HashFile() does.
+	/// @param threadPool ThreadPool to use.
+	/// @param paths File paths.
+	/// @return SHA2 256 hash for every file in paths, empty optional for files that couldn't be read.
+	[[nodiscard]] std::vector<TRAP::Optional<std::array<u8, 32>>> HashFiles(ThreadPool& threadPool,
+	                                                                          std::span<const std::filesystem::path> paths);
+	/// @brief Retrieve the SHA2 256 hashes of the given files using the engine ThreadPool.
+	/// @param paths File paths.
+	/// @return SHA2 256 hash for every file in paths, empty optional for files that couldn't be read.
+	/// @note See HashFiles(ThreadPool&, std::span<const std::filesystem::path>) for details.
+	[[nodiscard]] std::vector<TRAP::Optional<std::array<u8, 32>>> HashFiles(std::span<const std::filesystem::path> paths);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+template<TRAP::Utils::Hash::IncrementalHasher Hasher>
+[[nodiscard]] TRAP::Optional<typename Hasher::HashType> TRAP::Utils::Hash::HashFile(const std::filesystem::path& path)
+{
+	ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None);
+
+	TRAP_ASSERT(!path.empty(), "Hash::HashFile(): Path is empty!");
+
+	std::ifstream file(path, std::ios::binary);
+	if(!file.is_open() || !file.good())
+	{
+		TP_ERROR(Log::FileSystemPrefix, "Couldn't hash file: ", path, " (failed to open file)!");
+		return TRAP::NullOpt;
+	}
+
+	Hasher hasher{};
+	std::vector<u8> chunk(HashFileChunkSize);
+
+	while(file)
+	{
+		file.read(reinterpret_cast<char*>(chunk.data()), static_cast<std::streamsize>(chunk.size()));
+		if(file.bad())
+		{
+			TP_ERROR(Log::FileSystemPrefix, "Couldn't hash file: ", path, " (failed to read data)!");
+			return TRAP::NullOpt;
+		}
+
+		hasher.Update(std::span<const u8>(chunk.data(), static_cast<usize>(file.gcount())));
+	}
+
+	return hasher.Finalize();
+}
+
+#endif /*TRAP_HASHFILE_H*/
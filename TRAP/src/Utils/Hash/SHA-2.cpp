@@ -2,6 +2,10 @@
 #include "SHA-2.h"
 
 #include "Utils/Memory.h"
+#include "Utils/Utils.h"
+#include "TRAP_Assert.h"
+
+#include <immintrin.h>
 
 namespace
 {
@@ -158,7 +162,7 @@ namespace
 
 //-------------------------------------------------------------------------------------------------------------------//
 
-void Transform(const void* const mp, const u64 numBlks, std::array<u32, 8>& hash)
+void TransformScalar(const void* const mp, const u64 numBlks, std::array<u32, 8>& hash)
 {
     ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None);
 
@@ -214,6 +218,89 @@ void Transform(const void* const mp, const u64 numBlks, std::array<u32, 8>& hash
 
 //-------------------------------------------------------------------------------------------------------------------//
 
+/// @brief Process SHA2 256 blocks using the SHA extensions.
+/// @param mp Blocks to process.
+/// @param numBlks Amount of 64 byte blocks.
+/// @param hash Current hash state.
+/// @note Requires SHA, SSSE3 and SSE4.1 support.
+TRAP_TARGET_ISA("sha,ssse3,sse4.1")
+void TransformSHANI(const void* const mp, const u64 numBlks, std::array<u32, 8>& hash)
+{
+    ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None);
+
+	const u8* data = static_cast<const u8*>(mp);
+	const __m128i byteSwapMask = _mm_set_epi64x(0x0C0D0E0F08090A0Bll, 0x0405060700010203ll);
+
+	//The SHA instructions expect the state as ABEF and CDGH
+	__m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hash.data())), 0xB1); //CDAB
+	__m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hash.data() + 4)), 0x1B); //EFGH
+	__m128i state0 = _mm_alignr_epi8(tmp, state1, 8); //ABEF
+	state1 = _mm_blend_epi16(state1, tmp, 0xF0); //CDGH
+
+	for(u64 blk = 0; blk < numBlks; ++blk, data += 64)
+	{
+		const __m128i abefSave = state0;
+		const __m128i cdghSave = state1;
+
+		//C arrays, attributes of vector types get lost in template arguments
+		__m128i msg[4]{};
+		for(u32 i = 0; i < 4; ++i)
+			msg[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i * 16)), byteSwapMask);
+
+		//16 groups of 4 rounds, the message schedule runs alongside
+		for(u32 g = 0; g < 16; ++g)
+		{
+			__m128i& cur = msg[g % 4];
+			__m128i& prev = msg[(g + 3) % 4];
+			__m128i& next = msg[(g + 1) % 4];
+
+			__m128i rndMsg = _mm_add_epi32(cur, _mm_loadu_si128(reinterpret_cast<const __m128i*>(SHA256_K.data() + g * 4)));
+			state1 = _mm_sha256rnds2_epu32(state1, state0, rndMsg);
+			if(g >= 3 && g <= 14)
+			{
+				next = _mm_add_epi32(next, _mm_alignr_epi8(cur, prev, 4));
+				next = _mm_sha256msg2_epu32(next, cur);
+			}
+			rndMsg = _mm_shuffle_epi32(rndMsg, 0x0E);
+			state0 = _mm_sha256rnds2_epu32(state0, state1, rndMsg);
+			if(g >= 1 && g <= 12)
+				prev = _mm_sha256msg1_epu32(prev, cur);
+		}
+
+		state0 = _mm_add_epi32(state0, abefSave);
+		state1 = _mm_add_epi32(state1, cdghSave);
+	}
+
+	tmp = _mm_shuffle_epi32(state0, 0x1B); //FEBA
+	state1 = _mm_shuffle_epi32(state1, 0xB1); //DCHG
+	state0 = _mm_blend_epi16(tmp, state1, 0xF0); //DCBA
+	state1 = _mm_alignr_epi8(state1, tmp, 8); //HGFE
+
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(hash.data()), state0);
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(hash.data() + 4), state1);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+using PFN_TransformSHA256 = void(*)(const void* mp, u64 numBlks, std::array<u32, 8>& hash);
+
+/// @brief Process SHA2 256 blocks using the fastest implementation supported by the CPU.
+/// @param mp Blocks to process.
+/// @param numBlks Amount of 64 byte blocks.
+/// @param hash Current hash state.
+void Transform(const void* const mp, const u64 numBlks, std::array<u32, 8>& hash)
+{
+	using TRAP::Utils::Hash::INTERNAL::SHA2_256Implementation;
+
+	static const PFN_TransformSHA256 transform =
+		TRAP::Utils::Hash::INTERNAL::IsSHA2_256ImplementationSupported(SHA2_256Implementation::SHANI) ?
+		TransformSHANI : TransformScalar;
+
+	transform(mp, numBlks, hash);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
 void Transform(const void* const mp, const u64 numBlks, std::array<u64, 8>& hash)
 {
     ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None);
@@ -269,53 +356,110 @@ void Transform(const void* const mp, const u64 numBlks, std::array<u64, 8>& hash
 
 //-------------------------------------------------------------------------------------------------------------------//
 
-[[nodiscard]] std::array<u8, 32> TRAP::Utils::Hash::SHA2_256(const void* const data, u64 length)
+/// @brief Buffer the given data and transform every completed block.
+/// @param data Data to process.
+/// @param block Buffer holding the current incomplete block.
+/// @param blockPos Amount of bytes buffered in block.
+/// @param hash Current hash state.
+template<typename T, usize BlockSize>
+void UpdateSHA2(std::span<const u8> data, std::array<u8, BlockSize>& block, usize& blockPos, std::array<T, 8>& hash)
 {
-    ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None);
-
-	std::array<u32, 8> hash =
+	//Fill up a partially buffered block first
+	if(blockPos != 0)
 	{
-		0x6a09e667u,
-		0xbb67ae85u,
-		0x3c6ef372u,
-		0xa54ff53au,
-		0x510e527fu,
-		0x9b05688cu,
-		0x1f83d9abu,
-		0x5be0cd19u
-	};
-	usize pos = 0;
-	u64 total = 0;
-	std::array<u8, 64> m{};
-	const u8* dataPtr = static_cast<const u8*>(data);
+		const usize count = std::min(BlockSize - blockPos, data.size());
+		std::copy_n(data.data(), count, block.data() + blockPos);
+		blockPos += count;
+		data = data.subspan(count);
+
+		if(blockPos != BlockSize)
+			return;
 
-	if(length >= 64)
+		Transform(block.data(), 1, hash);
+		blockPos = 0;
+	}
+
+	//Transform all complete blocks directly from the input
+	if(data.size() >= BlockSize)
 	{
-		const usize blocks = length / 64;
-		const usize bytes = blocks * 64;
-		Transform(static_cast<const void*>(dataPtr), blocks, hash);
-		length -= bytes;
-		total += bytes * 8;
-		dataPtr += bytes;
+		const usize blocks = data.size() / BlockSize;
+		Transform(data.data(), blocks, hash);
+		data = data.subspan(blocks * BlockSize);
 	}
-	std::copy_n(dataPtr, length, &std::get<0>(m) + pos);
-	pos += length;
-	total += length * 8;
 
-	m[pos++] = 0x80;
-	if(pos > 56)
+	std::copy_n(data.data(), data.size(), block.data());
+	blockPos = data.size();
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+/// @brief Pad the last block, transform it and return the hash in big endian byte order.
+/// @param block Buffer holding the current incomplete block.
+/// @param blockPos Amount of bytes buffered in block.
+/// @param totalLength Total amount of processed bytes.
+/// @param hash Current hash state.
+template<typename T, usize BlockSize>
+void FinalizeSHA2(std::array<u8, BlockSize>& block, usize blockPos, const u64 totalLength, std::array<T, 8>& hash)
+{
+	//Last 8 bytes (SHA2 256) or 16 bytes (SHA2 512) hold the message length in bits
+	static constexpr usize LengthOffset = BlockSize - (BlockSize / 8);
+
+	block[blockPos++] = 0x80;
+	if(blockPos > LengthOffset)
 	{
-		std::fill_n(m.data() + pos, 64 - pos, NumericCast<u8>(0u));
-		Transform(&std::get<0>(m), 1, hash);
-		pos = 0;
+		std::fill_n(block.data() + blockPos, BlockSize - blockPos, NumericCast<u8>(0u));
+		Transform(block.data(), 1, hash);
+		blockPos = 0;
 	}
-	std::fill_n(m.data() + pos, 56 - pos, NumericCast<u8>(0u));
-	u64 mLength = total;
+	std::fill_n(block.data() + blockPos, BlockSize - blockPos, NumericCast<u8>(0u));
+	u64 mLength = totalLength * 8;
 	TRAP::Utils::Memory::SwapBytes<u64>(mLength);
-	std::copy_n(reinterpret_cast<u8*>(&mLength), 64 / 8, &std::get<0>(m) + (64 - 8));
-	Transform(&std::get<0>(m), 1, hash);
-	for(u32 i = 0; i < 8; i++)
-		TRAP::Utils::Memory::SwapBytes<u32>(hash[i]);
+	std::copy_n(reinterpret_cast<const u8*>(&mLength), sizeof(u64), block.data() + (BlockSize - sizeof(u64)));
+	Transform(block.data(), 1, hash);
+
+	for(T& h : hash)
+		TRAP::Utils::Memory::SwapBytes<T>(h);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+constexpr std::array<u32, 8> SHA256InitialHash
+{
+	0x6a09e667u, 0xbb67ae85u, 0x3c6ef372u, 0xa54ff53au, 0x510e527fu, 0x9b05688cu, 0x1f83d9abu, 0x5be0cd19u
+};
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+/// @brief Build the padded last block(s) of a SHA2 256 message.
+/// @param message Message to pad.
+/// @param tail Output for the padded last block(s).
+/// @return Amount of blocks stored in tail (1 or 2).
+[[nodiscard]] usize PadSHA256Tail(const std::span<const u8> message, std::array<u8, 128>& tail)
+{
+	const usize remaining = message.size() % 64;
+	std::copy_n(message.data() + (message.size() - remaining), remaining, tail.data());
+	tail[remaining] = 0x80;
+
+	const usize tailBlocks = (remaining + 1 + sizeof(u64)) > 64 ? 2 : 1;
+	const usize lengthOffset = tailBlocks * 64 - sizeof(u64);
+	std::fill(tail.data() + remaining + 1, tail.data() + lengthOffset, NumericCast<u8>(0u));
+
+	u64 bitLength = static_cast<u64>(message.size()) * 8;
+	TRAP::Utils::Memory::SwapBytes(bitLength);
+	std::copy_n(reinterpret_cast<const u8*>(&bitLength), sizeof(u64), tail.data() + lengthOffset);
+
+	return tailBlocks;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+/// @brief Convert a SHA2 256 state to the final hash.
+/// @param hash Hash state.
+/// @return SHA2 256 hash.
+[[nodiscard]] std::array<u8, 32> SHA256StateToHash(std::array<u32, 8> hash)
+{
+	for(u32& h : hash)
+		TRAP::Utils::Memory::SwapBytes(h);
 
 	std::array<u8, 32> result{};
 	std::copy_n(reinterpret_cast<const u8*>(hash.data()), result.size(), result.data());
@@ -325,68 +469,229 @@ void Transform(const void* const mp, const u64 numBlks, std::array<u64, 8>& hash
 
 //-------------------------------------------------------------------------------------------------------------------//
 
-[[nodiscard]] std::array<u8, 32> TRAP::Utils::Hash::SHA2_256(const std::string_view str)
+/// @brief Hash a whole message with a specific transform implementation.
+/// @param message Message to hash.
+/// @param transform Transform implementation to use.
+/// @return SHA2 256 hash of message.
+[[nodiscard]] std::array<u8, 32> SHA256Single(const std::span<const u8> message, const PFN_TransformSHA256 transform)
 {
-    ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None &&
-	                                          (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+	std::array<u32, 8> hash = SHA256InitialHash;
+	transform(message.data(), message.size() / 64, hash);
 
-	return SHA2_256(str.data(), str.length());
+	std::array<u8, 128> tail{};
+	const usize tailBlocks = PadSHA256Tail(message, tail);
+	transform(tail.data(), tailBlocks, hash);
+
+	return SHA256StateToHash(hash);
 }
 
 //-------------------------------------------------------------------------------------------------------------------//
 
-[[nodiscard]] std::array<u8, 64> TRAP::Utils::Hash::SHA2_512(const void* const data, u64 length)
+/// @brief Transpose a 8x8 matrix of 32 bit values.
+/// @param rows Matrix to transpose.
+TRAP_TARGET_ISA("avx2")
+inline void Transpose8x8(__m256i (&rows)[8]) noexcept
 {
-    ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None);
+	const __m256i t0 = _mm256_unpacklo_epi32(rows[0], rows[1]);
+	const __m256i t1 = _mm256_unpackhi_epi32(rows[0], rows[1]);
+	const __m256i t2 = _mm256_unpacklo_epi32(rows[2], rows[3]);
+	const __m256i t3 = _mm256_unpackhi_epi32(rows[2], rows[3]);
+	const __m256i t4 = _mm256_unpacklo_epi32(rows[4], rows[5]);
+	const __m256i t5 = _mm256_unpackhi_epi32(rows[4], rows[5]);
+	const __m256i t6 = _mm256_unpacklo_epi32(rows[6], rows[7]);
+	const __m256i t7 = _mm256_unpackhi_epi32(rows[6], rows[7]);
+
+	const __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+	const __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+	const __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+	const __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+	const __m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+	const __m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+	const __m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+	const __m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+
+	rows[0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+	rows[1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+	rows[2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+	rows[3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+	rows[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+	rows[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+	rows[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+	rows[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+TRAP_TARGET_ISA("avx2")
+[[nodiscard]] inline __m256i Rotr8x(const __m256i x, const i32 n) noexcept
+{
+	return _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - n));
+}
 
-	usize pos = 0;
-	u64 total = 0;
-	std::array<u64, 8> hash =
+//-------------------------------------------------------------------------------------------------------------------//
+
+/// @brief Hash up to 8 messages at once, one message per 32 bit AVX2 lane.
+/// @param messages Messages to hash (at most 8).
+/// @param results Output for the hashes of messages.
+/// @note Requires AVX2 support.
+TRAP_TARGET_ISA("avx2")
+void SHA256x8(const std::span<const std::span<const u8>> messages, const std::span<std::array<u8, 32>> results)
+{
+	static constexpr usize LaneCount = 8;
+	TRAP_ASSERT(messages.size() <= LaneCount, "SHA256x8(): Too many messages!");
+
+	struct Lane
 	{
-		0x6a09e667f3bcc908u,
-		0xbb67ae8584caa73bu,
-		0x3c6ef372fe94f82bu,
-		0xa54ff53a5f1d36f1u,
-		0x510e527fade682d1u,
-		0x9b05688c2b3e6c1fu,
-		0x1f83d9abfb41bd6bu,
-		0x5be0cd19137e2179u
+		const u8* Data = nullptr;
+		usize FullBlocks = 0;
+		usize TotalBlocks = 0;
+		std::array<u8, 128> Tail{};
 	};
-	std::array<u8, 128> m{};
-	const u8* dataPtr = static_cast<const u8*>(data);
 
-	if(length >= 128)
+	//Unused lanes hash a block of zeros, their results get discarded
+	alignas(32) static constexpr std::array<u8, 64> ZeroBlock{};
+
+	std::array<Lane, LaneCount> lanes{};
+	usize maxBlocks = 0;
+	for(usize i = 0; i < messages.size(); ++i)
 	{
-		const usize blocks = length / 128;
-		const usize bytes = blocks * 128;
-		Transform(static_cast<const void*>(dataPtr), blocks, hash);
-		length -= bytes;
-		total += bytes * 8;
-		dataPtr += bytes;
+		lanes[i].Data = messages[i].data();
+		lanes[i].FullBlocks = messages[i].size() / 64;
+		lanes[i].TotalBlocks = lanes[i].FullBlocks + PadSHA256Tail(messages[i], lanes[i].Tail);
+		maxBlocks = std::max(maxBlocks, lanes[i].TotalBlocks);
 	}
-	std::copy_n(dataPtr, length, &std::get<0>(m) + pos);
-	pos += length;
-	total += length * 8;
 
-	m[pos++] = 0x80;
-	if(pos > 112)
+	//C arrays, attributes of vector types get lost in template arguments
+	__m256i state[8]{};
+	for(usize i = 0; i < std::size(state); ++i)
+		state[i] = _mm256_set1_epi32(std::bit_cast<i32>(SHA256InitialHash[i]));
+
+	const __m256i byteSwapMask = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+	                                              3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+
+	__m256i W[64]{};
+	for(usize blk = 0; blk < maxBlocks; ++blk)
 	{
-		std::fill_n(m.data() + pos, 128 - pos, NumericCast<u8>(0u));
-		Transform(&std::get<0>(m), 1, hash);
-		pos = 0;
+		//Load and transpose the current block of every lane, so that W[t] holds word t of all lanes
+		__m256i low[8]{};
+		__m256i high[8]{};
+		for(usize i = 0; i < LaneCount; ++i)
+		{
+			const Lane& lane = lanes[i];
+			const u8* block = ZeroBlock.data();
+			if(blk < lane.FullBlocks)
+				block = lane.Data + blk * 64;
+			else if(blk < lane.TotalBlocks)
+				block = lane.Tail.data() + (blk - lane.FullBlocks) * 64;
+
+			low[i] = _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(block)), byteSwapMask);
+			high[i] = _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32)), byteSwapMask);
+		}
+		Transpose8x8(low);
+		Transpose8x8(high);
+		std::copy_n(low, 8, W);
+		std::copy_n(high, 8, W + 8);
+
+		for(usize t = 16; t < 64; ++t)
+		{
+			const __m256i w15 = W[t - 15];
+			const __m256i w2 = W[t - 2];
+			const __m256i sigma0 = _mm256_xor_si256(_mm256_xor_si256(Rotr8x(w15, 7), Rotr8x(w15, 18)), _mm256_srli_epi32(w15, 3));
+			const __m256i sigma1 = _mm256_xor_si256(_mm256_xor_si256(Rotr8x(w2, 17), Rotr8x(w2, 19)), _mm256_srli_epi32(w2, 10));
+			W[t] = _mm256_add_epi32(_mm256_add_epi32(sigma1, W[t - 7]), _mm256_add_epi32(sigma0, W[t - 16]));
+		}
+
+		__m256i a = state[0];
+		__m256i b = state[1];
+		__m256i c = state[2];
+		__m256i d = state[3];
+		__m256i e = state[4];
+		__m256i f = state[5];
+		__m256i g = state[6];
+		__m256i h = state[7];
+
+		for(usize t = 0; t < 64; ++t)
+		{
+			const __m256i sum1 = _mm256_xor_si256(_mm256_xor_si256(Rotr8x(e, 6), Rotr8x(e, 11)), Rotr8x(e, 25));
+			const __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+			const __m256i k = _mm256_set1_epi32(std::bit_cast<i32>(SHA256_K[t]));
+			const __m256i t1 = _mm256_add_epi32(_mm256_add_epi32(_mm256_add_epi32(h, sum1), _mm256_add_epi32(ch, k)), W[t]);
+			const __m256i sum0 = _mm256_xor_si256(_mm256_xor_si256(Rotr8x(a, 2), Rotr8x(a, 13)), Rotr8x(a, 22));
+			const __m256i maj = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+			const __m256i t2 = _mm256_add_epi32(sum0, maj);
+			h = g;
+			g = f;
+			f = e;
+			e = _mm256_add_epi32(d, t1);
+			d = c;
+			c = b;
+			b = a;
+			a = _mm256_add_epi32(t1, t2);
+		}
+
+		state[0] = _mm256_add_epi32(state[0], a);
+		state[1] = _mm256_add_epi32(state[1], b);
+		state[2] = _mm256_add_epi32(state[2], c);
+		state[3] = _mm256_add_epi32(state[3], d);
+		state[4] = _mm256_add_epi32(state[4], e);
+		state[5] = _mm256_add_epi32(state[5], f);
+		state[6] = _mm256_add_epi32(state[6], g);
+		state[7] = _mm256_add_epi32(state[7], h);
+
+		//Store the hashes of lanes which finished with this block
+		bool anyFinished = false;
+		for(usize i = 0; i < messages.size(); ++i)
+			anyFinished = anyFinished || lanes[i].TotalBlocks == blk + 1;
+		if(!anyFinished)
+			continue;
+
+		alignas(32) std::array<std::array<u32, LaneCount>, 8> laneStates{};
+		for(usize i = 0; i < std::size(state); ++i)
+			_mm256_store_si256(reinterpret_cast<__m256i*>(laneStates[i].data()), state[i]);
+
+		for(usize i = 0; i < messages.size(); ++i)
+		{
+			if(lanes[i].TotalBlocks != blk + 1)
+				continue;
+
+			std::array<u32, 8> hash{};
+			for(usize j = 0; j < hash.size(); ++j)
+				hash[j] = laneStates[j][i];
+			results[i] = SHA256StateToHash(hash);
+		}
 	}
-	std::fill_n(m.data() + pos, 128 - pos, NumericCast<u8>(0u));
-	u64 mLength = total;
-	TRAP::Utils::Memory::SwapBytes<u64>(mLength);
-	std::copy_n(reinterpret_cast<const u8*>(&mLength), 64 / 8, &std::get<0>(m) + (128 - 8));
-	Transform(&std::get<0>(m), 1, hash);
-	for (u32 i = 0; i < 8; i++)
-		TRAP::Utils::Memory::SwapBytes<u64>(hash[i]);
+}
 
-	std::array<u8, 64> result{};
-	std::copy_n(reinterpret_cast<const u8*>(hash.data()), result.size(), result.data());
+//-------------------------------------------------------------------------------------------------------------------//
 
-	return result;
+[[nodiscard]] std::array<u8, 32> TRAP::Utils::Hash::SHA2_256(const void* const data, const u64 length)
+{
+    ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None);
+
+	SHA2_256Hasher hasher{};
+	hasher.Update(std::span<const u8>(static_cast<const u8*>(data), length));
+	return hasher.Finalize();
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] std::array<u8, 32> TRAP::Utils::Hash::SHA2_256(const std::string_view str)
+{
+    ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None &&
+	                                          (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	return SHA2_256(str.data(), str.length());
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] std::array<u8, 64> TRAP::Utils::Hash::SHA2_512(const void* const data, const u64 length)
+{
+    ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None);
+
+	SHA2_512Hasher hasher{};
+	hasher.Update(std::span<const u8>(static_cast<const u8*>(data), length));
+	return hasher.Finalize();
 }
 
 //-------------------------------------------------------------------------------------------------------------------//
@@ -398,3 +703,169 @@ void Transform(const void* const mp, const u64 numBlks, std::array<u64, 8>& hash
 
 	return SHA2_512(str.data(), str.length());
 }
+
+//-------------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::Utils::Hash::SHA2_256Hasher::Update(const std::span<const u8> data)
+{
+    ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None);
+
+	UpdateSHA2(data, m_block, m_blockPos, m_hash);
+	m_totalLength += data.size_bytes();
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::Utils::Hash::SHA2_256Hasher::Update(const std::string_view str)
+{
+    ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None &&
+	                                          (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	Update(Utils::AsBytes(std::span(str)));
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] std::array<u8, 32> TRAP::Utils::Hash::SHA2_256Hasher::Finalize()
+{
+    ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None);
+
+	FinalizeSHA2(m_block, m_blockPos, m_totalLength, m_hash);
+
+	std::array<u8, 32> result{};
+	std::copy_n(reinterpret_cast<const u8*>(m_hash.data()), result.size(), result.data());
+
+	Reset();
+
+	return result;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::Utils::Hash::SHA2_512Hasher::Update(const std::span<const u8> data)
+{
+    ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None);
+
+	UpdateSHA2(data, m_block, m_blockPos, m_hash);
+	m_totalLength += data.size_bytes();
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::Utils::Hash::SHA2_512Hasher::Update(const std::string_view str)
+{
+    ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None &&
+	                                          (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	Update(Utils::AsBytes(std::span(str)));
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] std::array<u8, 64> TRAP::Utils::Hash::SHA2_512Hasher::Finalize()
+{
+    ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None);
+
+	FinalizeSHA2(m_block, m_blockPos, m_totalLength, m_hash);
+
+	std::array<u8, 64> result{};
+	std::copy_n(reinterpret_cast<const u8*>(m_hash.data()), result.size(), result.data());
+
+	Reset();
+
+	return result;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] std::vector<std::array<u8, 32>> TRAP::Utils::Hash::SHA2_256Batch(const std::span<const std::span<const u8>> messages)
+{
+    ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None);
+
+	using INTERNAL::SHA2_256Implementation;
+
+	//The SHA extensions outperform 8 AVX2 lanes
+	static const SHA2_256Implementation impl = []()
+	{
+		if(INTERNAL::IsSHA2_256ImplementationSupported(SHA2_256Implementation::SHANI))
+			return SHA2_256Implementation::SHANI;
+		if(INTERNAL::IsSHA2_256ImplementationSupported(SHA2_256Implementation::AVX2))
+			return SHA2_256Implementation::AVX2;
+
+		return SHA2_256Implementation::Scalar;
+	}();
+
+	return INTERNAL::SHA2_256Batch(messages, impl);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] bool TRAP::Utils::Hash::INTERNAL::IsSHA2_256ImplementationSupported(const SHA2_256Implementation impl)
+{
+    ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None &&
+	                                          (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	switch(impl)
+	{
+	case SHA2_256Implementation::Scalar:
+		return true;
+
+	case SHA2_256Implementation::AVX2:
+		return Utils::GetCPUInfo().AVX2;
+
+	case SHA2_256Implementation::SHANI:
+		return Utils::GetCPUInfo().SHA && Utils::GetCPUInfo().SSSE3 && Utils::GetCPUInfo().SSE4_1;
+
+	default:
+		return false;
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] std::vector<std::array<u8, 32>> TRAP::Utils::Hash::INTERNAL::SHA2_256Batch(const std::span<const std::span<const u8>> messages,
+                                                                                          const SHA2_256Implementation impl)
+{
+    ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None);
+
+	TRAP_ASSERT(IsSHA2_256ImplementationSupported(impl), "Hash::INTERNAL::SHA2_256Batch(): Implementation is not supported by the CPU!");
+
+	std::vector<std::array<u8, 32>> results(messages.size());
+
+	if(impl != SHA2_256Implementation::AVX2)
+	{
+		const PFN_TransformSHA256 transform = impl == SHA2_256Implementation::SHANI ? TransformSHANI : TransformScalar;
+		for(usize i = 0; i < messages.size(); ++i)
+			results[i] = SHA256Single(messages[i], transform);
+
+		return results;
+	}
+
+	//Group messages of similar length so that all lanes finish at roughly the same time
+	std::vector<usize> order(messages.size());
+	std::iota(order.begin(), order.end(), 0u);
+	std::ranges::stable_sort(order, std::ranges::less{}, [&messages](const usize i){return messages[i].size();});
+
+	static constexpr usize LaneCount = 8;
+	std::array<std::span<const u8>, LaneCount> laneMessages{};
+	std::array<std::array<u8, 32>, LaneCount> laneResults{};
+	for(usize first = 0; first < order.size(); first += LaneCount)
+	{
+		const usize count = std::min(LaneCount, order.size() - first);
+		for(usize i = 0; i < count; ++i)
+			laneMessages[i] = messages[order[first + i]];
+
+		SHA256x8(std::span(laneMessages).first(count), laneResults);
+
+		for(usize i = 0; i < count; ++i)
+			results[order[first + i]] = laneResults[i];
+	}
+
+	return results;
+}
\ No newline at end of file
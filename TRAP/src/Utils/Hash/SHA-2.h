@@ -2,7 +2,9 @@
 #define TRAP_SHA2_H
 
 #include <array>
+#include <span>
 #include <string_view>
+#include <vector>
 
 #include "Core/Types.h"
 
@@ -27,6 +29,165 @@ namespace TRAP::Utils::Hash
 	/// @param str String to get hash from.
 	/// @return SHA2 512 hash of input.
 	[[nodiscard]] std::array<u8, 64> SHA2_512(std::string_view str);
+
+	/// @brief Retrieve the SHA2 256 hashes of multiple independent messages.
+	///        Uses the SHA extensions if supported by the CPU, otherwise
+	///        messages get hashed in parallel, 8 at once, using AVX2.
+	///        Results are identical to calling SHA2_256() for every message.
+	/// @param messages Messages to get hashes from.
+	/// @return SHA2 256 hashes of messages, in the same order as messages.
+	[[nodiscard]] std::vector<std::array<u8, 32>> SHA2_256Batch(std::span<const std::span<const u8>> messages);
+
+	/// @brief Incremental SHA2 256 hasher.
+	///        Feed data in any amount of pieces via Update() and retrieve the hash via Finalize().
+	///        The resulting hash is the same as calling SHA2_256() with the concatenated data.
+	class SHA2_256Hasher
+	{
+	public:
+		/// @brief Type of the resulting hash.
+		using HashType = std::array<u8, 32>;
+
+		/// @brief Constructor.
+		constexpr SHA2_256Hasher() noexcept;
+
+		/// @brief Process the given data.
+		/// @param data Data to process.
+		void Update(std::span<const u8> data);
+		/// @brief Process the given string.
+		/// @param str String to process.
+		void Update(std::string_view str);
+
+		/// @brief Retrieve the SHA2 256 hash of all processed data.
+		///        Afterwards the hasher is reset and can be reused.
+		/// @return SHA2 256 hash of processed data.
+		[[nodiscard]] HashType Finalize();
+
+		/// @brief Reset the hasher, discarding all processed data.
+		constexpr void Reset() noexcept;
+
+	private:
+		std::array<u32, 8> m_hash{};
+		/// @brief Buffered bytes of the current incomplete block.
+		std::array<u8, 64> m_block{};
+		usize m_blockPos = 0;
+		/// @brief Total amount of processed bytes.
+		u64 m_totalLength = 0;
+	};
+
+	/// @brief Incremental SHA2 512 hasher.
+	///        Feed data in any amount of pieces via Update() and retrieve the hash via Finalize().
+	///        The resulting hash is the same as calling SHA2_512() with the concatenated data.
+	class SHA2_512Hasher
+	{
+	public:
+		/// @brief Type of the resulting hash.
+		using HashType = std::array<u8, 64>;
+
+		/// @brief Constructor.
+		constexpr SHA2_512Hasher() noexcept;
+
+		/// @brief Process the given data.
+		/// @param data Data to process.
+		void Update(std::span<const u8> data);
+		/// @brief Process the given string.
+		/// @param str String to process.
+		void Update(std::string_view str);
+
+		/// @brief Retrieve the SHA2 512 hash of all processed data.
+		///        Afterwards the hasher is reset and can be reused.
+		/// @return SHA2 512 hash of processed data.
+		[[nodiscard]] HashType Finalize();
+
+		/// @brief Reset the hasher, discarding all processed data.
+		constexpr void Reset() noexcept;
+
+	private:
+		std::array<u64, 8> m_hash{};
+		/// @brief Buffered bytes of the current incomplete block.
+		std::array<u8, 128> m_block{};
+		usize m_blockPos = 0;
+		/// @brief Total amount of processed bytes.
+		u64 m_totalLength = 0;
+	};
+
+	namespace INTERNAL
+	{
+		/// @brief Available SHA2 256 implementations.
+		///        SHA2_256Batch() automatically uses the fastest one supported by the CPU.
+		enum class SHA2_256Implementation : u8
+		{
+			Scalar,
+			AVX2,
+			SHANI
+		};
+
+		/// @brief Check whether the given SHA2 256 implementation is supported by the CPU.
+		/// @param impl SHA2 256 implementation.
+		/// @return True if supported, false otherwise.
+		[[nodiscard]] bool IsSHA2_256ImplementationSupported(SHA2_256Implementation impl);
+
+		/// @brief Retrieve the SHA2 256 hashes of multiple independent messages using a specific implementation.
+		/// @param messages Messages to get hashes from.
+		/// @param impl SHA2 256 implementation to use, must be supported by the CPU.
+		/// @return SHA2 256 hashes of messages, in the same order as messages.
+		/// @note Only intended for testing and benchmarking.
+		[[nodiscard]] std::vector<std::array<u8, 32>> SHA2_256Batch(std::span<const std::span<const u8>> messages,
+		                                                            SHA2_256Implementation impl);
+	}
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+constexpr TRAP::Utils::Hash::SHA2_256Hasher::SHA2_256Hasher() noexcept
+{
+	Reset();
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+constexpr void TRAP::Utils::Hash::SHA2_256Hasher::Reset() noexcept
+{
+	m_hash =
+	{
+		0x6a09e667u,
+		0xbb67ae85u,
+		0x3c6ef372u,
+		0xa54ff53au,
+		0x510e527fu,
+		0x9b05688cu,
+		0x1f83d9abu,
+		0x5be0cd19u
+	};
+	m_blockPos = 0;
+	m_totalLength = 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------------//
+
+constexpr TRAP::Utils::Hash::SHA2_512Hasher::SHA2_512Hasher() noexcept
+{
+	Reset();
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+constexpr void TRAP::Utils::Hash::SHA2_512Hasher::Reset() noexcept
+{
+	m_hash =
+	{
+		0x6a09e667f3bcc908u,
+		0xbb67ae8584caa73bu,
+		0x3c6ef372fe94f82bu,
+		0xa54ff53a5f1d36f1u,
+		0x510e527fade682d1u,
+		0x9b05688c2b3e6c1fu,
+		0x1f83d9abfb41bd6bu,
+		0x5be0cd19137e2179u
+	};
+	m_blockPos = 0;
+	m_totalLength = 0;
 }
 
 #endif /*TRAP_SHA2_H*/
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "SHA-3.h"
 
 #include "TRAP_Assert.h"
+#include "Utils/Utils.h"
 
 namespace
 {
@@ -135,38 +136,67 @@ void Transform(const void* const mp, const u64 numBlks, std::array<u64, 25>& A,
 
 //-------------------------------------------------------------------------------------------------------------------//
 
-[[nodiscard]] std::array<u8, 32> TRAP::Utils::Hash::SHA3_256(const void* const data, u64 length)
+/// @brief Buffer the given data and absorb every completed block.
+/// @param data Data to process.
+/// @param block Buffer holding the current incomplete block.
+/// @param blockPos Amount of bytes buffered in block.
+/// @param A Current state.
+template<usize BlockSize>
+void UpdateSHA3(std::span<const u8> data, std::array<u8, BlockSize>& block, usize& blockPos, std::array<u64, 25>& A)
 {
-    ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None);
+	static constexpr usize rate = BlockSize * 8;
+
+	//Fill up a partially buffered block first
+	if(blockPos != 0)
+	{
+		const usize count = std::min(BlockSize - blockPos, data.size());
+		std::copy_n(data.data(), count, block.data() + blockPos);
+		blockPos += count;
+		data = data.subspan(count);
 
-	static constexpr usize hs = 256;
-	static constexpr usize rate = 1600U - hs * 2;
-	std::array<u8, rate / 8> m{};
-	usize pos = 0;
-	std::array<u64, 25> A{};
+		if(blockPos != BlockSize)
+			return;
+
+		Transform(block.data(), 1, A, rate);
+		blockPos = 0;
+	}
 
-	const u8* dataPtr = static_cast<const u8*>(data);
-	static constexpr usize r = rate / 8;
-	if(length >= r)
+	//Absorb all complete blocks directly from the input
+	if(data.size() >= BlockSize)
 	{
-		const usize blocks = length / r;
-		const usize bytes = blocks * r;
-		Transform(dataPtr, blocks, A, rate);
-		length -= bytes;
-		dataPtr += bytes;
+		const usize blocks = data.size() / BlockSize;
+		Transform(data.data(), blocks, A, rate);
+		data = data.subspan(blocks * BlockSize);
 	}
-	std::copy_n(dataPtr, length, m.data() + pos);
-	pos += length;
 
-	m[pos++] = 0x06;
-	std::fill_n(m.data() + pos, r - pos, NumericCast<u8>(0u));
-	m[r - 1] |= 0x80;
-	Transform(m.data(), 1, A, rate);
+	std::copy_n(data.data(), data.size(), block.data());
+	blockPos = data.size();
+}
 
-	std::array<u8, hs / 8> result{};
-	std::copy_n(reinterpret_cast<const u8*>(A.data()), result.size(), result.data());
+//-------------------------------------------------------------------------------------------------------------------//
 
-	return result;
+/// @brief Pad and absorb the last block.
+/// @param block Buffer holding the current incomplete block.
+/// @param blockPos Amount of bytes buffered in block.
+/// @param A Current state.
+template<usize BlockSize>
+void FinalizeSHA3(std::array<u8, BlockSize>& block, usize blockPos, std::array<u64, 25>& A)
+{
+	block[blockPos++] = 0x06;
+	std::fill_n(block.data() + blockPos, BlockSize - blockPos, NumericCast<u8>(0u));
+	block[BlockSize - 1] |= 0x80;
+	Transform(block.data(), 1, A, BlockSize * 8);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] std::array<u8, 32> TRAP::Utils::Hash::SHA3_256(const void* const data, const u64 length)
+{
+    ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None);
+
+	SHA3_256Hasher hasher{};
+	hasher.Update(std::span<const u8>(static_cast<const u8*>(data), length));
+	return hasher.Finalize();
 }
 
 //-------------------------------------------------------------------------------------------------------------------//
@@ -181,46 +211,95 @@ void Transform(const void* const mp, const u64 numBlks, std::array<u64, 25>& A,
 
 //-------------------------------------------------------------------------------------------------------------------//
 
-[[nodiscard]] std::array<u8, 64> TRAP::Utils::Hash::SHA3_512(const void* const data, u64 length)
+[[nodiscard]] std::array<u8, 64> TRAP::Utils::Hash::SHA3_512(const void* const data, const u64 length)
 {
     ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None);
 
-	static constexpr usize hs = 512;
-	static constexpr usize rate = 1600U - hs * 2;
-	std::array<u8, rate / 8> m{};
-	usize pos = 0;
-	std::array<u64, 25> A{};
+	SHA3_512Hasher hasher{};
+	hasher.Update(std::span<const u8>(static_cast<const u8*>(data), length));
+	return hasher.Finalize();
+}
 
-	const u8* dataPtr = static_cast<const u8*>(data);
-	static constexpr usize r = rate / 8;
-	if (length >= r)
-	{
-		const usize blocks = length / r;
-		const usize bytes = blocks * r;
-		Transform(dataPtr, blocks, A, rate);
-		length -= bytes;
-		dataPtr += bytes;
-	}
-	std::copy_n(dataPtr, length, m.data() + pos);
-	pos += length;
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] std::array<u8, 64> TRAP::Utils::Hash::SHA3_512(const std::string_view str)
+{
+    ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None &&
+	                                          (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	return SHA3_512(str.data(), str.length());
+}
 
-	m[pos++] = 0x06;
-	std::fill_n(m.data() + pos, r - pos, NumericCast<u8>(0u));
-	m[r - 1] |= 0x80;
-	Transform(m.data(), 1, A, rate);
+//-------------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------------//
 
-	std::array<u8, hs / 8> result{};
-	std::copy_n(reinterpret_cast<const u8*>(A.data()), result.size(), result.data());
+void TRAP::Utils::Hash::SHA3_256Hasher::Update(const std::span<const u8> data)
+{
+    ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None);
+
+	UpdateSHA3(data, m_block, m_blockPos, m_state);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::Utils::Hash::SHA3_256Hasher::Update(const std::string_view str)
+{
+    ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None &&
+	                                          (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
+
+	Update(Utils::AsBytes(std::span(str)));
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] std::array<u8, 32> TRAP::Utils::Hash::SHA3_256Hasher::Finalize()
+{
+    ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None);
+
+	FinalizeSHA3(m_block, m_blockPos, m_state);
+
+	std::array<u8, 32> result{};
+	std::copy_n(reinterpret_cast<const u8*>(m_state.data()), result.size(), result.data());
+
+	Reset();
 
 	return result;
 }
 
+//-------------------------------------------------------------------------------------------------------------------//
+//-------------------------------------------------------------------------------------------------------------------//
 //-------------------------------------------------------------------------------------------------------------------//
 
-[[nodiscard]] std::array<u8, 64> TRAP::Utils::Hash::SHA3_512(const std::string_view str)
+void TRAP::Utils::Hash::SHA3_512Hasher::Update(const std::span<const u8> data)
+{
+    ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None);
+
+	UpdateSHA3(data, m_block, m_blockPos, m_state);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void TRAP::Utils::Hash::SHA3_512Hasher::Update(const std::string_view str)
 {
     ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None &&
 	                                          (GetTRAPProfileSystems() & ProfileSystems::Verbose) != ProfileSystems::None);
 
-	return SHA3_512(str.data(), str.length());
+	Update(Utils::AsBytes(std::span(str)));
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+[[nodiscard]] std::array<u8, 64> TRAP::Utils::Hash::SHA3_512Hasher::Finalize()
+{
+    ZoneNamedC(__tracy, tracy::Color::Violet, (GetTRAPProfileSystems() & ProfileSystems::Utils) != ProfileSystems::None);
+
+	FinalizeSHA3(m_block, m_blockPos, m_state);
+
+	std::array<u8, 64> result{};
+	std::copy_n(reinterpret_cast<const u8*>(m_state.data()), result.size(), result.data());
+
+	Reset();
+
+	return result;
 }
\ No newline at end of file
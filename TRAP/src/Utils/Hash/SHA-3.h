@@ -2,6 +2,7 @@
 #define TRAP_SHA3_H
 
 #include <array>
+#include <span>
 #include <string_view>
 
 #include "Core/Types.h"
@@ -27,6 +28,90 @@ namespace TRAP::Utils::Hash
 	/// @param str String to get hash from.
 	/// @return SHA3 512 hash of input.
 	[[nodiscard]] std::array<u8, 64> SHA3_512(std::string_view str);
+
+	/// @brief Incremental SHA3 256 hasher.
+	///        Feed data in any amount of pieces via Update() and retrieve the hash via Finalize().
+	///        The resulting hash is the same as calling SHA3_256() with the concatenated data.
+	class SHA3_256Hasher
+	{
+	public:
+		/// @brief Type of the resulting hash.
+		using HashType = std::array<u8, 32>;
+
+		/// @brief Process the given data.
+		/// @param data Data to process.
+		void Update(std::span<const u8> data);
+		/// @brief Process the given string.
+		/// @param str String to process.
+		void Update(std::string_view str);
+
+		/// @brief Retrieve the SHA3 256 hash of all processed data.
+		///        Afterwards the hasher is reset and can be reused.
+		/// @return SHA3 256 hash of processed data.
+		[[nodiscard]] HashType Finalize();
+
+		/// @brief Reset the hasher, discarding all processed data.
+		constexpr void Reset() noexcept;
+
+	private:
+		/// @brief Amount of bytes absorbed per permutation.
+		static constexpr usize Rate = (1600u - 256u * 2u) / 8u;
+
+		std::array<u64, 25> m_state{};
+		/// @brief Buffered bytes of the current incomplete block.
+		std::array<u8, Rate> m_block{};
+		usize m_blockPos = 0;
+	};
+
+	/// @brief Incremental SHA3 512 hasher.
+	///        Feed data in any amount of pieces via Update() and retrieve the hash via Finalize().
+	///        The resulting hash is the same as calling SHA3_512() with the concatenated data.
+	class SHA3_512Hasher
+	{
+	public:
+		/// @brief Type of the resulting hash.
+		using HashType = std::array<u8, 64>;
+
+		/// @brief Process the given data.
+		/// @param data Data to process.
+		void Update(std::span<const u8> data);
+		/// @brief Process the given string.
+		/// @param str String to process.
+		void Update(std::string_view str);
+
+		/// @brief Retrieve the SHA3 512 hash of all processed data.
+		///        Afterwards the hasher is reset and can be reused.
+		/// @return SHA3 512 hash of processed data.
+		[[nodiscard]] HashType Finalize();
+
+		/// @brief Reset the hasher, discarding all processed data.
+		constexpr void Reset() noexcept;
+
+	private:
+		/// @brief Amount of bytes absorbed per permutation.
+		static constexpr usize Rate = (1600u - 512u * 2u) / 8u;
+
+		std::array<u64, 25> m_state{};
+		/// @brief Buffered bytes of the current incomplete block.
+		std::array<u8, Rate> m_block{};
+		usize m_blockPos = 0;
+	};
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+constexpr void TRAP::Utils::Hash::SHA3_256Hasher::Reset() noexcept
+{
+	m_state = {};
+	m_blockPos = 0;
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+constexpr void TRAP::Utils::Hash::SHA3_512Hasher::Reset() noexcept
+{
+	m_state = {};
+	m_blockPos = 0;
 }
 
 #endif /*TRAP_SHA3_H*/
\ No newline at end of file
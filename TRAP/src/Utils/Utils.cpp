@@ -181,72 +181,129 @@ namespace
 	//Note this will only store info of the CPU we are currently running on.
 	//Its likely that this is broken on multi NUMA systems... //TODO
 
-	static CPUInfo cpu{};
-
-	if(!cpu.Model.empty())
-		return cpu;
-
-	static const auto CPUID = [](const u32 funcID, const u32 subFuncID)
+	//Queried exactly once, the static initialization is thread safe
+	static const CPUInfo cpuInfo = []()
 	{
-	#ifdef TRAP_PLATFORM_WINDOWS
-		std::array<i32, 4> regs{};
-		__cpuidex(regs.data(), static_cast<i32>(funcID), static_cast<i32>(subFuncID));
-	#else
-		std::array<u32, 4> regs{};
-		__get_cpuid_count(funcID, subFuncID, &std::get<0>(regs), &std::get<1>(regs), &std::get<2>(regs), &std::get<3>(regs));
-	#endif
+		CPUInfo cpu{};
 
-		return std::bit_cast<std::array<u32, 4>>(regs);
-	};
-
-	std::array<u32, 4> regs = CPUID(0, 0);
-	const u32 HFS = std::get<0>(regs);
-	//Get Vendor
-	const std::string vendorID = std::string(reinterpret_cast<char*>(&std::get<1>(regs)), sizeof(u32)) +
-		                         std::string(reinterpret_cast<char*>(&std::get<2>(regs)), sizeof(u32)) +
-		                         std::string(reinterpret_cast<char*>(&std::get<3>(regs)), sizeof(u32));
-	regs = CPUID(1, 0);
-	cpu.HyperThreaded = ((std::get<3>(regs) & 0x10000000u) != 0u); //Get Hyper-threading
-
-	const std::string upVendorID = Utils::String::ToUpper(vendorID);
-	//Get Number of cores
-	static constexpr i32 MAX_INTEL_TOP_LVL = 4;
-	static constexpr u32 LVL_TYPE = 0x0000FF00;
-	static constexpr u32 LVL_CORES = 0x0000FFFF;
-	if (Utils::String::Contains(upVendorID, "INTEL"))
-	{
-		if (HFS >= 11u)
+		static const auto CPUID = [](const u32 funcID, const u32 subFuncID)
+		{
+		#ifdef TRAP_PLATFORM_WINDOWS
+			std::array<i32, 4> regs{};
+			__cpuidex(regs.data(), static_cast<i32>(funcID), static_cast<i32>(subFuncID));
+		#else
+			std::array<u32, 4> regs{};
+			__get_cpuid_count(funcID, subFuncID, &std::get<0>(regs), &std::get<1>(regs), &std::get<2>(regs), &std::get<3>(regs));
+		#endif
+
+			return std::bit_cast<std::array<u32, 4>>(regs);
+		};
+
+		std::array<u32, 4> regs = CPUID(0, 0);
+		const u32 HFS = std::get<0>(regs);
+		//Get Vendor
+		const std::string vendorID = std::string(reinterpret_cast<char*>(&std::get<1>(regs)), sizeof(u32)) +
+			                         std::string(reinterpret_cast<char*>(&std::get<2>(regs)), sizeof(u32)) +
+			                         std::string(reinterpret_cast<char*>(&std::get<3>(regs)), sizeof(u32));
+		regs = CPUID(1, 0);
+		cpu.HyperThreaded = ((std::get<3>(regs) & 0x10000000u) != 0u); //Get Hyper-threading
+
+		//Get supported instruction set extensions
+		cpu.SSSE3 = (std::get<2>(regs) & BIT(9u)) != 0u;
+		cpu.SSE4_1 = (std::get<2>(regs) & BIT(19u)) != 0u;
+		cpu.SSE4_2 = (std::get<2>(regs) & BIT(20u)) != 0u;
+		cpu.PCLMULQDQ = (std::get<2>(regs) & BIT(1u)) != 0u;
+
+		//VEX encoded instructions (AVX2, F16C) additionally require the OS to save the YMM registers on context switches
+		bool OSSavesYMM = false;
+		if((std::get<2>(regs) & BIT(27u)) != 0u) //OSXSAVE
 		{
-			u32 numSMT = 0;
-			for (u32 lvl = 0; lvl < MAX_INTEL_TOP_LVL; ++lvl)
+		#ifdef TRAP_PLATFORM_WINDOWS
+			const u64 XCR0 = _xgetbv(0);
+		#else
+			u32 XCR0Low = 0, XCR0High = 0;
+			__asm__ volatile("xgetbv" : "=a"(XCR0Low), "=d"(XCR0High) : "c"(0u));
+			const u64 XCR0 = (static_cast<u64>(XCR0High) << 32u) | XCR0Low;
+		#endif
+			OSSavesYMM = (XCR0 & 0x6u) == 0x6u; //XMM and YMM state
+		}
+		cpu.F16C = OSSavesYMM && (std::get<2>(regs) & BIT(29u)) != 0u;
+		if(HFS >= 7u)
+		{
+			const std::array<u32, 4> regs1 = CPUID(7, 0);
+			cpu.SHA = (std::get<1>(regs1) & BIT(29u)) != 0u;
+			cpu.AVX2 = OSSavesYMM && (std::get<1>(regs1) & BIT(5u)) != 0u;
+		}
+
+		const std::string upVendorID = Utils::String::ToUpper(vendorID);
+		//Get Number of cores
+		static constexpr i32 MAX_INTEL_TOP_LVL = 4;
+		static constexpr u32 LVL_TYPE = 0x0000FF00;
+		static constexpr u32 LVL_CORES = 0x0000FFFF;
+		if (Utils::String::Contains(upVendorID, "INTEL"))
+		{
+			if (HFS >= 11u)
 			{
-				const std::array<u32, 4> regs1 = CPUID(0x0Bu, lvl);
-				const u32 currentLevel = (LVL_TYPE & std::get<2>(regs1)) >> 8u;
-				switch (currentLevel)
+				u32 numSMT = 0;
+				for (u32 lvl = 0; lvl < MAX_INTEL_TOP_LVL; ++lvl)
 				{
-				case BIT(0u):
-					numSMT = LVL_CORES & std::get<1>(regs1);
-					break;
-
-				case BIT(1u):
-					cpu.LogicalCores = LVL_CORES & std::get<1>(regs1);
-					break;
-
-				default:
-					break;
+					const std::array<u32, 4> regs1 = CPUID(0x0Bu, lvl);
+					const u32 currentLevel = (LVL_TYPE & std::get<2>(regs1)) >> 8u;
+					switch (currentLevel)
+					{
+					case BIT(0u):
+						numSMT = LVL_CORES & std::get<1>(regs1);
+						break;
+
+					case BIT(1u):
+						cpu.LogicalCores = LVL_CORES & std::get<1>(regs1);
+						break;
+
+					default:
+						break;
+					}
 				}
+				cpu.Cores = cpu.LogicalCores / numSMT;
+			}
+			else
+			{
+				if (HFS >= 1)
+				{
+					cpu.LogicalCores = (std::get<1>(regs) >> 16u) & 0xFFu;
+					if (HFS >= 4)
+					{
+						const std::array<u32, 4> regs1 = CPUID(4, 0);
+						cpu.Cores = (1 + (std::get<0>(regs1) >> 26u)) & 0x3Fu;
+					}
+				}
+				if (cpu.HyperThreaded)
+				{
+					if (!(cpu.Cores > 1))
+					{
+						cpu.Cores = 1;
+						cpu.LogicalCores = (cpu.LogicalCores >= 2 ? cpu.LogicalCores : 2);
+					}
+				}
+				else
+					cpu.Cores = cpu.LogicalCores = 1;
 			}
-			cpu.Cores = cpu.LogicalCores / numSMT;
 		}
-		else
+		else if (Utils::String::Contains(upVendorID, "AMD"))
 		{
+			u32 extFamily = 0;
+			if (((std::get<0>(regs) >> 8u) & 0xFu) < 0xFu)
+				extFamily = (std::get<0>(regs) >> 8u) & 0xFu;
+			else
+				extFamily = ((std::get<0>(regs) >> 8u) & 0xFu) + ((std::get<0>(regs) >> 20u) & 0xFFu);
+
 			if (HFS >= 1)
 			{
 				cpu.LogicalCores = (std::get<1>(regs) >> 16u) & 0xFFu;
-				if (HFS >= 4)
+				std::array<u32, 4> regs1 = CPUID(0x80000000u, 0u);
+				if (std::get<0>(regs1) >= 8u)
 				{
-					const std::array<u32, 4> regs1 = CPUID(4, 0);
-					cpu.Cores = (1 + (std::get<0>(regs1) >> 26u)) & 0x3Fu;
+					regs1 = CPUID(0x80000008u, 0u);
+					cpu.Cores = 1 + (std::get<2>(regs1) & 0xFFu);
 				}
 			}
 			if (cpu.HyperThreaded)
@@ -256,74 +313,47 @@ namespace
 					cpu.Cores = 1;
 					cpu.LogicalCores = (cpu.LogicalCores >= 2 ? cpu.LogicalCores : 2);
 				}
+				else if (cpu.Cores > 1)
+				{
+					//Ryzen 3 has SMT flag, but in fact cores count is equal to threads count.
+					//Ryzen 5/7 reports twice as many "real" cores (e.g. 16 cores instead of 8) because of SMT.
+					//On PPR 17h, page 82:
+					//CPUID_Fn8000001E_EBX [Core Identifiers][15:8] is ThreadsPerCore
+					//ThreadsPerCore: [...] The number of threads per core is ThreadsPerCore + 1
+					std::array<u32, 4> regs1 = CPUID(0x80000000u, 0u);
+					if ((extFamily >= 23u) && (std::get<0>(regs1) >= 30u))
+					{
+						regs1 = CPUID(0x8000001Eu, 0u);
+						cpu.Cores /= ((std::get<1>(regs1) >> 8u) & 0xFFu) + 1u;
+					}
+				}
 			}
 			else
 				cpu.Cores = cpu.LogicalCores = 1;
 		}
-	}
-	else if (Utils::String::Contains(upVendorID, "AMD"))
-	{
-		u32 extFamily = 0;
-		if (((std::get<0>(regs) >> 8u) & 0xFu) < 0xFu)
-			extFamily = (std::get<0>(regs) >> 8u) & 0xFu;
-		else
-			extFamily = ((std::get<0>(regs) >> 8u) & 0xFu) + ((std::get<0>(regs) >> 20u) & 0xFFu);
 
-		if (HFS >= 1)
+		//Get CPU brand string
+		for (u32 i = 0x80000002u; i < 0x80000005u; ++i)
 		{
-			cpu.LogicalCores = (std::get<1>(regs) >> 16u) & 0xFFu;
-			std::array<u32, 4> regs1 = CPUID(0x80000000u, 0u);
-			if (std::get<0>(regs1) >= 8u)
-			{
-				regs1 = CPUID(0x80000008u, 0u);
-				cpu.Cores = 1 + (std::get<2>(regs1) & 0xFFu);
-			}
-		}
-		if (cpu.HyperThreaded)
-		{
-			if (!(cpu.Cores > 1))
-			{
-				cpu.Cores = 1;
-				cpu.LogicalCores = (cpu.LogicalCores >= 2 ? cpu.LogicalCores : 2);
-			}
-			else if (cpu.Cores > 1)
-			{
-				//Ryzen 3 has SMT flag, but in fact cores count is equal to threads count.
-				//Ryzen 5/7 reports twice as many "real" cores (e.g. 16 cores instead of 8) because of SMT.
-				//On PPR 17h, page 82:
-				//CPUID_Fn8000001E_EBX [Core Identifiers][15:8] is ThreadsPerCore
-				//ThreadsPerCore: [...] The number of threads per core is ThreadsPerCore + 1
-				std::array<u32, 4> regs1 = CPUID(0x80000000u, 0u);
-				if ((extFamily >= 23u) && (std::get<0>(regs1) >= 30u))
-				{
-					regs1 = CPUID(0x8000001Eu, 0u);
-					cpu.Cores /= ((std::get<1>(regs1) >> 8u) & 0xFFu) + 1u;
-				}
-			}
+			std::array<u32, 4> regs1 = CPUID(i, 0);
+			cpu.Model += fmt::format("{}{}{}{}",
+			                         std::string(reinterpret_cast<char*>(&std::get<0>(regs1)), sizeof(u32)),
+			                         std::string(reinterpret_cast<char*>(&std::get<1>(regs1)), sizeof(u32)),
+			                         std::string(reinterpret_cast<char*>(&std::get<2>(regs1)), sizeof(u32)),
+			                         std::string(reinterpret_cast<char*>(&std::get<3>(regs1)), sizeof(u32)));
 		}
-		else
-			cpu.Cores = cpu.LogicalCores = 1;
-	}
 
-	//Get CPU brand string
-	for (u32 i = 0x80000002u; i < 0x80000005u; ++i)
-	{
-		std::array<u32, 4> regs1 = CPUID(i, 0);
-		cpu.Model += fmt::format("{}{}{}{}",
-		                         std::string(reinterpret_cast<char*>(&std::get<0>(regs1)), sizeof(u32)),
-		                         std::string(reinterpret_cast<char*>(&std::get<1>(regs1)), sizeof(u32)),
-		                         std::string(reinterpret_cast<char*>(&std::get<2>(regs1)), sizeof(u32)),
-		                         std::string(reinterpret_cast<char*>(&std::get<3>(regs1)), sizeof(u32)));
-	}
+		usize lastAlphaChar = 0;
+		const auto it = std::ranges::find_if(std::ranges::reverse_view(cpu.Model), Utils::String::IsAlphaNumeric);
+		if(it != cpu.Model.rend())
+			lastAlphaChar = NumericCast<usize>(it - cpu.Model.rbegin());
 
-	usize lastAlphaChar = 0;
-	const auto it = std::ranges::find_if(std::ranges::reverse_view(cpu.Model), Utils::String::IsAlphaNumeric);
-	if(it != cpu.Model.rend())
-		lastAlphaChar = NumericCast<usize>(it - cpu.Model.rbegin());
+		cpu.Model.erase(cpu.Model.end() - NumericCast<std::string::difference_type>(lastAlphaChar), cpu.Model.end());
 
-	cpu.Model.erase(cpu.Model.end() - NumericCast<std::string::difference_type>(lastAlphaChar), cpu.Model.end());
+		return cpu;
+	}();
 
-	return cpu;
+	return cpuInfo;
 }
 
 //-------------------------------------------------------------------------------------------------------------------//
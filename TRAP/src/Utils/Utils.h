@@ -107,6 +107,15 @@ namespace TRAP::Utils
 		u32 Cores = 0;
 		u32 LogicalCores = 0;
 		bool HyperThreaded = false;
+
+		//Supported instruction set extensions
+		bool SSSE3 = false;
+		bool SSE4_1 = false;
+		bool SSE4_2 = false;
+		bool PCLMULQDQ = false;
+		bool AVX2 = false;
+		bool F16C = false;
+		bool SHA = false;
 	};
 
 	/// @brief Get information about the CPU that runs the engine.
@@ -503,7 +503,7 @@ void TRAP::Window::SetIcon(const Image* const image) const
 		SetIcon();
 		return;
 	}
-	if (image->IsHDR() && image->GetBytesPerChannel() == 4)
+	if (image->IsHDR())
 	{
 		TP_ERROR(Log::WindowIconPrefix, "\"", m_data.Title, "\" HDR is not supported for window icons!");
 		TP_WARN(Log::WindowIconPrefix, "\"", m_data.Title, "\" Using default icon!");
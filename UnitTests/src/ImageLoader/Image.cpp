@@ -0,0 +1,542 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "ImageLoader/CustomImage.h"
+#include "ImageLoader/Image.h"
+#include "ImageLoader/PixelConversion.h"
+#include "ThreadPool/ThreadPool.h"
+
+namespace
+{
+    const std::filesystem::path TestFilesPath = "Testfiles/ImageLoader";
+
+    [[nodiscard]] std::vector<std::filesystem::path> GetTestImages()
+    {
+        static constexpr std::array<std::string_view, 8> Files
+        {
+            "Test24BPP.ppm",
+            "Test24BPPBigInterlaced.png",
+            "Test24BPPRLE.tga",
+            "Test32BPPsRGB.qoi",
+            "Test48BPPBig.png",
+            "Test8BPPPalette.bmp",
+            "TestGrayscaleHDR.pfm",
+            "TestHDR.hdr"
+        };
+
+        std::vector<std::filesystem::path> paths{};
+        for(const std::string_view file : Files)
+            paths.push_back(TestFilesPath / file);
+
+        return paths;
+    }
+
+    //The test files show the same logo as the fallback image, so a file that failed
+    //to decode is recognized by the fallback being a CustomImage
+    void RequireNotFallback(const TRAP::Image& img)
+    {
+        REQUIRE(dynamic_cast<const TRAP::INTERNAL::CustomImage*>(&img) == nullptr);
+    }
+
+    void RequireFallback(const TRAP::Image& img)
+    {
+        REQUIRE(dynamic_cast<const TRAP::INTERNAL::CustomImage*>(&img) != nullptr);
+    }
+
+    void RequireSameImage(const TRAP::Image& lhs, const TRAP::Image& rhs)
+    {
+        REQUIRE(lhs.GetWidth() == rhs.GetWidth());
+        REQUIRE(lhs.GetHeight() == rhs.GetHeight());
+        REQUIRE(lhs.GetColorFormat() == rhs.GetColorFormat());
+        REQUIRE(lhs.GetBitsPerPixel() == rhs.GetBitsPerPixel());
+        REQUIRE(std::ranges::equal(lhs.GetPixelData(), rhs.GetPixelData()));
+    }
+
+    //Pixel data size has to match the dimensions, no matter whether the data could be decoded
+    void RequireConsistentImage(const TRAP::Image& img)
+    {
+        REQUIRE(img.GetPixelData().size() ==
+                static_cast<usize>(img.GetWidth()) * img.GetHeight() * img.GetBitsPerPixel() / 8u);
+    }
+
+    [[nodiscard]] std::vector<u8> ReadTestFile(const std::filesystem::path& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        REQUIRE(file.is_open());
+
+        return std::vector<u8>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    /// @brief Binary portable map with the given header followed by a gradient.
+    [[nodiscard]] std::vector<u8> GeneratePortableMap(const std::string_view header, const usize pixelBytes)
+    {
+        std::vector<u8> file(header.begin(), header.end());
+        for(usize i = 0; i < pixelBytes; ++i)
+            file.push_back(static_cast<u8>(i * 7u));
+
+        return file;
+    }
+
+    /// @brief Encoded test image for every suffix of TRAP::Image::SupportedImageFormatSuffixes.
+    ///        Formats without a test file are generated.
+    [[nodiscard]] std::vector<u8> GetEncodedTestImage(const std::string_view suffix)
+    {
+        static constexpr std::array<std::pair<std::string_view, std::string_view>, 12> Files
+        {
+            {
+                {".ppm", "Test24BPP.ppm"},
+                {".pfm", "TestGrayscaleHDR.pfm"},
+                {".tga", "Test24BPPRLE.tga"},
+                {".icb", "Test24BPPRLE.tga"},
+                {".vda", "Test24BPPRLE.tga"},
+                {".vst", "Test24BPPRLE.tga"},
+                {".bmp", "Test8BPPPalette.bmp"},
+                {".dib", "Test8BPPPalette.bmp"},
+                {".png", "Test24BPPBigInterlaced.png"},
+                {".hdr", "TestHDR.hdr"},
+                {".pic", "TestHDR.hdr"},
+                {".qoi", "Test32BPPsRGB.qoi"}
+            }
+        };
+
+        if(suffix == ".pgm")
+            return GeneratePortableMap("P5\n7 5\n255\n", 7u * 5u);
+        if(suffix == ".pnm")
+            return GeneratePortableMap("P6\n7 5\n255\n", 7u * 5u * 3u);
+        if(suffix == ".pam")
+            return GeneratePortableMap("P7\nWIDTH 7\nHEIGHT 5\nDEPTH 4\nMAXVAL 255\nTUPLTYPE RGB_ALPHA\nENDHDR\n", 7u * 5u * 4u);
+
+        const auto* const file = std::ranges::find(Files, suffix, &std::pair<std::string_view, std::string_view>::first);
+        REQUIRE(file != Files.end());
+
+        return ReadTestFile(TestFilesPath / file->second);
+    }
+
+    //Expected half float pixel data for a 32-bit float HDR image, RGB is expanded to RGBA
+    [[nodiscard]] std::vector<u16> ToHalfFloat(const TRAP::Image& img)
+    {
+        std::vector<f32> data(img.GetPixelData().size() / sizeof(f32));
+        std::memcpy(data.data(), img.GetPixelData().data(), img.GetPixelData().size());
+
+        if(img.GetColorFormat() == TRAP::Image::ColorFormat::RGB)
+        {
+            std::vector<f32> rgba(data.size() / 3u * 4u);
+            TRAP::INTERNAL::ConvertRGBToRGBA<f32>(data, rgba);
+            data = std::move(rgba);
+        }
+
+        std::vector<u16> half(data.size());
+        TRAP::INTERNAL::ConvertF32ToF16(data, half, TRAP::INTERNAL::PixelConversionImplementation::Scalar);
+
+        return half;
+    }
+
+    //Radiance HDR file with uncompressed RLE scanlines and random pixels
+    [[nodiscard]] std::vector<u8> GenerateRadianceImage(const u32 width, const u32 height)
+    {
+        const std::string header = "#?RADIANCE\nFORMAT=32-bit_rle_rgbe\n\n-Y " + std::to_string(height) +
+                                   " +X " + std::to_string(width) + "\n";
+        std::vector<u8> file(header.begin(), header.end());
+
+        std::mt19937 rng(1337);
+        std::uniform_int_distribution<u32> mantissa(0, 255);
+        std::uniform_int_distribution<u32> exponent(100, 160);
+
+        std::vector<u8> component(width);
+        for(u32 y = 0; y < height; ++y)
+        {
+            file.insert(file.end(), {2, 2, static_cast<u8>(width >> 8u), static_cast<u8>(width & 0xFFu)});
+            for(u32 c = 0; c < 4; ++c)
+            {
+                for(u8& v : component)
+                    v = static_cast<u8>(c == 3 ? exponent(rng) : mantissa(rng));
+
+                for(u32 x = 0; x < width; x += 128)
+                {
+                    const u32 count = std::min(width - x, 128u);
+                    file.push_back(static_cast<u8>(count));
+                    file.insert(file.end(), component.begin() + x, component.begin() + x + count);
+                }
+            }
+        }
+
+        return file;
+    }
+}
+
+TEST_CASE("TRAP::Image::LoadFromFiles()", "[imageloader][image]")
+{
+    const std::vector<std::filesystem::path> paths = GetTestImages();
+
+    TRAP::ThreadPool threadPool(4);
+
+    SECTION("Result array")
+    {
+        const std::vector<TRAP::Scope<TRAP::Image>> images = TRAP::Image::LoadFromFiles(threadPool, paths);
+        REQUIRE(images.size() == paths.size());
+
+        for(usize i = 0; i < paths.size(); ++i)
+        {
+            INFO(paths[i]);
+            REQUIRE(images[i]);
+            REQUIRE(images[i]->GetFilePath() == paths[i]);
+            RequireNotFallback(*images[i]);
+
+            const TRAP::Scope<TRAP::Image> expected = TRAP::Image::LoadFromFile(paths[i]);
+            RequireSameImage(*images[i], *expected);
+        }
+    }
+
+    SECTION("Callback in file order")
+    {
+        //A limit of 1 byte only allows a single file in flight at a time
+        for(const u64 maxInFlightBytes : {u64(1), TRAP::Image::DefaultMaxInFlightBytes})
+        {
+            std::vector<usize> indices{};
+            TRAP::Image::LoadFromFiles(threadPool, paths, [&](const usize index, TRAP::Scope<TRAP::Image> image)
+            {
+                REQUIRE(image);
+                REQUIRE(image->GetFilePath() == paths[index]);
+                RequireNotFallback(*image);
+                indices.push_back(index);
+            }, maxInFlightBytes);
+
+            REQUIRE(indices.size() == paths.size());
+            REQUIRE(std::ranges::is_sorted(indices));
+            REQUIRE(std::ranges::adjacent_find(indices) == indices.end());
+        }
+    }
+
+    SECTION("Throwing callback")
+    {
+        //Files still being decoded when the callback throws must finish before LoadFromFiles() returns
+        usize calls = 0;
+        REQUIRE_THROWS_AS(TRAP::Image::LoadFromFiles(threadPool, paths, [&](const usize, TRAP::Scope<TRAP::Image>)
+        {
+            ++calls;
+            throw std::runtime_error("onLoaded");
+        }), std::runtime_error);
+        REQUIRE(calls == 1);
+    }
+
+    SECTION("Missing file uses fallback image")
+    {
+        const std::vector<std::filesystem::path> missing{TestFilesPath / "DoesNotExist.png"};
+        const std::vector<TRAP::Scope<TRAP::Image>> images = TRAP::Image::LoadFromFiles(threadPool, missing);
+        REQUIRE(images.size() == 1);
+        REQUIRE(images[0]);
+        REQUIRE(images[0]->GetWidth() == 32);
+        REQUIRE(images[0]->GetHeight() == 32);
+        REQUIRE(images[0]->GetColorFormat() == TRAP::Image::ColorFormat::RGBA);
+    }
+
+    SECTION("Empty")
+    {
+        REQUIRE(TRAP::Image::LoadFromFiles(threadPool, std::span<const std::filesystem::path>{}).empty());
+    }
+}
+
+TEST_CASE("TRAP::Image::LoadFromMemory()", "[imageloader][image]")
+{
+    const std::filesystem::path outputPath = std::filesystem::temp_directory_path() / "TRAPImageLoadFromMemory";
+    std::filesystem::create_directories(outputPath);
+
+    SECTION("Same as LoadFromFile()")
+    {
+        for(const std::string_view suffix : TRAP::Image::SupportedImageFormatSuffixes)
+        {
+            INFO(suffix);
+            const std::vector<u8> file = GetEncodedTestImage(suffix);
+            const std::filesystem::path path = outputPath / fmt::format("Image{}", suffix);
+            {
+                std::ofstream out(path, std::ios::binary);
+                out.write(reinterpret_cast<const char*>(file.data()), static_cast<std::streamsize>(file.size()));
+            }
+
+            const TRAP::Scope<TRAP::Image> fromFile = TRAP::Image::LoadFromFile(path);
+            const TRAP::Scope<TRAP::Image> fromMemory = TRAP::Image::LoadFromMemory(file);
+            RequireNotFallback(*fromFile);
+            RequireNotFallback(*fromMemory);
+            RequireSameImage(*fromMemory, *fromFile);
+        }
+    }
+
+    SECTION("Empty data")
+    {
+        RequireFallback(*TRAP::Image::LoadFromMemory(std::span<const u8>{}));
+    }
+
+    SECTION("Truncated data")
+    {
+        for(const std::string_view suffix : TRAP::Image::SupportedImageFormatSuffixes)
+        {
+            //QOI decodes as much as it can, see below
+            if(suffix == ".qoi")
+                continue;
+
+            const std::vector<u8> file = GetEncodedTestImage(suffix);
+            for(const usize size : {usize(1), file.size() / 4u, file.size() / 2u})
+            {
+                INFO(suffix << " truncated to " << size << " bytes");
+                const TRAP::Scope<TRAP::Image> image = TRAP::Image::LoadFromMemory(std::span(file).first(size));
+                REQUIRE(image);
+                RequireFallback(*image);
+                RequireConsistentImage(*image);
+            }
+        }
+    }
+
+    SECTION("Truncated last pixel")
+    {
+        for(const std::string_view suffix : {".pgm", ".ppm", ".pnm", ".pam", ".pfm", ".hdr"})
+        {
+            INFO(suffix);
+            const std::vector<u8> file = GetEncodedTestImage(suffix);
+            RequireFallback(*TRAP::Image::LoadFromMemory(std::span(file).first(file.size() - 1u)));
+        }
+    }
+
+    SECTION("Truncated trailer")
+    {
+        //Only optional data is cut off: the TGA footer, BMP row padding and the CRC of the PNG IEND chunk
+        for(const std::string_view suffix : {".tga", ".bmp", ".png"})
+        {
+            INFO(suffix);
+            const std::vector<u8> file = GetEncodedTestImage(suffix);
+            const TRAP::Scope<TRAP::Image> image = TRAP::Image::LoadFromMemory(std::span(file).first(file.size() - 1u));
+            RequireNotFallback(*image);
+            RequireSameImage(*image, *TRAP::Image::LoadFromMemory(file));
+        }
+    }
+
+    SECTION("Truncated PNG chunk header")
+    {
+        //Signature, complete IHDR chunk and the first 2 bytes of the next chunk length
+        const std::vector<u8> file = GetEncodedTestImage(".png");
+        RequireFallback(*TRAP::Image::LoadFromMemory(std::span(file).first(8u + 25u + 2u)));
+    }
+
+    SECTION("Truncated QOI")
+    {
+        const std::vector<u8> file = GetEncodedTestImage(".qoi");
+        const TRAP::Scope<TRAP::Image> full = TRAP::Image::LoadFromMemory(file);
+        RequireNotFallback(*full);
+
+        //Incomplete header
+        RequireFallback(*TRAP::Image::LoadFromMemory(std::span(file).first(13u)));
+
+        //QOI stops at the end of the data and fills the rest of the image with the last decoded pixel
+        for(const usize size : {file.size() / 4u, file.size() / 2u, file.size() - 8u})
+        {
+            INFO("Truncated to " << size << " bytes");
+            const TRAP::Scope<TRAP::Image> image = TRAP::Image::LoadFromMemory(std::span(file).first(size));
+            RequireNotFallback(*image);
+            REQUIRE(image->GetWidth() == full->GetWidth());
+            REQUIRE(image->GetHeight() == full->GetHeight());
+            REQUIRE(image->GetColorFormat() == full->GetColorFormat());
+            RequireConsistentImage(*image);
+            REQUIRE(std::ranges::equal(image->GetPixelData().first(4u), full->GetPixelData().first(4u)));
+        }
+
+        //Data after the end marker is ignored
+        std::vector<u8> trailingData = file;
+        trailingData.insert(trailingData.end(), {0xFEu, 0x12u, 0x34u});
+        RequireSameImage(*TRAP::Image::LoadFromMemory(trailingData), *full);
+    }
+
+    SECTION("Corrupted data")
+    {
+        //PNG chunks are protected by a CRC
+        std::vector<u8> png = GetEncodedTestImage(".png");
+        static constexpr std::string_view IDAT = "IDAT";
+        const auto idat = std::ranges::search(png, IDAT);
+        REQUIRE(idat.begin() != png.end());
+        idat.end()[0] ^= 0xFFu;
+        RequireFallback(*TRAP::Image::LoadFromMemory(png));
+
+        //Invalid QOI channel count
+        std::vector<u8> qoi = GetEncodedTestImage(".qoi");
+        qoi[12] = 5u;
+        RequireFallback(*TRAP::Image::LoadFromMemory(qoi));
+
+        //Random bit flips in the second half of every file must never crash
+        std::mt19937 rng(1337);
+        for(const std::string_view suffix : TRAP::Image::SupportedImageFormatSuffixes)
+        {
+            const std::vector<u8> file = GetEncodedTestImage(suffix);
+            std::uniform_int_distribution<usize> position(file.size() / 2u, file.size() - 1u);
+            std::uniform_int_distribution<u32> bit(0u, 7u);
+
+            for(u32 i = 0; i < 16u; ++i)
+            {
+                std::vector<u8> corrupted = file;
+                for(u32 j = 0; j < 4u; ++j)
+                    corrupted[position(rng)] ^= static_cast<u8>(1u << bit(rng));
+
+                INFO(suffix << " corruption " << i);
+                const TRAP::Scope<TRAP::Image> image = TRAP::Image::LoadFromMemory(corrupted);
+                REQUIRE(image);
+                RequireConsistentImage(*image);
+            }
+        }
+    }
+
+    std::filesystem::remove_all(outputPath);
+}
+
+TEST_CASE("TRAP::Image::SaveToFile()", "[imageloader][image]")
+{
+    const std::filesystem::path outputPath = std::filesystem::temp_directory_path() / "TRAPImageSaveToFile";
+    std::filesystem::create_directories(outputPath);
+
+    const TRAP::Scope<TRAP::Image> image = TRAP::Image::LoadFromFile(TestFilesPath / "Test24BPP.ppm");
+
+    SECTION("Synchronous")
+    {
+        for(const std::string_view extension : {".png", ".qoi", ".ppm"})
+        {
+            INFO(extension);
+            const std::filesystem::path path = outputPath / fmt::format("Image{}", extension);
+            REQUIRE(TRAP::Image::SaveToFile(image.get(), path));
+
+            const TRAP::Scope<TRAP::Image> loaded = TRAP::Image::LoadFromFile(path);
+            REQUIRE(loaded->GetWidth() == image->GetWidth());
+            REQUIRE(loaded->GetHeight() == image->GetHeight());
+            REQUIRE(std::ranges::equal(loaded->GetPixelData(), image->GetPixelData()));
+        }
+    }
+
+    SECTION("Asynchronous")
+    {
+        TRAP::ThreadPool threadPool(2);
+
+        const std::filesystem::path path = outputPath / "ImageAsync.png";
+        std::future<bool> result = TRAP::Image::SaveToFileAsync(threadPool, TRAP::Image::LoadFromFile(TestFilesPath / "Test24BPP.ppm"), path);
+        REQUIRE(result.get());
+
+        const TRAP::Scope<TRAP::Image> loaded = TRAP::Image::LoadFromFile(path);
+        REQUIRE(std::ranges::equal(loaded->GetPixelData(), image->GetPixelData()));
+    }
+
+    SECTION("Unsupported format")
+    {
+        REQUIRE_FALSE(TRAP::Image::SaveToFile(image.get(), outputPath / "Image.bmp"));
+    }
+
+    std::filesystem::remove_all(outputPath);
+}
+
+TEST_CASE("TRAP::Image::LoadFromFile() HDRPrecision::Float16", "[imageloader][image]")
+{
+    for(const std::string_view file : {"TestHDR.hdr", "TestGrayscaleHDR.pfm"})
+    {
+        INFO(file);
+
+        const TRAP::Scope<TRAP::Image> full = TRAP::Image::LoadFromFile(TestFilesPath / file);
+        const TRAP::Scope<TRAP::Image> half = TRAP::Image::LoadFromFile(TestFilesPath / file, TRAP::Image::HDRPrecision::Float16);
+
+        REQUIRE(half->IsHDR());
+        REQUIRE(half->GetBytesPerChannel() == 2);
+        REQUIRE(half->GetSize() == full->GetSize());
+        REQUIRE(half->GetColorFormat() == (full->GetColorFormat() == TRAP::Image::ColorFormat::RGB ?
+                                           TRAP::Image::ColorFormat::RGBA : full->GetColorFormat()));
+
+        const std::vector<u16> expected = ToHalfFloat(*full);
+        REQUIRE(half->GetPixelData().size() == expected.size() * sizeof(u16));
+        REQUIRE(std::memcmp(half->GetPixelData().data(), expected.data(), half->GetPixelData().size()) == 0);
+
+        //Transforms keep the half floats
+        const TRAP::Scope<TRAP::Image> rotated = TRAP::Image::Rotate90Clockwise(half.get());
+        REQUIRE(rotated->IsHDR());
+        REQUIRE(rotated->GetBitsPerPixel() == half->GetBitsPerPixel());
+    }
+
+    SECTION("Radiance scanlines")
+    {
+        const std::vector<u8> encoded = GenerateRadianceImage(300, 7);
+        const TRAP::Scope<TRAP::Image> full = TRAP::Image::LoadFromMemory(encoded);
+        const TRAP::Scope<TRAP::Image> half = TRAP::Image::LoadFromMemory(encoded, TRAP::Image::HDRPrecision::Float16);
+
+        REQUIRE(full->GetSize() == TRAP::Math::Vec2ui(300, 7));
+        const std::vector<u16> expected = ToHalfFloat(*full);
+        REQUIRE(half->GetPixelData().size() == expected.size() * sizeof(u16));
+        REQUIRE(std::memcmp(half->GetPixelData().data(), expected.data(), half->GetPixelData().size()) == 0);
+    }
+
+    SECTION("ConvertRGBToRGBA()")
+    {
+        //1.0, 2.0, 0.5 as half floats
+        const TRAP::Scope<TRAP::Image> rgb = TRAP::Image::LoadHalfFloatFromMemory(1, 1, TRAP::Image::ColorFormat::RGB,
+                                                                                   {0x3C00, 0x4000, 0x3800});
+        REQUIRE(rgb->IsHDR());
+
+        const TRAP::Scope<TRAP::Image> rgba = TRAP::Image::ConvertRGBToRGBA(rgb.get());
+        REQUIRE(rgba->IsHDR());
+        REQUIRE(rgba->GetBitsPerPixel() == 64);
+
+        std::array<u16, 4> pixel{};
+        std::memcpy(pixel.data(), rgba->GetPixelData().data(), sizeof(pixel));
+        REQUIRE(pixel == std::array<u16, 4>{0x3C00, 0x4000, 0x3800, 0x3C00});
+    }
+}
+
+TEST_CASE("TRAP::Image HDR decode Benchmark", "[.][benchmark][imageloader][image]")
+{
+    const std::vector<u8> encoded = GenerateRadianceImage(2048, 1024);
+
+    BENCHMARK("Radiance 2048x1024 Float32")
+    {
+        return TRAP::Image::LoadFromMemory(encoded);
+    };
+
+    BENCHMARK("Radiance 2048x1024 Float16")
+    {
+        return TRAP::Image::LoadFromMemory(encoded, TRAP::Image::HDRPrecision::Float16);
+    };
+
+    //Float32 RGB images get expanded to RGBA before upload, Float16 images are uploaded as is
+    BENCHMARK("Radiance 2048x1024 Float32 + ConvertRGBToRGBA")
+    {
+        return TRAP::Image::ConvertRGBToRGBA(TRAP::Image::LoadFromMemory(encoded).get());
+    };
+}
+
+TEST_CASE("TRAP::Image::LoadFromFiles() Benchmark", "[.][benchmark][imageloader][image]")
+{
+    //Load every image of the mixed format test directory multiple times
+    const std::vector<std::filesystem::path> testImages = GetTestImages();
+    std::vector<std::filesystem::path> paths{};
+    for(usize i = 0; i < 16; ++i)
+        paths.insert(paths.end(), testImages.begin(), testImages.end());
+
+    TRAP::ThreadPool threadPool;
+
+    BENCHMARK("LoadFromFile sequential")
+    {
+        std::vector<TRAP::Scope<TRAP::Image>> images{};
+        images.reserve(paths.size());
+        for(const auto& path : paths)
+            images.push_back(TRAP::Image::LoadFromFile(path));
+        return images;
+    };
+
+    BENCHMARK("LoadFromFiles")
+    {
+        return TRAP::Image::LoadFromFiles(threadPool, paths);
+    };
+}
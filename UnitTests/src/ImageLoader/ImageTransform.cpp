@@ -0,0 +1,301 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <array>
+#include <cstring>
+#include <random>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "ImageLoader/Image.h"
+#include "ImageLoader/ImageTransform.h"
+#include "ThreadPool/Parallel.h"
+
+namespace
+{
+    using ImageTransformImplementation = TRAP::INTERNAL::ImageTransformImplementation;
+
+    constexpr std::array<std::pair<ImageTransformImplementation, std::string_view>, 3> ImageTransformImplementations
+    {
+        {
+            {ImageTransformImplementation::Scalar, "Scalar"},
+            {ImageTransformImplementation::SSE2, "SSE2"},
+            {ImageTransformImplementation::AVX2, "AVX2"}
+        }
+    };
+
+    constexpr std::array<u32, 8> PixelSizes{1, 2, 3, 4, 6, 8, 12, 16};
+
+    //Sizes covering single pixels, partial SIMD blocks, partial tiles and multiple tiles
+    constexpr std::array<std::pair<u32, u32>, 8> ImageSizes
+    {
+        {
+            {1, 1}, {1, 7}, {9, 1}, {8, 8}, {17, 5}, {33, 64}, {70, 129}, {130, 97}
+        }
+    };
+
+    [[nodiscard]] std::vector<u8> GenerateData(const usize size, const u32 seed)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<u32> dist(0, 255);
+
+        std::vector<u8> data(size);
+        for(u8& v : data)
+            v = static_cast<u8>(dist(rng));
+
+        return data;
+    }
+
+    enum class Transform
+    {
+        FlipX,
+        FlipY,
+        Rotate90Clockwise,
+        Rotate90CounterClockwise
+    };
+
+    //Naive pixel by pixel transform, used as reference and benchmark baseline
+    [[nodiscard]] std::vector<u8> ReferenceTransform(const std::vector<u8>& src, const u32 width, const u32 height,
+                                                     const u32 bytesPerPixel, const Transform transform)
+    {
+        std::vector<u8> dst(src.size());
+
+        for(u32 y = 0; y < height; ++y)
+        {
+            for(u32 x = 0; x < width; ++x)
+            {
+                usize dstIndex = 0;
+                switch(transform)
+                {
+                case Transform::FlipX:
+                    dstIndex = static_cast<usize>(y) * width + (width - 1u - x);
+                    break;
+                case Transform::FlipY:
+                    dstIndex = static_cast<usize>(height - 1u - y) * width + x;
+                    break;
+                case Transform::Rotate90Clockwise:
+                    dstIndex = static_cast<usize>(x) * height + (height - 1u - y);
+                    break;
+                case Transform::Rotate90CounterClockwise:
+                    dstIndex = static_cast<usize>(width - 1u - x) * height + y;
+                    break;
+                }
+
+                std::memcpy(dst.data() + dstIndex * bytesPerPixel,
+                            src.data() + (static_cast<usize>(y) * width + x) * bytesPerPixel, bytesPerPixel);
+            }
+        }
+
+        return dst;
+    }
+}
+
+TEST_CASE("TRAP::INTERNAL::FlipPixelsX()/FlipPixelsY()", "[imageloader][imagetransform]")
+{
+    for(const u32 bytesPerPixel : PixelSizes)
+    {
+        for(const auto& [width, height] : ImageSizes)
+        {
+            const std::vector<u8> src = GenerateData(static_cast<usize>(width) * height * bytesPerPixel, width * 31u + height);
+            const std::vector<u8> expectedX = ReferenceTransform(src, width, height, bytesPerPixel, Transform::FlipX);
+            const std::vector<u8> expectedY = ReferenceTransform(src, width, height, bytesPerPixel, Transform::FlipY);
+
+            std::vector<u8> dst(src.size());
+            TRAP::INTERNAL::FlipPixelsX(src, dst, width, height, bytesPerPixel);
+            REQUIRE(dst == expectedX);
+            TRAP::INTERNAL::FlipPixelsY(src, dst, width, height, bytesPerPixel);
+            REQUIRE(dst == expectedY);
+
+            //In place
+            dst = src;
+            TRAP::INTERNAL::FlipPixelsX(dst, dst, width, height, bytesPerPixel);
+            REQUIRE(dst == expectedX);
+            dst = src;
+            TRAP::INTERNAL::FlipPixelsY(dst, dst, width, height, bytesPerPixel);
+            REQUIRE(dst == expectedY);
+
+            for(const auto& [impl, name] : ImageTransformImplementations)
+            {
+                if(!TRAP::INTERNAL::IsImageTransformImplementationSupported(impl))
+                    continue;
+
+                INFO(name);
+                TRAP::INTERNAL::FlipPixelsX(TRAP::INTERNAL::GetParallelThreadPool(), src, dst, width, height,
+                                            bytesPerPixel, impl);
+                REQUIRE(dst == expectedX);
+
+                dst = src;
+                TRAP::INTERNAL::FlipPixelsX(TRAP::INTERNAL::GetParallelThreadPool(), dst, dst, width, height,
+                                            bytesPerPixel, impl);
+                REQUIRE(dst == expectedX);
+            }
+        }
+    }
+}
+
+TEST_CASE("TRAP::INTERNAL::RotatePixels90Clockwise()/RotatePixels90CounterClockwise()", "[imageloader][imagetransform]")
+{
+    TRAP::ThreadPool& threadPool = TRAP::INTERNAL::GetParallelThreadPool();
+
+    for(const auto& [impl, name] : ImageTransformImplementations)
+    {
+        if(!TRAP::INTERNAL::IsImageTransformImplementationSupported(impl))
+            continue;
+
+        INFO(name);
+        for(const u32 bytesPerPixel : PixelSizes)
+        {
+            for(const auto& [width, height] : ImageSizes)
+            {
+                const std::vector<u8> src = GenerateData(static_cast<usize>(width) * height * bytesPerPixel, width * 17u + height);
+
+                std::vector<u8> dst(src.size());
+                TRAP::INTERNAL::RotatePixels90Clockwise(threadPool, src, dst, width, height, bytesPerPixel, impl);
+                REQUIRE(dst == ReferenceTransform(src, width, height, bytesPerPixel, Transform::Rotate90Clockwise));
+                TRAP::INTERNAL::RotatePixels90CounterClockwise(threadPool, src, dst, width, height, bytesPerPixel, impl);
+                REQUIRE(dst == ReferenceTransform(src, width, height, bytesPerPixel, Transform::Rotate90CounterClockwise));
+            }
+
+            //In place, square images only
+            for(const u32 size : {1u, 7u, 8u, 32u, 65u, 100u})
+            {
+                const std::vector<u8> src = GenerateData(static_cast<usize>(size) * size * bytesPerPixel, size);
+
+                std::vector<u8> data = src;
+                TRAP::INTERNAL::RotatePixels90ClockwiseInPlace(threadPool, data, size, bytesPerPixel, impl);
+                REQUIRE(data == ReferenceTransform(src, size, size, bytesPerPixel, Transform::Rotate90Clockwise));
+
+                data = src;
+                TRAP::INTERNAL::RotatePixels90CounterClockwiseInPlace(threadPool, data, size, bytesPerPixel, impl);
+                REQUIRE(data == ReferenceTransform(src, size, size, bytesPerPixel, Transform::Rotate90CounterClockwise));
+            }
+        }
+    }
+
+    SECTION("Engine ThreadPool")
+    {
+        const std::vector<u8> src = GenerateData(70u * 129u * 4u, 0);
+
+        std::vector<u8> dst(src.size());
+        TRAP::INTERNAL::RotatePixels90Clockwise(src, dst, 70, 129, 4);
+        REQUIRE(dst == ReferenceTransform(src, 70, 129, 4, Transform::Rotate90Clockwise));
+        TRAP::INTERNAL::RotatePixels90CounterClockwise(src, dst, 70, 129, 4);
+        REQUIRE(dst == ReferenceTransform(src, 70, 129, 4, Transform::Rotate90CounterClockwise));
+    }
+}
+
+TEST_CASE("TRAP::Image Flip and rotate", "[imageloader][imagetransform]")
+{
+    //3x2 RGBA image
+    const std::vector<u8> pixels
+    {
+         0,  1,  2,  3,    4,  5,  6,  7,    8,  9, 10, 11,
+        12, 13, 14, 15,   16, 17, 18, 19,   20, 21, 22, 23
+    };
+    const TRAP::Scope<TRAP::Image> img = TRAP::Image::LoadFromMemory(3, 2, TRAP::Image::ColorFormat::RGBA, pixels);
+
+    SECTION("FlipX()")
+    {
+        const TRAP::Scope<TRAP::Image> flipped = TRAP::Image::FlipX(img.get());
+        REQUIRE(flipped->GetSize() == TRAP::Math::Vec2ui(3, 2));
+        REQUIRE(std::vector<u8>(flipped->GetPixelData().begin(), flipped->GetPixelData().end()) == std::vector<u8>
+        {
+             8,  9, 10, 11,    4,  5,  6,  7,    0,  1,  2,  3,
+            20, 21, 22, 23,   16, 17, 18, 19,   12, 13, 14, 15
+        });
+    }
+
+    SECTION("FlipY()")
+    {
+        const TRAP::Scope<TRAP::Image> flipped = TRAP::Image::FlipY(img.get());
+        REQUIRE(flipped->GetSize() == TRAP::Math::Vec2ui(3, 2));
+        REQUIRE(std::vector<u8>(flipped->GetPixelData().begin(), flipped->GetPixelData().end()) == std::vector<u8>
+        {
+            12, 13, 14, 15,   16, 17, 18, 19,   20, 21, 22, 23,
+             0,  1,  2,  3,    4,  5,  6,  7,    8,  9, 10, 11
+        });
+    }
+
+    SECTION("Rotate90Clockwise()")
+    {
+        const TRAP::Scope<TRAP::Image> rotated = TRAP::Image::Rotate90Clockwise(img.get());
+        REQUIRE(rotated->GetSize() == TRAP::Math::Vec2ui(2, 3));
+        REQUIRE(std::vector<u8>(rotated->GetPixelData().begin(), rotated->GetPixelData().end()) == std::vector<u8>
+        {
+            12, 13, 14, 15,    0,  1,  2,  3,
+            16, 17, 18, 19,    4,  5,  6,  7,
+            20, 21, 22, 23,    8,  9, 10, 11
+        });
+    }
+
+    SECTION("Rotate90CounterClockwise()")
+    {
+        const TRAP::Scope<TRAP::Image> rotated = TRAP::Image::Rotate90CounterClockwise(img.get());
+        REQUIRE(rotated->GetSize() == TRAP::Math::Vec2ui(2, 3));
+        REQUIRE(std::vector<u8>(rotated->GetPixelData().begin(), rotated->GetPixelData().end()) == std::vector<u8>
+        {
+             8,  9, 10, 11,   20, 21, 22, 23,
+             4,  5,  6,  7,   16, 17, 18, 19,
+             0,  1,  2,  3,   12, 13, 14, 15
+        });
+    }
+
+    SECTION("HDR")
+    {
+        const std::vector<f32> hdrPixels{0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f};
+        const TRAP::Scope<TRAP::Image> hdr = TRAP::Image::LoadFromMemory(3, 2, TRAP::Image::ColorFormat::GrayScale, hdrPixels);
+        const TRAP::Scope<TRAP::Image> rotated = TRAP::Image::Rotate90Clockwise(hdr.get());
+
+        REQUIRE(rotated->IsHDR());
+        REQUIRE(rotated->GetSize() == TRAP::Math::Vec2ui(2, 3));
+        std::array<f32, 6> result{};
+        std::memcpy(result.data(), rotated->GetPixelData().data(), sizeof(result));
+        REQUIRE(result == std::array<f32, 6>{3.0f, 0.0f, 4.0f, 1.0f, 5.0f, 2.0f});
+    }
+}
+
+TEST_CASE("TRAP::INTERNAL Image transform Benchmark", "[.][benchmark][imageloader][imagetransform]")
+{
+    constexpr u32 Size = 4096;
+    TRAP::ThreadPool& threadPool = TRAP::INTERNAL::GetParallelThreadPool();
+
+    for(const u32 bytesPerPixel : {1u, 4u, 16u})
+    {
+        const std::vector<u8> src = GenerateData(static_cast<usize>(Size) * Size * bytesPerPixel, 0);
+        std::vector<u8> dst(src.size());
+
+        BENCHMARK(fmt::format("Rotate90Clockwise {}x{} {} bytes per pixel Reference", Size, Size, bytesPerPixel))
+        {
+            return ReferenceTransform(src, Size, Size, bytesPerPixel, Transform::Rotate90Clockwise);
+        };
+        BENCHMARK(fmt::format("FlipX {}x{} {} bytes per pixel Reference", Size, Size, bytesPerPixel))
+        {
+            return ReferenceTransform(src, Size, Size, bytesPerPixel, Transform::FlipX);
+        };
+
+        for(const auto& [impl, name] : ImageTransformImplementations)
+        {
+            if(!TRAP::INTERNAL::IsImageTransformImplementationSupported(impl))
+                continue;
+
+            BENCHMARK(fmt::format("Rotate90Clockwise {}x{} {} bytes per pixel {}", Size, Size, bytesPerPixel, name))
+            {
+                TRAP::INTERNAL::RotatePixels90Clockwise(threadPool, src, dst, Size, Size, bytesPerPixel, impl);
+                return dst.data();
+            };
+            BENCHMARK(fmt::format("Rotate90Clockwise {}x{} {} bytes per pixel in place {}", Size, Size, bytesPerPixel, name))
+            {
+                TRAP::INTERNAL::RotatePixels90ClockwiseInPlace(threadPool, dst, Size, bytesPerPixel, impl);
+                return dst.data();
+            };
+            BENCHMARK(fmt::format("FlipX {}x{} {} bytes per pixel {}", Size, Size, bytesPerPixel, name))
+            {
+                TRAP::INTERNAL::FlipPixelsX(threadPool, src, dst, Size, Size, bytesPerPixel, impl);
+                return dst.data();
+            };
+        }
+    }
+}
@@ -0,0 +1,389 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <array>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "ImageLoader/PixelConversion.h"
+
+namespace
+{
+    using PixelConversionImplementation = TRAP::INTERNAL::PixelConversionImplementation;
+
+    constexpr std::array<std::pair<PixelConversionImplementation, std::string_view>, 3> PixelConversionImplementations
+    {
+        {
+            {PixelConversionImplementation::Scalar, "Scalar"},
+            {PixelConversionImplementation::SSSE3, "SSSE3"},
+            {PixelConversionImplementation::AVX2, "AVX2"}
+        }
+    };
+
+    //Pixel counts covering empty input, scalar tails and multiple SIMD iterations
+    constexpr std::array<usize, 12> PixelCounts{0, 1, 3, 4, 15, 16, 17, 31, 33, 64, 127, 1000};
+
+    template<typename T>
+    [[nodiscard]] std::vector<T> GenerateData(const usize size, const u32 seed)
+    {
+        std::mt19937 rng(seed);
+
+        std::vector<T> data(size);
+        if constexpr(std::same_as<T, f32>)
+        {
+            std::uniform_real_distribution<f32> dist(-10.0f, 10.0f);
+            for(T& v : data)
+                v = dist(rng);
+        }
+        else
+        {
+            std::uniform_int_distribution<u32> dist(0, std::numeric_limits<T>::max());
+            for(T& v : data)
+                v = static_cast<T>(dist(rng));
+        }
+
+        return data;
+    }
+
+    template<typename T>
+    [[nodiscard]] std::vector<T> ReferenceRGBToRGBA(const std::vector<T>& rgb)
+    {
+        T alpha{};
+        if constexpr(std::same_as<T, f32>)
+            alpha = 1.0f;
+        else
+            alpha = std::numeric_limits<T>::max();
+
+        std::vector<T> rgba{};
+        for(usize i = 0; i + 3u <= rgb.size(); i += 3u)
+            rgba.insert(rgba.end(), {rgb[i], rgb[i + 1u], rgb[i + 2u], alpha});
+
+        return rgba;
+    }
+
+    template<typename T>
+    [[nodiscard]] std::vector<T> ReferenceRGBAToRGB(const std::vector<T>& rgba)
+    {
+        std::vector<T> rgb{};
+        for(usize i = 0; i + 4u <= rgba.size(); i += 4u)
+            rgb.insert(rgb.end(), {rgba[i], rgba[i + 1u], rgba[i + 2u]});
+
+        return rgb;
+    }
+
+    [[nodiscard]] std::array<u8, 3> ReferenceBGR16ToRGB24(const u8 lo, const u8 hi)
+    {
+        return
+        {
+            static_cast<u8>(static_cast<u8>(hi << 1u) & 0xF8u),
+            static_cast<u8>(static_cast<u8>(static_cast<u8>(hi << 6u) | static_cast<u8>(lo >> 2u)) & 0xF8u),
+            static_cast<u8>(static_cast<u8>(lo << 3u) & 0xF8u)
+        };
+    }
+
+    template<typename T>
+    void RequireRGBConversions(const PixelConversionImplementation impl)
+    {
+        for(const usize pixelCount : PixelCounts)
+        {
+            INFO(pixelCount << " pixels, " << sizeof(T) << " bytes per channel");
+
+            const std::vector<T> rgb = GenerateData<T>(pixelCount * 3u, 1337);
+            const std::vector<T> expectedRGBA = ReferenceRGBToRGBA(rgb);
+
+            std::vector<T> rgba(pixelCount * 4u);
+            TRAP::INTERNAL::ConvertRGBToRGBA(std::span<const T>(rgb), std::span<T>(rgba), impl);
+            REQUIRE(rgba == expectedRGBA);
+
+            std::vector<T> backToRGB(pixelCount * 3u);
+            TRAP::INTERNAL::ConvertRGBAToRGB(std::span<const T>(rgba), std::span<T>(backToRGB), impl);
+            REQUIRE(backToRGB == rgb);
+
+            //In place
+            std::vector<T> inPlace = GenerateData<T>(pixelCount * 4u, 42);
+            const std::vector<T> expectedRGB = ReferenceRGBAToRGB(inPlace);
+            TRAP::INTERNAL::ConvertRGBAToRGB(std::span<const T>(inPlace), std::span<T>(inPlace), impl);
+            inPlace.resize(pixelCount * 3u);
+            REQUIRE(inPlace == expectedRGB);
+        }
+    }
+
+    template<typename T>
+    void RequireRGBToRGBAInPlace()
+    {
+        for(const usize pixelCount : {usize(0), usize(1), usize(63), usize(64), usize(65), usize(1000), usize(4097)})
+        {
+            INFO(pixelCount << " pixels, " << sizeof(T) << " bytes per channel");
+
+            const std::vector<T> rgb = GenerateData<T>(pixelCount * 3u, 7);
+            std::vector<T> data = rgb;
+            data.resize(pixelCount * 4u);
+            TRAP::INTERNAL::ConvertRGBToRGBAInPlace(std::span<T>(data));
+            REQUIRE(data == ReferenceRGBToRGBA(rgb));
+        }
+    }
+}
+
+TEST_CASE("TRAP::INTERNAL::ConvertRGBToRGBA()/ConvertRGBAToRGB()", "[imageloader][pixelconversion]")
+{
+    for(const auto& [impl, name] : PixelConversionImplementations)
+    {
+        if(!TRAP::INTERNAL::IsPixelConversionImplementationSupported(impl))
+            continue;
+
+        INFO(name);
+        RequireRGBConversions<u8>(impl);
+        RequireRGBConversions<u16>(impl);
+        RequireRGBConversions<f32>(impl);
+    }
+
+    SECTION("In place RGB to RGBA")
+    {
+        RequireRGBToRGBAInPlace<u8>();
+        RequireRGBToRGBAInPlace<u16>();
+        RequireRGBToRGBAInPlace<f32>();
+    }
+
+    SECTION("Bytes per channel")
+    {
+        const std::vector<f32> rgb{0.5f, -1.0f, 2.0f};
+        std::vector<f32> rgba(4);
+        TRAP::INTERNAL::ConvertRGBToRGBA(std::span(reinterpret_cast<const u8*>(rgb.data()), rgb.size() * sizeof(f32)),
+                                         std::span(reinterpret_cast<u8*>(rgba.data()), rgba.size() * sizeof(f32)), 4);
+        REQUIRE(rgba == std::vector<f32>{0.5f, -1.0f, 2.0f, 1.0f});
+
+        const std::vector<u16> rgb16{1, 2, 3};
+        std::vector<u16> rgba16(4);
+        TRAP::INTERNAL::ConvertRGBToRGBA(std::span(reinterpret_cast<const u8*>(rgb16.data()), rgb16.size() * sizeof(u16)),
+                                         std::span(reinterpret_cast<u8*>(rgba16.data()), rgba16.size() * sizeof(u16)), 2);
+        REQUIRE(rgba16 == std::vector<u16>{1, 2, 3, 0xFFFF});
+    }
+}
+
+TEST_CASE("TRAP::INTERNAL::ConvertBGRToRGB()", "[imageloader][pixelconversion]")
+{
+    for(const auto& [impl, name] : PixelConversionImplementations)
+    {
+        if(!TRAP::INTERNAL::IsPixelConversionImplementationSupported(impl))
+            continue;
+
+        for(const u32 channels : {3u, 4u})
+        {
+            for(const usize pixelCount : PixelCounts)
+            {
+                INFO(name << " " << channels << " channels, " << pixelCount << " pixels");
+
+                const std::vector<u8> bgr = GenerateData<u8>(pixelCount * channels, 1337);
+                std::vector<u8> expected = bgr;
+                for(usize i = 0; i < pixelCount; ++i)
+                    std::swap(expected[i * channels], expected[i * channels + 2u]);
+
+                std::vector<u8> rgb = bgr;
+                TRAP::INTERNAL::ConvertBGRToRGB(rgb, channels, impl);
+                REQUIRE(rgb == expected);
+            }
+        }
+    }
+}
+
+TEST_CASE("TRAP::INTERNAL::ConvertBGR16ToRGB24()", "[imageloader][pixelconversion]")
+{
+    for(const auto& [impl, name] : PixelConversionImplementations)
+    {
+        if(!TRAP::INTERNAL::IsPixelConversionImplementationSupported(impl))
+            continue;
+
+        for(const usize pixelCount : PixelCounts)
+        {
+            INFO(name << " " << pixelCount << " pixels");
+
+            const std::vector<u8> bgr16 = GenerateData<u8>(pixelCount * 2u, 1337);
+            std::vector<u8> expected{};
+            for(usize i = 0; i < pixelCount; ++i)
+            {
+                const std::array<u8, 3> rgb = ReferenceBGR16ToRGB24(bgr16[i * 2u], bgr16[i * 2u + 1u]);
+                expected.insert(expected.end(), rgb.begin(), rgb.end());
+            }
+
+            std::vector<u8> rgb(pixelCount * 3u);
+            TRAP::INTERNAL::ConvertBGR16ToRGB24(bgr16, rgb, impl);
+            REQUIRE(rgb == expected);
+        }
+    }
+}
+
+TEST_CASE("TRAP::INTERNAL::DecodeBGRAMap()", "[imageloader][pixelconversion]")
+{
+    const std::vector<u8> indices = GenerateData<u8>(1000, 1337);
+
+    for(const auto& [impl, name] : PixelConversionImplementations)
+    {
+        if(!TRAP::INTERNAL::IsPixelConversionImplementationSupported(impl))
+            continue;
+
+        for(u32 channels = 1; channels <= 4; ++channels)
+        {
+            INFO(name << " " << channels << " channels");
+
+            //Only 200 entries, higher indices decode to black
+            const std::vector<u8> colorMap = GenerateData<u8>(200u * channels, 42);
+
+            std::vector<u8> expected{};
+            for(const u8 index : indices)
+            {
+                if(index >= 200u)
+                {
+                    expected.insert(expected.end(), TRAP::INTERNAL::GetDecodedBGRAMapChannels(channels), 0);
+                    continue;
+                }
+
+                const u8* const entry = colorMap.data() + static_cast<usize>(index) * channels;
+                if(channels == 1)
+                    expected.push_back(entry[0]);
+                else if(channels == 2)
+                {
+                    const std::array<u8, 3> rgb = ReferenceBGR16ToRGB24(entry[0], entry[1]);
+                    expected.insert(expected.end(), rgb.begin(), rgb.end());
+                }
+                else if(channels == 3)
+                    expected.insert(expected.end(), {entry[2], entry[1], entry[0]});
+                else
+                    expected.insert(expected.end(), {entry[2], entry[1], entry[0], entry[3]});
+            }
+
+            std::vector<u8> decoded(indices.size() * TRAP::INTERNAL::GetDecodedBGRAMapChannels(channels));
+            TRAP::INTERNAL::DecodeBGRAMap(indices, colorMap, channels, decoded, impl);
+            REQUIRE(decoded == expected);
+        }
+    }
+}
+
+TEST_CASE("TRAP::INTERNAL::ConvertF32ToF16()", "[imageloader][pixelconversion]")
+{
+    //Input and expected half float, covering rounding ties, overflow, subnormals and special values
+    const std::vector<std::pair<f32, u16>> values
+    {
+        {0.0f, 0x0000}, {-0.0f, 0x8000}, {1.0f, 0x3C00}, {-2.0f, 0xC000}, {0.5f, 0x3800},
+        {65504.0f, 0x7BFF}, {65519.0f, 0x7BFF}, {65520.0f, 0x7C00}, {1e10f, 0x7C00}, {-1e10f, 0xFC00},
+        {1.0f + std::ldexp(1.0f, -11), 0x3C00}, //Tie, rounds to even
+        {1.0f + 3.0f * std::ldexp(1.0f, -11), 0x3C02}, //Tie, rounds to even
+        {1.0f + std::ldexp(1.0f, -11) + std::ldexp(1.0f, -20), 0x3C01},
+        {std::ldexp(1.0f, -14), 0x0400}, {std::ldexp(1.0f, -24), 0x0001}, {std::ldexp(1.0f, -25), 0x0000},
+        {std::ldexp(1.5f, -25), 0x0001}, {std::ldexp(3.0f, -25), 0x0002}, {std::ldexp(1023.5f, -24), 0x0400},
+        {std::ldexp(1.0f, -130), 0x0000}, {-std::ldexp(1.0f, -24), 0x8001},
+        {std::numeric_limits<f32>::infinity(), 0x7C00}, {-std::numeric_limits<f32>::infinity(), 0xFC00},
+        {std::numeric_limits<f32>::quiet_NaN(), 0x7E00}
+    };
+
+    std::vector<f32> src{};
+    std::vector<u16> expected{};
+    for(const auto& [value, half] : values)
+    {
+        src.push_back(value);
+        expected.push_back(half);
+    }
+
+    //Random bit patterns cover every exponent
+    std::mt19937 rng(1337);
+    std::vector<f32> randomValues(1000);
+    for(f32& v : randomValues)
+        v = std::bit_cast<f32>(static_cast<u32>(rng()));
+
+    std::vector<u16> expectedRandom(randomValues.size());
+    TRAP::INTERNAL::ConvertF32ToF16(randomValues, expectedRandom, PixelConversionImplementation::Scalar);
+
+    for(const auto& [impl, name] : PixelConversionImplementations)
+    {
+        if(!TRAP::INTERNAL::IsPixelConversionImplementationSupported(impl))
+            continue;
+
+        INFO(name);
+
+        std::vector<u16> dst(src.size());
+        TRAP::INTERNAL::ConvertF32ToF16(src, dst, impl);
+        REQUIRE(dst == expected);
+
+        for(const usize count : PixelCounts)
+        {
+            INFO(count << " values");
+
+            std::vector<u16> random(count);
+            TRAP::INTERNAL::ConvertF32ToF16(std::span(randomValues).first(count), random, impl);
+            REQUIRE(std::ranges::equal(random, std::span(expectedRandom).first(count)));
+        }
+    }
+}
+
+TEST_CASE("TRAP::INTERNAL Pixel conversion Benchmark", "[.][benchmark][imageloader][pixelconversion]")
+{
+    static constexpr usize PixelCount = 2048u * 2048u;
+    const std::vector<u8> rgb = GenerateData<u8>(PixelCount * 3u, 1337);
+    const std::vector<u8> rgba = GenerateData<u8>(PixelCount * 4u, 42);
+    const std::vector<f32> rgbHDR = GenerateData<f32>(PixelCount * 3u, 1337);
+
+    //Per pixel loop into a freshly allocated vector, like the previous Image::ConvertRGBToRGBA() template
+    BENCHMARK("ConvertRGBToRGBA u8 2048x2048 Reference")
+    {
+        return ReferenceRGBToRGBA(rgb);
+    };
+    BENCHMARK("ConvertRGBToRGBA f32 2048x2048 Reference")
+    {
+        return ReferenceRGBToRGBA(rgbHDR);
+    };
+
+    for(const auto& [impl, name] : PixelConversionImplementations)
+    {
+        if(!TRAP::INTERNAL::IsPixelConversionImplementationSupported(impl))
+            continue;
+
+        std::vector<u8> rgbaOut(PixelCount * 4u);
+        BENCHMARK(fmt::format("ConvertRGBToRGBA u8 2048x2048 {}", name))
+        {
+            TRAP::INTERNAL::ConvertRGBToRGBA(std::span<const u8>(rgb), std::span<u8>(rgbaOut), impl);
+            return rgbaOut[0];
+        };
+
+        std::vector<f32> rgbaHDROut(PixelCount * 4u);
+        BENCHMARK(fmt::format("ConvertRGBToRGBA f32 2048x2048 {}", name))
+        {
+            TRAP::INTERNAL::ConvertRGBToRGBA(std::span<const f32>(rgbHDR), std::span<f32>(rgbaHDROut), impl);
+            return rgbaHDROut[0];
+        };
+
+        std::vector<u8> rgbOut(PixelCount * 3u);
+        BENCHMARK(fmt::format("ConvertRGBAToRGB u8 2048x2048 {}", name))
+        {
+            TRAP::INTERNAL::ConvertRGBAToRGB(std::span<const u8>(rgba), std::span<u8>(rgbOut), impl);
+            return rgbOut[0];
+        };
+
+        std::vector<u8> bgr = rgb;
+        BENCHMARK(fmt::format("ConvertBGRToRGB 3 channels 2048x2048 {}", name))
+        {
+            TRAP::INTERNAL::ConvertBGRToRGB(bgr, 3, impl);
+            return bgr[0];
+        };
+
+        const std::vector<u8> indices(rgb.begin(), rgb.begin() + static_cast<std::ptrdiff_t>(PixelCount));
+        std::vector<u8> decoded(PixelCount * 4u);
+        BENCHMARK(fmt::format("DecodeBGRAMap 4 channels 2048x2048 {}", name))
+        {
+            TRAP::INTERNAL::DecodeBGRAMap(indices, std::span(rgba).first(256u * 4u), 4, decoded, impl);
+            return decoded[0];
+        };
+
+        std::vector<u16> rgbHDRHalf(rgbHDR.size());
+        BENCHMARK(fmt::format("ConvertF32ToF16 RGB 2048x2048 {}", name))
+        {
+            TRAP::INTERNAL::ConvertF32ToF16(rgbHDR, rgbHDRHalf, impl);
+            return rgbHDRHalf[0];
+        };
+    }
+}
@@ -0,0 +1,105 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <random>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "ImageLoader/Image.h"
+#include "ImageLoader/PortableNetworkGraphics/PNGImage.h"
+
+namespace
+{
+    const std::filesystem::path TestFilesPath = "Testfiles/ImageLoader";
+
+    using CompressionLevel = TRAP::Utils::Compress::CompressionLevel;
+
+    constexpr std::array<std::pair<CompressionLevel, std::string_view>, 3> CompressionLevels
+    {
+        {
+            {CompressionLevel::None, "None"},
+            {CompressionLevel::Fastest, "Fastest"},
+            {CompressionLevel::Fast, "Fast"}
+        }
+    };
+
+    /// @brief Gradient with some noise, similar to a rendered frame.
+    [[nodiscard]] std::vector<u8> GenerateImageData(const u32 width, const u32 height, const u32 channels)
+    {
+        std::mt19937 rng(1337);
+        std::uniform_int_distribution<u32> noise(0, 7);
+
+        std::vector<u8> data(static_cast<usize>(width) * height * channels);
+        for(u32 y = 0; y < height; ++y)
+        {
+            for(u32 x = 0; x < width; ++x)
+            {
+                for(u32 c = 0; c < channels; ++c)
+                    data[(static_cast<usize>(y) * width + x) * channels + c] = static_cast<u8>(x + y * c + noise(rng));
+            }
+        }
+
+        return data;
+    }
+
+    void RequireSameImage(const TRAP::Image& lhs, const TRAP::Image& rhs)
+    {
+        REQUIRE(lhs.GetWidth() == rhs.GetWidth());
+        REQUIRE(lhs.GetHeight() == rhs.GetHeight());
+        REQUIRE(lhs.GetColorFormat() == rhs.GetColorFormat());
+        REQUIRE(lhs.GetBitsPerPixel() == rhs.GetBitsPerPixel());
+        REQUIRE(std::ranges::equal(lhs.GetPixelData(), rhs.GetPixelData()));
+    }
+}
+
+TEST_CASE("TRAP::INTERNAL::PNGImage::Encode()", "[imageloader][png][encode]")
+{
+    std::vector<TRAP::Scope<TRAP::Image>> images{};
+    images.push_back(TRAP::Image::LoadFromFile(TestFilesPath / "Test24BPPBigInterlaced.png"));
+    images.push_back(TRAP::Image::LoadFromFile(TestFilesPath / "Test48BPPBig.png"));
+    images.push_back(TRAP::Image::LoadFromMemory(67, 31, TRAP::Image::ColorFormat::GrayScale, GenerateImageData(67, 31, 1)));
+    images.push_back(TRAP::Image::LoadFromMemory(67, 31, TRAP::Image::ColorFormat::GrayScaleAlpha, GenerateImageData(67, 31, 2)));
+    images.push_back(TRAP::Image::LoadFromMemory(67, 31, TRAP::Image::ColorFormat::RGBA, GenerateImageData(67, 31, 4)));
+
+    for(const auto& [level, levelName] : CompressionLevels)
+    {
+        for(const auto& image : images)
+        {
+            INFO(levelName << " " << image->GetWidth() << "x" << image->GetHeight() << " " << image->GetBitsPerPixel() << " BPP");
+
+            const std::vector<u8> encoded = TRAP::INTERNAL::PNGImage::Encode(image.get(), level);
+            REQUIRE(!encoded.empty());
+
+            const TRAP::Scope<TRAP::Image> decoded = TRAP::Image::LoadFromMemory(encoded);
+            RequireSameImage(*decoded, *image);
+        }
+    }
+
+    SECTION("HDR images are not supported")
+    {
+        const TRAP::Scope<TRAP::Image> image = TRAP::Image::LoadFromMemory(2, 2, TRAP::Image::ColorFormat::RGB,
+                                                                           std::vector<f32>(12, 1.0f));
+        REQUIRE(TRAP::INTERNAL::PNGImage::Encode(image.get()).empty());
+    }
+}
+
+TEST_CASE("TRAP::INTERNAL::PNGImage::Encode() Benchmark", "[.][benchmark][imageloader][png][encode]")
+{
+    //A 1080p RGBA screenshot
+    const TRAP::Scope<TRAP::Image> image = TRAP::Image::LoadFromMemory(1920, 1080, TRAP::Image::ColorFormat::RGBA,
+                                                                       GenerateImageData(1920, 1080, 4));
+
+    for(const auto& [level, name] : CompressionLevels)
+    {
+        BENCHMARK(fmt::format("Encode PNG {} RGBA8 1920x1080", name))
+        {
+            return TRAP::INTERNAL::PNGImage::Encode(image.get(), level);
+        };
+    }
+}
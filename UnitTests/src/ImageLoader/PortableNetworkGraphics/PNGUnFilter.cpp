@@ -0,0 +1,145 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "ImageLoader/PortableNetworkGraphics/PNGUnFilter.h"
+
+namespace
+{
+    using PNGUnFilterImplementation = TRAP::INTERNAL::PNGUnFilterImplementation;
+
+    constexpr std::array<std::pair<PNGUnFilterImplementation, std::string_view>, 3> PNGUnFilterImplementations
+    {
+        {
+            {PNGUnFilterImplementation::Scalar, "Scalar"},
+            {PNGUnFilterImplementation::SSE2, "SSE2"},
+            {PNGUnFilterImplementation::AVX2, "AVX2"}
+        }
+    };
+
+    [[nodiscard]] std::vector<u8> GenerateData(const usize size, const u32 seed)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<u32> dist(0, 255);
+
+        std::vector<u8> data(size);
+        for(u8& b : data)
+            b = static_cast<u8>(dist(rng));
+
+        return data;
+    }
+}
+
+TEST_CASE("TRAP::INTERNAL::PNGUnFilterScanline()", "[imageloader][png][unfilter]")
+{
+    //Every implementation must match the scalar one for all filter types and pixel sizes
+    static constexpr usize MaxLength = 8u * 67u;
+    const std::vector<u8> scanline = GenerateData(MaxLength, 1337);
+    const std::vector<u8> precon = GenerateData(MaxLength, 42);
+
+    for(const auto& [impl, name] : PNGUnFilterImplementations)
+    {
+        if(!TRAP::INTERNAL::IsPNGUnFilterImplementationSupported(impl))
+            continue;
+
+        for(usize byteWidth = 1; byteWidth <= 8; ++byteWidth)
+        {
+            for(u8 filterType = 0; filterType < 5; ++filterType)
+            {
+                for(usize pixels = 1; pixels <= 67; pixels += 3)
+                {
+                    const usize length = pixels * byteWidth;
+
+                    for(const u8* const previous : {precon.data(), static_cast<const u8*>(nullptr)})
+                    {
+                        INFO(name << " byte width: " << byteWidth << " filter type: " << u32(filterType) <<
+                             " length: " << length << " first scanline: " << (previous == nullptr));
+
+                        std::vector<u8> expected(length);
+                        REQUIRE(TRAP::INTERNAL::PNGUnFilterScanline(expected.data(), scanline.data(), previous, byteWidth,
+                                                                    filterType, length, PNGUnFilterImplementation::Scalar));
+
+                        std::vector<u8> result(length);
+                        REQUIRE(TRAP::INTERNAL::PNGUnFilterScanline(result.data(), scanline.data(), previous, byteWidth,
+                                                                    filterType, length, impl));
+                        REQUIRE(result == expected);
+
+                        //Unfiltering in place
+                        std::vector<u8> inPlace(scanline.begin(), scanline.begin() + static_cast<isize>(length));
+                        REQUIRE(TRAP::INTERNAL::PNGUnFilterScanline(inPlace.data(), inPlace.data(), previous, byteWidth,
+                                                                    filterType, length, impl));
+                        REQUIRE(inPlace == expected);
+                    }
+                }
+            }
+        }
+
+        INFO(name);
+        std::vector<u8> result(16);
+        REQUIRE_FALSE(TRAP::INTERNAL::PNGUnFilterScanline(result.data(), scanline.data(), precon.data(), 4, 5, 16, impl));
+    }
+}
+
+TEST_CASE("TRAP::INTERNAL::PNGFilterScanline()", "[imageloader][png][filter]")
+{
+    //Filtering followed by unfiltering must give back the original scanline
+    static constexpr usize Length = 4u * 67u;
+    const std::vector<u8> scanline = GenerateData(Length, 1337);
+    const std::vector<u8> previous = GenerateData(Length, 42);
+
+    for(usize byteWidth = 1; byteWidth <= 8; byteWidth *= 2)
+    {
+        for(u8 filterType = 0; filterType < 5; ++filterType)
+        {
+            for(const u8* const prev : {previous.data(), static_cast<const u8*>(nullptr)})
+            {
+                INFO("byte width: " << byteWidth << " filter type: " << u32(filterType) << " first scanline: " << (prev == nullptr));
+
+                std::vector<u8> filtered(Length);
+                REQUIRE(TRAP::INTERNAL::PNGFilterScanline(filtered.data(), scanline.data(), prev, byteWidth, filterType, Length));
+
+                std::vector<u8> result(Length);
+                REQUIRE(TRAP::INTERNAL::PNGUnFilterScanline(result.data(), filtered.data(), prev, byteWidth, filterType, Length,
+                                                            PNGUnFilterImplementation::Scalar));
+                REQUIRE(result == scanline);
+            }
+        }
+    }
+
+    std::vector<u8> result(16);
+    REQUIRE_FALSE(TRAP::INTERNAL::PNGFilterScanline(result.data(), scanline.data(), previous.data(), 4, 5, 16));
+}
+
+TEST_CASE("TRAP::INTERNAL::PNGUnFilterScanline() Benchmark", "[.][benchmark][imageloader][png][unfilter]")
+{
+    //A 4096 pixel wide RGBA scanline
+    static constexpr usize Length = 4096u * 4u;
+    const std::vector<u8> scanline = GenerateData(Length, 1337);
+    const std::vector<u8> precon = GenerateData(Length, 42);
+    std::vector<u8> recon(Length);
+
+    static constexpr std::array<std::string_view, 5> FilterNames{"None", "Sub", "Up", "Average", "Paeth"};
+
+    for(const auto& [impl, name] : PNGUnFilterImplementations)
+    {
+        if(!TRAP::INTERNAL::IsPNGUnFilterImplementationSupported(impl))
+            continue;
+
+        for(u8 filterType = 1; filterType < 5; ++filterType)
+        {
+            BENCHMARK(fmt::format("UnFilter {} {} RGBA8 4096 pixels", name, FilterNames[filterType]))
+            {
+                return TRAP::INTERNAL::PNGUnFilterScanline(recon.data(), scanline.data(), precon.data(), 4,
+                                                           filterType, Length, impl);
+            };
+        }
+    }
+}
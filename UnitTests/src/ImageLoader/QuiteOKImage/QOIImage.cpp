@@ -0,0 +1,315 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "ImageLoader/Image.h"
+#include "ImageLoader/QuiteOKImage/QOIImage.h"
+#include "Utils/ByteReader.h"
+
+namespace
+{
+    const std::filesystem::path TestFilesPath = "Testfiles/ImageLoader";
+
+    /// @brief Gradient with flat areas and some noise, exercises every QOI operation.
+    [[nodiscard]] std::vector<u8> GenerateImageData(const u32 width, const u32 height, const u32 channels)
+    {
+        std::mt19937 rng(1337);
+        std::uniform_int_distribution<u32> noise(0, 255);
+
+        std::vector<u8> data(static_cast<usize>(width) * height * channels);
+        for(u32 y = 0; y < height; ++y)
+        {
+            for(u32 x = 0; x < width; ++x)
+            {
+                for(u32 c = 0; c < channels; ++c)
+                {
+                    u8 value = static_cast<u8>(x / 8u + c * 40u);
+                    if(y % 3u == 1u)
+                        value = static_cast<u8>(noise(rng));
+                    data[(static_cast<usize>(y) * width + x) * channels + c] = value;
+                }
+            }
+        }
+
+        return data;
+    }
+
+    /// @brief Byte by byte QOI decoder, the stream based decoder QOIImage used before.
+    ///        Serves as reference for the results and the speed of QOIImage.
+    /// @param encoded Complete QOI file.
+    /// @return Decoded pixels.
+    [[nodiscard]] std::vector<u8> ReferenceDecode(const std::span<const u8> encoded)
+    {
+        struct Pixel
+        {
+            u8 Red;
+            u8 Green;
+            u8 Blue;
+            u8 Alpha;
+        };
+
+        static constexpr usize HeaderSize = 14u;
+        static constexpr usize EndMarkerSize = 8u;
+
+        const u32 width = (u32(encoded[4]) << 24u) | (u32(encoded[5]) << 16u) | (u32(encoded[6]) << 8u) | encoded[7];
+        const u32 height = (u32(encoded[8]) << 24u) | (u32(encoded[9]) << 16u) | (u32(encoded[10]) << 8u) | encoded[11];
+        const u32 channels = encoded[12];
+
+        std::vector<u8> data(static_cast<usize>(width) * height * channels);
+        TRAP::Utils::ByteReader reader(encoded.subspan(HeaderSize));
+
+        Pixel prevPixel{0, 0, 0, 255};
+        std::array<Pixel, 64> prevPixels{};
+
+        for(usize pixelIndex = 0; pixelIndex < data.size();)
+        {
+            if(reader.GetRemainingSize() > EndMarkerSize)
+            {
+                const u8 tag = reader.ReadByte();
+
+                if(tag == 0xFE) //QOI_OP_RGB
+                {
+                    prevPixel.Red = reader.ReadByte();
+                    prevPixel.Green = reader.ReadByte();
+                    prevPixel.Blue = reader.ReadByte();
+                }
+                else if(tag == 0xFF) //QOI_OP_RGBA
+                {
+                    prevPixel.Red = reader.ReadByte();
+                    prevPixel.Green = reader.ReadByte();
+                    prevPixel.Blue = reader.ReadByte();
+                    prevPixel.Alpha = reader.ReadByte();
+                }
+                else if((tag & 0xC0u) == 0x00) //QOI_OP_INDEX
+                    prevPixel = prevPixels[tag & 0x3Fu];
+                else if((tag & 0xC0u) == 0x40) //QOI_OP_DIFF
+                {
+                    prevPixel.Red   += static_cast<u8>(((tag >> 4u) & 0x03u) - 2u);
+                    prevPixel.Green += static_cast<u8>(((tag >> 2u) & 0x03u) - 2u);
+                    prevPixel.Blue  += static_cast<u8>((tag & 0x03u) - 2u);
+                }
+                else if((tag & 0xC0u) == 0x80) //QOI_OP_LUMA
+                {
+                    const u8 lumaData = reader.ReadByte();
+                    const u8 vg = static_cast<u8>((tag & 0x3Fu) - 32u);
+                    prevPixel.Red   += static_cast<u8>(vg - 8u + (lumaData >> 4u));
+                    prevPixel.Green += vg;
+                    prevPixel.Blue  += static_cast<u8>(vg - 8u + (lumaData & 0x0Fu));
+                }
+                else //QOI_OP_RUN, the last pixel is written once more below
+                {
+                    for(u32 run = tag & 0x3Fu; run > 0u && pixelIndex < data.size(); --run)
+                    {
+                        data[pixelIndex++] = prevPixel.Red;
+                        data[pixelIndex++] = prevPixel.Green;
+                        data[pixelIndex++] = prevPixel.Blue;
+                        if(channels == 4u)
+                            data[pixelIndex++] = prevPixel.Alpha;
+                    }
+                    if(pixelIndex == data.size())
+                        break;
+                }
+
+                prevPixels[(prevPixel.Red * 3u + prevPixel.Green * 5u + prevPixel.Blue * 7u + prevPixel.Alpha * 11u) % 64u] = prevPixel;
+            }
+
+            data[pixelIndex++] = prevPixel.Red;
+            data[pixelIndex++] = prevPixel.Green;
+            data[pixelIndex++] = prevPixel.Blue;
+            if(channels == 4u)
+                data[pixelIndex++] = prevPixel.Alpha;
+        }
+
+        return data;
+    }
+}
+
+TEST_CASE("TRAP::INTERNAL::QOIImage::Encode()", "[imageloader][qoi][encode]")
+{
+    SECTION("RGB(A) round trip")
+    {
+        std::vector<TRAP::Scope<TRAP::Image>> images{};
+        images.push_back(TRAP::Image::LoadFromFile(TestFilesPath / "Test32BPPsRGB.qoi"));
+        images.push_back(TRAP::Image::LoadFromFile(TestFilesPath / "Test24BPPBigInterlaced.png"));
+        images.push_back(TRAP::Image::LoadFromMemory(300, 21, TRAP::Image::ColorFormat::RGB, GenerateImageData(300, 21, 3)));
+        images.push_back(TRAP::Image::LoadFromMemory(300, 21, TRAP::Image::ColorFormat::RGBA, GenerateImageData(300, 21, 4)));
+
+        for(const auto& image : images)
+        {
+            INFO(image->GetWidth() << "x" << image->GetHeight() << " " << image->GetBitsPerPixel() << " BPP");
+
+            const std::vector<u8> encoded = TRAP::INTERNAL::QOIImage::Encode(image.get());
+            REQUIRE(!encoded.empty());
+
+            const TRAP::Scope<TRAP::Image> decoded = TRAP::Image::LoadFromMemory(encoded);
+            REQUIRE(decoded->GetWidth() == image->GetWidth());
+            REQUIRE(decoded->GetHeight() == image->GetHeight());
+            REQUIRE(decoded->GetColorFormat() == image->GetColorFormat());
+            REQUIRE(std::ranges::equal(decoded->GetPixelData(), image->GetPixelData()));
+        }
+    }
+
+    SECTION("Re-encoding a QOI file gives the same file")
+    {
+        const TRAP::Scope<TRAP::Image> image = TRAP::Image::LoadFromFile(TestFilesPath / "Test32BPPsRGB.qoi");
+        const std::vector<u8> encoded = TRAP::INTERNAL::QOIImage::Encode(image.get());
+
+        std::ifstream file(TestFilesPath / "Test32BPPsRGB.qoi", std::ios::binary);
+        REQUIRE(file.is_open());
+        const std::vector<u8> expected{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+        REQUIRE(encoded == expected);
+    }
+
+    SECTION("GrayScale is expanded")
+    {
+        const std::vector<u8> pixels = GenerateImageData(16, 16, 2);
+        const TRAP::Scope<TRAP::Image> image = TRAP::Image::LoadFromMemory(16, 16, TRAP::Image::ColorFormat::GrayScaleAlpha, pixels);
+
+        const TRAP::Scope<TRAP::Image> decoded = TRAP::Image::LoadFromMemory(TRAP::INTERNAL::QOIImage::Encode(image.get()));
+        REQUIRE(decoded->GetColorFormat() == TRAP::Image::ColorFormat::RGBA);
+
+        const std::span<const u8> decodedPixels = decoded->GetPixelData();
+        for(usize i = 0; i < 16u * 16u; ++i)
+        {
+            REQUIRE(decodedPixels[i * 4u + 0u] == pixels[i * 2u]);
+            REQUIRE(decodedPixels[i * 4u + 1u] == pixels[i * 2u]);
+            REQUIRE(decodedPixels[i * 4u + 2u] == pixels[i * 2u]);
+            REQUIRE(decodedPixels[i * 4u + 3u] == pixels[i * 2u + 1u]);
+        }
+    }
+
+    SECTION("16 bits per channel is not supported")
+    {
+        const TRAP::Scope<TRAP::Image> image = TRAP::Image::LoadFromFile(TestFilesPath / "Test48BPPBig.png");
+        REQUIRE(TRAP::INTERNAL::QOIImage::Encode(image.get()).empty());
+    }
+}
+
+TEST_CASE("TRAP::INTERNAL::QOIImage Decode", "[imageloader][qoi][decode]")
+{
+    //2x2 RGB header
+    const std::vector<u8> header{'q', 'o', 'i', 'f', 0, 0, 0, 2, 0, 0, 0, 2, 3, 0};
+    const std::vector<u8> endMarker{0, 0, 0, 0, 0, 0, 0, 1};
+
+    SECTION("Run longer than the image is clamped")
+    {
+        std::vector<u8> data = header;
+        data.insert(data.end(), {0xFE, 1, 2, 3, 0xC0 | 61});
+        data.insert(data.end(), endMarker.begin(), endMarker.end());
+
+        const TRAP::INTERNAL::QOIImage image(data);
+        REQUIRE(std::ranges::equal(image.GetPixelData(), std::vector<u8>{1, 2, 3, 1, 2, 3, 1, 2, 3, 1, 2, 3}));
+    }
+
+    SECTION("Run at the start indexes the start pixel")
+    {
+        //2x2 RGBA header, opaque black is at index position 53
+        const std::vector<u8> rgbaHeader{'q', 'o', 'i', 'f', 0, 0, 0, 2, 0, 0, 0, 2, 4, 0};
+
+        std::vector<u8> data = rgbaHeader;
+        data.insert(data.end(), {0xC0 | 0, 53, 0xC0 | 1});
+        data.insert(data.end(), endMarker.begin(), endMarker.end());
+
+        const TRAP::INTERNAL::QOIImage image(data);
+        REQUIRE(std::ranges::equal(image.GetPixelData(), std::vector<u8>{0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255}));
+        REQUIRE(std::ranges::equal(image.GetPixelData(), ReferenceDecode(data)));
+
+        //Without the run the index position is still empty
+        data = rgbaHeader;
+        data.insert(data.end(), {53, 0xC0 | 2});
+        data.insert(data.end(), endMarker.begin(), endMarker.end());
+
+        const TRAP::INTERNAL::QOIImage noRun(data);
+        REQUIRE(std::ranges::equal(noRun.GetPixelData(), std::vector<u8>(16, 0)));
+        REQUIRE(std::ranges::equal(noRun.GetPixelData(), ReferenceDecode(data)));
+    }
+
+    SECTION("Same as the reference decoder")
+    {
+        std::vector<std::vector<u8>> encoded{};
+        for(const u32 channels : {3u, 4u})
+        {
+            const TRAP::Scope<TRAP::Image> image = TRAP::Image::LoadFromMemory(300, 21, channels == 3u ? TRAP::Image::ColorFormat::RGB :
+                                                                                                             TRAP::Image::ColorFormat::RGBA,
+                                                                               GenerateImageData(300, 21, channels));
+            encoded.push_back(TRAP::INTERNAL::QOIImage::Encode(image.get()));
+        }
+        std::ifstream file(TestFilesPath / "Test32BPPsRGB.qoi", std::ios::binary);
+        REQUIRE(file.is_open());
+        encoded.emplace_back(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+        for(const std::vector<u8>& data : encoded)
+        {
+            const TRAP::INTERNAL::QOIImage image(data);
+            REQUIRE(std::ranges::equal(image.GetPixelData(), ReferenceDecode(data)));
+        }
+    }
+
+    SECTION("Missing chunks repeat the last pixel")
+    {
+        std::vector<u8> data = header;
+        data.insert(data.end(), {0xFE, 10, 20, 30, 0x40 | 0x3F});
+        data.insert(data.end(), endMarker.begin(), endMarker.end());
+
+        const TRAP::INTERNAL::QOIImage image(data);
+        REQUIRE(std::ranges::equal(image.GetPixelData(), std::vector<u8>{10, 20, 30, 11, 21, 31, 11, 21, 31, 11, 21, 31}));
+    }
+}
+
+TEST_CASE("TRAP::INTERNAL::QOIImage::Encode() Benchmark", "[.][benchmark][imageloader][qoi][encode]")
+{
+    //A 1080p RGBA screenshot
+    const TRAP::Scope<TRAP::Image> image = TRAP::Image::LoadFromMemory(1920, 1080, TRAP::Image::ColorFormat::RGBA,
+                                                                       GenerateImageData(1920, 1080, 4));
+
+    BENCHMARK("Encode QOI RGBA8 1920x1080")
+    {
+        return TRAP::INTERNAL::QOIImage::Encode(image.get());
+    };
+}
+
+TEST_CASE("TRAP::INTERNAL::QOIImage Decode Benchmark", "[.][benchmark][imageloader][qoi][decode]")
+{
+    const TRAP::Scope<TRAP::Image> rgba = TRAP::Image::LoadFromMemory(1920, 1080, TRAP::Image::ColorFormat::RGBA,
+                                                                      GenerateImageData(1920, 1080, 4));
+    const TRAP::Scope<TRAP::Image> rgb = TRAP::Image::LoadFromMemory(1920, 1080, TRAP::Image::ColorFormat::RGB,
+                                                                     GenerateImageData(1920, 1080, 3));
+    const TRAP::Scope<TRAP::Image> photo = TRAP::Image::LoadFromFile(TestFilesPath / "Test24BPPBigInterlaced.png");
+
+    const std::vector<u8> encodedRGBA = TRAP::INTERNAL::QOIImage::Encode(rgba.get());
+    const std::vector<u8> encodedRGB = TRAP::INTERNAL::QOIImage::Encode(rgb.get());
+    const std::vector<u8> encodedPhoto = TRAP::INTERNAL::QOIImage::Encode(photo.get());
+
+    BENCHMARK("Decode QOI RGBA8 1920x1080")
+    {
+        return TRAP::INTERNAL::QOIImage(encodedRGBA);
+    };
+    BENCHMARK("Decode QOI RGBA8 1920x1080 (Reference)")
+    {
+        return ReferenceDecode(encodedRGBA);
+    };
+    BENCHMARK("Decode QOI RGB8 1920x1080")
+    {
+        return TRAP::INTERNAL::QOIImage(encodedRGB);
+    };
+    BENCHMARK("Decode QOI RGB8 1920x1080 (Reference)")
+    {
+        return ReferenceDecode(encodedRGB);
+    };
+    BENCHMARK("Decode QOI RGB8 Test24BPPBigInterlaced.png")
+    {
+        return TRAP::INTERNAL::QOIImage(encodedPhoto);
+    };
+    BENCHMARK("Decode QOI RGB8 Test24BPPBigInterlaced.png (Reference)")
+    {
+        return ReferenceDecode(encodedPhoto);
+    };
+}
@@ -0,0 +1,400 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <array>
+#include <cmath>
+#include <random>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "ImageLoader/TextureCompression/BlockCompression.h"
+#include "ThreadPool/Parallel.h"
+
+namespace
+{
+    using ImageFormat = TRAP::Graphics::API::ImageFormat;
+    using BlockCompressionImplementation = TRAP::INTERNAL::BlockCompressionImplementation;
+
+    constexpr std::array<std::pair<BlockCompressionImplementation, std::string_view>, 2> BlockCompressionImplementations
+    {
+        {
+            {BlockCompressionImplementation::Scalar, "Scalar"},
+            {BlockCompressionImplementation::AVX2, "AVX2"}
+        }
+    };
+
+    constexpr f64 BC1MinPSNR = 36.0;
+    constexpr f64 BC3MinPSNR = 37.0;
+    constexpr f64 BC7MinPSNR = 38.0;
+
+    /// @brief Image like data: smooth gradients, hard edges, an alpha ramp and a bit of noise.
+    [[nodiscard]] std::vector<u8> GenerateTestImage(const u32 width, const u32 height)
+    {
+        std::mt19937 rng(1337);
+        std::uniform_int_distribution<i32> noise(-4, 4);
+
+        std::vector<u8> rgba(static_cast<usize>(width) * height * 4u);
+        for(u32 y = 0; y < height; ++y)
+        {
+            for(u32 x = 0; x < width; ++x)
+            {
+                u8* const pixel = rgba.data() + (static_cast<usize>(y) * width + x) * 4u;
+                const f32 fx = static_cast<f32>(x) / static_cast<f32>(width);
+                const f32 fy = static_cast<f32>(y) / static_cast<f32>(height);
+                const bool edge = ((x / 37u) + (y / 23u)) % 2u == 0u;
+
+                const std::array<f32, 4> color
+                {
+                    255.0f * fx,
+                    127.5f + 127.5f * std::sin(fy * 12.0f),
+                    edge ? 200.0f : 40.0f,
+                    255.0f * fy
+                };
+                for(usize c = 0; c < 4; ++c)
+                    pixel[c] = static_cast<u8>(std::clamp(static_cast<i32>(color[c]) + noise(rng), 0, 255));
+            }
+        }
+
+        return rgba;
+    }
+
+    //Reference decoders--------------------------------------------------------------------------------------------//
+
+    void DecodeBC1Color(const u8* const block, u8* const rgba, const bool forceFourColor)
+    {
+        const u16 color0 = static_cast<u16>(block[0] | (block[1] << 8u));
+        const u16 color1 = static_cast<u16>(block[2] | (block[3] << 8u));
+        const u32 indices = block[4] | (block[5] << 8u) | (block[6] << 16u) | (static_cast<u32>(block[7]) << 24u);
+
+        const auto expand = [](const u16 c)
+        {
+            const u32 r = (c >> 11u) & 0x1Fu;
+            const u32 g = (c >> 5u) & 0x3Fu;
+            const u32 b = c & 0x1Fu;
+            return std::array<u32, 4>{(r << 3u) | (r >> 2u), (g << 2u) | (g >> 4u), (b << 3u) | (b >> 2u), 255u};
+        };
+
+        std::array<std::array<u32, 4>, 4> palette{expand(color0), expand(color1)};
+        for(usize c = 0; c < 3; ++c)
+        {
+            if(forceFourColor || color0 > color1)
+            {
+                palette[2][c] = (2u * palette[0][c] + palette[1][c]) / 3u;
+                palette[3][c] = (palette[0][c] + 2u * palette[1][c]) / 3u;
+            }
+            else
+            {
+                palette[2][c] = (palette[0][c] + palette[1][c]) / 2u;
+                palette[3][c] = 0u;
+            }
+        }
+        palette[2][3] = 255u;
+        palette[3][3] = (forceFourColor || color0 > color1) ? 255u : 0u;
+
+        for(usize i = 0; i < 16; ++i)
+        {
+            const std::array<u32, 4>& color = palette[(indices >> (i * 2u)) & 3u];
+            for(usize c = 0; c < 4; ++c)
+                rgba[i * 4u + c] = static_cast<u8>(color[c]);
+        }
+    }
+
+    void DecodeBC3Alpha(const u8* const block, u8* const rgba)
+    {
+        const u32 alpha0 = block[0];
+        const u32 alpha1 = block[1];
+        u64 indices = 0;
+        for(usize i = 0; i < 6; ++i)
+            indices |= static_cast<u64>(block[2 + i]) << (i * 8u);
+
+        std::array<u32, 8> palette{alpha0, alpha1};
+        if(alpha0 > alpha1)
+        {
+            for(u32 i = 1; i < 7; ++i)
+                palette[i + 1] = ((7u - i) * alpha0 + i * alpha1) / 7u;
+        }
+        else
+        {
+            for(u32 i = 1; i < 5; ++i)
+                palette[i + 1] = ((5u - i) * alpha0 + i * alpha1) / 5u;
+            palette[6] = 0u;
+            palette[7] = 255u;
+        }
+
+        for(usize i = 0; i < 16; ++i)
+            rgba[i * 4u + 3u] = static_cast<u8>(palette[(indices >> (i * 3u)) & 7u]);
+    }
+
+    void DecodeBC7Mode6(const u8* const block, u8* const rgba)
+    {
+        usize position = 0;
+        const auto read = [&](const u32 bitCount)
+        {
+            u32 value = 0;
+            for(u32 i = 0; i < bitCount; ++i, ++position)
+                value |= static_cast<u32>((block[position / 8u] >> (position % 8u)) & 1u) << i;
+            return value;
+        };
+
+        REQUIRE(read(7) == (1u << 6u));
+
+        std::array<std::array<u32, 4>, 2> endpoints{};
+        for(usize c = 0; c < 4; ++c)
+        {
+            endpoints[0][c] = read(7);
+            endpoints[1][c] = read(7);
+        }
+        const u32 pBit0 = read(1);
+        const u32 pBit1 = read(1);
+        for(usize c = 0; c < 4; ++c)
+        {
+            endpoints[0][c] = (endpoints[0][c] << 1u) | pBit0;
+            endpoints[1][c] = (endpoints[1][c] << 1u) | pBit1;
+        }
+
+        static constexpr std::array<u32, 16> Weights{0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+        for(usize i = 0; i < 16; ++i)
+        {
+            const u32 weight = Weights[read(i == 0 ? 3 : 4)];
+            for(usize c = 0; c < 4; ++c)
+                rgba[i * 4u + c] = static_cast<u8>(((64u - weight) * endpoints[0][c] + weight * endpoints[1][c] + 32u) >> 6u);
+        }
+    }
+
+    [[nodiscard]] std::vector<u8> Decompress(const std::span<const u8> blocks, const u32 width, const u32 height,
+                                             const ImageFormat format)
+    {
+        const u32 blocksX = (width + 3u) / 4u;
+        const u32 blocksY = (height + 3u) / 4u;
+        const usize blockSize = TRAP::Graphics::API::ImageFormatBitSizeOfBlock(format) / 8u;
+        REQUIRE(blocks.size() == static_cast<usize>(blocksX) * blocksY * blockSize);
+
+        std::vector<u8> rgba(static_cast<usize>(width) * height * 4u);
+        for(u32 blockY = 0; blockY < blocksY; ++blockY)
+        {
+            for(u32 blockX = 0; blockX < blocksX; ++blockX)
+            {
+                const u8* const block = blocks.data() + (static_cast<usize>(blockY) * blocksX + blockX) * blockSize;
+                std::array<u8, 64> pixels{};
+
+                if(format == ImageFormat::DXBC3_UNORM || format == ImageFormat::DXBC3_SRGB)
+                {
+                    DecodeBC1Color(block + 8, pixels.data(), true);
+                    DecodeBC3Alpha(block, pixels.data());
+                }
+                else if(format == ImageFormat::DXBC7_UNORM || format == ImageFormat::DXBC7_SRGB)
+                    DecodeBC7Mode6(block, pixels.data());
+                else
+                    DecodeBC1Color(block, pixels.data(), false);
+
+                for(u32 y = 0; y < 4 && blockY * 4u + y < height; ++y)
+                {
+                    for(u32 x = 0; x < 4 && blockX * 4u + x < width; ++x)
+                    {
+                        std::copy_n(pixels.data() + (y * 4u + x) * 4u, 4,
+                                    rgba.data() + ((static_cast<usize>(blockY) * 4u + y) * width + blockX * 4u + x) * 4u);
+                    }
+                }
+            }
+        }
+
+        return rgba;
+    }
+
+    /// @brief Peak signal to noise ratio in dB over the first channelCount channels.
+    [[nodiscard]] f64 PSNR(const std::span<const u8> lhs, const std::span<const u8> rhs, const usize channelCount)
+    {
+        f64 squaredError = 0.0;
+        usize count = 0;
+        for(usize i = 0; i < lhs.size(); i += 4)
+        {
+            for(usize c = 0; c < channelCount; ++c)
+            {
+                const f64 diff = static_cast<f64>(lhs[i + c]) - static_cast<f64>(rhs[i + c]);
+                squaredError += diff * diff;
+                ++count;
+            }
+        }
+
+        if(squaredError == 0.0)
+            return std::numeric_limits<f64>::infinity();
+
+        return 10.0 * std::log10((255.0 * 255.0) / (squaredError / static_cast<f64>(count)));
+    }
+
+    [[nodiscard]] std::vector<u8> Compress(const std::span<const u8> rgba, const u32 width, const u32 height,
+                                           const ImageFormat format)
+    {
+        return TRAP::INTERNAL::CompressImage(TRAP::INTERNAL::GetParallelThreadPool(), rgba, width, height, format);
+    }
+
+    [[nodiscard]] std::vector<u8> Compress(const std::span<const u8> rgba, const u32 width, const u32 height,
+                                           const ImageFormat format, const BlockCompressionImplementation impl)
+    {
+        return TRAP::INTERNAL::CompressImage(TRAP::INTERNAL::GetParallelThreadPool(), rgba, width, height, format, impl);
+    }
+}
+
+TEST_CASE("TRAP::INTERNAL::IsBlockCompressionFormatSupported()", "[imageloader][texturecompression]")
+{
+    STATIC_REQUIRE(TRAP::INTERNAL::IsBlockCompressionFormatSupported(ImageFormat::DXBC1_RGB_UNORM));
+    STATIC_REQUIRE(TRAP::INTERNAL::IsBlockCompressionFormatSupported(ImageFormat::DXBC1_RGBA_SRGB));
+    STATIC_REQUIRE(TRAP::INTERNAL::IsBlockCompressionFormatSupported(ImageFormat::DXBC3_UNORM));
+    STATIC_REQUIRE(TRAP::INTERNAL::IsBlockCompressionFormatSupported(ImageFormat::DXBC7_SRGB));
+    STATIC_REQUIRE_FALSE(TRAP::INTERNAL::IsBlockCompressionFormatSupported(ImageFormat::DXBC2_UNORM));
+    STATIC_REQUIRE_FALSE(TRAP::INTERNAL::IsBlockCompressionFormatSupported(ImageFormat::DXBC6H_UFLOAT));
+    STATIC_REQUIRE_FALSE(TRAP::INTERNAL::IsBlockCompressionFormatSupported(ImageFormat::R8G8B8A8_UNORM));
+}
+
+TEST_CASE("TRAP::INTERNAL::CompressImage()", "[imageloader][texturecompression]")
+{
+    SECTION("Solid color")
+    {
+        //RGB565 representable, so BC1 and BC3 are exact, BC7 is within the p-bit rounding
+        static constexpr std::array<u8, 4> Color{0xFF, 0x82, 0x08, 0x77};
+        std::vector<u8> solid(16u * 4u);
+        for(usize i = 0; i < 16; ++i)
+            std::ranges::copy(Color, solid.begin() + static_cast<std::ptrdiff_t>(i * 4u));
+
+        for(const ImageFormat format : {ImageFormat::DXBC1_RGB_UNORM, ImageFormat::DXBC3_UNORM, ImageFormat::DXBC7_UNORM})
+        {
+            INFO(std::to_underlying(format));
+            const std::vector<u8> decoded = Decompress(Compress(solid, 4, 4, format), 4, 4, format);
+            for(usize i = 0; i < 16; ++i)
+            {
+                for(usize c = 0; c < 4; ++c)
+                {
+                    const i32 expected = (c == 3 && format == ImageFormat::DXBC1_RGB_UNORM) ? 255 : Color[c];
+                    const i32 tolerance = format == ImageFormat::DXBC7_UNORM ? 1 : 0;
+                    REQUIRE(std::abs(decoded[i * 4u + c] - expected) <= tolerance);
+                }
+            }
+        }
+    }
+
+    SECTION("BC1 transparency")
+    {
+        std::vector<u8> rgba = GenerateTestImage(4, 4);
+        for(usize i = 0; i < 16; ++i)
+            rgba[i * 4u + 3u] = (i % 3u == 0u) ? 0u : 255u;
+
+        const std::vector<u8> withAlpha = Decompress(Compress(rgba, 4, 4, ImageFormat::DXBC1_RGBA_UNORM), 4, 4,
+                                                     ImageFormat::DXBC1_RGBA_UNORM);
+        const std::vector<u8> withoutAlpha = Decompress(Compress(rgba, 4, 4, ImageFormat::DXBC1_RGB_UNORM), 4, 4,
+                                                        ImageFormat::DXBC1_RGB_UNORM);
+        for(usize i = 0; i < 16; ++i)
+        {
+            REQUIRE(withAlpha[i * 4u + 3u] == rgba[i * 4u + 3u]);
+            REQUIRE(withoutAlpha[i * 4u + 3u] == 255u);
+        }
+
+        //Fully transparent block
+        std::ranges::fill(rgba, u8(0));
+        const std::vector<u8> transparent = Decompress(Compress(rgba, 4, 4, ImageFormat::DXBC1_RGBA_UNORM), 4, 4,
+                                                       ImageFormat::DXBC1_RGBA_UNORM);
+        REQUIRE(transparent == rgba);
+    }
+
+    SECTION("Partial edge blocks")
+    {
+        const std::vector<u8> rgba = GenerateTestImage(13, 6);
+        for(const ImageFormat format : {ImageFormat::DXBC1_RGB_UNORM, ImageFormat::DXBC3_UNORM, ImageFormat::DXBC7_UNORM})
+        {
+            INFO(std::to_underlying(format));
+            const std::vector<u8> blocks = Compress(rgba, 13, 6, format);
+            REQUIRE(blocks.size() == 4u * 2u * (TRAP::Graphics::API::ImageFormatBitSizeOfBlock(format) / 8u));
+            REQUIRE(PSNR(rgba, Decompress(blocks, 13, 6, format), 3) > 25.0);
+        }
+    }
+
+    SECTION("Quality")
+    {
+        static constexpr u32 Size = 256;
+        const std::vector<u8> rgba = GenerateTestImage(Size, Size);
+
+        for(const auto& [impl, name] : BlockCompressionImplementations)
+        {
+            if(!TRAP::INTERNAL::IsBlockCompressionImplementationSupported(impl))
+                continue;
+
+            INFO(name);
+            const std::vector<u8> bc1 = Decompress(Compress(rgba, Size, Size, ImageFormat::DXBC1_RGB_UNORM, impl), Size, Size,
+                                                   ImageFormat::DXBC1_RGB_UNORM);
+            const std::vector<u8> bc3 = Decompress(Compress(rgba, Size, Size, ImageFormat::DXBC3_UNORM, impl), Size, Size,
+                                                   ImageFormat::DXBC3_UNORM);
+            const std::vector<u8> bc7 = Decompress(Compress(rgba, Size, Size, ImageFormat::DXBC7_UNORM, impl), Size, Size,
+                                                   ImageFormat::DXBC7_UNORM);
+
+            const f64 bc1PSNR = PSNR(rgba, bc1, 3);
+            const f64 bc3PSNR = PSNR(rgba, bc3, 4);
+            const f64 bc7PSNR = PSNR(rgba, bc7, 4);
+            INFO("BC1 RGB: " << bc1PSNR << " dB, BC3 RGBA: " << bc3PSNR << " dB, BC7 RGBA: " << bc7PSNR << " dB");
+
+            REQUIRE(bc1PSNR > BC1MinPSNR);
+            REQUIRE(bc3PSNR > BC3MinPSNR);
+            REQUIRE(bc7PSNR > BC7MinPSNR);
+            REQUIRE(PSNR(rgba, bc7, 3) > bc1PSNR);
+        }
+    }
+
+    SECTION("Implementations match")
+    {
+        const std::vector<u8> rgba = GenerateTestImage(64, 48);
+        for(const ImageFormat format : {ImageFormat::DXBC1_RGB_UNORM, ImageFormat::DXBC1_RGBA_UNORM,
+                                        ImageFormat::DXBC3_UNORM, ImageFormat::DXBC7_UNORM})
+        {
+            INFO(std::to_underlying(format));
+            const std::vector<u8> expected = Compress(rgba, 64, 48, format, BlockCompressionImplementation::Scalar);
+
+            for(const auto& [impl, name] : BlockCompressionImplementations)
+            {
+                if(!TRAP::INTERNAL::IsBlockCompressionImplementationSupported(impl))
+                    continue;
+
+                INFO(name);
+                REQUIRE(Compress(rgba, 64, 48, format, impl) == expected);
+            }
+        }
+    }
+
+    SECTION("Invalid input")
+    {
+        const std::vector<u8> rgba = GenerateTestImage(4, 4);
+        REQUIRE(Compress(rgba, 4, 4, ImageFormat::R8G8B8A8_UNORM).empty());
+        REQUIRE(Compress(rgba, 8, 4, ImageFormat::DXBC1_RGB_UNORM).empty());
+        REQUIRE(Compress({}, 0, 0, ImageFormat::DXBC1_RGB_UNORM).empty());
+    }
+}
+
+TEST_CASE("TRAP::INTERNAL::CompressImage() Benchmark", "[.][benchmark][imageloader][texturecompression]")
+{
+    static constexpr u32 Size = 1024;
+    const std::vector<u8> rgba = GenerateTestImage(Size, Size);
+
+    static constexpr std::array<std::pair<ImageFormat, std::string_view>, 3> Formats
+    {
+        {
+            {ImageFormat::DXBC1_RGB_UNORM, "BC1"},
+            {ImageFormat::DXBC3_UNORM, "BC3"},
+            {ImageFormat::DXBC7_UNORM, "BC7"}
+        }
+    };
+
+    for(const auto& [impl, implName] : BlockCompressionImplementations)
+    {
+        if(!TRAP::INTERNAL::IsBlockCompressionImplementationSupported(impl))
+            continue;
+
+        for(const auto& [format, name] : Formats)
+        {
+            BENCHMARK(fmt::format("Compress {} 1024x1024 {}", name, implName))
+            {
+                return Compress(rgba, Size, Size, format, impl);
+            };
+        }
+    }
+}
@@ -0,0 +1,127 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <array>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "ImageLoader/TextureCompression/MipChain.h"
+#include "ThreadPool/Parallel.h"
+
+namespace
+{
+    using MipFilter = TRAP::TextureContainer::MipFilter;
+
+    constexpr std::array<std::pair<MipFilter, std::string_view>, 2> MipFilters
+    {
+        {
+            {MipFilter::Box, "Box"},
+            {MipFilter::Kaiser, "Kaiser"}
+        }
+    };
+
+    [[nodiscard]] std::vector<std::vector<u8>> GenerateMipChain(const std::vector<u8>& rgba, const u32 width, const u32 height,
+                                                                const MipFilter filter, const bool sRGB)
+    {
+        return TRAP::INTERNAL::GenerateMipChain(TRAP::INTERNAL::GetParallelThreadPool(), rgba, width, height, filter, sRGB);
+    }
+
+    [[nodiscard]] std::vector<u8> FillRGBA(const u32 width, const u32 height, const std::array<u8, 4>& color)
+    {
+        std::vector<u8> rgba(static_cast<usize>(width) * height * 4u);
+        for(usize i = 0; i < rgba.size(); i += 4)
+            std::ranges::copy(color, rgba.begin() + static_cast<std::ptrdiff_t>(i));
+
+        return rgba;
+    }
+}
+
+TEST_CASE("TRAP::INTERNAL::GenerateMipChain()", "[imageloader][texturecompression][mipchain]")
+{
+    SECTION("Level sizes")
+    {
+        for(const auto& [filter, name] : MipFilters)
+        {
+            INFO(name);
+
+            const std::vector<std::vector<u8>> oddLevels = GenerateMipChain(FillRGBA(5, 3, {}), 5, 3, filter, false);
+            REQUIRE(oddLevels.size() == 2);
+            REQUIRE(oddLevels[0].size() == 2u * 1u * 4u);
+            REQUIRE(oddLevels[1].size() == 1u * 1u * 4u);
+
+            const std::vector<std::vector<u8>> levels = GenerateMipChain(FillRGBA(256, 64, {}), 256, 64, filter, false);
+            REQUIRE(levels.size() == 8);
+            for(usize mip = 0; mip < levels.size(); ++mip)
+                REQUIRE(levels[mip].size() == static_cast<usize>(std::max(256u >> (mip + 1u), 1u)) * std::max(64u >> (mip + 1u), 1u) * 4u);
+
+            REQUIRE(GenerateMipChain(FillRGBA(1, 1, {}), 1, 1, filter, false).empty());
+        }
+    }
+
+    SECTION("Constant color stays constant")
+    {
+        static constexpr std::array<u8, 4> Color{200, 100, 17, 128};
+        const std::vector<u8> rgba = FillRGBA(37, 19, Color);
+
+        for(const auto& [filter, name] : MipFilters)
+        {
+            for(const bool sRGB : {false, true})
+            {
+                INFO(name << (sRGB ? " sRGB" : " Linear"));
+                for(const std::vector<u8>& level : GenerateMipChain(rgba, 37, 19, filter, sRGB))
+                    REQUIRE(level == FillRGBA(static_cast<u32>(level.size() / 4u), 1, Color));
+            }
+        }
+    }
+
+    SECTION("Gamma correct filtering")
+    {
+        //Black and white checkerboard, alpha is always linear
+        const std::vector<u8> rgba
+        {
+            0, 0, 0, 0,           255, 255, 255, 255,
+            255, 255, 255, 255,   0, 0, 0, 0
+        };
+
+        const std::vector<std::vector<u8>> linear = GenerateMipChain(rgba, 2, 2, MipFilter::Box, false);
+        REQUIRE(linear.size() == 1);
+        REQUIRE(linear[0] == std::vector<u8>{128, 128, 128, 128});
+
+        //Linear 0.5 is 188 in sRGB
+        const std::vector<std::vector<u8>> sRGB = GenerateMipChain(rgba, 2, 2, MipFilter::Box, true);
+        REQUIRE(sRGB.size() == 1);
+        REQUIRE(sRGB[0] == std::vector<u8>{188, 188, 188, 128});
+    }
+
+    SECTION("Box filter averages")
+    {
+        const std::vector<u8> rgba
+        {
+            10, 0, 255, 255,   20, 100, 255, 255,   30, 0, 0, 0,   40, 100, 0, 0
+        };
+
+        const std::vector<std::vector<u8>> levels = GenerateMipChain(rgba, 4, 1, MipFilter::Box, false);
+        REQUIRE(levels.size() == 2);
+        REQUIRE(levels[0] == std::vector<u8>{15, 50, 255, 255, 35, 50, 0, 0});
+        REQUIRE(levels[1] == std::vector<u8>{25, 50, 128, 128});
+    }
+}
+
+TEST_CASE("TRAP::INTERNAL::GenerateMipChain() Benchmark", "[.][benchmark][imageloader][texturecompression][mipchain]")
+{
+    static constexpr u32 Size = 2048;
+    std::vector<u8> rgba(static_cast<usize>(Size) * Size * 4u);
+    for(usize i = 0; i < rgba.size(); ++i)
+        rgba[i] = static_cast<u8>((i * 7u) ^ (i >> 11u));
+
+    for(const auto& [filter, name] : MipFilters)
+    {
+        BENCHMARK(fmt::format("GenerateMipChain {} sRGB 2048x2048", name))
+        {
+            return GenerateMipChain(rgba, Size, Size, filter, true);
+        };
+    }
+}
@@ -0,0 +1,301 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "ImageLoader/Image.h"
+#include "ImageLoader/TextureContainer.h"
+
+namespace
+{
+    const std::filesystem::path TestFilesPath = "Testfiles/TextureContainer";
+
+    using ImageFormat = TRAP::Graphics::API::ImageFormat;
+
+    [[nodiscard]] std::vector<u8> ReadTestFile(const std::filesystem::path& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        REQUIRE(file.is_open());
+
+        return std::vector<u8>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    /// @brief The test files fill every subresource with mipLevel * 16 + arrayLayer.
+    void RequireSubresources(const TRAP::TextureContainer& container)
+    {
+        for(u32 mip = 0; mip < container.GetMipLevels(); ++mip)
+        {
+            const u32 width = std::max(container.GetWidth() >> mip, 1u);
+            const u32 height = std::max(container.GetHeight() >> mip, 1u);
+            const u32 depth = std::max(container.GetDepth() >> mip, 1u);
+            const u64 expectedSize = TRAP::TextureContainer::CalculateSubresourceSize(container.GetImageFormat(), width,
+                                                                                      height, depth);
+
+            for(u32 layer = 0; layer < container.GetArraySize(); ++layer)
+            {
+                INFO("Mip " << mip << " Layer " << layer);
+                const std::span<const u8> data = container.GetSubresourceData(mip, layer);
+                REQUIRE(data.size() == expectedSize);
+                REQUIRE(std::ranges::all_of(data, [value = static_cast<u8>(mip * 16u + layer)](const u8 b){ return b == value; }));
+            }
+        }
+    }
+}
+
+TEST_CASE("TRAP::TextureContainer::CalculateSubresourceSize()", "[imageloader][texturecontainer]")
+{
+    STATIC_REQUIRE(TRAP::TextureContainer::CalculateSubresourceSize(ImageFormat::R8G8B8A8_UNORM, 4, 4, 1) == 64);
+    STATIC_REQUIRE(TRAP::TextureContainer::CalculateSubresourceSize(ImageFormat::R8_UNORM, 3, 5, 2) == 30);
+    STATIC_REQUIRE(TRAP::TextureContainer::CalculateSubresourceSize(ImageFormat::DXBC1_RGBA_UNORM, 8, 8, 1) == 32);
+    STATIC_REQUIRE(TRAP::TextureContainer::CalculateSubresourceSize(ImageFormat::DXBC1_RGBA_UNORM, 1, 1, 1) == 8);
+    STATIC_REQUIRE(TRAP::TextureContainer::CalculateSubresourceSize(ImageFormat::DXBC7_UNORM, 5, 5, 1) == 64);
+}
+
+TEST_CASE("TRAP::TextureContainer::IsSupportedTextureContainerFile()", "[imageloader][texturecontainer]")
+{
+    REQUIRE(TRAP::TextureContainer::IsSupportedTextureContainerFile("Test.ktx2"));
+    REQUIRE(TRAP::TextureContainer::IsSupportedTextureContainerFile("Test.KTX2"));
+    REQUIRE(TRAP::TextureContainer::IsSupportedTextureContainerFile("Test.dds"));
+    REQUIRE_FALSE(TRAP::TextureContainer::IsSupportedTextureContainerFile("Test.ktx"));
+    REQUIRE_FALSE(TRAP::TextureContainer::IsSupportedTextureContainerFile("Test.png"));
+    REQUIRE_FALSE(TRAP::TextureContainer::IsSupportedTextureContainerFile("Test"));
+}
+
+TEST_CASE("TRAP::TextureContainer::LoadFromFile() KTX2", "[imageloader][texturecontainer][ktx2]")
+{
+    SECTION("BC1 with mip chain")
+    {
+        const auto container = TRAP::TextureContainer::LoadFromFile(TestFilesPath / "BC1Mips.ktx2");
+        REQUIRE(container);
+        REQUIRE(container->GetImageFormat() == ImageFormat::DXBC1_RGBA_UNORM);
+        REQUIRE(container->GetWidth() == 8);
+        REQUIRE(container->GetHeight() == 8);
+        REQUIRE(container->GetDepth() == 1);
+        REQUIRE(container->GetArraySize() == 1);
+        REQUIRE(container->GetMipLevels() == 4);
+        REQUIRE_FALSE(container->IsCubemap());
+        RequireSubresources(*container);
+    }
+
+    SECTION("RGBA8 cube map")
+    {
+        const auto container = TRAP::TextureContainer::LoadFromFile(TestFilesPath / "RGBA8Cube.ktx2");
+        REQUIRE(container);
+        REQUIRE(container->GetImageFormat() == ImageFormat::R8G8B8A8_UNORM);
+        REQUIRE(container->GetWidth() == 4);
+        REQUIRE(container->GetHeight() == 4);
+        REQUIRE(container->GetArraySize() == 6);
+        REQUIRE(container->GetMipLevels() == 2);
+        REQUIRE(container->IsCubemap());
+        RequireSubresources(*container);
+    }
+
+    SECTION("R8 array")
+    {
+        const auto container = TRAP::TextureContainer::LoadFromFile(TestFilesPath / "R8Array.ktx2");
+        REQUIRE(container);
+        REQUIRE(container->GetImageFormat() == ImageFormat::R8_UNORM);
+        REQUIRE(container->GetWidth() == 4);
+        REQUIRE(container->GetHeight() == 2);
+        REQUIRE(container->GetArraySize() == 2);
+        REQUIRE(container->GetMipLevels() == 1);
+        RequireSubresources(*container);
+    }
+
+    SECTION("Zlib supercompression")
+    {
+        const auto container = TRAP::TextureContainer::LoadFromFile(TestFilesPath / "ZlibMips.ktx2");
+        REQUIRE(container);
+        REQUIRE(container->GetImageFormat() == ImageFormat::R8G8B8A8_UNORM);
+        REQUIRE(container->GetWidth() == 16);
+        REQUIRE(container->GetHeight() == 16);
+        REQUIRE(container->GetMipLevels() == 5);
+        RequireSubresources(*container);
+    }
+
+    SECTION("Corrupted zlib supercompression")
+    {
+        const std::vector<u8> data = ReadTestFile(TestFilesPath / "ZlibMips.ktx2");
+        REQUIRE(TRAP::TextureContainer::LoadFromMemory(data));
+
+        //UncompressedByteLength of the first level
+        static constexpr usize UncompressedByteLengthOffset = 80 + 16;
+
+        //Declared size bigger than the stream
+        std::vector<u8> corrupted = data;
+        ++corrupted[UncompressedByteLengthOffset];
+        REQUIRE_FALSE(TRAP::TextureContainer::LoadFromMemory(corrupted));
+
+        //Declared size smaller than the stream
+        corrupted = data;
+        --corrupted[UncompressedByteLengthOffset];
+        REQUIRE_FALSE(TRAP::TextureContainer::LoadFromMemory(corrupted));
+
+        //Adler32 checksum of the last level doesn't match
+        corrupted = data;
+        corrupted.back() ^= 0xFFu;
+        REQUIRE_FALSE(TRAP::TextureContainer::LoadFromMemory(corrupted));
+    }
+}
+
+TEST_CASE("TRAP::TextureContainer::LoadFromFile() DDS", "[imageloader][texturecontainer][dds]")
+{
+    SECTION("DXT1 with mip chain")
+    {
+        const auto container = TRAP::TextureContainer::LoadFromFile(TestFilesPath / "DXT1Mips.dds");
+        REQUIRE(container);
+        REQUIRE(container->GetImageFormat() == ImageFormat::DXBC1_RGBA_UNORM);
+        REQUIRE(container->GetWidth() == 8);
+        REQUIRE(container->GetHeight() == 8);
+        REQUIRE(container->GetArraySize() == 1);
+        REQUIRE(container->GetMipLevels() == 4);
+        RequireSubresources(*container);
+    }
+
+    SECTION("DX10 BC7 array")
+    {
+        const auto container = TRAP::TextureContainer::LoadFromFile(TestFilesPath / "BC7Array.dds");
+        REQUIRE(container);
+        REQUIRE(container->GetImageFormat() == ImageFormat::DXBC7_UNORM);
+        REQUIRE(container->GetArraySize() == 2);
+        REQUIRE(container->GetMipLevels() == 2);
+        REQUIRE_FALSE(container->IsCubemap());
+        RequireSubresources(*container);
+    }
+
+    SECTION("Legacy RGBA cube map")
+    {
+        const auto container = TRAP::TextureContainer::LoadFromFile(TestFilesPath / "RGBACube.dds");
+        REQUIRE(container);
+        REQUIRE(container->GetImageFormat() == ImageFormat::R8G8B8A8_UNORM);
+        REQUIRE(container->GetWidth() == 2);
+        REQUIRE(container->GetArraySize() == 6);
+        REQUIRE(container->GetMipLevels() == 1);
+        REQUIRE(container->IsCubemap());
+        RequireSubresources(*container);
+    }
+}
+
+TEST_CASE("TRAP::TextureContainer::LoadFromMemory()", "[imageloader][texturecontainer]")
+{
+    for(const auto& entry : std::filesystem::directory_iterator(TestFilesPath))
+    {
+        INFO(entry.path());
+        const std::vector<u8> data = ReadTestFile(entry.path());
+
+        const auto fromFile = TRAP::TextureContainer::LoadFromFile(entry.path());
+        const auto fromMemory = TRAP::TextureContainer::LoadFromMemory(data);
+        REQUIRE(fromFile);
+        REQUIRE(fromMemory);
+        REQUIRE(fromMemory->GetFilePath().empty());
+        REQUIRE(fromMemory->GetImageFormat() == fromFile->GetImageFormat());
+        REQUIRE(fromMemory->GetWidth() == fromFile->GetWidth());
+        REQUIRE(fromMemory->GetHeight() == fromFile->GetHeight());
+        REQUIRE(fromMemory->GetArraySize() == fromFile->GetArraySize());
+        REQUIRE(fromMemory->GetMipLevels() == fromFile->GetMipLevels());
+        RequireSubresources(*fromMemory);
+
+
+        //Truncated data must fail
+        REQUIRE_FALSE(TRAP::TextureContainer::LoadFromMemory(std::span(data).first(data.size() - 1)));
+        REQUIRE_FALSE(TRAP::TextureContainer::LoadFromMemory(std::span(data).first(32)));
+    }
+
+    //Unknown data must fail
+    const std::vector<u8> unknownData(256, 0);
+    REQUIRE_FALSE(TRAP::TextureContainer::LoadFromMemory(unknownData));
+}
+
+TEST_CASE("TRAP::TextureContainer::LoadFromFile() Invalid", "[imageloader][texturecontainer]")
+{
+    REQUIRE_FALSE(TRAP::TextureContainer::LoadFromFile(TestFilesPath / "DoesNotExist.ktx2"));
+    REQUIRE_FALSE(TRAP::TextureContainer::LoadFromFile(TestFilesPath / "DoesNotExist.png"));
+}
+
+TEST_CASE("TRAP::TextureContainer::CreateFromImage()", "[imageloader][texturecontainer]")
+{
+    std::vector<u8> pixels(37u * 20u * 3u);
+    for(usize i = 0; i < pixels.size(); ++i)
+        pixels[i] = static_cast<u8>(i * 3u);
+    const auto image = TRAP::Image::LoadFromMemory(37, 20, TRAP::Image::ColorFormat::RGB, pixels);
+    REQUIRE(image);
+
+    for(const ImageFormat format : {ImageFormat::R8G8B8A8_SRGB, ImageFormat::DXBC1_RGB_UNORM, ImageFormat::DXBC3_SRGB,
+                                    ImageFormat::DXBC7_UNORM})
+    {
+        INFO(std::to_underlying(format));
+        const auto container = TRAP::TextureContainer::CreateFromImage(*image, format);
+        REQUIRE(container);
+        REQUIRE(container->GetImageFormat() == format);
+        REQUIRE(container->GetWidth() == 37);
+        REQUIRE(container->GetHeight() == 20);
+        REQUIRE(container->GetArraySize() == 1);
+        REQUIRE(container->GetMipLevels() == 6);
+
+        for(u32 mip = 0; mip < container->GetMipLevels(); ++mip)
+        {
+            REQUIRE(container->GetSubresourceData(mip, 0).size() ==
+                    TRAP::TextureContainer::CalculateSubresourceSize(format, std::max(37u >> mip, 1u), std::max(20u >> mip, 1u), 1));
+        }
+    }
+
+    //Base level is stored as-is
+    const auto rgba = TRAP::TextureContainer::CreateFromImage(*image, ImageFormat::R8G8B8A8_UNORM, TRAP::TextureContainer::MipFilter::Box);
+    REQUIRE(rgba);
+    const std::span<const u8> baseLevel = rgba->GetSubresourceData(0, 0);
+    for(usize i = 0; i < 37u * 20u; ++i)
+    {
+        REQUIRE(std::equal(pixels.begin() + static_cast<std::ptrdiff_t>(i * 3u), pixels.begin() + static_cast<std::ptrdiff_t>(i * 3u + 3u),
+                           baseLevel.begin() + static_cast<std::ptrdiff_t>(i * 4u)));
+        REQUIRE(baseLevel[i * 4u + 3u] == 255u);
+    }
+
+    //Unsupported formats and images
+    REQUIRE_FALSE(TRAP::TextureContainer::CreateFromImage(*image, ImageFormat::DXBC5_UNORM));
+    const auto hdrImage = TRAP::Image::LoadFromMemory(4, 4, TRAP::Image::ColorFormat::RGB, std::vector<f32>(4u * 4u * 3u, 1.0f));
+    REQUIRE_FALSE(TRAP::TextureContainer::CreateFromImage(*hdrImage, ImageFormat::DXBC1_RGB_UNORM));
+}
+
+TEST_CASE("TRAP::TextureContainer::LoadFromImageFileCached()", "[imageloader][texturecontainer]")
+{
+    const std::filesystem::path imagePath = "Testfiles/ImageLoader/Test24BPPBigInterlaced.png";
+    const std::filesystem::path cachePath = std::filesystem::temp_directory_path() / "TRAPUnitTestsTextureCache.dds";
+    std::filesystem::remove(cachePath);
+
+    const auto created = TRAP::TextureContainer::LoadFromImageFileCached(imagePath, cachePath, ImageFormat::DXBC1_RGB_SRGB);
+    REQUIRE(created);
+    REQUIRE(std::filesystem::exists(cachePath));
+    const auto cacheWriteTime = std::filesystem::last_write_time(cachePath);
+
+    //Second call uses the cache
+    const auto cached = TRAP::TextureContainer::LoadFromImageFileCached(imagePath, cachePath, ImageFormat::DXBC1_RGB_SRGB);
+    REQUIRE(cached);
+    REQUIRE(cached->GetFilePath() == cachePath);
+    REQUIRE(std::filesystem::last_write_time(cachePath) == cacheWriteTime);
+    REQUIRE(cached->GetMipLevels() == created->GetMipLevels());
+    for(u32 mip = 0; mip < cached->GetMipLevels(); ++mip)
+        REQUIRE(std::ranges::equal(cached->GetSubresourceData(mip, 0), created->GetSubresourceData(mip, 0)));
+
+    //A different format recreates the cache
+    const auto recreated = TRAP::TextureContainer::LoadFromImageFileCached(imagePath, cachePath, ImageFormat::DXBC7_SRGB);
+    REQUIRE(recreated);
+    REQUIRE(recreated->GetImageFormat() == ImageFormat::DXBC7_SRGB);
+    REQUIRE(recreated->GetFilePath().empty());
+
+    //A different mip filter recreates the cache
+    const auto boxFiltered = TRAP::TextureContainer::LoadFromImageFileCached(imagePath, cachePath, ImageFormat::DXBC7_SRGB,
+                                                                             TRAP::TextureContainer::MipFilter::Box);
+    REQUIRE(boxFiltered);
+    REQUIRE(boxFiltered->GetFilePath().empty());
+
+    const auto boxCached = TRAP::TextureContainer::LoadFromImageFileCached(imagePath, cachePath, ImageFormat::DXBC7_SRGB,
+                                                                           TRAP::TextureContainer::MipFilter::Box);
+    REQUIRE(boxCached);
+    REQUIRE(boxCached->GetFilePath() == cachePath);
+    for(u32 mip = 0; mip < boxCached->GetMipLevels(); ++mip)
+        REQUIRE(std::ranges::equal(boxCached->GetSubresourceData(mip, 0), boxFiltered->GetSubresourceData(mip, 0)));
+
+    std::filesystem::remove(cachePath);
+}
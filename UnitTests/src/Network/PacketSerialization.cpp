@@ -0,0 +1,401 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Network/Packet.h"
+#include "Network/PacketReader.h"
+#include "Network/PacketWriter.h"
+#include "Network/Sockets/DatagramBatch.h"
+#include "Network/Sockets/TCPSocket.h"
+#include "Network/Sockets/UDPSocket.h"
+#include "Network/TCPListener.h"
+#include "Utils/AllocationCounter.h"
+
+namespace
+{
+    using Status = TRAP::Network::Socket::Status;
+
+    enum class Faction : u8
+    {
+        Red,
+        Blue
+    };
+
+    struct Vec3
+    {
+        f32 X;
+        f32 Y;
+        f32 Z;
+    };
+
+    struct PlayerState
+    {
+        u32 ID;
+        std::string_view Name;
+        Faction Team;
+        bool Alive;
+        Vec3 Position;
+        std::array<i16, 3> Ammo;
+        f64 Time;
+        i64 Score;
+    };
+
+    static_assert(TRAP::Network::Serializable<Vec3>);
+    static_assert(TRAP::Network::Serializable<PlayerState>);
+    static_assert(!TRAP::Network::Serializable<std::string>);
+    static_assert(!TRAP::Network::Serializable<std::vector<u8>>);
+    static_assert(!TRAP::Network::Serializable<const char*>);
+    static_assert(TRAP::INTERNAL::Network::Serialization::HasFixedSize<Vec3>());
+    static_assert(TRAP::INTERNAL::Network::Serialization::GetMinimumSize<PlayerState>() ==
+                  sizeof(u32) + sizeof(u32) + sizeof(u8) + sizeof(u8) + 3 * sizeof(f32) + 3 * sizeof(i16) + sizeof(f64) + sizeof(i64));
+
+    [[nodiscard]] PlayerState MakePlayerState(const u32 id, const std::string_view name)
+    {
+        return PlayerState{id, name, Faction::Blue, true, {1.5f, -2.0f, 3.25f}, {-7, 0, 300}, 12.5, -1234567890123};
+    }
+
+    void RequireEqual(const PlayerState& left, const PlayerState& right)
+    {
+        REQUIRE(left.ID == right.ID);
+        REQUIRE(left.Name == right.Name);
+        REQUIRE(left.Team == right.Team);
+        REQUIRE(left.Alive == right.Alive);
+        REQUIRE(left.Position.X == right.Position.X);
+        REQUIRE(left.Position.Y == right.Position.Y);
+        REQUIRE(left.Position.Z == right.Position.Z);
+        REQUIRE(left.Ammo == right.Ammo);
+        REQUIRE(left.Time == right.Time);
+        REQUIRE(left.Score == right.Score);
+    }
+}
+
+TEST_CASE("TRAP::Network::PacketWriter and PacketReader", "[network][packetserialization]")
+{
+    std::array<u8, 256> buffer{};
+
+    SECTION("Round trip")
+    {
+        TRAP::Network::PacketWriter writer(buffer);
+        writer << MakePlayerState(1, "Player") << u16(42) << std::string_view("Done");
+        REQUIRE(writer);
+        REQUIRE(writer.GetCapacity() == buffer.size());
+        REQUIRE(writer.GetDataSize() == TRAP::INTERNAL::Network::Serialization::GetMinimumSize<PlayerState>() + 6 +
+                                        sizeof(u16) + sizeof(u32) + 4);
+
+        TRAP::Network::PacketReader reader(writer.GetData());
+        PlayerState state{};
+        u16 value = 0;
+        std::string_view text{};
+        reader >> state >> value >> text;
+        REQUIRE(reader);
+        REQUIRE(reader.EndOfPacket());
+        RequireEqual(state, MakePlayerState(1, "Player"));
+        REQUIRE(value == 42);
+        REQUIRE(text == "Done");
+
+        //Strings are views into the received data
+        REQUIRE(reinterpret_cast<const u8*>(state.Name.data()) > buffer.data());
+        REQUIRE(reinterpret_cast<const u8*>(state.Name.data()) < buffer.data() + writer.GetDataSize());
+
+        writer.Clear();
+        REQUIRE(writer.GetDataSize() == 0);
+    }
+
+    SECTION("Writer overflow")
+    {
+        TRAP::Network::PacketWriter writer(std::span<u8>(buffer).first(16));
+        writer << u64(1);
+        REQUIRE(writer);
+
+        //Doesn't fit, nothing is written
+        writer << Vec3{1.0f, 2.0f, 3.0f};
+        REQUIRE(!writer);
+        REQUIRE(writer.GetDataSize() == sizeof(u64));
+
+        //Stays invalid until cleared
+        writer << u8(1);
+        REQUIRE(!writer);
+        REQUIRE(writer.GetDataSize() == sizeof(u64));
+
+        writer.Clear();
+        writer << Vec3{1.0f, 2.0f, 3.0f};
+        REQUIRE(writer);
+    }
+
+    SECTION("Reader underflow")
+    {
+        TRAP::Network::PacketWriter writer(buffer);
+        writer << MakePlayerState(7, "Truncated");
+        REQUIRE(writer);
+
+        //Every truncation of the data has to be detected
+        for(usize size = 0; size < writer.GetDataSize(); ++size)
+        {
+            TRAP::Network::PacketReader reader(writer.GetData().first(size));
+            PlayerState state{};
+            reader >> state;
+            REQUIRE(!reader);
+            REQUIRE(reader.GetReadPosition() == 0);
+        }
+
+        //A string length that points past the end of the data
+        const std::array<u8, 6> corrupt{0x00, 0x00, 0x10, 0x00, 'a', 'b'};
+        TRAP::Network::PacketReader reader(corrupt);
+        std::string_view text{};
+        reader >> text;
+        REQUIRE(!reader);
+    }
+
+    SECTION("Compatible with Packet")
+    {
+        TRAP::Network::PacketWriter writer(buffer);
+        writer << u32(0xDEADBEEF) << i16(-2) << true << 0.5f << 2.25 << std::string_view("Writer");
+        REQUIRE(writer);
+
+        TRAP::Network::Packet packet{};
+        packet.Append(writer.GetData().data(), writer.GetDataSize());
+        u32 u = 0;
+        i16 i = 0;
+        bool b = false;
+        f32 f = 0.0f;
+        f64 d = 0.0;
+        std::string s{};
+        packet >> u >> i >> b >> f >> d >> s;
+        REQUIRE(packet);
+        REQUIRE(packet.EndOfPacket());
+        REQUIRE(u == 0xDEADBEEF);
+        REQUIRE(i == -2);
+        REQUIRE(b);
+        REQUIRE(f == 0.5f);
+        REQUIRE(d == 2.25);
+        REQUIRE(s == "Writer");
+
+        TRAP::Network::Packet sent{};
+        sent << u64(0x0102030405060708) << i8(-3) << std::string("Packet");
+        TRAP::Network::PacketReader reader(std::span(static_cast<const u8*>(sent.GetData()), sent.GetDataSize()));
+        u64 l = 0;
+        i8 c = 0;
+        std::string_view view{};
+        reader >> l >> c >> view;
+        REQUIRE(reader);
+        REQUIRE(reader.EndOfPacket());
+        REQUIRE(l == 0x0102030405060708);
+        REQUIRE(c == -3);
+        REQUIRE(view == "Packet");
+    }
+
+    SECTION("Compile-time serialization")
+    {
+        static constexpr auto Serialized = []()
+        {
+            std::array<u8, 16> data{};
+            TRAP::Network::PacketWriter writer(data);
+            writer << Vec3{1.0f, 2.0f, 3.0f} << u16(0x0102);
+            return data;
+        }();
+        static_assert(Serialized[12] == 0x01 && Serialized[13] == 0x02);
+
+        static constexpr Vec3 Deserialized = []()
+        {
+            TRAP::Network::PacketReader reader(Serialized);
+            Vec3 vec{};
+            reader >> vec;
+            return vec;
+        }();
+        static_assert(Deserialized.X == 1.0f && Deserialized.Y == 2.0f && Deserialized.Z == 3.0f);
+    }
+}
+
+TEST_CASE("TRAP::Network::PacketReader UDP allocations", "[network][packetserialization]")
+{
+    if constexpr (!UnitTests::AllocationCountingEnabled)
+        SKIP("Allocations can't be counted while the engine replaces operator new");
+
+    static constexpr usize DatagramCount = 32;
+    static constexpr usize Iterations = 16;
+
+    TRAP::Network::UDPSocket receiver{};
+    TRAP::Network::UDPSocket sender{};
+    REQUIRE(receiver.Bind(TRAP::Network::Socket::AnyPort, TRAP::Network::IPv4Address::LocalHost) == Status::Done);
+    REQUIRE(sender.Bind(TRAP::Network::Socket::AnyPort, TRAP::Network::IPv4Address::LocalHost) == Status::Done);
+
+    std::vector<std::array<u8, 128>> payloads(DatagramCount);
+    std::vector<TRAP::Network::Datagram> datagrams{};
+    for(u32 i = 0; i < DatagramCount; ++i)
+    {
+        TRAP::Network::PacketWriter writer(payloads[i]);
+        writer << MakePlayerState(i, "Player");
+        REQUIRE(writer);
+        datagrams.push_back({writer.GetData(), TRAP::Network::IPv4Address::LocalHost, receiver.GetLocalPort()});
+    }
+
+    TRAP::Network::DatagramBatch batch(DatagramCount, 128);
+
+    //Warm up, the first receive may allocate inside the system
+    usize sent = 0;
+    REQUIRE(sender.Send(datagrams, sent) == Status::Done);
+    while(!batch.IsFull())
+    {
+        usize received = 0;
+        REQUIRE(receiver.Receive(batch, received) == Status::Done);
+    }
+    batch.Clear();
+
+    usize validMessages = 0;
+    u64 idSum = 0;
+    const u64 allocationsBefore = UnitTests::AllocationCount.load();
+    for(usize iteration = 0; iteration < Iterations; ++iteration)
+    {
+        if(sender.Send(datagrams, sent) != Status::Done)
+            break;
+
+        while(!batch.IsFull())
+        {
+            usize received = 0;
+            if(receiver.Receive(batch, received) != Status::Done)
+                break;
+        }
+
+        while(!batch.IsEmpty())
+        {
+            TRAP::Network::PacketReader reader(batch.Front().Data);
+            PlayerState state{};
+            reader >> state;
+            if(reader && reader.EndOfPacket() && state.Name == "Player")
+            {
+                ++validMessages;
+                idSum += state.ID;
+            }
+            batch.Pop();
+        }
+    }
+    const u64 allocations = UnitTests::AllocationCount.load() - allocationsBefore;
+
+    REQUIRE(validMessages == Iterations * DatagramCount);
+    REQUIRE(idSum == Iterations * (DatagramCount * (DatagramCount - 1) / 2));
+    REQUIRE(allocations == 0);
+}
+
+TEST_CASE("TRAP::Network::PacketReader TCP allocations", "[network][packetserialization]")
+{
+    if constexpr (!UnitTests::AllocationCountingEnabled)
+        SKIP("Allocations can't be counted while the engine replaces operator new");
+
+    static constexpr u32 MessageCount = 256;
+
+    TRAP::Network::TCPListener listener{};
+    TRAP::Network::TCPSocket client{};
+    TRAP::Network::TCPSocket server{};
+    REQUIRE(listener.Listen(TRAP::Network::Socket::AnyPort, TRAP::Network::IPv4Address::LocalHost) == Status::Done);
+    REQUIRE(client.Connect(TRAP::Network::IPv4Address::LocalHost, listener.GetLocalPort()) == Status::Done);
+    REQUIRE(listener.Accept(server) == Status::Done);
+
+    std::vector<TRAP::Network::Packet> packets(MessageCount);
+    for(u32 i = 0; i < MessageCount; ++i)
+    {
+        std::array<u8, 128> data{};
+        TRAP::Network::PacketWriter writer(data);
+        writer << MakePlayerState(i, "Player");
+        REQUIRE(writer);
+        packets[i].Append(writer.GetData().data(), writer.GetDataSize());
+    }
+
+    //Small enough to fit into the socket buffers, so sending doesn't block
+    usize sentPackets = 0;
+    REQUIRE(client.Send(packets, sentPackets) == Status::Done);
+
+    std::array<u8, 128> buffer{};
+    u32 validMessages = 0;
+    const u64 allocationsBefore = UnitTests::AllocationCount.load();
+    for(u32 i = 0; i < MessageCount; ++i)
+    {
+        std::span<const u8> packetData{};
+        if(server.Receive(buffer, packetData) != Status::Done)
+            break;
+
+        TRAP::Network::PacketReader reader(packetData);
+        PlayerState state{};
+        reader >> state;
+        if(reader && reader.EndOfPacket() && state.ID == i && state.Name == "Player")
+            ++validMessages;
+    }
+    const u64 allocations = UnitTests::AllocationCount.load() - allocationsBefore;
+
+    REQUIRE(validMessages == MessageCount);
+    REQUIRE(allocations == 0);
+
+    //Packets that don't fit are rejected
+    REQUIRE(client.Send(packets.front()) == Status::Done);
+    std::span<const u8> packetData{};
+    REQUIRE(server.Receive(std::span(buffer).first(16), packetData) == Status::Error);
+    REQUIRE(packetData.empty());
+}
+
+TEST_CASE("TRAP::Network::PacketWriter and PacketReader Benchmark", "[.][benchmark][network][packetserialization]")
+{
+    static constexpr usize MessageCount = 1000;
+
+    u64 packetAllocations = 0;
+    BENCHMARK("Packet write + read 1000 messages")
+    {
+        const u64 allocationsBefore = UnitTests::AllocationCount.load();
+
+        u64 sum = 0;
+        for(u32 i = 0; i < MessageCount; ++i)
+        {
+            const PlayerState state = MakePlayerState(i, "Player");
+
+            TRAP::Network::Packet packet{};
+            packet << state.ID << std::string(state.Name) << static_cast<u8>(state.Team) << state.Alive
+                   << state.Position.X << state.Position.Y << state.Position.Z
+                   << state.Ammo[0] << state.Ammo[1] << state.Ammo[2] << state.Time << state.Score;
+
+            u32 id = 0;
+            std::string name{};
+            u8 team = 0;
+            bool alive = false;
+            Vec3 position{};
+            std::array<i16, 3> ammo{};
+            f64 time = 0.0;
+            i64 score = 0;
+            packet >> id >> name >> team >> alive >> position.X >> position.Y >> position.Z
+                   >> ammo[0] >> ammo[1] >> ammo[2] >> time >> score;
+            sum += id + name.size();
+        }
+
+        packetAllocations += UnitTests::AllocationCount.load() - allocationsBefore;
+        return sum;
+    };
+
+    std::array<u8, 128> buffer{};
+    u64 readerAllocations = 0;
+    BENCHMARK("PacketWriter + PacketReader 1000 messages")
+    {
+        const u64 allocationsBefore = UnitTests::AllocationCount.load();
+
+        u64 sum = 0;
+        for(u32 i = 0; i < MessageCount; ++i)
+        {
+            TRAP::Network::PacketWriter writer(buffer);
+            writer << MakePlayerState(i, "Player");
+
+            TRAP::Network::PacketReader reader(writer.GetData());
+            PlayerState state{};
+            reader >> state;
+            sum += state.ID + state.Name.size();
+        }
+
+        readerAllocations += UnitTests::AllocationCount.load() - allocationsBefore;
+        return sum;
+    };
+
+    if constexpr (UnitTests::AllocationCountingEnabled)
+    {
+        REQUIRE(packetAllocations > 0);
+        REQUIRE(readerAllocations == 0);
+    }
+}
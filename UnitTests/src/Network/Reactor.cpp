@@ -0,0 +1,368 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Network/Packet.h"
+#include "Network/Reactor.h"
+#include "Network/TCPListener.h"
+#include "Network/Sockets/TCPSocket.h"
+#include "Network/Sockets/UDPSocket.h"
+#include "Utils/Time/TimeStep.h"
+
+namespace
+{
+    using Status = TRAP::Network::Socket::Status;
+
+    //Fails the test instead of hanging it when an expected event never arrives
+    constexpr TRAP::Utils::TimeStep TestTimeout(10.0f);
+
+    /// @brief Echo server that sends every received packet back to its sender.
+    struct EchoServer
+    {
+        explicit EchoServer(TRAP::Network::Reactor& reactor)
+            : Reactor(reactor)
+        {
+            REQUIRE(Listener.Listen(TRAP::Network::Socket::AnyPort, TRAP::Network::IPv4Address::LocalHost) == Status::Done);
+
+            Reactor.Accept(Listener, [this](const Status status, TRAP::Scope<TRAP::Network::TCPSocket> socket)
+            {
+                REQUIRE(status == Status::Done);
+
+                TRAP::Network::TCPSocket& client = *Clients.emplace_back(std::move(socket));
+                Reactor.Receive(client, [this, &client](const Status receiveStatus, TRAP::Network::Packet& packet)
+                {
+                    if(receiveStatus == Status::Done)
+                        Reactor.Send(client, packet);
+                    else
+                        ++Disconnects;
+                });
+            });
+        }
+
+        ~EchoServer()
+        {
+            for(const auto& client : Clients)
+                Reactor.Remove(*client);
+            Reactor.Remove(Listener);
+        }
+
+        EchoServer(const EchoServer&) = delete;
+        EchoServer& operator=(const EchoServer&) = delete;
+        EchoServer(EchoServer&&) = delete;
+        EchoServer& operator=(EchoServer&&) = delete;
+
+        TRAP::Network::Reactor& Reactor;
+        TRAP::Network::TCPListener Listener{};
+        std::vector<TRAP::Scope<TRAP::Network::TCPSocket>> Clients{};
+        u32 Disconnects = 0;
+    };
+
+    /// @brief Run the reactor until Stop() gets called or the test timeout is reached.
+    /// @return True if the reactor got stopped before the timeout.
+    [[nodiscard]] bool RunWithTimeout(TRAP::Network::Reactor& reactor)
+    {
+        bool timedOut = false;
+        const TRAP::Network::Reactor::TimerID timer = reactor.AddTimer(TestTimeout, [&reactor, &timedOut]()
+        {
+            timedOut = true;
+            reactor.Stop();
+        });
+
+        reactor.Run();
+        reactor.CancelTimer(timer);
+
+        return !timedOut;
+    }
+
+    /// @brief Connect clients to an echo server, every client sends packets one after another
+    ///        and waits for each echo before sending the next one.
+    /// @return True if all echos arrived in order.
+    [[nodiscard]] bool RunEcho(TRAP::Network::Reactor& reactor, const u16 port, const u32 clientCount,
+                               const u32 packetsPerClient)
+    {
+        std::vector<std::unique_ptr<TRAP::Network::TCPSocket>> clients{};
+        std::vector<u32> received(clientCount, 0);
+        u32 finishedClients = 0;
+        bool inOrder = true;
+
+        const auto sendPacket = [&reactor](TRAP::Network::TCPSocket& socket, const u32 client, const u32 index)
+        {
+            TRAP::Network::Packet packet{};
+            packet << client << index << std::string("Echo");
+            reactor.Send(socket, std::move(packet));
+        };
+
+        for(u32 c = 0; c < clientCount; ++c)
+        {
+            TRAP::Network::TCPSocket& socket = *clients.emplace_back(std::make_unique<TRAP::Network::TCPSocket>());
+            reactor.Connect(socket, TRAP::Network::IPv4Address::LocalHost, port, [&, c](const Status status)
+            {
+                REQUIRE(status == Status::Done);
+
+                reactor.Receive(socket, [&, c](const Status receiveStatus, TRAP::Network::Packet& packet)
+                {
+                    REQUIRE(receiveStatus == Status::Done);
+
+                    u32 client = 0;
+                    u32 index = 0;
+                    std::string text{};
+                    packet >> client >> index >> text;
+                    inOrder = inOrder && client == c && index == received[c] && text == "Echo";
+
+                    if(++received[c] < packetsPerClient)
+                        sendPacket(socket, c, received[c]);
+                    else if(++finishedClients == clientCount)
+                        reactor.Stop();
+                });
+
+                sendPacket(socket, c, 0);
+            });
+        }
+
+        const bool finished = RunWithTimeout(reactor);
+
+        for(const auto& client : clients)
+            reactor.Remove(*client);
+
+        return finished && inOrder;
+    }
+}
+
+TEST_CASE("TRAP::Network::Reactor", "[network][reactor]")
+{
+    TRAP::Network::Reactor reactor{};
+
+    SECTION("Echo")
+    {
+        EchoServer server(reactor);
+        REQUIRE(RunEcho(reactor, server.Listener.GetLocalPort(), 16, 50));
+        REQUIRE(server.Clients.size() == 16);
+    }
+
+    SECTION("Re-arming from inside a callback")
+    {
+        TRAP::Network::TCPListener listener{};
+        REQUIRE(listener.Listen(TRAP::Network::Socket::AnyPort, TRAP::Network::IPv4Address::LocalHost) == Status::Done);
+
+        std::vector<TRAP::Scope<TRAP::Network::TCPSocket>> accepted{};
+        u32 received = 0;
+
+        //Replacing a callback while it runs must not destroy its captures
+        std::function<void(Status, TRAP::Network::Packet&)> onPacket;
+        onPacket = [&, tag = std::string(64, 'P')](const Status status, TRAP::Network::Packet&)
+        {
+            REQUIRE(status == Status::Done);
+            reactor.Receive(*accepted.back(), onPacket);
+            REQUIRE(tag == std::string(64, 'P'));
+
+            if(++received == 3)
+                reactor.Stop();
+        };
+
+        std::function<void(Status, TRAP::Scope<TRAP::Network::TCPSocket>)> onAccept;
+        onAccept = [&, tag = std::string(64, 'A')](const Status status, TRAP::Scope<TRAP::Network::TCPSocket> socket)
+        {
+            REQUIRE(status == Status::Done);
+            reactor.Accept(listener, onAccept);
+            REQUIRE(tag == std::string(64, 'A'));
+
+            reactor.Receive(*accepted.emplace_back(std::move(socket)), onPacket);
+        };
+        reactor.Accept(listener, onAccept);
+
+        TRAP::Network::TCPSocket client{};
+        reactor.Connect(client, TRAP::Network::IPv4Address::LocalHost, listener.GetLocalPort(), [&](const Status status)
+        {
+            REQUIRE(status == Status::Done);
+
+            for(u32 i = 0; i < 3; ++i)
+            {
+                TRAP::Network::Packet packet{};
+                packet << i;
+                reactor.Send(client, std::move(packet));
+            }
+        });
+
+        REQUIRE(RunWithTimeout(reactor));
+        REQUIRE(received == 3);
+
+        reactor.Remove(client);
+        for(const auto& socket : accepted)
+            reactor.Remove(*socket);
+        reactor.Remove(listener);
+    }
+
+    SECTION("Disconnect")
+    {
+        EchoServer server(reactor);
+
+        TRAP::Network::TCPSocket client{};
+        reactor.Connect(client, TRAP::Network::IPv4Address::LocalHost, server.Listener.GetLocalPort(), [&](const Status status)
+        {
+            REQUIRE(status == Status::Done);
+
+            //Give the server a moment to accept, then hang up
+            reactor.AddTimer(TRAP::Utils::TimeStep(0.05f), [&]()
+            {
+                reactor.Remove(client);
+                client.Disconnect();
+            });
+        });
+
+        const TRAP::Network::Reactor::TimerID check = reactor.AddTimer(TRAP::Utils::TimeStep(0.01f), [&]()
+        {
+            if(server.Disconnects == 1)
+                reactor.Stop();
+        }, TRAP::Utils::TimeStep(0.01f));
+
+        REQUIRE(RunWithTimeout(reactor));
+        reactor.CancelTimer(check);
+        REQUIRE(server.Clients.size() == 1);
+    }
+
+    SECTION("Connect failure")
+    {
+        //A port that was just free is very likely to refuse the connection
+        u16 port = 0;
+        {
+            TRAP::Network::TCPListener listener{};
+            REQUIRE(listener.Listen(TRAP::Network::Socket::AnyPort, TRAP::Network::IPv4Address::LocalHost) == Status::Done);
+            port = listener.GetLocalPort();
+        }
+
+        TRAP::Network::TCPSocket client{};
+        Status result = Status::Done;
+        reactor.Connect(client, TRAP::Network::IPv4Address::LocalHost, port, [&](const Status status)
+        {
+            result = status;
+            reactor.Stop();
+        });
+
+        REQUIRE(RunWithTimeout(reactor));
+        REQUIRE(result != Status::Done);
+        reactor.Remove(client);
+    }
+
+    SECTION("UDP")
+    {
+        TRAP::Network::UDPSocket receiver{};
+        REQUIRE(receiver.Bind(TRAP::Network::Socket::AnyPort, TRAP::Network::IPv4Address::LocalHost) == Status::Done);
+
+        u32 value = 0;
+        reactor.Receive(receiver, [&](TRAP::Network::Packet& packet, const TRAP::Network::IPv4Address& address, u16)
+        {
+            REQUIRE(address == TRAP::Network::IPv4Address::LocalHost);
+            packet >> value;
+            reactor.Stop();
+        });
+
+        TRAP::Network::UDPSocket sender{};
+        TRAP::Network::Packet packet{};
+        packet << 1337u;
+        REQUIRE(sender.Send(packet, TRAP::Network::IPv4Address::LocalHost, receiver.GetLocalPort()) == Status::Done);
+
+        REQUIRE(RunWithTimeout(reactor));
+        REQUIRE(value == 1337u);
+        reactor.Remove(receiver);
+    }
+
+    SECTION("Timers")
+    {
+        u32 oneShot = 0;
+        u32 repeating = 0;
+        u32 cancelled = 0;
+
+        reactor.AddTimer(TRAP::Utils::TimeStep(0.01f), [&](){ ++oneShot; });
+        const TRAP::Network::Reactor::TimerID cancelledTimer = reactor.AddTimer(TRAP::Utils::TimeStep(0.02f), [&](){ ++cancelled; });
+        reactor.CancelTimer(cancelledTimer);
+
+        TRAP::Network::Reactor::TimerID repeatingTimer = 0;
+        repeatingTimer = reactor.AddTimer(TRAP::Utils::TimeStep(0.01f), [&]()
+        {
+            if(++repeating == 3)
+            {
+                reactor.CancelTimer(repeatingTimer);
+                reactor.AddTimer(TRAP::Utils::TimeStep(0.05f), [&](){ reactor.Stop(); });
+            }
+        }, TRAP::Utils::TimeStep(0.01f));
+
+        REQUIRE(RunWithTimeout(reactor));
+        REQUIRE(oneShot == 1);
+        REQUIRE(repeating == 3);
+        REQUIRE(cancelled == 0);
+    }
+
+    SECTION("Post() and Stop() from another thread")
+    {
+        std::thread::id taskThread{};
+
+        std::jthread thread([&reactor, &taskThread]()
+        {
+            reactor.Post([&taskThread]()
+            {
+                taskThread = std::this_thread::get_id();
+            });
+            reactor.Stop();
+        });
+
+        reactor.Run();
+        thread.join();
+
+        //Stop() may wake the loop before the posted task ran
+        reactor.RunOnce(TRAP::Utils::TimeStep(0.01f));
+        REQUIRE(taskThread == std::this_thread::get_id());
+    }
+}
+
+TEST_CASE("TRAP::Network::Reactor Benchmark", "[.][benchmark][network][reactor]")
+{
+    //Client and server share one reactor, so the results show the work per connection and message of a single thread
+    TRAP::Network::Reactor reactor{};
+
+    BENCHMARK_ADVANCED("Connect + accept 100 connections")(Catch::Benchmark::Chronometer meter)
+    {
+        EchoServer server(reactor);
+        std::vector<std::unique_ptr<TRAP::Network::TCPSocket>> clients(100);
+        for(auto& client : clients)
+            client = std::make_unique<TRAP::Network::TCPSocket>();
+
+        meter.measure([&]()
+        {
+            u32 connected = 0;
+            for(const auto& client : clients)
+            {
+                reactor.Connect(*client, TRAP::Network::IPv4Address::LocalHost, server.Listener.GetLocalPort(), [&](const Status)
+                {
+                    ++connected;
+                });
+            }
+
+            while(connected < clients.size() || server.Clients.size() < clients.size())
+                reactor.RunOnce(TestTimeout);
+
+            //Close the server side first, so the client ports don't pile up in TIME_WAIT
+            for(const auto& client : server.Clients)
+                reactor.Remove(*client);
+            server.Clients.clear();
+            for(const auto& client : clients)
+                reactor.Remove(*client);
+
+            return connected;
+        });
+    };
+
+    BENCHMARK_ADVANCED("Echo 10000 messages over 16 connections")(Catch::Benchmark::Chronometer meter)
+    {
+        EchoServer server(reactor);
+
+        meter.measure([&]()
+        {
+            return RunEcho(reactor, server.Listener.GetLocalPort(), 16, 625);
+        });
+    };
+}
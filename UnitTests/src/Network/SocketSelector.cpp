@@ -0,0 +1,259 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "Core/PlatformDetection.h"
+#include "Network/TCPListener.h"
+#include "Network/Sockets/SocketSelector.h"
+#include "Network/Sockets/TCPSocket.h"
+#include "Utils/Time/TimeStep.h"
+
+#ifdef TRAP_PLATFORM_LINUX
+#include <sys/resource.h>
+#endif /*TRAP_PLATFORM_LINUX*/
+
+namespace
+{
+    //Short timeout for waits that are expected to report nothing
+    constexpr TRAP::Utils::TimeStep ShortTimeout(0.05f);
+    constexpr TRAP::Utils::TimeStep LongTimeout(5.0f);
+
+    struct Connections
+    {
+        TRAP::Network::TCPListener Listener{};
+        std::vector<std::unique_ptr<TRAP::Network::TCPSocket>> Clients{};
+        std::vector<std::unique_ptr<TRAP::Network::TCPSocket>> Servers{};
+    };
+
+#ifdef TRAP_PLATFORM_LINUX
+    /// @brief Raises the soft file descriptor limit to the hard limit and restores it on destruction.
+    class FileDescriptorLimitGuard
+    {
+    public:
+        FileDescriptorLimitGuard()
+            : m_valid(getrlimit(RLIMIT_NOFILE, &m_original) == 0)
+        {
+            if(!m_valid || m_original.rlim_cur >= m_original.rlim_max)
+                return;
+
+            rlimit raised = m_original;
+            raised.rlim_cur = raised.rlim_max;
+            setrlimit(RLIMIT_NOFILE, &raised);
+        }
+
+        ~FileDescriptorLimitGuard()
+        {
+            if(m_valid)
+                setrlimit(RLIMIT_NOFILE, &m_original);
+        }
+
+        FileDescriptorLimitGuard(const FileDescriptorLimitGuard&) = delete;
+        FileDescriptorLimitGuard& operator=(const FileDescriptorLimitGuard&) = delete;
+        FileDescriptorLimitGuard(FileDescriptorLimitGuard&&) = delete;
+        FileDescriptorLimitGuard& operator=(FileDescriptorLimitGuard&&) = delete;
+
+    private:
+        rlimit m_original{};
+        bool m_valid;
+    };
+#else
+    /// @brief No file descriptor limit to raise on this platform.
+    struct FileDescriptorLimitGuard
+    {
+    };
+#endif /*TRAP_PLATFORM_LINUX*/
+
+    /// @brief Retrieve the amount of loopback connections to test with.
+    ///        More connections than FD_SETSIZE are used where the file descriptor limit allows it.
+    [[nodiscard]] u32 GetConnectionCount()
+    {
+#ifdef TRAP_PLATFORM_LINUX
+        static constexpr u32 WantedConnections = 2048;
+
+        rlimit limit{};
+        if(getrlimit(RLIMIT_NOFILE, &limit) != 0)
+            return 256;
+
+        //Every connection uses 2 file descriptors, keep some for the rest of the process
+        return static_cast<u32>(std::min<rlim_t>(WantedConnections, (limit.rlim_cur - 64u) / 2u));
+#else
+        //select() based selectors are limited to FD_SETSIZE sockets
+        return 32;
+#endif /*TRAP_PLATFORM_LINUX*/
+    }
+
+    void Connect(Connections& connections, const u32 count)
+    {
+        REQUIRE(connections.Listener.Listen(TRAP::Network::Socket::AnyPort, TRAP::Network::IPv4Address::LocalHost) == TRAP::Network::Socket::Status::Done);
+        const u16 port = connections.Listener.GetLocalPort();
+
+        for(u32 i = 0; i < count; ++i)
+        {
+            auto client = std::make_unique<TRAP::Network::TCPSocket>();
+            auto server = std::make_unique<TRAP::Network::TCPSocket>();
+            REQUIRE(client->Connect(TRAP::Network::IPv4Address::LocalHost, port) == TRAP::Network::Socket::Status::Done);
+            REQUIRE(connections.Listener.Accept(*server) == TRAP::Network::Socket::Status::Done);
+
+            connections.Clients.push_back(std::move(client));
+            connections.Servers.push_back(std::move(server));
+        }
+    }
+
+    [[nodiscard]] bool ShouldSend(const usize index)
+    {
+        return index % 7 == 0;
+    }
+
+    void SendToSome(const Connections& connections)
+    {
+        for(usize i = 0; i < connections.Clients.size(); ++i)
+        {
+            if(ShouldSend(i))
+            {
+                const u8 data = 42;
+                REQUIRE(connections.Clients[i]->Send(&data, sizeof(data)) == TRAP::Network::Socket::Status::Done);
+            }
+        }
+    }
+
+    void RequireReadySockets(const TRAP::Network::SocketSelector& selector, const Connections& connections)
+    {
+        const std::span<TRAP::Network::Socket* const> readySockets = selector.GetReadySockets();
+
+        usize expectedCount = 0;
+        for(usize i = 0; i < connections.Servers.size(); ++i)
+        {
+            TRAP::Network::Socket* const server = connections.Servers[i].get();
+            REQUIRE(selector.IsReady(*server) == ShouldSend(i));
+            REQUIRE((std::ranges::find(readySockets, server) != readySockets.end()) == ShouldSend(i));
+
+            if(ShouldSend(i))
+                ++expectedCount;
+        }
+
+        REQUIRE(readySockets.size() == expectedCount);
+    }
+
+    void ReceiveAll(const std::span<TRAP::Network::Socket* const> readySockets)
+    {
+        for(TRAP::Network::Socket* const socket : readySockets)
+        {
+            u8 data = 0;
+            usize received = 0;
+            REQUIRE(static_cast<TRAP::Network::TCPSocket*>(socket)->Receive(&data, sizeof(data), received) == TRAP::Network::Socket::Status::Done);
+            REQUIRE(received == sizeof(data));
+        }
+    }
+}
+
+TEST_CASE("TRAP::Network::SocketSelector", "[network][socketselector]")
+{
+    //Connecting thousands of sockets is slow, so all checks share one set of connections
+    //instead of using SECTIONs which would reconnect for every section.
+    //The guard is declared first so the limit is restored after the connections are closed.
+    const FileDescriptorLimitGuard limitGuard{};
+    Connections connections{};
+    Connect(connections, GetConnectionCount());
+
+    //Level triggered
+    {
+        TRAP::Network::SocketSelector selector{};
+        REQUIRE(selector.GetTriggerMode() == TRAP::Network::SocketSelector::TriggerMode::Level);
+
+        for(const auto& server : connections.Servers)
+            selector.Add(*server);
+
+        REQUIRE_FALSE(selector.Wait(ShortTimeout));
+        REQUIRE(selector.GetReadySockets().empty());
+
+        SendToSome(connections);
+
+        REQUIRE(selector.Wait(LongTimeout));
+        RequireReadySockets(selector, connections);
+
+        //Data that was not received is reported again
+        REQUIRE(selector.Wait(LongTimeout));
+        RequireReadySockets(selector, connections);
+
+        ReceiveAll(selector.GetReadySockets());
+        REQUIRE_FALSE(selector.Wait(ShortTimeout));
+    }
+
+    //Edge triggered
+    {
+        TRAP::Network::SocketSelector selector(TRAP::Network::SocketSelector::TriggerMode::Edge);
+
+        for(const auto& server : connections.Servers)
+        {
+            server->SetBlocking(false);
+            selector.Add(*server);
+        }
+
+        SendToSome(connections);
+
+        REQUIRE(selector.Wait(LongTimeout));
+        RequireReadySockets(selector, connections);
+
+#ifdef TRAP_PLATFORM_LINUX
+        //Data that was already reported is not reported again
+        REQUIRE_FALSE(selector.Wait(ShortTimeout));
+#endif /*TRAP_PLATFORM_LINUX*/
+
+        //New data is reported again
+        SendToSome(connections);
+        REQUIRE(selector.Wait(LongTimeout));
+        RequireReadySockets(selector, connections);
+
+        //Both sends are still pending, leave the connections as they were for the next checks
+        ReceiveAll(selector.GetReadySockets());
+        ReceiveAll(selector.GetReadySockets());
+        for(const auto& server : connections.Servers)
+            server->SetBlocking(true);
+    }
+
+    //Remove() and Clear()
+    {
+        TRAP::Network::SocketSelector selector{};
+
+        for(const auto& server : connections.Servers)
+            selector.Add(*server);
+
+        REQUIRE_FALSE(selector.Wait(ShortTimeout));
+
+        SendToSome(connections);
+        REQUIRE(selector.Wait(LongTimeout));
+
+        TRAP::Network::Socket& removed = *connections.Servers[0];
+        const usize readyCount = selector.GetReadySockets().size();
+        selector.Remove(removed);
+        REQUIRE_FALSE(selector.IsReady(removed));
+        REQUIRE(selector.GetReadySockets().size() == readyCount - 1);
+        REQUIRE(std::ranges::find(selector.GetReadySockets(), &removed) == selector.GetReadySockets().end());
+
+        //Copies wait on their own
+        const TRAP::Network::SocketSelector copy(selector);
+        REQUIRE(copy.Wait(LongTimeout));
+        REQUIRE(copy.GetReadySockets().size() == readyCount - 1);
+
+        selector.Clear();
+        REQUIRE(selector.GetReadySockets().empty());
+        REQUIRE_FALSE(selector.Wait(ShortTimeout));
+        REQUIRE(copy.Wait(LongTimeout));
+    }
+}
+
+#ifdef TRAP_PLATFORM_LINUX
+TEST_CASE("TRAP::Network::SocketSelector empty", "[network][socketselector]")
+{
+    const TRAP::Network::SocketSelector selector{};
+
+    //Waits for the timeout instead of returning immediately, so polling loops don't spin
+    const auto start = std::chrono::steady_clock::now();
+    REQUIRE_FALSE(selector.Wait(ShortTimeout));
+    REQUIRE(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(40));
+    REQUIRE(selector.GetReadySockets().empty());
+}
+#endif /*TRAP_PLATFORM_LINUX*/
@@ -0,0 +1,190 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <array>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "Network/Packet.h"
+#include "Network/TCPListener.h"
+#include "Network/Sockets/TCPSocket.h"
+
+namespace
+{
+    using Status = TRAP::Network::Socket::Status;
+
+    struct Connection
+    {
+        Connection()
+        {
+            REQUIRE(Listener.Listen(TRAP::Network::Socket::AnyPort, TRAP::Network::IPv4Address::LocalHost) == Status::Done);
+            REQUIRE(Client.Connect(TRAP::Network::IPv4Address::LocalHost, Listener.GetLocalPort()) == Status::Done);
+            REQUIRE(Listener.Accept(Server) == Status::Done);
+        }
+
+        TRAP::Network::TCPListener Listener{};
+        TRAP::Network::TCPSocket Client{};
+        TRAP::Network::TCPSocket Server{};
+    };
+
+    /// @brief Create a packet whose content depends on the index, so reordering or corruption can be detected.
+    [[nodiscard]] TRAP::Network::Packet MakePacket(const u32 index, const usize payloadSize)
+    {
+        TRAP::Network::Packet packet{};
+        packet << index;
+        for(usize i = 0; i < payloadSize; ++i)
+            packet << static_cast<u8>(index + i);
+
+        return packet;
+    }
+
+    [[nodiscard]] bool IsSamePacket(const TRAP::Network::Packet& left, const TRAP::Network::Packet& right)
+    {
+        return left.GetDataSize() == right.GetDataSize() &&
+               (left.GetDataSize() == 0 || std::memcmp(left.GetData(), right.GetData(), left.GetDataSize()) == 0);
+    }
+
+    /// @brief Receive packets on a separate thread and compare them against the expected ones.
+    ///        matching counts the packets that arrived intact and in order.
+    /// @return Receiving thread.
+    [[nodiscard]] std::jthread ReceiveAll(TRAP::Network::TCPSocket& socket, const std::vector<TRAP::Network::Packet>& expected,
+                                          usize& matching)
+    {
+        return std::jthread([&socket, &expected, &matching]()
+        {
+            for(const TRAP::Network::Packet& expectedPacket : expected)
+            {
+                TRAP::Network::Packet packet{};
+                if(socket.Receive(packet) != Status::Done || !IsSamePacket(packet, expectedPacket))
+                    return;
+
+                ++matching;
+            }
+        });
+    }
+}
+
+TEST_CASE("TRAP::Network::TCPSocket", "[network][tcpsocket]")
+{
+    Connection connection{};
+
+    SECTION("Send(Packet&)")
+    {
+        std::vector<TRAP::Network::Packet> packets{};
+        packets.emplace_back();
+        for(u32 i = 1; i < 64; ++i)
+            packets.push_back(MakePacket(i, i * 37u));
+
+        usize matching = 0;
+        {
+            std::jthread receiver = ReceiveAll(connection.Server, packets, matching);
+
+            for(TRAP::Network::Packet& packet : packets)
+                REQUIRE(connection.Client.Send(packet) == Status::Done);
+        }
+        REQUIRE(matching == packets.size());
+    }
+
+    SECTION("Send(std::span<Packet>)")
+    {
+        std::vector<TRAP::Network::Packet> packets{};
+        for(u32 i = 0; i < 1000; ++i)
+            packets.push_back(MakePacket(i, i % 300u));
+
+        usize matching = 0;
+        {
+            std::jthread receiver = ReceiveAll(connection.Server, packets, matching);
+
+            usize sentPackets = 0;
+            REQUIRE(connection.Client.Send(packets, sentPackets) == Status::Done);
+            REQUIRE(sentPackets == packets.size());
+        }
+        REQUIRE(matching == packets.size());
+    }
+
+    SECTION("Partial sends")
+    {
+        //Packets bigger than the socket buffers, so non-blocking sends have to be resumed
+        std::vector<TRAP::Network::Packet> packets{};
+        for(u32 i = 0; i < 8; ++i)
+            packets.push_back(MakePacket(i, 1024u * 1024u));
+        for(u32 i = 8; i < 200; ++i)
+            packets.push_back(MakePacket(i, 1000u));
+
+        usize matching = 0;
+        {
+            std::jthread receiver = ReceiveAll(connection.Server, packets, matching);
+            connection.Client.SetBlocking(false);
+
+            bool sawPartial = false;
+
+            //Single packets
+            const std::span<TRAP::Network::Packet> singles = std::span(packets).first(4);
+            for(TRAP::Network::Packet& packet : singles)
+            {
+                Status status = Status::NotReady;
+                while((status = connection.Client.Send(packet)) != Status::Done)
+                {
+                    REQUIRE((status == Status::Partial || status == Status::NotReady));
+                    sawPartial = sawPartial || status == Status::Partial;
+                    std::this_thread::yield();
+                }
+            }
+
+            //Batches, resumed with the packets that weren't sent completely
+            std::span<TRAP::Network::Packet> remaining = std::span(packets).subspan(4);
+            while(!remaining.empty())
+            {
+                usize sentPackets = 0;
+                const Status status = connection.Client.Send(remaining, sentPackets);
+                REQUIRE((status == Status::Done || status == Status::Partial || status == Status::NotReady));
+                sawPartial = sawPartial || status == Status::Partial;
+
+                remaining = remaining.subspan(sentPackets);
+                if(status != Status::Done)
+                    std::this_thread::yield();
+            }
+
+            REQUIRE(sawPartial);
+        }
+        REQUIRE(matching == packets.size());
+    }
+}
+
+TEST_CASE("TRAP::Network::TCPSocket Benchmark", "[.][benchmark][network][tcpsocket]")
+{
+    Connection connection{};
+
+    //Drain everything on the server side until the client disconnects
+    std::jthread receiver([&connection]()
+    {
+        std::array<u8, 64 * 1024> buffer{};
+        usize received = 0;
+        while(connection.Server.Receive(buffer.data(), buffer.size(), received) == Status::Done)
+            ;
+    });
+
+    std::vector<TRAP::Network::Packet> packets{};
+    for(u32 i = 0; i < 1000; ++i)
+        packets.push_back(MakePacket(i, 60));
+
+    BENCHMARK("Send 1000 small packets one by one")
+    {
+        for(TRAP::Network::Packet& packet : packets)
+        {
+            if(connection.Client.Send(packet) != Status::Done)
+                return false;
+        }
+
+        return true;
+    };
+
+    BENCHMARK("Send 1000 small packets batched")
+    {
+        usize sentPackets = 0;
+        return connection.Client.Send(packets, sentPackets) == Status::Done;
+    };
+
+    connection.Client.Disconnect();
+}
@@ -0,0 +1,224 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <array>
+#include <vector>
+
+#include "Network/Packet.h"
+#include "Network/PacketPool.h"
+#include "Network/Sockets/DatagramBatch.h"
+#include "Network/Sockets/UDPSocket.h"
+
+namespace
+{
+    using Status = TRAP::Network::Socket::Status;
+
+    struct Sockets
+    {
+        Sockets()
+        {
+            REQUIRE(Receiver.Bind(TRAP::Network::Socket::AnyPort, TRAP::Network::IPv4Address::LocalHost) == Status::Done);
+            REQUIRE(Sender.Bind(TRAP::Network::Socket::AnyPort, TRAP::Network::IPv4Address::LocalHost) == Status::Done);
+        }
+
+        TRAP::Network::UDPSocket Receiver{};
+        TRAP::Network::UDPSocket Sender{};
+    };
+
+    /// @brief Datagram payloads, the first byte of each payload is its index.
+    [[nodiscard]] std::vector<std::vector<u8>> MakePayloads(const usize count, const usize size, const usize firstIndex = 0)
+    {
+        std::vector<std::vector<u8>> payloads(count);
+        for(usize i = 0; i < count; ++i)
+            payloads[i].assign(size, static_cast<u8>(firstIndex + i));
+
+        return payloads;
+    }
+
+    void SendAll(Sockets& sockets, const std::vector<std::vector<u8>>& payloads)
+    {
+        std::vector<TRAP::Network::Datagram> datagrams{};
+        for(const std::vector<u8>& payload : payloads)
+            datagrams.push_back({payload, TRAP::Network::IPv4Address::LocalHost, sockets.Receiver.GetLocalPort()});
+
+        usize sent = 0;
+        REQUIRE(sockets.Sender.Send(datagrams, sent) == Status::Done);
+        REQUIRE(sent == datagrams.size());
+    }
+
+    void ReceiveUntil(const Sockets& sockets, TRAP::Network::DatagramBatch& batch, const usize size)
+    {
+        while(batch.GetSize() < size)
+        {
+            usize received = 0;
+            REQUIRE(sockets.Receiver.Receive(batch, received) == Status::Done);
+            REQUIRE(received > 0);
+        }
+    }
+}
+
+TEST_CASE("TRAP::Network::UDPSocket", "[network][udpsocket]")
+{
+    Sockets sockets{};
+
+    SECTION("Send() and Receive() batches")
+    {
+        TRAP::Network::DatagramBatch batch(128, 64);
+        REQUIRE(batch.GetCapacity() == 128);
+        REQUIRE(batch.GetMaxDatagramSize() == 64);
+        REQUIRE(batch.IsEmpty());
+
+        SendAll(sockets, MakePayloads(100, 32));
+        ReceiveUntil(sockets, batch, 100);
+
+        REQUIRE(batch.GetSize() == 100);
+        for(usize i = 0; i < batch.GetSize(); ++i)
+        {
+            const TRAP::Network::Datagram& datagram = batch[i];
+            REQUIRE(datagram.Data.size() == 32);
+            REQUIRE(datagram.Data.front() == i);
+            REQUIRE(datagram.RemoteAddress == TRAP::Network::IPv4Address::LocalHost);
+            REQUIRE(datagram.RemotePort == sockets.Sender.GetLocalPort());
+        }
+
+        batch.Clear();
+        REQUIRE(batch.IsEmpty());
+    }
+
+    SECTION("Ring wraps around")
+    {
+        TRAP::Network::DatagramBatch batch(8, 16);
+
+        SendAll(sockets, MakePayloads(5, 8));
+        ReceiveUntil(sockets, batch, 5);
+
+        //Keep 2 datagrams, the next ones wrap around the end of the ring
+        batch.Pop(3);
+        REQUIRE(batch.Front().Data.front() == 3);
+
+        SendAll(sockets, MakePayloads(6, 8, 5));
+        ReceiveUntil(sockets, batch, 8);
+
+        REQUIRE(batch.IsFull());
+        for(usize i = 0; i < batch.GetSize(); ++i)
+            REQUIRE(batch[i].Data.front() == i + 3);
+
+        usize received = 0;
+        REQUIRE(sockets.Receiver.Receive(batch, received) == Status::Error);
+        REQUIRE(received == 0);
+    }
+
+    SECTION("Datagrams bigger than the batch slots are discarded")
+    {
+        TRAP::Network::DatagramBatch batch(8, 16);
+
+        std::vector<std::vector<u8>> payloads = MakePayloads(3, 8);
+        payloads[1].resize(32);
+        SendAll(sockets, payloads);
+
+        //Send a marker afterwards, so we know when everything arrived
+        SendAll(sockets, MakePayloads(1, 8, 3));
+        while(batch.IsEmpty() || batch[batch.GetSize() - 1].Data.front() != 3)
+        {
+            usize received = 0;
+            REQUIRE(sockets.Receiver.Receive(batch, received) == Status::Done);
+        }
+
+        REQUIRE(batch.GetSize() == 3);
+        REQUIRE(batch[0].Data.front() == 0);
+        REQUIRE(batch[1].Data.front() == 2);
+        REQUIRE(batch[1].Data.size() == 8);
+        REQUIRE(batch[2].Data.front() == 3);
+    }
+
+    SECTION("PacketPool")
+    {
+        TRAP::Network::PacketPool pool(256);
+        pool.Reserve(4);
+        REQUIRE(pool.GetAvailable() == 4);
+
+        TRAP::Network::Packet sent{};
+        sent << 42u << std::string("Pooled");
+        TRAP::Network::Datagram datagram{std::span(static_cast<const u8*>(sent.GetData()), sent.GetDataSize()),
+                                         TRAP::Network::IPv4Address::LocalHost, sockets.Receiver.GetLocalPort()};
+        usize sentCount = 0;
+        REQUIRE(sockets.Sender.Send(std::span(&datagram, 1), sentCount) == Status::Done);
+
+        TRAP::Network::DatagramBatch batch(4, 64);
+        ReceiveUntil(sockets, batch, 1);
+
+        TRAP::Network::Packet packet = pool.Acquire(batch.Front().Data);
+        batch.Pop();
+        REQUIRE(pool.GetAvailable() == 3);
+
+        u32 value = 0;
+        std::string text{};
+        packet >> value >> text;
+        REQUIRE(packet);
+        REQUIRE(value == 42u);
+        REQUIRE(text == "Pooled");
+
+        //Released packets keep their memory
+        const void* const memory = packet.GetData();
+        pool.Release(std::move(packet));
+        REQUIRE(pool.GetAvailable() == 4);
+
+        TRAP::Network::Packet reused = pool.Acquire();
+        REQUIRE(reused.GetDataSize() == 0);
+        reused << 1u;
+        REQUIRE(reused.GetData() == memory);
+    }
+}
+
+TEST_CASE("TRAP::Network::UDPSocket Benchmark", "[.][benchmark][network][udpsocket]")
+{
+    //Few enough datagrams to not overflow the receive buffer of the socket
+    static constexpr usize DatagramCount = 64;
+
+    Sockets sockets{};
+    const std::vector<std::vector<u8>> payloads = MakePayloads(DatagramCount, 64);
+
+    std::vector<TRAP::Network::Datagram> datagrams{};
+    for(const std::vector<u8>& payload : payloads)
+        datagrams.push_back({payload, TRAP::Network::IPv4Address::LocalHost, sockets.Receiver.GetLocalPort()});
+
+    BENCHMARK("Send + receive 64 datagrams one by one")
+    {
+        for(const std::vector<u8>& payload : payloads)
+        {
+            if(sockets.Sender.Send(payload.data(), payload.size(), TRAP::Network::IPv4Address::LocalHost,
+                                   sockets.Receiver.GetLocalPort()) != Status::Done)
+                return false;
+        }
+
+        std::array<u8, 64> buffer{};
+        for(usize i = 0; i < DatagramCount; ++i)
+        {
+            usize received = 0;
+            TRAP::Network::IPv4Address address{};
+            u16 port = 0;
+            if(sockets.Receiver.Receive(buffer.data(), buffer.size(), received, address, port) != Status::Done)
+                return false;
+        }
+
+        return true;
+    };
+
+    TRAP::Network::DatagramBatch batch(DatagramCount, 64);
+    BENCHMARK("Send + receive 64 datagrams batched")
+    {
+        usize sent = 0;
+        if(sockets.Sender.Send(datagrams, sent) != Status::Done)
+            return false;
+
+        batch.Clear();
+        while(!batch.IsFull())
+        {
+            usize received = 0;
+            if(sockets.Receiver.Receive(batch, received) != Status::Done)
+                return false;
+        }
+
+        return true;
+    };
+}
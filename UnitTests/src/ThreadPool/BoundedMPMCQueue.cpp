@@ -0,0 +1,180 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "ThreadPool/BlockingQueue.h"
+#include "ThreadPool/BoundedMPMCQueue.h"
+
+namespace
+{
+    /// @brief Push itemCount items with the given amount of producers and pop them with the given amount of consumers.
+    /// @return Sum of all popped items.
+    template<typename Queue>
+    [[nodiscard]] u64 RunProducersConsumers(Queue& queue, const u32 producerCount, const u32 consumerCount,
+                                            const u32 itemCount)
+    {
+        std::atomic<u64> sum = 0;
+        std::atomic<u32> remainingProducers = producerCount;
+
+        {
+            std::vector<std::jthread> threads{};
+
+            for(u32 c = 0; c < consumerCount; ++c)
+            {
+                threads.emplace_back([&queue, &sum]()
+                {
+                    u64 localSum = 0;
+                    u32 item = 0;
+                    while(queue.Pop(item))
+                        localSum += item;
+                    sum += localSum;
+                });
+            }
+
+            for(u32 p = 0; p < producerCount; ++p)
+            {
+                threads.emplace_back([&queue, &remainingProducers, p, producerCount, itemCount]()
+                {
+                    for(u32 i = p; i < itemCount; i += producerCount)
+                        queue.Push(i + 1);
+
+                    if(remainingProducers.fetch_sub(1) == 1)
+                        queue.Done();
+                });
+            }
+        }
+
+        return sum.load();
+    }
+}
+
+TEST_CASE("TRAP::BoundedMPMCQueue", "[threadpool][boundedmpmcqueue]")
+{
+    SECTION("Empty")
+    {
+        TRAP::BoundedMPMCQueue<i32> queue(4);
+        i32 item = 0;
+
+        REQUIRE(queue.Empty());
+        REQUIRE(queue.Size() == 0);
+        REQUIRE(queue.Capacity() == 4);
+        REQUIRE_FALSE(queue.TryPop(item));
+    }
+
+    SECTION("FIFO and full")
+    {
+        TRAP::BoundedMPMCQueue<i32> queue(4);
+
+        for(i32 i = 0; i < 4; ++i)
+            REQUIRE(queue.TryPush(i));
+        REQUIRE_FALSE(queue.TryPush(4));
+        REQUIRE(queue.Size() == 4);
+
+        for(i32 round = 0; round < 10; ++round)
+        {
+            i32 item = -1;
+            REQUIRE(queue.TryPop(item));
+            REQUIRE(item == round);
+            REQUIRE(queue.TryPush(round + 4));
+        }
+    }
+
+    SECTION("Move-only items")
+    {
+        TRAP::BoundedMPMCQueue<std::unique_ptr<i32>> queue(2);
+        queue.Push(std::make_unique<i32>(1));
+        REQUIRE(queue.TryPush(std::make_unique<i32>(2)));
+
+        std::unique_ptr<i32> item{};
+        REQUIRE(queue.Pop(item));
+        REQUIRE(*item == 1);
+
+        //Remaining item gets destroyed by the queue
+    }
+
+    SECTION("Done")
+    {
+        TRAP::BoundedMPMCQueue<i32> queue(4);
+        queue.Push(1);
+        queue.Done();
+
+        i32 item = 0;
+        REQUIRE(queue.Pop(item));
+        REQUIRE(item == 1);
+        REQUIRE_FALSE(queue.Pop(item));
+    }
+
+    SECTION("Blocking Pop() wakes up on Done()")
+    {
+        TRAP::BoundedMPMCQueue<i32> queue(4);
+        std::atomic<bool> popped = true;
+
+        std::jthread consumer([&queue, &popped]()
+        {
+            i32 item = 0;
+            popped = queue.Pop(item);
+        });
+
+        queue.Done();
+        consumer.join();
+
+        REQUIRE_FALSE(popped);
+    }
+
+    SECTION("Blocking Push() wakes up on Done()")
+    {
+        TRAP::BoundedMPMCQueue<i32> queue(2);
+        REQUIRE(queue.TryPush(1));
+        REQUIRE(queue.TryPush(2));
+        std::atomic<bool> pushed = true;
+
+        std::jthread producer([&queue, &pushed]()
+        {
+            pushed = queue.Push(3);
+        });
+
+        queue.Done();
+        producer.join();
+
+        REQUIRE_FALSE(pushed);
+        REQUIRE(queue.Size() == 2);
+    }
+
+    SECTION("Multiple producers and consumers")
+    {
+        static constexpr u32 ItemCount = 200'000;
+        static constexpr u64 ExpectedSum = (static_cast<u64>(ItemCount) * (ItemCount + 1)) / 2;
+
+        for(const u32 threads : {1u, 2u, 4u})
+        {
+            //Small capacity so producers have to block
+            TRAP::BoundedMPMCQueue<u32> queue(64);
+            REQUIRE(RunProducersConsumers(queue, threads, threads, ItemCount) == ExpectedSum);
+        }
+    }
+}
+
+TEST_CASE("TRAP::BoundedMPMCQueue Benchmark", "[.][benchmark][threadpool][boundedmpmcqueue]")
+{
+    static constexpr u32 ItemCount = 1u << 18u;
+
+    for(const u32 threads : {1u, 2u, 4u, 8u, 16u, 32u})
+    {
+        BENCHMARK(fmt::format("BoundedMPMCQueue {} producers / {} consumers", threads, threads))
+        {
+            TRAP::BoundedMPMCQueue<u32> queue(1024);
+            return RunProducersConsumers(queue, threads, threads, ItemCount);
+        };
+
+        BENCHMARK(fmt::format("BlockingQueue {} producers / {} consumers", threads, threads))
+        {
+            TRAP::BlockingQueue<u32> queue{};
+            return RunProducersConsumers(queue, threads, threads, ItemCount);
+        };
+    }
+}
@@ -0,0 +1,114 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <memory>
+
+#include "ThreadPool/MoveOnlyTask.h"
+
+namespace
+{
+    struct LifetimeCounter
+    {
+        u32* Destroyed = nullptr;
+
+        explicit LifetimeCounter(u32& destroyed)
+            : Destroyed(&destroyed)
+        {
+        }
+
+        LifetimeCounter(LifetimeCounter&& other) noexcept
+            : Destroyed(std::exchange(other.Destroyed, nullptr))
+        {
+        }
+
+        ~LifetimeCounter()
+        {
+            if(Destroyed != nullptr)
+                ++(*Destroyed);
+        }
+
+        LifetimeCounter(const LifetimeCounter&) = delete;
+        LifetimeCounter& operator=(const LifetimeCounter&) = delete;
+        LifetimeCounter& operator=(LifetimeCounter&&) noexcept = delete;
+    };
+}
+
+TEST_CASE("TRAP::MoveOnlyTask", "[threadpool][moveonlytask]")
+{
+    SECTION("Size")
+    {
+        STATIC_REQUIRE(sizeof(TRAP::MoveOnlyTask) == 64);
+        STATIC_REQUIRE_FALSE(std::is_copy_constructible_v<TRAP::MoveOnlyTask>);
+        STATIC_REQUIRE(std::is_nothrow_move_constructible_v<TRAP::MoveOnlyTask>);
+    }
+
+    SECTION("Empty")
+    {
+        const TRAP::MoveOnlyTask task{};
+        REQUIRE_FALSE(task);
+    }
+
+    SECTION("Inline storage")
+    {
+        u32 value = 0;
+        auto f = [&value](){++value;};
+        STATIC_REQUIRE(TRAP::MoveOnlyTask::IsStoredInline<decltype(f)>);
+
+        TRAP::MoveOnlyTask task = f;
+        REQUIRE(task);
+        task();
+        task();
+        REQUIRE(value == 2);
+    }
+
+    SECTION("Heap storage")
+    {
+        std::array<u64, 16> values{};
+        values.fill(1);
+        u64 sum = 0;
+        auto f = [values, &sum](){for(const u64 v : values) sum += v;};
+        STATIC_REQUIRE_FALSE(TRAP::MoveOnlyTask::IsStoredInline<decltype(f)>);
+
+        TRAP::MoveOnlyTask task = f;
+        TRAP::MoveOnlyTask moved = std::move(task);
+        REQUIRE_FALSE(task);
+        moved();
+        REQUIRE(sum == 16);
+    }
+
+    SECTION("Move-only captures")
+    {
+        u32 result = 0;
+        TRAP::MoveOnlyTask task = [value = std::make_unique<u32>(42u), &result](){result = *value;};
+
+        TRAP::MoveOnlyTask other{};
+        other = std::move(task);
+        other();
+
+        REQUIRE(result == 42);
+    }
+
+    SECTION("Destruction")
+    {
+        u32 destroyed = 0;
+
+        {
+            TRAP::MoveOnlyTask task = [counter = LifetimeCounter(destroyed)](){};
+            TRAP::MoveOnlyTask moved = std::move(task);
+            REQUIRE(destroyed == 0);
+
+            moved = TRAP::MoveOnlyTask([](){});
+            REQUIRE(destroyed == 1);
+        }
+
+        REQUIRE(destroyed == 1);
+
+        {
+            std::array<u64, 16> padding{};
+            TRAP::MoveOnlyTask task = [padding, counter = LifetimeCounter(destroyed)](){static_cast<void>(padding);};
+            TRAP::MoveOnlyTask moved = std::move(task);
+        }
+
+        REQUIRE(destroyed == 2);
+    }
+}
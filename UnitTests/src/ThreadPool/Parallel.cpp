@@ -0,0 +1,248 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "ThreadPool/Parallel.h"
+
+TEST_CASE("TRAP::ParallelFor()", "[threadpool][parallel]")
+{
+    TRAP::ThreadPool pool(4);
+
+    SECTION("Empty range")
+    {
+        u32 calls = 0;
+        TRAP::ParallelFor(pool, 10, 10, 1, [&calls](i32){++calls;});
+        TRAP::ParallelFor(pool, 10, 5, 1, [&calls](i32){++calls;});
+        REQUIRE(calls == 0);
+    }
+
+    SECTION("Every index is visited exactly once")
+    {
+        static constexpr u32 Count = 100'000;
+        std::vector<std::atomic<u32>> visits(Count);
+
+        TRAP::ParallelFor(pool, 0u, Count, 64, [&visits](const u32 i){visits[i].fetch_add(1);});
+
+        REQUIRE(std::ranges::all_of(visits, [](const auto& v){return v.load() == 1;}));
+    }
+
+    SECTION("Chunk functor")
+    {
+        static constexpr i64 Begin = -5'000;
+        static constexpr i64 End = 5'000;
+        std::vector<std::atomic<u32>> visits(End - Begin);
+        std::atomic<u32> chunkCount = 0;
+        std::atomic<bool> validChunks = true;
+
+        TRAP::ParallelFor(pool, Begin, End, 100, [&](const i64 chunkBegin, const i64 chunkEnd)
+        {
+            if(chunkBegin >= chunkEnd || (chunkEnd - chunkBegin) < 100)
+                validChunks = false;
+            ++chunkCount;
+            for(i64 i = chunkBegin; i < chunkEnd; ++i)
+                visits[static_cast<usize>(i - Begin)].fetch_add(1);
+        });
+
+        REQUIRE(chunkCount > 1);
+        REQUIRE(validChunks);
+        REQUIRE(std::ranges::all_of(visits, [](const auto& v){return v.load() == 1;}));
+    }
+
+    SECTION("Small ranges stay on the calling thread")
+    {
+        const std::thread::id caller = std::this_thread::get_id();
+        bool onCaller = true;
+
+        TRAP::ParallelFor(pool, 0, 64, 64, [&](i32){onCaller = onCaller && std::this_thread::get_id() == caller;});
+
+        REQUIRE(onCaller);
+    }
+
+    SECTION("Nested")
+    {
+        static constexpr u32 Outer = 16;
+        static constexpr u32 Inner = 1'000;
+        std::atomic<u32> counter = 0;
+
+        TRAP::ParallelFor(pool, 0u, Outer, 1, [&](u32)
+        {
+            TRAP::ParallelFor(pool, 0u, Inner, 10, [&](u32){++counter;});
+        });
+
+        REQUIRE(counter == Outer * Inner);
+    }
+
+    SECTION("Nested on a single worker")
+    {
+        TRAP::ThreadPool singlePool(1);
+        std::atomic<u32> counter = 0;
+
+        auto future = singlePool.EnqueueTask([&]()
+        {
+            TRAP::ParallelFor(singlePool, 0, 1'000, 1, [&](i32){++counter;});
+        });
+        future.get();
+
+        REQUIRE(counter == 1'000);
+    }
+}
+
+TEST_CASE("TRAP::ParallelReduce()", "[threadpool][parallel]")
+{
+    TRAP::ThreadPool pool(4);
+
+    SECTION("Empty range")
+    {
+        const u64 result = TRAP::ParallelReduce(pool, 0, 0, 1, 42ull,
+                                                [](i32, i32, u64 value){return value + 1;},
+                                                [](u64 lhs, u64 rhs){return lhs + rhs;});
+        REQUIRE(result == 42);
+    }
+
+    SECTION("Sum")
+    {
+        static constexpr u64 Count = 1'000'000;
+
+        const u64 result = TRAP::ParallelReduce(pool, u64(0), Count, 1'000, u64(0),
+                                                [](const u64 begin, const u64 end, u64 sum)
+                                                {
+                                                    for(u64 i = begin; i < end; ++i)
+                                                        sum += i;
+                                                    return sum;
+                                                },
+                                                [](const u64 lhs, const u64 rhs){return lhs + rhs;});
+
+        REQUIRE(result == (Count * (Count - 1)) / 2);
+    }
+
+    SECTION("Floating point results are deterministic")
+    {
+        const auto reduce = [&pool]()
+        {
+            return TRAP::ParallelReduce(pool, 1, 100'000, 100, 0.0f,
+                                        [](const i32 begin, const i32 end, f32 sum)
+                                        {
+                                            for(i32 i = begin; i < end; ++i)
+                                                sum += 1.0f / static_cast<f32>(i);
+                                            return sum;
+                                        },
+                                        [](const f32 lhs, const f32 rhs){return lhs + rhs;});
+        };
+
+        const f32 expected = reduce();
+        for(u32 i = 0; i < 20; ++i)
+            REQUIRE(reduce() == expected);
+    }
+
+    SECTION("Max")
+    {
+        std::vector<i32> values(50'000);
+        std::iota(values.begin(), values.end(), -25'000);
+        values[12'345] = 1'000'000;
+
+        const i32 result = TRAP::ParallelReduce(pool, usize(0), values.size(), 256, std::numeric_limits<i32>::min(),
+                                                [&values](const usize begin, const usize end, i32 max)
+                                                {
+                                                    for(usize i = begin; i < end; ++i)
+                                                        max = std::max(max, values[i]);
+                                                    return max;
+                                                },
+                                                [](const i32 lhs, const i32 rhs){return std::max(lhs, rhs);});
+
+        REQUIRE(result == 1'000'000);
+    }
+
+    SECTION("Bool")
+    {
+        //Partials of neighbouring chunks are written concurrently, they must not share memory
+        std::vector<u8> values(100'000, 1);
+        values[99'999] = 0;
+
+        const auto allSet = [&pool, &values]()
+        {
+            return TRAP::ParallelReduce(pool, usize(0), values.size(), 16, true,
+                                        [&values](const usize begin, const usize end, const bool set)
+                                        {
+                                            return set && std::ranges::all_of(std::span(values).subspan(begin, end - begin),
+                                                                              [](const u8 value){return value != 0;});
+                                        },
+                                        [](const bool lhs, const bool rhs){return lhs && rhs;});
+        };
+
+        REQUIRE_FALSE(allSet());
+        values[99'999] = 1;
+        REQUIRE(allSet());
+    }
+}
+
+TEST_CASE("TRAP::ParallelFor() Benchmark", "[.][benchmark][threadpool][parallel]")
+{
+    static constexpr u32 Width = 2048;
+    static constexpr u32 Height = 2048;
+
+    std::vector<u8> image(static_cast<usize>(Width) * Height * 4);
+    std::iota(image.begin(), image.end(), u8(0));
+    std::vector<u8> gray(static_cast<usize>(Width) * Height);
+
+    //RGBA8 -> Grayscale, one row per index
+    const auto convertRows = [&](const u32 rowBegin, const u32 rowEnd)
+    {
+        for(u32 y = rowBegin; y < rowEnd; ++y)
+        {
+            const u8* src = image.data() + static_cast<usize>(y) * Width * 4;
+            u8* dst = gray.data() + static_cast<usize>(y) * Width;
+            for(u32 x = 0; x < Width; ++x)
+                dst[x] = static_cast<u8>((src[x * 4 + 0] * 77u + src[x * 4 + 1] * 150u + src[x * 4 + 2] * 29u) >> 8u);
+        }
+    };
+
+    static constexpr u64 MathCount = 4'000'000;
+    const auto mathMap = [](const u64 begin, const u64 end, f64 sum)
+    {
+        for(u64 i = begin; i < end; ++i)
+            sum += std::sqrt(static_cast<f64>(i)) * std::sin(static_cast<f64>(i));
+        return sum;
+    };
+    const auto mathReduce = [](const f64 lhs, const f64 rhs){return lhs + rhs;};
+
+    BENCHMARK("Image RGBA8 to grayscale serial")
+    {
+        convertRows(0, Height);
+        return gray[Width];
+    };
+
+    BENCHMARK("Math reduce serial")
+    {
+        return mathMap(0, MathCount, 0.0);
+    };
+
+    //Serial runs above are the 1 thread case
+    const u32 hardwareThreads = std::max(std::thread::hardware_concurrency(), 2u);
+    for(u32 threads = 2; ; threads = std::min(threads * 2, hardwareThreads))
+    {
+        //The calling thread takes part too
+        TRAP::ThreadPool pool(threads - 1);
+
+        BENCHMARK(fmt::format("Image RGBA8 to grayscale {} thread(s)", threads))
+        {
+            TRAP::ParallelFor(pool, 0u, Height, 8, convertRows);
+            return gray[Width];
+        };
+
+        BENCHMARK(fmt::format("Math reduce {} thread(s)", threads))
+        {
+            return TRAP::ParallelReduce(pool, u64(0), MathCount, 4'096, 0.0, mathMap, mathReduce);
+        };
+
+        if(threads == hardwareThreads)
+            break;
+    }
+}
@@ -0,0 +1,144 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <vector>
+
+#include "ThreadPool/TaskGraph.h"
+
+TEST_CASE("TRAP::TaskGraph", "[threadpool][taskgraph]")
+{
+    TRAP::ThreadPool pool(4);
+
+    SECTION("Empty graph")
+    {
+        TRAP::TaskGraph graph(pool);
+        REQUIRE(graph.IsDone());
+        REQUIRE(graph.GetTaskCount() == 0);
+
+        graph.Run();
+        graph.Wait();
+        REQUIRE(graph.IsDone());
+    }
+
+    SECTION("Chain")
+    {
+        TRAP::TaskGraph graph(pool);
+        std::vector<i32> order{};
+
+        auto a = graph.Emplace([&order](){order.push_back(0);});
+        auto b = graph.Emplace([&order](){order.push_back(1);});
+        auto c = graph.Emplace([&order](){order.push_back(2);});
+        a.Precede(b);
+        c.Succeed(b);
+
+        REQUIRE(a.GetSuccessorCount() == 1);
+        REQUIRE(c.GetPredecessorCount() == 1);
+
+        graph.Run();
+        graph.Wait();
+
+        REQUIRE(order == std::vector{0, 1, 2});
+    }
+
+    SECTION("Diamond")
+    {
+        TRAP::TaskGraph graph(pool);
+        std::atomic<u32> sequence = 0;
+        u32 aOrder = 0, bOrder = 0, cOrder = 0, dOrder = 0;
+
+        auto a = graph.Emplace([&](){aOrder = sequence++;});
+        auto b = graph.Emplace([&](){bOrder = sequence++;});
+        auto c = graph.Emplace([&](){cOrder = sequence++;});
+        auto d = graph.Emplace([&](){dOrder = sequence++;});
+        a.Precede(b, c);
+        d.Succeed(b, c);
+
+        REQUIRE(d.GetPredecessorCount() == 2);
+
+        for(u32 run = 0; run < 100; ++run)
+        {
+            sequence = 0;
+            graph.Run();
+            graph.Wait();
+
+            REQUIRE(aOrder == 0);
+            REQUIRE(bOrder > aOrder);
+            REQUIRE(cOrder > aOrder);
+            REQUIRE(dOrder == 3);
+        }
+    }
+
+    SECTION("Wide fan-out and fan-in")
+    {
+        static constexpr u32 Width = 10'000;
+
+        TRAP::TaskGraph graph(pool);
+        std::atomic<u32> counter = 0;
+        bool sourceDone = false;
+        bool sinkSawAll = false;
+
+        auto source = graph.Emplace([&sourceDone](){sourceDone = true;});
+        auto sink = graph.Emplace([&counter, &sinkSawAll](){sinkSawAll = counter.load() == Width;});
+
+        for(u32 i = 0; i < Width; ++i)
+        {
+            auto task = graph.Emplace([&counter, &sourceDone]()
+            {
+                if(sourceDone)
+                    ++counter;
+            });
+            source.Precede(task);
+            task.Precede(sink);
+        }
+
+        REQUIRE(source.GetSuccessorCount() == Width);
+        REQUIRE(sink.GetPredecessorCount() == Width);
+
+        graph.Run(TRAP::TaskPriority::High);
+        graph.Wait();
+
+        REQUIRE(counter == Width);
+        REQUIRE(sinkSawAll);
+    }
+
+    SECTION("Wait while helping inside a worker")
+    {
+        //A single worker would deadlock if Wait() blocked the thread
+        TRAP::ThreadPool singlePool(1);
+        std::atomic<u32> counter = 0;
+
+        auto future = singlePool.EnqueueTask([&singlePool, &counter]()
+        {
+            TRAP::TaskGraph inner(singlePool);
+            auto a = inner.Emplace([&counter](){++counter;});
+            auto b = inner.Emplace([&counter](){++counter;});
+            auto c = inner.Emplace([&counter](){++counter;});
+            a.Precede(c);
+            b.Precede(c);
+
+            inner.Run();
+            inner.Wait();
+
+            return counter.load();
+        });
+
+        REQUIRE(future.get() == 3);
+    }
+
+    SECTION("Clear")
+    {
+        TRAP::TaskGraph graph(pool);
+        std::atomic<u32> counter = 0;
+
+        graph.Emplace([&counter](){++counter;});
+        graph.Run();
+        graph.Wait();
+        REQUIRE(counter == 1);
+
+        graph.Clear();
+        REQUIRE(graph.GetTaskCount() == 0);
+        graph.Run();
+        graph.Wait();
+        REQUIRE(counter == 1);
+    }
+}
@@ -0,0 +1,388 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <atomic>
+#include <memory>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include "ThreadPool/BlockingQueue.h"
+#include "ThreadPool/ThreadPool.h"
+#include "Utils/AllocationCounter.h"
+
+namespace
+{
+    /// @brief Copy of the mutex based round-robin ThreadPool used before the work stealing scheduler.
+    ///        Only used as a baseline for the benchmarks.
+    class LegacyThreadPool
+    {
+    public:
+        explicit LegacyThreadPool(const u32 threads)
+            : m_queues(threads), m_maxThreadsCount(threads)
+        {
+            auto worker = [&](const u32 i)
+            {
+                while (true)
+                {
+                    Proc f;
+                    for (u32 n = 0; n < m_maxThreadsCount; ++n)
+                    {
+                        if (m_queues[(i + n) % m_maxThreadsCount].TryPop(f))
+                            break;
+                    }
+
+                    if (!f && !m_queues[i].Pop(f))
+                        break;
+
+                    f();
+                }
+            };
+
+            for (u32 i = 0; i < m_maxThreadsCount; ++i)
+                m_threads.emplace_back(worker, i);
+        }
+
+        ~LegacyThreadPool()
+        {
+            for (Queue& queue : m_queues)
+                queue.Done();
+        }
+
+        LegacyThreadPool(const LegacyThreadPool&) = delete;
+        LegacyThreadPool& operator=(const LegacyThreadPool&) = delete;
+        LegacyThreadPool(LegacyThreadPool&&) noexcept = delete;
+        LegacyThreadPool& operator=(LegacyThreadPool&&) noexcept = delete;
+
+        template<typename F>
+        void EnqueueWork(F&& f)
+        {
+            Proc work = std::forward<F>(f);
+            const u32 i = m_index++;
+
+            for (u32 n = 0; n < m_maxThreadsCount * K; ++n)
+            {
+                if (m_queues[(i + n) % m_maxThreadsCount].TryPush(std::move(work)))
+                    return;
+            }
+
+            m_queues[i % m_maxThreadsCount].Push(std::move(work));
+        }
+
+    private:
+        using Proc = std::function<void()>;
+        using Queue = TRAP::BlockingQueue<Proc>;
+        std::vector<Queue> m_queues;
+        std::vector<std::jthread> m_threads;
+        u32 m_maxThreadsCount;
+        std::atomic<u32> m_index = 0;
+
+        static constexpr u32 K = 3;
+    };
+
+    //-------------------------------------------------------------------------------------------------------------------//
+
+    [[nodiscard]] u32 GetBenchmarkThreadCount()
+    {
+        return std::max(2u, std::thread::hardware_concurrency() - 1);
+    }
+
+    //-------------------------------------------------------------------------------------------------------------------//
+
+    template<typename Pool>
+    void RunTinyJobs(Pool& pool, const u32 jobCount)
+    {
+        std::atomic<u32> remaining = jobCount;
+
+        for(u32 i = 0; i < jobCount; ++i)
+        {
+            pool.EnqueueWork([&remaining]()
+            {
+                if(remaining.fetch_sub(1) == 1)
+                    remaining.notify_one();
+            });
+        }
+
+        for(u32 value = remaining.load(); value != 0; value = remaining.load())
+            remaining.wait(value);
+    }
+
+    //-------------------------------------------------------------------------------------------------------------------//
+
+    /// @brief Enqueue tiny jobs from inside a worker and count the heap allocations this causes.
+    /// @param pool ThreadPool to use.
+    /// @param jobCount Number of jobs to enqueue.
+    /// @param withFuture Whether to use EnqueueTask() instead of EnqueueWork().
+    /// @return Number of heap allocations.
+    [[nodiscard]] u64 CountNestedJobAllocations(TRAP::ThreadPool& pool, const u32 jobCount, const bool withFuture)
+    {
+        auto outer = pool.EnqueueTask([&pool, jobCount, withFuture]()
+        {
+            std::atomic<u32> remaining = jobCount;
+            std::vector<std::future<void>> futures{};
+            futures.reserve(jobCount);
+
+            const u64 start = UnitTests::AllocationCount.load();
+
+            for(u32 i = 0; i < jobCount; ++i)
+            {
+                if(withFuture)
+                    futures.push_back(pool.EnqueueTask([&remaining](){--remaining;}));
+                else
+                    pool.EnqueueWork([&remaining](){--remaining;});
+            }
+
+            while(remaining.load() != 0)
+                pool.TryRunPendingTask();
+
+            for(auto& future : futures)
+                future.get();
+            futures.clear();
+
+            return UnitTests::AllocationCount.load() - start;
+        });
+
+        return outer.get();
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+TEST_CASE("TRAP::ThreadPool", "[threadpool]")
+{
+    SECTION("Thread count")
+    {
+        const TRAP::ThreadPool pool(2);
+        REQUIRE(pool.GetThreadCount() == 2);
+
+        const TRAP::ThreadPool fallbackPool(0);
+        REQUIRE(fallbackPool.GetThreadCount() == 3);
+    }
+
+    SECTION("EnqueueWork()")
+    {
+        std::atomic<u32> counter = 0;
+
+        {
+            TRAP::ThreadPool pool(4);
+            for(u32 i = 0; i < 10'000; ++i)
+                pool.EnqueueWork([&counter](const u32 add){counter += add;}, 1u);
+        }
+
+        REQUIRE(counter == 10'000);
+    }
+
+    SECTION("EnqueueTask()")
+    {
+        TRAP::ThreadPool pool(4);
+
+        std::vector<std::future<u32>> futures{};
+        for(u32 i = 0; i < 1'000; ++i)
+            futures.emplace_back(pool.EnqueueTask([](const u32 x){return x * 2;}, i));
+
+        for(u32 i = 0; i < 1'000; ++i)
+            REQUIRE(futures[i].get() == i * 2);
+    }
+
+    SECTION("Nested enqueue from worker")
+    {
+        std::atomic<u32> counter = 0;
+
+        {
+            TRAP::ThreadPool pool(4);
+
+            for(u32 i = 0; i < 100; ++i)
+            {
+                pool.EnqueueWork([&pool, &counter]()
+                {
+                    for(u32 j = 0; j < 100; ++j)
+                        pool.EnqueueWork([&counter](){++counter;});
+                });
+            }
+        }
+
+        REQUIRE(counter == 10'000);
+    }
+
+    SECTION("Priorities")
+    {
+        TRAP::ThreadPool pool(1);
+
+        std::promise<void> blocker{};
+        std::shared_future<void> blocked = blocker.get_future().share();
+        pool.EnqueueWork([blocked](){blocked.wait();});
+
+        std::mutex orderMutex{};
+        std::vector<TRAP::TaskPriority> order{};
+        const auto record = [&orderMutex, &order](const TRAP::TaskPriority priority)
+        {
+            const std::lock_guard lock(orderMutex);
+            order.push_back(priority);
+        };
+
+        pool.EnqueueWork(TRAP::TaskPriority::Low, record, TRAP::TaskPriority::Low);
+        pool.EnqueueWork(TRAP::TaskPriority::Normal, record, TRAP::TaskPriority::Normal);
+        std::future<void> last = pool.EnqueueTask(TRAP::TaskPriority::High, record, TRAP::TaskPriority::High);
+
+        blocker.set_value();
+        last.get();
+
+        //Wait for the remaining lower priority work
+        while(true)
+        {
+            const std::lock_guard lock(orderMutex);
+            if(order.size() == 3)
+                break;
+        }
+
+        REQUIRE(order == std::vector{TRAP::TaskPriority::High, TRAP::TaskPriority::Normal, TRAP::TaskPriority::Low});
+    }
+
+    SECTION("EnqueueTask() exceptions")
+    {
+        TRAP::ThreadPool pool(2);
+
+        auto future = pool.EnqueueTask([]() -> u32 {throw std::runtime_error("Task failed");});
+
+        REQUIRE_THROWS_AS(future.get(), std::runtime_error);
+    }
+
+    SECTION("Move-only arguments")
+    {
+        TRAP::ThreadPool pool(2);
+
+        auto future = pool.EnqueueTask([](const std::unique_ptr<u32>& value){return *value;}, std::make_unique<u32>(42u));
+
+        REQUIRE(future.get() == 42);
+    }
+
+    SECTION("Tasks are allocation free after warm up")
+    {
+        if constexpr (!UnitTests::AllocationCountingEnabled)
+            SKIP("Allocations can't be counted while the engine replaces operator new");
+
+        static constexpr u32 JobCount = 1'000;
+
+        TRAP::ThreadPool pool(2);
+
+        //Warm up task memory caches
+        for(u32 i = 0; i < 5; ++i)
+        {
+            static_cast<void>(CountNestedJobAllocations(pool, JobCount, false));
+            static_cast<void>(CountNestedJobAllocations(pool, JobCount, true));
+        }
+
+        REQUIRE(CountNestedJobAllocations(pool, JobCount, false) == 0);
+        REQUIRE(CountNestedJobAllocations(pool, JobCount, true) == 0);
+    }
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+TEST_CASE("TRAP::ThreadPool Benchmark", "[.][benchmark][threadpool]")
+{
+    static constexpr u32 JobCount = 100'000;
+
+    SECTION("Throughput")
+    {
+        TRAP::ThreadPool pool(GetBenchmarkThreadCount());
+        LegacyThreadPool legacyPool(GetBenchmarkThreadCount());
+
+        BENCHMARK("ThreadPool 100k tiny jobs")
+        {
+            RunTinyJobs(pool, JobCount);
+        };
+
+        BENCHMARK("LegacyThreadPool 100k tiny jobs")
+        {
+            RunTinyJobs(legacyPool, JobCount);
+        };
+    }
+
+    SECTION("Nested throughput")
+    {
+        TRAP::ThreadPool pool(GetBenchmarkThreadCount());
+
+        BENCHMARK("ThreadPool 100k tiny jobs spawned by workers")
+        {
+            std::atomic<u32> remaining = JobCount;
+
+            for(u32 i = 0; i < 100; ++i)
+            {
+                pool.EnqueueWork([&pool, &remaining]()
+                {
+                    for(u32 j = 0; j < JobCount / 100; ++j)
+                    {
+                        pool.EnqueueWork([&remaining]()
+                        {
+                            if(remaining.fetch_sub(1) == 1)
+                                remaining.notify_one();
+                        });
+                    }
+                });
+            }
+
+            for(u32 value = remaining.load(); value != 0; value = remaining.load())
+                remaining.wait(value);
+        };
+    }
+
+    SECTION("Allocations per task")
+    {
+        if constexpr (!UnitTests::AllocationCountingEnabled)
+            SKIP("Allocations can't be counted while the engine replaces operator new");
+
+        //Task memory caches are bounded, so measure tasks enqueued from workers in bursts
+        static constexpr u32 BurstJobCount = 1'000;
+
+        TRAP::ThreadPool pool(GetBenchmarkThreadCount());
+        LegacyThreadPool legacyPool(GetBenchmarkThreadCount());
+
+        //Warm up
+        RunTinyJobs(pool, JobCount);
+        RunTinyJobs(legacyPool, JobCount);
+        for(u32 i = 0; i < 5; ++i)
+        {
+            static_cast<void>(CountNestedJobAllocations(pool, BurstJobCount, false));
+            static_cast<void>(CountNestedJobAllocations(pool, BurstJobCount, true));
+        }
+
+        u64 start = UnitTests::AllocationCount.load();
+        RunTinyJobs(pool, JobCount);
+        const f64 allocationsPerJob = static_cast<f64>(UnitTests::AllocationCount.load() - start) / JobCount;
+
+        start = UnitTests::AllocationCount.load();
+        RunTinyJobs(legacyPool, JobCount);
+        const f64 legacyAllocationsPerJob = static_cast<f64>(UnitTests::AllocationCount.load() - start) / JobCount;
+
+        const u64 nestedAllocations = CountNestedJobAllocations(pool, BurstJobCount, false);
+        const u64 nestedTaskAllocations = CountNestedJobAllocations(pool, BurstJobCount, true);
+
+        WARN(fmt::format("Allocations per job: ThreadPool {:.3f}, LegacyThreadPool {:.3f}, "
+                         "ThreadPool enqueued from worker {:.3f} (EnqueueTask() {:.3f})",
+                         allocationsPerJob, legacyAllocationsPerJob,
+                         static_cast<f64>(nestedAllocations) / BurstJobCount, static_cast<f64>(nestedTaskAllocations) / BurstJobCount));
+
+        BENCHMARK("ThreadPool 1k tiny tasks with futures enqueued from worker")
+        {
+            return CountNestedJobAllocations(pool, BurstJobCount, true);
+        };
+    }
+
+    SECTION("Latency")
+    {
+        TRAP::ThreadPool pool(GetBenchmarkThreadCount());
+        LegacyThreadPool legacyPool(GetBenchmarkThreadCount());
+
+        BENCHMARK("ThreadPool single job round trip")
+        {
+            RunTinyJobs(pool, 1);
+        };
+
+        BENCHMARK("LegacyThreadPool single job round trip")
+        {
+            RunTinyJobs(legacyPool, 1);
+        };
+    }
+}
@@ -0,0 +1,134 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "ThreadPool/WorkStealingDeque.h"
+
+TEST_CASE("TRAP::WorkStealingDeque", "[threadpool][workstealingdeque]")
+{
+    SECTION("Empty")
+    {
+        TRAP::WorkStealingDeque<i32> deque{};
+        i32 item = 0;
+
+        REQUIRE(deque.Empty());
+        REQUIRE(deque.Size() == 0);
+        REQUIRE_FALSE(deque.Pop(item));
+        REQUIRE_FALSE(deque.Steal(item));
+    }
+
+    SECTION("Pop is LIFO")
+    {
+        TRAP::WorkStealingDeque<i32> deque{};
+        for(i32 i = 0; i < 4; ++i)
+            deque.Push(i);
+
+        REQUIRE(deque.Size() == 4);
+
+        for(i32 i = 3; i >= 0; --i)
+        {
+            i32 item = -1;
+            REQUIRE(deque.Pop(item));
+            REQUIRE(item == i);
+        }
+
+        REQUIRE(deque.Empty());
+    }
+
+    SECTION("Steal is FIFO")
+    {
+        TRAP::WorkStealingDeque<i32> deque{};
+        for(i32 i = 0; i < 4; ++i)
+            deque.Push(i);
+
+        for(i32 i = 0; i < 4; ++i)
+        {
+            i32 item = -1;
+            REQUIRE(deque.Steal(item));
+            REQUIRE(item == i);
+        }
+
+        REQUIRE(deque.Empty());
+    }
+
+    SECTION("Grow")
+    {
+        TRAP::WorkStealingDeque<i32> deque{4};
+        i32 item = -1;
+
+        deque.Push(0);
+        deque.Push(1);
+        REQUIRE(deque.Steal(item));
+        REQUIRE(item == 0);
+
+        for(i32 i = 2; i < 64; ++i)
+            deque.Push(i);
+
+        REQUIRE(deque.Capacity() >= 64);
+        REQUIRE(deque.Size() == 63);
+
+        REQUIRE(deque.Steal(item));
+        REQUIRE(item == 1);
+        REQUIRE(deque.Pop(item));
+        REQUIRE(item == 63);
+    }
+
+    SECTION("Concurrent owner and thieves")
+    {
+        static constexpr i32 ItemCount = 100'000;
+        static constexpr u32 ThiefCount = 4;
+
+        TRAP::WorkStealingDeque<i32> deque{16};
+        std::vector<std::atomic<u32>> taken(ItemCount);
+        std::atomic<bool> done = false;
+        std::atomic<i32> takenCount = 0;
+
+        {
+            std::vector<std::jthread> thieves{};
+            for(u32 t = 0; t < ThiefCount; ++t)
+            {
+                thieves.emplace_back([&]()
+                {
+                    i32 item = 0;
+                    while(!done.load())
+                    {
+                        if(deque.Steal(item))
+                        {
+                            taken[static_cast<usize>(item)].fetch_add(1);
+                            takenCount.fetch_add(1);
+                        }
+                    }
+                });
+            }
+
+            for(i32 i = 0; i < ItemCount; ++i)
+            {
+                deque.Push(i);
+
+                i32 item = 0;
+                if(i % 3 == 0 && deque.Pop(item))
+                {
+                    taken[static_cast<usize>(item)].fetch_add(1);
+                    takenCount.fetch_add(1);
+                }
+            }
+
+            i32 item = 0;
+            while(takenCount.load() != ItemCount)
+            {
+                if(deque.Pop(item))
+                {
+                    taken[static_cast<usize>(item)].fetch_add(1);
+                    takenCount.fetch_add(1);
+                }
+            }
+
+            done = true;
+        }
+
+        REQUIRE(std::ranges::all_of(taken, [](const auto& t){return t.load() == 1;}));
+    }
+}
@@ -0,0 +1,43 @@
+#include "AllocationCounter.h"
+
+#include <cstdlib>
+#include <new>
+
+std::atomic<u64> UnitTests::AllocationCount = 0;
+
+#ifndef TRACY_ENABLE
+//Count all heap allocations of the test executable
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif /*__GNUC__ && !__clang__*/
+
+void* operator new(const std::size_t size)
+{
+    UnitTests::AllocationCount.fetch_add(1, std::memory_order_relaxed);
+
+    if(void* const ptr = std::malloc(size != 0 ? size : 1))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void operator delete(void* const ptr) noexcept
+{
+    std::free(ptr);
+}
+
+//-------------------------------------------------------------------------------------------------------------------//
+
+void operator delete(void* const ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif /*__GNUC__ && !__clang__*/
+#endif /*TRACY_ENABLE*/
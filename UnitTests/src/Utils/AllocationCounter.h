@@ -0,0 +1,24 @@
+#ifndef TRAP_UNITTESTS_ALLOCATIONCOUNTER_H
+#define TRAP_UNITTESTS_ALLOCATIONCOUNTER_H
+
+#include <atomic>
+
+#include "Core/Types.h"
+
+namespace UnitTests
+{
+    /// @brief Whether heap allocations of the test executable are counted.
+    ///        With TRACY_ENABLE the engine replaces the global operator new for memory profiling,
+    ///        so tests relying on AllocationCount have to be skipped.
+#ifdef TRACY_ENABLE
+    inline constexpr bool AllocationCountingEnabled = false;
+#else
+    inline constexpr bool AllocationCountingEnabled = true;
+#endif /*TRACY_ENABLE*/
+
+    /// @brief Number of calls to the global operator new, used to prove that code paths don't allocate.
+    ///        Stays 0 if AllocationCountingEnabled is false.
+    extern std::atomic<u64> AllocationCount;
+}
+
+#endif /*TRAP_UNITTESTS_ALLOCATIONCOUNTER_H*/
@@ -0,0 +1,104 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <string_view>
+
+#include "Core/Types.h"
+#include "Utils/ByteReader.h"
+
+namespace
+{
+    [[nodiscard]] std::span<const u8> AsBytes(const std::string_view str)
+    {
+        return std::span<const u8>(reinterpret_cast<const u8*>(str.data()), str.size());
+    }
+}
+
+TEST_CASE("TRAP::Utils::ByteReader", "[utils][bytereader]")
+{
+    SECTION("Read()")
+    {
+        static constexpr std::array<u8, 7> data{0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07};
+        TRAP::Utils::ByteReader reader(data);
+
+        u32 value = 0;
+        REQUIRE(reader.Read(value));
+        REQUIRE(value == std::bit_cast<u32>(std::array<u8, 4>{0x01, 0x02, 0x03, 0x04}));
+        REQUIRE(reader.GetPosition() == 4);
+        REQUIRE(reader.GetRemainingSize() == 3);
+
+        REQUIRE(reader.ReadByte() == 0x05);
+
+        //Not enough data left, fails and moves to the end
+        REQUIRE_FALSE(reader.Read(value));
+        REQUIRE(reader.HasFailed());
+        REQUIRE(reader.IsEOF());
+        REQUIRE(reader.ReadByte() == 0);
+    }
+
+    SECTION("ReadSpan()")
+    {
+        static constexpr std::array<u8, 4> data{0x01, 0x02, 0x03, 0x04};
+        TRAP::Utils::ByteReader reader(data);
+
+        const auto first = reader.ReadSpan(3);
+        REQUIRE(first);
+        REQUIRE(first->data() == data.data());
+        REQUIRE(first->size() == 3);
+        REQUIRE(reader.Peek() == 0x04u);
+
+        REQUIRE_FALSE(reader.ReadSpan(2));
+        REQUIRE(reader.HasFailed());
+        REQUIRE_FALSE(reader.Peek());
+    }
+
+    SECTION("Seek() and Skip()")
+    {
+        static constexpr std::array<u8, 4> data{0x01, 0x02, 0x03, 0x04};
+        TRAP::Utils::ByteReader reader(data);
+
+        REQUIRE(reader.Skip(2));
+        REQUIRE(reader.ReadByte() == 0x03);
+        REQUIRE(reader.Seek(0));
+        REQUIRE(reader.ReadByte() == 0x01);
+        REQUIRE(reader.Seek(4));
+        REQUIRE(reader.IsEOF());
+        REQUIRE_FALSE(reader.HasFailed());
+
+        REQUIRE_FALSE(reader.Seek(5));
+        REQUIRE(reader.HasFailed());
+    }
+
+    SECTION("Text")
+    {
+        TRAP::Utils::ByteReader reader(AsBytes("P5\n# comment\n 32\t16 255\nline\r\nlast"));
+
+        REQUIRE(reader.ReadToken() == "P5");
+        reader.SkipLine();
+        reader.SkipLine();
+
+        u32 width = 0, height = 0, maxValue = 0;
+        REQUIRE(reader.ReadNumber(width));
+        REQUIRE(reader.ReadNumber(height));
+        REQUIRE(reader.ReadNumber(maxValue));
+        REQUIRE(width == 32);
+        REQUIRE(height == 16);
+        REQUIRE(maxValue == 255);
+
+        reader.SkipLine();
+        REQUIRE(reader.ReadLine() == std::string_view("line\r"));
+        REQUIRE(reader.ReadLine() == std::string_view("last"));
+        REQUIRE_FALSE(reader.HasFailed());
+        REQUIRE_FALSE(reader.ReadLine());
+        REQUIRE(reader.HasFailed());
+    }
+
+    SECTION("Invalid number")
+    {
+        TRAP::Utils::ByteReader reader(AsBytes("12a"));
+
+        i32 value = 0;
+        REQUIRE_FALSE(reader.ReadNumber(value));
+        REQUIRE(reader.HasFailed());
+    }
+}
@@ -0,0 +1,157 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Utils/Compress/Deflate.h"
+#include "Utils/Decompress/Inflate.h"
+#include "Utils/Hash/Adler32.h"
+
+namespace
+{
+    const std::filesystem::path TestFilesPath = "Testfiles/Decompress/";
+
+    using CompressionLevel = TRAP::Utils::Compress::CompressionLevel;
+
+    constexpr std::array<std::pair<CompressionLevel, std::string_view>, 3> CompressionLevels
+    {
+        {
+            {CompressionLevel::None, "None"},
+            {CompressionLevel::Fastest, "Fastest"},
+            {CompressionLevel::Fast, "Fast"}
+        }
+    };
+
+    [[nodiscard]] std::vector<u8> ReadTestFile(const std::filesystem::path& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        REQUIRE(file.is_open());
+
+        return std::vector<u8>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    [[nodiscard]] std::vector<u8> GenerateRandomData(const usize size)
+    {
+        std::mt19937 rng(1337);
+        std::uniform_int_distribution<u32> dist(0, 255);
+
+        std::vector<u8> data(size);
+        for(u8& b : data)
+            b = static_cast<u8>(dist(rng));
+
+        return data;
+    }
+
+    /// @brief Image like data, rows of slowly changing pixels with some noise.
+    [[nodiscard]] std::vector<u8> GenerateImageData(const usize size)
+    {
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<u32> noise(0, 15);
+
+        std::vector<u8> data(size);
+        for(usize i = 0; i < size; ++i)
+            data[i] = static_cast<u8>((i % 4096) / 32 + (noise(rng) == 0 ? noise(rng) : 0));
+
+        return data;
+    }
+
+    void RequireRoundTrip(const std::vector<u8>& data, const CompressionLevel level)
+    {
+        std::vector<u8> compressed = TRAP::Utils::Compress::Deflate(data, level);
+        REQUIRE(!compressed.empty());
+
+        //Like for PNG the Adler32 trailer is passed along
+        const std::array<u8, 4> adler32 = TRAP::Utils::Hash::Adler32(data.data(), data.size());
+        compressed.insert(compressed.end(), adler32.begin(), adler32.end());
+
+        std::vector<u8> decompressed(data.size());
+        REQUIRE(TRAP::Utils::Decompress::Inflate(compressed, decompressed));
+        REQUIRE(decompressed == data);
+    }
+}
+
+TEST_CASE("TRAP::Utils::Compress::Deflate()", "[utils][compress][deflate]")
+{
+    const std::vector<std::pair<std::vector<u8>, std::string_view>> inputs
+    {
+        {{}, "Empty"},
+        {{42}, "Single byte"},
+        {std::vector<u8>(1000, 7), "Run"},
+        {ReadTestFile(TestFilesPath / "Data.bin"), "Data.bin"},
+        {GenerateRandomData(100000), "Random"},
+        {GenerateImageData(1u << 20u), "Image like"}
+    };
+
+    for(const auto& [level, levelName] : CompressionLevels)
+    {
+        for(const auto& [data, dataName] : inputs)
+        {
+            INFO(levelName << " " << dataName);
+            RequireRoundTrip(data, level);
+        }
+    }
+
+    SECTION("Compressible data gets smaller")
+    {
+        const std::vector<u8> data = GenerateImageData(1u << 20u);
+        const usize fastestSize = TRAP::Utils::Compress::Deflate(data, CompressionLevel::Fastest).size();
+        const usize fastSize = TRAP::Utils::Compress::Deflate(data, CompressionLevel::Fast).size();
+        REQUIRE(fastestSize < data.size() / 3u);
+        REQUIRE(fastSize <= fastestSize);
+    }
+
+    SECTION("Incompressible data is stored")
+    {
+        const std::vector<u8> data = GenerateRandomData(100000);
+        for(const auto& [level, levelName] : CompressionLevels)
+        {
+            INFO(levelName);
+            REQUIRE(TRAP::Utils::Compress::Deflate(data, level).size() <= data.size() + 16u);
+        }
+    }
+}
+
+TEST_CASE("TRAP::Utils::Compress::ZlibCompress()", "[utils][compress][deflate]")
+{
+    const std::vector<u8> data = ReadTestFile(TestFilesPath / "Data.bin");
+    const std::array<u8, 4> adler32 = TRAP::Utils::Hash::Adler32(data.data(), data.size());
+
+    for(const auto& [level, levelName] : CompressionLevels)
+    {
+        INFO(levelName);
+        const std::vector<u8> compressed = TRAP::Utils::Compress::ZlibCompress(data, level);
+        REQUIRE(compressed.size() > 6u);
+
+        //Header
+        REQUIRE(compressed[0] == 0x78);
+        REQUIRE(((compressed[0] * 256u) + compressed[1]) % 31u == 0u);
+
+        //Trailer
+        REQUIRE(std::equal(adler32.begin(), adler32.end(), compressed.end() - 4));
+
+        std::vector<u8> decompressed(data.size());
+        REQUIRE(TRAP::Utils::Decompress::Inflate(std::span(compressed).subspan(2), decompressed));
+        REQUIRE(decompressed == data);
+    }
+}
+
+TEST_CASE("TRAP::Utils::Compress::Deflate() Benchmark", "[.][benchmark][utils][compress][deflate]")
+{
+    const std::vector<u8> data = GenerateImageData(16u << 20u);
+
+    for(const auto& [level, name] : CompressionLevels)
+    {
+        BENCHMARK(fmt::format("Deflate {} 16 MiB", name))
+        {
+            return TRAP::Utils::Compress::Deflate(data, level);
+        };
+    }
+}
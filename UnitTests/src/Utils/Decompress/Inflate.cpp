@@ -0,0 +1,142 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Utils/Decompress/Inflate.h"
+
+namespace
+{
+    const std::filesystem::path TestFilesPath = "Testfiles/Decompress/";
+
+    using InflateImplementation = TRAP::Utils::Decompress::INTERNAL::InflateImplementation;
+
+    constexpr std::array<std::pair<InflateImplementation, std::string_view>, 2> InflateImplementations
+    {
+        {
+            {InflateImplementation::Careful, "Careful"},
+            {InflateImplementation::FastPath, "FastPath"}
+        }
+    };
+
+    [[nodiscard]] std::vector<u8> ReadTestFile(const std::filesystem::path& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        REQUIRE(file.is_open());
+
+        return std::vector<u8>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    /// @brief Read a zlib stream and strip the zlib header.
+    [[nodiscard]] std::vector<u8> ReadDeflateStream(const std::filesystem::path& path)
+    {
+        std::vector<u8> data = ReadTestFile(path);
+        REQUIRE(data.size() > 2);
+        data.erase(data.begin(), data.begin() + 2);
+
+        return data;
+    }
+}
+
+TEST_CASE("TRAP::Utils::Decompress::Inflate()", "[utils][decompress][inflate]")
+{
+    //Data.bin contains text, image like rows with repeated pixels, runs and incompressible data.
+    //The .zlib files are zlib streams of Data.bin using different block types,
+    //like PNG the 2 byte zlib header is skipped and the Adler32 trailer is passed along.
+    const std::vector<u8> expected = ReadTestFile(TestFilesPath / "Data.bin");
+
+    for(const std::string_view fileName : {"Dynamic.zlib", "Fixed.zlib", "Stored.zlib"})
+    {
+        const std::vector<u8> compressed = ReadDeflateStream(TestFilesPath / fileName);
+
+        for(const auto& [impl, name] : InflateImplementations)
+        {
+            INFO(fileName << " " << name);
+
+            std::vector<u8> result(expected.size());
+            REQUIRE(TRAP::Utils::Decompress::INTERNAL::Inflate(compressed, result, impl));
+            REQUIRE(result == expected);
+        }
+
+        std::vector<u8> result(expected.size());
+        REQUIRE(TRAP::Utils::Decompress::Inflate(compressed, result));
+        REQUIRE(result == expected);
+    }
+}
+
+TEST_CASE("TRAP::Utils::Decompress::Inflate() Invalid data", "[utils][decompress][inflate]")
+{
+    for(const auto& [impl, name] : InflateImplementations)
+    {
+        INFO(name);
+
+        SECTION("Truncated stream")
+        {
+            std::vector<u8> compressed = ReadDeflateStream(TestFilesPath / "Dynamic.zlib");
+            compressed.resize(compressed.size() / 2);
+
+            std::vector<u8> result(ReadTestFile(TestFilesPath / "Data.bin").size());
+            REQUIRE_FALSE(TRAP::Utils::Decompress::INTERNAL::Inflate(compressed, result, impl));
+        }
+
+        SECTION("Distance too far back")
+        {
+            //Fixed huffman block starting with a match of length 3 and distance 1
+            static constexpr std::array<u8, 10> compressed{0x03, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+
+            std::vector<u8> result(1024);
+            REQUIRE_FALSE(TRAP::Utils::Decompress::INTERNAL::Inflate(compressed, result, impl));
+        }
+
+        SECTION("Output too small")
+        {
+            //Every block type has to stop at the end of the output instead of writing past it
+            const usize expectedSize = ReadTestFile(TestFilesPath / "Data.bin").size();
+            for(const std::string_view fileName : {"Dynamic.zlib", "Fixed.zlib", "Stored.zlib"})
+            {
+                INFO(fileName);
+                const std::vector<u8> compressed = ReadDeflateStream(TestFilesPath / fileName);
+
+                for(const usize size : {usize(0), usize(1), usize(258), expectedSize / 2, expectedSize - 1})
+                {
+                    std::vector<u8> result(size);
+                    REQUIRE_FALSE(TRAP::Utils::Decompress::INTERNAL::Inflate(compressed, result, impl));
+                }
+            }
+        }
+
+        SECTION("Invalid block type")
+        {
+            static constexpr std::array<u8, 10> compressed{0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+
+            std::vector<u8> result(1024);
+            REQUIRE_FALSE(TRAP::Utils::Decompress::INTERNAL::Inflate(compressed, result, impl));
+        }
+    }
+}
+
+TEST_CASE("TRAP::Utils::Decompress::Inflate() Benchmark", "[.][benchmark][utils][decompress][inflate]")
+{
+    const std::vector<u8> expected = ReadTestFile(TestFilesPath / "Data.bin");
+
+    for(const std::string_view fileName : {"Dynamic.zlib", "Fixed.zlib"})
+    {
+        const std::vector<u8> compressed = ReadDeflateStream(TestFilesPath / fileName);
+        std::vector<u8> result(expected.size());
+
+        for(const auto& [impl, name] : InflateImplementations)
+        {
+            BENCHMARK(fmt::format("Inflate {} {}", name, fileName))
+            {
+                return TRAP::Utils::Decompress::INTERNAL::Inflate(compressed, result, impl);
+            };
+        }
+    }
+}
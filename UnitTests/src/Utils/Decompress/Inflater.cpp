@@ -0,0 +1,155 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "Utils/Decompress/Inflater.h"
+
+namespace
+{
+    const std::filesystem::path TestFilesPath = "Testfiles/Decompress/";
+
+    [[nodiscard]] std::vector<u8> ReadTestFile(const std::filesystem::path& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        REQUIRE(file.is_open());
+
+        return std::vector<u8>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    /// @brief Read a zlib stream and strip the zlib header.
+    [[nodiscard]] std::vector<u8> ReadDeflateStream(const std::filesystem::path& path)
+    {
+        std::vector<u8> data = ReadTestFile(path);
+        REQUIRE(data.size() > 2);
+        data.erase(data.begin(), data.begin() + 2);
+
+        return data;
+    }
+
+    /// @brief Data compressed in Pattern.zlib, bigger than the inflate window.
+    [[nodiscard]] std::vector<u8> GeneratePattern()
+    {
+        std::vector<u8> data(512u * 1024u);
+        for(usize i = 0; i < data.size(); ++i)
+            data[i] = static_cast<u8>(((i % 251u) ^ (i / 4096u)) & 0xFFu);
+
+        return data;
+    }
+
+    /// @brief Inflate the given deflate stream, feeding input and retrieving output in chunks of the given sizes.
+    [[nodiscard]] std::vector<u8> InflateInChunks(TRAP::Utils::Decompress::Inflater& inflater, const std::span<const u8> compressed,
+                                                  const usize inputChunkSize, const usize outputChunkSize)
+    {
+        std::vector<u8> result{};
+        std::vector<u8> chunk(outputChunkSize);
+
+        const auto drain = [&]()
+        {
+            usize written = 0;
+            do
+            {
+                written = inflater.Inflate(chunk);
+                result.insert(result.end(), chunk.begin(), chunk.begin() + static_cast<isize>(written));
+            } while(written == chunk.size());
+        };
+
+        for(usize offset = 0; offset < compressed.size(); offset += inputChunkSize)
+        {
+            inflater.AppendInput(compressed.subspan(offset, std::min(inputChunkSize, compressed.size() - offset)));
+            drain();
+        }
+
+        inflater.FinishInput();
+        drain();
+
+        return result;
+    }
+}
+
+TEST_CASE("TRAP::Utils::Decompress::Inflater", "[utils][decompress][inflater]")
+{
+    SECTION("Block types")
+    {
+        const std::vector<u8> expected = ReadTestFile(TestFilesPath / "Data.bin");
+
+        for(const std::string_view fileName : {"Dynamic.zlib", "Fixed.zlib", "Stored.zlib"})
+        {
+            const std::vector<u8> compressed = ReadDeflateStream(TestFilesPath / fileName);
+
+            for(const usize inputChunkSize : {usize(1), usize(7), usize(1000), compressed.size()})
+            {
+                for(const usize outputChunkSize : {usize(13), usize(4096), expected.size() + 1})
+                {
+                    INFO(fileName << " input chunk size: " << inputChunkSize << " output chunk size: " << outputChunkSize);
+
+                    TRAP::Utils::Decompress::Inflater inflater{};
+                    REQUIRE(InflateInChunks(inflater, compressed, inputChunkSize, outputChunkSize) == expected);
+                    REQUIRE(inflater.GetStatus() == TRAP::Utils::Decompress::Inflater::Status::Done);
+
+                    //Adler32 trailer of the zlib stream
+                    const std::span<const u8> trailer = inflater.GetTrailingInput();
+                    REQUIRE(std::ranges::equal(trailer, std::span(compressed).last(4)));
+                }
+            }
+        }
+    }
+
+    SECTION("Output bigger than window")
+    {
+        const std::vector<u8> expected = GeneratePattern();
+        const std::vector<u8> compressed = ReadDeflateStream(TestFilesPath / "Pattern.zlib");
+
+        for(const usize inputChunkSize : {usize(100), compressed.size()})
+        {
+            for(const usize outputChunkSize : {usize(1), usize(5000), usize(200'000)})
+            {
+                INFO("input chunk size: " << inputChunkSize << " output chunk size: " << outputChunkSize);
+
+                TRAP::Utils::Decompress::Inflater inflater{};
+                REQUIRE(InflateInChunks(inflater, compressed, inputChunkSize, outputChunkSize) == expected);
+                REQUIRE(inflater.GetStatus() == TRAP::Utils::Decompress::Inflater::Status::Done);
+            }
+        }
+    }
+
+    SECTION("Waits for more input")
+    {
+        const std::vector<u8> compressed = ReadDeflateStream(TestFilesPath / "Dynamic.zlib");
+
+        TRAP::Utils::Decompress::Inflater inflater{};
+        inflater.AppendInput(std::span(compressed).first(compressed.size() / 2));
+
+        std::vector<u8> output(1024u * 1024u);
+        const usize written = inflater.Inflate(output);
+        REQUIRE(written > 0);
+        REQUIRE(written < output.size());
+        REQUIRE(inflater.GetStatus() == TRAP::Utils::Decompress::Inflater::Status::Running);
+        REQUIRE(inflater.GetTrailingInput().empty());
+    }
+
+    SECTION("Truncated stream")
+    {
+        std::vector<u8> compressed = ReadDeflateStream(TestFilesPath / "Dynamic.zlib");
+        compressed.resize(compressed.size() / 2);
+
+        TRAP::Utils::Decompress::Inflater inflater{};
+        static_cast<void>(InflateInChunks(inflater, compressed, 4096, 4096));
+        REQUIRE(inflater.GetStatus() == TRAP::Utils::Decompress::Inflater::Status::Error);
+    }
+
+    SECTION("Distance too far back")
+    {
+        //Fixed huffman block starting with a match of length 3 and distance 1
+        static constexpr std::array<u8, 10> compressed{0x03, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+
+        TRAP::Utils::Decompress::Inflater inflater{};
+        static_cast<void>(InflateInChunks(inflater, compressed, compressed.size(), 1024));
+        REQUIRE(inflater.GetStatus() == TRAP::Utils::Decompress::Inflater::Status::Error);
+    }
+}
@@ -0,0 +1,170 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <random>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Utils/Hash/Adler32.h"
+#include "Utils/Hash/ConvertHashToString.h"
+
+namespace
+{
+    using Adler32Implementation = TRAP::Utils::Hash::INTERNAL::Adler32Implementation;
+
+    constexpr std::array<std::pair<Adler32Implementation, std::string_view>, 3> Adler32Implementations
+    {
+        {
+            {Adler32Implementation::Scalar, "Scalar"},
+            {Adler32Implementation::SSSE3, "SSSE3"},
+            {Adler32Implementation::AVX2, "AVX2"}
+        }
+    };
+
+    [[nodiscard]] std::vector<u8> GenerateData(const usize size)
+    {
+        std::mt19937 rng(1337);
+        std::uniform_int_distribution<u32> dist(0, 255);
+
+        std::vector<u8> data(size);
+        for(u8& b : data)
+            b = static_cast<u8>(dist(rng));
+
+        return data;
+    }
+}
+
+TEST_CASE("TRAP::Utils::Hash::Adler32()", "[utils][hash][adler32]")
+{
+    SECTION("Known values")
+    {
+        REQUIRE(TRAP::Utils::Hash::ConvertHashToString(TRAP::Utils::Hash::Adler32("")) == "00000001");
+        REQUIRE(TRAP::Utils::Hash::ConvertHashToString(TRAP::Utils::Hash::Adler32("Wikipedia")) == "11e60398");
+        REQUIRE(TRAP::Utils::Hash::ConvertHashToString(TRAP::Utils::Hash::Adler32("abc")) == "024d0127");
+    }
+
+    SECTION("Pointer and string overloads match")
+    {
+        const std::vector<u8> data = GenerateData(1000);
+        const std::string_view str(reinterpret_cast<const char*>(data.data()), data.size());
+        REQUIRE(TRAP::Utils::Hash::Adler32(data.data(), data.size()) == TRAP::Utils::Hash::Adler32(str));
+    }
+}
+
+TEST_CASE("TRAP::Utils::Hash::Adler32Hasher", "[utils][hash][adler32]")
+{
+    TRAP::Utils::Hash::Adler32Hasher hasher{};
+
+    SECTION("Known values")
+    {
+        hasher.Update("");
+        REQUIRE(TRAP::Utils::Hash::ConvertHashToString(hasher.Finalize()) == "00000001");
+        hasher.Update("Wikipedia");
+        REQUIRE(TRAP::Utils::Hash::ConvertHashToString(hasher.Finalize()) == "11e60398");
+        hasher.Update("abc");
+        REQUIRE(TRAP::Utils::Hash::ConvertHashToString(hasher.Finalize()) == "024d0127");
+    }
+
+    SECTION("Streamed data matches one-shot result")
+    {
+        std::mt19937 rng(42);
+
+        for(const usize size : {0u, 1u, 63u, 64u, 65u, 127u, 128u, 135u, 136u, 1000u, 100'000u})
+        {
+            const std::vector<u8> data = GenerateData(size);
+            const auto expected = TRAP::Utils::Hash::Adler32(data.data(), data.size());
+
+            std::span<const u8> remaining = data;
+            while(!remaining.empty())
+            {
+                std::uniform_int_distribution<usize> dist(1, std::min<usize>(remaining.size(), 300));
+                const usize chunkSize = dist(rng);
+                hasher.Update(remaining.first(chunkSize));
+                remaining = remaining.subspan(chunkSize);
+            }
+
+            REQUIRE(hasher.Finalize() == expected);
+        }
+    }
+
+    SECTION("Finalize() resets the hasher")
+    {
+        hasher.Update("Some data");
+        const auto first = hasher.Finalize();
+        hasher.Update("Some data");
+        REQUIRE(hasher.Finalize() == first);
+        REQUIRE(hasher.Finalize() == TRAP::Utils::Hash::Adler32(""));
+    }
+
+    SECTION("Reset()")
+    {
+        hasher.Update("Discarded");
+        hasher.Reset();
+        hasher.Update("abc");
+        REQUIRE(hasher.Finalize() == TRAP::Utils::Hash::Adler32("abc"));
+    }
+}
+
+TEST_CASE("TRAP::Utils::Hash::INTERNAL::Adler32()", "[utils][hash][adler32]")
+{
+    //Every implementation must match the scalar one, including unaligned data and all tail lengths
+    const std::vector<u8> data = GenerateData(70'000);
+    std::vector<u8> maxBytes(70'000, 0xFF);
+
+    for(const auto& [impl, name] : Adler32Implementations)
+    {
+        if(!TRAP::Utils::Hash::INTERNAL::IsAdler32ImplementationSupported(impl))
+            continue;
+
+        INFO(name);
+
+        for(usize size = 0; size < 300; ++size)
+        {
+            for(usize offset = 0; offset < 16; offset += 5)
+            {
+                const std::span<const u8> input(data.data() + offset, size);
+                REQUIRE(TRAP::Utils::Hash::INTERNAL::Adler32(input, impl) == TRAP::Utils::Hash::INTERNAL::Adler32(input, Adler32Implementation::Scalar));
+            }
+        }
+
+        for(const usize size : {5552u, 5553u, 5552u * 2u + 31u, 65'536u, 69'997u})
+        {
+            const std::span<const u8> input(data.data() + 3, size);
+            REQUIRE(TRAP::Utils::Hash::INTERNAL::Adler32(input, impl) == TRAP::Utils::Hash::INTERNAL::Adler32(input, Adler32Implementation::Scalar));
+            const std::span<const u8> maxInput(maxBytes.data(), size);
+            REQUIRE(TRAP::Utils::Hash::INTERNAL::Adler32(maxInput, impl) == TRAP::Utils::Hash::INTERNAL::Adler32(maxInput, Adler32Implementation::Scalar));
+        }
+    }
+}
+
+TEST_CASE("TRAP::Utils::Hash::Adler32() Benchmark", "[.][benchmark][utils][hash][adler32]")
+{
+    static constexpr usize Size = 16u * 1024u * 1024u;
+    const std::vector<u8> data = GenerateData(Size);
+
+    for(const auto& [impl, name] : Adler32Implementations)
+    {
+        if(!TRAP::Utils::Hash::INTERNAL::IsAdler32ImplementationSupported(impl))
+            continue;
+
+        BENCHMARK(fmt::format("Adler32 {} 16 MiB", name))
+        {
+            return TRAP::Utils::Hash::INTERNAL::Adler32(data, impl);
+        };
+
+        //Throughput
+        static constexpr u32 Iterations = 16;
+        const auto start = std::chrono::steady_clock::now();
+        for(u32 i = 0; i < Iterations; ++i)
+            [[maybe_unused]] const auto hash = TRAP::Utils::Hash::INTERNAL::Adler32(data, impl);
+        const std::chrono::duration<f64> duration = std::chrono::steady_clock::now() - start;
+        WARN(fmt::format("Adler32 {}: {:.2f} GB/s", name, (static_cast<f64>(Size) * Iterations) / duration.count() / 1e9));
+    }
+}
@@ -0,0 +1,94 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Utils/Hash/HashFile.h"
+#include "ThreadPool/ThreadPool.h"
+
+namespace
+{
+    [[nodiscard]] std::filesystem::path WriteTestFile(const usize size, std::vector<u8>& outData)
+    {
+        std::mt19937 rng(1337);
+        std::uniform_int_distribution<u32> dist(0, 255);
+
+        outData.resize(size);
+        for(u8& b : outData)
+            b = static_cast<u8>(dist(rng));
+
+        const std::filesystem::path path = std::filesystem::temp_directory_path() / "TRAPUnitTestHashFile.bin";
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(outData.data()), static_cast<std::streamsize>(outData.size()));
+
+        return path;
+    }
+}
+
+TEST_CASE("TRAP::Utils::Hash::HashFile()", "[utils][hash][hashfile]")
+{
+    TRAP::TRAPLog.SetImportance(TRAP::Log::Level::Critical);
+
+    SECTION("Matches one-shot results")
+    {
+        //Bigger than a single chunk and not a multiple of the chunk size
+        for(const usize size : {usize(0), usize(1000), 3 * TRAP::Utils::Hash::HashFileChunkSize + 123})
+        {
+            std::vector<u8> data{};
+            const std::filesystem::path path = WriteTestFile(size, data);
+
+            using namespace TRAP::Utils::Hash;
+            REQUIRE(HashFile<CRC32Hasher>(path) == CRC32(data.data(), data.size()));
+            REQUIRE(HashFile<Adler32Hasher>(path) == Adler32(data.data(), data.size()));
+            REQUIRE(HashFile<SHA2_256Hasher>(path) == SHA2_256(data.data(), data.size()));
+            REQUIRE(HashFile<SHA2_512Hasher>(path) == SHA2_512(data.data(), data.size()));
+            REQUIRE(HashFile<SHA3_256Hasher>(path) == SHA3_256(data.data(), data.size()));
+            REQUIRE(HashFile<SHA3_512Hasher>(path) == SHA3_512(data.data(), data.size()));
+
+            std::filesystem::remove(path);
+        }
+    }
+
+    SECTION("Non existing file")
+    {
+        REQUIRE_FALSE(TRAP::Utils::Hash::HashFile<TRAP::Utils::Hash::SHA2_256Hasher>("Testfiles/DoesNotExist.bin"));
+    }
+}
+
+TEST_CASE("TRAP::Utils::Hash::HashFiles()", "[utils][hash][hashfile]")
+{
+    TRAP::TRAPLog.SetImportance(TRAP::Log::Level::Critical);
+
+    TRAP::ThreadPool pool(2);
+
+    //Mix of small files (hashed in batches) and big files (streamed)
+    const std::filesystem::path folder = std::filesystem::temp_directory_path() / "TRAPUnitTestHashFiles";
+    std::filesystem::create_directories(folder);
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<u32> byteDist(0, 255);
+    std::vector<std::filesystem::path> paths{};
+    std::vector<TRAP::Optional<std::array<u8, 32>>> expected{};
+    for(usize i = 0; i < 40; ++i)
+    {
+        const usize size = (i % 10 == 0) ? 200'000 + i : i * 97;
+        std::vector<u8> content(size);
+        for(u8& b : content)
+            b = static_cast<u8>(byteDist(rng));
+
+        paths.push_back(folder / fmt::format("{}.bin", i));
+        std::ofstream file(paths.back(), std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(content.data()), static_cast<std::streamsize>(content.size()));
+        expected.emplace_back(TRAP::Utils::Hash::SHA2_256(content.data(), content.size()));
+    }
+    paths.insert(paths.begin() + 5, folder / "DoesNotExist.bin");
+    expected.insert(expected.begin() + 5, TRAP::NullOpt);
+
+    REQUIRE(TRAP::Utils::Hash::HashFiles(pool, paths) == expected);
+
+    std::filesystem::remove_all(folder);
+}
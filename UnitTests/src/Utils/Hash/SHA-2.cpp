@@ -0,0 +1,245 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Utils/Hash/SHA-2.h"
+#include "Utils/Hash/ConvertHashToString.h"
+
+namespace
+{
+    using SHA2_256Implementation = TRAP::Utils::Hash::INTERNAL::SHA2_256Implementation;
+
+    constexpr std::array<std::pair<SHA2_256Implementation, std::string_view>, 3> SHA2_256Implementations
+    {
+        {
+            {SHA2_256Implementation::Scalar, "Scalar"},
+            {SHA2_256Implementation::AVX2, "AVX2"},
+            {SHA2_256Implementation::SHANI, "SHANI"}
+        }
+    };
+
+    [[nodiscard]] std::vector<u8> GenerateData(const usize size)
+    {
+        std::mt19937 rng(1337);
+        std::uniform_int_distribution<u32> dist(0, 255);
+
+        std::vector<u8> data(size);
+        for(u8& b : data)
+            b = static_cast<u8>(dist(rng));
+
+        return data;
+    }
+}
+
+TEST_CASE("TRAP::Utils::Hash::SHA2_256()", "[utils][hash][sha2_256]")
+{
+    SECTION("Known values")
+    {
+        REQUIRE(TRAP::Utils::Hash::ConvertHashToString(TRAP::Utils::Hash::SHA2_256("")) == "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+        REQUIRE(TRAP::Utils::Hash::ConvertHashToString(TRAP::Utils::Hash::SHA2_256("abc")) == "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    }
+
+    SECTION("Pointer and string overloads match")
+    {
+        const std::vector<u8> data = GenerateData(1000);
+        const std::string_view str(reinterpret_cast<const char*>(data.data()), data.size());
+        REQUIRE(TRAP::Utils::Hash::SHA2_256(data.data(), data.size()) == TRAP::Utils::Hash::SHA2_256(str));
+    }
+}
+
+TEST_CASE("TRAP::Utils::Hash::SHA2_256Hasher", "[utils][hash][sha2_256]")
+{
+    TRAP::Utils::Hash::SHA2_256Hasher hasher{};
+
+    SECTION("Known values")
+    {
+        hasher.Update("");
+        REQUIRE(TRAP::Utils::Hash::ConvertHashToString(hasher.Finalize()) == "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+        hasher.Update("abc");
+        REQUIRE(TRAP::Utils::Hash::ConvertHashToString(hasher.Finalize()) == "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    }
+
+    SECTION("Streamed data matches one-shot result")
+    {
+        std::mt19937 rng(42);
+
+        for(const usize size : {0u, 1u, 63u, 64u, 65u, 127u, 128u, 135u, 136u, 1000u, 100'000u})
+        {
+            const std::vector<u8> data = GenerateData(size);
+            const auto expected = TRAP::Utils::Hash::SHA2_256(data.data(), data.size());
+
+            std::span<const u8> remaining = data;
+            while(!remaining.empty())
+            {
+                std::uniform_int_distribution<usize> dist(1, std::min<usize>(remaining.size(), 300));
+                const usize chunkSize = dist(rng);
+                hasher.Update(remaining.first(chunkSize));
+                remaining = remaining.subspan(chunkSize);
+            }
+
+            REQUIRE(hasher.Finalize() == expected);
+        }
+    }
+
+    SECTION("Finalize() resets the hasher")
+    {
+        hasher.Update("Some data");
+        const auto first = hasher.Finalize();
+        hasher.Update("Some data");
+        REQUIRE(hasher.Finalize() == first);
+        REQUIRE(hasher.Finalize() == TRAP::Utils::Hash::SHA2_256(""));
+    }
+
+    SECTION("Reset()")
+    {
+        hasher.Update("Discarded");
+        hasher.Reset();
+        hasher.Update("abc");
+        REQUIRE(hasher.Finalize() == TRAP::Utils::Hash::SHA2_256("abc"));
+    }
+}
+
+TEST_CASE("TRAP::Utils::Hash::SHA2_512()", "[utils][hash][sha2_512]")
+{
+    SECTION("Known values")
+    {
+        REQUIRE(TRAP::Utils::Hash::ConvertHashToString(TRAP::Utils::Hash::SHA2_512("")) == "cf83e1357eefb8bdf1542850d66d8007d620e4050b5715dc83f4a921d36ce9ce47d0d13c5d85f2b0ff8318d2877eec2f63b931bd47417a81a538327af927da3e");
+        REQUIRE(TRAP::Utils::Hash::ConvertHashToString(TRAP::Utils::Hash::SHA2_512("abc")) == "ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f");
+    }
+
+    SECTION("Pointer and string overloads match")
+    {
+        const std::vector<u8> data = GenerateData(1000);
+        const std::string_view str(reinterpret_cast<const char*>(data.data()), data.size());
+        REQUIRE(TRAP::Utils::Hash::SHA2_512(data.data(), data.size()) == TRAP::Utils::Hash::SHA2_512(str));
+    }
+}
+
+TEST_CASE("TRAP::Utils::Hash::SHA2_512Hasher", "[utils][hash][sha2_512]")
+{
+    TRAP::Utils::Hash::SHA2_512Hasher hasher{};
+
+    SECTION("Known values")
+    {
+        hasher.Update("");
+        REQUIRE(TRAP::Utils::Hash::ConvertHashToString(hasher.Finalize()) == "cf83e1357eefb8bdf1542850d66d8007d620e4050b5715dc83f4a921d36ce9ce47d0d13c5d85f2b0ff8318d2877eec2f63b931bd47417a81a538327af927da3e");
+        hasher.Update("abc");
+        REQUIRE(TRAP::Utils::Hash::ConvertHashToString(hasher.Finalize()) == "ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f");
+    }
+
+    SECTION("Streamed data matches one-shot result")
+    {
+        std::mt19937 rng(42);
+
+        for(const usize size : {0u, 1u, 63u, 64u, 65u, 127u, 128u, 135u, 136u, 1000u, 100'000u})
+        {
+            const std::vector<u8> data = GenerateData(size);
+            const auto expected = TRAP::Utils::Hash::SHA2_512(data.data(), data.size());
+
+            std::span<const u8> remaining = data;
+            while(!remaining.empty())
+            {
+                std::uniform_int_distribution<usize> dist(1, std::min<usize>(remaining.size(), 300));
+                const usize chunkSize = dist(rng);
+                hasher.Update(remaining.first(chunkSize));
+                remaining = remaining.subspan(chunkSize);
+            }
+
+            REQUIRE(hasher.Finalize() == expected);
+        }
+    }
+
+    SECTION("Finalize() resets the hasher")
+    {
+        hasher.Update("Some data");
+        const auto first = hasher.Finalize();
+        hasher.Update("Some data");
+        REQUIRE(hasher.Finalize() == first);
+        REQUIRE(hasher.Finalize() == TRAP::Utils::Hash::SHA2_512(""));
+    }
+
+    SECTION("Reset()")
+    {
+        hasher.Update("Discarded");
+        hasher.Reset();
+        hasher.Update("abc");
+        REQUIRE(hasher.Finalize() == TRAP::Utils::Hash::SHA2_512("abc"));
+    }
+}
+
+TEST_CASE("TRAP::Utils::Hash::SHA2_256Batch()", "[utils][hash][sha2_256]")
+{
+    //Different lengths per lane, including every padding case (1 or 2 tail blocks)
+    const std::vector<u8> data = GenerateData(5'000);
+    std::vector<std::span<const u8>> messages{};
+    for(usize size = 0; size < 200; ++size)
+        messages.emplace_back(data.data() + size, size);
+    messages.emplace_back(data.data(), 4'999);
+    messages.emplace_back(data.data(), 1'000);
+
+    std::vector<std::array<u8, 32>> expected{};
+    for(const auto& message : messages)
+        expected.push_back(TRAP::Utils::Hash::SHA2_256(message.data(), message.size()));
+
+    SECTION("Best implementation")
+    {
+        REQUIRE(TRAP::Utils::Hash::SHA2_256Batch(messages) == expected);
+        REQUIRE(TRAP::Utils::Hash::SHA2_256Batch({}).empty());
+    }
+
+    SECTION("Every implementation")
+    {
+        for(const auto& [impl, name] : SHA2_256Implementations)
+        {
+            if(!TRAP::Utils::Hash::INTERNAL::IsSHA2_256ImplementationSupported(impl))
+                continue;
+
+            INFO(name);
+            REQUIRE(TRAP::Utils::Hash::INTERNAL::SHA2_256Batch(messages, impl) == expected);
+
+            //Less messages than lanes
+            const std::span<const std::span<const u8>> few = std::span(messages).subspan(100, 3);
+            REQUIRE(TRAP::Utils::Hash::INTERNAL::SHA2_256Batch(few, impl) ==
+                    std::vector<std::array<u8, 32>>(expected.begin() + 100, expected.begin() + 103));
+        }
+    }
+}
+
+TEST_CASE("TRAP::Utils::Hash::SHA2_256Batch() Benchmark", "[.][benchmark][utils][hash][sha2_256]")
+{
+    static constexpr usize MessageCount = 1'024;
+    static constexpr usize MessageSize = 1'024;
+
+    const std::vector<u8> data = GenerateData(MessageCount * MessageSize);
+    std::vector<std::span<const u8>> messages{};
+    for(usize i = 0; i < MessageCount; ++i)
+        messages.emplace_back(data.data() + i * MessageSize, MessageSize);
+
+    BENCHMARK("SHA2_256 one at a time 1024x1 KiB")
+    {
+        std::array<u8, 32> last{};
+        for(const auto& message : messages)
+            last = TRAP::Utils::Hash::SHA2_256(message.data(), message.size());
+        return last;
+    };
+
+    for(const auto& [impl, name] : SHA2_256Implementations)
+    {
+        if(!TRAP::Utils::Hash::INTERNAL::IsSHA2_256ImplementationSupported(impl))
+            continue;
+
+        BENCHMARK(fmt::format("SHA2_256Batch {} 1024x1 KiB", name))
+        {
+            return TRAP::Utils::Hash::INTERNAL::SHA2_256Batch(messages, impl);
+        };
+    }
+}
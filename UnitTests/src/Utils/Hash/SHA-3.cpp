@@ -0,0 +1,161 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <random>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "Utils/Hash/SHA-3.h"
+#include "Utils/Hash/ConvertHashToString.h"
+
+namespace
+{
+    [[nodiscard]] std::vector<u8> GenerateData(const usize size)
+    {
+        std::mt19937 rng(1337);
+        std::uniform_int_distribution<u32> dist(0, 255);
+
+        std::vector<u8> data(size);
+        for(u8& b : data)
+            b = static_cast<u8>(dist(rng));
+
+        return data;
+    }
+}
+
+TEST_CASE("TRAP::Utils::Hash::SHA3_256()", "[utils][hash][sha3_256]")
+{
+    SECTION("Known values")
+    {
+        REQUIRE(TRAP::Utils::Hash::ConvertHashToString(TRAP::Utils::Hash::SHA3_256("")) == "a7ffc6f8bf1ed76651c14756a061d662f580ff4de43b49fa82d80a4b80f8434a");
+        REQUIRE(TRAP::Utils::Hash::ConvertHashToString(TRAP::Utils::Hash::SHA3_256("abc")) == "3a985da74fe225b2045c172d6bd390bd855f086e3e9d525b46bfe24511431532");
+    }
+
+    SECTION("Pointer and string overloads match")
+    {
+        const std::vector<u8> data = GenerateData(1000);
+        const std::string_view str(reinterpret_cast<const char*>(data.data()), data.size());
+        REQUIRE(TRAP::Utils::Hash::SHA3_256(data.data(), data.size()) == TRAP::Utils::Hash::SHA3_256(str));
+    }
+}
+
+TEST_CASE("TRAP::Utils::Hash::SHA3_256Hasher", "[utils][hash][sha3_256]")
+{
+    TRAP::Utils::Hash::SHA3_256Hasher hasher{};
+
+    SECTION("Known values")
+    {
+        hasher.Update("");
+        REQUIRE(TRAP::Utils::Hash::ConvertHashToString(hasher.Finalize()) == "a7ffc6f8bf1ed76651c14756a061d662f580ff4de43b49fa82d80a4b80f8434a");
+        hasher.Update("abc");
+        REQUIRE(TRAP::Utils::Hash::ConvertHashToString(hasher.Finalize()) == "3a985da74fe225b2045c172d6bd390bd855f086e3e9d525b46bfe24511431532");
+    }
+
+    SECTION("Streamed data matches one-shot result")
+    {
+        std::mt19937 rng(42);
+
+        for(const usize size : {0u, 1u, 63u, 64u, 65u, 127u, 128u, 135u, 136u, 1000u, 100'000u})
+        {
+            const std::vector<u8> data = GenerateData(size);
+            const auto expected = TRAP::Utils::Hash::SHA3_256(data.data(), data.size());
+
+            std::span<const u8> remaining = data;
+            while(!remaining.empty())
+            {
+                std::uniform_int_distribution<usize> dist(1, std::min<usize>(remaining.size(), 300));
+                const usize chunkSize = dist(rng);
+                hasher.Update(remaining.first(chunkSize));
+                remaining = remaining.subspan(chunkSize);
+            }
+
+            REQUIRE(hasher.Finalize() == expected);
+        }
+    }
+
+    SECTION("Finalize() resets the hasher")
+    {
+        hasher.Update("Some data");
+        const auto first = hasher.Finalize();
+        hasher.Update("Some data");
+        REQUIRE(hasher.Finalize() == first);
+        REQUIRE(hasher.Finalize() == TRAP::Utils::Hash::SHA3_256(""));
+    }
+
+    SECTION("Reset()")
+    {
+        hasher.Update("Discarded");
+        hasher.Reset();
+        hasher.Update("abc");
+        REQUIRE(hasher.Finalize() == TRAP::Utils::Hash::SHA3_256("abc"));
+    }
+}
+
+TEST_CASE("TRAP::Utils::Hash::SHA3_512()", "[utils][hash][sha3_512]")
+{
+    SECTION("Known values")
+    {
+        REQUIRE(TRAP::Utils::Hash::ConvertHashToString(TRAP::Utils::Hash::SHA3_512("")) == "a69f73cca23a9ac5c8b567dc185a756e97c982164fe25859e0d1dcc1475c80a615b2123af1f5f94c11e3e9402c3ac558f500199d95b6d3e301758586281dcd26");
+        REQUIRE(TRAP::Utils::Hash::ConvertHashToString(TRAP::Utils::Hash::SHA3_512("abc")) == "b751850b1a57168a5693cd924b6b096e08f621827444f70d884f5d0240d2712e10e116e9192af3c91a7ec57647e3934057340b4cf408d5a56592f8274eec53f0");
+    }
+
+    SECTION("Pointer and string overloads match")
+    {
+        const std::vector<u8> data = GenerateData(1000);
+        const std::string_view str(reinterpret_cast<const char*>(data.data()), data.size());
+        REQUIRE(TRAP::Utils::Hash::SHA3_512(data.data(), data.size()) == TRAP::Utils::Hash::SHA3_512(str));
+    }
+}
+
+TEST_CASE("TRAP::Utils::Hash::SHA3_512Hasher", "[utils][hash][sha3_512]")
+{
+    TRAP::Utils::Hash::SHA3_512Hasher hasher{};
+
+    SECTION("Known values")
+    {
+        hasher.Update("");
+        REQUIRE(TRAP::Utils::Hash::ConvertHashToString(hasher.Finalize()) == "a69f73cca23a9ac5c8b567dc185a756e97c982164fe25859e0d1dcc1475c80a615b2123af1f5f94c11e3e9402c3ac558f500199d95b6d3e301758586281dcd26");
+        hasher.Update("abc");
+        REQUIRE(TRAP::Utils::Hash::ConvertHashToString(hasher.Finalize()) == "b751850b1a57168a5693cd924b6b096e08f621827444f70d884f5d0240d2712e10e116e9192af3c91a7ec57647e3934057340b4cf408d5a56592f8274eec53f0");
+    }
+
+    SECTION("Streamed data matches one-shot result")
+    {
+        std::mt19937 rng(42);
+
+        for(const usize size : {0u, 1u, 63u, 64u, 65u, 127u, 128u, 135u, 136u, 1000u, 100'000u})
+        {
+            const std::vector<u8> data = GenerateData(size);
+            const auto expected = TRAP::Utils::Hash::SHA3_512(data.data(), data.size());
+
+            std::span<const u8> remaining = data;
+            while(!remaining.empty())
+            {
+                std::uniform_int_distribution<usize> dist(1, std::min<usize>(remaining.size(), 300));
+                const usize chunkSize = dist(rng);
+                hasher.Update(remaining.first(chunkSize));
+                remaining = remaining.subspan(chunkSize);
+            }
+
+            REQUIRE(hasher.Finalize() == expected);
+        }
+    }
+
+    SECTION("Finalize() resets the hasher")
+    {
+        hasher.Update("Some data");
+        const auto first = hasher.Finalize();
+        hasher.Update("Some data");
+        REQUIRE(hasher.Finalize() == first);
+        REQUIRE(hasher.Finalize() == TRAP::Utils::Hash::SHA3_512(""));
+    }
+
+    SECTION("Reset()")
+    {
+        hasher.Update("Discarded");
+        hasher.Reset();
+        hasher.Update("abc");
+        REQUIRE(hasher.Finalize() == TRAP::Utils::Hash::SHA3_512("abc"));
+    }
+}